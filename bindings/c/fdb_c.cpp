@@ -29,6 +29,11 @@
 #include "fdbclient/MultiVersionAssignmentVars.h"
 #include "foundationdb/fdb_c.h"
 #include "foundationdb/fdb_c_internal.h"
+#include "flow/ThreadSafeQueue.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 
 int g_api_version = 0;
 
@@ -60,6 +65,7 @@ int g_api_version = 0;
 /* This must be true so that we can return the data pointer of a
    Standalone<RangeResultRef> as an array of FDBKeyValue. */
 static_assert(sizeof(FDBKeyValue) == sizeof(KeyValueRef), "FDBKeyValue / KeyValueRef size mismatch");
+static_assert(sizeof(FDBKey) == sizeof(KeyRef), "FDBKey / KeyRef size mismatch");
 static_assert(static_cast<int>(FDB_BG_MUTATION_TYPE_SET_VALUE) == static_cast<int>(MutationRef::Type::SetValue),
               "FDB_BG_MUTATION_TYPE_SET_VALUE enum value mismatch");
 static_assert(static_cast<int>(FDB_BG_MUTATION_TYPE_CLEAR_RANGE) == static_cast<int>(MutationRef::Type::ClearRange),
@@ -227,6 +233,109 @@ extern "C" DLLEXPORT fdb_error_t fdb_future_set_callback(FDBFuture* f,
 	CATCH_AND_RETURN(TSAVB(f)->callOrSetAsCallback(cb, ignore, 0););
 }
 
+// Collects ready futures for a consumer which takes them in batches. Futures are pushed onto a lock-free queue, and the
+// mutex is only taken to put the consumer to sleep and wake it, so a busy consumer takes many completions per poll
+// without synchronizing with the network thread at all. Only one thread may poll at a time. The callbacks of pending
+// futures hold references to the queue, so it outlives fdb_completion_queue_destroy until the last of them has fired.
+class CompletionQueue : public ThreadSafeReferenceCounted<CompletionQueue> {
+public:
+	void push(FDBFuture* f, void* tag) {
+		if (closed.load()) {
+			return;
+		}
+		if (completed.push(Completion{ f, tag })) {
+			std::lock_guard<std::mutex> lock(mutex);
+			woken = true;
+			wake.notify_one();
+		}
+	}
+
+	int poll(FDBFuture** futures, void** tags, int maxCount, double timeout) {
+		double deadline = timer_monotonic() + timeout;
+		while (true) {
+			int count = 0;
+			Optional<Completion> c;
+			while (count < maxCount && (c = completed.pop()).present()) {
+				futures[count] = c.get().future;
+				if (tags) {
+					tags[count] = c.get().tag;
+				}
+				++count;
+			}
+			double remaining = deadline - timer_monotonic();
+			if (count > 0 || maxCount <= 0 || remaining <= 0) {
+				return count;
+			}
+			// canSleep() fails if a completion arrived since the pop above, otherwise the next push will wake us
+			if (completed.canSleep()) {
+				std::unique_lock<std::mutex> lock(mutex);
+				wake.wait_for(lock, std::chrono::duration<double>(remaining), [this] { return woken; });
+				woken = false;
+			}
+		}
+	}
+
+	// Futures which become ready after this are no longer pushed
+	void close() { closed.store(true); }
+
+private:
+	struct Completion {
+		FDBFuture* future;
+		void* tag;
+	};
+
+	ThreadSafeQueue<Completion> completed;
+	std::mutex mutex;
+	std::condition_variable wake;
+	bool woken = false;
+	std::atomic<bool> closed{ false };
+};
+
+#define COMPLETION_QUEUE(q) ((CompletionQueue*)(q))
+
+class CompletionQueueCallback final : public ThreadCallback {
+public:
+	CompletionQueueCallback(CompletionQueue* queue, FDBFuture* f, void* tag)
+	  : queue(Reference<CompletionQueue>::addRef(queue)), f(f), tag(tag) {}
+
+	bool canFire(int notMadeActive) const override { return true; }
+	void fire(const Void& unused, int& userParam) override {
+		queue->push(f, tag);
+		delete this;
+	}
+	void error(const Error&, int& userParam) override {
+		queue->push(f, tag);
+		delete this;
+	}
+
+private:
+	Reference<CompletionQueue> queue;
+	FDBFuture* f;
+	void* tag;
+};
+
+extern "C" DLLEXPORT fdb_error_t fdb_create_completion_queue(FDBCompletionQueue** out_queue) {
+	CATCH_AND_RETURN(*out_queue = (FDBCompletionQueue*)new CompletionQueue(););
+}
+
+extern "C" DLLEXPORT void fdb_completion_queue_destroy(FDBCompletionQueue* queue) {
+	CATCH_AND_DIE(COMPLETION_QUEUE(queue)->close(); COMPLETION_QUEUE(queue)->delref(););
+}
+
+extern "C" DLLEXPORT fdb_error_t fdb_future_set_completion_queue(FDBFuture* f, FDBCompletionQueue* queue, void* tag) {
+	CompletionQueueCallback* cb = new CompletionQueueCallback(COMPLETION_QUEUE(queue), f, tag);
+	int ignore;
+	CATCH_AND_RETURN(TSAVB(f)->callOrSetAsCallback(cb, ignore, 0););
+}
+
+extern "C" DLLEXPORT int fdb_completion_queue_poll(FDBCompletionQueue* queue,
+                                                   FDBFuture** out_futures,
+                                                   void** out_tags,
+                                                   int max_count,
+                                                   double timeout) {
+	return COMPLETION_QUEUE(queue)->poll(out_futures, out_tags, max_count, timeout);
+}
+
 fdb_error_t fdb_future_get_error_impl(FDBFuture* f) {
 	return TSAVB(f)->getErrorCode();
 }
@@ -538,6 +647,15 @@ FDBFuture* fdb_transaction_get_v13(FDBTransaction* tr, uint8_t const* key_name,
 	return fdb_transaction_get_impl(tr, key_name, key_name_length, 0);
 }
 
+extern "C" DLLEXPORT FDBFuture* fdb_transaction_get_multi(FDBTransaction* tr,
+                                                          FDBKey const* keys,
+                                                          int key_count,
+                                                          fdb_bool_t snapshot) {
+	RETURN_FUTURE_ON_ERROR(
+	    RangeResult,
+	    return (FDBFuture*)(TXN(tr)->getMulti(VectorRef<KeyRef>((KeyRef*)keys, key_count), snapshot).extractPtr()););
+}
+
 FDBFuture* fdb_transaction_get_key_impl(FDBTransaction* tr,
                                         uint8_t const* key_name,
                                         int key_name_length,
@@ -839,6 +957,20 @@ extern "C" DLLEXPORT FDBFuture* fdb_transaction_get_range_split_points(FDBTransa
 	    return (FDBFuture*)(TXN(tr)->getRangeSplitPoints(range, chunk_size).extractPtr()););
 }
 
+extern "C" DLLEXPORT FDBFuture* fdb_transaction_get_range_parallel(FDBTransaction* tr,
+                                                                   uint8_t const* begin_key_name,
+                                                                   int begin_key_name_length,
+                                                                   uint8_t const* end_key_name,
+                                                                   int end_key_name_length,
+                                                                   int parallelism,
+                                                                   int64_t chunk_size,
+                                                                   fdb_bool_t snapshot) {
+	RETURN_FUTURE_ON_ERROR(
+	    RangeResult,
+	    KeyRangeRef range(KeyRef(begin_key_name, begin_key_name_length), KeyRef(end_key_name, end_key_name_length));
+	    return (FDBFuture*)(TXN(tr)->getRangeParallel(range, parallelism, chunk_size, snapshot).extractPtr()););
+}
+
 #include "fdb_c_function_pointers.g.h"
 
 #define FDB_API_CHANGED(func, ver)                                                                                     \
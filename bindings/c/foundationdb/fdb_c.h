@@ -308,6 +308,20 @@ DLLEXPORT WARN_UNUSED_RESULT fdb_error_t fdb_future_set_callback(FDBFuture* f,
                                                                  FDBCallback callback,
                                                                  void* callback_parameter);
 
+DLLEXPORT WARN_UNUSED_RESULT fdb_error_t fdb_create_completion_queue(FDBCompletionQueue** out_queue);
+
+DLLEXPORT void fdb_completion_queue_destroy(FDBCompletionQueue* queue);
+
+DLLEXPORT WARN_UNUSED_RESULT fdb_error_t fdb_future_set_completion_queue(FDBFuture* f,
+                                                                         FDBCompletionQueue* queue,
+                                                                         void* tag);
+
+DLLEXPORT int fdb_completion_queue_poll(FDBCompletionQueue* queue,
+                                        FDBFuture** out_futures,
+                                        void** out_tags,
+                                        int max_count,
+                                        double timeout);
+
 #if FDB_API_VERSION >= 23
 DLLEXPORT WARN_UNUSED_RESULT fdb_error_t fdb_future_get_error(FDBFuture* f);
 #endif
@@ -439,6 +453,11 @@ DLLEXPORT WARN_UNUSED_RESULT FDBFuture* fdb_transaction_get(FDBTransaction* tr,
                                                             fdb_bool_t snapshot);
 #endif
 
+DLLEXPORT WARN_UNUSED_RESULT FDBFuture* fdb_transaction_get_multi(FDBTransaction* tr,
+                                                                  FDBKey const* keys,
+                                                                  int key_count,
+                                                                  fdb_bool_t snapshot);
+
 #if FDB_API_VERSION >= 14
 DLLEXPORT WARN_UNUSED_RESULT FDBFuture* fdb_transaction_get_key(FDBTransaction* tr,
                                                                 uint8_t const* key_name,
@@ -557,6 +576,15 @@ DLLEXPORT WARN_UNUSED_RESULT FDBFuture* fdb_transaction_get_range_split_points(F
                                                                                int end_key_name_length,
                                                                                int64_t chunk_size);
 
+DLLEXPORT WARN_UNUSED_RESULT FDBFuture* fdb_transaction_get_range_parallel(FDBTransaction* tr,
+                                                                           uint8_t const* begin_key_name,
+                                                                           int begin_key_name_length,
+                                                                           uint8_t const* end_key_name,
+                                                                           int end_key_name_length,
+                                                                           int parallelism,
+                                                                           int64_t chunk_size,
+                                                                           fdb_bool_t snapshot);
+
 #define FDB_KEYSEL_LAST_LESS_THAN(k, l) k, l, 0, 0
 #define FDB_KEYSEL_LAST_LESS_OR_EQUAL(k, l) k, l, 1, 0
 #define FDB_KEYSEL_FIRST_GREATER_THAN(k, l) k, l, 1, 1
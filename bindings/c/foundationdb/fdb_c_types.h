@@ -36,6 +36,7 @@ typedef struct FDB_result FDBResult;
 typedef struct FDB_cluster FDBCluster;
 typedef struct FDB_database FDBDatabase;
 typedef struct FDB_transaction FDBTransaction;
+typedef struct FDB_completion_queue FDBCompletionQueue;
 
 typedef int fdb_error_t;
 typedef int fdb_bool_t;
@@ -258,9 +258,11 @@ int runOneTransaction(Transaction& tx,
                       WorkflowStatistics& stats,
                       ByteString& key1,
                       ByteString& key2,
-                      ByteString& val) {
+                      ByteString& val,
+                      std::optional<timepoint_t> intended_start) {
 	const auto do_sample = (stats.getOpCount(OP_TRANSACTION) % args.sampling) == 0;
-	auto watch_tx = Stopwatch(StartAtCtor{});
+	// in open-loop mode, the time spent waiting behind earlier transactions counts towards the latency
+	auto watch_tx = intended_start ? Stopwatch(*intended_start) : Stopwatch(StartAtCtor{});
 	auto watch_op = Stopwatch{};
 
 	auto op_iter = getOpBegin(args);
@@ -410,13 +412,21 @@ int runWorkload(Database db,
 
 			/* more than 1 second passed*/
 			xacts = 0;
-			time_prev = time_now;
+			/* in open-loop mode, a schedule that has fallen behind is kept rather than restarted */
+			time_prev = args.open_loop ? time_prev + std::chrono::seconds(1) : time_now;
 
 			/* update throttle rate */
 			current_tps = static_cast<int>(thread_tps * throttle_factor.load());
 		}
 
 		if (current_tps > 0 || thread_tps == 0 /* throttling off */) {
+			auto intended_start = std::optional<timepoint_t>{};
+			if (args.open_loop) {
+				/* spread the second's transactions evenly over it rather than start them all at once */
+				const auto offset = std::chrono::duration<double>(static_cast<double>(xacts) / current_tps);
+				intended_start = time_prev + std::chrono::duration_cast<timediff_t>(offset);
+				std::this_thread::sleep_until(*intended_start);
+			}
 			auto [tx, token] = createNewTransaction(db, args, -1);
 			setTransactionTimeoutIfEnabled(args, tx);
 
@@ -454,7 +464,7 @@ int runWorkload(Database db,
 				}
 			}
 
-			rc = runOneTransaction(tx, token, args, workflow_stats, key1, key2, val);
+			rc = runOneTransaction(tx, token, args, workflow_stats, key1, key2, val, intended_start);
 			if (rc) {
 				logr.warn("runOneTransaction failed ({})", rc);
 			}
@@ -792,6 +802,7 @@ Arguments::Arguments() {
 	tpsmin = -1;
 	tpsinterval = 10;
 	tpschange = TPS_SIN;
+	open_loop = 0;
 	sampling = 1000;
 	key_length = 32;
 	value_length = 16;
@@ -1093,6 +1104,7 @@ void usage() {
 	printf("%-24s %s\n", "    --tpsmin=TPS", "Specify the target min TPS");
 	printf("%-24s %s\n", "    --tpsinterval=SEC", "Specify the TPS change interval (Default: 10 seconds)");
 	printf("%-24s %s\n", "    --tpschange=<sin|square|pulse>", "Specify the TPS change type (Default: sin)");
+	printf("%-24s %s\n", "    --open_loop", "Space transactions evenly at the target TPS, timing them from schedule");
 	printf("%-24s %s\n", "    --sampling=RATE", "Specify the sampling rate for latency stats");
 	printf("%-24s %s\n", "-m, --mode=MODE", "Specify the mode (build, run, clean, report)");
 	printf("%-24s %s\n", "-z, --zipf", "Use zipfian distribution instead of uniform distribution");
@@ -1165,6 +1177,7 @@ int parseArguments(int argc, char* argv[], Arguments& args) {
 			{ "tpsmin", required_argument, NULL, ARG_TPSMIN },
 			{ "tpsinterval", required_argument, NULL, ARG_TPSINTERVAL },
 			{ "tpschange", required_argument, NULL, ARG_TPSCHANGE },
+			{ "open_loop", no_argument, NULL, ARG_OPEN_LOOP },
 			{ "sampling", required_argument, NULL, ARG_SAMPLING },
 			{ "verbose", required_argument, NULL, 'v' },
 			{ "mode", required_argument, NULL, 'm' },
@@ -1308,6 +1321,9 @@ int parseArguments(int argc, char* argv[], Arguments& args) {
 		case ARG_TPSINTERVAL:
 			args.tpsinterval = atoi(optarg);
 			break;
+		case ARG_OPEN_LOOP:
+			args.open_loop = 1;
+			break;
 		case ARG_TPSCHANGE:
 			if (strcmp(optarg, "sin") == 0)
 				args.tpschange = TPS_SIN;
@@ -1562,6 +1578,11 @@ int Arguments::validate() {
 		return -1;
 	}
 
+	if (open_loop && (mode != MODE_RUN || tpsmax == 0)) {
+		logr.error("--open_loop is only supported in run mode with --tpsmax|--tps");
+		return -1;
+	}
+
 	if (mode == MODE_RUN || mode == MODE_BUILD) {
 		if (tpsmax > 0) {
 			if (async_xacts > 0) {
@@ -2203,6 +2224,7 @@ int statsProcessMain(Arguments const& args,
 		fmt::fprintf(fp, "\"tpsmin\": %d,", args.tpsmin);
 		fmt::fprintf(fp, "\"tpsinterval\": %d,", args.tpsinterval);
 		fmt::fprintf(fp, "\"tpschange\": %d,", args.tpschange);
+		fmt::fprintf(fp, "\"open_loop\": %d,", args.open_loop);
 		fmt::fprintf(fp, "\"sampling\": %d,", args.sampling);
 		fmt::fprintf(fp, "\"key_length\": %d,", args.key_length);
 		fmt::fprintf(fp, "\"value_length\": %d,", args.value_length);
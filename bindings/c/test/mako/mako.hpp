@@ -69,6 +69,7 @@ enum ArgKind {
 	ARG_TPSMIN,
 	ARG_TPSINTERVAL,
 	ARG_TPSCHANGE,
+	ARG_OPEN_LOOP,
 	ARG_TXNTRACE,
 	ARG_TXNTAGGING,
 	ARG_TXNTAGGINGPREFIX,
@@ -164,6 +165,7 @@ struct Arguments {
 	int tpsmin;
 	int tpsinterval;
 	int tpschange;
+	int open_loop;
 	int sampling;
 	int key_length;
 	int value_length;
@@ -42,6 +42,10 @@ bool Future::is_ready() {
 	return fdb_future_set_callback(future_, callback, callback_parameter);
 }
 
+[[nodiscard]] fdb_error_t Future::set_completion_queue(FDBCompletionQueue* queue, void* tag) {
+	return fdb_future_set_completion_queue(future_, queue, tag);
+}
+
 [[nodiscard]] fdb_error_t Future::get_error() {
 	return fdb_future_get_error(future_);
 }
@@ -188,6 +192,10 @@ ValueFuture Transaction::get(std::string_view key, fdb_bool_t snapshot) {
 	return ValueFuture(fdb_transaction_get(tr_, (const uint8_t*)key.data(), key.size(), snapshot));
 }
 
+KeyValueArrayFuture Transaction::get_multi(const FDBKey* keys, int key_count, fdb_bool_t snapshot) {
+	return KeyValueArrayFuture(fdb_transaction_get_multi(tr_, keys, key_count, snapshot));
+}
+
 KeyFuture Transaction::get_key(const uint8_t* key_name,
                                int key_name_length,
                                fdb_bool_t or_equal,
@@ -231,6 +239,21 @@ KeyValueArrayFuture Transaction::get_range(const uint8_t* begin_key_name,
 	                                                     reverse));
 }
 
+KeyValueArrayFuture Transaction::get_range_parallel(std::string_view begin_key,
+                                                    std::string_view end_key,
+                                                    int parallelism,
+                                                    int64_t chunk_size,
+                                                    fdb_bool_t snapshot) {
+	return KeyValueArrayFuture(fdb_transaction_get_range_parallel(tr_,
+	                                                              (const uint8_t*)begin_key.data(),
+	                                                              begin_key.size(),
+	                                                              (const uint8_t*)end_key.data(),
+	                                                              end_key.size(),
+	                                                              parallelism,
+	                                                              chunk_size,
+	                                                              snapshot));
+}
+
 MappedKeyValueArrayFuture Transaction::get_mapped_range(const uint8_t* begin_key_name,
                                                         int begin_key_name_length,
                                                         fdb_bool_t begin_or_equal,
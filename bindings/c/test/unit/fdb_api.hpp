@@ -59,6 +59,8 @@ public:
 	fdb_error_t block_until_ready();
 	// Wrapper around fdb_future_set_callback.
 	fdb_error_t set_callback(FDBCallback callback, void* callback_parameter);
+	// Wrapper around fdb_future_set_completion_queue.
+	fdb_error_t set_completion_queue(FDBCompletionQueue* queue, void* tag);
 	// Wrapper around fdb_future_get_error.
 	fdb_error_t get_error();
 	// Wrapper around fdb_future_release_memory.
@@ -256,6 +258,9 @@ public:
 	// Returns a future which will be set to the value of `key` in the database.
 	ValueFuture get(std::string_view key, fdb_bool_t snapshot);
 
+	// Wrapper around fdb_transaction_get_multi.
+	KeyValueArrayFuture get_multi(const FDBKey* keys, int key_count, fdb_bool_t snapshot);
+
 	// Returns a future which will be set to the key in the database matching the
 	// passed key selector.
 	KeyFuture get_key(const uint8_t* key_name,
@@ -283,6 +288,13 @@ public:
 	                              fdb_bool_t snapshot,
 	                              fdb_bool_t reverse);
 
+	// Wrapper around fdb_transaction_get_range_parallel.
+	KeyValueArrayFuture get_range_parallel(std::string_view begin_key,
+	                                       std::string_view end_key,
+	                                       int parallelism,
+	                                       int64_t chunk_size,
+	                                       fdb_bool_t snapshot);
+
 	// WARNING: This feature is considered experimental at this time. It is only allowed when using snapshot isolation
 	// AND disabling read-your-writes. Returns a future which will be set to an FDBKeyValue array.
 	MappedKeyValueArrayFuture get_mapped_range(const uint8_t* begin_key_name,
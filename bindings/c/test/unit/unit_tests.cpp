@@ -29,8 +29,10 @@
 #include <condition_variable>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <optional>
+#include <set>
 #include <stdexcept>
 #include <thread>
 #include <tuple>
@@ -379,6 +381,57 @@ TEST_CASE("fdb_future_set_callback") {
 	}
 }
 
+TEST_CASE("fdb_future_set_completion_queue") {
+	FDBCompletionQueue* queue;
+	fdb_check(fdb_create_completion_queue(&queue));
+
+	FDBFuture* polled[4];
+	void* tags[4];
+	CHECK(fdb_completion_queue_poll(queue, polled, tags, 4, 0.01) == 0);
+
+	fdb::Transaction tr(db);
+	std::vector<std::unique_ptr<fdb::ValueFuture>> futures;
+	for (int i = 0; i < 10; ++i) {
+		futures.emplace_back(new fdb::ValueFuture(tr.get("foo", /*snapshot*/ true)));
+		fdb_check(futures.back()->set_completion_queue(queue, reinterpret_cast<void*>(static_cast<intptr_t>(i))));
+	}
+
+	std::set<intptr_t> completed;
+	while (completed.size() < futures.size()) {
+		int count = fdb_completion_queue_poll(queue, polled, tags, 4, 10.0);
+		CHECK(count > 0);
+		CHECK(count <= 4);
+		for (int i = 0; i < count; ++i) {
+			CHECK(fdb_future_is_ready(polled[i]));
+			CHECK(completed.insert(reinterpret_cast<intptr_t>(tags[i])).second);
+		}
+	}
+	CHECK(*completed.begin() == 0);
+	CHECK(*completed.rbegin() == 9);
+	CHECK(fdb_completion_queue_poll(queue, polled, tags, 4, 0.0) == 0);
+
+	fdb_completion_queue_destroy(queue);
+}
+
+TEST_CASE("fdb_completion_queue_destroy with pending futures") {
+	FDBCompletionQueue* queue;
+	fdb_check(fdb_create_completion_queue(&queue));
+
+	fdb::Transaction tr(db);
+	std::vector<std::unique_ptr<fdb::ValueFuture>> futures;
+	for (int i = 0; i < 10; ++i) {
+		futures.emplace_back(new fdb::ValueFuture(tr.get("foo", /*snapshot*/ true)));
+		fdb_check(futures.back()->set_completion_queue(queue, nullptr));
+	}
+
+	// The futures which complete after this are not delivered, and remain usable by their owner
+	fdb_completion_queue_destroy(queue);
+	for (auto& f : futures) {
+		fdb_check(f->block_until_ready());
+		CHECK(f->is_ready());
+	}
+}
+
 TEST_CASE("fdb_future_cancel after future completion") {
 	fdb::Transaction tr(db);
 	while (1) {
@@ -494,6 +547,42 @@ TEST_CASE("fdb_future_get_key") {
 	}
 }
 
+TEST_CASE("fdb_transaction_get_multi") {
+	insert_data(db, create_data({ { "a", "1" }, { "b", "2" }, { "c", "3" } }));
+
+	std::vector<std::string> keys = { key("c"), key("missing"), key("a") };
+	std::vector<FDBKey> fdbKeys;
+	for (const auto& k : keys) {
+		fdbKeys.push_back(FDBKey{ (const uint8_t*)k.data(), (int)k.size() });
+	}
+
+	fdb::Transaction tr(db);
+	while (1) {
+		fdb::KeyValueArrayFuture f1 = tr.get_multi(fdbKeys.data(), fdbKeys.size(), /* snapshot */ false);
+
+		fdb_error_t err = wait_future(f1);
+		if (err) {
+			fdb::EmptyFuture f2 = tr.on_error(err);
+			fdb_check(wait_future(f2));
+			continue;
+		}
+
+		const FDBKeyValue* out_kv;
+		int out_count;
+		fdb_bool_t out_more;
+		fdb_check(f1.get(&out_kv, &out_count, &out_more));
+
+		// Missing keys are left out, and the rest come back in the order requested
+		CHECK(out_count == 2);
+		CHECK(!out_more);
+		CHECK(std::string((const char*)out_kv[0].key, out_kv[0].key_length) == key("c"));
+		CHECK(std::string((const char*)out_kv[0].value, out_kv[0].value_length) == "3");
+		CHECK(std::string((const char*)out_kv[1].key, out_kv[1].key_length) == key("a"));
+		CHECK(std::string((const char*)out_kv[1].value, out_kv[1].value_length) == "1");
+		break;
+	}
+}
+
 TEST_CASE("fdb_future_get_value") {
 	insert_data(db, create_data({ { "foo", "bar" } }));
 
@@ -1223,6 +1312,45 @@ TEST_CASE("fdb_transaction_get_range reverse") {
 	}
 }
 
+TEST_CASE("fdb_transaction_get_range_parallel") {
+	std::map<std::string, std::string> data;
+	for (int i = 0; i < 100; ++i) {
+		data[key(format("%03d", i))] = std::string(1000, 'v');
+	}
+	insert_data(db, data);
+
+	fdb::Transaction tr(db);
+	while (1) {
+		// A chunk size much smaller than the range, so that the range is read as several chunks
+		fdb::KeyValueArrayFuture f1 = tr.get_range_parallel(key("000"),
+		                                                    key("100"),
+		                                                    /* parallelism */ 4,
+		                                                    /* chunk_size */ 10000,
+		                                                    /* snapshot */ true);
+
+		fdb_error_t err = wait_future(f1);
+		if (err) {
+			fdb::EmptyFuture f2 = tr.on_error(err);
+			fdb_check(wait_future(f2));
+			continue;
+		}
+
+		const FDBKeyValue* out_kv;
+		int out_count;
+		fdb_bool_t out_more;
+		fdb_check(f1.get(&out_kv, &out_count, &out_more));
+
+		CHECK(out_count == data.size());
+		CHECK(!out_more);
+		auto it = data.begin();
+		for (int i = 0; i < out_count && it != data.end(); ++i, ++it) {
+			CHECK(std::string((const char*)out_kv[i].key, out_kv[i].key_length) == it->first);
+			CHECK(std::string((const char*)out_kv[i].value, out_kv[i].value_length) == it->second);
+		}
+		break;
+	}
+}
+
 TEST_CASE("fdb_transaction_get_range limit") {
 	std::map<std::string, std::string> data = create_data({ { "a", "1" }, { "b", "2" }, { "c", "3" }, { "d", "4" } });
 	insert_data(db, data);
@@ -1309,6 +1309,43 @@ JNIEXPORT void JNICALL Java_com_apple_foundationdb_FDBTransaction_Transaction_1s
 	jenv->ReleaseByteArrayElements(valueBytes, (jbyte*)barrValue, JNI_ABORT);
 }
 
+// data holds each key followed by its value, and lengths holds the length of each key followed by that of its value
+JNIEXPORT void JNICALL Java_com_apple_foundationdb_FDBTransaction_Transaction_1setAll(JNIEnv* jenv,
+                                                                                      jobject,
+                                                                                      jlong tPtr,
+                                                                                      jbyteArray dataBytes,
+                                                                                      jintArray lengthInts) {
+	if (!tPtr || !dataBytes || !lengthInts) {
+		throwParamNotNull(jenv);
+		return;
+	}
+	FDBTransaction* tr = (FDBTransaction*)tPtr;
+
+	uint8_t* barr = (uint8_t*)jenv->GetByteArrayElements(dataBytes, JNI_NULL);
+	if (!barr) {
+		if (!jenv->ExceptionOccurred())
+			throwRuntimeEx(jenv, "Error getting handle to native resources");
+		return;
+	}
+
+	jint* lengths = jenv->GetIntArrayElements(lengthInts, JNI_NULL);
+	if (!lengths) {
+		jenv->ReleaseByteArrayElements(dataBytes, (jbyte*)barr, JNI_ABORT);
+		if (!jenv->ExceptionOccurred())
+			throwRuntimeEx(jenv, "Error getting handle to native resources");
+		return;
+	}
+
+	const uint8_t* p = barr;
+	const jsize count = jenv->GetArrayLength(lengthInts);
+	for (jsize i = 0; i + 1 < count; i += 2) {
+		fdb_transaction_set(tr, p, lengths[i], p + lengths[i], lengths[i + 1]);
+		p += lengths[i] + lengths[i + 1];
+	}
+	jenv->ReleaseIntArrayElements(lengthInts, lengths, JNI_ABORT);
+	jenv->ReleaseByteArrayElements(dataBytes, (jbyte*)barr, JNI_ABORT);
+}
+
 JNIEXPORT void JNICALL Java_com_apple_foundationdb_FDBTransaction_Transaction_1clear__J_3B(JNIEnv* jenv,
                                                                                            jobject,
                                                                                            jlong tPtr,
@@ -19,6 +19,8 @@
  */
 package com.apple.foundationdb;
 
+import java.util.ArrayList;
+import java.util.List;
 import java.util.concurrent.CompletableFuture;
 import java.util.concurrent.CompletionException;
 import java.util.function.Consumer;
@@ -74,6 +76,32 @@ public class TransactionIntegrationTest {
         });
     }
 
+    @Test
+    public void testSetAll() throws Exception {
+        try (Database db = fdb.open()) {
+            List<KeyValue> keyValues = new ArrayList<>();
+            for (int i = 0; i < 100; i++) {
+                keyValues.add(new KeyValue(("setAll" + i).getBytes(), ("value" + i).getBytes()));
+            }
+            // Later sets of the same key win, as they would if set one at a time
+            keyValues.add(new KeyValue("setAll0".getBytes(), "last".getBytes()));
+            keyValues.add(new KeyValue("setAllEmpty".getBytes(), new byte[0]));
+
+            db.run(tr -> {
+                tr.clear(Range.startsWith("setAll".getBytes()));
+                tr.setAll(keyValues);
+                return null;
+            });
+            db.read(tr -> {
+                Assertions.assertArrayEquals("last".getBytes(), tr.get("setAll0".getBytes()).join());
+                Assertions.assertArrayEquals("value42".getBytes(), tr.get("setAll42".getBytes()).join());
+                Assertions.assertArrayEquals(new byte[0], tr.get("setAllEmpty".getBytes()).join());
+                Assertions.assertEquals(101, tr.getRange(Range.startsWith("setAll".getBytes())).asList().join().size());
+                return null;
+            });
+        }
+    }
+
     private void expectUsedDuringCommitError(Runnable operation) {
         try {
             operation.run();
@@ -20,6 +20,7 @@
 
 package com.apple.foundationdb;
 
+import java.util.List;
 import java.util.concurrent.CompletableFuture;
 import java.util.concurrent.CompletionException;
 import java.util.concurrent.ExecutionException;
@@ -558,6 +559,41 @@ class FDBTransaction extends NativeObjectWrapper implements Transaction, OptionC
 		}
 	}
 
+	@Override
+	public void setAll(List<KeyValue> keyValues) {
+		// Pack the keys and values into one array so that they cross JNI in a single call
+		int[] lengths = new int[keyValues.size() * 2];
+		long totalLength = 0;
+		int i = 0;
+		for (KeyValue keyValue : keyValues) {
+			if (keyValue.getKey() == null || keyValue.getValue() == null)
+				throw new IllegalArgumentException("Keys/Values must be non-null");
+			lengths[i++] = keyValue.getKey().length;
+			lengths[i++] = keyValue.getValue().length;
+			totalLength += keyValue.getKey().length + keyValue.getValue().length;
+		}
+		if (totalLength > Integer.MAX_VALUE)
+			throw new IllegalArgumentException("Keys/Values are too large to set at once");
+		byte[] data = new byte[(int)totalLength];
+		int offset = 0;
+		for (KeyValue keyValue : keyValues) {
+			System.arraycopy(keyValue.getKey(), 0, data, offset, keyValue.getKey().length);
+			offset += keyValue.getKey().length;
+			System.arraycopy(keyValue.getValue(), 0, data, offset, keyValue.getValue().length);
+			offset += keyValue.getValue().length;
+		}
+
+		if (eventKeeper != null) {
+			eventKeeper.increment(Events.JNI_CALL);
+		}
+		pointerReadLock.lock();
+		try {
+			Transaction_setAll(getPtr(), data, lengths);
+		} finally {
+			pointerReadLock.unlock();
+		}
+	}
+
 	@Override
 	public void clear(byte[] key) {
 		if (key == null)
@@ -821,6 +857,7 @@ class FDBTransaction extends NativeObjectWrapper implements Transaction, OptionC
 	private native void Transaction_addConflictRange(long cPtr,
 			byte[] keyBegin, byte[] keyEnd, int conflictRangeType);
 	private native void Transaction_set(long cPtr, byte[] key, byte[] value);
+	private native void Transaction_setAll(long cPtr, byte[] data, int[] lengths);
 	private native void Transaction_clear(long cPtr, byte[] key);
 	private native void Transaction_clear(long cPtr, byte[] beginKey, byte[] endKey);
 	private native void Transaction_mutate(long ptr, int code, byte[] key, byte[] value);
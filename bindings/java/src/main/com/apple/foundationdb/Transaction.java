@@ -20,6 +20,7 @@
 
 package com.apple.foundationdb;
 
+import java.util.List;
 import java.util.concurrent.CompletableFuture;
 import java.util.function.Function;
 
@@ -126,6 +127,23 @@ public interface Transaction extends AutoCloseable, ReadTransaction, Transaction
 	 */
 	void set(byte[] key, byte[] value);
 
+	/**
+	 * Sets the values for several keys, as if {@link #set(byte[], byte[])} were called
+	 *  for each of them in order. Implementations may pass all of them to the native
+	 *  client at once, which is cheaper than setting them one at a time.
+	 *  This will not affect the database until {@link #commit} is called.
+	 *
+	 * @param keyValues the keys to set, each with the value to set it to
+	 *
+	 * @throws IllegalArgumentException if any key or value is {@code null}
+	 * @throws FDBException if a set operation otherwise fails
+	 */
+	default void setAll(List<KeyValue> keyValues) {
+		for (KeyValue keyValue : keyValues) {
+			set(keyValue.getKey(), keyValue.getValue());
+		}
+	}
+
 	/**
 	 * Clears a given key from the database. This will not affect the
 	 * database until {@link #commit} is called.
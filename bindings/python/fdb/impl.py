@@ -376,7 +376,7 @@ class FDBRange(object):
 
     """
 
-    def __init__(self, tr, begin, end, limit, reverse, streaming_mode):
+    def __init__(self, tr, begin, end, limit, reverse, streaming_mode, views=False):
         self._tr = tr
 
         self._bsel = begin
@@ -385,6 +385,7 @@ class FDBRange(object):
         self._limit = limit
         self._reverse = reverse
         self._mode = streaming_mode
+        self._views = views
 
         self._future = self._tr._get_range(
             begin, end, limit, streaming_mode, 1, reverse
@@ -415,7 +416,10 @@ class FDBRange(object):
 
         while not done:
             if future:
-                (kvs, count, more) = future.wait()
+                if self._views:
+                    (kvs, count, more) = future.wait_views()
+                else:
+                    (kvs, count, more) = future.wait()
                 index = 0
                 future = None
 
@@ -432,10 +436,11 @@ class FDBRange(object):
                     iteration += 1
                     if limit > 0:
                         limit = limit - count
+                    last_key = bytes(kvs[-1].key)
                     if self._reverse:
-                        esel = KeySelector.first_greater_or_equal(kvs[-1].key)
+                        esel = KeySelector.first_greater_or_equal(last_key)
                     else:
-                        bsel = KeySelector.first_greater_than(kvs[-1].key)
+                        bsel = KeySelector.first_greater_than(last_key)
                     future = self._tr._get_range(
                         bsel, esel, limit, mode, iteration, self._reverse
                     )
@@ -507,7 +512,13 @@ class TransactionRead(_FDBBase):
         return key_or_selector
 
     def get_range(
-        self, begin, end, limit=0, reverse=False, streaming_mode=StreamingMode.iterator
+        self,
+        begin,
+        end,
+        limit=0,
+        reverse=False,
+        streaming_mode=StreamingMode.iterator,
+        views=False,
     ):
         if begin is None:
             begin = b""
@@ -515,7 +526,7 @@ class TransactionRead(_FDBBase):
             end = b"\xff"
         begin = self._to_selector(begin)
         end = self._to_selector(end)
-        return FDBRange(self, begin, end, limit, reverse, streaming_mode)
+        return FDBRange(self, begin, end, limit, reverse, streaming_mode, views)
 
     def get_range_startswith(self, prefix, *args, **kwargs):
         prefix = keyToBytes(prefix)
@@ -806,6 +817,41 @@ class Future(_FDBBase):
         raise NotImplementedError()
 
 
+class _CompletionQueue(object):
+    """Collects callbacks made ready on the network thread and runs them in
+    batches on the event loop thread, so that the loop is woken once per batch
+    of completed futures rather than once per future.  An exception raised by
+    a callback goes to call_exception_handler, as the event loop would handle
+    it, and does not stop the rest of the batch."""
+
+    def __init__(self, call_soon_threadsafe, call_exception_handler):
+        self._call_soon_threadsafe = call_soon_threadsafe
+        self._call_exception_handler = call_exception_handler
+        self._lock = threading.Lock()
+        self._pending = []
+
+    def call_soon_threadsafe(self, fn, *args):
+        with self._lock:
+            self._pending.append((fn, args))
+            if len(self._pending) > 1:
+                return
+        self._call_soon_threadsafe(self._drain)
+
+    def _drain(self):
+        with self._lock:
+            pending, self._pending = self._pending, []
+        for fn, args in pending:
+            try:
+                fn(*args)
+            except Exception as e:
+                self._call_exception_handler(
+                    {
+                        "message": "Exception in FDB future callback %r" % (fn,),
+                        "exception": e,
+                    }
+                )
+
+
 class FutureVoid(Future):
     def wait(self):
         self.block_until_ready()
@@ -855,6 +901,38 @@ class FutureKeyValueArray(Future):
         # the KVs on the python side and in most cases we are about to
         # destroy the future anyway
 
+    def wait_views(self):
+        """Like wait(), but the keys and values are read-only memoryviews of
+        the result held by this future instead of copies. Each memoryview
+        keeps the future, and so the memory it refers to, alive."""
+        self.block_until_ready()
+        kvs = ctypes.pointer(KeyValueStruct())
+        count = ctypes.c_int()
+        more = ctypes.c_int()
+        self.capi.fdb_future_get_keyvalue_array(
+            self.fpointer, ctypes.byref(kvs), ctypes.byref(count), ctypes.byref(more)
+        )
+        return (
+            [
+                KeyValue(
+                    self._view(x.key, x.key_length),
+                    self._view(x.value, x.value_length),
+                )
+                for x in kvs[0 : count.value]
+            ],
+            count.value,
+            more.value,
+        )
+
+    def _view(self, pointer, length):
+        if not length:
+            return memoryview(b"")
+        buffer = (ctypes.c_char * length).from_address(
+            ctypes.cast(pointer, ctypes.c_void_p).value
+        )
+        buffer._future = self
+        return memoryview(buffer).cast("B").toreadonly()
+
 
 class FutureKeyArray(Future):
     def wait(self):
@@ -2035,10 +2113,11 @@ def init(event_model=None):
                             raise Exception("Future not ready")
 
                     Future.block_until_ready = _do_not_block
-                    Future.call_soon_threadsafe = (
-                        asyncio.get_event_loop().call_soon_threadsafe
-                    )
-                    Future._loop = asyncio.get_event_loop()
+                    loop = asyncio.get_event_loop()
+                    Future.call_soon_threadsafe = _CompletionQueue(
+                        loop.call_soon_threadsafe, loop.call_exception_handler
+                    ).call_soon_threadsafe
+                    Future._loop = loop
 
                     def iterate(self):
                         """Usage:
@@ -22,6 +22,7 @@
 import argparse
 import os
 import sys
+import threading
 import time
 import traceback
 import json
@@ -210,6 +211,47 @@ def test_predicates():
     assert not fdb.predicates.is_retryable(fdb.FDBError(10))
 
 
+def test_completion_queue():
+    wakeups = []
+    errors = []
+    queue = fdb.impl._CompletionQueue(wakeups.append, errors.append)
+    ran = []
+
+    def fail():
+        raise Exception("callback failed")
+
+    # The loop is woken once for a batch, and a failing callback goes to the
+    # loop's exception handler without stopping the rest of the batch
+    for i in range(5):
+        queue.call_soon_threadsafe(ran.append, i)
+        if i == 2:
+            queue.call_soon_threadsafe(fail)
+    assert len(wakeups) == 1
+    wakeups.pop()()
+    assert ran == list(range(5))
+    assert len(errors) == 1 and str(errors[0]["exception"]) == "callback failed"
+
+    # Callbacks queued from several threads all run, with a wake-up for each batch that was drained
+    def enqueue(t):
+        for i in range(1000):
+            queue.call_soon_threadsafe(ran.append, (t, i))
+
+    del ran[:]
+    drains = 0
+    threads = [threading.Thread(target=enqueue, args=(t,)) for t in range(4)]
+    for thread in threads:
+        thread.start()
+    while any(thread.is_alive() for thread in threads) or wakeups:
+        if wakeups:
+            wakeups.pop(0)()
+            drains += 1
+    for thread in threads:
+        thread.join()
+    assert not wakeups
+    assert sorted(ran) == [(t, i) for t in range(4) for i in range(1000)]
+    assert 1 <= drains <= len(ran)
+
+
 def test_get_client_status(db):
     @fdb.transactional
     def simple_txn(tr):
@@ -226,6 +268,23 @@ def test_get_client_status(db):
     assert status["Healthy"]
 
 
+@fdb.transactional
+def test_get_range_views(tr):
+    tr.clear_range(b"views/", b"views0")
+    for i in range(10):
+        tr[b"views/%02d" % i] = b"value%d" % i
+    # The small streaming mode may read the range in several batches
+    kvs = list(
+        tr.get_range(
+            b"views/", b"views0", streaming_mode=fdb.StreamingMode.small, views=True
+        )
+    )
+    assert [bytes(kv.key) for kv in kvs] == [b"views/%02d" % i for i in range(10)]
+    assert [bytes(kv.value) for kv in kvs] == [b"value%d" % i for i in range(10)]
+    assert all(kv.key.readonly and kv.value.readonly for kv in kvs)
+    tr.clear_range(b"views/", b"views0")
+
+
 def run_unit_tests(db):
     try:
         log("test_db_options")
@@ -250,12 +309,16 @@ def run_unit_tests(db):
         test_locality(db)
         log("test_predicates")
         test_predicates()
+        log("test_completion_queue")
+        test_completion_queue()
         log("test_size_limit_option")
         test_size_limit_option(db)
         log("test_get_approximate_size")
         test_get_approximate_size(db)
         log("test_get_client_status")
         test_get_client_status(db)
+        log("test_get_range_views")
+        test_get_range_views(db)
 
     except fdb.FDBError as e:
         print("Unit tests failed: %s" % e.description)
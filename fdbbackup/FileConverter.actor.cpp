@@ -175,11 +175,13 @@ struct MutationFilesReadProgress : public ReferenceCounted<MutationFilesReadProg
 			StringRefReader reader(block, restore_corrupted_data());
 			int count = 0, inserted = 0;
 			Version msgVersion = invalidVersion;
+			// Holds the block and, for compressed blocks, its decompressed mutations
+			Arena arena;
+			arena.dependsOn(buf.arena());
 
 			try {
-				// Read block header
-				if (reader.consume<int32_t>() != PARTITIONED_MLOG_VERSION)
-					throw restore_unsupported_file_version();
+				// Read block header, decompressing the block's mutations if needed
+				reader = StringRefReader(decodePartitionedLogBlock(block, arena), restore_corrupted_data());
 
 				while (1) {
 					// If eof reached or first key len bytes is 0xFF then end of block was reached.
@@ -192,8 +194,7 @@ struct MutationFilesReadProgress : public ReferenceCounted<MutationFilesReadProg
 					int msgSize = bigEndian32(reader.consume<int>());
 					const uint8_t* message = reader.consume(msgSize);
 
-					ArenaReader rd(
-					    buf.arena(), StringRef(message, msgSize), AssumeVersion(g_network->protocolVersion()));
+					ArenaReader rd(arena, StringRef(message, msgSize), AssumeVersion(g_network->protocolVersion()));
 					MutationRef m;
 					rd >> m;
 					count++;
@@ -206,8 +207,7 @@ struct MutationFilesReadProgress : public ReferenceCounted<MutationFilesReadProg
 						break; // skip
 					}
 					if (msgVersion >= minVersion) {
-						mutations.emplace_back(
-						    LogMessageVersion(msgVersion, sub), StringRef(message, msgSize), buf.arena());
+						mutations.emplace_back(LogMessageVersion(msgVersion, sub), StringRef(message, msgSize), arena);
 						inserted++;
 					}
 				}
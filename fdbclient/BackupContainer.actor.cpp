@@ -30,6 +30,7 @@
 #include "fdbclient/FDBTypes.h"
 #include "fdbclient/JsonBuilder.h"
 #include "flow/Arena.h"
+#include "flow/CompressionUtils.h"
 #include "flow/Trace.h"
 #include "flow/UnitTest.h"
 #include "flow/Hash3.h"
@@ -68,6 +69,34 @@ Future<Void> IBackupFile::appendStringRefWithLen(Standalone<StringRef> s) {
 	return IBackupFile_impl::appendStringRefWithLen(Reference<IBackupFile>::addRef(this), s);
 }
 
+StringRef decodePartitionedLogBlock(StringRef block, Arena& arena) {
+	StringRefReader reader(block, restore_corrupted_data());
+	const uint32_t version = reader.consume<uint32_t>();
+	if (version == PARTITIONED_MLOG_VERSION) {
+		return reader.remainder();
+	}
+	if (version != PARTITIONED_MLOG_COMPRESSED_VERSION) {
+		throw restore_unsupported_file_version();
+	}
+	const uint8_t filter = reader.consume<uint8_t>();
+	if (filter >= (uint8_t)CompressionFilter::LAST) {
+		throw restore_corrupted_data();
+	}
+	const int32_t len = reader.consumeNetworkInt32();
+	if (len < 0 || len > reader.remainder().size()) {
+		throw restore_corrupted_data();
+	}
+	try {
+		return CompressionUtils::decompress((CompressionFilter)filter, StringRef(reader.consume(len), len), arena);
+	} catch (Error& e) {
+		// The compressed data does not decode, or does not record how large it is
+		if (e.code() == error_code_serialization_failed || e.code() == error_code_internal_error) {
+			throw restore_corrupted_data();
+		}
+		throw;
+	}
+}
+
 bool isBlobstoreUrl(const std::string& url) {
 	return url.find("blobstore://") == 0;
 }
@@ -133,6 +133,23 @@ public:
 	static constexpr Version NON_PARTITIONED_MUTATION_LOG = 0;
 	static constexpr Version PARTITIONED_MUTATION_LOG = 1;
 
+	// Lists the partitioned and non-partitioned log files in the given version range. Listing the non-partitioned
+	// logs is skipped if logType says the container holds partitioned logs, which saves the LIST calls of a folder
+	// such backups never write to. Only the partitioned type is trusted, as describe can record the non-partitioned
+	// type before a partitioned backup has written any logs.
+	static Future<Void> listLogFiles(Reference<BackupContainerFileSystem> bc,
+	                                 Version beginVersion,
+	                                 Version targetVersion,
+	                                 Optional<Version> logType,
+	                                 std::vector<LogFile>* logs,
+	                                 std::vector<LogFile>* plogs) {
+		Future<Void> listed = store(*plogs, bc->listLogFiles(beginVersion, targetVersion, true));
+		if (!logType.present() || logType.get() != PARTITIONED_MUTATION_LOG) {
+			listed = listed && store(*logs, bc->listLogFiles(beginVersion, targetVersion, false));
+		}
+		return listed;
+	}
+
 	// Find what should be the filename of a path by finding whatever is after the last forward or backward slash, or
 	// failing to find those, the whole string.
 	static std::string fileNameOnly(const std::string& path) {
@@ -612,8 +629,8 @@ public:
 		state std::vector<LogFile> plogs;
 		TraceEvent("BackupContainerListFiles").detail("URL", bc->getURL());
 
-		wait(store(logs, bc->listLogFiles(scanBegin, scanEnd, false)) &&
-		     store(plogs, bc->listLogFiles(scanBegin, scanEnd, true)) &&
+		// A deep scan lists everything rather than trusting the log type metadata
+		wait(listLogFiles(bc, scanBegin, scanEnd, deepScan ? Optional<Version>() : metaLogType, &logs, &plogs) &&
 		     store(desc.snapshots, bc->listKeyspaceSnapshots()));
 
 		TraceEvent("BackupContainerListFiles")
@@ -1079,6 +1096,17 @@ public:
 			}
 		}
 
+		// The log type lets the log listing below skip the folder of the other log type. It is only an optimization,
+		// so failing to read it is not an error.
+		state Optional<Version> logType;
+		try {
+			wait(store(logType, bc->logType().get()));
+		} catch (Error& e) {
+			if (e.code() == error_code_actor_cancelled) {
+				throw;
+			}
+		}
+
 		// Find the most recent keyrange snapshot through which we can restore filtered key ranges into targetVersion.
 		state std::vector<KeyspaceSnapshotFile> snapshots = wait(bc->listKeyspaceSnapshots());
 		state int i = snapshots.size() - 1;
@@ -1139,8 +1167,7 @@ public:
 			// FIXME: check if there are tagged logs. for each tag, there is no version gap.
 			state std::vector<LogFile> logs;
 			state std::vector<LogFile> plogs;
-			wait(store(logs, bc->listLogFiles(minKeyRangeVersion, restorable.targetVersion, false)) &&
-			     store(plogs, bc->listLogFiles(minKeyRangeVersion, restorable.targetVersion, true)));
+			wait(listLogFiles(bc, minKeyRangeVersion, restorable.targetVersion, logType, &logs, &plogs));
 
 			if (plogs.size() > 0) {
 				logs.swap(plogs);
@@ -41,6 +41,7 @@
 #include "flow/Trace.h"
 #include "flow/UnitTest.h"
 
+#include <atomic>
 #include <chrono>
 #include <cstring>
 #include <limits>
@@ -50,6 +51,7 @@
 #include <type_traits>
 #include <utility>
 #include <variant>
+#include <vector>
 
 #ifndef _WIN32
 #include <unistd.h>
@@ -105,6 +107,86 @@ void validateEncryptHeaderAlgoHeaderVersion(const EncryptCipherMode cipherMode,
 		throw not_implemented();
 	}
 }
+
+// Every page, log message and backup block gets its own encryptor or decryptor, so allocating a cipher context and
+// selecting the cipher for each one shows up in profiles. Contexts are instead kept in a small per-thread cache and
+// handed out already set up for AES-256-CTR, leaving only the key and IV to be loaded.
+constexpr int MAX_CACHED_CIPHER_CTX = 16;
+
+// A released context still holds the key schedule of the last key it was used with. This is bumped when keys rotate
+// or are dropped, and each thread then frees its cached contexts, which cleanses that key material, instead of
+// handing them out again.
+std::atomic<uint64_t> cipherCtxCacheGeneration{ 0 };
+
+struct CipherCtxCache {
+	std::vector<EVP_CIPHER_CTX*> free;
+	uint64_t generation = 0;
+
+	void clear() {
+		for (EVP_CIPHER_CTX* ctx : free) {
+			EVP_CIPHER_CTX_free(ctx);
+		}
+		free.clear();
+	}
+
+	~CipherCtxCache() { clear(); }
+};
+
+// Returns the calling thread's cache and whether it had to be cleared because keys rotated since it was last used
+std::pair<CipherCtxCache*, bool> cipherCtxCache() {
+	thread_local CipherCtxCache cache;
+	const uint64_t generation = cipherCtxCacheGeneration.load(std::memory_order_acquire);
+	if (cache.generation == generation) {
+		return { &cache, false };
+	}
+	cache.clear();
+	cache.generation = generation;
+	return { &cache, true };
+}
+
+void invalidateCachedCipherCtxs() {
+	cipherCtxCacheGeneration.fetch_add(1, std::memory_order_acq_rel);
+}
+
+EVP_CIPHER_CTX* acquireCipherCtx() {
+	CipherCtxCache* cache = cipherCtxCache().first;
+	if (cache->free.empty()) {
+		return EVP_CIPHER_CTX_new();
+	}
+	EVP_CIPHER_CTX* ctx = cache->free.back();
+	cache->free.pop_back();
+	return ctx;
+}
+
+void releaseCipherCtx(EVP_CIPHER_CTX* ctx) {
+	std::pair<CipherCtxCache*, bool> cache = cipherCtxCache();
+	// If keys rotated since this thread last used the cache, the context may hold one of the old keys
+	if (!cache.second && cache.first->free.size() < MAX_CACHED_CIPHER_CTX) {
+		cache.first->free.push_back(ctx);
+	} else {
+		EVP_CIPHER_CTX_free(ctx);
+	}
+}
+
+bool isAes256CtrCtx(EVP_CIPHER_CTX* ctx) {
+	// EVP_CIPHER_CTX_cipher() may return a different object for the same cipher than EVP_aes_256_ctr(), for instance
+	// when OpenSSL fetches the implementation from a provider, so compare the cipher's NID
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+	return EVP_CIPHER_CTX_get_nid(ctx) == NID_aes_256_ctr;
+#else
+	return EVP_CIPHER_CTX_cipher(ctx) != nullptr && EVP_CIPHER_CTX_nid(ctx) == NID_aes_256_ctr;
+#endif
+}
+
+// A cached context still has AES-256-CTR selected, so the cipher is only set up for new contexts. Setting the key
+// and IV alone leaves the cipher state in place.
+bool initCipherCtx(EVP_CIPHER_CTX* ctx, const uint8_t* key, const uint8_t* iv, bool encrypt) {
+	if (ctx == nullptr) {
+		return false;
+	}
+	const EVP_CIPHER* cipher = isAes256CtrCtx(ctx) ? nullptr : EVP_aes_256_ctr();
+	return EVP_CipherInit_ex(ctx, cipher, nullptr, key, iv, encrypt ? 1 : 0) == 1;
+}
 } // namespace
 
 // BlobCipherEncryptHeaderRef
@@ -347,6 +429,7 @@ BlobCipherMetrics::BlobCipherMetrics()
     cipherKeyCacheExpired("CipherKeyCacheExpired", cc), latestCipherKeyCacheHit("LatestCipherKeyCacheHit", cc),
     latestCipherKeyCacheMiss("LatestCipherKeyCacheMiss", cc),
     latestCipherKeyCacheNeedsRefresh("LatestCipherKeyCacheNeedsRefresh", cc),
+    latestCipherKeyCacheBackgroundRefresh("LatestCipherKeyCacheBackgroundRefresh", cc),
     getBlobMetadataLatency("GetBlobMetadataLatency",
                            UID(),
                            FLOW_KNOBS->ENCRYPT_KEY_CACHE_LOGGING_INTERVAL,
@@ -497,6 +580,7 @@ void BlobCipherKey::applyHmacSha256Derivation() {
 void BlobCipherKey::reset() {
 	memset(baseCipher.get(), 0, baseCipherLen);
 	memset(cipher.get(), 0, AES_256_KEY_LENGTH);
+	invalidateCachedCipherCtxs();
 }
 
 // BlobKeyIdCache class methods
@@ -515,7 +599,7 @@ BlobCipherKeyIdCacheKey BlobCipherKeyIdCache::getCacheKey(const EncryptCipherBas
 	return std::make_pair(baseCipherKeyId, salt);
 }
 
-Reference<BlobCipherKey> BlobCipherKeyIdCache::getLatestCipherKey() {
+Reference<BlobCipherKey> BlobCipherKeyIdCache::getLatestCipherKey(bool* needsRefresh) {
 	if (!latestBaseCipherKeyId.present()) {
 		return Reference<BlobCipherKey>();
 	}
@@ -543,6 +627,10 @@ Reference<BlobCipherKey> BlobCipherKeyIdCache::getLatestCipherKey() {
 		    .detail("ExpireAt", latest->getExpireAtTS());
 #endif
 		++BlobCipherMetrics::getInstance()->latestCipherKeyCacheNeedsRefresh;
+		if (needsRefresh != nullptr) {
+			*needsRefresh = true;
+			return latest;
+		}
 		latestBaseCipherKeyId.reset();
 		latestRandomSalt.reset();
 		return Reference<BlobCipherKey>();
@@ -627,6 +715,11 @@ Reference<BlobCipherKey> BlobCipherKeyIdCache::insertBaseCipherKey(const Encrypt
 	auto result = keyIdCache.emplace(cacheKey, cipherKey);
 	ASSERT(result.second);
 
+	// Cached cipher contexts must not keep the key schedule of the key being rotated out
+	if (latestCipherKey.isValid()) {
+		invalidateCachedCipherCtxs();
+	}
+
 	// Update the latest BaseCipherKeyId for the given encryption domain
 	latestBaseCipherKeyId = baseCipherId;
 	latestRandomSalt = cipherKey->getSalt();
@@ -786,7 +879,8 @@ Reference<BlobCipherKey> BlobCipherKeyCache::insertCipherKey(const EncryptCipher
 	return cipherKey;
 }
 
-Reference<BlobCipherKey> BlobCipherKeyCache::getLatestCipherKey(const EncryptCipherDomainId& domainId) {
+Reference<BlobCipherKey> BlobCipherKeyCache::getLatestCipherKey(const EncryptCipherDomainId& domainId,
+                                                                bool* needsRefresh) {
 	if (domainId == INVALID_ENCRYPT_DOMAIN_ID) {
 		TraceEvent(SevWarn, "BlobCipherGetLatestCipherKeyInvalidID").detail("DomainId", domainId);
 		throw encrypt_invalid_id();
@@ -798,7 +892,7 @@ Reference<BlobCipherKey> BlobCipherKeyCache::getLatestCipherKey(const EncryptCip
 	}
 
 	Reference<BlobCipherKeyIdCache> keyIdCache = domainItr->second;
-	Reference<BlobCipherKey> cipherKey = keyIdCache->getLatestCipherKey();
+	Reference<BlobCipherKey> cipherKey = keyIdCache->getLatestCipherKey(needsRefresh);
 
 	cipherKey.isValid() ? ++BlobCipherMetrics::getInstance()->latestCipherKeyCacheHit
 	                    : ++BlobCipherMetrics::getInstance()->latestCipherKeyCacheMiss;
@@ -896,7 +990,7 @@ EncryptBlobCipherAes265Ctr::EncryptBlobCipherAes265Ctr(Reference<BlobCipherKey>
                                                        const int ivLen,
                                                        const EncryptAuthTokenMode mode,
                                                        BlobCipherMetrics::UsageType usageType)
-  : ctx(EVP_CIPHER_CTX_new()), textCipherKey(tCipherKey), headerCipherKeyOpt(hCipherKeyOpt), authTokenMode(mode) {
+  : ctx(acquireCipherCtx()), textCipherKey(tCipherKey), headerCipherKeyOpt(hCipherKeyOpt), authTokenMode(mode) {
 	ASSERT_EQ(ivLen, AES_256_IV_LENGTH);
 	authTokenAlgo = getAuthTokenAlgoFromMode(authTokenMode);
 	memcpy(&iv[0], cipherIV, ivLen);
@@ -910,7 +1004,7 @@ EncryptBlobCipherAes265Ctr::EncryptBlobCipherAes265Ctr(Reference<BlobCipherKey>
                                                        const EncryptAuthTokenMode mode,
                                                        const EncryptAuthTokenAlgo algo,
                                                        BlobCipherMetrics::UsageType usageType)
-  : ctx(EVP_CIPHER_CTX_new()), textCipherKey(tCipherKey), headerCipherKeyOpt(hCipherKeyOpt), authTokenMode(mode),
+  : ctx(acquireCipherCtx()), textCipherKey(tCipherKey), headerCipherKeyOpt(hCipherKeyOpt), authTokenMode(mode),
     authTokenAlgo(algo) {
 	ASSERT_EQ(ivLen, AES_256_IV_LENGTH);
 	memcpy(&iv[0], cipherIV, ivLen);
@@ -921,7 +1015,7 @@ EncryptBlobCipherAes265Ctr::EncryptBlobCipherAes265Ctr(Reference<BlobCipherKey>
                                                        Optional<Reference<BlobCipherKey>> hCipherKeyOpt,
                                                        const EncryptAuthTokenMode mode,
                                                        BlobCipherMetrics::UsageType usageType)
-  : ctx(EVP_CIPHER_CTX_new()), textCipherKey(tCipherKey), headerCipherKeyOpt(hCipherKeyOpt), authTokenMode(mode) {
+  : ctx(acquireCipherCtx()), textCipherKey(tCipherKey), headerCipherKeyOpt(hCipherKeyOpt), authTokenMode(mode) {
 	authTokenAlgo = getAuthTokenAlgoFromMode(authTokenMode);
 	deterministicRandom()->randomBytes(iv, AES_256_IV_LENGTH);
 	init();
@@ -932,7 +1026,7 @@ EncryptBlobCipherAes265Ctr::EncryptBlobCipherAes265Ctr(Reference<BlobCipherKey>
                                                        const EncryptAuthTokenMode mode,
                                                        const EncryptAuthTokenAlgo algo,
                                                        BlobCipherMetrics::UsageType usageType)
-  : ctx(EVP_CIPHER_CTX_new()), textCipherKey(tCipherKey), headerCipherKeyOpt(hCipherKeyOpt), authTokenMode(mode),
+  : ctx(acquireCipherCtx()), textCipherKey(tCipherKey), headerCipherKeyOpt(hCipherKeyOpt), authTokenMode(mode),
     authTokenAlgo(algo) {
 	deterministicRandom()->randomBytes(iv, AES_256_IV_LENGTH);
 	init();
@@ -951,13 +1045,7 @@ void EncryptBlobCipherAes265Ctr::init() {
 		throw internal_error();
 	}
 
-	if (ctx == nullptr) {
-		throw encrypt_ops_error();
-	}
-	if (EVP_EncryptInit_ex(ctx, EVP_aes_256_ctr(), nullptr, nullptr, nullptr) != 1) {
-		throw encrypt_ops_error();
-	}
-	if (EVP_EncryptInit_ex(ctx, nullptr, nullptr, textCipherKey.getPtr()->data(), iv) != 1) {
+	if (!initCipherCtx(ctx, textCipherKey.getPtr()->data(), iv, true)) {
 		throw encrypt_ops_error();
 	}
 }
@@ -1298,7 +1386,7 @@ void EncryptBlobCipherAes265Ctr::encryptInplace(uint8_t* plaintext,
 
 EncryptBlobCipherAes265Ctr::~EncryptBlobCipherAes265Ctr() {
 	if (ctx != nullptr) {
-		EVP_CIPHER_CTX_free(ctx);
+		releaseCipherCtx(ctx);
 	}
 }
 
@@ -1308,15 +1396,9 @@ DecryptBlobCipherAes256Ctr::DecryptBlobCipherAes256Ctr(Reference<BlobCipherKey>
                                                        Optional<Reference<BlobCipherKey>> hCipherKeyOpt,
                                                        const uint8_t* iv,
                                                        BlobCipherMetrics::UsageType usageType)
-  : ctx(EVP_CIPHER_CTX_new()), textCipherKey(tCipherKey), headerCipherKeyOpt(hCipherKeyOpt),
+  : ctx(acquireCipherCtx()), textCipherKey(tCipherKey), headerCipherKeyOpt(hCipherKeyOpt),
     authTokensValidationDone(false) {
-	if (ctx == nullptr) {
-		throw encrypt_ops_error();
-	}
-	if (!EVP_DecryptInit_ex(ctx, EVP_aes_256_ctr(), nullptr, nullptr, nullptr)) {
-		throw encrypt_ops_error();
-	}
-	if (!EVP_DecryptInit_ex(ctx, nullptr, nullptr, tCipherKey.getPtr()->data(), iv)) {
+	if (!initCipherCtx(ctx, tCipherKey.getPtr()->data(), iv, false)) {
 		throw encrypt_ops_error();
 	}
 }
@@ -1732,7 +1814,7 @@ void DecryptBlobCipherAes256Ctr::decryptInplace(uint8_t* ciphertext,
 
 DecryptBlobCipherAes256Ctr::~DecryptBlobCipherAes256Ctr() {
 	if (ctx != nullptr) {
-		EVP_CIPHER_CTX_free(ctx);
+		releaseCipherCtx(ctx);
 	}
 }
 
@@ -56,6 +56,7 @@ void ClientKnobs::initialize(Randomize randomize, IsSimulated isSimulated) {
 	init( MAX_GENERATIONS_SIM,                      50 ); //Disable network connections after this many generations in simulation, should be less than RECOVERY_DELAY_START_GENERATION
 
 	init( COORDINATOR_RECONNECTION_DELAY,          1.0 );
+	init( COORDINATOR_RECONNECTION_MAX_DELAY,      1.0 ); if( randomize && BUGGIFY ) COORDINATOR_RECONNECTION_MAX_DELAY = 10.0;
 	init( CLIENT_EXAMPLE_AMOUNT,                    20 );
 	init( MAX_CLIENT_STATUS_AGE,                   1.0 );
 	init( MAX_COMMIT_PROXY_CONNECTIONS,              5 ); if( randomize && BUGGIFY ) MAX_COMMIT_PROXY_CONNECTIONS = 1;
@@ -75,6 +76,7 @@ void ClientKnobs::initialize(Randomize randomize, IsSimulated isSimulated) {
 	init( BACKOFF_GROWTH_RATE,                     2.0 );
 	init( RESOURCE_CONSTRAINED_MAX_BACKOFF,       30.0 );
 	init( PROXY_COMMIT_OVERHEAD_BYTES,              23 ); //The size of serializing 7 tags (3 primary, 3 remote, 1 log router) + 2 for the tag length
+	init( COALESCE_COMMIT_CONFLICT_RANGES,        true ); if( randomize && BUGGIFY ) COALESCE_COMMIT_CONFLICT_RANGES = false;
 	init( SHARD_STAT_SMOOTH_AMOUNT,                5.0 );
 	init( INIT_MID_SHARD_BYTES,               10000000 ); if( randomize && BUGGIFY ) INIT_MID_SHARD_BYTES = 40000; else if(randomize && BUGGIFY_WITH_PROB(0.75)) INIT_MID_SHARD_BYTES = 200000; // The same value as SERVER_KNOBS->MIN_SHARD_BYTES
 
@@ -85,6 +87,8 @@ void ClientKnobs::initialize(Randomize randomize, IsSimulated isSimulated) {
 	init( SPLIT_KEY_SIZE_LIMIT,                    KEY_SIZE_LIMIT/2 );  if( randomize && BUGGIFY ) SPLIT_KEY_SIZE_LIMIT = KEY_SIZE_LIMIT - 31;//serverKeysPrefixFor(UID()).size() - 1;
 	init( METADATA_VERSION_CACHE_SIZE,            1000 );
 	init( CHANGE_FEED_LOCATION_LIMIT,            10000 );
+	init( BATCH_GET_VALUES,                      false ); if( randomize && BUGGIFY ) BATCH_GET_VALUES = true; // Storage servers older than the client do not serve getValues
+	init( GET_VALUES_BATCH_MAX_KEYS,               100 ); if( randomize && BUGGIFY ) GET_VALUES_BATCH_MAX_KEYS = 2;
 	init( CHANGE_FEED_CACHE_SIZE,               100000 ); if( randomize && BUGGIFY ) CHANGE_FEED_CACHE_SIZE = 1;
 	init( CHANGE_FEED_POP_TIMEOUT,                10.0 );
 	init( CHANGE_FEED_STREAM_MIN_BYTES,            1e4 ); if( randomize && BUGGIFY ) CHANGE_FEED_STREAM_MIN_BYTES = 1;
@@ -103,8 +107,10 @@ void ClientKnobs::initialize(Randomize randomize, IsSimulated isSimulated) {
 	init( LOCATION_CACHE_EVICTION_SIZE_SIM,         10 ); if( randomize && BUGGIFY ) LOCATION_CACHE_EVICTION_SIZE_SIM = 3;
 	init( LOCATION_CACHE_ENDPOINT_FAILURE_GRACE_PERIOD,     60 );
 	init( LOCATION_CACHE_FAILED_ENDPOINT_RETRY_INTERVAL,    60 );
+	init( LOCATION_CACHE_PREFETCH_SHARDS,            4 ); if( randomize && BUGGIFY ) LOCATION_CACHE_PREFETCH_SHARDS = deterministicRandom()->randomInt(1, 10);
 
 	init( GET_RANGE_SHARD_LIMIT,                     2 );
+	init( GET_RANGE_COMPRESS_KEY_PREFIXES,       false ); if( randomize && BUGGIFY ) GET_RANGE_COMPRESS_KEY_PREFIXES = true;
 	init( WARM_RANGE_SHARD_LIMIT,                  100 );
 	init( STORAGE_METRICS_SHARD_LIMIT,             100 ); if( randomize && BUGGIFY ) STORAGE_METRICS_SHARD_LIMIT = 10;
 	init( SHARD_COUNT_LIMIT,                        80 ); if( randomize && BUGGIFY ) SHARD_COUNT_LIMIT = 3;
@@ -184,6 +190,7 @@ void ClientKnobs::initialize(Randomize randomize, IsSimulated isSimulated) {
 	init( COPY_LOG_PREFETCH_BLOCKS,                  3 );
 	init( COPY_LOG_READ_AHEAD_BYTES,        BACKUP_LOCK_BYTES / COPY_LOG_PREFETCH_BLOCKS); // each task will use up to COPY_LOG_PREFETCH_BLOCKS * COPY_LOG_READ_AHEAD_BYTES memory
 	init( COPY_LOG_TASK_DURATION_NANOS,	      1e10 ); // 10 seconds
+	init( COPY_LOG_MAX_PIPELINED_COMMITS,            4 ); if( randomize && BUGGIFY ) COPY_LOG_MAX_PIPELINED_COMMITS = deterministicRandom()->randomInt(0, 5);
 	init( BACKUP_TASKS_PER_AGENT,                   10 );
 	init( BACKUP_POLL_PROGRESS_SECONDS,             10 );
 	init( SIM_BACKUP_TASKS_PER_AGENT,               10 );
@@ -319,6 +326,7 @@ void ClientKnobs::initialize(Randomize randomize, IsSimulated isSimulated) {
 	init( TAG_THROTTLE_EXPIRATION_INTERVAL,        60.0 ); if( randomize && BUGGIFY ) TAG_THROTTLE_EXPIRATION_INTERVAL = 1.0;
 	init( TAG_THROTTLING_PAGE_SIZE,                4096 ); if( randomize && BUGGIFY ) TAG_THROTTLING_PAGE_SIZE = 4096;
 	init( GLOBAL_TAG_THROTTLING_RW_FUNGIBILITY_RATIO,            4.0 );
+	init( TAG_THROTTLING_CHARGE_ATOMIC_OP_READS,   true ); if( randomize && BUGGIFY ) TAG_THROTTLING_CHARGE_ATOMIC_OP_READS = false;
 	init( PROXY_MAX_TAG_THROTTLE_DURATION,          5.0 ); if( randomize && BUGGIFY ) PROXY_MAX_TAG_THROTTLE_DURATION = 0.5;
 	init( TRANSACTION_LOCK_REJECTION_RETRIABLE,    true );
 
@@ -335,6 +343,9 @@ void ClientKnobs::initialize(Randomize randomize, IsSimulated isSimulated) {
 	init( ENCRYPT_HEADER_AES_CTR_AES_CMAC_AUTH_VERSION, 1 );
 	init( ENCRYPT_HEADER_AES_CTR_HMAC_SHA_AUTH_VERSION, 1 );
 	init( ENCRYPT_GET_CIPHER_KEY_LONG_REQUEST_THRESHOLD, 6.0);
+	init( ENCRYPT_CIPHER_KEY_BACKGROUND_REFRESH,    false ); if ( randomize && BUGGIFY ) ENCRYPT_CIPHER_KEY_BACKGROUND_REFRESH = true;
+	init( ENCRYPT_CIPHER_KEY_REFRESH_JITTER,          1.0 );
+	init( ENCRYPT_CIPHER_KEY_REFRESH_TIMEOUT,        30.0 );
 
 	init( REST_KMS_ALLOW_NOT_SECURE_CONNECTION,     false ); if ( randomize && BUGGIFY ) REST_KMS_ALLOW_NOT_SECURE_CONNECTION = !REST_KMS_ALLOW_NOT_SECURE_CONNECTION;
 	init( SIM_KMS_VAULT_MAX_KEYS,                    4096 );
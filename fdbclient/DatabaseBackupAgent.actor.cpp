@@ -727,6 +727,61 @@ struct CopyLogRangeTaskFunc : TaskFuncBase {
 		return _finish(tr, tb, fb, task);
 	};
 
+	// Copies the given mutation log data into the apply mutations keyspace of the destination. If breakAfterVersion is
+	// set, stops at the first mutation of a later version and returns that version.
+	ACTOR static Future<Optional<Version>> commitMutations(Database cx,
+	                                                       Reference<Task> task,
+	                                                       std::vector<RangeResult> mutations,
+	                                                       Optional<Version> breakAfterVersion) {
+		state Transaction tr(cx);
+		loop {
+			state Optional<Version> nextVersionAfterBreak;
+			try {
+				tr.setOption(FDBTransactionOptions::LOCK_AWARE);
+				tr.trState->options.sizeLimit = 2 * CLIENT_KNOBS->TRANSACTION_SIZE_LIMIT;
+				wait(checkDatabaseLock(
+				    &tr,
+				    BinaryReader::fromStringRef<UID>(task->params[BackupAgentBase::keyConfigLogUid], Unversioned())));
+				state int64_t bytesSet = 0;
+
+				bool first = true;
+				for (auto m : mutations) {
+					for (auto kv : m) {
+						if (breakAfterVersion.present()) {
+							Version newVersion = getLogKeyVersion(kv.key);
+
+							if (newVersion > breakAfterVersion.get()) {
+								nextVersionAfterBreak = newVersion;
+								break;
+							}
+						}
+						if (first) {
+							tr.addReadConflictRange(singleKeyRange(kv.key));
+							first = false;
+						}
+						tr.set(kv.key.removePrefix(backupLogKeys.begin)
+						           .removePrefix(task->params[BackupAgentBase::destUid])
+						           .withPrefix(task->params[BackupAgentBase::keyConfigLogUid])
+						           .withPrefix(applyLogKeys.begin),
+						       kv.value);
+						bytesSet += kv.expectedSize() - backupLogKeys.begin.expectedSize() +
+						            applyLogKeys.begin.expectedSize();
+					}
+					// Later groups are of later versions, so nothing after the break can be copied either
+					if (nextVersionAfterBreak.present()) {
+						break;
+					}
+				}
+
+				wait(tr.commit());
+				Params.bytesWritten().set(task, Params.bytesWritten().getOrDefault(task) + bytesSet);
+				return nextVersionAfterBreak;
+			} catch (Error& e) {
+				wait(tr.onError(e));
+			}
+		}
+	}
+
 	// store mutation data from results until the end of stream or the timeout. If breaks on timeout returns the first
 	// uncopied version
 	ACTOR static Future<Optional<Version>> dumpData(Database cx,
@@ -741,12 +796,15 @@ struct CopyLogRangeTaskFunc : TaskFuncBase {
 		                          .get(task->params[BackupAgentBase::keyConfigLogUid]);
 		state std::vector<RangeResult> nextMutations;
 		state bool isTimeoutOccurred = false;
-		state Optional<KeyRef> lastKey;
+		state Optional<Key> lastKey;
 		state Version lastVersion;
 		state int64_t nextMutationSize = 0;
+		// Commits still in flight while the next batch is gathered, which are only pipelined until a timeout occurs
+		state std::vector<Future<Optional<Version>>> commits;
 		loop {
 			try {
 				if (endOfStream && !nextMutationSize) {
+					wait(waitForAll(commits));
 					return Optional<Version>();
 				}
 
@@ -783,59 +841,33 @@ struct CopyLogRangeTaskFunc : TaskFuncBase {
 					}
 				}
 
-				state Optional<Version> nextVersionAfterBreak;
-				state Transaction tr(cx);
-
-				loop {
-					try {
-						tr.setOption(FDBTransactionOptions::LOCK_AWARE);
-						tr.trState->options.sizeLimit = 2 * CLIENT_KNOBS->TRANSACTION_SIZE_LIMIT;
-						wait(checkDatabaseLock(&tr,
-						                       BinaryReader::fromStringRef<UID>(
-						                           task->params[BackupAgentBase::keyConfigLogUid], Unversioned())));
-						state int64_t bytesSet = 0;
-
-						bool first = true;
-						for (auto m : mutations) {
-							for (auto kv : m) {
-								if (isTimeoutOccurred) {
-									Version newVersion = getLogKeyVersion(kv.key);
-
-									if (newVersion > lastVersion) {
-										nextVersionAfterBreak = newVersion;
-										break;
-									}
-								}
-								if (first) {
-									tr.addReadConflictRange(singleKeyRange(kv.key));
-									first = false;
-								}
-								tr.set(kv.key.removePrefix(backupLogKeys.begin)
-								           .removePrefix(task->params[BackupAgentBase::destUid])
-								           .withPrefix(task->params[BackupAgentBase::keyConfigLogUid])
-								           .withPrefix(applyLogKeys.begin),
-								       kv.value);
-								bytesSet += kv.expectedSize() - backupLogKeys.begin.expectedSize() +
-								            applyLogKeys.begin.expectedSize();
-								lastKey = kv.key;
-							}
-						}
+				if (isTimeoutOccurred) {
+					Optional<Version> nextVersionAfterBreak =
+					    wait(commitMutations(cx, task, mutations, Optional<Version>(lastVersion)));
+					if (nextVersionAfterBreak.present()) {
+						return nextVersionAfterBreak;
+					}
+					continue;
+				}
 
-						wait(tr.commit());
-						Params.bytesWritten().set(task, Params.bytesWritten().getOrDefault(task) + bytesSet);
-						break;
-					} catch (Error& e) {
-						wait(tr.onError(e));
+				for (const auto& m : mutations) {
+					if (!m.empty()) {
+						lastKey = m.back().key;
 					}
 				}
-				if (nextVersionAfterBreak.present()) {
-					return nextVersionAfterBreak;
+				commits.push_back(commitMutations(cx, task, mutations, Optional<Version>()));
+				while (commits.size() > CLIENT_KNOBS->COPY_LOG_MAX_PIPELINED_COMMITS) {
+					wait(success(commits.front()));
+					commits.erase(commits.begin());
 				}
-				if (!isTimeoutOccurred && timer_monotonic() >= breakTime && lastKey.present()) {
+
+				if (timer_monotonic() >= breakTime && lastKey.present()) {
 					// timeout occurred
 					// continue to copy mutations with the
 					// same version before break because
 					// the next run should start from the beginning of a version > lastVersion.
+					wait(waitForAll(commits));
+					commits.clear();
 					lastVersion = getLogKeyVersion(lastKey.get());
 					isTimeoutOccurred = true;
 				}
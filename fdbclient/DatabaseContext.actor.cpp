@@ -632,6 +632,14 @@ ACTOR Future<Void> databaseLogger(DatabaseContext* cx) {
 			    .detail("MedianBytesPerCommit", cx->bytesPerCommit.median())
 			    .detail("MaxBytesPerCommit", cx->bytesPerCommit.max())
 			    .detail("NumLocalityCacheEntries", cx->locationCache.size());
+			// With LOAD_BALANCE_ZONE_ID_LOCALITY_ENABLED, the nearest storage servers are those in the client's zone
+			ev.detail("LoadBalanceSameZoneRequests", cx->queueModel.requestsAtDistance[LBDistance::SAME_MACHINE])
+			    .detail("LoadBalanceSameDCRequests", cx->queueModel.requestsAtDistance[LBDistance::SAME_DC])
+			    .detail("LoadBalanceDistantRequests", cx->queueModel.requestsAtDistance[LBDistance::DISTANT]);
+		}
+
+		for (auto& requests : cx->queueModel.requestsAtDistance) {
+			requests = 0;
 		}
 
 		cx->latencies.clear();
@@ -1193,6 +1201,8 @@ DatabaseContext::DatabaseContext(Reference<AsyncVar<Reference<IClusterConnection
     enableLocalityLoadBalance(enableLocalityLoadBalance), internal(internal), cc("TransactionMetrics", dbId.toString()),
     transactionReadVersions("ReadVersions", cc), transactionReadVersionsThrottled("ReadVersionsThrottled", cc),
     transactionReadVersionsCompleted("ReadVersionsCompleted", cc),
+    transactionReadVersionsFromCache("ReadVersionsFromCache", cc),
+    transactionReadVersionsCacheStale("ReadVersionsCacheStale", cc),
     transactionReadVersionBatches("ReadVersionBatches", cc),
     transactionBatchReadVersions("BatchPriorityReadVersions", cc),
     transactionDefaultReadVersions("DefaultPriorityReadVersions", cc),
@@ -1212,6 +1222,7 @@ DatabaseContext::DatabaseContext(Reference<AsyncVar<Reference<IClusterConnection
     transactionCommittedMutationBytes("CommittedMutationBytes", cc), transactionSetMutations("SetMutations", cc),
     transactionClearMutations("ClearMutations", cc), transactionAtomicMutations("AtomicMutations", cc),
     transactionsCommitStarted("CommitStarted", cc), transactionsCommitCompleted("CommitCompleted", cc),
+    transactionReadConflictRangesMerged("ReadConflictRangesMerged", cc),
     transactionKeyServerLocationRequests("KeyServerLocationRequests", cc),
     transactionKeyServerLocationRequestsCompleted("KeyServerLocationRequestsCompleted", cc),
     transactionStatusRequests("StatusRequests", cc), transactionsTooOld("TooOld", cc),
@@ -1484,6 +1495,8 @@ DatabaseContext::DatabaseContext(const Error& err)
   : deferredError(err), internal(IsInternal::False), cc("TransactionMetrics"),
     transactionReadVersions("ReadVersions", cc), transactionReadVersionsThrottled("ReadVersionsThrottled", cc),
     transactionReadVersionsCompleted("ReadVersionsCompleted", cc),
+    transactionReadVersionsFromCache("ReadVersionsFromCache", cc),
+    transactionReadVersionsCacheStale("ReadVersionsCacheStale", cc),
     transactionReadVersionBatches("ReadVersionBatches", cc),
     transactionBatchReadVersions("BatchPriorityReadVersions", cc),
     transactionDefaultReadVersions("DefaultPriorityReadVersions", cc),
@@ -1503,6 +1516,7 @@ DatabaseContext::DatabaseContext(const Error& err)
     transactionCommittedMutationBytes("CommittedMutationBytes", cc), transactionSetMutations("SetMutations", cc),
     transactionClearMutations("ClearMutations", cc), transactionAtomicMutations("AtomicMutations", cc),
     transactionsCommitStarted("CommitStarted", cc), transactionsCommitCompleted("CommitCompleted", cc),
+    transactionReadConflictRangesMerged("ReadConflictRangesMerged", cc),
     transactionKeyServerLocationRequests("KeyServerLocationRequests", cc),
     transactionKeyServerLocationRequestsCompleted("KeyServerLocationRequestsCompleted", cc),
     transactionStatusRequests("StatusRequests", cc), transactionsTooOld("TooOld", cc),
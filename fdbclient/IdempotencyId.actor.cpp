@@ -160,6 +160,23 @@ TEST_CASE("/fdbclient/IdempotencyId/basic") {
 	return Void();
 }
 
+TEST_CASE("/fdbclient/IdempotencyId/addIdempotencyClear") {
+	Standalone<VectorRef<MutationRef>> clears;
+	Version commitVersion = deterministicRandom()->randomInt64(1, std::numeric_limits<Version>::max());
+	addIdempotencyClear(clears, commitVersion, 5);
+	addIdempotencyClear(clears, commitVersion, 6);
+	addIdempotencyClear(clears, commitVersion, 4);
+	ASSERT_EQ(clears.size(), 1);
+	ASSERT(clears[0].param1 == makeIdempotencySingleKeyRange(clears.arena(), commitVersion, 4).begin);
+	ASSERT(clears[0].param2 == makeIdempotencySingleKeyRange(clears.arena(), commitVersion, 6).end);
+
+	// Neither a gap in batch indexes nor a different version may be merged
+	addIdempotencyClear(clears, commitVersion, 8);
+	addIdempotencyClear(clears, commitVersion - 1, 7);
+	ASSERT_EQ(clears.size(), 3);
+	return Void();
+}
+
 TEST_CASE("/fdbclient/IdempotencyId/serialization") {
 	ASSERT(ObjectReader::fromStringRef<IdempotencyIdRef>(ObjectWriter::toValue(IdempotencyIdRef(), Unversioned()),
 	                                                     Unversioned()) == IdempotencyIdRef());
@@ -206,6 +223,30 @@ void decodeIdempotencyKey(KeyRef key, Version& commitVersion, uint8_t& highOrder
 	reader >> highOrderBatchIndex;
 }
 
+void addIdempotencyClear(Standalone<VectorRef<MutationRef>>& clears, Version version, uint8_t highOrderBatchIndex) {
+	KeyRangeRef range = makeIdempotencySingleKeyRange(clears.arena(), version, highOrderBatchIndex);
+	if (clears.size()) {
+		// No idempotency key sorts between those of neighboring batch indexes of the same version, so the new key can
+		// be cleared by widening the last clear when it is such a neighbor
+		MutationRef& last = clears.back();
+		Version firstVersion, lastVersion;
+		uint8_t firstIndex, lastIndex;
+		decodeIdempotencyKey(last.param1, firstVersion, firstIndex);
+		decodeIdempotencyKey(last.param2, lastVersion, lastIndex);
+		if (firstVersion == version && lastVersion == version) {
+			if (highOrderBatchIndex == lastIndex + 1) {
+				last.param2 = range.end;
+				return;
+			}
+			if (highOrderBatchIndex + 1 == firstIndex) {
+				last.param1 = range.begin;
+				return;
+			}
+		}
+	}
+	clears.push_back(clears.arena(), MutationRef(MutationRef::ClearRange, range.begin, range.end));
+}
+
 FDB_BOOLEAN_PARAM(Oldest);
 
 // Find the youngest or oldest idempotency id key in `range` (depending on `oldest`)
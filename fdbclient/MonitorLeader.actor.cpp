@@ -856,6 +856,7 @@ ACTOR Future<MonitorLeaderInfo> monitorProxiesOneGeneration(
 	state std::vector<GrvProxyInterface> lastGrvProxies;
 	state std::vector<ClientLeaderRegInterface> clientLeaderServers;
 	state bool allConnectionsFailed = false;
+	state double reconnectionDelay = CLIENT_KNOBS->COORDINATOR_RECONNECTION_DELAY;
 
 	clientLeaderServers.reserve(coordinatorsSize);
 	for (const auto& h : cs.hostnames) {
@@ -966,6 +967,7 @@ ACTOR Future<MonitorLeaderInfo> monitorProxiesOneGeneration(
 			clientInfo->setUnconditional(ni);
 			successIndex = index;
 			allConnectionsFailed = false;
+			reconnectionDelay = CLIENT_KNOBS->COORDINATOR_RECONNECTION_DELAY;
 		} else {
 			CODE_PROBE(rep.getError().code() == error_code_failed_to_progress,
 			           "Coordinator cannot talk to cluster controller");
@@ -975,7 +977,10 @@ ACTOR Future<MonitorLeaderInfo> monitorProxiesOneGeneration(
 			index = (index + 1) % coordinatorsSize;
 			if (index == successIndex) {
 				allConnectionsFailed = true;
-				wait(delay(CLIENT_KNOBS->COORDINATOR_RECONNECTION_DELAY));
+				// Every client of the cluster reaches this point together during a recovery, so spread their retries
+				// rather than have them all query the coordinators again at the same moment
+				wait(delayJittered(reconnectionDelay));
+				reconnectionDelay = std::min(reconnectionDelay * 2, CLIENT_KNOBS->COORDINATOR_RECONNECTION_MAX_DELAY);
 			}
 		}
 	}
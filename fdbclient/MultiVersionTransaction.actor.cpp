@@ -102,6 +102,24 @@ ThreadFuture<Optional<Value>> DLTransaction::get(const KeyRef& key, bool snapsho
 	});
 }
 
+ThreadFuture<RangeResult> DLTransaction::getMulti(const VectorRef<KeyRef>& keys, bool snapshot) {
+	if (!api->transactionGetMulti) {
+		return unsupported_operation();
+	}
+	FdbCApi::FDBFuture* f = api->transactionGetMulti(tr, (FdbCApi::FDBKey const*)keys.begin(), keys.size(), snapshot);
+
+	return toThreadFuture<RangeResult>(api, f, [](FdbCApi::FDBFuture* f, FdbCApi* api) {
+		const FdbCApi::FDBKeyValue* kvs;
+		int count;
+		FdbCApi::fdb_bool_t more;
+		FdbCApi::fdb_error_t error = api->futureGetKeyValueArray(f, &kvs, &count, &more);
+		ASSERT(!error);
+
+		// The memory for this is stored in the FDBFuture and is released when the future gets destroyed
+		return RangeResult(RangeResultRef(VectorRef<KeyValueRef>((KeyValueRef*)kvs, count), more), Arena());
+	});
+}
+
 ThreadFuture<Key> DLTransaction::getKey(const KeySelectorRef& key, bool snapshot) {
 	FdbCApi::FDBFuture* f =
 	    api->transactionGetKey(tr, key.getKey().begin(), key.getKey().size(), key.orEqual, key.offset, snapshot);
@@ -270,6 +288,34 @@ ThreadFuture<Standalone<VectorRef<KeyRef>>> DLTransaction::getRangeSplitPoints(c
 	});
 }
 
+ThreadFuture<RangeResult> DLTransaction::getRangeParallel(const KeyRangeRef& range,
+                                                          int parallelism,
+                                                          int64_t chunkSize,
+                                                          bool snapshot) {
+	if (!api->transactionGetRangeParallel) {
+		return unsupported_operation();
+	}
+	FdbCApi::FDBFuture* f = api->transactionGetRangeParallel(tr,
+	                                                         range.begin.begin(),
+	                                                         range.begin.size(),
+	                                                         range.end.begin(),
+	                                                         range.end.size(),
+	                                                         parallelism,
+	                                                         chunkSize,
+	                                                         snapshot);
+
+	return toThreadFuture<RangeResult>(api, f, [](FdbCApi::FDBFuture* f, FdbCApi* api) {
+		const FdbCApi::FDBKeyValue* kvs;
+		int count;
+		FdbCApi::fdb_bool_t more;
+		FdbCApi::fdb_error_t error = api->futureGetKeyValueArray(f, &kvs, &count, &more);
+		ASSERT(!error);
+
+		// The memory for this is stored in the FDBFuture and is released when the future gets destroyed
+		return RangeResult(RangeResultRef(VectorRef<KeyValueRef>((KeyValueRef*)kvs, count), more), Arena());
+	});
+}
+
 void DLTransaction::addReadConflictRange(const KeyRangeRef& keys) {
 	throwIfError(api->transactionAddConflictRange(
 	    tr, keys.begin.begin(), keys.begin.size(), keys.end.begin(), keys.end.size(), FDB_CONFLICT_RANGE_TYPE_READ));
@@ -611,6 +657,7 @@ void DLApi::init() {
 	loadClientFunction(
 	    &api->transactionGetReadVersion, lib, fdbCPath, "fdb_transaction_get_read_version", headerVersion >= 0);
 	loadClientFunction(&api->transactionGet, lib, fdbCPath, "fdb_transaction_get", headerVersion >= 0);
+	loadClientFunction(&api->transactionGetMulti, lib, fdbCPath, "fdb_transaction_get_multi", false);
 	loadClientFunction(&api->transactionGetKey, lib, fdbCPath, "fdb_transaction_get_key", headerVersion >= 0);
 	loadClientFunction(&api->transactionGetAddressesForKey,
 	                   lib,
@@ -663,6 +710,7 @@ void DLApi::init() {
 	                   fdbCPath,
 	                   "fdb_transaction_get_range_split_points",
 	                   headerVersion >= 700);
+	loadClientFunction(&api->transactionGetRangeParallel, lib, fdbCPath, "fdb_transaction_get_range_parallel", false);
 
 	loadClientFunction(&api->futureGetDouble,
 	                   lib,
@@ -935,6 +983,10 @@ ThreadFuture<Optional<Value>> MultiVersionTransaction::get(const KeyRef& key, bo
 	return executeOperation(&ITransaction::get, key, std::forward<bool>(snapshot));
 }
 
+ThreadFuture<RangeResult> MultiVersionTransaction::getMulti(const VectorRef<KeyRef>& keys, bool snapshot) {
+	return executeOperation(&ITransaction::getMulti, keys, std::forward<bool>(snapshot));
+}
+
 ThreadFuture<Key> MultiVersionTransaction::getKey(const KeySelectorRef& key, bool snapshot) {
 	return executeOperation(&ITransaction::getKey, key, std::forward<bool>(snapshot));
 }
@@ -1026,6 +1078,17 @@ ThreadFuture<Standalone<VectorRef<KeyRef>>> MultiVersionTransaction::getRangeSpl
 	return executeOperation(&ITransaction::getRangeSplitPoints, range, std::forward<int64_t>(chunkSize));
 }
 
+ThreadFuture<RangeResult> MultiVersionTransaction::getRangeParallel(const KeyRangeRef& range,
+                                                                    int parallelism,
+                                                                    int64_t chunkSize,
+                                                                    bool snapshot) {
+	return executeOperation(&ITransaction::getRangeParallel,
+	                        range,
+	                        std::forward<int>(parallelism),
+	                        std::forward<int64_t>(chunkSize),
+	                        std::forward<bool>(snapshot));
+}
+
 void MultiVersionTransaction::atomicOp(const KeyRef& key, const ValueRef& value, uint32_t operationType) {
 	auto tr = getTransaction();
 	if (tr.transaction) {
@@ -2006,6 +2069,11 @@ std::vector<std::pair<std::string, bool>> MultiVersionApi::copyExternalLibraryPe
 		// if the thing we're about to copy is the shared object executing this code
 		// or not, so this optimization is unsafe.
 		// paths.push_back({path, false});
+
+		// Client libraries are tens of megabytes and are copied once per thread, so copy in large chunks rather
+		// than making a pair of system calls for every page.
+		constexpr size_t buf_sz = 1 << 20;
+		std::vector<char> buf(buf_sz);
 		for (int ii = 0; ii < threadCount; ++ii) {
 			std::string filename = basename(path);
 
@@ -2025,10 +2093,8 @@ std::vector<std::pair<std::string, bool>> MultiVersionApi::copyExternalLibraryPe
 			    .detail("LibraryPath", path)
 			    .detail("TempPath", tempName);
 
-			constexpr size_t buf_sz = 4096;
-			char buf[buf_sz];
 			while (1) {
-				ssize_t readCount = read(fd, buf, buf_sz);
+				ssize_t readCount = read(fd, buf.data(), buf_sz);
 				if (readCount == 0) {
 					// eof
 					break;
@@ -2041,7 +2107,7 @@ std::vector<std::pair<std::string, bool>> MultiVersionApi::copyExternalLibraryPe
 				}
 				ssize_t written = 0;
 				while (written != readCount) {
-					ssize_t writeCount = write(tempFd, buf + written, readCount - written);
+					ssize_t writeCount = write(tempFd, buf.data() + written, readCount - written);
 					if (writeCount == -1) {
 						TraceEvent(SevError, "ExternalClientCopyFailedWriteError")
 						    .GetLastError()
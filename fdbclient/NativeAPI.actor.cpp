@@ -1188,6 +1188,19 @@ ACTOR Future<KeyRangeLocationInfo> getKeyLocation_internal(Database cx,
 		ASSERT(key < allKeys.end);
 	}
 
+	// A miss usually means the client has not read nearby either, so the locations of the shards after the key's shard
+	// (or before it, if isBackward) are fetched in the same request
+	state KeyRef begin = key;
+	state Optional<KeyRef> end;
+	if (CLIENT_KNOBS->LOCATION_CACHE_PREFETCH_SHARDS > 1) {
+		if (isBackward) {
+			begin = allKeys.begin;
+			end = key;
+		} else {
+			end = allKeys.end;
+		}
+	}
+
 	if (debugID.present())
 		g_traceBatch.addEvent("TransactionDebug", debugID.get().first(), "NativeAPI.getKeyLocation.Before");
 
@@ -1200,16 +1213,25 @@ ACTOR Future<KeyRangeLocationInfo> getKeyLocation_internal(Database cx,
 				when(GetKeyServerLocationsReply rep = wait(basicLoadBalance(
 				         cx->getCommitProxies(useProvisionalProxies),
 				         &CommitProxyInterface::getKeyServersLocations,
-				         GetKeyServerLocationsRequest(
-				             span.context, key, Optional<KeyRef>(), /*limit=*/100, isBackward, version, key.arena()),
+				         GetKeyServerLocationsRequest(span.context,
+				                                      begin,
+				                                      end,
+				                                      CLIENT_KNOBS->LOCATION_CACHE_PREFETCH_SHARDS,
+				                                      isBackward,
+				                                      version,
+				                                      key.arena()),
 				         TaskPriority::DefaultPromiseEndpoint))) {
 					++cx->transactionKeyServerLocationRequestsCompleted;
 					if (debugID.present())
 						g_traceBatch.addEvent(
 						    "TransactionDebug", debugID.get().first(), "NativeAPI.getKeyLocation.After");
-					ASSERT(rep.results.size() == 1);
+					ASSERT(rep.results.size() >= 1);
 
+					// The shard containing the key always comes first
 					auto locationInfo = cx->setCachedLocation(rep.results[0].first, rep.results[0].second);
+					for (int i = 1; i < rep.results.size(); i++) {
+						cx->setCachedLocation(rep.results[i].first, rep.results[i].second);
+					}
 					updateTssMappings(cx, rep);
 					updateTagMappings(cx, rep);
 
@@ -1602,6 +1624,152 @@ Future<REPLY_TYPE(Request)> loadBalance(
 }
 } // namespace
 
+// Point reads which are served by the same storage team at the same read version and will be sent in one
+// GetValuesRequest. They may come from several transactions, in which case the request is sent with the options of the
+// one which started the batch, so only transactions whose reads are sent identically share a batch.
+struct GetValuesBatch : ReferenceCounted<GetValuesBatch> {
+	Reference<LocationInfo> locations;
+	Reference<TransactionState> trState;
+	Standalone<VectorRef<KeyRef>> keys;
+	std::vector<Promise<GetValueReply>> replies;
+	Future<Void> sender;
+
+	GetValuesBatch(Reference<LocationInfo> locations, Reference<TransactionState> trState)
+	  : locations(locations), trState(trState) {}
+};
+
+struct PendingGetValues {
+	std::map<std::pair<LocationInfo*, Version>, Reference<GetValuesBatch>> batches;
+};
+
+// Whether point reads of the two transactions would be sent with the same request, other than their keys
+static bool canShareGetValuesBatch(TransactionState const& a, TransactionState const& b) {
+	if (&a == &b) {
+		return true;
+	}
+	if (a.readVersion() != b.readVersion() || a.taskID != b.taskID ||
+	    a.readVersionObtainedFromGrvProxy != b.readVersionObtainedFromGrvProxy ||
+	    a.options.useGrvCache != b.options.useGrvCache || a.options.skipGrvCache != b.options.skipGrvCache ||
+	    a.options.enableReplicaConsistencyCheck != b.options.enableReplicaConsistencyCheck ||
+	    a.options.requiredReplicas != b.options.requiredReplicas ||
+	    a.readOptions.present() != b.readOptions.present()) {
+		return false;
+	}
+	if (a.readOptions.present()) {
+		ReadOptions const& ao = a.readOptions.get();
+		ReadOptions const& bo = b.readOptions.get();
+		if (ao.type != bo.type || ao.cacheResult != bo.cacheResult || ao.lockAware != bo.lockAware ||
+		    ao.consistencyCheckStartVersion != bo.consistencyCheckStartVersion) {
+			return false;
+		}
+	}
+	return a.options.readTags.size() == b.options.readTags.size() &&
+	       std::equal(a.options.readTags.begin(), a.options.readTags.end(), b.options.readTags.begin());
+}
+
+ACTOR static Future<Void> sendGetValuesBatch(Reference<GetValuesBatch> batch, SpanContext spanContext) {
+	state Reference<TransactionState> trState = batch->trState;
+	// Let the other reads started in this run loop iteration join the batch
+	wait(delay(0, trState->taskID));
+
+	auto& batches = trState->cx->pendingGetValues->batches;
+	auto it = batches.find(std::make_pair(batch->locations.getPtr(), trState->readVersion()));
+	if (it != batches.end() && it->second == batch) {
+		batches.erase(it);
+	}
+
+	try {
+		state VersionVector ssLatestCommitVersions;
+		trState->cx->getLatestCommitVersions(batch->locations, trState, ssLatestCommitVersions);
+		state Optional<TagSet> tags = trState->cx->sampleReadTags() ? trState->options.readTags : Optional<TagSet>();
+		if (batch->keys.size() == 1) {
+			GetValueReply reply =
+			    wait(loadBalance(trState->cx.getPtr(),
+			                     batch->locations,
+			                     &StorageServerInterface::getValue,
+			                     GetValueRequest(spanContext,
+			                                     batch->keys[0],
+			                                     trState->readVersion(),
+			                                     tags,
+			                                     trState->readOptions,
+			                                     ssLatestCommitVersions),
+			                     TaskPriority::DefaultPromiseEndpoint,
+			                     AtMostOnce::False,
+			                     trState->cx->enableLocalityLoadBalance ? &trState->cx->queueModel : nullptr,
+			                     trState->options.enableReplicaConsistencyCheck,
+			                     trState->options.requiredReplicas));
+			batch->replies[0].send(reply);
+		} else {
+			GetValuesReply reply =
+			    wait(loadBalance(trState->cx.getPtr(),
+			                     batch->locations,
+			                     &StorageServerInterface::getValues,
+			                     GetValuesRequest(spanContext,
+			                                      batch->keys,
+			                                      trState->readVersion(),
+			                                      tags,
+			                                      trState->readOptions,
+			                                      ssLatestCommitVersions),
+			                     TaskPriority::DefaultPromiseEndpoint,
+			                     AtMostOnce::False,
+			                     trState->cx->enableLocalityLoadBalance ? &trState->cx->queueModel : nullptr,
+			                     trState->options.enableReplicaConsistencyCheck,
+			                     trState->options.requiredReplicas));
+			ASSERT(reply.values.size() == batch->keys.size());
+			for (int i = 0; i < batch->replies.size(); i++) {
+				batch->replies[i].send(GetValueReply(reply.values[i], reply.cached));
+			}
+		}
+	} catch (Error& e) {
+		if (e.code() == error_code_actor_cancelled) {
+			throw;
+		}
+		// Every read in the batch handles the error as if it had been sent on its own
+		for (auto& reply : batch->replies) {
+			reply.sendError(e);
+		}
+	}
+	return Void();
+}
+
+// Adds a point read to the batch for the storage team serving it at the transaction's read version, starting a new
+// batch if there is none or the transaction cannot share it
+static Future<GetValueReply> getValueBatched(Reference<TransactionState> trState,
+                                             Reference<LocationInfo> locations,
+                                             Key key,
+                                             SpanContext spanContext) {
+	auto& pending = trState->cx->pendingGetValues;
+	if (!pending) {
+		pending = std::make_shared<PendingGetValues>();
+	}
+	auto batchKey = std::make_pair(locations.getPtr(), trState->readVersion());
+	Reference<GetValuesBatch>& batch = pending->batches[batchKey];
+	if (!batch || !canShareGetValuesBatch(*batch->trState, *trState)) {
+		// A batch which is replaced is still sent by its sender
+		batch = makeReference<GetValuesBatch>(locations, trState);
+		batch->sender = sendGetValuesBatch(batch, spanContext);
+	}
+	batch->keys.push_back_deep(batch->keys.arena(), key);
+	batch->replies.emplace_back();
+	Future<GetValueReply> reply = batch->replies.back().getFuture();
+	if (batch->keys.size() >= CLIENT_KNOBS->GET_VALUES_BATCH_MAX_KEYS) {
+		// The full batch is still sent by its sender, later reads start a new one
+		pending->batches.erase(batchKey);
+	}
+	return reply;
+}
+
+// Records that a read was served at the given version, which may be older than the read version if the transaction
+// allows stale reads.  With version vector, storage servers may also reply with an older version which is equivalent
+// to the read version, so only stale-tolerant transactions track it.
+static void noteStaleRead(Reference<TransactionState> const& trState, Version version) {
+	if (!trState->readOptions.present() || !trState->readOptions.get().maxStaleness.present() ||
+	    version >= trState->readVersion()) {
+		return;
+	}
+	trState->staleReadVersion = std::min(version, trState->staleReadVersion.orDefault(version));
+}
+
 ACTOR Future<Optional<Value>> getValue(Reference<TransactionState> trState,
                                        Key key,
                                        TransactionRecordLogInfo recordLogInfo) {
@@ -1644,31 +1812,40 @@ ACTOR Future<Optional<Value>> getValue(Reference<TransactionState> trState,
 			++trState->cx->transactionPhysicalReads;
 
 			state GetValueReply reply;
+			state Future<GetValueReply> replyFuture;
 			try {
 				if (CLIENT_BUGGIFY_WITH_PROB(.01)) {
 					throw deterministicRandom()->randomChoice(
 					    std::vector<Error>{ transaction_too_old(), future_version() });
 				}
+				// Debug reads are always sent on their own so that their trace events can be attached to them, and
+				// batched reads always wait for the read version
+				if (CLIENT_KNOBS->BATCH_GET_VALUES && !getValueID.present() &&
+				    !(readOptions.present() && readOptions.get().maxStaleness.present())) {
+					replyFuture = getValueBatched(trState, locationInfo.locations, key, span.context);
+				} else {
+					replyFuture =
+					    loadBalance(trState->cx.getPtr(),
+					                locationInfo.locations,
+					                &StorageServerInterface::getValue,
+					                GetValueRequest(span.context,
+					                                key,
+					                                trState->readVersion(),
+					                                trState->cx->sampleReadTags() ? trState->options.readTags
+					                                                              : Optional<TagSet>(),
+					                                readOptions,
+					                                ssLatestCommitVersions),
+					                TaskPriority::DefaultPromiseEndpoint,
+					                AtMostOnce::False,
+					                trState->cx->enableLocalityLoadBalance ? &trState->cx->queueModel : nullptr,
+					                trState->options.enableReplicaConsistencyCheck,
+					                trState->options.requiredReplicas);
+				}
 				choose {
 					when(wait(trState->cx->connectionFileChanged())) {
 						throw transaction_too_old();
 					}
-					when(GetValueReply _reply = wait(
-					         loadBalance(trState->cx.getPtr(),
-					                     locationInfo.locations,
-					                     &StorageServerInterface::getValue,
-					                     GetValueRequest(span.context,
-					                                     key,
-					                                     trState->readVersion(),
-					                                     trState->cx->sampleReadTags() ? trState->options.readTags
-					                                                                   : Optional<TagSet>(),
-					                                     readOptions,
-					                                     ssLatestCommitVersions),
-					                     TaskPriority::DefaultPromiseEndpoint,
-					                     AtMostOnce::False,
-					                     trState->cx->enableLocalityLoadBalance ? &trState->cx->queueModel : nullptr,
-					                     trState->options.enableReplicaConsistencyCheck,
-					                     trState->options.requiredReplicas))) {
+					when(GetValueReply _reply = wait(replyFuture)) {
 						reply = _reply;
 					}
 				}
@@ -1678,6 +1855,10 @@ ACTOR Future<Optional<Value>> getValue(Reference<TransactionState> trState,
 				throw;
 			}
 
+			if (reply.version.present()) {
+				noteStaleRead(trState, reply.version.get());
+			}
+
 			double latency = now() - startTimeD;
 			trState->cx->readLatencies.addSample(latency);
 			if (trState->trLogInfo && recordLogInfo) {
@@ -2212,6 +2393,21 @@ PublicRequestStream<GetKeyValuesFamilyRequest> StorageServerInterface::* getRang
 	}
 }
 
+// Range reads, unlike mapped range reads, can have the keys of their replies sent without their shared prefixes
+template <class GetKeyValuesFamilyRequest>
+void setCompressKeyPrefixes(GetKeyValuesFamilyRequest& req) {
+	if constexpr (std::is_same<GetKeyValuesFamilyRequest, GetKeyValuesRequest>::value) {
+		req.compressKeyPrefixes = CLIENT_KNOBS->GET_RANGE_COMPRESS_KEY_PREFIXES;
+	}
+}
+
+template <class GetKeyValuesFamilyReply>
+void expandKeyPrefixes(GetKeyValuesFamilyReply& rep) {
+	if constexpr (std::is_same<GetKeyValuesFamilyReply, GetKeyValuesReply>::value) {
+		rep.expandKeyPrefixes();
+	}
+}
+
 ACTOR template <class GetKeyValuesFamilyRequest, class GetKeyValuesFamilyReply, class RangeResultFamily>
 Future<RangeResultFamily> getExactRange(Reference<TransactionState> trState,
                                         KeyRange keys,
@@ -2254,6 +2450,7 @@ Future<RangeResultFamily> getExactRange(Reference<TransactionState> trState,
 			req.tags = trState->cx->sampleReadTags() ? trState->options.readTags : Optional<TagSet>();
 
 			req.options = trState->readOptions;
+			setCompressKeyPrefixes(req);
 
 			try {
 				if (trState->readOptions.present() && trState->readOptions.get().debugID.present()) {
@@ -2287,6 +2484,7 @@ Future<RangeResultFamily> getExactRange(Reference<TransactionState> trState,
 						         trState->options.enableReplicaConsistencyCheck,
 						         trState->options.requiredReplicas))) {
 							rep = _rep;
+							expandKeyPrefixes(rep);
 						}
 					}
 					++trState->cx->transactionPhysicalReadsCompleted;
@@ -2298,6 +2496,7 @@ Future<RangeResultFamily> getExactRange(Reference<TransactionState> trState,
 					g_traceBatch.addEvent("TransactionDebug",
 					                      trState->readOptions.get().debugID.get().first(),
 					                      "NativeAPI.getExactRange.After");
+				noteStaleRead(trState, rep.version);
 				output.arena().dependsOn(rep.arena);
 				output.append(output.arena(), rep.data.begin(), rep.data.size());
 
@@ -2591,6 +2790,7 @@ Future<RangeResultFamily> getRange(Reference<TransactionState> trState,
 			req.options = trState->readOptions;
 			req.version = trState->readVersion();
 			req.taskID = trState->taskID;
+			setCompressKeyPrefixes(req);
 
 			trState->cx->getLatestCommitVersions(beginServer.locations, trState, req.ssLatestCommitVersions);
 
@@ -2673,6 +2873,7 @@ Future<RangeResultFamily> getRange(Reference<TransactionState> trState,
 					                     trState->options.enableReplicaConsistencyCheck,
 					                     trState->options.requiredReplicas));
 					rep = _rep;
+					expandKeyPrefixes(rep);
 					++trState->cx->transactionPhysicalReadsCompleted;
 				} catch (Error&) {
 					++trState->cx->transactionPhysicalReadsCompleted;
@@ -2697,6 +2898,8 @@ Future<RangeResultFamily> getRange(Reference<TransactionState> trState,
 				ASSERT(!rep.more || rep.data.size());
 				ASSERT(!limits.hasRowLimit() || rep.data.size() <= limits.rows);
 
+				noteStaleRead(trState, rep.version);
+
 				limits.decrement(rep.data);
 
 				if (reverse && begin.isLastLessOrEqual() && rep.data.size() &&
@@ -3898,7 +4101,7 @@ void Transaction::atomicOp(const KeyRef& key,
 	auto v = ValueRef(req.arena, operand);
 
 	t.mutations.emplace_back(req.arena, operationType, r.begin, v);
-	trState->totalCost += getWriteOperationCost(key.expectedSize());
+	trState->totalCost += getMutationOperationCost(t.mutations.back());
 
 	if (addConflictRange && operationType != MutationRef::SetVersionstampedKey)
 		t.write_conflict_ranges.push_back(req.arena, r);
@@ -4056,6 +4259,7 @@ void TransactionOptions::clear() {
 	bypassStorageQuota = false;
 	enableReplicaConsistencyCheck = false;
 	requiredReplicas = 0;
+	readConflictRangeLimit = 0;
 }
 
 TransactionOptions::TransactionOptions() {
@@ -4134,6 +4338,61 @@ Optional<KeyRangeRef> intersects(VectorRef<KeyRangeRef> lhs, VectorRef<KeyRangeR
 	return Optional<KeyRangeRef>();
 }
 
+// Sorts the given ranges and merges those which overlap or touch, in place, so that the resolvers have fewer ranges to
+//   check. Transactions which read or write many adjacent keys through the native API otherwise send a range per key.
+void coalesceConflictRanges(Arena& arena, VectorRef<KeyRangeRef>& ranges) {
+	if (ranges.size() < 2) {
+		return;
+	}
+	if (!std::is_sorted(ranges.begin(), ranges.end(), compareBegin)) {
+		std::sort(ranges.begin(), ranges.end(), compareBegin);
+	}
+
+	int last = 0;
+	for (int i = 1; i < ranges.size(); i++) {
+		if (ranges[i].begin <= ranges[last].end) {
+			if (ranges[last].end < ranges[i].end) {
+				ranges[last] = KeyRangeRef(ranges[last].begin, ranges[i].end);
+			}
+		} else {
+			ranges[++last] = ranges[i];
+		}
+	}
+	ranges.resize(arena, last + 1);
+}
+
+// Merges the given ranges until at most limit remain, closing the smallest gaps first, and returns how many ranges were
+//   merged away. The bounds of a small gap share a long prefix, so that is what measures a gap.
+int limitConflictRanges(Arena& arena, VectorRef<KeyRangeRef>& ranges, int limit) {
+	coalesceConflictRanges(arena, ranges);
+	int excess = ranges.size() - limit;
+	if (excess <= 0) {
+		return 0;
+	}
+
+	std::vector<std::pair<int, int>> gaps; // shared prefix length of the gap's bounds, index of the range before it
+	gaps.reserve(ranges.size() - 1);
+	for (int i = 0; i < ranges.size() - 1; i++) {
+		gaps.emplace_back(commonPrefixLength(ranges[i].end, ranges[i + 1].begin), i);
+	}
+	std::nth_element(gaps.begin(), gaps.begin() + (excess - 1), gaps.end(), std::greater<std::pair<int, int>>());
+	std::vector<bool> closed(ranges.size(), false);
+	for (int i = 0; i < excess; i++) {
+		closed[gaps[i].second] = true;
+	}
+
+	int last = 0;
+	for (int i = 1; i < ranges.size(); i++) {
+		if (closed[i - 1]) {
+			ranges[last] = KeyRangeRef(ranges[last].begin, ranges[i].end);
+		} else {
+			ranges[++last] = ranges[i];
+		}
+	}
+	ranges.resize(arena, last + 1);
+	return excess;
+}
+
 ACTOR void checkWrites(Reference<TransactionState> trState,
                        Future<Void> committed,
                        Promise<Void> outCommitted,
@@ -4343,7 +4602,7 @@ ACTOR Future<Optional<ClientTrCommitCostEstimation>> estimateCommitCosts(Referen
 
 		if (mutation.type == MutationRef::Type::SetValue || mutation.isAtomicOp()) {
 			trCommitCosts.opsCount++;
-			trCommitCosts.writeCosts += getWriteOperationCost(mutation.expectedSize());
+			trCommitCosts.writeCosts += getMutationOperationCost(mutation);
 		} else if (mutation.type == MutationRef::Type::ClearRange) {
 			trCommitCosts.opsCount++;
 			keyRange = KeyRangeRef(mutation.param1, mutation.param2);
@@ -4628,7 +4887,9 @@ Future<Void> Transaction::commitMutations() {
 
 		++trState->cx->transactionsCommitStarted;
 
-		if (trState->options.readOnly)
+		// Reads which may have been served at older versions cannot be conflict checked at the read version
+		if (trState->options.readOnly ||
+		    (trState->readOptions.present() && trState->readOptions.get().maxStaleness.present()))
 			return transaction_read_only();
 
 		trState->cx->mutationsPerCommit.addSample(tr.transaction.mutations.size());
@@ -4686,6 +4947,19 @@ Future<Void> Transaction::commitMutations() {
 			    tr.arena, tr.transaction.write_conflict_ranges.begin(), tr.transaction.write_conflict_ranges.size());
 		}
 
+		if (CLIENT_KNOBS->COALESCE_COMMIT_CONFLICT_RANGES) {
+			// Conflicting keys are reported as the read conflict ranges the resolver found conflicts in, so keep them
+			// as they were added rather than reporting the whole of a merged range
+			if (!trState->options.reportConflictingKeys) {
+				coalesceConflictRanges(tr.arena, tr.transaction.read_conflict_ranges);
+			}
+			coalesceConflictRanges(tr.arena, tr.transaction.write_conflict_ranges);
+		}
+		if (trState->options.readConflictRangeLimit > 0) {
+			trState->cx->transactionReadConflictRangesMerged += limitConflictRanges(
+			    tr.arena, tr.transaction.read_conflict_ranges, trState->options.readConflictRangeLimit);
+		}
+
 		if (trState->options.debugDump) {
 			UID u = nondeterministicRandom()->randomUniqueID();
 			TraceEvent("TransactionDump", u).log();
@@ -4958,6 +5232,11 @@ void Transaction::setOption(FDBTransactionOptions::Option option, Optional<Strin
 		trState->options.reportConflictingKeys = true;
 		break;
 
+	case FDBTransactionOptions::READ_CONFLICT_RANGE_LIMIT:
+		validateOptionValuePresent(value);
+		trState->options.readConflictRangeLimit = (int)extractIntOption(value, 1, std::numeric_limits<int>::max());
+		break;
+
 	case FDBTransactionOptions::EXPENSIVE_CLEAR_COST_ESTIMATION_ENABLE:
 		validateOptionValueNotPresent(value);
 		trState->options.expensiveClearCostEstimation = true;
@@ -5039,6 +5318,17 @@ void Transaction::setOption(FDBTransactionOptions::Option option, Optional<Strin
 		trState->readOptions.withDefault(ReadOptions()).type = ReadType::HIGH;
 		break;
 
+	case FDBTransactionOptions::READ_STALENESS_BUDGET: {
+		int64_t ms = extractIntOption(value, 0, std::numeric_limits<int>::max());
+		if (ms) {
+			trState->readOptions.withDefault(ReadOptions()).maxStaleness =
+			    ms * (CLIENT_KNOBS->CORE_VERSIONSPERSECOND / 1000);
+		} else if (trState->readOptions.present()) {
+			trState->readOptions.get().maxStaleness.reset();
+		}
+		break;
+	}
+
 	case FDBTransactionOptions::ENABLE_REPLICA_CONSISTENCY_CHECK:
 		validateOptionValueNotPresent(value);
 		trState->options.enableReplicaConsistencyCheck = true;
@@ -5384,8 +5674,10 @@ Future<Version> TransactionState::getReadVersion(uint32_t flags) {
 		double requestTime = now();
 		if (requestTime - lastTime <= CLIENT_KNOBS->MAX_VERSION_CACHE_LAG && rv != Version(0)) {
 			ASSERT(!debug_checkVersionTime(rv, requestTime, "CheckStaleness"));
+			++cx->transactionReadVersionsFromCache;
 			return rv;
 		} // else go through regular GRV path
+		++cx->transactionReadVersionsCacheStale;
 	}
 	++cx->transactionReadVersions;
 	flags |= options.getReadVersionFlags;
@@ -6067,6 +6359,77 @@ Future<Standalone<VectorRef<KeyRef>>> Transaction::getRangeSplitPoints(KeyRange
 	return ::getRangeSplitPoints(trState, keys, chunkSize);
 }
 
+// Aggregates a range served by one storage team, sending more requests if a storage server returns a partial result
+ACTOR static Future<RangeAggregate> getRangeAggregateFragment(Reference<TransactionState> trState,
+                                                              Reference<LocationInfo> locations,
+                                                              KeyRange keys,
+                                                              SpanContext spanContext) {
+	state RangeAggregate result;
+	state Key begin = keys.begin;
+	loop {
+		state VersionVector ssLatestCommitVersions;
+		trState->cx->getLatestCommitVersions(locations, trState, ssLatestCommitVersions);
+		GetRangeAggregateReply reply =
+		    wait(loadBalance(trState->cx.getPtr(),
+		                     locations,
+		                     &StorageServerInterface::getRangeAggregate,
+		                     GetRangeAggregateRequest(spanContext,
+		                                              KeyRangeRef(begin, keys.end),
+		                                              trState->readVersion(),
+		                                              trState->cx->sampleReadTags() ? trState->options.readTags
+		                                                                            : Optional<TagSet>(),
+		                                              trState->readOptions,
+		                                              ssLatestCommitVersions),
+		                     TaskPriority::DefaultPromiseEndpoint,
+		                     AtMostOnce::False,
+		                     trState->cx->enableLocalityLoadBalance ? &trState->cx->queueModel : nullptr));
+		result.add(reply.aggregate);
+		trState->totalCost += getReadOperationCost(reply.aggregate.bytes);
+		if (!reply.more) {
+			return result;
+		}
+		begin = reply.end;
+	}
+}
+
+ACTOR Future<RangeAggregate> getRangeAggregate(Reference<TransactionState> trState, KeyRange keys) {
+	wait(trState->startTransaction());
+	state Span span("NAPI:getRangeAggregate"_loc, trState->spanContext);
+
+	loop {
+		state std::vector<KeyRangeLocationInfo> locations = wait(getKeyRangeLocations(
+		    trState, keys, CLIENT_KNOBS->TOO_MANY, Reverse::False, &StorageServerInterface::getRangeAggregate));
+		try {
+			state std::vector<Future<RangeAggregate>> fragments;
+			for (const auto& location : locations) {
+				fragments.push_back(getRangeAggregateFragment(
+				    trState, location.locations, location.range & keys, span.context));
+			}
+			wait(waitForAll(fragments));
+
+			RangeAggregate result;
+			for (const auto& f : fragments) {
+				result.add(f.get());
+			}
+			return result;
+		} catch (Error& e) {
+			if (e.code() == error_code_wrong_shard_server || e.code() == error_code_all_alternatives_failed) {
+				trState->cx->invalidateCache(keys);
+				wait(delay(CLIENT_KNOBS->WRONG_SHARD_SERVER_DELAY, trState->taskID));
+			} else {
+				throw;
+			}
+		}
+	}
+}
+
+Future<RangeAggregate> Transaction::getRangeAggregate(KeyRange const& keys, Snapshot snapshot) {
+	if (!snapshot) {
+		addReadConflictRange(keys);
+	}
+	return ::getRangeAggregate(trState, keys);
+}
+
 ACTOR Future<Version> setPerpetualStorageWiggle(Database cx, bool enable, LockAware lockAware) {
 	state ReadYourWritesTransaction tr(cx);
 	state Version version = invalidVersion;
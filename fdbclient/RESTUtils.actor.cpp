@@ -42,7 +42,7 @@ RESTConnectionPool::~RESTConnectionPool() {
 				if (rconn.conn.isValid()) {
 					rconn.conn->close();
 				}
-				kv.second.pop();
+				kv.second.pop_front();
 			}
 		}
 	}
@@ -140,8 +140,8 @@ ACTOR Future<RESTConnectionPool::ReusableConnection> connect_impl(Reference<REST
 
 	auto poolItr = connectionPool->connectionPoolMap.find(connectKey);
 	while (poolItr != connectionPool->connectionPoolMap.end() && !poolItr->second.empty()) {
-		RESTConnectionPool::ReusableConnection rconn = poolItr->second.front();
-		poolItr->second.pop();
+		RESTConnectionPool::ReusableConnection rconn = poolItr->second.back();
+		poolItr->second.pop_back();
 
 		if (rconn.expirationTime > now()) {
 			if (FLOW_KNOBS->REST_LOG_LEVEL >= RESTLogSeverity::DEBUG) {
@@ -154,6 +154,7 @@ ACTOR Future<RESTConnectionPool::ReusableConnection> connect_impl(Reference<REST
 			}
 			return rconn;
 		}
+		rconn.conn->close();
 	}
 
 	ASSERT(poolItr == connectionPool->connectionPoolMap.end() || poolItr->second.empty());
@@ -190,13 +191,20 @@ void RESTConnectionPool::returnConnection(RESTConnectionPoolKey connectKey,
 	}
 
 	auto poolItr = connectionPoolMap.find(connectKey);
-	// If it expires in the future then add it to the pool in the front iff connection pool size is not maxed
+	// Expired connections would otherwise hold their places in the pool until everything newer had been reused
+	if (poolItr != connectionPoolMap.end()) {
+		while (!poolItr->second.empty() && poolItr->second.front().expirationTime <= now()) {
+			poolItr->second.front().conn->close();
+			poolItr->second.pop_front();
+		}
+	}
+	// If it expires in the future then add it to the pool iff connection pool size is not maxed
 	if (rconn.expirationTime > now()) {
 		bool returned = true;
 		if (poolItr == connectionPoolMap.end()) {
-			connectionPoolMap.insert({ connectKey, std::queue<RESTConnectionPool::ReusableConnection>({ rconn }) });
+			connectionPoolMap.insert({ connectKey, std::deque<RESTConnectionPool::ReusableConnection>({ rconn }) });
 		} else if (poolItr->second.size() < maxConnections) {
-			poolItr->second.push(rconn);
+			poolItr->second.push_back(rconn);
 		} else {
 			// Connection pool at its capacity; do nothing
 			returned = false;
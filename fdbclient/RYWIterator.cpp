@@ -63,6 +63,9 @@ bool RYWIterator::is_dependent() const {
 bool RYWIterator::is_unreadable() const {
 	return writes.is_unreadable();
 }
+bool RYWIterator::is_unmodified() const {
+	return writes.is_unmodified_range();
+}
 
 ExtStringRef RYWIterator::beginKey() {
 	return begin_key_cmp <= 0 ? writes.beginKey() : cache.beginKey();
@@ -775,12 +775,15 @@ public:
 					++it;
 					continue;
 				}
-				it.skipContiguous(end.isFirstGreaterOrEqual()
-				                      ? end.getKey()
-				                      : ryw->getMaxReadKey()); // not technically correct since this would add
-				                                               // end.getKey(), but that is protected above
-
-				int maxCount = it.kv(ryw->arena) - start + 1;
+				// A written key is always a segment of its own, so only a run of cached keys is worth extending
+				int maxCount = 1;
+				if (it.is_unmodified()) {
+					it.skipContiguous(end.isFirstGreaterOrEqual()
+					                      ? end.getKey()
+					                      : ryw->getMaxReadKey()); // not technically correct since this would add
+					                                               // end.getKey(), but that is protected above
+					maxCount = it.kv(ryw->arena) - start + 1;
+				}
 				int count = 0;
 				for (; count < maxCount && !limits.isReached(); count++) {
 					limits.decrement(start[count]);
@@ -1082,9 +1085,12 @@ public:
 			} else {
 				KeyValueRef const* end = it.is_kv() ? it.kv(ryw->arena) : nullptr;
 				if (end != nullptr) {
-					it.skipContiguousBack(begin.isFirstGreaterOrEqual() ? begin.getKey() : allKeys.begin);
-					KeyValueRef const* start = it.kv(ryw->arena);
-					ASSERT(start != nullptr);
+					KeyValueRef const* start = end;
+					if (it.is_unmodified()) {
+						it.skipContiguousBack(begin.isFirstGreaterOrEqual() ? begin.getKey() : allKeys.begin);
+						start = it.kv(ryw->arena);
+						ASSERT(start != nullptr);
+					}
 
 					int maxCount = end - start + 1;
 					int count = 0;
@@ -1830,6 +1836,44 @@ Future<MappedRangeResult> ReadYourWritesTransaction::getMappedRange(KeySelector
 	return result;
 }
 
+Future<Void> ReadYourWritesTransaction::prefetch(Standalone<VectorRef<KeyRangeRef>> const& ranges,
+                                                 GetRangeLimits limits) {
+	if (checkUsedDuringCommit()) {
+		return used_during_commit();
+	}
+
+	if (resetPromise.isSet())
+		return resetPromise.getFuture().getError();
+
+	if (options.readYourWritesDisabled || limits.isReached()) {
+		return Void();
+	}
+
+	if (!limits.isValid())
+		return range_limits_invalid();
+
+	KeyRef maxKey = getMaxReadKey();
+	std::vector<Future<RangeResult>> reads;
+	reads.reserve(ranges.size());
+	for (const auto& range : ranges) {
+		if (range.end > maxKey)
+			return key_outside_legal_range();
+		if (range.empty())
+			continue;
+		// Reading as a snapshot fills the cache the same way any other read does, but leaves the conflict ranges to
+		// the reads which are later served from it
+		reads.push_back(RYWImpl::readWithConflictRangeSnapshot(
+		    this,
+		    RYWImpl::GetRangeReq<false>(KeySelector(firstGreaterOrEqual(range.begin), ranges.arena()),
+		                                KeySelector(firstGreaterOrEqual(range.end), ranges.arena()),
+		                                limits)));
+	}
+
+	Future<Void> result = waitForAll(reads);
+	reading.add(success(result));
+	return result;
+}
+
 Future<Standalone<VectorRef<const char*>>> ReadYourWritesTransaction::getAddressesForKey(const Key& key) {
 	if (checkUsedDuringCommit()) {
 		return used_during_commit();
@@ -69,7 +69,8 @@ struct PartState {
 // Config for S3 operations with configurable parameters
 struct PartConfig {
 	// Basic part configuration
-	int64_t partSizeBytes = CLIENT_KNOBS->BLOBSTORE_MULTIPART_MIN_PART_SIZE;
+	int64_t partSizeBytes = CLIENT_KNOBS->BLOBSTORE_MULTIPART_MIN_PART_SIZE; // Smallest part size, see getPartSize()
+	int partsPerConcurrentRequest = 4; // Parts are sized so that each concurrent request has about this many to do
 	int baseRetryDelayMs = CLIENT_KNOBS->BLOBSTORE_MULTIPART_RETRY_DELAY_MS;
 
 	// Retry configuration - now configurable instead of magic numbers
@@ -83,6 +84,35 @@ struct PartConfig {
 	bool enableChecksumValidation = true; // Default: enable checksum validation
 };
 
+// Returns the part size for transferring an object of the given size with the given number of concurrent requests.
+// Parts grow with the object, up to the endpoint's max part size, so that large objects are not split into many small
+// requests, while keeping enough parts to keep all concurrent requests busy and staying under S3's limit on parts.
+static int64_t getPartSize(Reference<S3BlobStoreEndpoint> endpoint,
+                           int64_t size,
+                           int concurrency,
+                           const PartConfig& config) {
+	constexpr int64_t maxPartsPerObject = 10000;
+	const int64_t maxPartSize = std::max<int64_t>(config.partSizeBytes, endpoint->knobs.multipart_max_part_size);
+	int64_t partSize = size / std::max(1, concurrency * config.partsPerConcurrentRequest);
+	partSize = std::clamp(partSize, config.partSizeBytes, maxPartSize);
+	return std::max(partSize, (size + maxPartsPerObject - 1) / maxPartsPerObject);
+}
+
+// Records the results of the parts which have completed, and stops tracking them.
+static void collectCompletedParts(std::vector<Future<PartState>>& activeFutures,
+                                  std::vector<int>& activePartIndices,
+                                  std::vector<PartState>& parts) {
+	for (int i = 0; i < activeFutures.size();) {
+		if (activeFutures[i].isReady()) {
+			parts[activePartIndices[i]] = activeFutures[i].get();
+			activeFutures.erase(activeFutures.begin() + i);
+			activePartIndices.erase(activePartIndices.begin() + i);
+		} else {
+			++i;
+		}
+	}
+}
+
 // Calculate hash of a file.
 // Uses xxhash library because it's fast (supposedly) and used elsewhere in fdb.
 // If size is -1, the function will determine the file size automatically.
@@ -420,6 +450,7 @@ ACTOR static Future<Void> copyUpFile(Reference<S3BlobStoreEndpoint> endpoint,
 	state std::vector<Future<PartState>> activeFutures;
 	state std::vector<int> activePartIndices;
 	state int64_t partSize;
+	state int64_t maxPartSize;
 	state int numParts;
 	state std::string checksum;
 	state PartState part;
@@ -451,15 +482,17 @@ ACTOR static Future<Void> copyUpFile(Reference<S3BlobStoreEndpoint> endpoint,
 
 			offset = 0;
 			partNumber = 1;
-			maxConcurrentUploads = CLIENT_KNOBS->BLOBSTORE_CONCURRENT_WRITES_PER_FILE;
+			maxConcurrentUploads = endpoint->knobs.concurrent_writes_per_file;
+			maxPartSize = getPartSize(endpoint, size, maxConcurrentUploads, config);
 			activeFutures.clear();
 			activePartIndices.clear();
 
-			// Process parts in batches with concurrency limit
-			while (offset < size) {
+			// Keep up to maxConcurrentUploads parts in flight, starting the next part as soon as any one completes
+			// rather than waiting for the slowest part of a batch
+			while (offset < size || !activeFutures.empty()) {
 				// Fill up to maxConcurrentUploads active uploads
 				while (activeFutures.size() < maxConcurrentUploads && offset < size) {
-					partSize = std::min(config.partSizeBytes, size - offset);
+					partSize = std::min(maxPartSize, size - offset);
 
 					part = PartState();
 					part.partNumber = partNumber;
@@ -474,17 +507,10 @@ ACTOR static Future<Void> copyUpFile(Reference<S3BlobStoreEndpoint> endpoint,
 					partNumber++;
 				}
 
-				// Wait for all active uploads to complete
-				if (!activeFutures.empty()) {
-					std::vector<PartState> completedParts = wait(getAll(activeFutures));
-					// Update parts with completion status
-					for (int i = 0; i < completedParts.size(); i++) {
-						parts[activePartIndices[i]] = completedParts[i];
-					}
-					// Memory is automatically freed when uploadPart actors complete
-					activeFutures.clear();
-					activePartIndices.clear();
-				}
+				// Wait for any active upload to complete
+				wait(waitForAny(activeFutures));
+				// Memory is automatically freed when uploadPart actors complete
+				collectCompletedParts(activeFutures, activePartIndices, parts);
 			}
 
 			// Verify all parts completed and prepare etag map
@@ -825,6 +851,7 @@ ACTOR static Future<Void> copyDownFile(Reference<S3BlobStoreEndpoint> endpoint,
 	state int64_t offset = 0;
 	state int partNumber = 1;
 	state int64_t partSize;
+	state int64_t maxPartSize;
 	state std::string expectedChecksum;
 	state int retries = 0;
 	state int maxConcurrentDownloads;
@@ -860,7 +887,9 @@ ACTOR static Future<Void> copyDownFile(Reference<S3BlobStoreEndpoint> endpoint,
 				platform::createDirectory(dirPath);
 			}
 
-			int numParts = (fileSize + config.partSizeBytes - 1) / config.partSizeBytes;
+			maxConcurrentDownloads = endpoint->knobs.concurrent_reads_per_file;
+			maxPartSize = getPartSize(endpoint, fileSize, maxConcurrentDownloads, config);
+			int numParts = (fileSize + maxPartSize - 1) / maxPartSize;
 			parts.reserve(numParts);
 			Reference<IAsyncFile> f = wait(IAsyncFileSystem::filesystem()->open(
 			    filepath,
@@ -874,15 +903,15 @@ ACTOR static Future<Void> copyDownFile(Reference<S3BlobStoreEndpoint> endpoint,
 
 			offset = 0;
 			partNumber = 1;
-			maxConcurrentDownloads = CLIENT_KNOBS->BLOBSTORE_CONCURRENT_READS_PER_FILE;
 			activeDownloadFutures.clear();
 			activePartIndices.clear();
 
-			// Process parts in batches with concurrency limit
-			while (offset < fileSize) {
+			// Keep up to maxConcurrentDownloads parts in flight, starting the next part as soon as any one completes
+			// rather than waiting for the slowest part of a batch
+			while (offset < fileSize || !activeDownloadFutures.empty()) {
 				// Fill up to maxConcurrentDownloads active downloads
 				while (activeDownloadFutures.size() < maxConcurrentDownloads && offset < fileSize) {
-					partSize = std::min(config.partSizeBytes, fileSize - offset);
+					partSize = std::min(maxPartSize, fileSize - offset);
 					parts.emplace_back(partNumber, offset, partSize, "");
 					activeDownloadFutures.push_back(
 					    downloadPart(endpoint, bucket, objectName, file, parts.back(), config));
@@ -891,17 +920,10 @@ ACTOR static Future<Void> copyDownFile(Reference<S3BlobStoreEndpoint> endpoint,
 					partNumber++;
 				}
 
-				// Wait for all active downloads to complete
-				if (!activeDownloadFutures.empty()) {
-					std::vector<PartState> completedParts = wait(getAll(activeDownloadFutures));
-					// Update parts with completion status
-					for (int i = 0; i < completedParts.size(); i++) {
-						parts[activePartIndices[i]] = completedParts[i];
-					}
-					// Memory is automatically freed when downloadPart actors complete
-					activeDownloadFutures.clear();
-					activePartIndices.clear();
-				}
+				// Wait for any active download to complete
+				wait(waitForAny(activeDownloadFutures));
+				// Memory is automatically freed when downloadPart actors complete
+				collectCompletedParts(activeDownloadFutures, activePartIndices, parts);
 			}
 
 			// Verify all parts completed
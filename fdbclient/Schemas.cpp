@@ -113,6 +113,7 @@ const KeyRef JSONSchemas::statusSchema = R"statusSchema(
                   "kvstore_total_size":12341234,
                   "kvstore_total_nodes":12341234,
                   "kvstore_inline_keys":12341234,
+                  "kvstore_memory_bytes":12341234,
                   "durable_bytes":{
                      "hz":0.0,
                      "counter":0,
@@ -266,6 +267,20 @@ const KeyRef JSONSchemas::statusSchema = R"statusSchema(
                      "p99":0.0,
                      "p99.9":0.0
                   },
+                  "read_stage_latency_statistics":{
+                     "$map":{
+                        "count":0,
+                        "min":0.0,
+                        "max":0.0,
+                        "median":0.0,
+                        "mean":0.0,
+                        "p25":0.0,
+                        "p90":0.0,
+                        "p95":0.0,
+                        "p99":0.0,
+                        "p99.9":0.0
+                     }
+                  },
                   "commit_latency_statistics":{
                      "count":0,
                      "min":0.0,
@@ -290,6 +305,32 @@ const KeyRef JSONSchemas::statusSchema = R"statusSchema(
                      "p99":0.0,
                      "p99.9":0.0
                   },
+                  "commit_batching_desired_bytes":{
+                     "count":0,
+                     "min":0.0,
+                     "max":0.0,
+                     "median":0.0,
+                     "mean":0.0,
+                     "p25":0.0,
+                     "p90":0.0,
+                     "p95":0.0,
+                     "p99":0.0,
+                     "p99.9":0.0
+                  },
+                  "commit_stage_latency_statistics":{
+                     "$map":{
+                        "count":0,
+                        "min":0.0,
+                        "max":0.0,
+                        "median":0.0,
+                        "mean":0.0,
+                        "p25":0.0,
+                        "p90":0.0,
+                        "p95":0.0,
+                        "p99":0.0,
+                        "p99.9":0.0
+                     }
+                  },
                   "grv_latency_bands":{
                      "$map": 1
                   },
@@ -632,6 +673,15 @@ const KeyRef JSONSchemas::statusSchema = R"statusSchema(
       ],
       "recovery_state":{
          "seconds_since_last_recovered":1,
+         "seconds_in_state":1,
+         "last_recovery_timeline":{
+            "coordinated_state_read":1,
+            "coordinated_state_locked":1,
+            "old_logs_locked":1,
+            "transaction_servers_recruited":1,
+            "recovery_transaction_committed":1,
+            "accepting_commits":1
+         },
          "required_resolvers":1,
          "required_commit_proxies":1,
          "required_grv_proxies":1,
@@ -1438,6 +1488,15 @@ file is writable and has not been overwritten externally."
       ],
       "recovery_state":{
          "seconds_since_last_recovered":1,
+         "seconds_in_state":1,
+         "last_recovery_timeline":{
+            "coordinated_state_read":1,
+            "coordinated_state_locked":1,
+            "old_logs_locked":1,
+            "transaction_servers_recruited":1,
+            "recovery_transaction_committed":1,
+            "accepting_commits":1
+         },
          "required_resolvers":1,
          "required_commit_proxies":1,
          "required_grv_proxies":1,
@@ -65,6 +65,7 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( BUGGIFY_WORKER_REMOVED_MAX_LAG,                         30 );
 	init( UPDATE_STORAGE_BYTE_LIMIT,                             1e6 );
 	init( TLOG_PEEK_DELAY,                                    0.0005 );
+	init( TLOG_PEEK_STREAM_DELAY,                                0.0 ); if ( randomize && BUGGIFY ) TLOG_PEEK_STREAM_DELAY = 0.001;
 	init( LEGACY_TLOG_UPGRADE_ENTRIES_PER_VERSION,               100 );
 	init( VERSION_MESSAGES_OVERHEAD_FACTOR_1024THS,             1072 ); // Based on a naive interpretation of the gcc version of std::deque, we would expect this to be 16 bytes overhead per 512 bytes data. In practice, it seems to be 24 bytes overhead per 512.
 	init( VERSION_MESSAGES_ENTRY_BYTES_WITH_OVERHEAD, std::ceil(16.0 * VERSION_MESSAGES_OVERHEAD_FACTOR_1024THS / 1024) );
@@ -72,6 +73,7 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( MAX_MESSAGE_SIZE,            std::max<int>(LOG_SYSTEM_PUSHED_DATA_BLOCK_SIZE, 1e5 + 2e4 + 1) + 8 ); // VALUE_SIZE_LIMIT + SYSTEM_KEY_SIZE_LIMIT + 9 bytes (4 bytes for length, 4 bytes for sequence number, and 1 byte for mutation type)
 	init( TLOG_MESSAGE_BLOCK_BYTES,                             10e6 );
 	init( TLOG_MESSAGE_BLOCK_OVERHEAD_FACTOR,      double(TLOG_MESSAGE_BLOCK_BYTES) / (TLOG_MESSAGE_BLOCK_BYTES - MAX_MESSAGE_SIZE) ); //1.0121466709838096006362758832473
+	init( TLOG_EXACT_MESSAGE_BLOCK_ACCOUNTING,                 false ); if( randomize && BUGGIFY ) TLOG_EXACT_MESSAGE_BLOCK_ACCOUNTING = true;
 	init( PEEK_TRACKER_EXPIRATION_TIME,                          600 ); if( randomize && BUGGIFY ) PEEK_TRACKER_EXPIRATION_TIME = 120; // Cannot be buggified lower without changing the following assert in LogSystemPeekCursor.actor.cpp: ASSERT_WE_THINK(e.code() == error_code_operation_obsolete || SERVER_KNOBS->PEEK_TRACKER_EXPIRATION_TIME < 10);
 	init( PEEK_USING_STREAMING,                                false ); if( randomize && isSimulated && BUGGIFY ) PEEK_USING_STREAMING = true;
 	init( PARALLEL_GET_MORE_REQUESTS,                             32 ); if( randomize && BUGGIFY ) PARALLEL_GET_MORE_REQUESTS = 2;
@@ -88,8 +90,17 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( TLOG_SPILL_REFERENCE_MAX_PEEK_MEMORY_BYTES,            2e9 ); if ( randomize && BUGGIFY ) TLOG_SPILL_REFERENCE_MAX_PEEK_MEMORY_BYTES = 2e6;
 	init( TLOG_SPILL_REFERENCE_MAX_BATCHES_PER_PEEK,           100 ); if ( randomize && BUGGIFY ) TLOG_SPILL_REFERENCE_MAX_BATCHES_PER_PEEK = 1;
 	init( TLOG_SPILL_REFERENCE_MAX_BYTES_PER_BATCH,           16<<10 ); if ( randomize && BUGGIFY ) TLOG_SPILL_REFERENCE_MAX_BYTES_PER_BATCH = 500;
+	init( TLOG_SPILL_REFERENCE_MAX_READ_BYTES,                1<<20 ); if ( randomize && BUGGIFY ) TLOG_SPILL_REFERENCE_MAX_READ_BYTES = deterministicRandom()->randomInt(0, 100000);
+	init( TLOG_SPILL_REFERENCE_READAHEAD,                       true ); if ( randomize && BUGGIFY ) TLOG_SPILL_REFERENCE_READAHEAD = false;
+	init( TLOG_SPILLED_COMMIT_INDEX_BYTES,                      10e6 ); if ( randomize && BUGGIFY ) TLOG_SPILLED_COMMIT_INDEX_BYTES = deterministicRandom()->randomInt(0, 10000);
+	init( TLOG_QUEUE_COMPRESSION_FILTER,                      "NONE" ); if ( randomize && BUGGIFY ) TLOG_QUEUE_COMPRESSION_FILTER = "ZSTD"; // Set to NONE by tests which downgrade, since older versions cannot read compressed entries
+	init( TLOG_QUEUE_COMPRESSION_MIN_BYTES,                     4096 ); if ( randomize && BUGGIFY ) TLOG_QUEUE_COMPRESSION_MIN_BYTES = deterministicRandom()->randomInt(0, 1000);
+	init( TLOG_QUEUE_COMPRESSION_MAX_RATIO,                      0.9 ); if ( randomize && BUGGIFY ) TLOG_QUEUE_COMPRESSION_MAX_RATIO = 1.0;
+	init( TLOG_DISK_QUEUE_FOLDER,                                 "" );
+	init( TLOG_OLD_GENERATION_COMPACTION_BYTES,                    0 ); if ( randomize && BUGGIFY ) TLOG_OLD_GENERATION_COMPACTION_BYTES = deterministicRandom()->randomInt(1, 1e6); // Set to 0 by tests which downgrade, since older versions cannot read compacted data
 	init( DISK_QUEUE_FILE_EXTENSION_BYTES,                    10<<20 ); // BUGGIFYd per file within the DiskQueue
 	init( DISK_QUEUE_FILE_SHRINK_BYTES,                      100<<20 ); // BUGGIFYd per file within the DiskQueue
+	init( DISK_QUEUE_SYNC_BATCH_WINDOW,                          0.0 ); if ( randomize && BUGGIFY ) DISK_QUEUE_SYNC_BATCH_WINDOW = deterministicRandom()->random01() * 0.001;
 	init( DISK_QUEUE_MAX_TRUNCATE_BYTES,                     2LL<<30 ); if ( randomize && BUGGIFY ) DISK_QUEUE_MAX_TRUNCATE_BYTES = 0;
 	init( TLOG_DEGRADED_DURATION,                                5.0 );
 	init( TLOG_IGNORE_POP_AUTO_ENABLE_DELAY,                   300.0 );
@@ -146,6 +157,7 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( WIGGLING_RELOCATION_PARALLELISM_PER_SOURCE_SERVER,       2 ); if( randomize && BUGGIFY ) WIGGLING_RELOCATION_PARALLELISM_PER_SOURCE_SERVER = 1;
 	init( RELOCATION_PARALLELISM_PER_SOURCE_SERVER,                2 ); if( randomize && BUGGIFY ) RELOCATION_PARALLELISM_PER_SOURCE_SERVER = 1;
 	init( RELOCATION_PARALLELISM_PER_DEST_SERVER,                 10 ); if( randomize && BUGGIFY ) RELOCATION_PARALLELISM_PER_DEST_SERVER = 1; // Note: if this is smaller than FETCH_KEYS_PARALLELISM, this will artificially reduce performance. The current default of 10 is probably too high but is set conservatively for now.
+	init( HEALING_RELOCATION_PARALLELISM_PER_DEST_SERVER,         20 ); if( randomize && BUGGIFY ) HEALING_RELOCATION_PARALLELISM_PER_DEST_SERVER = 1;
 	init( MERGE_RELOCATION_PARALLELISM_PER_TEAM,                   6 ); if (randomize && BUGGIFY ) MERGE_RELOCATION_PARALLELISM_PER_TEAM = 1;
 	init( DD_QUEUE_MAX_KEY_SERVERS,                              100 ); // Do not buggify
 	init( DD_REBALANCE_PARALLELISM,                               50 );
@@ -191,6 +203,7 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	// In simulation, the CPU percent of every storage server is hard-coded as 100.0%. It is difficult to test pivot CPU in normal simulation. TODO: add mock DD Test case for it.
 	// TODO: choose a meaning value for real cluster
 	init( MAX_DEST_CPU_PERCENT, 		  					   100.0 );
+	init( MAX_DEST_DISK_BUSY_PERCENT,                          100.0 );
 	init( DD_TEAM_PIVOT_UPDATE_DELAY,                            5.0 );
 
 	init( ALLOW_LARGE_SHARD,                                   false ); if( randomize && BUGGIFY )  ALLOW_LARGE_SHARD = true;
@@ -199,6 +212,7 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( ENABLE_DD_PHYSICAL_SHARD,                            false ); // EXPERIMENTAL; If true, SHARD_ENCODE_LOCATION_METADATA must be true; When true, optimization of data move between DCs is disabled
 	init( DD_PHYSICAL_SHARD_MOVE_PROBABILITY,                    0.0 ); // FIXME: re-enable after ShardedRocksDB is well tested by simulation
 	init( ENABLE_PHYSICAL_SHARD_MOVE_EXPERIMENT,               false ); // FIXME: re-enable after ShardedRocksDB is well tested by simulation
+	init( DD_PHYSICAL_SHARD_MOVE_FOR_WIGGLE,                   false ); // Perpetual wiggle data moves are physical shard moves; storage servers which are not shard aware fall back to fetchKeys
 	init( MAX_PHYSICAL_SHARD_BYTES,                         10000000 ); // 10 MB; for ENABLE_DD_PHYSICAL_SHARD; smaller leads to larger number of physicalShard per storage server
  	init( PHYSICAL_SHARD_METRICS_DELAY,                        300.0 ); // 300 seconds; for ENABLE_DD_PHYSICAL_SHARD
 	init( ANONYMOUS_PHYSICAL_SHARD_TRANSITION_TIME,            600.0 ); if( randomize && BUGGIFY )  ANONYMOUS_PHYSICAL_SHARD_TRANSITION_TIME = 0.0; // 600 seconds; for ENABLE_DD_PHYSICAL_SHARD
@@ -282,6 +296,8 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 
 	init( DD_SHARD_USABLE_REGION_CHECK_RATE,                       2 );
 	init( ENABLE_WRITE_BASED_SHARD_SPLIT,                      false ); if( randomize && BUGGIFY ) ENABLE_WRITE_BASED_SHARD_SPLIT = true;
+	init( SHARD_MAX_WRITE_OPS_PER_KSEC,                20000 * 1000 ); if( randomize && BUGGIFY ) SHARD_MAX_WRITE_OPS_PER_KSEC = 500 * 1000;
+	init( SHARD_SPLIT_WRITE_OPS_PER_KSEC,               5000 * 1000 ); if( randomize && BUGGIFY ) SHARD_SPLIT_WRITE_OPS_PER_KSEC = 200 * 1000;
 	init( STORAGE_METRIC_TIMEOUT,         isSimulated ? 60.0 : 600.0 ); if( randomize && BUGGIFY ) STORAGE_METRIC_TIMEOUT = deterministicRandom()->coinflip() ? 10.0 : 30.0;
 	init( METRIC_DELAY,                                          0.1 ); if( randomize && BUGGIFY ) METRIC_DELAY = 1.0;
 	init( ALL_DATA_REMOVED_DELAY,                                1.0 );
@@ -353,6 +369,7 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( ENFORCE_SHARD_COUNT_PER_TEAM,                        false ); if( randomize && BUGGIFY ) ENFORCE_SHARD_COUNT_PER_TEAM = true;
 	init( DESIRED_MAX_SHARDS_PER_TEAM,                          1000 ); if( randomize && BUGGIFY ) DESIRED_MAX_SHARDS_PER_TEAM = 10;
 	init( ENABLE_STORAGE_QUEUE_AWARE_TEAM_SELECTION,           false ); if( randomize && BUGGIFY ) ENABLE_STORAGE_QUEUE_AWARE_TEAM_SELECTION = true;
+	init( MAX_DEST_DURABILITY_LAG_VERSIONS,                    350e6 ); if( randomize && BUGGIFY ) MAX_DEST_DURABILITY_LAG_VERSIONS = 50e6; // The same as TARGET_DURABILITY_LAG_VERSIONS
 	init( DD_LONG_STORAGE_QUEUE_TEAM_MAJORITY_PERCENTILE,        0.5 ); if( randomize && BUGGIFY ) DD_LONG_STORAGE_QUEUE_TEAM_MAJORITY_PERCENTILE = deterministicRandom()->random01();
 	init( ENABLE_REBALANCE_STORAGE_QUEUE,                      false ); if( randomize && BUGGIFY ) ENABLE_REBALANCE_STORAGE_QUEUE = true;
  	init( REBALANCE_STORAGE_QUEUE_LONG_BYTES, TARGET_BYTES_PER_STORAGE_SERVER*0.15); if( randomize && BUGGIFY ) REBALANCE_STORAGE_QUEUE_LONG_BYTES = TARGET_BYTES_PER_STORAGE_SERVER*0.05;
@@ -375,6 +392,7 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( BULKLOAD_FILE_BYTES_MAX,                  1*1024*1024*1024 ); // 1GB
 	init( BULKLOAD_DOWNLOAD_RETRY_DELAY,                         2.0 ); // Retry delay for bulk load file downloads - reasonable for both S3 and simulation
 	init( BULKLOAD_DOWNLOAD_MAX_RETRIES,                          20 ); // Maximum retries for bulk load downloads - 20 retries × 2s = 40s total
+	init( BULKLOAD_DOWNLOAD_FILESET_PARALLELISM,                   4 ); if( randomize && BUGGIFY ) BULKLOAD_DOWNLOAD_FILESET_PARALLELISM = deterministicRandom()->randomInt(1, 5);
 	init( BULKLOAD_BYTE_SAMPLE_BATCH_KEY_COUNT,                10000 ); if( randomize && BUGGIFY ) BULKLOAD_BYTE_SAMPLE_BATCH_KEY_COUNT = deterministicRandom()->randomInt(2, 1000);
 	init( DD_BULKLOAD_SHARD_BOUNDARY_CHANGE_DELAY_SEC,          60.0 ); if( randomize && BUGGIFY ) DD_BULKLOAD_SHARD_BOUNDARY_CHANGE_DELAY_SEC = deterministicRandom()->random01() * 10 + 1;
 	init( DD_BULKLOAD_TASK_METADATA_READ_SIZE,                   100 ); if( randomize && BUGGIFY ) DD_BULKLOAD_TASK_METADATA_READ_SIZE = deterministicRandom()->randomInt(2, 100);
@@ -516,6 +534,7 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( ROCKSDB_READ_CHECKPOINT_TIMEOUT, isSimulated ? 300.0 : 5.0 );
 	init( ROCKSDB_CHECKPOINT_READ_AHEAD_SIZE,                2 << 20 ); // 2M
 	init( ROCKSDB_READ_QUEUE_WAIT,                               1.0 );
+	init( ROCKSDB_READ_VALUE_BATCH_MAX_KEYS,                      32 ); if( randomize && BUGGIFY ) ROCKSDB_READ_VALUE_BATCH_MAX_KEYS = deterministicRandom()->randomInt(1, 64);
 	init( ROCKSDB_READ_QUEUE_HARD_MAX,                          1000 );
 	init( ROCKSDB_READ_QUEUE_SOFT_MAX,                           500 );
 	init( ROCKSDB_FETCH_QUEUE_HARD_MAX,                          100 );
@@ -527,6 +546,8 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( SHARDED_ROCKSDB_REUSE_ITERATORS,                     false ); if (isSimulated) SHARDED_ROCKSDB_REUSE_ITERATORS = deterministicRandom()->coinflip(); 
 	init( ROCKSDB_READ_RANGE_REUSE_BOUNDED_ITERATORS,          false ); if( randomize && BUGGIFY ) ROCKSDB_READ_RANGE_REUSE_BOUNDED_ITERATORS = deterministicRandom()->coinflip();
 	init( ROCKSDB_READ_RANGE_BOUNDED_ITERATORS_MAX_LIMIT,        200 );
+	// Lets range read iterators prefetch the next data blocks asynchronously instead of blocking on each block read.
+	init( ROCKSDB_READ_ASYNC_IO,                               false ); if (isSimulated) ROCKSDB_READ_ASYNC_IO = deterministicRandom()->coinflip();
 	// Set to 0 to disable rocksdb write rate limiting. Rate limiter unit: bytes per second.
 	init( ROCKSDB_WRITE_RATE_LIMITER_BYTES_PER_SEC,        200000000 );
 	init( ROCKSDB_WRITE_RATE_LIMITER_FAIRNESS,                    10 ); // RocksDB default 10
@@ -537,6 +558,7 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 
 	init( ROCKSDB_PERFCONTEXT_ENABLE,                          false ); if( randomize && BUGGIFY ) ROCKSDB_PERFCONTEXT_ENABLE = deterministicRandom()->coinflip();
 	init( ROCKSDB_PERFCONTEXT_SAMPLE_RATE,                    0.0001 );
+	init( ROCKSDB_PERFCONTEXT_READ_TRACE_SAMPLE_RATE,            0.0 ); if( randomize && BUGGIFY ) ROCKSDB_PERFCONTEXT_READ_TRACE_SAMPLE_RATE = 0.01;
 	init( ROCKSDB_METRICS_SAMPLE_INTERVAL,						 0.0 );
 	init( ROCKSDB_MAX_SUBCOMPACTIONS,                              3 );
 	init( ROCKSDB_SOFT_PENDING_COMPACT_BYTES_LIMIT,     128000000000 ); // 128GB, Rocksdb option, Writes will slow down.
@@ -620,6 +642,10 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( ROCKSDB_MEMTABLE_PROTECTION_BYTES_PER_KEY,               0 ); if ( randomize && BUGGIFY ) ROCKSDB_MEMTABLE_PROTECTION_BYTES_PER_KEY = 8; // Default: 0 (disabled). Supported values: 0, 1, 2, 4, 8.
 	// Block cache key-value checksum. Checksum is validated during read, so has non-trivial impact on read performance.
 	init( ROCKSDB_BLOCK_PROTECTION_BYTES_PER_KEY,                  0 ); if ( randomize && BUGGIFY ) ROCKSDB_BLOCK_PROTECTION_BYTES_PER_KEY = 8; // Default: 0 (disabled). Supported values: 0, 1, 2, 4, 8.
+	// Write pipelining and commit batch visibility
+	init( ROCKSDB_ENABLE_PIPELINED_WRITE,                      false ); if( randomize && BUGGIFY ) ROCKSDB_ENABLE_PIPELINED_WRITE = deterministicRandom()->coinflip();
+	init( ROCKSDB_ALLOW_CONCURRENT_MEMTABLE_WRITE,              true );
+	init( ROCKSDB_LARGE_COMMIT_BYTES,                       20000000 ); if( randomize && BUGGIFY ) ROCKSDB_LARGE_COMMIT_BYTES = 100000; // Commits at least this large are counted and traced
 	init( ROCKSDB_ENABLE_NONDETERMINISM,                      false );
 	init( SHARDED_ROCKSDB_ALLOW_MULTIPLE_RANGES,              false );
 	init( SHARDED_ROCKSDB_ALLOW_WRITE_STALL_ON_FLUSH,          false );	
@@ -631,6 +657,10 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( SHARDED_ROCKSDB_COMPACTION_PERIOD, isSimulated? 3600 : 2592000 ); // 30d
 	init( SHARDED_ROCKSDB_COMPACTION_ACTOR_DELAY,               3600 ); // 1h
 	init( SHARDED_ROCKSDB_COMPACTION_SHARD_LIMIT,                 -1 );
+	init( SHARDED_ROCKSDB_CLEAN_UP_VACATED_RANGES,              true ); if( randomize && BUGGIFY ) SHARDED_ROCKSDB_CLEAN_UP_VACATED_RANGES = false;
+	init( SHARDED_ROCKSDB_VACATED_RANGE_CLEAN_UP_INTERVAL,      10.0 ); if( randomize && BUGGIFY ) SHARDED_ROCKSDB_VACATED_RANGE_CLEAN_UP_INTERVAL = 1.0;
+	init( SHARDED_ROCKSDB_VACATED_RANGE_CLEAN_UP_LIMIT,           10 );
+	init( SHARDED_ROCKSDB_VACATED_RANGE_MAX_DISK_UTILIZATION,    0.5 ); // Skip the clean up while the disk is busier than this
 	init( SHARDED_ROCKSDB_WRITE_BUFFER_SIZE, (isSimulated && !buggifySmallShards && !buggifySmallBandwidthSplit && !simulationMediumShards) ? 128 << 20 : 16 << 20 );  // 16MB
 	init( SHARDED_ROCKSDB_TOTAL_WRITE_BUFFER_SIZE,         2LL << 30 ); // 2GB
 	init( SHARDED_ROCKSDB_MEMTABLE_BUDGET,                  64 << 20 ); // 64MB
@@ -645,6 +675,11 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( SHARDED_ROCKSDB_BLOCK_CACHE_SIZE, isSimulated?   128 << 20 : 3LL << 30); // 3GB
 	init( SHARDED_ROCKSDB_CACHE_HIGH_PRI_POOL_RATIO,              0.5 ); /* Share of high priority Index&filter blocks in cache */
 	init( SHARDED_ROCKSDB_CACHE_INDEX_AND_FILTER_BLOCKS,         true );
+	init( SHARDED_ROCKSDB_CHARGE_MEMTABLES_TO_BLOCK_CACHE,  false ); if( randomize && BUGGIFY ) SHARDED_ROCKSDB_CHARGE_MEMTABLES_TO_BLOCK_CACHE = true;
+	// Set to 0 to let every physical shard fill the block cache regardless of how little of the read traffic it takes.
+	init( SHARDED_ROCKSDB_CACHE_FILL_MIN_READ_FRACTION,       0.0 ); if( randomize && BUGGIFY ) SHARDED_ROCKSDB_CACHE_FILL_MIN_READ_FRACTION = deterministicRandom()->random01();
+	init( SHARDED_ROCKSDB_COLD_SHARD_MAX_READ_BYTES_PER_SEC,     1e3 );
+	init( SHARDED_ROCKSDB_COLD_SHARD_MIN_IDLE_TIME,          86400.0 ); if( randomize && BUGGIFY ) SHARDED_ROCKSDB_COLD_SHARD_MIN_IDLE_TIME = 30.0;
 	// Set to 0 to disable rocksdb write rate limiting. Rate limiter unit: bytes per second.
 	init( SHARDED_ROCKSDB_WRITE_RATE_LIMITER_BYTES_PER_SEC,        300 << 20 );
 	init( SHARDED_ROCKSDB_RATE_LIMITER_MODE,                       2 );
@@ -658,6 +693,10 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( SHARDED_ROCKSDB_COMPACTION_PRI,                          3 ); // kMinOverlappingRatio, RocksDB default.
 	init (SHARDED_ROCKSDB_READ_ASYNC_IO,                       false ); if (isSimulated) SHARDED_ROCKSDB_READ_ASYNC_IO = deterministicRandom()->coinflip();
 	init( SHARDED_ROCKSDB_PREFIX_LEN,                             11 ); if( randomize && BUGGIFY )  SHARDED_ROCKSDB_PREFIX_LEN = deterministicRandom()->randomInt(1, 20);
+	// Comma separated <key prefix>:<prefix length> entries. A new physical shard whose first range begins with a key
+	// prefix uses a prefix filter of that length, e.g. "\x15\x01:4" for tuple-encoded index keys under (1,).
+	init( SHARDED_ROCKSDB_PREFIX_FILTER_RANGES,                   "" );
+	init( SHARDED_ROCKSDB_USE_RIBBON_FILTER,                   false ); if( randomize && BUGGIFY ) SHARDED_ROCKSDB_USE_RIBBON_FILTER = true;
 	init( SHARDED_ROCKSDB_BLOOM_FILTER_BITS,                       3 ); if( randomize && BUGGIFY )  SHARDED_ROCKSDB_BLOOM_FILTER_BITS = deterministicRandom()->randomInt(3, 10);
 	init (SHARDED_ROCKSDB_MEMTABLE_BLOOM_FILTER_RATIO,           0.1 );
 	init( SHARDED_ROCKSDB_USE_DIRECT_IO,                       false ); if (isSimulated) SHARDED_ROCKSDB_USE_DIRECT_IO = deterministicRandom()->coinflip();
@@ -689,6 +728,7 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( START_TRANSACTION_MAX_EMPTY_QUEUE_BUDGET,             10.0 );
 	init( TAG_THROTTLE_MAX_EMPTY_QUEUE_BUDGET,                1000.0 );
 	init( START_TRANSACTION_MAX_QUEUE_SIZE,                      1e6 ); if ( randomize && BUGGIFY ) START_TRANSACTION_MAX_QUEUE_SIZE = 1000;
+	init( START_TRANSACTION_MAX_QUEUE_TIME,                      0.0 ); if ( randomize && BUGGIFY ) START_TRANSACTION_MAX_QUEUE_TIME = 1.0;
 	init( KEY_LOCATION_MAX_QUEUE_SIZE,                           1e6 );
 
 	init( COMMIT_PROXY_LIVENESS_TIMEOUT,                        20.0 );
@@ -711,6 +751,10 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( COMMIT_TRANSACTION_BATCH_BYTES_MAX,                  100000 ); if( randomize && BUGGIFY ) { COMMIT_TRANSACTION_BATCH_BYTES_MIN = COMMIT_TRANSACTION_BATCH_BYTES_MAX = 1000000; }
 	init( COMMIT_TRANSACTION_BATCH_BYTES_SCALE_BASE,           100000 );
 	init( COMMIT_TRANSACTION_BATCH_BYTES_SCALE_POWER,             0.0 );
+	init( COMMIT_BATCH_ADAPTIVE_ENABLED,                        false ); if( randomize && BUGGIFY ) COMMIT_BATCH_ADAPTIVE_ENABLED = deterministicRandom()->coinflip();
+	init( COMMIT_BATCH_ADAPTIVE_QUEUED_BATCHES,                     2 ); if( randomize && BUGGIFY ) COMMIT_BATCH_ADAPTIVE_QUEUED_BATCHES = deterministicRandom()->randomInt(0, 4);
+	init( COMMIT_BATCH_ADAPTIVE_GROWTH,                          1.25 );
+	init( COMMIT_BATCH_ADAPTIVE_BYTES_MAX,                        1e6 ); if( randomize && BUGGIFY ) COMMIT_BATCH_ADAPTIVE_BYTES_MAX = 200000;
 
 	init( RESOLVER_COALESCE_TIME,                                1.0 );
 	init( BUGGIFIED_ROW_LIMIT,                  APPLY_MUTATION_BYTES ); if( randomize && BUGGIFY ) BUGGIFIED_ROW_LIMIT = deterministicRandom()->randomInt(3, 30);
@@ -723,15 +767,19 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( ENFORCED_MIN_RECOVERY_DURATION,                       0.085 ); if( shortRecoveryDuration ) ENFORCED_MIN_RECOVERY_DURATION = 0.01;
 	init( REQUIRED_MIN_RECOVERY_DURATION,                       0.080 ); if( shortRecoveryDuration ) REQUIRED_MIN_RECOVERY_DURATION = 0.01;
 	init( ALWAYS_CAUSAL_READ_RISKY,                             false );
+	init( GRV_PROXY_CAUSAL_READ_RISKY_CACHE_TIME,                 0.0 ); if( randomize && BUGGIFY ) GRV_PROXY_CAUSAL_READ_RISKY_CACHE_TIME = deterministicRandom()->random01() * 0.1;
 	init( MAX_COMMIT_UPDATES,                                    2000 ); if( randomize && BUGGIFY ) MAX_COMMIT_UPDATES = 1;
 	init( MAX_PROXY_COMPUTE,                                      2.0 );
 	init( MAX_COMPUTE_PER_OPERATION,                              0.1 );
 	init( MAX_COMPUTE_DURATION_LOG_CUTOFF,                       0.05 );
 	init( PROXY_COMPUTE_BUCKETS,                                20000 );
 	init( PROXY_COMPUTE_GROWTH_RATE,                             0.01 );
+	init( PROXY_PIPELINED_RESOLUTION,                           false ); if( randomize && BUGGIFY ) PROXY_PIPELINED_RESOLUTION = deterministicRandom()->coinflip();
+	init( PROXY_PIPELINED_RESOLUTION_DEPTH,                         2 ); if( randomize && BUGGIFY ) PROXY_PIPELINED_RESOLUTION_DEPTH = deterministicRandom()->randomInt(1, 5);
 	init( TXN_STATE_SEND_AMOUNT,                                    4 );
 	init( REPORT_TRANSACTION_COST_ESTIMATION_DELAY,               0.1 );
 	init( PROXY_REJECT_BATCH_QUEUED_TOO_LONG,                    true );
+	init( LOG_PUSH_SHARED_MUTATION_MIN_BYTES,                10000 ); if( randomize && BUGGIFY ) LOG_PUSH_SHARED_MUTATION_MIN_BYTES = deterministicRandom()->randomInt(0, 200);
 
 	bool buggfyUseResolverPrivateMutations = randomize && BUGGIFY && !ENABLE_VERSION_VECTOR_TLOG_UNICAST;
 	init( PROXY_USE_RESOLVER_PRIVATE_MUTATIONS,                 false ); if( buggfyUseResolverPrivateMutations ) PROXY_USE_RESOLVER_PRIVATE_MUTATIONS = deterministicRandom()->coinflip();
@@ -756,6 +804,7 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( KEY_BYTES_PER_SAMPLE,                                  2e4 ); if( fastBalancing ) KEY_BYTES_PER_SAMPLE = 1e3;
 	init( MIN_BALANCE_TIME,                                      0.2 );
 	init( MIN_BALANCE_DIFFERENCE,                                1e6 ); if( fastBalancing ) MIN_BALANCE_DIFFERENCE = 1e4;
+	init( RESOLUTION_BALANCE_PAIRS,                                1 ); if( randomize && BUGGIFY ) RESOLUTION_BALANCE_PAIRS = deterministicRandom()->randomInt(2, 5);
 	init( SECONDS_BEFORE_NO_FAILURE_DELAY,                  8 * 3600 );
 	init( MAX_TXS_SEND_MEMORY,                                   1e7 ); if( randomize && BUGGIFY ) MAX_TXS_SEND_MEMORY = 1e5;
 	init( MAX_RECOVERY_VERSIONS,           200 * VERSIONS_PER_SECOND );
@@ -771,6 +820,9 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( SAMPLE_EXPIRATION_TIME,                                1.0 );
 	init( SAMPLE_POLL_TIME,                                      0.1 );
 	init( RESOLVER_STATE_MEMORY_LIMIT,                           1e6 );
+	init( RESOLVER_CONFLICT_THREADS,                               0 ); if( randomize && BUGGIFY ) RESOLVER_CONFLICT_THREADS = deterministicRandom()->randomInt(2, 5);
+	init( RESOLVER_PARALLEL_CONFLICT_MIN_RANGES,                1000 ); if( randomize && BUGGIFY ) RESOLVER_PARALLEL_CONFLICT_MIN_RANGES = 1;
+	init( RESOLVER_USE_ART_CONFLICT_SET,                       false ); if( randomize && BUGGIFY ) RESOLVER_USE_ART_CONFLICT_SET = deterministicRandom()->coinflip();
 	init( LAST_LIMITED_RATIO,                                    2.0 );
 
 	// Backup Worker
@@ -779,6 +831,8 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( BACKUP_FILE_BLOCK_BYTES,                       1024 * 1024 );
 	init( BACKUP_WORKER_LOCK_BYTES,                              3e9 ); if(randomize && BUGGIFY) BACKUP_WORKER_LOCK_BYTES = deterministicRandom()->randomInt(2048, 4096) * 4096;
 	init( BACKUP_UPLOAD_DELAY,                                  10.0 ); if(randomize && BUGGIFY) BACKUP_UPLOAD_DELAY = deterministicRandom()->random01() * 60;
+	init( BACKUP_LOG_COMPRESSION_FILTER,                      "NONE" ); if(randomize && BUGGIFY) BACKUP_LOG_COMPRESSION_FILTER = "ZSTD"; // Set to NONE by tests which downgrade, since older versions cannot read compressed logs
+	init( BACKUP_LOG_COMPRESSION_MAX_RATIO,                      8.0 ); if(randomize && BUGGIFY) BACKUP_LOG_COMPRESSION_MAX_RATIO = 1.0;
 
 	//Cluster Controller
 	init( CLUSTER_CONTROLLER_LOGGING_DELAY,                      5.0 );
@@ -898,6 +952,7 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( RATEKEEPER_MAX_RATE,                                   1e9 );
 	init( RATEKEEPER_BATCH_MIN_RATE,                             0.0 );
 	init( RATEKEEPER_BATCH_MAX_RATE,                             1e9 );
+	init( RATEKEEPER_QUEUE_PROJECTION_SECONDS,                   0.0 ); if( randomize && BUGGIFY ) RATEKEEPER_QUEUE_PROJECTION_SECONDS = deterministicRandom()->random01() * 5.0;
 
 	bool smallStorageTarget = randomize && BUGGIFY;
 	init( TARGET_BYTES_PER_STORAGE_SERVER,                    1000e6 ); if( smallStorageTarget ) TARGET_BYTES_PER_STORAGE_SERVER = 3000e3;
@@ -910,6 +965,9 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( STORAGE_HARD_LIMIT_BYTES_OVERAGE,                   5000e3 ); if( smallStorageTarget ) STORAGE_HARD_LIMIT_BYTES_OVERAGE = 100e3; // byte+version overage ensures storage server makes enough progress on freeing up storage queue memory at hard limit by ensuring it advances desiredOldestVersion enough per commit cycle.
 	init( STORAGE_HARD_LIMIT_BYTES_SPEED_UP_SIM, STORAGE_HARD_LIMIT_BYTES ); if( smallStorageTarget ) STORAGE_HARD_LIMIT_BYTES_SPEED_UP_SIM *= 10;
 	init( STORAGE_HARD_LIMIT_BYTES_OVERAGE_SPEED_UP_SIM, STORAGE_HARD_LIMIT_BYTES_OVERAGE ); if( smallStorageTarget ) STORAGE_HARD_LIMIT_BYTES_OVERAGE_SPEED_UP_SIM *= 10;
+	// Set to 0 to always keep MAX_READ_TRANSACTION_LIFE_VERSIONS in memory regardless of the storage queue size.
+	init( STORAGE_VERSION_WINDOW_SHRINK_BYTES,                     0 ); if( randomize && BUGGIFY ) STORAGE_VERSION_WINDOW_SHRINK_BYTES = STORAGE_HARD_LIMIT_BYTES / 2;
+	init( STORAGE_MIN_VERSIONS_IN_MEMORY,        VERSIONS_PER_SECOND );
 	init( STORAGE_HARD_LIMIT_VERSION_OVERAGE, VERSIONS_PER_SECOND / 4.0 );
 	init( STORAGE_DURABILITY_LAG_HARD_MAX,                    2000e6 ); if( smallStorageTarget ) STORAGE_DURABILITY_LAG_HARD_MAX = 100e6;
 	init( STORAGE_DURABILITY_LAG_SOFT_MAX,                     250e6 ); if( smallStorageTarget ) STORAGE_DURABILITY_LAG_SOFT_MAX = 10e6;
@@ -934,6 +992,8 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( REFERENCE_SPILL_UPDATE_STORAGE_BYTE_LIMIT,            20e6 ); if( (randomize && BUGGIFY) || smallTlogTarget ) REFERENCE_SPILL_UPDATE_STORAGE_BYTE_LIMIT = 1e6;
 	init( TLOG_HARD_LIMIT_BYTES,                              3000e6 ); if( smallTlogTarget ) TLOG_HARD_LIMIT_BYTES = 30e6;
 	init( TLOG_RECOVER_MEMORY_LIMIT, TARGET_BYTES_PER_TLOG + SPRING_BYTES_TLOG );
+	// Exact accounting charges a whole TLOG_MESSAGE_BLOCK_BYTES block up front, more than the small targets allow
+	if( smallTlogTarget ) TLOG_EXACT_MESSAGE_BLOCK_ACCOUNTING = false;
 
 	init( MAX_TRANSACTIONS_PER_BYTE,                            1000 );
 
@@ -983,6 +1043,7 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( TAG_THROTTLE_EXPIRED_CLEANUP_INTERVAL,                30.0 ); if(randomize && BUGGIFY) TAG_THROTTLE_EXPIRED_CLEANUP_INTERVAL = 1.0;
 	init( AUTO_TAG_THROTTLING_ENABLED,                          true ); if(randomize && BUGGIFY) AUTO_TAG_THROTTLING_ENABLED = false;
 	init( SS_THROTTLE_TAGS_TRACKED,                                5 ); if(randomize && BUGGIFY) SS_THROTTLE_TAGS_TRACKED = deterministicRandom()->randomInt(1, 10);
+	init( SS_THROTTLE_TAGS_COUNTED,                            10000 ); if(randomize && BUGGIFY) SS_THROTTLE_TAGS_COUNTED = deterministicRandom()->randomInt(SS_THROTTLE_TAGS_TRACKED, 20);
 	init( GLOBAL_TAG_THROTTLING,                                true ); if(isSimulated) GLOBAL_TAG_THROTTLING = deterministicRandom()->coinflip();
 	init( ENFORCE_TAG_THROTTLING_ON_PROXIES,   GLOBAL_TAG_THROTTLING );
 	init( GLOBAL_TAG_THROTTLING_MIN_RATE,                        1.0 );
@@ -1026,6 +1087,7 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	//Storage Server
 	init( STORAGE_LOGGING_DELAY,                                 5.0 );
 	init( STORAGE_SERVER_POLL_METRICS_DELAY,                     1.0 );
+	init( STORAGE_READ_COST_SAMPLE_DELAY,                        1.0 );
 	init( FUTURE_VERSION_DELAY,                                  1.0 );
 	init( STORAGE_LIMIT_BYTES,                                500000 );
 	init( BUGGIFY_LIMIT_BYTES,                                  1000 );
@@ -1035,6 +1097,7 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( FETCH_KEYS_PARALLELISM_BYTES,                          4e6 ); if( randomize && BUGGIFY ) FETCH_KEYS_PARALLELISM_BYTES = 3e6;
 	init( FETCH_KEYS_PARALLELISM,                                  2 );
 	init( FETCH_KEYS_LOWER_PRIORITY,                               0 );
+	init( FETCH_KEYS_PARALLEL_SUBRANGES,                           1 ); if( randomize && BUGGIFY ) FETCH_KEYS_PARALLEL_SUBRANGES = deterministicRandom()->randomInt(2, 5);
 	init( SERVE_FETCH_CHECKPOINT_PARALLELISM,                      4 );
 	init( SERVE_AUDIT_STORAGE_PARALLELISM,                         1 );
 	init( PERSIST_FINISH_AUDIT_COUNT,                             10 ); if ( isSimulated ) PERSIST_FINISH_AUDIT_COUNT = deterministicRandom()->randomInt(1, PERSIST_FINISH_AUDIT_COUNT+1);
@@ -1097,20 +1160,37 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( FETCH_KEYS_TOO_LONG_TIME_CRITERIA,                   300.0 );
 	init( MAX_STORAGE_COMMIT_TIME,                             200.0 ); //The max fsync stall time on the storage server and tlog before marking a disk as failed
 	init( RANGESTREAM_LIMIT_BYTES,                               2e6 ); if( randomize && BUGGIFY ) RANGESTREAM_LIMIT_BYTES = 1;
+	init( RANGESTREAM_MAX_LIMIT_BYTES,                          16e6 ); if( randomize && BUGGIFY ) RANGESTREAM_MAX_LIMIT_BYTES = deterministicRandom()->randomInt(1, 1e6);
+	init( RANGESTREAM_WINDOW_GAIN,                               2.0 );
 	init( BLOBWORKERSTATUSSTREAM_LIMIT_BYTES,                    1e4 ); if( randomize && BUGGIFY ) BLOBWORKERSTATUSSTREAM_LIMIT_BYTES = 1;
+	init( CHANGEFEEDSTREAM_LIMIT_BYTES,                          1e6 ); if( randomize && BUGGIFY ) CHANGEFEEDSTREAM_LIMIT_BYTES = 1;
+	init( CHANGE_FEED_MAX_BYTES,                               100e6 ); if( randomize && BUGGIFY ) CHANGE_FEED_MAX_BYTES = 1e4;
+	init( CHANGE_FEED_PROCESS_MAX_BYTES,                         1e9 ); if( randomize && BUGGIFY ) CHANGE_FEED_PROCESS_MAX_BYTES = 1e5;
+	init( CHANGE_FEED_IDLE_TIMEOUT,                            600.0 ); if( randomize && BUGGIFY ) CHANGE_FEED_IDLE_TIMEOUT = 10.0;
+	init( CHANGE_FEED_HEARTBEAT_INTERVAL,                        1.0 );
+	init( CHANGE_FEED_STREAM_BATCH_DELAY,                      0.001 ); if( randomize && BUGGIFY ) CHANGE_FEED_STREAM_BATCH_DELAY = 0.0;
+	init( STORAGE_FEED_STREAM_HARD_LIMIT,                      10000 ); if( randomize && BUGGIFY ) STORAGE_FEED_STREAM_HARD_LIMIT = 50;
 	init( ENABLE_CLEAR_RANGE_EAGER_READS,                       true ); if( randomize && BUGGIFY ) ENABLE_CLEAR_RANGE_EAGER_READS = deterministicRandom()->coinflip();
 	init( CHECKPOINT_TRANSFER_BLOCK_BYTES,                      40e6 );
+	init( CHECKPOINT_HARD_LINK_LOCAL_FILES,                     true ); if( randomize && BUGGIFY ) CHECKPOINT_HARD_LINK_LOCAL_FILES = false;
 	init( QUICK_GET_VALUE_FALLBACK,                             true );
 	init( QUICK_GET_KEY_VALUES_FALLBACK,                        true );
 	init( STRICTLY_ENFORCE_BYTE_LIMIT,                          false); if( randomize && BUGGIFY ) STRICTLY_ENFORCE_BYTE_LIMIT = deterministicRandom()->coinflip();
 	init( FRACTION_INDEX_BYTELIMIT_PREFETCH,                      0.2); if( randomize && BUGGIFY ) FRACTION_INDEX_BYTELIMIT_PREFETCH = 0.01 + deterministicRandom()->random01();
 	init( MAX_PARALLEL_QUICK_GET_VALUE,                           10 ); if ( randomize && BUGGIFY ) MAX_PARALLEL_QUICK_GET_VALUE = deterministicRandom()->randomInt(1, 100);
+	init( QUICK_GET_VALUES_BATCHED,                             true ); if ( randomize && BUGGIFY ) QUICK_GET_VALUES_BATCHED = deterministicRandom()->coinflip();
+	init( QUICK_GET_VALUES_BATCH_SIZE,                           100 ); if ( randomize && BUGGIFY ) QUICK_GET_VALUES_BATCH_SIZE = deterministicRandom()->randomInt(1, 100);
 	init( QUICK_GET_KEY_VALUES_LIMIT,                           2000 );
 	init( QUICK_GET_KEY_VALUES_LIMIT_BYTES,                      1e7 );
+	init( STORAGE_RANGE_AGGREGATE_SCAN_BYTES,                    1e7 ); if( randomize && BUGGIFY ) STORAGE_RANGE_AGGREGATE_SCAN_BYTES = deterministicRandom()->randomInt(1, 100000);
+	init( STORAGE_FILTERED_READ_SCAN_BYTES,                      1e7 ); if( randomize && BUGGIFY ) STORAGE_FILTERED_READ_SCAN_BYTES = deterministicRandom()->randomInt(1, 10000);
+	init( STORAGE_SERVER_READ_CACHE_BYTES,                         0 ); if( randomize && BUGGIFY ) STORAGE_SERVER_READ_CACHE_BYTES = deterministicRandom()->randomInt(1, 100000);
 	// Read priority definitions in the form of a list of their relative concurrency share weights
 	init( STORAGESERVER_READ_PRIORITIES,           "120,10,20,40,60" );
 	// The total concurrency which will be shared by active priorities according to their relative weights
 	init( STORAGE_SERVER_READ_CONCURRENCY,                        70 );
+	init( STORAGE_SERVER_READ_FAIR_QUEUEING,                   false ); if( randomize && BUGGIFY ) STORAGE_SERVER_READ_FAIR_QUEUEING = true;
+	init( STORAGE_SERVER_READ_FAIR_QUEUEING_BUSY_TAG_COST,       4.0 );
 	// The priority number which each ReadType maps to in enumeration order
 	// This exists for flexibility but assigning each ReadType to its own unique priority number makes the most sense
 	// The enumeration is currently: eager, fetch, low, normal, high
@@ -1182,6 +1262,7 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	// Status
 	init( STATUS_MIN_TIME_BETWEEN_REQUESTS,                      0.0 );
 	init( MAX_STATUS_REQUESTS_PER_SECOND,                      256.0 );
+	init( STATUS_CACHE_TIME,                                     0.0 ); if( randomize && BUGGIFY ) STATUS_CACHE_TIME = deterministicRandom()->random01() * 2.0;
 	init( CONFIGURATION_ROWS_TO_FETCH,                         20000 );
 	init( DISABLE_DUPLICATE_LOG_WARNING,                       false );
 	init( HISTOGRAM_REPORT_INTERVAL,                           300.0 );
@@ -1242,17 +1323,26 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( REDWOOD_DEFAULT_EXTENT_READ_SIZE,              1024 * 1024 );
 	init( REDWOOD_EXTENT_CONCURRENT_READS,                         4 );
 	init( REDWOOD_KVSTORE_RANGE_PREFETCH,                       true );
+	init( REDWOOD_KVSTORE_RANGE_PREFETCH_WINDOW_PAGES,            64 ); if( randomize && BUGGIFY ) { REDWOOD_KVSTORE_RANGE_PREFETCH_WINDOW_PAGES = deterministicRandom()->randomInt(1, 10); }
 	init( REDWOOD_PAGE_REBUILD_MAX_SLACK,                       0.33 );
 	init( REDWOOD_PAGE_REBUILD_SLACK_DISTRIBUTION,              0.50 );
 	init( REDWOOD_LAZY_CLEAR_BATCH_SIZE_PAGES,                    10 );
+	init( REDWOOD_LAZY_CLEAR_IDLE_BATCH_SIZE_PAGES,              100 ); if( randomize && BUGGIFY ) REDWOOD_LAZY_CLEAR_IDLE_BATCH_SIZE_PAGES = deterministicRandom()->randomInt(1, 200);
 	init( REDWOOD_LAZY_CLEAR_MIN_PAGES,                            0 );
 	init( REDWOOD_LAZY_CLEAR_MAX_PAGES,                          1e6 );
 	init( REDWOOD_REMAP_CLEANUP_WINDOW_BYTES, 4LL * 1024 * 1024 * 1024 );
 	init( REDWOOD_REMAP_CLEANUP_TOLERANCE_RATIO,                0.05 );
+	init( REDWOOD_REMAP_CLEANUP_PAGES_PER_SECOND,                  0 ); if( randomize && BUGGIFY ) { REDWOOD_REMAP_CLEANUP_PAGES_PER_SECOND = deterministicRandom()->randomInt(100, 10000); }
 	init( REDWOOD_PAGEFILE_GROWTH_SIZE_PAGES,                  20000 ); if( randomize && BUGGIFY ) { REDWOOD_PAGEFILE_GROWTH_SIZE_PAGES = deterministicRandom()->randomInt(200, 1000); }
 	init( REDWOOD_METRICS_INTERVAL,                              5.0 );
 	init( REDWOOD_HISTOGRAM_INTERVAL,                           30.0 );
 	init( REDWOOD_EVICT_UPDATED_PAGES,                          true ); if( randomize && BUGGIFY ) { REDWOOD_EVICT_UPDATED_PAGES = false; }
+	init( REDWOOD_ART_MUTATION_BUFFER,                          true ); if( randomize && BUGGIFY ) { REDWOOD_ART_MUTATION_BUFFER = false; }
+	init( REDWOOD_READ_COST_SAMPLES_MAX,                       10000 );
+	init( REDWOOD_PAGE_CACHE_PROTECTED_FRACTION,                 0.8 ); if( randomize && BUGGIFY ) { REDWOOD_PAGE_CACHE_PROTECTED_FRACTION = deterministicRandom()->coinflip() ? 0.0 : deterministicRandom()->random01(); }
+	init( REDWOOD_COMPRESSED_PAGE_CACHE_BYTES,                     0 ); if( randomize && BUGGIFY ) { REDWOOD_COMPRESSED_PAGE_CACHE_BYTES = deterministicRandom()->randomInt(1, 100) * 100000; }
+	init( REDWOOD_COMPRESSED_PAGE_CACHE_FILTER,               "ZSTD" );
+	init( REDWOOD_COMPRESSED_PAGE_CACHE_MAX_RATIO,              0.75 ); if( randomize && BUGGIFY ) { REDWOOD_COMPRESSED_PAGE_CACHE_MAX_RATIO = 1.0; }
 	init( REDWOOD_DECODECACHE_REUSE_MIN_HEIGHT,                    2 ); if( randomize && BUGGIFY ) { REDWOOD_DECODECACHE_REUSE_MIN_HEIGHT = deterministicRandom()->randomInt(1, 7); }
 	init( REDWOOD_NODE_MAX_UNBALANCE,                              2 );
 	init( REDWOOD_IO_PRIORITIES,                       "32,32,32,32" );
@@ -1309,6 +1399,7 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( REST_KMS_STABILITY_CHECK_INTERVAL,                      5.0);
 
 	init( CONSISTENCY_SCAN_ACTIVE_THROTTLE_RATIO,                0.5 ); if( randomize && BUGGIFY ) CONSISTENCY_SCAN_ACTIVE_THROTTLE_RATIO = deterministicRandom()->random01();
+	init( CONSISTENCY_SCAN_BUSY_READ_LATENCY,                    0.0 ); if( randomize && BUGGIFY ) CONSISTENCY_SCAN_BUSY_READ_LATENCY = deterministicRandom()->random01() * 0.1;
 
 
 	init( FLOW_WITH_SWIFT,                                       false);
@@ -23,6 +23,8 @@
 // is just one use case.  This code is agnostic to the specific use cases.
 // Fundamentally it is just about comparing replies. Where they came from is incidental.
 #include "fdbclient/StorageServerInterface.h"
+#include "fdbclient/Tuple.h"
+#include "flow/ObjectSerializer.h"
 
 #include "crc32/crc32c.h" // for crc32c_append, to checksum values in tss trace events
 
@@ -60,6 +62,67 @@ void TSS_traceMismatch(TraceEvent& event,
 	            tss.value.present() ? traceChecksumValue(tss.value.get()) : "missing");
 }
 
+// batched point reads
+template <>
+bool TSS_doCompare(const GetValuesReply& src, const GetValuesReply& tss) {
+	return src.values == tss.values;
+}
+
+template <>
+const char* LB_mismatchTraceName(const GetValuesRequest& req, const ComparisonType& type) {
+	return type == TSS_COMPARISON ? "TSSMismatchGetValues" : "ReplicaMismatchGetValues";
+}
+
+template <>
+void TSS_traceMismatch(TraceEvent& event,
+                       const GetValuesRequest& req,
+                       const GetValuesReply& src,
+                       const GetValuesReply& tss,
+                       const ComparisonType& type) {
+	// Only trace the first key that differs, since a request can contain many keys
+	int i = 0;
+	while (i < req.keys.size() && i < src.values.size() && i < tss.values.size() && src.values[i] == tss.values[i]) {
+		i++;
+	}
+	auto traceValue = [](const std::vector<Optional<Value>>& values, int i) {
+		return i >= values.size() ? "absent" : values[i].present() ? traceChecksumValue(values[i].get()) : "missing";
+	};
+	event.detail("Keys", req.keys.size())
+	    .detail("Key", i < req.keys.size() ? req.keys[i] : KeyRef())
+	    .detail("Version", req.version)
+	    .detail(type == TSS_COMPARISON ? "SSReply" : "SourceSSReply", traceValue(src.values, i))
+	    .detail(type == TSS_COMPARISON ? "TSSReply" : "ReplicaSSReply", traceValue(tss.values, i));
+}
+
+// range aggregates
+template <>
+bool TSS_doCompare(const GetRangeAggregateReply& src, const GetRangeAggregateReply& tss) {
+	// Storage servers may stop at different keys, in which case the aggregates cover different ranges
+	return src.more != tss.more || src.end != tss.end || src.aggregate == tss.aggregate;
+}
+
+template <>
+const char* LB_mismatchTraceName(const GetRangeAggregateRequest& req, const ComparisonType& type) {
+	return type == TSS_COMPARISON ? "TSSMismatchGetRangeAggregate" : "ReplicaMismatchGetRangeAggregate";
+}
+
+template <>
+void TSS_traceMismatch(TraceEvent& event,
+                       const GetRangeAggregateRequest& req,
+                       const GetRangeAggregateReply& src,
+                       const GetRangeAggregateReply& tss,
+                       const ComparisonType& type) {
+	event.detail("Begin", req.range.begin)
+	    .detail("End", req.range.end)
+	    .detail("Version", req.version)
+	    .detail(type == TSS_COMPARISON ? "SSCount" : "SourceSSCount", src.aggregate.count)
+	    .detail(type == TSS_COMPARISON ? "TSSCount" : "ReplicaSSCount", tss.aggregate.count)
+	    .detail(type == TSS_COMPARISON ? "SSSum" : "SourceSSSum", src.aggregate.sum)
+	    .detail(type == TSS_COMPARISON ? "TSSSum" : "ReplicaSSSum", tss.aggregate.sum)
+	    .detail(type == TSS_COMPARISON ? "SSBytes" : "SourceSSBytes", src.aggregate.bytes)
+	    .detail(type == TSS_COMPARISON ? "TSSBytes" : "ReplicaSSBytes", tss.aggregate.bytes);
+}
+
 // key selector reads
 template <>
 bool TSS_doCompare(const GetKeyReply& src, const GetKeyReply& tss) {
@@ -124,9 +187,11 @@ void TSS_traceMismatch(TraceEvent& event,
 }
 
 // range reads
+// Replies are compared before the client expands their keys, so keys sent without their shared prefixes are only equal
+// if the lengths of the prefixes left out are too
 template <>
 bool TSS_doCompare(const GetKeyValuesReply& src, const GetKeyValuesReply& tss) {
-	return src.more == tss.more && src.data == tss.data;
+	return src.more == tss.more && src.keyPrefixLengths == tss.keyPrefixLengths && src.data == tss.data;
 }
 
 template <>
@@ -204,6 +269,19 @@ static void traceKeyValuesDiff(TraceEvent& event,
 	ASSERT(mismatchFound);
 }
 
+// The rows of a reply with full keys, which is left as it was so that it can still be expanded by the client
+static Standalone<VectorRef<KeyValueRef>> expandedKeyValues(const GetKeyValuesReply& rep) {
+	Standalone<VectorRef<KeyValueRef>> kvs;
+	kvs.arena().dependsOn(rep.arena);
+	kvs.append(kvs.arena(), rep.data.begin(), rep.data.size());
+	for (int i = 1; i < rep.keyPrefixLengths.size(); i++) {
+		if (rep.keyPrefixLengths[i] > 0) {
+			kvs[i].key = kvs[i - 1].key.substr(0, rep.keyPrefixLengths[i]).withSuffix(kvs[i].key, kvs.arena());
+		}
+	}
+	return kvs;
+}
+
 template <>
 void TSS_traceMismatch(TraceEvent& event,
                        const GetKeyValuesRequest& req,
@@ -216,9 +294,9 @@ void TSS_traceMismatch(TraceEvent& event,
 	                   req.version,
 	                   req.limit,
 	                   req.limitBytes,
-	                   src.data,
+	                   expandedKeyValues(src),
 	                   src.more,
-	                   tss.data,
+	                   expandedKeyValues(tss),
 	                   tss.more,
 	                   type);
 }
@@ -423,6 +501,12 @@ void TSSMetrics::recordLatency(const GetValueRequest& req, double ssLatency, dou
 	TSSgetValueLatency.addSample(tssLatency);
 }
 
+template <>
+void TSSMetrics::recordLatency(const GetValuesRequest& req, double ssLatency, double tssLatency) {
+	SSgetValueLatency.addSample(ssLatency);
+	TSSgetValueLatency.addSample(tssLatency);
+}
+
 template <>
 void TSSMetrics::recordLatency(const GetKeyRequest& req, double ssLatency, double tssLatency) {
 	SSgetKeyLatency.addSample(ssLatency);
@@ -444,6 +528,9 @@ void TSSMetrics::recordLatency(const GetMappedKeyValuesRequest& req, double ssLa
 template <>
 void TSSMetrics::recordLatency(const WatchValueRequest& req, double ssLatency, double tssLatency) {}
 
+template <>
+void TSSMetrics::recordLatency(const GetRangeAggregateRequest& req, double ssLatency, double tssLatency) {}
+
 template <>
 void TSSMetrics::recordLatency(const WaitMetricsRequest& req, double ssLatency, double tssLatency) {}
 
@@ -573,3 +660,233 @@ TEST_CASE("/StorageServerInterface/TSSCompare/TestComparison") {
 	ASSERT(checksumStart13 == traceChecksumValue(StringRef(s13)).substr(0, 4));
 	return Void();
 }
+
+void RangeAggregate::add(KeyValueRef kv) {
+	add(&kv, 1);
+}
+
+void RangeAggregate::add(const KeyValueRef* kvs, int n) {
+	if (n == 0) {
+		return;
+	}
+	const KeyRef* batchMin = &kvs[0].key;
+	const KeyRef* batchMax = &kvs[0].key;
+	for (const KeyValueRef* kv = kvs; kv != kvs + n; ++kv) {
+		++count;
+		bytes += kv->expectedSize();
+		// Values shorter than 8 bytes are zero extended and longer ones truncated, as in doLittleEndianAdd
+		uint64_t v = 0;
+		for (int i = 0; i < std::min(kv->value.size(), 8); i++) {
+			v |= uint64_t(kv->value[i]) << (8 * i);
+		}
+		sum = int64_t(uint64_t(sum) + v);
+		if (kv->key < *batchMin) {
+			batchMin = &kv->key;
+		}
+		if (kv->key > *batchMax) {
+			batchMax = &kv->key;
+		}
+	}
+	if (!minKey.present() || *batchMin < minKey.get()) {
+		minKey = *batchMin;
+	}
+	if (!maxKey.present() || *batchMax > maxKey.get()) {
+		maxKey = *batchMax;
+	}
+}
+
+void RangeAggregate::add(const RangeAggregate& other) {
+	count += other.count;
+	sum = int64_t(uint64_t(sum) + uint64_t(other.sum));
+	bytes += other.bytes;
+	if (other.minKey.present() && (!minKey.present() || other.minKey.get() < minKey.get())) {
+		minKey = other.minKey;
+	}
+	if (other.maxKey.present() && (!maxKey.present() || other.maxKey.get() > maxKey.get())) {
+		maxKey = other.maxKey;
+	}
+}
+
+bool KeyTuplePredicateRef::matches(StringRef packedElement) const {
+	int c = packedElement.compare(element);
+	switch (op) {
+	case EQ:
+		return c == 0;
+	case NE:
+		return c != 0;
+	case LT:
+		return c < 0;
+	case LE:
+		return c <= 0;
+	case GT:
+		return c > 0;
+	case GE:
+		return c >= 0;
+	default:
+		return false;
+	}
+}
+
+bool ReadFilterRef::matches(KeyValueRef kv) const {
+	if (kv.value.size() < minValueBytes || kv.value.size() > maxValueBytes) {
+		return false;
+	}
+	if (keyPrefix.present() && !kv.key.startsWith(keyPrefix.get())) {
+		return false;
+	}
+	if (valuePrefix.present() && !kv.value.startsWith(valuePrefix.get())) {
+		return false;
+	}
+	if (keyTuple.empty()) {
+		return true;
+	}
+
+	Tuple t;
+	try {
+		t = Tuple::unpack(kv.key);
+	} catch (Error& e) {
+		// Keys which are not tuples cannot match a tuple predicate
+		return false;
+	}
+	for (const auto& p : keyTuple) {
+		if (p.index < 0 || p.index >= t.size() || !p.matches(t.subTupleRawString(p.index))) {
+			return false;
+		}
+	}
+	return true;
+}
+
+TEST_CASE("/StorageServerInterface/ReadFilter") {
+	Arena arena;
+	Key key = Tuple::makeTuple("user"_sr, 42, "name"_sr).pack();
+	Value value = "alice"_sr;
+
+	ReadFilterRef filter;
+	ASSERT(filter.matches(KeyValueRef(key, value)));
+
+	filter.valuePrefix = "al"_sr;
+	filter.maxValueBytes = 5;
+	ASSERT(filter.matches(KeyValueRef(key, value)));
+	filter.maxValueBytes = 4;
+	ASSERT(!filter.matches(KeyValueRef(key, value)));
+	filter.maxValueBytes = std::numeric_limits<int>::max();
+	filter.valuePrefix = "bo"_sr;
+	ASSERT(!filter.matches(KeyValueRef(key, value)));
+	filter.valuePrefix.reset();
+
+	// Integers compare in numeric order since the tuple encoding preserves it
+	filter.keyTuple.push_back(arena,
+	                          KeyTuplePredicateRef(arena, 1, KeyTuplePredicateRef::GE, Tuple::makeTuple(7).pack()));
+	ASSERT(filter.matches(KeyValueRef(key, value)));
+	filter.keyTuple.push_back(arena,
+	                          KeyTuplePredicateRef(arena, 1, KeyTuplePredicateRef::LT, Tuple::makeTuple(42).pack()));
+	ASSERT(!filter.matches(KeyValueRef(key, value)));
+	filter.keyTuple.back().op = KeyTuplePredicateRef::LE;
+	ASSERT(filter.matches(KeyValueRef(key, value)));
+
+	filter.keyTuple.push_back(
+	    arena, KeyTuplePredicateRef(arena, 2, KeyTuplePredicateRef::EQ, Tuple::makeTuple("name"_sr).pack()));
+	ASSERT(filter.matches(KeyValueRef(key, value)));
+	// Missing elements and keys which are not tuples never match
+	filter.keyTuple.back().index = 3;
+	ASSERT(!filter.matches(KeyValueRef(key, value)));
+	ASSERT(!filter.matches(KeyValueRef("\xff\xff\xff"_sr, value)));
+
+	// A deep copy does not depend on the original's arena
+	Arena copyArena;
+	ReadFilterRef copy(copyArena, filter);
+	arena = Arena();
+	filter = ReadFilterRef();
+	ASSERT(copy.keyTuple.size() == 3 && copy.keyTuple[1].op == KeyTuplePredicateRef::LE);
+	ASSERT(!copy.matches(KeyValueRef(key, value)));
+	copy.keyTuple.back().index = 2;
+	ASSERT(copy.matches(KeyValueRef(key, value)));
+	return Void();
+}
+
+TEST_CASE("/StorageServerInterface/RangeAggregate") {
+	auto le = [](int64_t v) { return StringRef((const uint8_t*)&v, sizeof(v)).toString(); };
+	std::string one = le(1), big = le(std::numeric_limits<int64_t>::max()), minusThree = le(-3);
+
+	RangeAggregate a;
+	a.add(KeyValueRef("b"_sr, StringRef(one)));
+	a.add(KeyValueRef("d"_sr, StringRef(minusThree)));
+	ASSERT_EQ(a.count, 2);
+	ASSERT_EQ(a.sum, -2);
+	ASSERT_EQ(a.bytes, 18);
+	ASSERT(a.minKey.get() == "b"_sr && a.maxKey.get() == "d"_sr);
+
+	// Short values are zero extended and long ones truncated
+	RangeAggregate b;
+	b.add(KeyValueRef("a"_sr, "\x02"_sr));
+	b.add(KeyValueRef("c"_sr, StringRef(one + "ignored")));
+	ASSERT_EQ(b.sum, 3);
+
+	// Sums wrap around, as AddValue does
+	RangeAggregate c;
+	c.add(KeyValueRef("e"_sr, StringRef(big)));
+	c.add(KeyValueRef("f"_sr, StringRef(one)));
+	ASSERT_EQ(c.sum, std::numeric_limits<int64_t>::min());
+
+	RangeAggregate empty;
+	a.add(empty);
+	ASSERT_EQ(a.count, 2);
+	a.add(b);
+	a.add(c);
+	ASSERT_EQ(a.count, 6);
+	ASSERT_EQ(a.sum, std::numeric_limits<int64_t>::min() + 1);
+	ASSERT(a.minKey.get() == "a"_sr && a.maxKey.get() == "f"_sr);
+
+	// A batch gives the same result as adding its rows one at a time
+	KeyValueRef rows[] = { KeyValueRef("c"_sr, StringRef(one)),
+		                   KeyValueRef("g"_sr, "\x02"_sr),
+		                   KeyValueRef("a"_sr, ""_sr) };
+	RangeAggregate batch, single;
+	batch.add(rows, 3);
+	for (const auto& row : rows) {
+		single.add(row);
+	}
+	ASSERT(batch == single);
+	ASSERT(batch.minKey.get() == "a"_sr && batch.maxKey.get() == "g"_sr);
+	return Void();
+}
+
+TEST_CASE("/StorageServerInterface/KeyPrefixCompression") {
+	GetKeyValuesReply reply;
+	std::vector<std::string> keys = { "user/1/a", "user/1/b", "user/2", "user/2/c", "x", std::string(70000, 'k'),
+		                              std::string(70000, 'k') + "z" };
+	for (const auto& key : keys) {
+		reply.data.push_back_deep(reply.arena, KeyValueRef(StringRef(key), "v"_sr));
+	}
+	reply.compressKeyPrefixes();
+	ASSERT_EQ(reply.keyPrefixLengths.size(), keys.size());
+	ASSERT(reply.data[1].key == "b"_sr && reply.data[3].key == "/c"_sr && reply.data[4].key == "x"_sr);
+	// Prefixes longer than a uint16_t can count are only partly left out
+	ASSERT_EQ(reply.keyPrefixLengths[6], std::numeric_limits<uint16_t>::max());
+
+	GetKeyValuesReply received;
+	Standalone<StringRef> msg = ObjectWriter::toValue(reply, Unversioned());
+	ArenaObjectReader reader(msg.arena(), msg, Unversioned());
+	reader.deserialize(received);
+	received.expandKeyPrefixes();
+	ASSERT(received.keyPrefixLengths.empty());
+	ASSERT_EQ(received.data.size(), keys.size());
+	for (int i = 0; i < keys.size(); i++) {
+		ASSERT(received.data[i].key == StringRef(keys[i]) && received.data[i].value == "v"_sr);
+	}
+
+	// Mismatches are traced with full keys, and keys with equal suffixes only compare equal with equal prefixes
+	GetKeyValuesReply other;
+	other.data.push_back_deep(other.arena, KeyValueRef("user/1/a"_sr, "v"_sr));
+	other.data.push_back_deep(other.arena, KeyValueRef("user/1/b"_sr, "v"_sr));
+	other.compressKeyPrefixes();
+	GetKeyValuesReply shorterPrefix;
+	shorterPrefix.data.push_back_deep(shorterPrefix.arena, KeyValueRef("user/1/a"_sr, "v"_sr));
+	shorterPrefix.data.push_back_deep(shorterPrefix.arena, KeyValueRef("user/b"_sr, "v"_sr));
+	shorterPrefix.compressKeyPrefixes();
+	ASSERT(other.data == shorterPrefix.data);
+	ASSERT(!TSS_doCompare(other, shorterPrefix));
+	ASSERT(expandedKeyValues(other)[1].key == "user/1/b"_sr && expandedKeyValues(shorterPrefix)[1].key == "user/b"_sr);
+	ASSERT(other.data[1].key == "b"_sr);
+	return Void();
+}
@@ -234,6 +234,31 @@ ThreadFuture<Optional<Value>> ThreadSafeTransaction::get(const KeyRef& key, bool
 	});
 }
 
+ThreadFuture<RangeResult> ThreadSafeTransaction::getMulti(const VectorRef<KeyRef>& keys, bool snapshot) {
+	Standalone<VectorRef<KeyRef>> k;
+	k.append_deep(k.arena(), keys.begin(), keys.size());
+
+	ISingleThreadTransaction* tr = this->tr;
+	return onMainThread([tr, k, snapshot]() -> Future<RangeResult> {
+		tr->checkDeferredError();
+		// The reads are all issued before any is waited on, so reads going to the same storage servers are batched
+		std::vector<Future<Optional<Value>>> values;
+		values.reserve(k.size());
+		for (const KeyRef& key : k) {
+			values.push_back(tr->get(key, Snapshot{ snapshot }));
+		}
+		return map(getAll(values), [k](std::vector<Optional<Value>> values) {
+			RangeResult result;
+			for (int i = 0; i < k.size(); i++) {
+				if (values[i].present()) {
+					result.push_back_deep(result.arena(), KeyValueRef(k[i], values[i].get()));
+				}
+			}
+			return result;
+		});
+	});
+}
+
 ThreadFuture<Key> ThreadSafeTransaction::getKey(const KeySelectorRef& key, bool snapshot) {
 	KeySelector k = key;
 
@@ -265,6 +290,47 @@ ThreadFuture<Standalone<VectorRef<KeyRef>>> ThreadSafeTransaction::getRangeSplit
 	});
 }
 
+ThreadFuture<RangeResult> ThreadSafeTransaction::getRangeParallel(const KeyRangeRef& range,
+                                                                  int parallelism,
+                                                                  int64_t chunkSize,
+                                                                  bool snapshot) {
+	if (parallelism < 1) {
+		return client_invalid_operation();
+	}
+	KeyRange r = range;
+
+	ISingleThreadTransaction* tr = this->tr;
+	return onMainThread([tr, r, parallelism, chunkSize, snapshot]() -> Future<RangeResult> {
+		tr->checkDeferredError();
+		auto readChunks = [tr, parallelism, snapshot](Standalone<VectorRef<KeyRef>> splitPoints) {
+			// A chunk holds its slot until all of its rows are read, so at most parallelism reads are in flight
+			auto slots = makeReference<FlowLock>(parallelism);
+			std::vector<Future<RangeResult>> chunks;
+			for (int i = 0; i + 1 < splitPoints.size(); i++) {
+				chunks.push_back(runAfter(slots->take(), [tr, slots, splitPoints, i, snapshot](Void) {
+					Future<RangeResult> rows = tr->getRange(firstGreaterOrEqual(splitPoints[i]),
+					                                        firstGreaterOrEqual(splitPoints[i + 1]),
+					                                        GetRangeLimits(),
+					                                        Snapshot{ snapshot });
+					return map(rows, [slots](RangeResult rows) {
+						slots->release();
+						return rows;
+					});
+				}));
+			}
+			return map(getAll(chunks), [](std::vector<RangeResult> chunks) {
+				RangeResult result;
+				for (const auto& rows : chunks) {
+					result.append(result.arena(), rows.begin(), rows.size());
+					result.arena().dependsOn(rows.arena());
+				}
+				return result;
+			});
+		};
+		return mapAsync(tr->getRangeSplitPoints(r, chunkSize), readChunks);
+	});
+}
+
 ThreadFuture<RangeResult> ThreadSafeTransaction::getRange(const KeySelectorRef& begin,
                                                           const KeySelectorRef& end,
                                                           int limit,
@@ -21,6 +21,8 @@
 #include "fdbclient/Tuple.h"
 #include "flow/UnitTest.h"
 
+#include <cstring>
+
 const uint8_t VERSIONSTAMP_96_CODE = 0x33;
 const uint8_t USER_TYPE_START = 0x40;
 const uint8_t USER_TYPE_END = 0x4f;
@@ -38,10 +40,19 @@ static double bigEndianDouble(double orig) {
 	return *(double*)&big;
 }
 
+// Strings are scanned for null bytes with memchr, which checks many bytes at a time, rather than byte by byte
 static size_t findStringTerminator(const StringRef data, size_t offset) {
 	size_t i = offset;
-	while (i < data.size() - 1 && !(data[i] == '\x00' && data[i + 1] != (uint8_t)'\xff')) {
-		i += (data[i] == '\x00' ? 2 : 1);
+	while (i < data.size() - 1) {
+		const uint8_t* nul = (const uint8_t*)memchr(data.begin() + i, '\x00', data.size() - 1 - i);
+		if (nul == nullptr) {
+			return data.size() - 1;
+		}
+		i = nul - data.begin();
+		if (data[i + 1] != (uint8_t)'\xff') {
+			return i;
+		}
+		i += 2;
 	}
 
 	return i;
@@ -173,13 +184,14 @@ Tuple& Tuple::append(StringRef const& str, bool utf8) {
 	data.append(data.arena(), &utfChar, 1);
 
 	size_t lastPos = 0;
-	for (size_t pos = 0; pos < str.size(); ++pos) {
-		if (str[pos] == '\x00') {
-			data.append(data.arena(), str.begin() + lastPos, pos - lastPos);
-			data.push_back(data.arena(), (uint8_t)'\x00');
-			data.push_back(data.arena(), (uint8_t)'\xff');
-			lastPos = pos + 1;
-		}
+	const uint8_t* nul;
+	while (lastPos < str.size() &&
+	       (nul = (const uint8_t*)memchr(str.begin() + lastPos, '\x00', str.size() - lastPos)) != nullptr) {
+		size_t pos = nul - str.begin();
+		data.append(data.arena(), str.begin() + lastPos, pos - lastPos);
+		data.push_back(data.arena(), (uint8_t)'\x00');
+		data.push_back(data.arena(), (uint8_t)'\xff');
+		lastPos = pos + 1;
 	}
 
 	data.append(data.arena(), str.begin() + lastPos, str.size() - lastPos);
@@ -331,15 +343,15 @@ Standalone<StringRef> Tuple::getString(size_t index) const {
 	Standalone<StringRef> result;
 	VectorRef<uint8_t> staging;
 
-	for (size_t i = b; i < e; ++i) {
-		if (data[i] == '\x00') {
-			staging.append(result.arena(), data.begin() + b, i - b);
-			++i;
-			b = i + 1;
+	const uint8_t* nul;
+	while (b < e && (nul = (const uint8_t*)memchr(data.begin() + b, '\x00', e - b)) != nullptr) {
+		size_t i = nul - data.begin();
+		staging.append(result.arena(), data.begin() + b, i - b);
+		++i;
+		b = i + 1;
 
-			if (i < e) {
-				staging.push_back(result.arena(), '\x00');
-			}
+		if (i < e) {
+			staging.push_back(result.arena(), '\x00');
 		}
 	}
 
@@ -69,6 +69,15 @@ static const uint32_t BACKUP_AGENT_MLOG_VERSION = 2001;
 // Mutation log version written by BackupWorker
 static const uint32_t PARTITIONED_MLOG_VERSION = 4110;
 
+// Mutation log version written by BackupWorker for blocks compressed with BACKUP_LOG_COMPRESSION_FILTER. The version is
+// followed by the filter (uint8_t), the big endian length of the compressed data and the compressed data, which holds
+// the mutations of a PARTITIONED_MLOG_VERSION block. The rest of the block is 0xFF padding.
+static const uint32_t PARTITIONED_MLOG_COMPRESSED_VERSION = 4111;
+
+// Returns the mutations of a block of a partitioned mutation log file, which follow the block's version. Compressed
+// blocks are decompressed into arena.
+StringRef decodePartitionedLogBlock(StringRef block, Arena& arena);
+
 // Snapshot file version written by FileBackupAgent
 static const uint32_t BACKUP_AGENT_SNAPSHOT_FILE_VERSION = 1001;
 
@@ -52,6 +52,7 @@
 #include <openssl/sha.h>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <variant>
 #include <vector>
 
@@ -100,6 +101,7 @@ public:
 	Counter latestCipherKeyCacheHit;
 	Counter latestCipherKeyCacheMiss;
 	Counter latestCipherKeyCacheNeedsRefresh;
+	Counter latestCipherKeyCacheBackgroundRefresh;
 	LatencySample getBlobMetadataLatency;
 	LatencySample getCipherKeysLatency;
 	LatencySample getLatestCipherKeysLatency;
@@ -739,8 +741,10 @@ public:
 
 	// API returns the last inserted cipherKey.
 	// If none exists, null reference is returned.
+	// If 'needsRefresh' is given, a cipherKey due for refresh but not yet expired is still returned, and
+	// '*needsRefresh' is set so that the caller can fetch its replacement.
 
-	Reference<BlobCipherKey> getLatestCipherKey();
+	Reference<BlobCipherKey> getLatestCipherKey(bool* needsRefresh = nullptr);
 
 	// API returns cipherKey corresponding to input 'baseCipherKeyId'.
 	// If none exists, null reference is returned.
@@ -847,8 +851,15 @@ public:
 	// API returns the last insert cipherKey for a given encryption domain Id.
 	// If domain Id is invalid, it would throw 'encrypt_invalid_id' exception,
 	// otherwise, and if none exists, it would return null reference.
+	// See BlobCipherKeyIdCache::getLatestCipherKey() for 'needsRefresh'.
 
-	Reference<BlobCipherKey> getLatestCipherKey(const EncryptCipherDomainId& domainId);
+	Reference<BlobCipherKey> getLatestCipherKey(const EncryptCipherDomainId& domainId, bool* needsRefresh = nullptr);
+
+	// APIs tracking the encryption domains whose latest cipherKey is being refreshed in the background.
+	// startRefresh() returns false if a refresh of the domain is already in flight.
+
+	bool startRefresh(const EncryptCipherDomainId& domainId) { return refreshingDomains.insert(domainId).second; }
+	void finishRefresh(const EncryptCipherDomainId& domainId) { refreshingDomains.erase(domainId); }
 
 	// API returns cipherKey corresponding to {encryptionDomainId, baseCipherId} tuple.
 	// If none exists, it would return null reference.
@@ -890,6 +901,7 @@ public:
 
 private:
 	BlobCipherDomainCacheMap domainCacheMap;
+	std::unordered_set<EncryptCipherDomainId> refreshingDomains;
 	size_t size = 0;
 
 	BlobCipherKeyCache() {}
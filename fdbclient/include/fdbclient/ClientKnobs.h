@@ -51,6 +51,7 @@ public:
 	double MAX_GENERATIONS_SIM;
 
 	double COORDINATOR_RECONNECTION_DELAY;
+	double COORDINATOR_RECONNECTION_MAX_DELAY; // Upper bound for backing off COORDINATOR_RECONNECTION_DELAY
 	int CLIENT_EXAMPLE_AMOUNT;
 	double MAX_CLIENT_STATUS_AGE;
 	int MAX_COMMIT_PROXY_CONNECTIONS;
@@ -70,6 +71,7 @@ public:
 	double BACKOFF_GROWTH_RATE;
 	double RESOURCE_CONSTRAINED_MAX_BACKOFF;
 	int PROXY_COMMIT_OVERHEAD_BYTES;
+	bool COALESCE_COMMIT_CONFLICT_RANGES; // Merge overlapping conflict ranges of a commit before sending it to the resolvers
 	double SHARD_STAT_SMOOTH_AMOUNT;
 	int INIT_MID_SHARD_BYTES;
 
@@ -80,6 +82,8 @@ public:
 	int64_t SPLIT_KEY_SIZE_LIMIT;
 	int METADATA_VERSION_CACHE_SIZE;
 	int64_t CHANGE_FEED_LOCATION_LIMIT;
+	bool BATCH_GET_VALUES; // Coalesce concurrent point reads of a transaction to the same storage team into one request
+	int GET_VALUES_BATCH_MAX_KEYS;
 	int64_t CHANGE_FEED_CACHE_SIZE;
 	double CHANGE_FEED_POP_TIMEOUT;
 	int64_t CHANGE_FEED_STREAM_MIN_BYTES;
@@ -99,8 +103,10 @@ public:
 	int LOCATION_CACHE_EVICTION_SIZE_SIM;
 	double LOCATION_CACHE_ENDPOINT_FAILURE_GRACE_PERIOD;
 	double LOCATION_CACHE_FAILED_ENDPOINT_RETRY_INTERVAL;
+	int LOCATION_CACHE_PREFETCH_SHARDS; // Shards whose locations are fetched together on a location cache miss
 
 	int GET_RANGE_SHARD_LIMIT;
+	bool GET_RANGE_COMPRESS_KEY_PREFIXES; // Have storage servers drop the prefix each key shares with the one before
 	int WARM_RANGE_SHARD_LIMIT;
 	int STORAGE_METRICS_SHARD_LIMIT;
 	int SHARD_COUNT_LIMIT;
@@ -182,6 +188,7 @@ public:
 	int COPY_LOG_PREFETCH_BLOCKS;
 	int COPY_LOG_READ_AHEAD_BYTES;
 	double COPY_LOG_TASK_DURATION_NANOS;
+	int COPY_LOG_MAX_PIPELINED_COMMITS; // DR log copy commits left in flight while the next batch is read
 	int BACKUP_TASKS_PER_AGENT;
 	int BACKUP_POLL_PROGRESS_SECONDS;
 	int SIM_BACKUP_TASKS_PER_AGENT;
@@ -318,6 +325,7 @@ public:
 	int64_t TAG_THROTTLING_PAGE_SIZE; // Used to round up the cost of operations
 	// Cost multiplier for writes (because write operations are more expensive than reads):
 	double GLOBAL_TAG_THROTTLING_RW_FUNGIBILITY_RATIO;
+	bool TAG_THROTTLING_CHARGE_ATOMIC_OP_READS; // If true, atomic ops are also charged for the read they cause
 	// Maximum duration that a transaction can be tag throttled by proxy before being rejected
 	double PROXY_MAX_TAG_THROTTLE_DURATION;
 
@@ -342,6 +350,10 @@ public:
 	int ENCRYPT_HEADER_AES_CTR_NO_AUTH_VERSION;
 	int ENCRYPT_HEADER_AES_CTR_AES_CMAC_AUTH_VERSION;
 	int ENCRYPT_HEADER_AES_CTR_HMAC_SHA_AUTH_VERSION;
+	bool ENCRYPT_CIPHER_KEY_BACKGROUND_REFRESH; // Keep serving a latest cipher key due for refresh while fetching its
+	                                            // replacement in the background, until the key expires
+	double ENCRYPT_CIPHER_KEY_REFRESH_JITTER; // Upper bound of the random delay before a background refresh
+	double ENCRYPT_CIPHER_KEY_REFRESH_TIMEOUT; // Give up on a background refresh after this long
 	double ENCRYPT_GET_CIPHER_KEY_LONG_REQUEST_THRESHOLD;
 
 	// REST KMS configurations
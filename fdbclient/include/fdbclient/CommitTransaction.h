@@ -358,14 +358,27 @@ struct MutationRef {
 			// Attach checksum at first, then attach acs index
 			populateChecksum();
 			uint8_t cType = createTypeWithChecksum(this->type);
+			uint8_t suffix[6];
+			int suffixLength = 4;
 			uint32_t cs = this->checksum.get();
-			Standalone<StringRef> cParam2 = param2.withSuffix(StringRef((uint8_t*)&cs, 4));
+			memcpy(suffix, &cs, 4);
 			if (CLIENT_KNOBS->ENABLE_ACCUMULATIVE_CHECKSUM && this->accumulativeChecksumIndex.present()) {
 				cType = createTypeWithAccumulativeChecksumIndex(cType);
 				uint16_t acsIdx = this->accumulativeChecksumIndex.get();
-				cParam2 = cParam2.withSuffix(StringRef((uint8_t*)&acsIdx, 2));
+				memcpy(suffix + 4, &acsIdx, 2);
+				suffixLength += 2;
+			}
+			if constexpr (is_fb_function<Ar> || !Ar::isSerializing) {
+				Standalone<StringRef> cParam2 = param2.withSuffix(StringRef(suffix, suffixLength));
+				serializer(ar, cType, param1, cParam2);
+			} else {
+				// Write param2 and its suffix straight into the archive, rather than first copying a possibly
+				// large value into a temporary just to append a few bytes.
+				serializer(ar, cType, param1);
+				ar << uint32_t(param2.size() + suffixLength);
+				ar.serializeBytes(param2.begin(), param2.size());
+				ar.serializeBytes(suffix, suffixLength);
 			}
-			serializer(ar, cType, param1, cParam2);
 		} else {
 			serializer(ar, type, param1, param2);
 		}
@@ -373,6 +373,10 @@ public:
 	QueueModel queueModel;
 	EnableLocalityLoadBalance enableLocalityLoadBalance{ EnableLocalityLoadBalance::False };
 
+	// Point reads waiting to be sent to storage servers together, if CLIENT_KNOBS->BATCH_GET_VALUES is enabled. Reads
+	// of different transactions at the same read version share a batch.
+	std::shared_ptr<struct PendingGetValues> pendingGetValues;
+
 	struct VersionRequest {
 		SpanContext spanContext;
 		Promise<GetReadVersionReply> reply;
@@ -437,6 +441,8 @@ public:
 	Counter transactionReadVersions;
 	Counter transactionReadVersionsThrottled;
 	Counter transactionReadVersionsCompleted;
+	Counter transactionReadVersionsFromCache;
+	Counter transactionReadVersionsCacheStale;
 	Counter transactionReadVersionBatches;
 	Counter transactionBatchReadVersions;
 	Counter transactionDefaultReadVersions;
@@ -464,6 +470,7 @@ public:
 	Counter transactionAtomicMutations;
 	Counter transactionsCommitStarted;
 	Counter transactionsCommitCompleted;
+	Counter transactionReadConflictRangesMerged;
 	Counter transactionKeyServerLocationRequests;
 	Counter transactionKeyServerLocationRequestsCompleted;
 	Counter transactionStatusRequests;
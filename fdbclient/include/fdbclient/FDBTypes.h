@@ -1635,6 +1635,8 @@ FDB_BOOLEAN_PARAM(CacheResult);
 // cacheResult determines whether the storage engine cache for this read
 // consistencyCheckStartVersion indicates the consistency check which began at this version
 // debugID helps to trace the path of the read
+// maxStaleness allows the read to be served at an older version than requested, by at most this many versions, if
+// the storage server has not yet caught up to the read version
 struct ReadOptions {
 	ReadType type;
 	// Once CacheResult is serializable, change type from bool to CacheResult
@@ -1642,6 +1644,7 @@ struct ReadOptions {
 	bool lockAware = false;
 	Optional<UID> debugID;
 	Optional<Version> consistencyCheckStartVersion;
+	Optional<Version> maxStaleness;
 
 	ReadOptions(Optional<UID> debugID = Optional<UID>(),
 	            ReadType type = ReadType::NORMAL,
@@ -1653,7 +1656,7 @@ struct ReadOptions {
 
 	template <class Ar>
 	void serialize(Ar& ar) {
-		serializer(ar, type, cacheResult, debugID, consistencyCheckStartVersion, lockAware);
+		serializer(ar, type, cacheResult, debugID, consistencyCheckStartVersion, lockAware, maxStaleness);
 	}
 };
 
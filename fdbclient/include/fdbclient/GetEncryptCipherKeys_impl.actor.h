@@ -128,6 +128,58 @@ Future<EKPGetLatestBaseCipherKeysReply> _getUncachedLatestEncryptCipherKeys(Refe
 	}
 }
 
+// Fetches the replacements of latest cipher keys which are due for refresh, while the keys being replaced keep being
+// served. Failures are only traced: once a key expires it is no longer served and the next caller fetches it.
+ACTOR template <class T>
+Future<Void> _refreshLatestEncryptCipherKeys(Reference<AsyncVar<T> const> db,
+                                             std::unordered_set<EncryptCipherDomainId> domainIds,
+                                             BlobCipherMetrics::UsageType usageType) {
+	state Reference<BlobCipherKeyCache> cipherKeyCache = BlobCipherKeyCache::getInstance();
+	state EKPGetLatestBaseCipherKeysRequest request;
+	state Future<Void> timeout = delay(CLIENT_KNOBS->ENCRYPT_CIPHER_KEY_REFRESH_TIMEOUT);
+
+	for (auto& domainId : domainIds) {
+		request.encryptDomainIds.emplace_back(domainId);
+	}
+	try {
+		// Keys cached at the same time come due for refresh together, so spread the requests out.
+		wait(delay(deterministicRandom()->random01() * CLIENT_KNOBS->ENCRYPT_CIPHER_KEY_REFRESH_JITTER));
+		loop choose {
+			when(EKPGetLatestBaseCipherKeysReply reply =
+			         wait(_getUncachedLatestEncryptCipherKeys(db, request, usageType))) {
+				for (const EKPBaseCipherDetails& details : reply.baseCipherDetails) {
+					if (domainIds.count(details.encryptDomainId) > 0) {
+						cipherKeyCache->insertCipherKey(details.encryptDomainId,
+						                                details.baseCipherId,
+						                                details.baseCipherKey.begin(),
+						                                details.baseCipherKey.size(),
+						                                details.baseCipherKCV,
+						                                details.refreshAt,
+						                                details.expireAt);
+					}
+				}
+				break;
+			}
+			when(wait(_onEncryptKeyProxyChange(db))) {}
+			when(wait(timeout)) {
+				TraceEvent(SevWarn, "RefreshLatestEncryptCipherKeysTimedOut")
+				    .detail("UsageType", toString(usageType))
+				    .detail("Domains", domainIds.size());
+				break;
+			}
+		}
+	} catch (Error& e) {
+		if (e.code() == error_code_actor_cancelled) {
+			throw;
+		}
+		TraceEvent(SevWarn, "RefreshLatestEncryptCipherKeysFailed").error(e).detail("UsageType", toString(usageType));
+	}
+	for (auto& domainId : domainIds) {
+		cipherKeyCache->finishRefresh(domainId);
+	}
+	return Void();
+}
+
 ACTOR template <class T>
 Future<std::unordered_map<EncryptCipherDomainId, Reference<BlobCipherKey>>> _getLatestEncryptCipherKeysImpl(
     Reference<AsyncVar<T> const> db,
@@ -142,15 +194,26 @@ Future<std::unordered_map<EncryptCipherDomainId, Reference<BlobCipherKey>>> _get
 		throw encrypt_ops_error();
 	}
 
-	// Collect cached cipher keys.
+	// Collect cached cipher keys. With background refresh, keys due for refresh are still used and their
+	// replacements are fetched without blocking this request.
+	state std::unordered_set<EncryptCipherDomainId> refreshDomainIds;
 	for (auto& domainId : domainIds) {
-		Reference<BlobCipherKey> cachedCipherKey = cipherKeyCache->getLatestCipherKey(domainId);
+		bool needsRefresh = false;
+		Reference<BlobCipherKey> cachedCipherKey = cipherKeyCache->getLatestCipherKey(
+		    domainId, CLIENT_KNOBS->ENCRYPT_CIPHER_KEY_BACKGROUND_REFRESH ? &needsRefresh : nullptr);
 		if (cachedCipherKey.isValid()) {
 			cipherKeys[domainId] = cachedCipherKey;
+			if (needsRefresh && cipherKeyCache->startRefresh(domainId)) {
+				refreshDomainIds.insert(domainId);
+			}
 		} else {
 			request.encryptDomainIds.emplace_back(domainId);
 		}
 	}
+	if (!refreshDomainIds.empty()) {
+		BlobCipherMetrics::getInstance()->latestCipherKeyCacheBackgroundRefresh += refreshDomainIds.size();
+		uncancellable(_refreshLatestEncryptCipherKeys(db, refreshDomainIds, usageType));
+	}
 	if (request.encryptDomainIds.empty()) {
 		return cipherKeys;
 	}
@@ -43,6 +43,8 @@ public:
 	// own memory. It is guaranteed, however, that the ThreadFuture will hold a reference to the memory. It will persist
 	// until the ThreadFuture's ThreadSingleAssignmentVar has its memory released or it is destroyed.
 	virtual ThreadFuture<Optional<Value>> get(const KeyRef& key, bool snapshot = false) = 0;
+	// Reads all of the given keys, returning the key-value pairs of those which are present in the order requested
+	virtual ThreadFuture<RangeResult> getMulti(const VectorRef<KeyRef>& keys, bool snapshot = false) = 0;
 	virtual ThreadFuture<Key> getKey(const KeySelectorRef& key, bool snapshot = false) = 0;
 	virtual ThreadFuture<RangeResult> getRange(const KeySelectorRef& begin,
 	                                           const KeySelectorRef& end,
@@ -75,6 +77,11 @@ public:
 	virtual ThreadFuture<int64_t> getEstimatedRangeSizeBytes(const KeyRangeRef& keys) = 0;
 	virtual ThreadFuture<Standalone<VectorRef<KeyRef>>> getRangeSplitPoints(const KeyRangeRef& range,
 	                                                                        int64_t chunkSize) = 0;
+	// Reads all of the given range as chunks of about chunkSize bytes, with up to parallelism chunks read at once
+	virtual ThreadFuture<RangeResult> getRangeParallel(const KeyRangeRef& range,
+	                                                   int parallelism,
+	                                                   int64_t chunkSize,
+	                                                   bool snapshot = false) = 0;
 
 	virtual void atomicOp(const KeyRef& key, const ValueRef& value, uint32_t operationType) = 0;
 	virtual void set(const KeyRef& key, const ValueRef& value) = 0;
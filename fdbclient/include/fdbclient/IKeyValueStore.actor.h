@@ -112,6 +112,9 @@ public:
 	// Returns the amount of free and total space for this store, in bytes
 	virtual StorageBytes getStorageBytes() const = 0;
 
+	// Returns the memory used by the store's caches and write buffers, in bytes, or 0 if the store does not report it
+	virtual int64_t getMemoryBytes() const { return 0; }
+
 	virtual void logRecentRocksDBBackgroundWorkStats(UID ssId, std::string logReason) { throw not_implemented(); }
 
 	virtual void resyncLog() {}
@@ -138,6 +141,10 @@ public:
 	// Compact a range of keys in the store
 	virtual Future<Void> compactRange(KeyRangeRef range) { throw not_implemented(); }
 
+	// Returns and forgets the costs, in bytes, of reads beyond the size of the data they returned, such as pages read
+	// from disk on cache misses.  Each cost is attributed to the first key of the read which incurred it.
+	virtual std::vector<std::pair<Key, int64_t>> takeReadCostSamples() { return {}; }
+
 	/*
 	Concurrency contract
 	    Causal consistency:
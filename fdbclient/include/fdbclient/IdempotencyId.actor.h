@@ -28,6 +28,7 @@
 
 #pragma once
 
+#include "fdbclient/CommitTransaction.h"
 #include "fdbclient/FDBTypes.h"
 #include "fdbclient/JsonBuilder.h"
 #include "fdbclient/PImpl.h"
@@ -189,6 +190,10 @@ KeyRangeRef makeIdempotencySingleKeyRange(Arena& arena, Version version, uint8_t
 
 void decodeIdempotencyKey(KeyRef key, Version& commitVersion, uint8_t& highOrderBatchIndex);
 
+// Append a clear of the idempotency key associated with version and highOrderBatchIndex to clears, merging it into the
+// last clear when that covers the neighboring keys of the same version
+void addIdempotencyClear(Standalone<VectorRef<MutationRef>>& clears, Version version, uint8_t highOrderBatchIndex);
+
 ACTOR Future<JsonBuilderObject> getIdmpKeyStatus(Database db);
 
 // Delete zero or more idempotency ids older than minAgeSeconds
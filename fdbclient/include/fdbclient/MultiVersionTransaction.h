@@ -144,6 +144,7 @@ struct FdbCApi : public ThreadSafeReferenceCounted<FdbCApi> {
 	FDBFuture* (*transactionGetReadVersion)(FDBTransaction* tr);
 
 	FDBFuture* (*transactionGet)(FDBTransaction* tr, uint8_t const* keyName, int keyNameLength, fdb_bool_t snapshot);
+	FDBFuture* (*transactionGetMulti)(FDBTransaction* tr, FDBKey const* keys, int keyCount, fdb_bool_t snapshot);
 	FDBFuture* (*transactionGetKey)(FDBTransaction* tr,
 	                                uint8_t const* keyName,
 	                                int keyNameLength,
@@ -215,6 +216,14 @@ struct FdbCApi : public ThreadSafeReferenceCounted<FdbCApi> {
 	                                             uint8_t const* end_key_name,
 	                                             int end_key_name_length,
 	                                             int64_t chunkSize);
+	FDBFuture* (*transactionGetRangeParallel)(FDBTransaction* tr,
+	                                          uint8_t const* begin_key_name,
+	                                          int begin_key_name_length,
+	                                          uint8_t const* end_key_name,
+	                                          int end_key_name_length,
+	                                          int parallelism,
+	                                          int64_t chunkSize,
+	                                          fdb_bool_t snapshot);
 
 	FDBFuture* (*transactionCommit)(FDBTransaction* tr);
 	fdb_error_t (*transactionGetCommittedVersion)(FDBTransaction* tr, int64_t* outVersion);
@@ -278,6 +287,7 @@ public:
 	ThreadFuture<Version> getReadVersion() override;
 
 	ThreadFuture<Optional<Value>> get(const KeyRef& key, bool snapshot = false) override;
+	ThreadFuture<RangeResult> getMulti(const VectorRef<KeyRef>& keys, bool snapshot = false) override;
 	ThreadFuture<Key> getKey(const KeySelectorRef& key, bool snapshot = false) override;
 	ThreadFuture<RangeResult> getRange(const KeySelectorRef& begin,
 	                                   const KeySelectorRef& end,
@@ -308,6 +318,10 @@ public:
 	ThreadFuture<int64_t> getEstimatedRangeSizeBytes(const KeyRangeRef& keys) override;
 	ThreadFuture<Standalone<VectorRef<KeyRef>>> getRangeSplitPoints(const KeyRangeRef& range,
 	                                                                int64_t chunkSize) override;
+	ThreadFuture<RangeResult> getRangeParallel(const KeyRangeRef& range,
+	                                           int parallelism,
+	                                           int64_t chunkSize,
+	                                           bool snapshot = false) override;
 
 	void addReadConflictRange(const KeyRangeRef& keys) override;
 
@@ -441,6 +455,7 @@ public:
 	ThreadFuture<Version> getReadVersion() override;
 
 	ThreadFuture<Optional<Value>> get(const KeyRef& key, bool snapshot = false) override;
+	ThreadFuture<RangeResult> getMulti(const VectorRef<KeyRef>& keys, bool snapshot = false) override;
 	ThreadFuture<Key> getKey(const KeySelectorRef& key, bool snapshot = false) override;
 	ThreadFuture<RangeResult> getRange(const KeySelectorRef& begin,
 	                                   const KeySelectorRef& end,
@@ -474,6 +489,10 @@ public:
 
 	ThreadFuture<Standalone<VectorRef<KeyRef>>> getRangeSplitPoints(const KeyRangeRef& range,
 	                                                                int64_t chunkSize) override;
+	ThreadFuture<RangeResult> getRangeParallel(const KeyRangeRef& range,
+	                                           int parallelism,
+	                                           int64_t chunkSize,
+	                                           bool snapshot = false) override;
 
 	void atomicOp(const KeyRef& key, const ValueRef& value, uint32_t operationType) override;
 	void set(const KeyRef& key, const ValueRef& value) override;
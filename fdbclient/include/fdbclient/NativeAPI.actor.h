@@ -170,6 +170,7 @@ struct TransactionOptions {
 	bool bypassStorageQuota : 1;
 	bool enableReplicaConsistencyCheck : 1;
 	int requiredReplicas;
+	int readConflictRangeLimit; // 0 for no limit
 
 	TransactionPriority priority;
 
@@ -271,6 +272,10 @@ struct TransactionState : ReferenceCounted<TransactionState> {
 
 	Version committedVersion{ invalidVersion };
 
+	// The oldest version a read was served at, if the read staleness budget allowed a read to be served at an older
+	// version than the read version
+	Optional<Version> staleReadVersion;
+
 	// Used to save conflicting keys if FDBTransactionOptions::REPORT_CONFLICTING_KEYS is enabled
 	// prefix/<key1> : '1' - any keys equal or larger than this key are (probably) conflicting keys
 	// prefix/<key2> : '0' - any keys equal or larger than this key are (definitely) not conflicting keys
@@ -421,6 +426,10 @@ public:
 	// The returned list would still be in form of [keys.begin, splitPoint1, splitPoint2, ... , keys.end]
 	Future<Standalone<VectorRef<KeyRef>>> getRangeSplitPoints(KeyRange const& keys, int64_t chunkSize);
 
+	// Computes the count, little-endian sum and size of the key-value pairs in the range at the read version, on the
+	// storage servers.  Writes made by the transaction are not included.
+	Future<RangeAggregate> getRangeAggregate(KeyRange const& keys, Snapshot = Snapshot::False);
+
 	// If checkWriteConflictRanges is true, existing write conflict ranges will be searched for this key
 	void set(const KeyRef& key, const ValueRef& value, AddConflictRange = AddConflictRange::True);
 	void atomicOp(const KeyRef& key,
@@ -438,6 +447,10 @@ public:
 	// May be called only after commit() returns success
 	Version getCommittedVersion() const { return trState->committedVersion; }
 
+	// The oldest version any read of this transaction was actually served at, if FDBTransactionOptions::
+	// READ_STALENESS_BUDGET allowed one to be served at an older version than the read version
+	Optional<Version> getStaleReadVersion() const { return trState->staleReadVersion; }
+
 	int64_t getTotalCost() const { return trState->totalCost; }
 
 	double getTagThrottledDuration() const;
@@ -597,6 +610,19 @@ inline uint64_t getReadOperationCost(uint64_t bytes) {
 	}
 }
 
+// The cost of a single key mutation. Storage servers read the current value of the key to apply an atomic op, so
+// atomic ops are also charged for that read. Versionstamped mutations become sets and are not. The client does not know
+// the size of the stored value, so the read is estimated from the key plus the operand, which is the size of the value
+// an arithmetic or bitwise op produces.
+inline uint64_t getMutationOperationCost(MutationRef const& m) {
+	uint64_t cost = getWriteOperationCost(m.expectedSize());
+	if (CLIENT_KNOBS->TAG_THROTTLING_CHARGE_ATOMIC_OP_READS && m.isAtomicOp() &&
+	    m.type != MutationRef::SetVersionstampedKey && m.type != MutationRef::SetVersionstampedValue) {
+		cost += getReadOperationCost(m.param1.size() + m.param2.size());
+	}
+	return cost;
+}
+
 // Create a transaction to set the value of system key \xff/conf/perpetual_storage_wiggle. If enable == true, the value
 // will be 1. Otherwise, the value will be 0. The caller should take care of the reset of StorageWiggleMetrics if
 // necessary. Returns the FDB version at which the transaction was committed.
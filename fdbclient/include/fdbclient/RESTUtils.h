@@ -29,6 +29,7 @@
 
 #include <boost/functional/hash.hpp>
 #include <fmt/format.h>
+#include <deque>
 #include <unordered_map>
 #include <utility>
 
@@ -56,7 +57,10 @@ public:
 
 	// Maximum number of connections cached in the connection-pool.
 	int maxConnPerConnectKey;
-	std::unordered_map<RESTConnectionPoolKey, std::queue<ReusableConnection>, boost::hash<RESTConnectionPoolKey>>
+	// Connections are returned to the back and reused from the back, so that the most recently used one, which is the
+	// least likely to have been closed by the server for idling, is reused first. Expired connections are dropped from
+	// the front.
+	std::unordered_map<RESTConnectionPoolKey, std::deque<ReusableConnection>, boost::hash<RESTConnectionPoolKey>>
 	    connectionPoolMap;
 
 	RESTConnectionPool(const int maxConnsPerKey) : maxConnPerConnectKey(maxConnsPerKey) {}
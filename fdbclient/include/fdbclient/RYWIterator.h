@@ -40,11 +40,13 @@ public:
 	bool is_empty_range() const;
 	bool is_unreadable() const;
 	bool is_dependent() const;
+	// True if the segment comes from the snapshot cache alone, so that skipContiguous() may extend it over several keys
+	bool is_unmodified() const;
 
 	ExtStringRef beginKey();
 	ExtStringRef endKey();
 
-	virtual const KeyValueRef* kv(Arena& arena);
+	const KeyValueRef* kv(Arena& arena);
 
 	RYWIterator& operator++();
 
@@ -61,7 +63,7 @@ public:
 
 	void bypassUnreadableProtection() { bypassUnreadable = true; }
 
-	virtual WriteMap::iterator& extractWriteMapIterator();
+	WriteMap::iterator& extractWriteMapIterator();
 	// Really this should return an iterator by value, but for performance it's convenient to actually grab the internal
 	// one.  Consider copying the return value if performance isn't critical. If you modify the returned iterator, it
 	// invalidates this iterator until the next call to skip()
@@ -116,6 +116,12 @@ public:
 	                                         Snapshot = Snapshot::False,
 	                                         Reverse = Reverse::False) override;
 
+	// Reads the given ranges concurrently into the transaction's cache, without adding read conflict ranges, so that
+	// later reads within them complete without waiting for a storage server. Each range is read from its beginning up
+	// to the limits, and only the part read is cached. Does nothing when read-your-writes is disabled, since there is
+	// then no cache to read into.
+	[[nodiscard]] Future<Void> prefetch(Standalone<VectorRef<KeyRangeRef>> const& ranges, GetRangeLimits limits);
+
 	[[nodiscard]] Future<Standalone<VectorRef<const char*>>> getAddressesForKey(const Key& key) override;
 	Future<Standalone<VectorRef<KeyRef>>> getRangeSplitPoints(const KeyRange& range, int64_t chunkSize) override;
 	Future<int64_t> getEstimatedRangeSizeBytes(const KeyRange& keys) override;
@@ -180,7 +180,7 @@ public:
 				"concurrent_writes_per_file (or cwps)  Max concurrent uploads in progress for any one file.",
 				"enable_read_cache (or erc)            Whether read block caching is enabled.",
 				"read_block_size (or rbs)              Block size in bytes to be used for reads.",
-				"read_ahead_blocks (or rab)            Number of blocks to read ahead of requested offset.",
+				"read_ahead_blocks (or rab)            Max number of blocks to read ahead of sequential reads.",
 				"read_cache_blocks_per_file (or rcb)   Size of the read cache for a file in blocks.",
 				"max_send_bytes_per_second (or sbps)   Max send bytes per second for all requests combined.",
 				"max_recv_bytes_per_second (or rbps)   Max receive bytes per second for all requests combined (NOT YET "
@@ -75,6 +75,7 @@ public:
 	int64_t UPDATE_STORAGE_BYTE_LIMIT;
 	int64_t REFERENCE_SPILL_UPDATE_STORAGE_BYTE_LIMIT;
 	double TLOG_PEEK_DELAY;
+	double TLOG_PEEK_STREAM_DELAY; // Delay before a caught up peek stream sends a new commit, to batch commits together
 	int LEGACY_TLOG_UPGRADE_ENTRIES_PER_VERSION;
 	int VERSION_MESSAGES_OVERHEAD_FACTOR_1024THS; // Multiplicative factor to bound total space used to store a version
 	                                              // message (measured in 1/1024ths, e.g. a value of 2048 yields a
@@ -84,6 +85,7 @@ public:
 	bool ENABLE_DETAILED_TLOG_POP_TRACE;
 	double TLOG_MESSAGE_BLOCK_OVERHEAD_FACTOR;
 	int64_t TLOG_MESSAGE_BLOCK_BYTES;
+	bool TLOG_EXACT_MESSAGE_BLOCK_ACCOUNTING; // Count the bytes reserved for message blocks instead of estimating them
 	int64_t MAX_MESSAGE_SIZE;
 	int LOG_SYSTEM_PUSHED_DATA_BLOCK_SIZE;
 	double PEEK_TRACKER_EXPIRATION_TIME;
@@ -101,8 +103,31 @@ public:
 	int64_t TLOG_SPILL_REFERENCE_MAX_PEEK_MEMORY_BYTES;
 	int64_t TLOG_SPILL_REFERENCE_MAX_BATCHES_PER_PEEK;
 	int64_t TLOG_SPILL_REFERENCE_MAX_BYTES_PER_BATCH;
+	// Commits adjacent in the disk queue are read together when serving peeks of data spilled by reference, in reads of
+	// up to this many bytes
+	int64_t TLOG_SPILL_REFERENCE_MAX_READ_BYTES;
+	// Read the next spilled commits of a tag spilled by reference while a peek reply which ended early is sent
+	bool TLOG_SPILL_REFERENCE_READAHEAD;
+	// Memory used to remember where each tag's messages are in commits read back from the disk queue to serve
+	// peeks of data spilled by reference, or 0 to parse each commit again for every tag which peeks it
+	int64_t TLOG_SPILLED_COMMIT_INDEX_BYTES;
+	// Compression filter applied to TLog queue entries, or NONE.  Queues written with compression enabled cannot be
+	// recovered by versions which predate it.
+	std::string TLOG_QUEUE_COMPRESSION_FILTER;
+	int TLOG_QUEUE_COMPRESSION_MIN_BYTES; // Queue entries smaller than this are written uncompressed
+	double TLOG_QUEUE_COMPRESSION_MAX_RATIO; // Entries must compress to at most this fraction of their size
+	// Directory, ideally on a separate device from the data folder, in which new TLog disk queues are created, or empty
+	// to keep each queue beside its TLog's data store.  Queues created here must be opened with the same setting.
+	std::string TLOG_DISK_QUEUE_FOLDER;
+	// Once the disk queue data kept for the oldest stopped generation exceeds this many bytes, the commits it still needs
+	// are copied into the TLog's data store by value so that the queue can be popped, or 0 to keep them in the queue.
+	// Data stores compacted this way cannot be recovered by versions which predate it.
+	int64_t TLOG_OLD_GENERATION_COMPACTION_BYTES;
 	int64_t DISK_QUEUE_FILE_EXTENSION_BYTES; // When we grow the disk queue, by how many bytes should it grow?
 	int64_t DISK_QUEUE_FILE_SHRINK_BYTES; // When we shrink the disk queue, by how many bytes should it shrink?
+	// Syncs of the disk queue files of a process requested within this many seconds of each other are issued together,
+	// so that a file system journal shared by the files can make them durable in one commit, or 0 to sync immediately
+	double DISK_QUEUE_SYNC_BATCH_WINDOW;
 	int64_t DISK_QUEUE_MAX_TRUNCATE_BYTES; // A truncate larger than this will cause the file to be replaced instead.
 	double TLOG_DEGRADED_DURATION;
 	double TXS_POPPED_MAX_DELAY;
@@ -145,6 +170,8 @@ public:
 	                                                          // than healthy priority
 	double RELOCATION_PARALLELISM_PER_SOURCE_SERVER;
 	double RELOCATION_PARALLELISM_PER_DEST_SERVER;
+	double HEALING_RELOCATION_PARALLELISM_PER_DEST_SERVER; // used instead of RELOCATION_PARALLELISM_PER_DEST_SERVER
+	                                                       // for relocations of teams with one or no replicas left
 	double MERGE_RELOCATION_PARALLELISM_PER_TEAM;
 	int DD_QUEUE_MAX_KEY_SERVERS;
 	int DD_REBALANCE_PARALLELISM;
@@ -233,6 +260,9 @@ public:
 	double CPU_PIVOT_RATIO;
 	// DD won't move shard to teams that has CPU > MAX_DEST_CPU_PERCENT
 	double MAX_DEST_CPU_PERCENT;
+	// DD won't move shard to teams that has a server whose disk is busy more than MAX_DEST_DISK_BUSY_PERCENT of the time,
+	// when ENABLE_STORAGE_QUEUE_AWARE_TEAM_SELECTION is set
+	double MAX_DEST_DISK_BUSY_PERCENT;
 	// The constant interval DD update pivot values for team selection. It should be >=
 	// min(STORAGE_METRICS_POLLING_DELAY,DETAILED_METRIC_UPDATE_RATE)  otherwise the pivot won't change;
 	double DD_TEAM_PIVOT_UPDATE_DELAY;
@@ -244,6 +274,8 @@ public:
 	bool ENABLE_DD_PHYSICAL_SHARD; // EXPERIMENTAL; If true, SHARD_ENCODE_LOCATION_METADATA must be true.
 	double DD_PHYSICAL_SHARD_MOVE_PROBABILITY; // Percentage of physical shard move, in the range of [0, 1].
 	bool ENABLE_PHYSICAL_SHARD_MOVE_EXPERIMENT;
+	bool DD_PHYSICAL_SHARD_MOVE_FOR_WIGGLE; // If true, perpetual wiggle moves data with physical shard moves, which
+	                                        // fall back to fetchKeys on storage servers that are not shard aware.
 	int64_t MAX_PHYSICAL_SHARD_BYTES;
 	double PHYSICAL_SHARD_METRICS_DELAY;
 	double ANONYMOUS_PHYSICAL_SHARD_TRANSITION_TIME;
@@ -270,6 +302,10 @@ public:
 	// shard metrics will update immediately
 	int64_t SHARD_READ_OPS_CHANGE_THRESHOLD;
 	bool ENABLE_WRITE_BASED_SHARD_SPLIT; // Experimental. Enable to enforce shard split when write traffic is high
+	int64_t SHARD_MAX_WRITE_OPS_PER_KSEC; // With ENABLE_WRITE_BASED_SHARD_SPLIT, shards with more write operations than
+	                                      // this are split, however few bytes they write
+	int64_t SHARD_SPLIT_WRITE_OPS_PER_KSEC; // When splitting a shard, it is split into pieces with fewer write operations
+	                                        // than this
 	int DD_SHARD_USABLE_REGION_CHECK_RATE; // Assuming all shards need to repair, the (rough) number of shards moving
 	                                       // for usable region per second. Set 0 to disable shard usable region check
 	double SHARD_MAX_READ_DENSITY_RATIO;
@@ -348,6 +384,8 @@ public:
 
 	bool ENABLE_STORAGE_QUEUE_AWARE_TEAM_SELECTION; // Experimental! Enable to avoid moving data to a team which has a
 	                                                // long storage queue
+	int64_t MAX_DEST_DURABILITY_LAG_VERSIONS; // With ENABLE_STORAGE_QUEUE_AWARE_TEAM_SELECTION, DD won't move data to a
+	                                          // team with a server whose durability lag is longer than this
 	double DD_LONG_STORAGE_QUEUE_TEAM_MAJORITY_PERCENTILE; // p% amount teams which have longer queues (team queue size
 	                                                       // = max SSes queue size)
 	bool ENABLE_REBALANCE_STORAGE_QUEUE; // Experimental! Enable to trigger data moves to rebalance storage queues when
@@ -405,6 +443,7 @@ public:
 	int BULKLOAD_FILE_BYTES_MAX; // the maximum bytes of files to inject by bulk loading
 	double BULKLOAD_DOWNLOAD_RETRY_DELAY; // seconds to wait between retries when downloading bulk load files
 	int BULKLOAD_DOWNLOAD_MAX_RETRIES; // maximum number of retries when downloading bulk load files
+	int BULKLOAD_DOWNLOAD_FILESET_PARALLELISM; // file sets of one bulk load task downloaded concurrently
 	int BULKLOAD_BYTE_SAMPLE_BATCH_KEY_COUNT; // the maximum key count that can be successively sampled when bulkload
 	double DD_BULKLOAD_SHARD_BOUNDARY_CHANGE_DELAY_SEC; // seconds to delay shard boundary change when blocked by bulk
 	                                                    // loading
@@ -517,6 +556,9 @@ public:
 	double ROCKSDB_READ_CHECKPOINT_TIMEOUT;
 	int64_t ROCKSDB_CHECKPOINT_READ_AHEAD_SIZE;
 	double ROCKSDB_READ_QUEUE_WAIT;
+	// Point reads posted in the same run loop tick are served by one MultiGet of at most this many keys.
+	// Set to 1 to disable batching.
+	int ROCKSDB_READ_VALUE_BATCH_MAX_KEYS;
 	int ROCKSDB_READ_QUEUE_SOFT_MAX;
 	int ROCKSDB_READ_QUEUE_HARD_MAX;
 	int ROCKSDB_FETCH_QUEUE_SOFT_MAX;
@@ -530,6 +572,7 @@ public:
 	bool SHARDED_ROCKSDB_REUSE_ITERATORS;
 	bool ROCKSDB_READ_RANGE_REUSE_BOUNDED_ITERATORS;
 	int ROCKSDB_READ_RANGE_BOUNDED_ITERATORS_MAX_LIMIT;
+	bool ROCKSDB_READ_ASYNC_IO;
 	int64_t ROCKSDB_WRITE_RATE_LIMITER_BYTES_PER_SEC;
 	int ROCKSDB_WRITE_RATE_LIMITER_FAIRNESS;
 	bool ROCKSDB_WRITE_RATE_LIMITER_AUTO_TUNE;
@@ -537,6 +580,7 @@ public:
 	bool ROCKSDB_DISABLE_AUTO_COMPACTIONS;
 	bool ROCKSDB_PERFCONTEXT_ENABLE; // Enable rocks perf context metrics. May cause performance overhead
 	double ROCKSDB_PERFCONTEXT_SAMPLE_RATE;
+	double ROCKSDB_PERFCONTEXT_READ_TRACE_SAMPLE_RATE; // Fraction of reads whose perf context is traced individually
 	double ROCKSDB_METRICS_SAMPLE_INTERVAL;
 	int ROCKSDB_MAX_SUBCOMPACTIONS;
 	int64_t ROCKSDB_SOFT_PENDING_COMPACT_BYTES_LIMIT;
@@ -609,6 +653,9 @@ public:
 	int ROCKSDB_WRITEBATCH_PROTECTION_BYTES_PER_KEY;
 	int ROCKSDB_MEMTABLE_PROTECTION_BYTES_PER_KEY;
 	int ROCKSDB_BLOCK_PROTECTION_BYTES_PER_KEY;
+	bool ROCKSDB_ENABLE_PIPELINED_WRITE;
+	bool ROCKSDB_ALLOW_CONCURRENT_MEMTABLE_WRITE;
+	int64_t ROCKSDB_LARGE_COMMIT_BYTES; // Commits at least this large are counted and traced
 	bool ROCKSDB_ENABLE_NONDETERMINISM; // Whether rocksdb nondeterministic behavior should be enabled in simulation.
 	                                    // Note that turning this on in simulation could lead to non-deterministic runs
 	                                    // since we rely on rocksdb metadata. This knob also applies to sharded rocks
@@ -623,6 +670,10 @@ public:
 	double SHARDED_ROCKSDB_COMPACTION_PERIOD;
 	double SHARDED_ROCKSDB_COMPACTION_ACTOR_DELAY;
 	int SHARDED_ROCKSDB_COMPACTION_SHARD_LIMIT;
+	bool SHARDED_ROCKSDB_CLEAN_UP_VACATED_RANGES; // Delete files and compact ranges removed from live physical shards
+	double SHARDED_ROCKSDB_VACATED_RANGE_CLEAN_UP_INTERVAL;
+	int SHARDED_ROCKSDB_VACATED_RANGE_CLEAN_UP_LIMIT; // Vacated ranges cleaned up per interval
+	double SHARDED_ROCKSDB_VACATED_RANGE_MAX_DISK_UTILIZATION;
 	int64_t SHARDED_ROCKSDB_WRITE_BUFFER_SIZE;
 	int64_t SHARDED_ROCKSDB_TOTAL_WRITE_BUFFER_SIZE;
 	int64_t SHARDED_ROCKSDB_MEMTABLE_BUDGET;
@@ -636,6 +687,15 @@ public:
 	int64_t SHARDED_ROCKSDB_BLOCK_CACHE_SIZE;
 	double SHARDED_ROCKSDB_CACHE_HIGH_PRI_POOL_RATIO;
 	bool SHARDED_ROCKSDB_CACHE_INDEX_AND_FILTER_BLOCKS;
+	bool SHARDED_ROCKSDB_CHARGE_MEMTABLES_TO_BLOCK_CACHE; // Memtables of all physical shards are charged to the
+	                                                      // shared block cache through one write buffer manager
+	double SHARDED_ROCKSDB_CACHE_FILL_MIN_READ_FRACTION; // A physical shard reading less than this fraction of the
+	                                                     // average shard read rate stops inserting into the block
+	                                                     // cache, so cold shards cannot evict the blocks of hot shards
+	// A physical shard whose read rate stays at or below SHARDED_ROCKSDB_COLD_SHARD_MAX_READ_BYTES_PER_SEC for
+	// SHARDED_ROCKSDB_COLD_SHARD_MIN_IDLE_TIME seconds is reported as cold
+	double SHARDED_ROCKSDB_COLD_SHARD_MAX_READ_BYTES_PER_SEC;
+	double SHARDED_ROCKSDB_COLD_SHARD_MIN_IDLE_TIME;
 	int64_t SHARDED_ROCKSDB_WRITE_RATE_LIMITER_BYTES_PER_SEC;
 	int64_t SHARDED_ROCKSDB_RATE_LIMITER_MODE;
 	int SHARDED_ROCKSDB_BACKGROUND_PARALLELISM;
@@ -648,6 +708,8 @@ public:
 	int SHARDED_ROCKSDB_COMPACTION_PRI;
 	bool SHARDED_ROCKSDB_READ_ASYNC_IO;
 	int SHARDED_ROCKSDB_PREFIX_LEN;
+	std::string SHARDED_ROCKSDB_PREFIX_FILTER_RANGES; // Per key prefix overrides of SHARDED_ROCKSDB_PREFIX_LEN
+	bool SHARDED_ROCKSDB_USE_RIBBON_FILTER; // Use Ribbon instead of Bloom filters for prefix filters
 	int SHARDED_ROCKSDB_BLOOM_FILTER_BITS;
 	double SHARDED_ROCKSDB_MEMTABLE_BLOOM_FILTER_RATIO;
 	double SHARDED_ROCKSDB_HISTOGRAMS_SAMPLE_RATE;
@@ -677,6 +739,8 @@ public:
 	double START_TRANSACTION_MAX_EMPTY_QUEUE_BUDGET;
 	double TAG_THROTTLE_MAX_EMPTY_QUEUE_BUDGET;
 	int START_TRANSACTION_MAX_QUEUE_SIZE;
+	double START_TRANSACTION_MAX_QUEUE_TIME; // Default and batch priority GRV requests which waited longer than this
+	                                         // to be started are rejected, so clients back off. 0 disables.
 	int KEY_LOCATION_MAX_QUEUE_SIZE;
 
 	double COMMIT_PROXY_LIVENESS_TIMEOUT;
@@ -692,6 +756,12 @@ public:
 	int COMMIT_TRANSACTION_BATCH_BYTES_MAX;
 	double COMMIT_TRANSACTION_BATCH_BYTES_SCALE_BASE;
 	double COMMIT_TRANSACTION_BATCH_BYTES_SCALE_POWER;
+	// Pick the batch interval and byte target from observed resolution and TLog push latency and the number of
+	// queued batches, instead of from the end-to-end commit latency alone
+	bool COMMIT_BATCH_ADAPTIVE_ENABLED;
+	int COMMIT_BATCH_ADAPTIVE_QUEUED_BATCHES; // More queued batches than this means the proxy is throughput bound
+	double COMMIT_BATCH_ADAPTIVE_GROWTH; // Factor by which the byte target grows or shrinks per batch
+	int COMMIT_BATCH_ADAPTIVE_BYTES_MAX;
 	int64_t COMMIT_BATCHES_MEM_BYTES_HARD_LIMIT;
 	double COMMIT_BATCHES_MEM_FRACTION_OF_TOTAL;
 	double COMMIT_BATCHES_MEM_TO_TOTAL_MEM_SCALE_FACTOR;
@@ -707,15 +777,26 @@ public:
 	double ENFORCED_MIN_RECOVERY_DURATION;
 	double REQUIRED_MIN_RECOVERY_DURATION;
 	bool ALWAYS_CAUSAL_READ_RISKY;
+	double GRV_PROXY_CAUSAL_READ_RISKY_CACHE_TIME; // Causal read risky GRVs may be answered by a GRV proxy with a
+	                                               // version, lock state and metadata version it got from the master
+	                                               // at most this long ago
 	int MAX_COMMIT_UPDATES;
 	double MAX_PROXY_COMPUTE;
 	double MAX_COMPUTE_PER_OPERATION;
 	double MAX_COMPUTE_DURATION_LOG_CUTOFF;
 	int PROXY_COMPUTE_BUCKETS;
 	double PROXY_COMPUTE_GROWTH_RATE;
+	// If true, the next commit batch may start resolving as soon as the current batch has sent its resolution
+	// requests, instead of after the estimated compute time, as long as it stays within
+	// PROXY_PIPELINED_RESOLUTION_DEPTH batches of the last batch to hand its mutations to the log system.
+	bool PROXY_PIPELINED_RESOLUTION;
+	int PROXY_PIPELINED_RESOLUTION_DEPTH;
 	int TXN_STATE_SEND_AMOUNT;
 	double REPORT_TRANSACTION_COST_ESTIMATION_DELAY;
 	bool PROXY_REJECT_BATCH_QUEUED_TOO_LONG;
+	// Mutations at least this large that are pushed to more than one TLog are serialized once and copied into each
+	// TLog's exactly sized message when it is collected, instead of being copied between growing writers.
+	int LOG_PUSH_SHARED_MUTATION_MIN_BYTES;
 	bool PROXY_USE_RESOLVER_PRIVATE_MUTATIONS;
 	bool BURSTINESS_METRICS_ENABLED;
 	// Interval on which to emit burstiness metrics on the commit proxy (in
@@ -735,6 +816,7 @@ public:
 	double COMMIT_SLEEP_TIME;
 	double MIN_BALANCE_TIME;
 	int64_t MIN_BALANCE_DIFFERENCE;
+	int RESOLUTION_BALANCE_PAIRS; // Pairs of resolvers which may exchange key ranges in one balancing round
 	double SECONDS_BEFORE_NO_FAILURE_DELAY;
 	int64_t MAX_TXS_SEND_MEMORY;
 	int64_t MAX_RECOVERY_VERSIONS;
@@ -751,6 +833,12 @@ public:
 	double SAMPLE_EXPIRATION_TIME;
 	double SAMPLE_POLL_TIME;
 	int64_t RESOLVER_STATE_MEMORY_LIMIT;
+	int RESOLVER_CONFLICT_THREADS; // Partitions used to check read conflict ranges in parallel; <= 1 disables.
+	                               // Simulation checks the partitions one after another on the resolver's thread
+	int RESOLVER_PARALLEL_CONFLICT_MIN_RANGES; // Smaller batches are checked on the resolver's network thread
+	bool RESOLVER_USE_ART_CONFLICT_SET; // Keep the version history in an adaptive radix tree instead of a SkipList;
+	                                    // read ranges scan every boundary they cover, so only suited to short
+	                                    // conflict ranges. RESOLVER_CONFLICT_THREADS is ignored
 
 	// Backup Worker
 	double BACKUP_TIMEOUT; // master's reaction time for backup failure
@@ -758,6 +846,8 @@ public:
 	int BACKUP_FILE_BLOCK_BYTES;
 	int64_t BACKUP_WORKER_LOCK_BYTES;
 	double BACKUP_UPLOAD_DELAY;
+	std::string BACKUP_LOG_COMPRESSION_FILTER; // Compresses partitioned mutation log blocks, see BackupWorker
+	double BACKUP_LOG_COMPRESSION_MAX_RATIO; // Caps the mutation bytes buffered for a compressed block, per block byte
 
 	// Cluster Controller
 	double CLUSTER_CONTROLLER_LOGGING_DELAY;
@@ -928,6 +1018,8 @@ public:
 	double RATEKEEPER_MAX_RATE;
 	double RATEKEEPER_BATCH_MIN_RATE;
 	double RATEKEEPER_BATCH_MAX_RATE;
+	double RATEKEEPER_QUEUE_PROJECTION_SECONDS; // Storage servers are throttled on their queue size projected this
+	                                            // far ahead at its current growth rate. 0 disables the projection.
 
 	int64_t TARGET_BYTES_PER_STORAGE_SERVER;
 	int64_t SPRING_BYTES_STORAGE_SERVER;
@@ -939,6 +1031,8 @@ public:
 	int64_t STORAGE_HARD_LIMIT_BYTES_OVERAGE;
 	int64_t STORAGE_HARD_LIMIT_BYTES_SPEED_UP_SIM;
 	int64_t STORAGE_HARD_LIMIT_BYTES_OVERAGE_SPEED_UP_SIM;
+	int64_t STORAGE_VERSION_WINDOW_SHRINK_BYTES; // Storage queue size above which fewer versions are kept in memory
+	int64_t STORAGE_MIN_VERSIONS_IN_MEMORY; // Versions kept in memory when the version window is fully shrunk
 	int64_t STORAGE_HARD_LIMIT_VERSION_OVERAGE;
 	int64_t STORAGE_DURABILITY_LAG_HARD_MAX;
 	int64_t STORAGE_DURABILITY_LAG_SOFT_MAX;
@@ -976,6 +1070,9 @@ public:
 	// Limit to the number of throttling tags each storage server
 	// will track and send to the ratekeeper
 	int64_t SS_THROTTLE_TAGS_TRACKED;
+	// Limit to the number of distinct tags each storage server counts
+	// costs for in an interval, 0 for no limit
+	int64_t SS_THROTTLE_TAGS_COUNTED;
 	// Use global tag throttling strategy. i.e. throttle based on the cluster-wide
 	// throughput for tags and their associated quotas.
 	bool GLOBAL_TAG_THROTTLING;
@@ -1097,6 +1194,7 @@ public:
 	// Storage Server
 	double STORAGE_LOGGING_DELAY;
 	double STORAGE_SERVER_POLL_METRICS_DELAY;
+	double STORAGE_READ_COST_SAMPLE_DELAY; // How often read costs sampled by the storage engine feed read sampling
 	double FUTURE_VERSION_DELAY;
 	int STORAGE_LIMIT_BYTES;
 	int BUGGIFY_LIMIT_BYTES;
@@ -1106,6 +1204,7 @@ public:
 	int FETCH_KEYS_PARALLELISM_BYTES;
 	int FETCH_KEYS_PARALLELISM;
 	int FETCH_KEYS_LOWER_PRIORITY;
+	int FETCH_KEYS_PARALLEL_SUBRANGES; // Sub-ranges of FETCH_BLOCK_BYTES read concurrently by a non-streaming fetch
 	int SERVE_FETCH_CHECKPOINT_PARALLELISM;
 	int SERVE_AUDIT_STORAGE_PARALLELISM;
 	int PERSIST_FINISH_AUDIT_COUNT; // Num of persist complete/failed audits for each type
@@ -1159,18 +1258,48 @@ public:
 	double FETCH_KEYS_TOO_LONG_TIME_CRITERIA;
 	double MAX_STORAGE_COMMIT_TIME;
 	int64_t RANGESTREAM_LIMIT_BYTES;
+	// Range streams grow their flow control window beyond RANGESTREAM_LIMIT_BYTES, up to this size, to cover the
+	// observed bandwidth-delay product of the client's connection times RANGESTREAM_WINDOW_GAIN
+	int64_t RANGESTREAM_MAX_LIMIT_BYTES;
+	double RANGESTREAM_WINDOW_GAIN;
 	int64_t BLOBWORKERSTATUSSTREAM_LIMIT_BYTES;
+	int64_t CHANGEFEEDSTREAM_LIMIT_BYTES; // Flow control window of a change feed stream
+	int64_t CHANGE_FEED_MAX_BYTES; // Memory limit of a single in-memory change feed; older versions are discarded
+	int64_t CHANGE_FEED_PROCESS_MAX_BYTES; // Memory limit of all change feeds in a process; storage servers with feeds
+	                                       // stop applying new versions until feeds are popped below it
+	double CHANGE_FEED_IDLE_TIMEOUT; // Change feeds with no streams for this long are removed
+	double CHANGE_FEED_HEARTBEAT_INTERVAL;
+	double CHANGE_FEED_STREAM_BATCH_DELAY; // Time to wait for more versions before replying to a caught up stream
+	int STORAGE_FEED_STREAM_HARD_LIMIT;
 	bool ENABLE_CLEAR_RANGE_EAGER_READS;
 	bool QUICK_GET_VALUE_FALLBACK;
 	bool QUICK_GET_KEY_VALUES_FALLBACK;
 	bool STRICTLY_ENFORCE_BYTE_LIMIT;
 	double FRACTION_INDEX_BYTELIMIT_PREFETCH;
 	int MAX_PARALLEL_QUICK_GET_VALUE;
+	// If true, the point lookups of a mapped range read are issued as batches of up to QUICK_GET_VALUES_BATCH_SIZE
+	// keys.  The keys readable on this storage server are read with one local getValues request, and only the rest
+	// are read through quickGetValue.
+	bool QUICK_GET_VALUES_BATCHED;
+	int QUICK_GET_VALUES_BATCH_SIZE;
 	int CHECKPOINT_TRANSFER_BLOCK_BYTES;
+	bool CHECKPOINT_HARD_LINK_LOCAL_FILES; // Hard link checkpoint files of storage servers on the same host
 	int QUICK_GET_KEY_VALUES_LIMIT;
 	int QUICK_GET_KEY_VALUES_LIMIT_BYTES;
+	// The most data a storage server aggregates for one range aggregate request before replying with a partial result
+	int64_t STORAGE_RANGE_AGGREGATE_SCAN_BYTES;
+	// The most data a range read with a filter scans before replying with the rows which matched so far
+	int64_t STORAGE_FILTERED_READ_SCAN_BYTES;
+	// Memory used by a storage server to cache values read from its storage engine, or 0 to disable the cache
+	int64_t STORAGE_SERVER_READ_CACHE_BYTES;
 	std::string STORAGESERVER_READ_PRIORITIES;
 	int STORAGE_SERVER_READ_CONCURRENCY;
+	// If true, reads at the same priority are queued fairly by transaction tag.  Only reads which carry their tags,
+	// as sampled by the transaction tag sample rate, are queued by tag rather than together with untagged reads.
+	bool STORAGE_SERVER_READ_FAIR_QUEUEING;
+	// Reads of the busiest tags are queued as if they cost up to this much more than other reads, in proportion to
+	// the fraction of the storage server's read cost the tag was responsible for in the last interval
+	double STORAGE_SERVER_READ_FAIR_QUEUEING_BUSY_TAG_COST;
 	std::string STORAGESERVER_READTYPE_PRIORITY_MAP;
 	int SPLIT_METRICS_MAX_ROWS;
 	double STORAGE_SHARD_CONSISTENCY_CHECK_INTERVAL;
@@ -1260,6 +1389,7 @@ public:
 	// Status
 	double STATUS_MIN_TIME_BETWEEN_REQUESTS;
 	double MAX_STATUS_REQUESTS_PER_SECOND;
+	double STATUS_CACHE_TIME; // If > 0, status requests within this many seconds of the last status reuse its result
 	int CONFIGURATION_ROWS_TO_FETCH;
 	bool DISABLE_DUPLICATE_LOG_WARNING;
 	double HISTOGRAM_REPORT_INTERVAL;
@@ -1327,6 +1457,7 @@ public:
 	int REDWOOD_DEFAULT_EXTENT_READ_SIZE; // Extent read size for Redwood files
 	int REDWOOD_EXTENT_CONCURRENT_READS; // Max number of simultaneous extent disk reads in progress.
 	bool REDWOOD_KVSTORE_RANGE_PREFETCH; // Whether to use range read prefetching
+	int REDWOOD_KVSTORE_RANGE_PREFETCH_WINDOW_PAGES; // Max leaf reads a range read keeps in flight ahead of its cursor
 	double REDWOOD_PAGE_REBUILD_MAX_SLACK; // When rebuilding pages, max slack to allow in page before extending it
 	double REDWOOD_PAGE_REBUILD_SLACK_DISTRIBUTION; // When rebuilding pages, use this ratio of slack distribution
 	                                                // between the rightmost (new) page and the previous page. Defaults
@@ -1335,8 +1466,11 @@ public:
 	                                                // old page, where a value close to 1 causes the new page to have
 	                                                // most of the slack. Immutable workloads with an increasing key
 	                                                // pattern benefit from setting this to a value close to 1.
-	int REDWOOD_LAZY_CLEAR_BATCH_SIZE_PAGES; // Number of pages to try to pop from the lazy delete queue and process at
-	                                         // once
+	int REDWOOD_LAZY_CLEAR_BATCH_SIZE_PAGES; // Number of lazy delete queue pages to keep reading ahead of the one being
+	                                         // processed while other pager IO is waiting
+	int REDWOOD_LAZY_CLEAR_IDLE_BATCH_SIZE_PAGES; // Number of lazy clear page reads to keep in flight while no other
+	                                              // pager IO is waiting, so large clears are reclaimed faster when the
+	                                              // disk is idle
 	int REDWOOD_LAZY_CLEAR_MIN_PAGES; // Minimum number of pages to free before ending a lazy clear cycle, unless the
 	                                  // queue is empty
 	int REDWOOD_LAZY_CLEAR_MAX_PAGES; // Maximum number of pages to free before ending a lazy clear cycle, unless the
@@ -1345,10 +1479,21 @@ public:
 	                                            // remap cleanup
 	double REDWOOD_REMAP_CLEANUP_TOLERANCE_RATIO; // Maximum ratio of the remap cleanup window that remap cleanup is
 	                                              // allowed to be ahead or behind
+	int REDWOOD_REMAP_CLEANUP_PAGES_PER_SECOND; // Target rate of page copies done by remap cleanup, 0 for unlimited.
+	                                            // Pacing is abandoned while the remap backlog exceeds twice its window.
 	int REDWOOD_PAGEFILE_GROWTH_SIZE_PAGES; // Number of pages to grow page file by
 	double REDWOOD_METRICS_INTERVAL;
 	double REDWOOD_HISTOGRAM_INTERVAL;
 	bool REDWOOD_EVICT_UPDATED_PAGES; // Whether to prioritize eviction of updated pages from cache.
+	bool REDWOOD_ART_MUTATION_BUFFER; // Whether the mutation buffer is an adaptive radix tree rather than a std::map
+	int REDWOOD_READ_COST_SAMPLES_MAX; // Max cache miss read costs held for the storage server's read sampling
+	double REDWOOD_PAGE_CACHE_PROTECTED_FRACTION; // Fraction of the page cache reserved for pages hit more than once,
+	                                              // so scans cannot evict them.  0 makes eviction plain LRU.
+	int64_t REDWOOD_COMPRESSED_PAGE_CACHE_BYTES; // Memory for compressed copies of leaf pages evicted from the page
+	                                             // cache, 0 disables the compressed page cache.
+	std::string REDWOOD_COMPRESSED_PAGE_CACHE_FILTER; // Compression filter used for the compressed page cache
+	double REDWOOD_COMPRESSED_PAGE_CACHE_MAX_RATIO; // Pages which do not compress to at most this fraction of their
+	                                                // size are not kept in the compressed page cache.
 	int REDWOOD_DECODECACHE_REUSE_MIN_HEIGHT; // Minimum height for which to keep and reuse page decode caches
 	int REDWOOD_NODE_MAX_UNBALANCE; // Maximum imbalance in a node before it should be rebuilt instead of updated
 
@@ -1396,6 +1541,7 @@ public:
 	double REST_KMS_STABILITY_CHECK_INTERVAL;
 
 	double CONSISTENCY_SCAN_ACTIVE_THROTTLE_RATIO;
+	double CONSISTENCY_SCAN_BUSY_READ_LATENCY; // If > 0, back off for as long as a slower read took, 0 disables
 
 	// Idempotency ids
 	double IDEMPOTENCY_ID_IN_MEMORY_LIFETIME;
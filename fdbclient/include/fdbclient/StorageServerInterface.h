@@ -127,6 +127,9 @@ struct StorageServerInterface {
 	RequestStream<struct GetHotShardsRequest> getHotShards;
 	RequestStream<struct GetStorageCheckSumRequest> getCheckSum;
 	RequestStream<struct BulkDumpRequest> bulkdump;
+	// Reads several keys at the same version with a single request, for keys that are all within this server's shards
+	PublicRequestStream<struct GetValuesRequest> getValues;
+	PublicRequestStream<struct GetRangeAggregateRequest> getRangeAggregate;
 
 private:
 	bool acceptingRequests;
@@ -197,6 +200,9 @@ public:
 			getCheckSum =
 			    RequestStream<struct GetStorageCheckSumRequest>(getValue.getEndpoint().getAdjustedEndpoint(25));
 			bulkdump = RequestStream<struct BulkDumpRequest>(getValue.getEndpoint().getAdjustedEndpoint(26));
+			getValues = PublicRequestStream<struct GetValuesRequest>(getValue.getEndpoint().getAdjustedEndpoint(27));
+			getRangeAggregate =
+			    PublicRequestStream<struct GetRangeAggregateRequest>(getValue.getEndpoint().getAdjustedEndpoint(28));
 		}
 	}
 	bool operator==(StorageServerInterface const& s) const { return uniqueID == s.uniqueID; }
@@ -230,6 +236,8 @@ public:
 		streams.push_back(getHotShards.getReceiver());
 		streams.push_back(getCheckSum.getReceiver());
 		streams.push_back(bulkdump.getReceiver());
+		streams.push_back(getValues.getReceiver(TaskPriority::LoadBalancedEndpoint));
+		streams.push_back(getRangeAggregate.getReceiver(TaskPriority::LoadBalancedEndpoint));
 		FlowTransport::transport().addEndpoints(streams);
 	}
 };
@@ -271,13 +279,15 @@ struct GetValueReply : public LoadBalancedReply {
 	constexpr static FileIdentifier file_identifier = 1378929;
 	Optional<Value> value;
 	bool cached;
+	// Set if the read was served at an older version than requested, as allowed by ReadOptions::maxStaleness
+	Optional<Version> version;
 
 	GetValueReply() : cached(false) {}
 	GetValueReply(Optional<Value> value, bool cached) : value(value), cached(cached) {}
 
 	template <class Ar>
 	void serialize(Ar& ar) {
-		serializer(ar, LoadBalancedReply::penalty, LoadBalancedReply::error, value, cached);
+		serializer(ar, LoadBalancedReply::penalty, LoadBalancedReply::error, value, cached, version);
 	}
 };
 
@@ -311,6 +321,51 @@ struct GetValueRequest : TimedRequest {
 	}
 };
 
+struct GetValuesReply : public LoadBalancedReply {
+	constexpr static FileIdentifier file_identifier = 1378930;
+	// One entry per key of the request, in the same order
+	std::vector<Optional<Value>> values;
+	bool cached;
+
+	GetValuesReply() : cached(false) {}
+
+	template <class Ar>
+	void serialize(Ar& ar) {
+		serializer(ar, LoadBalancedReply::penalty, LoadBalancedReply::error, values, cached);
+	}
+};
+
+struct GetValuesRequest : TimedRequest {
+	constexpr static FileIdentifier file_identifier = 8454531;
+	SpanContext spanContext;
+	Arena arena;
+	VectorRef<KeyRef> keys;
+	Version version;
+	Optional<TagSet> tags;
+	ReplyPromise<GetValuesReply> reply;
+	Optional<ReadOptions> options;
+	VersionVector ssLatestCommitVersions; // includes the latest commit versions, as known
+	                                      // to this client, of all storage replicas that
+	                                      // serve the given keys
+	GetValuesRequest() {}
+
+	bool verify() const { return true; }
+
+	GetValuesRequest(SpanContext spanContext,
+	                 VectorRef<KeyRef> keys,
+	                 Version ver,
+	                 Optional<TagSet> tags,
+	                 Optional<ReadOptions> options,
+	                 VersionVector latestCommitVersions)
+	  : spanContext(spanContext), keys(arena, keys), version(ver), tags(tags), options(options),
+	    ssLatestCommitVersions(latestCommitVersions) {}
+
+	template <class Ar>
+	void serialize(Ar& ar) {
+		serializer(ar, keys, version, tags, reply, spanContext, options, ssLatestCommitVersions, arena);
+	}
+};
+
 struct WatchValueReply {
 	constexpr static FileIdentifier file_identifier = 3;
 
@@ -353,6 +408,63 @@ struct WatchValueRequest {
 	}
 };
 
+// Compares one element of a key, unpacked as a tuple, with a constant.  Tuple encoding preserves order, so the packed
+// element is compared bytewise with the packed constant.
+struct KeyTuplePredicateRef {
+	enum Op : uint8_t { EQ = 0, NE, LT, LE, GT, GE };
+
+	int index = 0;
+	uint8_t op = EQ;
+	// A packed tuple containing only the element to compare with
+	ValueRef element;
+
+	KeyTuplePredicateRef() {}
+	KeyTuplePredicateRef(Arena& a, int index, Op op, ValueRef element) : index(index), op(op), element(a, element) {}
+	KeyTuplePredicateRef(Arena& a, const KeyTuplePredicateRef& copyFrom)
+	  : index(copyFrom.index), op(copyFrom.op), element(a, copyFrom.element) {}
+
+	bool matches(StringRef packedElement) const;
+
+	int expectedSize() const { return element.expectedSize(); }
+
+	template <class Ar>
+	void serialize(Ar& ar) {
+		serializer(ar, index, op, element);
+	}
+};
+
+// A filter evaluated by the storage server on each row of a range read.  Rows which do not match are neither returned
+// nor counted against the limits of the read, so a selective scan returns only the rows the client asked for.  A row
+// matches if every condition which is set holds.
+struct ReadFilterRef {
+	VectorRef<KeyTuplePredicateRef> keyTuple;
+	Optional<KeyRef> keyPrefix;
+	Optional<ValueRef> valuePrefix;
+	int minValueBytes = 0;
+	int maxValueBytes = std::numeric_limits<int>::max();
+	// If true, matching rows are returned with empty values
+	bool keysOnly = false;
+
+	ReadFilterRef() {}
+	ReadFilterRef(Arena& a, const ReadFilterRef& copyFrom)
+	  : keyTuple(a, copyFrom.keyTuple), minValueBytes(copyFrom.minValueBytes), maxValueBytes(copyFrom.maxValueBytes),
+	    keysOnly(copyFrom.keysOnly) {
+		if (copyFrom.keyPrefix.present()) {
+			keyPrefix = KeyRef(a, copyFrom.keyPrefix.get());
+		}
+		if (copyFrom.valuePrefix.present()) {
+			valuePrefix = ValueRef(a, copyFrom.valuePrefix.get());
+		}
+	}
+
+	bool matches(KeyValueRef kv) const;
+
+	template <class Ar>
+	void serialize(Ar& ar) {
+		serializer(ar, keyTuple, keyPrefix, valuePrefix, minValueBytes, maxValueBytes, keysOnly);
+	}
+};
+
 struct GetKeyValuesReply : public LoadBalancedReply {
 	constexpr static FileIdentifier file_identifier = 1783066;
 	Arena arena;
@@ -360,12 +472,57 @@ struct GetKeyValuesReply : public LoadBalancedReply {
 	Version version; // useful when latestVersion was requested
 	bool more;
 	bool cached = false;
+	// Set for filtered reads which stopped before reaching their limits, after scanning the most data a read is
+	// allowed to.  A forward read continues at this key and a reverse read continues before it, rather than from the
+	// last row returned.
+	Optional<KeyRef> scanEnd;
+	// When not empty, each key in data is only the part of it following the first keyPrefixLengths[i] bytes, which it
+	// shares with the key before it
+	VectorRef<uint16_t> keyPrefixLengths;
 
 	GetKeyValuesReply() : version(invalidVersion), more(false), cached(false) {}
 
+	// Keys read from a range often share long prefixes, which need not be sent for every key
+	void compressKeyPrefixes() {
+		if (data.size() < 2) {
+			return;
+		}
+		keyPrefixLengths.resize(arena, data.size());
+		keyPrefixLengths[0] = 0;
+		KeyRef prev = data[0].key;
+		for (int i = 1; i < data.size(); i++) {
+			KeyRef key = data[i].key;
+			keyPrefixLengths[i] = std::min(commonPrefixLength(prev, key), (int)std::numeric_limits<uint16_t>::max());
+			data[i].key = key.substr(keyPrefixLengths[i]);
+			prev = key;
+		}
+	}
+
+	void expandKeyPrefixes() {
+		if (keyPrefixLengths.empty()) {
+			return;
+		}
+		ASSERT_EQ(keyPrefixLengths.size(), data.size());
+		for (int i = 1; i < data.size(); i++) {
+			if (keyPrefixLengths[i] > 0) {
+				data[i].key = data[i - 1].key.substr(0, keyPrefixLengths[i]).withSuffix(data[i].key, arena);
+			}
+		}
+		keyPrefixLengths = VectorRef<uint16_t>();
+	}
+
 	template <class Ar>
 	void serialize(Ar& ar) {
-		serializer(ar, LoadBalancedReply::penalty, LoadBalancedReply::error, data, version, more, cached, arena);
+		serializer(ar,
+		           LoadBalancedReply::penalty,
+		           LoadBalancedReply::error,
+		           data,
+		           version,
+		           more,
+		           cached,
+		           scanEnd,
+		           keyPrefixLengths,
+		           arena);
 	}
 };
 
@@ -386,6 +543,8 @@ struct GetKeyValuesRequest : TimedRequest {
 	                                      // to this client, of all storage replicas that
 	                                      // serve the given key
 	Optional<TaskPriority> taskID; // includes the information about read purpose
+	Optional<ReadFilterRef> filter;
+	bool compressKeyPrefixes = false; // Whether the reply may leave out the prefix each key shares with the one before
 
 	GetKeyValuesRequest() {}
 
@@ -405,10 +564,84 @@ struct GetKeyValuesRequest : TimedRequest {
 		           options,
 		           ssLatestCommitVersions,
 		           taskID,
+		           filter,
+		           compressKeyPrefixes,
 		           arena);
 	}
 };
 
+// Aggregates over the key-value pairs of a range
+struct RangeAggregate {
+	int64_t count = 0;
+	// The sum of the values read as little-endian integers, accumulated as the AddValue atomic operation would
+	int64_t sum = 0;
+	// The total size of the keys and values
+	int64_t bytes = 0;
+	Optional<Key> minKey, maxKey;
+
+	void add(KeyValueRef kv);
+	// Adds a batch of rows, copying the minimum and maximum keys at most once each
+	void add(const KeyValueRef* kvs, int n);
+	void add(const RangeAggregate& other);
+
+	bool operator==(const RangeAggregate& r) const {
+		return count == r.count && sum == r.sum && bytes == r.bytes && minKey == r.minKey && maxKey == r.maxKey;
+	}
+
+	template <class Ar>
+	void serialize(Ar& ar) {
+		serializer(ar, count, sum, bytes, minKey, maxKey);
+	}
+};
+
+struct GetRangeAggregateReply : public LoadBalancedReply {
+	constexpr static FileIdentifier file_identifier = 1783068;
+	RangeAggregate aggregate;
+	// If true, only [range.begin, end) was aggregated, and the rest of the range must be requested again
+	bool more = false;
+	Key end;
+	bool cached = false;
+
+	GetRangeAggregateReply() {}
+
+	template <class Ar>
+	void serialize(Ar& ar) {
+		serializer(ar, LoadBalancedReply::penalty, LoadBalancedReply::error, aggregate, more, end, cached);
+	}
+};
+
+// Computes a RangeAggregate at a version on the storage server, for a range within one of its shards
+struct GetRangeAggregateRequest : TimedRequest {
+	constexpr static FileIdentifier file_identifier = 6795748;
+	SpanContext spanContext;
+	Arena arena;
+	KeyRangeRef range;
+	Version version;
+	Optional<TagSet> tags;
+	Optional<ReadOptions> options;
+	ReplyPromise<GetRangeAggregateReply> reply;
+	VersionVector ssLatestCommitVersions; // includes the latest commit versions, as known
+	                                      // to this client, of all storage replicas that
+	                                      // serve the given key range
+
+	GetRangeAggregateRequest() {}
+	GetRangeAggregateRequest(SpanContext spanContext,
+	                         KeyRangeRef range,
+	                         Version version,
+	                         Optional<TagSet> tags,
+	                         Optional<ReadOptions> options,
+	                         VersionVector latestCommitVersions)
+	  : spanContext(spanContext), range(arena, range), version(version), tags(tags), options(options),
+	    ssLatestCommitVersions(latestCommitVersions) {}
+
+	bool verify() const { return true; }
+
+	template <class Ar>
+	void serialize(Ar& ar) {
+		serializer(ar, range, version, tags, reply, spanContext, options, ssLatestCommitVersions, arena);
+	}
+};
+
 struct GetMappedKeyValuesReply : public LoadBalancedReply {
 	constexpr static FileIdentifier file_identifier = 1783067;
 	Arena arena;
@@ -506,6 +739,7 @@ struct GetKeyValuesStreamRequest {
 	VersionVector ssLatestCommitVersions; // includes the latest commit versions, as known
 	                                      // to this client, of all storage replicas that
 	                                      // serve the given key range
+	Optional<ReadFilterRef> filter;
 
 	GetKeyValuesStreamRequest() {}
 
@@ -524,6 +758,7 @@ struct GetKeyValuesStreamRequest {
 		           spanContext,
 		           options,
 		           ssLatestCommitVersions,
+		           filter,
 		           arena);
 	}
 };
@@ -884,8 +1119,8 @@ struct ChangeFeedStreamReply : public ReplyPromiseStreamReply {
 	}
 };
 
-// NOTE: This is obsolete and not used, but a RequestStream interface dependent on this
-// type is persisted in the database via StorageServerInterface, so just keep this around.
+// Streams the mutations of the change feed rangeID within range, for versions in [begin, end). The storage server
+// registers the feed in memory the first time it is named, so only mutations applied after that are available.
 struct ChangeFeedStreamRequest {
 	constexpr static FileIdentifier file_identifier = 6795746;
 	SpanContext spanContext;
@@ -921,8 +1156,7 @@ struct ChangeFeedStreamRequest {
 	}
 };
 
-// NOTE: This is obsolete and not used, but a RequestStream interface dependent on this
-// type is persisted in the database via StorageServerInterface, so just keep this around.
+// Discards the mutations of a change feed before version.
 struct ChangeFeedPopRequest {
 	constexpr static FileIdentifier file_identifier = 10726174;
 	Key rangeID;
@@ -1028,8 +1262,6 @@ struct FetchCheckpointKeyValuesRequest {
 	}
 };
 
-// NOTE: This is obsolete and not used, but a RequestStream interface dependent on this
-// type is persisted in the database via StorageServerInterface, so just keep this around.
 struct OverlappingChangeFeedEntry {
 	KeyRef feedId;
 	KeyRangeRef range;
@@ -1061,8 +1293,6 @@ struct OverlappingChangeFeedEntry {
 	}
 };
 
-// NOTE: This is obsolete and not used, but a RequestStream interface dependent on this
-// type is persisted in the database via StorageServerInterface, so just keep this around.
 struct OverlappingChangeFeedsReply {
 	constexpr static FileIdentifier file_identifier = 11815134;
 	VectorRef<OverlappingChangeFeedEntry> feeds;
@@ -1081,8 +1311,7 @@ struct OverlappingChangeFeedsReply {
 	}
 };
 
-// NOTE: This is obsolete and not used, but a RequestStream interface dependent on this
-// type is persisted in the database via StorageServerInterface, so just keep this around.
+// Returns the change feeds registered on a storage server which intersect range.
 struct OverlappingChangeFeedsRequest {
 	constexpr static FileIdentifier file_identifier = 7228462;
 	KeyRange range;
@@ -1098,8 +1327,6 @@ struct OverlappingChangeFeedsRequest {
 	}
 };
 
-// NOTE: This is obsolete and not used, but a RequestStream interface dependent on this
-// type is persisted in the database via StorageServerInterface, so just keep this around.
 struct ChangeFeedVersionUpdateReply {
 	constexpr static FileIdentifier file_identifier = 4246160;
 	Version version = 0;
@@ -1113,8 +1340,7 @@ struct ChangeFeedVersionUpdateReply {
 	}
 };
 
-// NOTE: This is obsolete and not used, but a RequestStream interface dependent on this
-// type is persisted in the database via StorageServerInterface, so just keep this around.
+// Replies with the storage server's version once it is at least minVersion.
 struct ChangeFeedVersionUpdateRequest {
 	constexpr static FileIdentifier file_identifier = 6795746;
 	Version minVersion;
@@ -92,6 +92,7 @@ public:
 	ThreadFuture<Version> getReadVersion() override;
 
 	ThreadFuture<Optional<Value>> get(const KeyRef& key, bool snapshot = false) override;
+	ThreadFuture<RangeResult> getMulti(const VectorRef<KeyRef>& keys, bool snapshot = false) override;
 	ThreadFuture<Key> getKey(const KeySelectorRef& key, bool snapshot = false) override;
 	ThreadFuture<RangeResult> getRange(const KeySelectorRef& begin,
 	                                   const KeySelectorRef& end,
@@ -126,6 +127,10 @@ public:
 	ThreadFuture<int64_t> getEstimatedRangeSizeBytes(const KeyRangeRef& keys) override;
 	ThreadFuture<Standalone<VectorRef<KeyRef>>> getRangeSplitPoints(const KeyRangeRef& range,
 	                                                                int64_t chunkSize) override;
+	ThreadFuture<RangeResult> getRangeParallel(const KeyRangeRef& range,
+	                                           int parallelism,
+	                                           int64_t chunkSize,
+	                                           bool snapshot = false) override;
 
 	void addReadConflictRange(const KeyRangeRef& keys) override;
 	void makeSelfConflicting();
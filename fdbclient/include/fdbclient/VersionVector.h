@@ -46,13 +46,20 @@ struct VersionVector {
 	VersionVector(Version version) : maxVersion(version), cachedEncodedSize(InvalidEncodedSize) {}
 
 private:
-	// Only invoked by getDelta() and applyDelta(), where tag has been validated
+	// Only invoked by applyDelta(), where tag has been validated
 	// and version is guaranteed to be larger than the existing value.
 	inline void setVersionNoCheck(const Tag& tag, Version version) {
 		versions[tag] = version;
 		invalidateCachedEncodedSize();
 	}
 
+	// Only invoked by getDelta(), which visits tags in order, so every entry goes at the end of the flat map
+	// instead of being searched for and shifted into place.
+	inline void appendVersionNoCheck(const Tag& tag, Version version) {
+		versions.emplace_hint(versions.end(), tag, version);
+		invalidateCachedEncodedSize();
+	}
+
 	inline void invalidateCachedEncodedSize() { cachedEncodedSize = InvalidEncodedSize; }
 
 	// Encoded version vector size. Introduced to help speed up serialization.
@@ -129,7 +136,7 @@ public:
 		} else {
 			for (const auto& [tag, version] : versions) {
 				if (version > refVersion) {
-					delta.setVersionNoCheck(tag, version);
+					delta.appendVersionNoCheck(tag, version);
 				}
 			}
 			delta.maxVersion = maxVersion;
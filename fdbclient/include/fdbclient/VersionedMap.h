@@ -172,42 +172,52 @@ static Reference<PTree<T>> update(Reference<PTree<T>> const& node,
 	}
 }
 
+// Searches load one node per level and the comparison at each node usually misses the cache on the key as well, so
+// fetch the children while the key of the current node is compared. Prefetching a null pointer is harmless.
+template <class T>
+inline void prefetchChildren(const PTree<T>* p) {
+	_mm_prefetch((const char*)p->pointer[0].getPtr(), _MM_HINT_T0);
+	_mm_prefetch((const char*)p->pointer[1].getPtr(), _MM_HINT_T0);
+	_mm_prefetch((const char*)p->pointer[2].getPtr(), _MM_HINT_T0);
+}
+
 template <class T, class X>
-bool contains(const Reference<PTree<T>>& p, Version at, const X& x) {
-	if (!p)
-		return false;
-	int cmp = compare(x, p->data);
-	bool less = cmp < 0;
-	if (cmp == 0)
-		return true;
-	return contains(p->child(!less, at), at, x);
+bool contains(const Reference<PTree<T>>& root, Version at, const X& x) {
+	for (const PTree<T>* p = root.getPtr(); p;) {
+		prefetchChildren(p);
+		int cmp = compare(x, p->data);
+		if (cmp == 0)
+			return true;
+		p = p->child(!(cmp < 0), at).getPtr();
+	}
+	return false;
 }
 
 // TODO: Remove the number of invocations of operator<, and replace with something closer to memcmp.
 // and same for upper_bound.
 template <class T, class X>
-void lower_bound(const Reference<PTree<T>>& p, Version at, const X& x, PTreeFinger<T>& f) {
-	if (!p) {
-		f.trim_to_bound();
-		return;
+void lower_bound(const Reference<PTree<T>>& root, Version at, const X& x, PTreeFinger<T>& f) {
+	for (const PTree<T>* p = root.getPtr(); p;) {
+		prefetchChildren(p);
+		int cmp = compare(x, p->data);
+		bool less = cmp < 0;
+		f.push_for_bound(p, less);
+		if (cmp == 0)
+			return;
+		p = p->child(!less, at).getPtr();
 	}
-	int cmp = compare(x, p->data);
-	bool less = cmp < 0;
-	f.push_for_bound(p.getPtr(), less);
-	if (cmp == 0)
-		return;
-	lower_bound(p->child(!less, at), at, x, f);
+	f.trim_to_bound();
 }
 
 template <class T, class X>
-void upper_bound(const Reference<PTree<T>>& p, Version at, const X& x, PTreeFinger<T>& f) {
-	if (!p) {
-		f.trim_to_bound();
-		return;
-	}
-	bool less = x < p->data;
-	f.push_for_bound(p.getPtr(), less);
-	upper_bound(p->child(!less, at), at, x, f);
+void upper_bound(const Reference<PTree<T>>& root, Version at, const X& x, PTreeFinger<T>& f) {
+	for (const PTree<T>* p = root.getPtr(); p;) {
+		prefetchChildren(p);
+		bool less = x < p->data;
+		f.push_for_bound(p, less);
+		p = p->child(!less, at).getPtr();
+	}
+	f.trim_to_bound();
 }
 
 template <class T, bool forward>
@@ -318,11 +328,10 @@ Reference<PTree<T>> lastNode(const Reference<PTree<T>>& p, Version at) {
 }
 
 template <class T, bool last>
-void firstOrLastFinger(const Reference<PTree<T>>& p, Version at, PTreeFinger<T>& f) {
-	if (!p)
-		return;
-	f.push_back(p.getPtr());
-	firstOrLastFinger<T, last>(p->child(last, at), at, f);
+void firstOrLastFinger(const Reference<PTree<T>>& root, Version at, PTreeFinger<T>& f) {
+	for (const PTree<T>* p = root.getPtr(); p; p = p->child(last, at).getPtr()) {
+		f.push_back(p);
+	}
 }
 
 template <class T>
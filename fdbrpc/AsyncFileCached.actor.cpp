@@ -20,6 +20,8 @@
 
 #include "fdbrpc/AsyncFileCached.actor.h"
 
+#include <algorithm>
+
 // Page caches used in non-simulated environments
 Optional<Reference<EvictablePageCache>> pc4k, pc64k;
 
@@ -60,8 +62,9 @@ Future<Reference<IAsyncFile>> AsyncFileCached::open_impl(std::string filename, i
 			int64_t pageCacheSize4k = (BUGGIFY) ? FLOW_KNOBS->BUGGIFY_SIM_PAGE_CACHE_4K : FLOW_KNOBS->SIM_PAGE_CACHE_4K;
 			int64_t pageCacheSize64k =
 			    (BUGGIFY) ? FLOW_KNOBS->BUGGIFY_SIM_PAGE_CACHE_64K : FLOW_KNOBS->SIM_PAGE_CACHE_64K;
-			auto caches = std::make_pair(makeReference<EvictablePageCache>(4096, pageCacheSize4k),
-			                             makeReference<EvictablePageCache>(65536, pageCacheSize64k));
+			auto caches =
+			    std::make_pair(makeReference<EvictablePageCache>(4096, pageCacheSize4k, PageCacheBudget::get()),
+			                   makeReference<EvictablePageCache>(65536, pageCacheSize64k));
 			simulatorPageCaches[g_network->getLocalAddress()] = caches;
 			pageCache = (flags & IAsyncFile::OPEN_LARGE_PAGES) ? caches.second : caches.first;
 		} else
@@ -73,7 +76,7 @@ Future<Reference<IAsyncFile>> AsyncFileCached::open_impl(std::string filename, i
 			pageCache = pc64k.get();
 		} else {
 			if (!pc4k.present())
-				pc4k = makeReference<EvictablePageCache>(4096, FLOW_KNOBS->PAGE_CACHE_4K);
+				pc4k = makeReference<EvictablePageCache>(4096, FLOW_KNOBS->PAGE_CACHE_4K, PageCacheBudget::get());
 			pageCache = pc4k.get();
 		}
 	}
@@ -254,6 +257,13 @@ Future<Void> AsyncFileCached::flush() {
 
 	std::vector<Future<Void>> unflushed;
 
+	// Issue the page writes in file order rather than the order the pages were dirtied in, so that the kernel and the
+	// disk see adjacent pages together and can merge and schedule them.
+	std::sort(flushable.begin(), flushable.end(), [](AFCPage* a, AFCPage* b) { return a->pageOffset < b->pageOffset; });
+	for (int i = 0; i < flushable.size(); i++) {
+		flushable[i]->flushableIndex = i;
+	}
+
 	int debug_count = flushable.size();
 	for (int i = 0; i < flushable.size();) {
 		auto p = flushable[i];
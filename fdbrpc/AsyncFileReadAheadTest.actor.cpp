@@ -0,0 +1,171 @@
+/*
+ * AsyncFileReadAheadTest.actor.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2025 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "fdbrpc/AsyncFileReadAhead.actor.h"
+#include "flow/UnitTest.h"
+#include "flow/actorcompiler.h" // This must be the last #include.
+
+void forceLinkAsyncFileReadAheadTests() {}
+
+namespace {
+
+// A file whose reads only complete when the test completes them, recording the offset of every read it is asked for.
+// Each byte read is the number of the block it is in.
+class MockReadFile final : public IAsyncFile, public ReferenceCounted<MockReadFile> {
+public:
+	MockReadFile(int blockSize, int64_t fileSize) : blockSize(blockSize), fileSize(fileSize) {}
+
+	void addref() override { ReferenceCounted<MockReadFile>::addref(); }
+	void delref() override { ReferenceCounted<MockReadFile>::delref(); }
+
+	Future<int> read(void* data, int length, int64_t offset) override {
+		int len = std::min<int64_t>(length, fileSize - offset);
+		memset(data, offset / blockSize, len);
+		reads.push_back(offset);
+		pending[offset] = std::make_pair(Promise<int>(), len);
+		return pending[offset].first.getFuture();
+	}
+
+	// Completes the read of the block at offset, which must have been started
+	void complete(int64_t offset) {
+		auto i = pending.find(offset);
+		ASSERT(i != pending.end());
+		Promise<int> p = i->second.first;
+		int len = i->second.second;
+		pending.erase(i);
+		p.send(len);
+	}
+
+	void completeAll() {
+		while (!pending.empty()) {
+			complete(pending.begin()->first);
+		}
+	}
+
+	// The blocks the file has been asked to read since the given number of reads
+	std::set<int> blocksReadSince(int readCount) const {
+		std::set<int> blocks;
+		for (int i = readCount; i < reads.size(); i++) {
+			blocks.insert(reads[i] / blockSize);
+		}
+		return blocks;
+	}
+
+	Future<Void> write(void const* data, int length, int64_t offset) override { throw file_not_writable(); }
+	Future<Void> truncate(int64_t size) override { throw file_not_writable(); }
+	Future<Void> sync() override { return Void(); }
+	Future<int64_t> size() const override { return fileSize; }
+	std::string getFilename() const override { return "MockReadFile"; }
+	int64_t debugFD() const override { return -1; }
+
+	int blockSize;
+	int64_t fileSize;
+	std::vector<int64_t> reads;
+	std::map<int64_t, std::pair<Promise<int>, int>> pending;
+};
+
+// Reads a block sized range at the start of the given block, completing every read the mock file is asked for
+ACTOR Future<Void> readBlockAt(Reference<AsyncFileReadAheadCache> f, Reference<MockReadFile> file, int blockNum) {
+	state std::vector<uint8_t> buf(file->blockSize);
+	state Future<int> r = f->read(buf.data(), file->blockSize, (int64_t)blockNum * file->blockSize);
+	file->completeAll();
+	int len = wait(r);
+	ASSERT_EQ(len, file->blockSize);
+	ASSERT_EQ(buf[0], blockNum);
+	return Void();
+}
+
+} // namespace
+
+TEST_CASE("/fdbrpc/AsyncFileReadAhead/Window") {
+	state int blockSize = 100;
+	state Reference<MockReadFile> file = makeReference<MockReadFile>(blockSize, 100 * blockSize);
+	state Reference<AsyncFileReadAheadCache> f = makeReference<AsyncFileReadAheadCache>(file, blockSize, 8, 100, 100);
+	state int readCount;
+
+	// A read which does not continue the last one closes the window, so only the block it needs is read
+	readCount = file->reads.size();
+	wait(readBlockAt(f, file, 50));
+	ASSERT_EQ(f->m_read_ahead_window, 0);
+	ASSERT(file->blocksReadSince(readCount) == std::set<int>({ 50 }));
+
+	// Sequential reads double the window up to the configured number of read ahead blocks
+	readCount = file->reads.size();
+	wait(readBlockAt(f, file, 51));
+	ASSERT_EQ(f->m_read_ahead_window, 1);
+	ASSERT(file->blocksReadSince(readCount) == std::set<int>({ 51, 52 }));
+
+	readCount = file->reads.size();
+	wait(readBlockAt(f, file, 52));
+	ASSERT_EQ(f->m_read_ahead_window, 2);
+	ASSERT(file->blocksReadSince(readCount) == std::set<int>({ 53, 54 }));
+
+	readCount = file->reads.size();
+	wait(readBlockAt(f, file, 53));
+	ASSERT_EQ(f->m_read_ahead_window, 4);
+	ASSERT(file->blocksReadSince(readCount) == std::set<int>({ 55, 56, 57 }));
+
+	readCount = file->reads.size();
+	wait(readBlockAt(f, file, 54));
+	ASSERT_EQ(f->m_read_ahead_window, 8);
+	ASSERT(file->blocksReadSince(readCount) == std::set<int>({ 58, 59, 60, 61, 62 }));
+
+	readCount = file->reads.size();
+	wait(readBlockAt(f, file, 55));
+	ASSERT_EQ(f->m_read_ahead_window, 8);
+	ASSERT(file->blocksReadSince(readCount) == std::set<int>({ 63 }));
+
+	// A random read closes the window again
+	readCount = file->reads.size();
+	wait(readBlockAt(f, file, 10));
+	ASSERT_EQ(f->m_read_ahead_window, 0);
+	ASSERT(file->blocksReadSince(readCount) == std::set<int>({ 10 }));
+
+	return Void();
+}
+
+TEST_CASE("/fdbrpc/AsyncFileReadAhead/KeepInFlightBlocks") {
+	state int blockSize = 100;
+	state Reference<MockReadFile> file = makeReference<MockReadFile>(blockSize, 100 * blockSize);
+	state Reference<AsyncFileReadAheadCache> f = makeReference<AsyncFileReadAheadCache>(file, blockSize, 8, 100, 1);
+	state std::vector<uint8_t> buf(blockSize);
+	state int readCount;
+
+	wait(readBlockAt(f, file, 50));
+	wait(readBlockAt(f, file, 10));
+
+	// Read block 11 with the read ahead of block 12 left in flight. The cache is over its limit afterwards, and the
+	// ready block 50 is evicted rather than block 12, which comes first but is still being read.
+	readCount = file->reads.size();
+	state Future<int> r = f->read(buf.data(), blockSize, 11 * blockSize);
+	ASSERT(file->blocksReadSince(readCount) == std::set<int>({ 11, 12 }));
+	file->complete(11 * blockSize);
+	wait(success(r));
+	ASSERT_EQ(r.get(), blockSize);
+	ASSERT_EQ(f->m_blocks.size(), 1);
+	ASSERT(f->m_blocks.count(12) && !f->m_blocks[12].isReady());
+
+	// The next read uses the block read ahead instead of reading it again
+	readCount = file->reads.size();
+	wait(readBlockAt(f, file, 12));
+	ASSERT(file->blocksReadSince(readCount) == std::set<int>({ 13, 14 }));
+
+	return Void();
+}
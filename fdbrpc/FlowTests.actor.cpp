@@ -31,6 +31,7 @@
 #include "flow/WriteOnlySet.h"
 #include "fdbrpc/fdbrpc.h"
 #include "flow/IAsyncFile.h"
+#include "flow/PriorityMultiLock.actor.h"
 #include "flow/TLSConfig.actor.h"
 #include "fdbrpc/grpc/AsyncTaskExecutor.h"
 #include "flow/actorcompiler.h" // This must be the last #include.
@@ -1615,6 +1616,63 @@ TEST_CASE("/flow/flow/FlowMutex") {
 	return Void();
 }
 
+ACTOR static Future<Void> fairQueueingWaiter(Reference<PriorityMultiLock> pml,
+                                              uint64_t flow,
+                                              double cost,
+                                              int index,
+                                              std::vector<std::pair<uint64_t, int>>* grants) {
+	PriorityMultiLock::Lock lock = wait(pml->lock(0, flow, cost));
+	grants->emplace_back(flow, index);
+	return Void();
+}
+
+TEST_CASE("/flow/flow/PriorityMultiLock/fairQueueing") {
+	state Reference<PriorityMultiLock> pml = makeReference<PriorityMultiLock>(1, "1");
+	state PriorityMultiLock::Lock held = wait(pml->lock(0));
+	state std::vector<std::pair<uint64_t, int>> grants;
+	state std::vector<Future<Void>> waiters;
+
+	// Flow 1 queues all its waiters first, and flow 3 is charged twice as much as flow 2 for each of its waiters
+	for (int i = 0; i < 100; ++i) {
+		waiters.push_back(fairQueueingWaiter(pml, 1, 1.0, i, &grants));
+	}
+	for (int i = 0; i < 10; ++i) {
+		waiters.push_back(fairQueueingWaiter(pml, 2, 1.0, i, &grants));
+	}
+	for (int i = 0; i < 10; ++i) {
+		waiters.push_back(fairQueueingWaiter(pml, 3, 2.0, i, &grants));
+	}
+	ASSERT_EQ(pml->getWaitersCount(0), 120);
+
+	held.release();
+	wait(waitForAll(waiters));
+	ASSERT_EQ(grants.size(), 120);
+
+	std::map<uint64_t, int> granted;
+	std::map<uint64_t, int> lastGrant;
+	for (int i = 0; i < grants.size(); ++i) {
+		uint64_t flow = grants[i].first;
+		// Waiters of a flow are granted locks in the order they queued
+		ASSERT_EQ(grants[i].second, granted[flow]);
+		++granted[flow];
+		lastGrant[flow] = i;
+
+		// Up to a finish time of 10, flows 1 and 2 have each been granted 10 locks and flow 3, at twice the cost, 5
+		if (i == 24) {
+			ASSERT_EQ(granted[1], 10);
+			ASSERT_EQ(granted[2], 10);
+			ASSERT_EQ(granted[3], 5);
+		}
+	}
+
+	// Flows 2 and 3 are not starved by the waiters flow 1 queued ahead of them
+	ASSERT_LT(lastGrant[2], 25);
+	ASSERT_LT(lastGrant[3], 40);
+	ASSERT_EQ(lastGrant[1], 119);
+
+	return Void();
+}
+
 using namespace std::chrono_literals;
 
 TEST_CASE("/flow/thread/ThreadReturnPromiseStream_Simple") {
@@ -43,6 +43,7 @@
 #include "fdbrpc/IPAllowList.h"
 #include "fdbrpc/simulator.h"
 #include "flow/ActorCollection.h"
+#include "flow/CompressionUtils.h"
 #include "flow/Error.h"
 #include "flow/flow.h"
 #include "flow/Net2Packet.h"
@@ -81,6 +82,10 @@ Future<Void> g_currentDeliveryPeerDisconnect;
 // messages as "messages".
 constexpr int PACKET_LEN_WIDTH = sizeof(uint32_t);
 
+// Set in the length of a packet whose message, everything after the endpoint token, is zstd compressed. Such packets
+// are only sent to processes whose ConnectPacket has FLAG_COMPRESSION. PACKET_LIMIT keeps the bit clear otherwise.
+constexpr uint32_t COMPRESSED_PACKET_FLAG = 1u << 31;
+
 // FIXME: explain what this is for
 const uint64_t TOKEN_STREAM_FLAG = 1;
 
@@ -111,6 +116,9 @@ private:
 		NetworkMessageReceiver* receiver = nullptr;
 		Endpoint::Token& token() { return *(Endpoint::Token*)uid; }
 	};
+	// Every lookup is a single index into data[] by the low 32 bits of the token, followed by a check of the rest of
+	// the token, which rejects tokens whose slot has since been reused
+	Entry* find(Endpoint::Token const& token);
 	int wellKnownEndpointCount;
 	std::vector<Entry> data;
 	uint32_t firstFree;
@@ -189,7 +197,23 @@ const Endpoint& EndpointMap::insert(NetworkAddressList localAddresses,
 	return streams[0].first->getEndpoint(TaskPriority::DefaultEndpoint);
 }
 
+EndpointMap::Entry* EndpointMap::find(Endpoint::Token const& token) {
+	uint32_t index = token.second();
+	if (index < data.size()) {
+		Entry& entry = data[index];
+		if (entry.token().first() == token.first() &&
+		    ((entry.token().second() & 0xffffffff00000000LL) | index) == token.second()) {
+			return &entry;
+		}
+	}
+	return nullptr;
+}
+
 NetworkMessageReceiver* EndpointMap::get(Endpoint::Token const& token) {
+	Entry* entry = find(token);
+	if (entry && entry->receiver) {
+		return entry->receiver;
+	}
 	uint32_t index = token.second();
 	if (index < wellKnownEndpointCount && data[index].receiver == nullptr) {
 		TraceEvent(SevWarnAlways, "WellKnownEndpointNotAdded")
@@ -197,17 +221,13 @@ NetworkMessageReceiver* EndpointMap::get(Endpoint::Token const& token) {
 		    .detail("Index", index)
 		    .backtrace();
 	}
-	if (index < data.size() && data[index].token().first() == token.first() &&
-	    ((data[index].token().second() & 0xffffffff00000000LL) | index) == token.second())
-		return data[index].receiver;
-	return 0;
+	return nullptr;
 }
 
 TaskPriority EndpointMap::getPriority(Endpoint::Token const& token) {
-	uint32_t index = token.second();
-	if (index < data.size() && data[index].token().first() == token.first() &&
-	    ((data[index].token().second() & 0xffffffff00000000LL) | index) == token.second()) {
-		auto res = static_cast<TaskPriority>(data[index].token().second());
+	Entry* entry = find(token);
+	if (entry) {
+		auto res = static_cast<TaskPriority>(entry->token().second());
 		// we don't allow this priority to be "misused" for other stuff as we won't even
 		// attempt to find an endpoint if UnknownEndpoint is returned here
 		ASSERT(res != TaskPriority::UnknownEndpoint);
@@ -220,11 +240,12 @@ void EndpointMap::remove(Endpoint::Token const& token, NetworkMessageReceiver* r
 	uint32_t index = token.second();
 	if (index < wellKnownEndpointCount) {
 		data[index].receiver = nullptr;
-	} else if (index < data.size() && data[index].token().first() == token.first() &&
-	           ((data[index].token().second() & 0xffffffff00000000LL) | index) == token.second() &&
-	           data[index].receiver == r) {
-		data[index].receiver = 0;
-		data[index].nextFree = firstFree;
+		return;
+	}
+	Entry* entry = find(token);
+	if (entry && entry->receiver == r) {
+		entry->receiver = 0;
+		entry->nextFree = firstFree;
 		firstFree = index;
 	}
 }
@@ -507,6 +528,8 @@ ACTOR Future<Void> pingLatencyLogger(TransportData* self) {
 				    .detail("Count", peer->pingLatencies.getPopulationSize())
 				    .detail("BytesReceived", peer->bytesReceived - peer->lastLoggedBytesReceived)
 				    .detail("BytesSent", peer->bytesSent - peer->lastLoggedBytesSent)
+				    .detail("PacketsSent", peer->packetsSent - peer->lastLoggedPacketsSent)
+				    .detail("WriteCalls", peer->writeCalls - peer->lastLoggedWriteCalls)
 				    .detail("TimeoutCount", peer->timeoutCount)
 				    .detail("ConnectOutgoingCount", peer->connectOutgoingCount)
 				    .detail("ConnectIncomingCount", peer->connectIncomingCount)
@@ -515,15 +538,23 @@ ACTOR Future<Void> pingLatencyLogger(TransportData* self) {
 				    .detail("ConnectMaxLatency", peer->connectLatencies.max())
 				    .detail("ConnectMeanLatency", peer->connectLatencies.mean())
 				    .detail("ConnectMedianLatency", peer->connectLatencies.median())
-				    .detail("ConnectP90Latency", peer->connectLatencies.percentile(0.90));
+				    .detail("ConnectP90Latency", peer->connectLatencies.percentile(0.90))
+				    .detail("PacketsCompressed", peer->packetsCompressed)
+				    .detail("CompressionBytesSaved", peer->compressionBytesSaved)
+				    .detail("CompressionSeconds", peer->compressionSeconds);
 				peer->lastLoggedTime = now();
 				peer->connectOutgoingCount = 0;
 				peer->connectIncomingCount = 0;
 				peer->connectFailedCount = 0;
 				peer->pingLatencies.clear();
 				peer->connectLatencies.clear();
+				peer->packetsCompressed = 0;
+				peer->compressionBytesSaved = 0;
+				peer->compressionSeconds = 0.0;
 				peer->lastLoggedBytesReceived = peer->bytesReceived;
 				peer->lastLoggedBytesSent = peer->bytesSent;
+				peer->lastLoggedPacketsSent = peer->packetsSent;
+				peer->lastLoggedWriteCalls = peer->writeCalls;
 				peer->timeoutCount = 0;
 				wait(delay(FLOW_KNOBS->PING_LOGGING_INTERVAL));
 			} else if (it == self->orderedAddresses.begin()) {
@@ -564,7 +595,9 @@ struct ConnectPacket {
 	// IP Address to reconnect to the originating process. Only one of these must be populated.
 	uint32_t canonicalRemoteIp4 = 0;
 
-	enum ConnectPacketFlags { FLAG_IPV6 = 1 };
+	// FLAG_COMPRESSION is set by processes which can decompress packets marked with COMPRESSED_PACKET_FLAG. Older
+	// versions ignore it and never set it, so they are never sent compressed packets.
+	enum ConnectPacketFlags { FLAG_IPV6 = 1, FLAG_COMPRESSION = 2 };
 	uint16_t flags = 0;
 	uint8_t canonicalRemoteIp6[16] = { 0 };
 
@@ -592,6 +625,8 @@ struct ConnectPacket {
 
 	bool isIPv6() const { return flags & FLAG_IPV6; }
 
+	bool acceptsCompression() const { return flags & FLAG_COMPRESSION; }
+
 	uint32_t totalPacketSize() const { return connectPacketLength + sizeof(connectPacketLength); }
 
 	template <class Ar>
@@ -742,6 +777,7 @@ ACTOR Future<Void> connectionWriter(Reference<Peer> self, Reference<IConnection>
 			lastWriteTime = now();
 
 			int sent = conn->write(self->unsent.getUnsent(), /* limit= */ FLOW_KNOBS->MAX_PACKET_SEND_BYTES);
+			++self->writeCalls;
 			if (sent) {
 				self->bytesSent += sent;
 				self->transport->bytesSent += sent;
@@ -924,6 +960,7 @@ ACTOR Future<Void> connectionKeeper(Reference<Peer> self,
 			}
 		} catch (Error& e) {
 			self->connected = false;
+			self->compressionAccepted = false;
 			delayedHealthUpdateF.cancel();
 			if (now() - self->lastConnectTime > FLOW_KNOBS->RECONNECTION_RESET_TIME) {
 				self->reconnectionDelay = FLOW_KNOBS->INITIAL_RECONNECTION_TIME;
@@ -1050,14 +1087,17 @@ ACTOR Future<Void> connectionKeeper(Reference<Peer> self,
 }
 
 Peer::Peer(TransportData* transport, NetworkAddress const& destination)
-  : transport(transport), destination(destination), compatible(true), connected(false), outgoingConnectionIdle(true),
+  : transport(transport), destination(destination), compatible(true), connected(false), compressionAccepted(false),
+    outgoingConnectionIdle(true),
     lastConnectTime(0.0), reconnectionDelay(FLOW_KNOBS->INITIAL_RECONNECTION_TIME), peerReferences(-1),
-    bytesReceived(0), bytesSent(0), lastDataPacketSentTime(now()), outstandingReplies(0),
+    bytesReceived(0), bytesSent(0), packetsSent(0), writeCalls(0), lastDataPacketSentTime(now()), outstandingReplies(0),
     pingLatencies(destination.isPublic() ? FLOW_KNOBS->PING_SKETCH_ACCURACY : 0.1), lastLoggedTime(0.0),
-    lastLoggedBytesReceived(0), lastLoggedBytesSent(0), timeoutCount(0),
+    lastLoggedBytesReceived(0), lastLoggedBytesSent(0), lastLoggedPacketsSent(0), lastLoggedWriteCalls(0),
+    timeoutCount(0),
     protocolVersion(Reference<AsyncVar<Optional<ProtocolVersion>>>(new AsyncVar<Optional<ProtocolVersion>>())),
     connectOutgoingCount(0), connectIncomingCount(0), connectFailedCount(0),
-    connectLatencies(destination.isPublic() ? FLOW_KNOBS->PING_SKETCH_ACCURACY : 0.1) {
+    connectLatencies(destination.isPublic() ? FLOW_KNOBS->PING_SKETCH_ACCURACY : 0.1), packetsCompressed(0),
+    compressionBytesSaved(0), compressionSeconds(0.0) {
 	IFailureMonitor::failureMonitor().setStatus(destination, FailureStatus(false));
 }
 
@@ -1088,6 +1128,9 @@ void Peer::prependConnectPacket() {
 	pkt.protocolVersion = g_network->protocolVersion();
 	pkt.protocolVersion.addObjectSerializerFlag();
 	pkt.connectionId = transport->transportId;
+	if (CompressionUtils::supportedFilters.count(CompressionFilter::ZSTD)) {
+		pkt.flags |= ConnectPacket::FLAG_COMPRESSION;
+	}
 
 	PacketBuffer *pb_first = PacketBuffer::create(), *pb_end = nullptr;
 	PacketWriter wr(pb_first, nullptr, Unversioned());
@@ -1209,7 +1252,8 @@ ACTOR static void deliver(TransportData* self,
 			g_currentDeliveryPeerDisconnect = disconnect;
 			StringRef data = reader.arenaReadAll();
 			ASSERT(data.size() > 8);
-			ArenaObjectReader objReader(reader.arena(), reader.arenaReadAll(), AssumeVersion(reader.protocolVersion()));
+			// The message is deserialized in place, so its StringRefs point into the packet's receive buffer
+			ArenaObjectReader objReader(reader.arena(), data, AssumeVersion(reader.protocolVersion()));
 			receiver->receive(objReader);
 			g_currentDeliveryPeerAddress = NetworkAddressList();
 			g_currentDeliverPeerAddressTrusted = false;
@@ -1261,6 +1305,29 @@ ACTOR static void deliver(TransportData* self,
 	}
 }
 
+// Returns the packet with its message decompressed, in a new arena which replaces the given one
+static StringRef decompressPacket(StringRef packet, Arena& arena, NetworkAddress const& peerAddress) {
+	arena = Arena();
+	StringRef message;
+	try {
+		// The limit is checked against the size recorded in the frame, before any memory is allocated for it
+		message = CompressionUtils::decompress(
+		    CompressionFilter::ZSTD, packet.substr(sizeof(UID)), arena, FLOW_KNOBS->PACKET_LIMIT - sizeof(UID));
+	} catch (Error& e) {
+		if (e.code() != error_code_serialization_failed) {
+			throw;
+		}
+		TraceEvent(SevError, "PacketLimitExceeded")
+		    .detail("FromPeer", peerAddress.toString())
+		    .detail("CompressedLength", packet.size());
+		throw platform_error();
+	}
+	uint8_t* result = new (arena) uint8_t[sizeof(UID) + message.size()];
+	memcpy(result, packet.begin(), sizeof(UID));
+	memcpy(result + sizeof(UID), message.begin(), message.size());
+	return StringRef(result, sizeof(UID) + message.size());
+}
+
 static void scanPackets(TransportData* transport,
                         uint8_t*& unprocessed_begin, // FIXME: why isn't this called `start`?
                         const uint8_t* e, // FIXME: why isn't this called `end`?
@@ -1290,6 +1357,8 @@ static void scanPackets(TransportData* transport,
 			break;
 		packetLen = *(uint32_t*)p;
 		p += PACKET_LEN_WIDTH;
+		const bool compressed = packetLen & COMPRESSED_PACKET_FLAG;
+		packetLen &= ~COMPRESSED_PACKET_FLAG;
 
 		// Read checksum if present
 		if (checksumEnabled) {
@@ -1374,7 +1443,12 @@ static void scanPackets(TransportData* transport,
 #endif
 		// remove object serializer flag to account for flat buffer
 		peerProtocolVersion.removeObjectSerializerFlag();
-		ArenaReader reader(arena, StringRef(p, packetLen), AssumeVersion(peerProtocolVersion));
+		Arena packetArena = arena;
+		StringRef packet(p, packetLen);
+		if (compressed) {
+			packet = decompressPacket(packet, packetArena, peerAddress);
+		}
+		ArenaReader reader(packetArena, packet, AssumeVersion(peerProtocolVersion));
 		UID token;
 		reader >> token;
 
@@ -1422,7 +1496,7 @@ static int getNewBufferSize(const uint8_t* begin,
 	if (len < PACKET_LEN_WIDTH) {
 		return FLOW_KNOBS->MIN_PACKET_BUFFER_BYTES;
 	}
-	const uint32_t packetLen = *(uint32_t*)begin;
+	const uint32_t packetLen = *(uint32_t*)begin & ~COMPRESSED_PACKET_FLAG;
 	if (packetLen > FLOW_KNOBS->PACKET_LIMIT) {
 		TraceEvent(SevError, "PacketLimitExceeded")
 		    .detail("FromPeer", peerAddress.toString())
@@ -1586,6 +1660,7 @@ ACTOR static Future<Void> connectionReader(TransportData* transport,
 								incompatiblePeerCounted = true;
 							}
 							ASSERT(pkt.canonicalRemotePort == peerAddress.port);
+							peer->compressionAccepted = pkt.acceptsCompression();
 							onConnected.send(peer);
 						} else {
 							peerProtocolVersion = protocolVersion;
@@ -1598,6 +1673,7 @@ ACTOR static Future<Void> connectionReader(TransportData* transport,
 							}
 							peer = transport->getOrOpenPeer(peerAddress, false);
 							peer->compatible = compatible;
+							peer->compressionAccepted = pkt.acceptsCompression();
 							if (!compatible) {
 								peer->transport->numIncompatibleConnections++;
 								incompatiblePeerCounted = true;
@@ -1972,6 +2048,40 @@ static void sendLocal(TransportData* self, ISerializeSource const& what, const E
 	}
 }
 
+// Serializes the message contiguously and writes it compressed if it is large enough and compression saves space,
+// otherwise as is. Returns whether it was compressed.
+static bool writeCompressedMessage(Peer* peer, ISerializeSource const& what, PacketWriter& wr) {
+	ObjectWriter objectWriter(AssumeVersion(g_network->protocolVersion()));
+	what.serializeObjectWriter(objectWriter);
+	Standalone<StringRef> message = objectWriter.toStringRef();
+	StringRef toWrite = message;
+	Arena compressedArena;
+	if (message.size() >= FLOW_KNOBS->TRANSPORT_COMPRESSION_THRESHOLD) {
+		double start = timer_monotonic();
+		StringRef compressedMessage = CompressionUtils::compress(
+		    CompressionFilter::ZSTD, message, FLOW_KNOBS->TRANSPORT_COMPRESSION_LEVEL, compressedArena);
+		peer->compressionSeconds += timer_monotonic() - start;
+		if (compressedMessage.size() < message.size()) {
+			++peer->packetsCompressed;
+			peer->compressionBytesSaved += message.size() - compressedMessage.size();
+			toWrite = compressedMessage;
+		}
+	}
+
+	uint8_t* out = wr.writeBytes(toWrite.size());
+	memcpy(out, toWrite.begin(), toWrite.size());
+	if (FLOW_KNOBS->WIPE_SENSITIVE_DATA_FROM_PACKET_BUFFER) {
+		// The message may hold sensitive data, which serializePacketWriter would have marked for wiping. Wipe the
+		// whole message instead, and the intermediate copies now.
+		PacketWriter::packetWriterMarkForWipe(out, toWrite.size(), &wr);
+		memset(mutateString(message), 0, message.size());
+		if (toWrite.begin() != message.begin()) {
+			memset(mutateString(toWrite), 0, toWrite.size());
+		}
+	}
+	return toWrite.begin() != message.begin();
+}
+
 static ReliablePacket* sendPacket(TransportData* self,
                                   Reference<Peer> peer,
                                   ISerializeSource const& what,
@@ -2017,7 +2127,14 @@ static ReliablePacket* sendPacket(TransportData* self,
 
 	wr.writeAhead(packetInfoSize, &packetInfoBuffer);
 	wr << destination.token;
-	what.serializePacketWriter(wr);
+	bool compressed = false;
+	// Reliable packets are not compressed, since they are resent on a new connection to a process which may not have
+	// advertised FLAG_COMPRESSION
+	if (!reliable && peer->compressionAccepted && FLOW_KNOBS->TRANSPORT_COMPRESSION_THRESHOLD > 0) {
+		compressed = writeCompressedMessage(peer.getPtr(), what, wr);
+	} else {
+		what.serializePacketWriter(wr);
+	}
 	pb = wr.finish();
 	len = wr.size() - packetInfoSize;
 
@@ -2069,7 +2186,8 @@ static ReliablePacket* sendPacket(TransportData* self,
 	}
 
 	// Write packet length and checksum into packet buffer
-	packetInfoBuffer.write(&len, sizeof(len));
+	const uint32_t lenField = compressed ? len | COMPRESSED_PACKET_FLAG : len;
+	packetInfoBuffer.write(&lenField, sizeof(lenField));
 	if (checksumEnabled) {
 		packetInfoBuffer.write(&checksum, sizeof(checksum), sizeof(len));
 	}
@@ -2099,6 +2217,7 @@ static ReliablePacket* sendPacket(TransportData* self,
 #endif
 
 	peer->send(pb, rp, firstUnsent);
+	++peer->packetsSent;
 	if (destination.token != Endpoint::wellKnownToken(WLTOKEN_PING_PACKET)) {
 		peer->lastDataPacketSentTime = now();
 	}
@@ -41,6 +41,7 @@
 #include "fdbrpc/AsyncFileEncrypted.h"
 #include "fdbrpc/AsyncFileWinASIO.actor.h"
 #include "fdbrpc/AsyncFileKAIO.actor.h"
+#include "fdbrpc/AsyncFileIOUring.actor.h"
 #include "flow/AsioReactor.h"
 #include "flow/Platform.h"
 #include "fdbrpc/AsyncFileWriteChecker.actor.h"
@@ -72,9 +73,14 @@ Future<Reference<class IAsyncFile>> Net2FileSystem::open(const std::string& file
 	// of Kernel AIO. And EIO_USE_ODIRECT can be used to turn on or off O_DIRECT within
 	// EIO.
 	if ((flags & IAsyncFile::OPEN_UNBUFFERED) && !(flags & IAsyncFile::OPEN_NO_AIO) &&
-	    !FLOW_KNOBS->DISABLE_POSIX_KERNEL_AIO)
-		f = AsyncFileKAIO::open(filename, flags, mode, nullptr);
-	else
+	    !FLOW_KNOBS->DISABLE_POSIX_KERNEL_AIO) {
+#ifdef HAVE_ASYNC_FILE_IO_URING
+		if (AsyncFileIOUring::isInitialized())
+			f = AsyncFileIOUring::open(filename, flags, mode, nullptr);
+		else
+#endif
+			f = AsyncFileKAIO::open(filename, flags, mode, nullptr);
+	} else
 #endif
 		f = Net2AsyncFile::open(
 		    filename,
@@ -117,8 +123,17 @@ void Net2FileSystem::newFileSystem(double ioTimeout, const std::string& fileSyst
 Net2FileSystem::Net2FileSystem(double ioTimeout, const std::string& fileSystemPath) {
 	Net2AsyncFile::init();
 #ifdef __linux__
-	if (!FLOW_KNOBS->DISABLE_POSIX_KERNEL_AIO)
-		AsyncFileKAIO::init(Reference<IEventFD>(N2::ASIOReactor::getEventFD()), ioTimeout);
+	if (!FLOW_KNOBS->DISABLE_POSIX_KERNEL_AIO) {
+		// io_uring and kernel AIO share the reactor's eventfd, so only one of them is set up. If io_uring was asked
+		// for but the kernel can't provide it, fall back to kernel AIO.
+		bool useIOUring = false;
+#ifdef HAVE_ASYNC_FILE_IO_URING
+		if (FLOW_KNOBS->USE_IO_URING)
+			useIOUring = AsyncFileIOUring::init(Reference<IEventFD>(N2::ASIOReactor::getEventFD()), ioTimeout);
+#endif
+		if (!useIOUring)
+			AsyncFileKAIO::init(Reference<IEventFD>(N2::ASIOReactor::getEventFD()), ioTimeout);
+	}
 
 	if (fileSystemPath.empty()) {
 		checkFileSystem = false;
@@ -0,0 +1,120 @@
+/*
+ * PageCacheBudget.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2024 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "fdbrpc/PageCacheBudget.h"
+#include "flow/Knobs.h"
+#include "flow/UnitTest.h"
+
+#include <algorithm>
+#include <map>
+
+void PageCacheBudget::remove(Consumer* c) {
+	auto i = std::find(consumers.begin(), consumers.end(), c);
+	if (i != consumers.end()) {
+		consumers.erase(i);
+	}
+}
+
+int64_t PageCacheBudget::bytesUsed() const {
+	int64_t total = 0;
+	for (const Consumer* c : consumers) {
+		total += c->bytesUsed();
+	}
+	return total;
+}
+
+// Trims c by up to bytes and returns the number of bytes it freed
+static int64_t trimBy(PageCacheBudget::Consumer* c, int64_t bytes) {
+	int64_t used = c->bytesUsed();
+	c->trimTo(used - std::min(bytes, used));
+	return used - c->bytesUsed();
+}
+
+void PageCacheBudget::makeRoom(Consumer* requester, int64_t bytes) {
+	int64_t excess = bytesUsed() + bytes - limit;
+	if (excess <= 0) {
+		return;
+	}
+
+	// Reclaim from the largest consumers first, whether or not that is the requester, so that one cache which has
+	// grown large cannot keep the others from growing
+	std::vector<std::pair<int64_t, Consumer*>> bySize;
+	bySize.reserve(consumers.size());
+	for (Consumer* c : consumers) {
+		bySize.emplace_back(c->bytesUsed(), c);
+	}
+	std::stable_sort(bySize.begin(), bySize.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+
+	for (auto& consumer : bySize) {
+		if (excess <= 0) {
+			break;
+		}
+		excess -= trimBy(consumer.second, excess);
+	}
+}
+
+PageCacheBudget* PageCacheBudget::get() {
+	if (!FLOW_KNOBS->PAGE_CACHE_SHARED_BUDGET) {
+		return nullptr;
+	}
+
+	// Budgets are never destroyed because the page caches registered with them can outlive function local statics
+	if (g_network->isSimulated()) {
+		static std::map<NetworkAddress, PageCacheBudget>* simBudgets = new std::map<NetworkAddress, PageCacheBudget>();
+		return &simBudgets->try_emplace(g_network->getLocalAddress(), FLOW_KNOBS->SIM_PAGE_CACHE_4K).first->second;
+	}
+	static PageCacheBudget* budget = new PageCacheBudget(FLOW_KNOBS->PAGE_CACHE_4K);
+	return budget;
+}
+
+TEST_CASE("/fdbrpc/PageCacheBudget/makeRoom") {
+	PageCacheBudget budget(100);
+	int64_t a = 60, b = 30;
+	PageCacheBudget::Consumer ca{ [&]() { return a; }, [&](int64_t target) { a = std::min(a, target); } };
+	// b holds entries that cannot be evicted below 20 bytes
+	PageCacheBudget::Consumer cb{ [&]() { return b; },
+	                              [&](int64_t target) { b = std::min(b, std::max<int64_t>(target, 20)); } };
+	budget.add(&ca);
+	budget.add(&cb);
+	ASSERT_EQ(budget.bytesUsed(), 90);
+
+	// Fits without evicting anything
+	budget.makeRoom(&cb, 10);
+	ASSERT(a == 60 && b == 30);
+
+	// The space is taken from the largest consumer even though it is not the requester
+	budget.makeRoom(&cb, 15);
+	ASSERT(a == 55 && b == 30);
+
+	// What the largest consumer cannot free is taken from the next largest
+	budget.makeRoom(&ca, 100);
+	ASSERT(a == 0 && b == 20);
+
+	// Once every consumer has given up what it can the budget is exceeded
+	a = 60;
+	budget.makeRoom(&cb, 100);
+	ASSERT(a == 0 && b == 20);
+
+	budget.remove(&ca);
+	ASSERT_EQ(budget.bytesUsed(), 20);
+	budget.remove(&cb);
+	ASSERT_EQ(budget.bytesUsed(), 0);
+	return Void();
+}
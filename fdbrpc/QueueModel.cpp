@@ -33,6 +33,22 @@ void QueueModel::endRequest(uint64_t id, double latency, double penalty, double
 		d.latency = std::max(d.latency, latency);
 	}
 
+	if (FLOW_KNOBS->LOAD_BALANCE_TAIL_LATENCY_AWARE) {
+		if (clean) {
+			if (!d.latencySketch.present()) {
+				d.latencySketch = DDSketch<double>(FLOW_KNOBS->LOAD_BALANCE_LATENCY_SKETCH_ACCURACY);
+			}
+			DDSketch<double>& sketch = d.latencySketch.get();
+			sketch.addSample(latency);
+			if (sketch.getPopulationSize() >= FLOW_KNOBS->LOAD_BALANCE_TAIL_LATENCY_SAMPLES) {
+				d.tailLatency = sketch.percentile(FLOW_KNOBS->LOAD_BALANCE_TAIL_LATENCY_PERCENTILE);
+				sketch.clear();
+			}
+		} else {
+			d.tailLatency = std::max(d.tailLatency, latency);
+		}
+	}
+
 	if (futureVersion) {
 		if (now() > d.increaseBackoffTime) {
 			d.futureVersionBackoff = std::min(d.futureVersionBackoff * FLOW_KNOBS->FUTURE_VERSION_BACKOFF_GROWTH,
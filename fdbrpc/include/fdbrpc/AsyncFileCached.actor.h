@@ -36,6 +36,7 @@
 #include "flow/Knobs.h"
 #include "flow/TDMetric.actor.h"
 #include "flow/network.h"
+#include "fdbrpc/PageCacheBudget.h"
 #include "flow/actorcompiler.h" // This must be the last #include.
 
 namespace bi = boost::intrusive;
@@ -70,15 +71,36 @@ struct EvictablePageCache : ReferenceCounted<EvictablePageCache> {
 
 	EvictablePageCache() : pageSize(0), maxPages(0), cacheEvictionType(RANDOM) {}
 
-	explicit EvictablePageCache(int pageSize, int64_t maxSize)
+	// If budget is given then the cache's size is bounded by the budget, which it shares with other page caches,
+	// instead of by maxSize.
+	explicit EvictablePageCache(int pageSize, int64_t maxSize, PageCacheBudget* budget = nullptr)
 	  : pageSize(pageSize), maxPages(maxSize / pageSize),
-	    cacheEvictionType(evictionPolicyStringToEnum(FLOW_KNOBS->CACHE_EVICTION_POLICY)) {
+	    cacheEvictionType(evictionPolicyStringToEnum(FLOW_KNOBS->CACHE_EVICTION_POLICY)), budget(budget) {
 		cacheEvictions.init("EvictablePageCache.CacheEvictions"_sr);
+		if (budget != nullptr) {
+			budgetConsumer.bytesUsed = [this]() { return bytesUsed(); };
+			budgetConsumer.trimTo = [this](int64_t target) { evictTo(target); };
+			budget->add(&budgetConsumer);
+		}
+	}
+
+	~EvictablePageCache() {
+		if (budget != nullptr) {
+			budget->remove(&budgetConsumer);
+		}
+	}
+
+	int64_t bytesUsed() const {
+		return (int64_t)(RANDOM == cacheEvictionType ? pages.size() : lruPages.size()) * pageSize;
 	}
 
 	void allocate(EvictablePage* page) {
-		try_evict();
-		try_evict();
+		if (budget != nullptr) {
+			budget->makeRoom(&budgetConsumer, pageSize);
+		} else {
+			try_evict();
+			try_evict();
+		}
 
 		page->data = allocateFast4kAligned(pageSize);
 
@@ -99,31 +121,41 @@ struct EvictablePageCache : ReferenceCounted<EvictablePageCache> {
 	}
 
 	void try_evict() {
+		if ((RANDOM == cacheEvictionType ? pages.size() : lruPages.size()) >= (uint64_t)maxPages) {
+			evictOne();
+		}
+	}
+
+	// Evicts pages until the cache holds at most target bytes or no more pages can be evicted right now
+	void evictTo(int64_t target) {
+		while (bytesUsed() > target && evictOne()) {
+		}
+	}
+
+	// Returns true if a page was evicted.  If we don't manage to evict anything within MAX_EVICT_ATTEMPTS then the
+	// caller just goes ahead and exceeds the cache limit.
+	bool evictOne() {
 		if (RANDOM == cacheEvictionType) {
-			if (pages.size() >= (uint64_t)maxPages && !pages.empty()) {
-				for (int i = 0; i < FLOW_KNOBS->MAX_EVICT_ATTEMPTS;
-				     i++) { // If we don't manage to evict anything, just go ahead and exceed the cache limit
-					int toEvict = deterministicRandom()->randomInt(0, pages.size());
-					if (pages[toEvict]->evict()) {
-						++cacheEvictions;
-						break;
-					}
+			for (int i = 0; i < FLOW_KNOBS->MAX_EVICT_ATTEMPTS && !pages.empty(); i++) {
+				int toEvict = deterministicRandom()->randomInt(0, pages.size());
+				if (pages[toEvict]->evict()) {
+					++cacheEvictions;
+					return true;
 				}
 			}
 		} else {
 			// For now, LRU is the only other CACHE_EVICTION option
-			if (lruPages.size() >= (uint64_t)maxPages) {
-				int i = 0;
-				// try the least recently used pages first (starting at head of the LRU list)
-				for (List::iterator it = lruPages.begin(); it != lruPages.end() && i < FLOW_KNOBS->MAX_EVICT_ATTEMPTS;
-				     ++it, ++i) { // If we don't manage to evict anything, just go ahead and exceed the cache limit
-					if (it->evict()) {
-						++cacheEvictions;
-						break;
-					}
+			int i = 0;
+			// try the least recently used pages first (starting at head of the LRU list)
+			for (List::iterator it = lruPages.begin(); it != lruPages.end() && i < FLOW_KNOBS->MAX_EVICT_ATTEMPTS;
+			     ++it, ++i) {
+				if (it->evict()) {
+					++cacheEvictions;
+					return true;
 				}
 			}
 		}
+		return false;
 	}
 
 	std::vector<EvictablePage*> pages;
@@ -132,6 +164,8 @@ struct EvictablePageCache : ReferenceCounted<EvictablePageCache> {
 	int64_t maxPages;
 	Int64MetricHandle cacheEvictions;
 	const CacheEvictionType cacheEvictionType;
+	PageCacheBudget* budget;
+	PageCacheBudget::Consumer budgetConsumer;
 };
 
 struct AFCPage;
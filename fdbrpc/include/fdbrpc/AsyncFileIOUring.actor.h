@@ -0,0 +1,874 @@
+/*
+ * AsyncFileIOUring.actor.h
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2025 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+
+// When actually compiled (NO_INTELLISENSE), include the generated version of this file.  In intellisense use the source
+// version.
+#if defined(NO_INTELLISENSE) && !defined(FLOW_ASYNCFILEIOURING_ACTOR_G_H)
+#define FLOW_ASYNCFILEIOURING_ACTOR_G_H
+#include "fdbrpc/AsyncFileIOUring.actor.g.h"
+#elif !defined(FLOW_ASYNCFILEIOURING_ACTOR_H)
+#define FLOW_ASYNCFILEIOURING_ACTOR_H
+
+#define HAVE_ASYNC_FILE_IO_URING 1
+
+#include "flow/IAsyncFile.h"
+
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include "fdbrpc/AsyncFileEIO.actor.h"
+#include "flow/Knobs.h"
+#include "fdbrpc/Stats.h"
+#include "flow/UnitTest.h"
+#include "flow/genericactors.actor.h"
+#include "flow/actorcompiler.h" // This must be the last #include.
+
+// The io_uring system call numbers are the same on every architecture we build for, but older C libraries do not
+// define them.
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup 425
+#endif
+#ifndef __NR_io_uring_enter
+#define __NR_io_uring_enter 426
+#endif
+#ifndef __NR_io_uring_register
+#define __NR_io_uring_register 427
+#endif
+
+// An IAsyncFile for unbuffered (O_DIRECT) files that drives a single io_uring per process. Operations are queued by
+// priority like AsyncFileKAIO and pushed into the submission ring from the Net2 run loop, so one io_uring_enter()
+// submits everything queued during a loop iteration. Completions are reaped straight from the shared completion
+// ring on every loop iteration and whenever the ring's eventfd fires, without a system call per completion.
+// Buffers registered with registerBuffers() are read and written with the fixed-buffer operations, which saves the
+// kernel from pinning the pages on every request.
+class AsyncFileIOUring final : public IAsyncFile, public ReferenceCounted<AsyncFileIOUring> {
+public:
+	virtual StringRef getClassName() override { return "AsyncFileIOUring"_sr; }
+
+	struct AsyncFileIOUringMetrics {
+		LatencySample readLatencySample = { "AsyncFileIOUringReadLatency",
+			                                UID(),
+			                                FLOW_KNOBS->KAIO_LATENCY_LOGGING_INTERVAL,
+			                                FLOW_KNOBS->KAIO_LATENCY_SKETCH_ACCURACY };
+		LatencySample writeLatencySample = { "AsyncFileIOUringWriteLatency",
+			                                 UID(),
+			                                 FLOW_KNOBS->KAIO_LATENCY_LOGGING_INTERVAL,
+			                                 FLOW_KNOBS->KAIO_LATENCY_SKETCH_ACCURACY };
+		LatencySample syncLatencySample = { "AsyncFileIOUringSyncLatency",
+			                                UID(),
+			                                FLOW_KNOBS->KAIO_LATENCY_LOGGING_INTERVAL,
+			                                FLOW_KNOBS->KAIO_LATENCY_SKETCH_ACCURACY };
+	};
+
+	static AsyncFileIOUringMetrics& getMetrics() {
+		static AsyncFileIOUringMetrics metrics;
+		return metrics;
+	}
+
+	static Future<Reference<IAsyncFile>> open(std::string filename, int flags, int mode, void* ignore) {
+		ASSERT(isInitialized());
+		ASSERT(flags & OPEN_UNBUFFERED);
+
+		if (flags & OPEN_LOCK)
+			mode |= 02000; // Enable mandatory locking for this file if it is supported by the filesystem
+
+		std::string open_filename = filename;
+		if (flags & OPEN_ATOMIC_WRITE_AND_CREATE) {
+			ASSERT((flags & OPEN_CREATE) && (flags & OPEN_READWRITE) && !(flags & OPEN_EXCLUSIVE));
+			open_filename = filename + ".part";
+		}
+
+		int fd = ::open(open_filename.c_str(), openFlags(flags), mode);
+		if (fd < 0) {
+			Error e = errno == ENOENT ? file_not_found() : io_error();
+			TraceEvent("AsyncFileIOUringOpenFailed")
+			    .error(e)
+			    .detail("Filename", filename)
+			    .detailf("Flags", "%x", flags)
+			    .detailf("OSFlags", "%x", openFlags(flags))
+			    .detailf("Mode", "0%o", mode)
+			    .GetLastError();
+			return e;
+		} else {
+			TraceEvent("AsyncFileIOUringOpen")
+			    .detail("Filename", filename)
+			    .detail("Flags", flags)
+			    .detail("Mode", mode)
+			    .detail("Fd", fd);
+		}
+
+		Reference<AsyncFileIOUring> r(new AsyncFileIOUring(fd, flags, filename));
+
+		if (flags & OPEN_LOCK) {
+			// Acquire a "write" lock for the entire file
+			flock lockDesc;
+			lockDesc.l_type = F_WRLCK;
+			lockDesc.l_whence = SEEK_SET;
+			lockDesc.l_start = 0;
+			lockDesc.l_len = 0; // Lock all bytes from l_start through to the end of file, no matter how large it grows
+			lockDesc.l_pid = 0;
+			if (fcntl(fd, F_SETLK, &lockDesc) == -1) {
+				TraceEvent(SevWarn, "UnableToLockFile").detail("Filename", filename).GetLastError();
+				return lock_file_failure();
+			}
+		}
+
+		struct stat buf;
+		if (fstat(fd, &buf)) {
+			TraceEvent("AsyncFileIOUringFStatError").detail("Fd", fd).detail("Filename", filename).GetLastError();
+			return io_error();
+		}
+
+		r->lastFileSize = r->nextFileSize = buf.st_size;
+		return Reference<IAsyncFile>(std::move(r));
+	}
+
+	// Sets up the process-wide ring. Returns false, leaving the caller to fall back to another implementation, if
+	// the kernel does not support io_uring. Must be called before the network starts running, since the run loop
+	// only picks up its per-iteration hook once; any hook installed earlier (e.g. AsyncFileKAIO's) keeps running.
+	static bool init(Reference<IEventFD> ev, double ioTimeout) {
+		ASSERT(!isInitialized());
+
+		io_uring_params params;
+		memset(&params, 0, sizeof(params));
+		if (FLOW_KNOBS->IO_URING_SQPOLL) {
+			params.flags |= IORING_SETUP_SQPOLL;
+			params.sq_thread_idle = FLOW_KNOBS->IO_URING_SQPOLL_IDLE_MS;
+		}
+		int fd = syscall(__NR_io_uring_setup, FLOW_KNOBS->IO_URING_ENTRIES, &params);
+		if (fd < 0) {
+			TraceEvent(SevWarnAlways, "AsyncFileIOUringSetupError")
+			    .detail("Entries", FLOW_KNOBS->IO_URING_ENTRIES)
+			    .detail("SQPoll", FLOW_KNOBS->IO_URING_SQPOLL)
+			    .GetLastError();
+			return false;
+		}
+#ifdef IORING_FEAT_RW_CUR_POS
+		// IORING_OP_READ and IORING_OP_WRITE arrived in the same kernel release as this feature bit.
+		if (!(params.features & IORING_FEAT_RW_CUR_POS)) {
+			TraceEvent(SevWarnAlways, "AsyncFileIOUringUnsupportedKernel").detail("Features", params.features);
+			::close(fd);
+			return false;
+		}
+#endif
+		if (!ctx.ring.map(fd, params)) {
+			TraceEvent(SevWarnAlways, "AsyncFileIOUringMmapError").GetLastError();
+			ctx.ring.unmap();
+			::close(fd);
+			return false;
+		}
+		ctx.sqPoll = params.flags & IORING_SETUP_SQPOLL;
+
+		int evfd = ev->getFD();
+		if (syscall(__NR_io_uring_register, fd, IORING_REGISTER_EVENTFD, &evfd, 1) < 0) {
+			TraceEvent(SevWarnAlways, "AsyncFileIOUringRegisterEventFDError").GetLastError();
+			ctx.ring.unmap();
+			::close(fd);
+			return false;
+		}
+
+		if (!g_network->isSimulated()) {
+			ctx.countSubmit.init("AsyncFile.CountIOUringSubmit"_sr);
+			ctx.countCollect.init("AsyncFile.CountIOUringCollect"_sr);
+			ctx.submitMetric.init("AsyncFile.IOUringSubmit"_sr);
+		}
+		setTimeout(ioTimeout);
+		poll(ev);
+
+		ctx.previousRunCycle = reinterpret_cast<void (*)()>(g_network->global(INetwork::enRunCycleFunc));
+		g_network->setGlobal(INetwork::enRunCycleFunc, (flowGlobalType)&AsyncFileIOUring::launch);
+		if (FLOW_KNOBS->REAP_IO_IN_RUN_LOOP) {
+			g_network->setGlobal(INetwork::enIOPollFunc, (flowGlobalType)&AsyncFileIOUring::pollCompletions);
+		}
+
+		TraceEvent("AsyncFileIOUringInit")
+		    .detail("SQEntries", params.sq_entries)
+		    .detail("CQEntries", params.cq_entries)
+		    .detail("SQPoll", ctx.sqPoll)
+		    .detail("Features", params.features);
+		return true;
+	}
+
+	static bool isInitialized() { return ctx.ring.fd >= 0; }
+
+	// Called by the Net2 run loop right after it polls the network, so completions are delivered in the same loop
+	// iteration that notices them.
+	static void pollCompletions() {
+		if (ctx.outstanding) {
+			reap();
+		}
+	}
+	static void setTimeout(double ioTimeout) { ctx.setIOTimeout(ioTimeout); }
+
+	// Registers memory that later reads and writes may use as their buffer; requests whose buffer falls entirely
+	// inside a registered region are issued as fixed-buffer operations. Replaces any earlier registration, and must
+	// not be called while requests are outstanding.
+	static bool registerBuffers(std::vector<iovec> const& buffers) {
+		ASSERT(isInitialized() && ctx.outstanding == 0 && ctx.queue.empty());
+		if (!ctx.registeredBuffers.empty()) {
+			syscall(__NR_io_uring_register, ctx.ring.fd, IORING_UNREGISTER_BUFFERS, nullptr, 0);
+			ctx.registeredBuffers.clear();
+		}
+		if (buffers.empty()) {
+			return true;
+		}
+		if (syscall(__NR_io_uring_register, ctx.ring.fd, IORING_REGISTER_BUFFERS, buffers.data(), buffers.size()) <
+		    0) {
+			TraceEvent(SevWarn, "AsyncFileIOUringRegisterBuffersError")
+			    .detail("Buffers", buffers.size())
+			    .GetLastError();
+			return false;
+		}
+		ctx.registeredBuffers = buffers;
+		return true;
+	}
+
+	void addref() override { ReferenceCounted<AsyncFileIOUring>::addref(); }
+	void delref() override { ReferenceCounted<AsyncFileIOUring>::delref(); }
+
+	Future<int> read(void* data, int length, int64_t offset) override {
+		++countFileLogicalReads;
+		++countLogicalReads;
+
+		if (failed) {
+			return io_timeout();
+		}
+
+		IOBlock* io = new IOBlock(IORING_OP_READ, fd);
+		io->buf = data;
+		io->nbytes = length;
+		io->offset = offset;
+
+		enqueue(io);
+		return io->result.getFuture();
+	}
+
+	Future<Void> write(void const* data, int length, int64_t offset) override {
+		++countFileLogicalWrites;
+		++countLogicalWrites;
+
+		if (failed) {
+			return io_timeout();
+		}
+
+		IOBlock* io = new IOBlock(IORING_OP_WRITE, fd);
+		io->buf = (void*)data;
+		io->nbytes = length;
+		io->offset = offset;
+
+		nextFileSize = std::max(nextFileSize, offset + length);
+
+		enqueue(io);
+		return success(io->result.getFuture());
+	}
+
+#ifndef FALLOC_FL_ZERO_RANGE
+#define FALLOC_FL_ZERO_RANGE 0x10
+#endif
+	Future<Void> zeroRange(int64_t offset, int64_t length) override {
+		bool success = false;
+		if (ctx.fallocateZeroSupported) {
+			int rc = fallocate(fd, FALLOC_FL_ZERO_RANGE, offset, length);
+			if (rc == -1 && errno == EOPNOTSUPP) {
+				ctx.fallocateZeroSupported = false;
+			}
+			if (rc == 0) {
+				success = true;
+			}
+		}
+		return success ? Void() : IAsyncFile::zeroRange(offset, length);
+	}
+
+	Future<Void> truncate(int64_t size) override {
+		++countFileLogicalWrites;
+		++countLogicalWrites;
+
+		if (failed) {
+			return io_timeout();
+		}
+
+		int result = -1;
+		bool completed = false;
+		double begin = timer_monotonic();
+
+		if (ctx.fallocateSupported && size >= lastFileSize) {
+			result = fallocate(fd, 0, 0, size);
+			if (result != 0) {
+				int fallocateErrCode = errno;
+				TraceEvent("AsyncFileIOUringAllocateError")
+				    .detail("Fd", fd)
+				    .detail("Filename", filename)
+				    .detail("Size", size)
+				    .GetLastError();
+				if (fallocateErrCode == EOPNOTSUPP) {
+					// Mark fallocate as unsupported. Try again with truncate.
+					ctx.fallocateSupported = false;
+				} else {
+					return io_error();
+				}
+			} else {
+				completed = true;
+			}
+		}
+		if (!completed)
+			result = ftruncate(fd, size);
+
+		double end = timer_monotonic();
+		if (nondeterministicRandom()->random01() < end - begin) {
+			TraceEvent("SlowIOUringTruncate")
+			    .detail("TruncateTime", end - begin)
+			    .detail("TruncateBytes", size - lastFileSize);
+		}
+
+		if (result != 0) {
+			TraceEvent("AsyncFileIOUringTruncateError").detail("Fd", fd).detail("Filename", filename).GetLastError();
+			return io_error();
+		}
+
+		lastFileSize = nextFileSize = size;
+
+		return Void();
+	}
+
+	ACTOR static Future<Void> throwErrorIfFailed(Reference<AsyncFileIOUring> self, Future<int> sync) {
+		wait(success(sync));
+		if (self->failed) {
+			throw io_timeout();
+		}
+		return Void();
+	}
+
+	Future<Void> sync() override {
+		++countFileLogicalWrites;
+		++countLogicalWrites;
+
+		if (failed) {
+			return io_timeout();
+		}
+
+		double start_time = timer();
+
+		// Unlike kernel AIO, io_uring implements fdatasync, so the sync goes through the ring like everything else.
+		IOBlock* io = new IOBlock(IORING_OP_FSYNC, fd);
+		enqueue(io);
+		Future<Void> fsync = throwErrorIfFailed(Reference<AsyncFileIOUring>::addRef(this), io->result.getFuture());
+
+		fsync = map(fsync, [=](Void r) mutable {
+			getMetrics().syncLatencySample.addMeasurement(timer() - start_time);
+			return r;
+		});
+
+		if (flags & OPEN_ATOMIC_WRITE_AND_CREATE) {
+			flags &= ~OPEN_ATOMIC_WRITE_AND_CREATE;
+
+			return AsyncFileEIO::waitAndAtomicRename(fsync, filename + ".part", filename);
+		}
+
+		return fsync;
+	}
+
+	Future<int64_t> size() const override { return nextFileSize; }
+	int64_t debugFD() const override { return fd; }
+	std::string getFilename() const override { return filename; }
+	~AsyncFileIOUring() override { close(fd); }
+
+	// Called once per Net2 run loop iteration: reaps whatever has completed, then moves queued requests into the
+	// submission ring and submits them with a single io_uring_enter().
+	static void launch() {
+		if (ctx.previousRunCycle) {
+			ctx.previousRunCycle();
+		}
+
+		if (ctx.outstanding) {
+			reap();
+		}
+
+		if (ctx.queue.empty() && !ctx.ring.unsubmitted()) {
+			return;
+		}
+
+		ctx.submitMetric = true;
+		double begin = timer_monotonic();
+		if (!ctx.outstanding)
+			ctx.ioStallBegin = begin;
+
+		double start = timer();
+		int n = std::min<int64_t>({ (int64_t)ctx.queue.size(),
+		                            (int64_t)ctx.ring.sqFree(),
+		                            (int64_t)FLOW_KNOBS->IO_URING_ENTRIES - ctx.outstanding });
+		for (int i = 0; i < n; i++) {
+			IOBlock* io = ctx.queue.top();
+			ctx.queue.pop();
+			io->startTime = start;
+
+			if (ctx.ioTimeout > 0) {
+				ctx.appendToRequestList(io);
+			}
+
+			if (io->opcode == IORING_OP_WRITE && io->owner->lastFileSize != io->owner->nextFileSize) {
+				ASSERT(io->owner->nextFileSize > io->owner->lastFileSize);
+				io->owner->truncate(io->owner->nextFileSize);
+			}
+
+			io->prepare(ctx.ring.nextSqe(), ctx.registeredBuffers);
+		}
+		ctx.outstanding += n;
+		ctx.ring.publishSqes();
+
+		if (!ctx.sqPoll) {
+			int rc = syscall(__NR_io_uring_enter, ctx.ring.fd, ctx.ring.unsubmitted(), 0, 0, nullptr, 0);
+			if (rc < 0 && errno != EAGAIN && errno != EBUSY && errno != EINTR) {
+				// Whatever is left in the ring is retried on the next loop iteration; if it never goes through the
+				// request timeout will notice.
+				TraceEvent(SevWarnAlways, "AsyncFileIOUringSubmitError").GetLastError();
+			}
+		} else if (ctx.ring.sqNeedsWakeup()) {
+			syscall(__NR_io_uring_enter, ctx.ring.fd, 0, 0, IORING_ENTER_SQ_WAKEUP, nullptr, 0);
+		}
+
+		ctx.submitMetric = false;
+		++ctx.countSubmit;
+
+		double elapsed = timer_monotonic() - begin;
+		g_network->networkInfo.metrics.secSquaredSubmit += elapsed * elapsed / 2;
+	}
+
+	bool failed;
+
+private:
+	int fd, flags;
+	int64_t lastFileSize, nextFileSize;
+	std::string filename;
+	Int64MetricHandle countFileLogicalWrites;
+	Int64MetricHandle countFileLogicalReads;
+
+	Int64MetricHandle countLogicalWrites;
+	Int64MetricHandle countLogicalReads;
+
+	struct IOBlock : FastAllocated<IOBlock> {
+		Promise<int> result;
+		Reference<AsyncFileIOUring> owner;
+		uint8_t opcode;
+		int fd;
+		void* buf;
+		uint32_t nbytes;
+		int64_t offset;
+		int64_t prio;
+		IOBlock* prev;
+		IOBlock* next;
+		double startTime;
+
+		struct indirect_order_by_priority {
+			bool operator()(IOBlock* a, IOBlock* b) { return a->prio < b->prio; }
+		};
+
+		IOBlock(uint8_t opcode, int fd)
+		  : opcode(opcode), fd(fd), buf(nullptr), nbytes(0), offset(0), prio(0), prev(nullptr), next(nullptr),
+		    startTime(0) {}
+
+		TaskPriority getTask() const { return static_cast<TaskPriority>((prio >> 32) + 1); }
+
+		void prepare(io_uring_sqe* sqe, std::vector<iovec> const& registeredBuffers) {
+			memset(sqe, 0, sizeof(*sqe));
+			sqe->opcode = opcode;
+			sqe->fd = fd;
+			sqe->user_data = reinterpret_cast<uint64_t>(this);
+			if (opcode == IORING_OP_FSYNC) {
+				sqe->fsync_flags = IORING_FSYNC_DATASYNC;
+				return;
+			}
+			sqe->addr = reinterpret_cast<uint64_t>(buf);
+			sqe->len = nbytes;
+			sqe->off = offset;
+			for (int i = 0; i < (int)registeredBuffers.size(); i++) {
+				uint8_t* base = static_cast<uint8_t*>(registeredBuffers[i].iov_base);
+				if ((uint8_t*)buf >= base && (uint8_t*)buf + nbytes <= base + registeredBuffers[i].iov_len) {
+					sqe->opcode = opcode == IORING_OP_READ ? IORING_OP_READ_FIXED : IORING_OP_WRITE_FIXED;
+					sqe->buf_index = i;
+					break;
+				}
+			}
+		}
+
+		ACTOR static void deliver(Promise<int> result, bool failed, int r, TaskPriority task) {
+			wait(delay(0, task));
+			if (failed)
+				result.sendError(io_timeout());
+			else if (r < 0)
+				result.sendError(io_error());
+			else
+				result.send(r);
+		}
+
+		void setResult(int r) {
+			if (r < 0) {
+				struct stat fst;
+				fstat(fd, &fst);
+
+				errno = -r;
+				TraceEvent("AsyncFileIOUringIOError")
+				    .GetLastError()
+				    .detail("Fd", fd)
+				    .detail("Op", opcode)
+				    .detail("Nbytes", nbytes)
+				    .detail("Offset", offset)
+				    .detail("Ptr", int64_t(buf))
+				    .detail("Size", fst.st_size)
+				    .detail("Filename", owner->filename);
+			}
+			deliver(result, owner->failed, r, getTask());
+			delete this;
+		}
+
+		void timeout(bool warnOnly) {
+			TraceEvent(SevWarnAlways, "AsyncFileIOUringTimeout")
+			    .detail("Fd", fd)
+			    .detail("Op", opcode)
+			    .detail("Nbytes", nbytes)
+			    .detail("Offset", offset)
+			    .detail("Ptr", int64_t(buf))
+			    .detail("Filename", owner->filename);
+			g_network->setGlobal(INetwork::enASIOTimedOut, (flowGlobalType) true);
+
+			if (!warnOnly)
+				owner->failed = true;
+		}
+	};
+
+	// The submission and completion rings shared with the kernel.
+	struct Ring {
+		int fd = -1;
+		void* sqPtr = nullptr;
+		void* cqPtr = nullptr;
+		size_t sqSize = 0;
+		size_t cqSize = 0;
+		io_uring_sqe* sqes = nullptr;
+		size_t sqesSize = 0;
+
+		unsigned* sqHead = nullptr;
+		unsigned* sqTail = nullptr;
+		unsigned* sqFlags = nullptr;
+		unsigned* sqArray = nullptr;
+		unsigned sqMask = 0;
+		unsigned sqEntries = 0;
+		unsigned sqLocalTail = 0;
+
+		unsigned* cqHead = nullptr;
+		unsigned* cqTail = nullptr;
+		io_uring_cqe* cqes = nullptr;
+		unsigned cqMask = 0;
+
+		bool map(int ringFd, io_uring_params const& p) {
+			fd = ringFd;
+			sqSize = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+			cqSize = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+			bool singleMmap = p.features & IORING_FEAT_SINGLE_MMAP;
+			if (singleMmap) {
+				sqSize = cqSize = std::max(sqSize, cqSize);
+			}
+
+			sqPtr = mmap(nullptr, sqSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+			if (sqPtr == MAP_FAILED) {
+				sqPtr = nullptr;
+				return false;
+			}
+			if (singleMmap) {
+				cqPtr = sqPtr;
+			} else {
+				cqPtr =
+				    mmap(nullptr, cqSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+				if (cqPtr == MAP_FAILED) {
+					cqPtr = nullptr;
+					return false;
+				}
+			}
+			sqesSize = p.sq_entries * sizeof(io_uring_sqe);
+			void* sqesPtr =
+			    mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+			if (sqesPtr == MAP_FAILED) {
+				return false;
+			}
+			sqes = static_cast<io_uring_sqe*>(sqesPtr);
+
+			uint8_t* sq = static_cast<uint8_t*>(sqPtr);
+			sqHead = reinterpret_cast<unsigned*>(sq + p.sq_off.head);
+			sqTail = reinterpret_cast<unsigned*>(sq + p.sq_off.tail);
+			sqFlags = reinterpret_cast<unsigned*>(sq + p.sq_off.flags);
+			sqArray = reinterpret_cast<unsigned*>(sq + p.sq_off.array);
+			sqMask = *reinterpret_cast<unsigned*>(sq + p.sq_off.ring_mask);
+			sqEntries = p.sq_entries;
+			sqLocalTail = *sqTail;
+
+			uint8_t* cq = static_cast<uint8_t*>(cqPtr);
+			cqHead = reinterpret_cast<unsigned*>(cq + p.cq_off.head);
+			cqTail = reinterpret_cast<unsigned*>(cq + p.cq_off.tail);
+			cqes = reinterpret_cast<io_uring_cqe*>(cq + p.cq_off.cqes);
+			cqMask = *reinterpret_cast<unsigned*>(cq + p.cq_off.ring_mask);
+			return true;
+		}
+
+		void unmap() {
+			if (sqes)
+				munmap(sqes, sqesSize);
+			if (cqPtr && cqPtr != sqPtr)
+				munmap(cqPtr, cqSize);
+			if (sqPtr)
+				munmap(sqPtr, sqSize);
+			sqes = nullptr;
+			sqPtr = cqPtr = nullptr;
+			fd = -1;
+		}
+
+		// Entries published to the kernel but not yet consumed by it.
+		unsigned unsubmitted() const { return sqLocalTail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE); }
+		unsigned sqFree() const { return sqEntries - unsubmitted(); }
+
+		io_uring_sqe* nextSqe() {
+			unsigned index = sqLocalTail & sqMask;
+			sqArray[index] = index;
+			++sqLocalTail;
+			return &sqes[index];
+		}
+
+		void publishSqes() { __atomic_store_n(sqTail, sqLocalTail, __ATOMIC_RELEASE); }
+
+		bool sqNeedsWakeup() const {
+			// The tail store must be visible before the flags are checked, or a poller going idle could miss it.
+			__atomic_thread_fence(__ATOMIC_SEQ_CST);
+			return __atomic_load_n(sqFlags, __ATOMIC_RELAXED) & IORING_SQ_NEED_WAKEUP;
+		}
+	};
+
+	struct Context {
+		Ring ring;
+		bool sqPoll;
+		int outstanding;
+		double ioStallBegin;
+		bool fallocateSupported;
+		bool fallocateZeroSupported;
+		std::priority_queue<IOBlock*, std::vector<IOBlock*>, IOBlock::indirect_order_by_priority> queue;
+		std::vector<iovec> registeredBuffers;
+		void (*previousRunCycle)();
+		Int64MetricHandle countSubmit;
+		Int64MetricHandle countCollect;
+		Int64MetricHandle submitMetric;
+
+		double ioTimeout;
+		bool timeoutWarnOnly;
+		IOBlock* submittedRequestList;
+
+		uint32_t opsIssued;
+		Context()
+		  : sqPoll(false), outstanding(0), ioStallBegin(0), fallocateSupported(true), fallocateZeroSupported(true),
+		    previousRunCycle(nullptr), submittedRequestList(nullptr), opsIssued(0) {
+			setIOTimeout(0);
+		}
+
+		void setIOTimeout(double timeout) {
+			ioTimeout = fabs(timeout);
+			timeoutWarnOnly = timeout < 0;
+		}
+
+		void appendToRequestList(IOBlock* io) {
+			ASSERT(!io->next && !io->prev);
+
+			if (submittedRequestList) {
+				io->prev = submittedRequestList->prev;
+				io->prev->next = io;
+
+				submittedRequestList->prev = io;
+				io->next = submittedRequestList;
+			} else {
+				submittedRequestList = io;
+				io->next = io->prev = io;
+			}
+		}
+
+		void removeFromRequestList(IOBlock* io) {
+			if (io->next == nullptr) {
+				ASSERT(io->prev == nullptr);
+				return;
+			}
+
+			ASSERT(io->prev != nullptr);
+
+			if (io == io->next) {
+				ASSERT(io == submittedRequestList && io == io->prev);
+				submittedRequestList = nullptr;
+			} else {
+				io->next->prev = io->prev;
+				io->prev->next = io->next;
+
+				if (submittedRequestList == io) {
+					submittedRequestList = io->next;
+				}
+			}
+
+			io->next = io->prev = nullptr;
+		}
+	};
+	inline static Context ctx;
+
+	explicit AsyncFileIOUring(int fd, int flags, std::string const& filename)
+	  : failed(false), fd(fd), flags(flags), filename(filename) {
+		if (!g_network->isSimulated()) {
+			countFileLogicalWrites.init("AsyncFile.CountFileLogicalWrites"_sr, filename);
+			countFileLogicalReads.init("AsyncFile.CountFileLogicalReads"_sr, filename);
+			countLogicalWrites.init("AsyncFile.CountLogicalWrites"_sr);
+			countLogicalReads.init("AsyncFile.CountLogicalReads"_sr);
+		}
+	}
+
+	void enqueue(IOBlock* io) {
+		ASSERT(io->opcode == IORING_OP_FSYNC ||
+		       (int64_t(io->buf) % 4096 == 0 && io->offset % 4096 == 0 && io->nbytes % 4096 == 0));
+
+		io->prio = (int64_t(g_network->getCurrentTask()) << 32) - (++ctx.opsIssued);
+		io->owner = Reference<AsyncFileIOUring>::addRef(this);
+
+		ctx.queue.push(io);
+	}
+
+	static int openFlags(int flags) {
+		int oflags = O_DIRECT | O_CLOEXEC;
+		ASSERT(bool(flags & OPEN_READONLY) != bool(flags & OPEN_READWRITE)); // readonly xor readwrite
+		if (flags & OPEN_EXCLUSIVE)
+			oflags |= O_EXCL;
+		if (flags & OPEN_CREATE)
+			oflags |= O_CREAT;
+		if (flags & OPEN_READONLY)
+			oflags |= O_RDONLY;
+		if (flags & OPEN_READWRITE)
+			oflags |= O_RDWR;
+		if (flags & OPEN_ATOMIC_WRITE_AND_CREATE)
+			oflags |= O_TRUNC;
+		return oflags;
+	}
+
+	// Drains the completion ring. No system call is needed: the kernel posts completions into shared memory.
+	static void reap() {
+		unsigned head = *ctx.ring.cqHead;
+		unsigned tail = __atomic_load_n(ctx.ring.cqTail, __ATOMIC_ACQUIRE);
+		if (head == tail) {
+			return;
+		}
+
+		double currentTime = timer();
+		++ctx.countCollect;
+
+		double t = timer_monotonic();
+		double elapsed = t - ctx.ioStallBegin;
+		ctx.ioStallBegin = t;
+		g_network->networkInfo.metrics.secSquaredDiskStall += elapsed * elapsed / 2;
+
+		if (ctx.ioTimeout > 0) {
+			while (ctx.submittedRequestList && currentTime - ctx.submittedRequestList->startTime > ctx.ioTimeout) {
+				ctx.submittedRequestList->timeout(ctx.timeoutWarnOnly);
+				ctx.removeFromRequestList(ctx.submittedRequestList);
+			}
+		}
+
+		for (; head != tail; ++head) {
+			io_uring_cqe const& cqe = ctx.ring.cqes[head & ctx.ring.cqMask];
+			IOBlock* iob = reinterpret_cast<IOBlock*>(cqe.user_data);
+			int res = cqe.res;
+			--ctx.outstanding;
+
+			if (ctx.ioTimeout > 0) {
+				ctx.removeFromRequestList(iob);
+			}
+
+			switch (iob->opcode) {
+			case IORING_OP_READ:
+				getMetrics().readLatencySample.addMeasurement(currentTime - iob->startTime);
+				break;
+			case IORING_OP_WRITE:
+				getMetrics().writeLatencySample.addMeasurement(currentTime - iob->startTime);
+				break;
+			}
+
+			iob->setResult(res);
+		}
+		__atomic_store_n(ctx.ring.cqHead, head, __ATOMIC_RELEASE);
+	}
+
+	// Wakes up to reap completions that arrive while the run loop is otherwise idle.
+	ACTOR static void poll(Reference<IEventFD> ev) {
+		loop {
+			wait(success(ev->read()));
+			wait(delay(0, TaskPriority::DiskIOComplete));
+			reap();
+		}
+	}
+};
+
+TEST_CASE("/fdbrpc/AsyncFileIOUring/ReadWrite") {
+	// This test does nothing in simulation, or when io_uring is not in use in this process
+	if (!g_network->isSimulated() && AsyncFileIOUring::isInitialized()) {
+		state Reference<IAsyncFile> f;
+		state void* buf = FastAllocator<4096>::allocate();
+		state int fileSize = 1 << 22;
+		state int64_t offset = 0;
+		try {
+			Reference<IAsyncFile> f_ = wait(AsyncFileIOUring::open(
+			    "/tmp/__IO_URING_TEST_FILE__",
+			    IAsyncFile::OPEN_UNBUFFERED | IAsyncFile::OPEN_READWRITE | IAsyncFile::OPEN_CREATE,
+			    0666,
+			    nullptr));
+			f = f_;
+			wait(f->truncate(fileSize));
+
+			for (offset = 0; offset < fileSize; offset += 4096) {
+				memset(buf, (offset / 4096) & 0xff, 4096);
+				wait(f->write(buf, 4096, offset));
+			}
+			wait(f->sync());
+
+			for (offset = 0; offset < fileSize; offset += 4096) {
+				int bytes = wait(f->read(buf, 4096, offset));
+				ASSERT_EQ(bytes, 4096);
+				ASSERT_EQ(((uint8_t*)buf)[0], (offset / 4096) & 0xff);
+				ASSERT_EQ(((uint8_t*)buf)[4095], (offset / 4096) & 0xff);
+			}
+		} catch (Error& e) {
+			state Error err = e;
+			FastAllocator<4096>::release(buf);
+			if (f) {
+				wait(AsyncFileEIO::deleteFile(f->getFilename(), true));
+			}
+			throw err;
+		}
+
+		FastAllocator<4096>::release(buf);
+		wait(AsyncFileEIO::deleteFile(f->getFilename(), true));
+	}
+
+	return Void();
+}
+
+#include "flow/unactorcompiler.h"
+#endif
+#endif
@@ -211,6 +211,9 @@ public:
 		poll(ev);
 
 		g_network->setGlobal(INetwork::enRunCycleFunc, (flowGlobalType)&AsyncFileKAIO::launch);
+		if (FLOW_KNOBS->REAP_IO_IN_RUN_LOOP) {
+			g_network->setGlobal(INetwork::enIOPollFunc, (flowGlobalType)&AsyncFileKAIO::pollCompletions);
+		}
 	}
 
 	static int get_eventfd() { return ctx.evfd; }
@@ -720,73 +723,93 @@ private:
 		return oflags;
 	}
 
-	ACTOR static void poll(Reference<IEventFD> ev) {
-		loop {
-			wait(success(ev->read()));
+	// Collects whatever kernel AIO has completed without blocking. Returns the number of completions, or -1 if
+	// io_getevents failed.
+	static int reapCompletions() {
+		linux_ioresult ev[FLOW_KNOBS->MAX_OUTSTANDING];
+		timespec tm;
+		tm.tv_sec = 0;
+		tm.tv_nsec = 0;
 
-			wait(delay(0, TaskPriority::DiskIOComplete));
+		int n;
 
-			linux_ioresult ev[FLOW_KNOBS->MAX_OUTSTANDING];
-			timespec tm;
-			tm.tv_sec = 0;
-			tm.tv_nsec = 0;
+		loop {
+			n = io_getevents(ctx.iocx, 0, FLOW_KNOBS->MAX_OUTSTANDING, ev, &tm);
+			if (n >= 0 || errno != EINTR)
+				break;
+		}
 
-			int n;
+		double currentTime = timer();
 
-			loop {
-				n = io_getevents(ctx.iocx, 0, FLOW_KNOBS->MAX_OUTSTANDING, ev, &tm);
-				if (n >= 0 || errno != EINTR)
-					break;
-			}
+		++ctx.countAIOCollect;
+		// printf("io_getevents: collected %d/%d in %f us (%d queued)\n", n, ctx.outstanding, (timer()-before)*1e6,
+		// ctx.queue.size());
+		if (n < 0) {
+			// printf("io_getevents failed: %d\n", errno);
+			TraceEvent("IOGetEventsError").GetLastError();
+			return -1;
+		}
+		if (n) {
+			double t = timer_monotonic();
+			double elapsed = t - ctx.ioStallBegin;
+			ctx.ioStallBegin = t;
+			g_network->networkInfo.metrics.secSquaredDiskStall += elapsed * elapsed / 2;
+		}
 
-			double currentTime = timer();
+		ctx.outstanding -= n;
 
-			++ctx.countAIOCollect;
-			// printf("io_getevents: collected %d/%d in %f us (%d queued)\n", n, ctx.outstanding, (timer()-before)*1e6,
-			// ctx.queue.size());
-			if (n < 0) {
-				// printf("io_getevents failed: %d\n", errno);
-				TraceEvent("IOGetEventsError").GetLastError();
-				throw io_error();
-			}
-			if (n) {
-				double t = timer_monotonic();
-				double elapsed = t - ctx.ioStallBegin;
-				ctx.ioStallBegin = t;
-				g_network->networkInfo.metrics.secSquaredDiskStall += elapsed * elapsed / 2;
+		if (ctx.ioTimeout > 0) {
+			while (ctx.submittedRequestList && currentTime - ctx.submittedRequestList->startTime > ctx.ioTimeout) {
+				ctx.submittedRequestList->timeout(ctx.timeoutWarnOnly);
+				ctx.removeFromRequestList(ctx.submittedRequestList);
 			}
+		}
+
+		for (int i = 0; i < n; i++) {
+			IOBlock* iob = static_cast<IOBlock*>(ev[i].iocb);
 
-			ctx.outstanding -= n;
+			KAIOLogBlockEvent(iob, OpLogEntry::COMPLETE, ev[i].result);
 
 			if (ctx.ioTimeout > 0) {
-				while (ctx.submittedRequestList && currentTime - ctx.submittedRequestList->startTime > ctx.ioTimeout) {
-					ctx.submittedRequestList->timeout(ctx.timeoutWarnOnly);
-					ctx.removeFromRequestList(ctx.submittedRequestList);
-				}
+				ctx.removeFromRequestList(iob);
 			}
 
-			for (int i = 0; i < n; i++) {
-				IOBlock* iob = static_cast<IOBlock*>(ev[i].iocb);
+			switch (iob->aio_lio_opcode) {
+			case IO_CMD_PREAD:
+				getMetrics().readLatencySample.addMeasurement(currentTime - iob->startTime);
+				break;
+			case IO_CMD_PWRITE:
+				getMetrics().writeLatencySample.addMeasurement(currentTime - iob->startTime);
+				break;
+			}
 
-				KAIOLogBlockEvent(iob, OpLogEntry::COMPLETE, ev[i].result);
+			iob->setResult(ev[i].result);
+		}
+		return n;
+	}
 
-				if (ctx.ioTimeout > 0) {
-					ctx.removeFromRequestList(iob);
-				}
+	ACTOR static void poll(Reference<IEventFD> ev) {
+		loop {
+			wait(success(ev->read()));
 
-				switch (iob->aio_lio_opcode) {
-				case IO_CMD_PREAD:
-					getMetrics().readLatencySample.addMeasurement(currentTime - iob->startTime);
-					break;
-				case IO_CMD_PWRITE:
-					getMetrics().writeLatencySample.addMeasurement(currentTime - iob->startTime);
-					break;
-				}
+			wait(delay(0, TaskPriority::DiskIOComplete));
 
-				iob->setResult(ev[i].result);
+			if (reapCompletions() < 0) {
+				throw io_error();
 			}
 		}
 	}
+
+public:
+	// Called by the Net2 run loop right after it polls the network. The completion ring lives in user memory, so
+	// checking it costs no system call; io_getevents() is only made when something has actually completed, and
+	// completions are picked up without waiting for the eventfd to wake the poll actor. Throwing here would unwind the
+	// run loop itself, so a failed io_getevents() is logged as an error instead (IOGetEventsError carries errno).
+	static void pollCompletions() {
+		if (ctx.outstanding && io_ring_has_events(ctx.iocx) && reapCompletions() < 0) {
+			TraceEvent(SevError, "AsyncFileKAIOPollCompletionsError").detail("Outstanding", ctx.outstanding);
+		}
+	}
 };
 
 #if KAIO_LOGGING
@@ -66,6 +66,16 @@ public:
 	}
 
 	ACTOR static Future<int> read_impl(Reference<AsyncFileReadAheadCache> f, void* data, int length, int64_t offset) {
+		// Only read ahead while the file is being read sequentially.  Each read which starts where the last one ended
+		// doubles the read ahead window, up to m_read_ahead_blocks, and a read anywhere else closes it so that random
+		// reads do not fetch blocks which will never be used.
+		if (offset == f->m_next_sequential_offset) {
+			f->m_read_ahead_window = std::min(f->m_read_ahead_blocks, std::max(1, f->m_read_ahead_window * 2));
+		} else {
+			f->m_read_ahead_window = 0;
+		}
+		f->m_next_sequential_offset = offset + length;
+
 		// Make sure range is valid for the file
 		int64_t fileSize = wait(f->size());
 		if (offset >= fileSize)
@@ -93,7 +103,7 @@ public:
 		// Start blocks up to the read ahead size beyond the last needed block but don't go past the end of the file
 		state int lastBlockNumInFile = ((fileSize + f->m_block_size - 1) / f->m_block_size) - 1;
 		ASSERT(lastBlockNum <= lastBlockNumInFile);
-		int lastBlockToStart = std::min<int>(lastBlockNum + f->m_read_ahead_blocks, lastBlockNumInFile);
+		int lastBlockToStart = std::min<int>(lastBlockNum + f->m_read_ahead_window, lastBlockNumInFile);
 
 		state int blockNum;
 		for (blockNum = firstBlockNum; blockNum <= lastBlockToStart; ++blockNum) {
@@ -150,7 +160,8 @@ public:
 		// If the cache is too large then go through the cache in block number order and remove any entries whose future
 		// has a reference count of 1, stopping once the cache is no longer too big.  There is no point in removing
 		// an entry from the cache if it has a reference count of > 1 because it will continue to exist and use memory
-		// anyway so it should be left in the cache so that other readers may benefit from it.
+		// anyway so it should be left in the cache so that other readers may benefit from it.  Blocks which are still
+		// being read are also kept, since dropping them would cancel read ahead that was just started.
 
 		// printf("cache block limit: %d   Cache contents:\n", f->m_cache_block_limit);
 		// for(auto &m : f->m_blocks) printf("\tblock %d refcount %d\n", m.first, m.second.getFutureReferenceCount());
@@ -158,7 +169,7 @@ public:
 		if (f->m_blocks.size() > f->m_cache_block_limit) {
 			auto i = f->m_blocks.begin();
 			while (i != f->m_blocks.end()) {
-				if (i->second.getFutureReferenceCount() == 1) {
+				if (i->second.getFutureReferenceCount() == 1 && i->second.isReady()) {
 					// printf("evicting block %d\n", i->first);
 					i = f->m_blocks.erase(i);
 					if (f->m_blocks.size() <= f->m_cache_block_limit)
@@ -203,6 +214,10 @@ public:
 	int m_block_size;
 	int m_read_ahead_blocks;
 	int m_cache_block_limit;
+	// Current read ahead, which grows towards m_read_ahead_blocks during sequential reads
+	int m_read_ahead_window;
+	// Offset at which a read continues the last one
+	int64_t m_next_sequential_offset;
 	FlowLock m_max_concurrent_reads;
 
 	// Map block numbers to future
@@ -214,7 +229,8 @@ public:
 	                        int maxConcurrentReads,
 	                        int cacheSizeBlocks)
 	  : m_f(f), m_block_size(blockSize), m_read_ahead_blocks(readAheadBlocks),
-	    m_cache_block_limit(std::max<int>(1, cacheSizeBlocks)), m_max_concurrent_reads(maxConcurrentReads) {}
+	    m_cache_block_limit(std::max<int>(1, cacheSizeBlocks)), m_read_ahead_window(readAheadBlocks),
+	    m_next_sequential_offset(0), m_max_concurrent_reads(maxConcurrentReads) {}
 };
 
 #include "flow/unactorcompiler.h"
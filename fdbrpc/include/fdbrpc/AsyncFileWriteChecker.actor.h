@@ -301,6 +301,12 @@ private:
 		uint32_t startPage = page;
 		uint32_t pageEnd = (offset + len) / checksumHistoryPageSize; // Last page plus 1
 		while (page < pageEnd) {
+			// Most pages read have no history left to check against, so skip computing their checksums
+			if (!updateChecksum && !lru.exist(page)) {
+				start += checksumHistoryPageSize;
+				++page;
+				continue;
+			}
 			uint32_t checksum = crc32c_append(0xab12fd93, start, checksumHistoryPageSize);
 #if VALGRIND
 			// It's possible we'll read or write a page where not all of the data is defined, but the checksum of the
@@ -157,6 +157,7 @@ struct Peer : public ReferenceCounted<Peer> {
 	AsyncTrigger resetConnection;
 	bool compatible;
 	bool connected;
+	bool compressionAccepted; // The other end of the current connection advertised that it decompresses packets
 	bool outgoingConnectionIdle; // We don't actually have a connection open and aren't trying to open one because we
 	                             // don't have anything to send
 	double lastConnectTime;
@@ -164,12 +165,16 @@ struct Peer : public ReferenceCounted<Peer> {
 	int peerReferences;
 	int64_t bytesReceived;
 	int64_t bytesSent;
+	int64_t packetsSent;
+	int64_t writeCalls; // Each is one send syscall, so packetsSent / writeCalls measures how well packets coalesce
 	double lastDataPacketSentTime;
 	int outstandingReplies;
 	DDSketch<double> pingLatencies;
 	double lastLoggedTime;
 	int64_t lastLoggedBytesReceived;
 	int64_t lastLoggedBytesSent;
+	int64_t lastLoggedPacketsSent;
+	int64_t lastLoggedWriteCalls;
 	int timeoutCount;
 
 	Reference<AsyncVar<Optional<ProtocolVersion>>> protocolVersion;
@@ -179,6 +184,9 @@ struct Peer : public ReferenceCounted<Peer> {
 	int connectIncomingCount;
 	int connectFailedCount;
 	DDSketch<double> connectLatencies;
+	int64_t packetsCompressed;
+	int64_t compressionBytesSaved;
+	double compressionSeconds;
 	Promise<Void> disconnect;
 
 	explicit Peer(TransportData* transport, NetworkAddress const& destination);
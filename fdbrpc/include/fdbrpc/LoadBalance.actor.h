@@ -481,7 +481,10 @@ struct RequestData : NonCopyable {
 			// Send parallel request to TSS pair, if it exists
 			Optional<TSSEndpointData> tssData = model->getTssData(stream->getEndpoint().token.first());
 
-			if (tssData.present()) {
+			// Comparing every request costs the client a second reply to receive and compare, so only a sample of them
+			// need be duplicated
+			if (tssData.present() && (FLOW_KNOBS->LOAD_BALANCE_TSS_SAMPLE_RATE >= 1.0 ||
+			                          deterministicRandom()->random01() < FLOW_KNOBS->LOAD_BALANCE_TSS_SAMPLE_RATE)) {
 				CODE_PROBE(true, "duplicating request to TSS");
 				resetReply(request);
 				// FIXME: optimize to avoid creating new netNotifiedQueue for each message
@@ -679,13 +682,62 @@ struct RequestData : NonCopyable {
 	}
 };
 
+// Chooses among the usable alternatives in the best locality with power of two choices: of two picked at random, the
+// one with the lower predicted tail latency, scaled up by its outstanding requests, is sent the request. The other is
+// sent it too if the first has not answered within its predicted tail latency, as adjusted by secondMultiplier.
+// Returns false, changing nothing, if fewer than two alternatives are usable.
+template <class Interface, class Request, class Multi, bool P>
+bool chooseByTailLatency(QueueModel* model,
+                         Reference<MultiInterface<Multi>> const& alternatives,
+                         RequestStream<Request, P> Interface::* channel,
+                         int& bestAlt,
+                         int& nextAlt,
+                         Future<Void>& secondDelay) {
+	int picked[2] = { -1, -1 };
+	int usable = 0;
+	for (int i = 0; i < alternatives->countBest(); i++) {
+		Endpoint const& endpoint = alternatives->get(i, channel).getEndpoint();
+		if (IFailureMonitor::failureMonitor().getState(endpoint).failed) {
+			continue;
+		}
+		auto const& qd = model->getMeasurement(endpoint.token.first());
+		if (now() <= qd.failedUntil || (FLOW_KNOBS->LOAD_BALANCE_PENALTY_IS_BAD && qd.penalty > 1.001)) {
+			continue;
+		}
+		// Reservoir sample two of the usable alternatives
+		if (usable < 2) {
+			picked[usable] = i;
+		} else {
+			int slot = deterministicRandom()->randomInt(0, usable + 1);
+			if (slot < 2) {
+				picked[slot] = i;
+			}
+		}
+		++usable;
+	}
+	if (usable < 2) {
+		return false;
+	}
+
+	auto const& first = model->getMeasurement(alternatives->get(picked[0], channel).getEndpoint().token.first());
+	auto const& second = model->getMeasurement(alternatives->get(picked[1], channel).getEndpoint().token.first());
+	bool firstIsBest = first.predictedTailLatency() * (1.0 + first.smoothOutstanding.smoothTotal()) <=
+	                   second.predictedTailLatency() * (1.0 + second.smoothOutstanding.smoothTotal());
+	bestAlt = picked[firstIsBest ? 0 : 1];
+	nextAlt = picked[firstIsBest ? 1 : 0];
+	double bestTail = (firstIsBest ? first : second).predictedTailLatency();
+	secondDelay = delay(model->secondMultiplier * bestTail + FLOW_KNOBS->BASE_SECOND_REQUEST_TIME);
+	return true;
+}
+
 // Try to get a reply from one of the alternatives until success, cancellation, or certain errors.
 // Load balancing has a budget to race requests to a second alternative if the first request is slow.
 // Tries to take into account failMon's information for load balancing and avoiding failed servers.
 // If ALL the servers are failed and the list of servers is not fresh, throws an exception to let the caller refresh the
 // list of servers.
 // When model is set, load balance among alternatives in the same DC aims to balance request queue length on these
-// interfaces. If too many interfaces in the same DC are bad, try remote interfaces.
+// interfaces, or with LOAD_BALANCE_TAIL_LATENCY_AWARE their predicted tail latency (see chooseByTailLatency). If too
+// many interfaces in the same DC are bad, try remote interfaces.
 // If compareReplicas is set, does a consistency check by fetching and comparing results from storage
 // replicas (as many as specified by "requiredReplicas") and throws an exception if an inconsistency is found.
 // FIXME: reformat this minus the long inline comment about one parameter, so that the indentation of
@@ -724,7 +776,8 @@ Future<REPLY_TYPE(Request)> loadBalance(
 	if (nextAlt >= bestAlt)
 		nextAlt++;
 
-	if (model) {
+	if (model && !(FLOW_KNOBS->LOAD_BALANCE_TAIL_LATENCY_AWARE &&
+	               chooseByTailLatency(model, alternatives, channel, bestAlt, nextAlt, secondDelay))) {
 		double bestMetric = 1e9; // Storage server with the least outstanding requests.
 		double nextMetric = 1e9;
 		double bestTime = 1e9; // The latency to the server with the least outstanding requests.
@@ -735,10 +788,13 @@ Future<REPLY_TYPE(Request)> loadBalance(
 			// countBest(): the number of alternatives in the same locality (i.e., DC by default) as alternatives[0].
 			// if the if-statement is correct, it won't try to send requests to the remote ones.
 			if (badServers < std::min(i, FLOW_KNOBS->LOAD_BALANCE_MAX_BAD_OPTIONS + 1) &&
-			    i == alternatives->countBest()) {
+			    i == alternatives->countBest() &&
+			    (FLOW_KNOBS->LOAD_BALANCE_NEAREST_MAX_OUTSTANDING <= 0 ||
+			     bestMetric <= FLOW_KNOBS->LOAD_BALANCE_NEAREST_MAX_OUTSTANDING)) {
 				// When we have at least one healthy local server, and the bad
 				// server count is within "LOAD_BALANCE_MAX_BAD_OPTIONS". We
-				// do not need to consider any remote servers.
+				// do not need to consider any remote servers, unless even the
+				// least busy local one has too many requests outstanding.
 				break;
 			} else if (badServers == alternatives->countBest() && i == badServers) {
 				TraceEvent("AllLocalAlternativesFailed")
@@ -918,6 +974,9 @@ Future<REPLY_TYPE(Request)> loadBalance(
 				    .detail("Attempts", numAttempts);
 			}
 			secondRequestData.startRequest(backoff, triedAllOptions, stream, request, model, alternatives, channel);
+			if (model) {
+				++model->requestsAtDistance[distance];
+			}
 
 			state bool firstRequestSuccessful = false;
 			state bool secondRequestSuccessful = false;
@@ -971,6 +1030,9 @@ Future<REPLY_TYPE(Request)> loadBalance(
 			}
 			firstRequestData.startRequest(backoff, triedAllOptions, stream, request, model, alternatives, channel);
 			firstRequestEndpoint = stream->getEndpoint().token.first();
+			if (model) {
+				++model->requestsAtDistance[distance];
+			}
 
 			loop {
 				choose {
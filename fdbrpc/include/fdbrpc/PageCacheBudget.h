@@ -0,0 +1,64 @@
+/*
+ * PageCacheBudget.h
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2024 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FDBRPC_PAGECACHEBUDGET_H
+#define FDBRPC_PAGECACHEBUDGET_H
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include "flow/flow.h"
+
+// A memory budget shared by the page caches of a process, so that their combined size is bounded by the configured
+// cache memory rather than each cache being allowed the full amount.  Each cache registers a Consumer and calls
+// makeRoom() before it grows, which evicts from whichever caches hold the most memory.
+class PageCacheBudget : NonCopyable {
+public:
+	struct Consumer {
+		// Bytes of page memory the consumer currently holds
+		std::function<int64_t()> bytesUsed;
+		// Evict entries, as far as possible, until the consumer holds at most the given number of bytes
+		std::function<void(int64_t)> trimTo;
+	};
+
+	explicit PageCacheBudget(int64_t limit) : limit(limit) {}
+
+	void add(Consumer* c) { consumers.push_back(c); }
+	void remove(Consumer* c);
+
+	int64_t bytesUsed() const;
+
+	// Free enough memory for an allocation of the given size by requester to fit within the budget, trimming the
+	// largest consumers first.  Consumers may hold entries which cannot currently be evicted, in which case the
+	// budget is exceeded rather than failing the allocation.
+	void makeRoom(Consumer* requester, int64_t bytes);
+
+	// Returns the budget shared by the page caches of this process, or nullptr if each page cache should enforce
+	// its own limit.  In simulation each virtual process has its own budget of SIM_PAGE_CACHE_4K.
+	static PageCacheBudget* get();
+
+	int64_t limit;
+
+private:
+	std::vector<Consumer*> consumers;
+};
+
+#endif
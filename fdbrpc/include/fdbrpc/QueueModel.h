@@ -23,11 +23,13 @@
 #pragma once
 
 #include "flow/flow.h"
+#include "fdbrpc/DDSketch.h"
 #include "fdbrpc/Smoother.h"
 #include "flow/Knobs.h"
 #include "flow/ActorCollection.h"
 #include "fdbrpc/TSSComparison.h" // For TSS Metrics
 #include "fdbrpc/FlowTransport.h" // For Endpoint
+#include "fdbrpc/Locality.h" // For LBDistance
 
 struct TSSEndpointData {
 	UID tssId;
@@ -71,12 +73,24 @@ struct QueueData {
 	// to increase the future backoff amount.
 	double increaseBackoffTime;
 
+	// The clean latencies of the requests since tailLatency was last estimated. Only kept when
+	// LOAD_BALANCE_TAIL_LATENCY_AWARE is set, since a sketch takes a few KB.
+	Optional<DDSketch<double>> latencySketch;
+
+	// LOAD_BALANCE_TAIL_LATENCY_PERCENTILE of the latencies the sketch last collected, raised by any slower failed
+	// request. Zero until the first LOAD_BALANCE_TAIL_LATENCY_SAMPLES requests have finished.
+	double tailLatency;
+
 	// a bit of a hack to store this here, but it's the only centralized place for per-endpoint tracking
 	Optional<TSSEndpointData> tssData;
 
 	QueueData()
 	  : smoothOutstanding(FLOW_KNOBS->QUEUE_MODEL_SMOOTHING_AMOUNT), latency(0.001), penalty(1.0), failedUntil(0),
-	    futureVersionBackoff(FLOW_KNOBS->FUTURE_VERSION_INITIAL_BACKOFF), increaseBackoffTime(0) {}
+	    futureVersionBackoff(FLOW_KNOBS->FUTURE_VERSION_INITIAL_BACKOFF), increaseBackoffTime(0), tailLatency(0) {}
+
+	// The latency this storage server is expected to answer within at the tail percentile. The last latency is
+	// included so that a storage server which has just slowed down is avoided before a new estimate is taken.
+	double predictedTailLatency() const { return std::max(tailLatency, latency); }
 };
 
 typedef double TimeEstimate;
@@ -110,6 +124,8 @@ public:
 	Future<Void> tssComparisons; // requests for which a different recipient already answered
 	int laggingRequestCount;
 	int laggingTSSCompareCount;
+	// The number of requests sent to an alternative at each LBDistance since they were last logged
+	int64_t requestsAtDistance[LBDistance::DISTANT + 1] = {};
 
 	// Updates this endpoint data to duplicate requests to the specified TSS endpoint
 	void updateTssEndpoint(uint64_t endpointId, const TSSEndpointData& endpointData);
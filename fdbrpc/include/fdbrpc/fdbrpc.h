@@ -605,6 +605,11 @@ public:
 	// Must be called on the server before using a ReplyPromiseStream to limit the amount of outstanding bytes to the
 	// client
 	void setByteLimit(int64_t byteLimit) const { queue->acknowledgements.bytesLimit = byteLimit; }
+	int64_t getByteLimit() const { return queue->acknowledgements.bytesLimit; }
+
+	// Bytes sent to a remote client, and how many of them it has acknowledged so far
+	int64_t getBytesSent() const { return queue->acknowledgements.bytesSent; }
+	int64_t getBytesAcknowledged() const { return queue->acknowledgements.bytesAcknowledged; }
 
 	void operator=(const ReplyPromiseStream& rhs) {
 		rhs.queue->addPromiseRef();
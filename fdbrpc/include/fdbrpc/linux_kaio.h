@@ -47,6 +47,30 @@ struct linux_ioresult {
 	unsigned long result2;
 };
 
+// The kernel maps the completion ring into user memory, and the io_context_t returned by io_setup() points at it.
+struct linux_aio_ring {
+	unsigned id;
+	unsigned nr;
+	unsigned head;
+	unsigned tail;
+	unsigned magic;
+	unsigned compat_features;
+	unsigned incompat_features;
+	unsigned header_length;
+};
+
+enum { LINUX_AIO_RING_MAGIC = 0xa10a10a1 };
+
+// Returns whether io_getevents() would find completions, without making the system call. Errs on the side of
+// true if the ring doesn't look like one we understand.
+static bool io_ring_has_events(io_context_t ctx) {
+	linux_aio_ring* ring = reinterpret_cast<linux_aio_ring*>(ctx);
+	if (ring->magic != LINUX_AIO_RING_MAGIC) {
+		return true;
+	}
+	return __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) != __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+}
+
 static int io_setup(unsigned nr_events, io_context_t* ctxp) {
 	return syscall(__NR_io_setup, nr_events, ctxp);
 }
@@ -19,6 +19,7 @@
  */
 
 #include <string>
+#include <unordered_map>
 #include <utility>
 
 #include "flow/MkCert.h"
@@ -2387,9 +2388,10 @@ public:
 	}
 	ProcessInfo* getProcessByAddress(NetworkAddress const& address) override {
 		NetworkAddress normalizedAddress(address.ip, address.port, true, address.isTLS());
-		ASSERT(addressMap.count(normalizedAddress));
+		auto it = addressMap.find(normalizedAddress);
+		ASSERT(it != addressMap.end());
 		// NOTE: addressMap[normalizedAddress]->address may not equal to normalizedAddress
-		return addressMap[normalizedAddress];
+		return it->second;
 	}
 
 	MachineInfo* getMachineByNetworkAddress(NetworkAddress const& address) override {
@@ -2602,7 +2604,8 @@ public:
 	TaskPriority currentTaskID;
 
 	std::map<Optional<Standalone<StringRef>>, MachineInfo> machines;
-	std::map<NetworkAddress, ProcessInfo*> addressMap;
+	// Looked up for every connection and process access, and never iterated, so its order does not matter
+	std::unordered_map<NetworkAddress, ProcessInfo*> addressMap;
 	std::map<ProcessInfo*, Promise<Void>> filesDeadMap;
 
 	TaskQueue<PromiseTask> taskQueue;
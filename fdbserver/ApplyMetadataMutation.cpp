@@ -187,6 +187,10 @@ private:
 
 	std::shared_ptr<RangeLock> rangeLock = nullptr;
 
+	// The server tags needed to decode keyServers values, read once for all the keyServers changes of a batch rather
+	// than once for each. Reset whenever the batch changes a server tag.
+	Optional<RangeResult> serverTags;
+
 private:
 	bool dummyConfChange = false;
 
@@ -250,8 +254,10 @@ private:
 		std::vector<UID> src, dest;
 		// txnStateStore is always an in-memory KVS, and must always be recovered before
 		// applyMetadataMutations is called, so a wait here should never be needed.
-		Future<RangeResult> fResult = txnStateStore->readRange(serverTagKeys);
-		decodeKeyServersValue(fResult.get(), m.param2, src, dest);
+		if (!serverTags.present()) {
+			serverTags = txnStateStore->readRange(serverTagKeys).get();
+		}
+		decodeKeyServersValue(serverTags.get(), m.param2, src, dest);
 
 		ASSERT(storageCache);
 		ServerCacheInfo info;
@@ -314,6 +320,7 @@ private:
 
 		UID id = decodeServerTagKey(m.param1);
 		Tag tag = decodeServerTagValue(m.param2);
+		serverTags.reset();
 
 		// At this point, this tag will be visible to others
 		// So, acsBuilder should create an brand new acsState for this tag
@@ -831,6 +838,7 @@ private:
 		if (!serverTagKeys.intersects(range)) {
 			return;
 		}
+		serverTags.reset();
 		// Storage server removal always happens in a separate version from any prior writes (or any subsequent
 		// reuse of the tag) so we can safely destroy the tag here without any concern about intra-batch
 		// ordering
@@ -34,9 +34,11 @@
 #include "fdbserver/ServerDBInfo.h"
 #include "fdbserver/WaitFailure.h"
 #include "fdbserver/WorkerInterface.actor.h"
+#include "flow/CompressionUtils.h"
 #include "flow/Error.h"
 
 #include "flow/IRandom.h"
+#include "flow/UnitTest.h"
 #include "fdbclient/Tracing.h"
 #include "flow/actorcompiler.h" // This must be the last #include.
 
@@ -133,6 +135,7 @@ struct BackupData {
 	Version minKnownCommittedVersion;
 	Version savedVersion; // Largest version saved to blob storage
 	Version popVersion; // Largest version popped in NOOP mode, can be larger than savedVersion.
+	CompressionFilter logCompressionFilter = CompressionFilter::NONE; // Compresses blocks of saved mutation logs
 	Reference<AsyncVar<ServerDBInfo> const> db;
 	AsyncVar<Reference<ILogSystem>> logSystem;
 	Database cx;
@@ -296,6 +299,14 @@ struct BackupData {
 	    cc("BackupWorker", myId.toString()) {
 		cx = openDBOnServer(db, TaskPriority::DefaultEndpoint, LockAware::True);
 
+		CompressionFilter filter = CompressionUtils::fromFilterString(SERVER_KNOBS->BACKUP_LOG_COMPRESSION_FILTER);
+		if (CompressionUtils::supportedFilters.contains(filter)) {
+			logCompressionFilter = filter;
+		} else {
+			TraceEvent(SevWarn, "BackupWorkerLogCompressionDisabled", myId)
+			    .detail("Filter", SERVER_KNOBS->BACKUP_LOG_COMPRESSION_FILTER);
+		}
+
 		specialCounter(cc, "SavedVersion", [this]() { return this->savedVersion; });
 		specialCounter(cc, "MinKnownCommittedVersion", [this]() { return this->minKnownCommittedVersion; });
 		specialCounter(cc, "MsgQ", [this]() { return this->messages.size(); });
@@ -764,6 +775,150 @@ ACTOR Future<Void> addMutation(Reference<IBackupFile> logFile,
 	return Void();
 }
 
+// Mutations buffered for a log file written with BACKUP_LOG_COMPRESSION_FILTER, which is written a block at a time.
+// The mutations are encoded as addMutation() writes them, so a compressed block decompresses to what a plain block
+// of the same mutations would hold after its version.
+struct CompressedLogFile {
+	static constexpr int headerBytes = sizeof(PARTITIONED_MLOG_COMPRESSED_VERSION) + sizeof(uint8_t) + sizeof(int32_t);
+
+	Reference<IBackupFile> logFile;
+	int64_t blockEnd = 0;
+	std::string records;
+	std::vector<int> recordEnds; // End offset in records of each buffered mutation
+	double ratio = 1.0; // How well the last block compressed, which decides how much to buffer for the next one
+
+	explicit CompressedLogFile(Reference<IBackupFile> logFile) : logFile(logFile) {}
+
+	void add(const VersionedMessage& message, StringRef mutation) {
+		BinaryWriter wr(Unversioned());
+		wr << bigEndian64(message.version.version) << bigEndian32(message.version.sub) << bigEndian32(mutation.size());
+		records.append((const char*)wr.getData(), wr.getLength());
+		records.append((const char*)mutation.begin(), mutation.size());
+		recordEnds.push_back(records.size());
+	}
+
+	// Returns true if enough mutations are buffered to fill a block, going by how well the last block compressed.
+	bool blockReady(int blockSize) const { return records.size() >= (blockSize - headerBytes) * ratio; }
+
+	// Returns the next block, holding as many of the buffered mutations as compress to fit in it, and removes them
+	// from the buffer. Mutations which compress poorly are written as a plain PARTITIONED_MLOG_VERSION block instead.
+	Standalone<StringRef> encodeBlock(int blockSize, CompressionFilter filter) {
+		int count = recordEnds.size();
+		ASSERT(count > 0);
+		loop {
+			const int bytes = recordEnds[count - 1];
+			const StringRef data((const uint8_t*)records.data(), bytes);
+			Arena arena;
+			const StringRef compressed = CompressionUtils::compress(filter, data, arena);
+			BinaryWriter wr(Unversioned());
+			if (headerBytes + compressed.size() <= blockSize && compressed.size() < bytes) {
+				wr << PARTITIONED_MLOG_COMPRESSED_VERSION << uint8_t(filter) << bigEndian32(compressed.size());
+				wr.serializeBytes(compressed);
+				ratio = std::min((double)bytes / compressed.size(), SERVER_KNOBS->BACKUP_LOG_COMPRESSION_MAX_RATIO);
+			} else if (bytes + sizeof(PARTITIONED_MLOG_VERSION) <= blockSize || count == 1) {
+				wr << PARTITIONED_MLOG_VERSION;
+				wr.serializeBytes(data);
+				ratio = 1.0;
+			} else {
+				// Retry with the mutations expected to fit, going by how well these compressed
+				const int64_t fit = (int64_t)bytes * (blockSize - headerBytes) / compressed.size() * 9 / 10;
+				const int fitCount = std::upper_bound(recordEnds.begin(), recordEnds.begin() + count, fit) -
+				                     recordEnds.begin();
+				count = std::max(1, std::min(count - 1, fitCount));
+				continue;
+			}
+
+			records.erase(0, bytes);
+			recordEnds.erase(recordEnds.begin(), recordEnds.begin() + count);
+			for (int& end : recordEnds) {
+				end -= bytes;
+			}
+			return wr.toValue();
+		}
+	}
+};
+
+// Writes out blocks of the mutations buffered for a compressed log file while enough are buffered to fill a block, or
+// until none are left if flushing.
+ACTOR Future<Void> writeCompressedLogBlocks(CompressedLogFile* file,
+                                            int blockSize,
+                                            CompressionFilter filter,
+                                            bool flush) {
+	state Standalone<StringRef> block;
+	while (!file->recordEnds.empty() && (flush || file->blockReady(blockSize))) {
+		block = file->encodeBlock(blockSize, filter);
+
+		// Write padding for the previous block if needed
+		const int bytesLeft = file->blockEnd - file->logFile->size();
+		if (bytesLeft > 0) {
+			state Value paddingFFs = fileBackup::makePadding(bytesLeft);
+			wait(file->logFile->append(paddingFFs.begin(), bytesLeft));
+		}
+
+		file->blockEnd += blockSize;
+		wait(file->logFile->append(block.begin(), block.size()));
+	}
+	return Void();
+}
+
+// Buffers a mutation for a compressed log file, writing out blocks once enough mutations are buffered.
+Future<Void> addCompressedMutation(CompressedLogFile* file,
+                                   const VersionedMessage& message,
+                                   StringRef mutation,
+                                   int blockSize,
+                                   CompressionFilter filter) {
+	file->add(message, mutation);
+	return writeCompressedLogBlocks(file, blockSize, filter, false);
+}
+
+TEST_CASE("/fdbserver/BackupWorker/CompressedLogBlocks") {
+	if (!CompressionUtils::supportedFilters.contains(CompressionFilter::ZSTD)) {
+		return Void();
+	}
+	const int blockSize = deterministicRandom()->randomInt(1000, 100000);
+	CompressedLogFile file{ Reference<IBackupFile>() };
+	std::vector<std::string> mutations;
+	for (int i = 0; i < 1000; i++) {
+		// A mix of mutations which compress well and poorly
+		const int size = deterministicRandom()->randomInt(1, 500);
+		mutations.push_back(deterministicRandom()->coinflip() ? std::string(size, 'm')
+		                                                      : deterministicRandom()->randomAlphaNumeric(size));
+		file.add(VersionedMessage(LogMessageVersion(i, i % 3), StringRef(), VectorRef<Tag>(), Arena()),
+		         StringRef(mutations.back()));
+	}
+
+	int decoded = 0;
+	while (!file.recordEnds.empty()) {
+		Standalone<StringRef> block = file.encodeBlock(blockSize, CompressionFilter::ZSTD);
+		ASSERT_LE(block.size(), blockSize);
+		Arena arena;
+		StringRefReader reader(decodePartitionedLogBlock(block, arena), restore_corrupted_data());
+		while (!reader.eof()) {
+			ASSERT_EQ(reader.consumeNetworkUInt64(), decoded);
+			ASSERT_EQ(reader.consumeNetworkUInt32(), decoded % 3);
+			const uint32_t len = reader.consumeNetworkUInt32();
+			ASSERT(StringRef(reader.consume(len), len) == StringRef(mutations[decoded]));
+			decoded++;
+		}
+	}
+	ASSERT_EQ(decoded, (int)mutations.size());
+
+	// Compressed lengths which do not fit in the block are rejected
+	for (int32_t len : { -1, 10 }) {
+		BinaryWriter wr(Unversioned());
+		wr << PARTITIONED_MLOG_COMPRESSED_VERSION << uint8_t(CompressionFilter::ZSTD) << bigEndian32((uint32_t)len);
+		wr.serializeBytes("short"_sr);
+		Arena arena;
+		try {
+			decodePartitionedLogBlock(wr.toValue(), arena);
+			ASSERT(false);
+		} catch (Error& e) {
+			ASSERT_EQ(e.code(), error_code_restore_corrupted_data);
+		}
+	}
+	return Void();
+}
+
 ACTOR static Future<Void> updateLogBytesWritten(BackupData* self,
                                                 std::vector<UID> backupUids,
                                                 std::vector<Reference<IBackupFile>> logFiles) {
@@ -789,7 +944,8 @@ ACTOR static Future<Void> updateLogBytesWritten(BackupData* self,
 }
 
 // Saves messages in the range of [0, numMsg) to a file and then remove these
-// messages. The file content format is a sequence of (Version, sub#, msgSize, message).
+// messages. The file content format is a sequence of (Version, sub#, msgSize, message),
+// compressed a block at a time if BACKUP_LOG_COMPRESSION_FILTER is set.
 // Note only ready backups are saved.
 ACTOR Future<Void> saveMutationsToFile(BackupData* self,
                                        Version popVersion,
@@ -799,6 +955,7 @@ ACTOR Future<Void> saveMutationsToFile(BackupData* self,
 	state std::vector<Future<Reference<IBackupFile>>> logFileFutures;
 	state std::vector<Reference<IBackupFile>> logFiles;
 	state std::vector<int64_t> blockEnds;
+	state std::vector<CompressedLogFile> compressedFiles; // Used instead of blockEnds if compressing
 	state std::vector<UID> activeUids; // active Backups' UIDs
 	state std::vector<Version> beginVersions; // logFiles' begin versions
 	state KeyRangeMap<std::set<int>> keyRangeMap; // range to index in logFileFutures, logFiles, & blockEnds
@@ -856,6 +1013,11 @@ ACTOR Future<Void> saveMutationsToFile(BackupData* self,
 	}
 
 	blockEnds = std::vector<int64_t>(logFiles.size(), 0);
+	if (self->logCompressionFilter != CompressionFilter::NONE) {
+		for (const auto& logFile : logFiles) {
+			compressedFiles.emplace_back(logFile);
+		}
+	}
 	for (idx = 0; idx < numMsg; idx++) {
 		auto& message = self->messages[idx];
 		MutationRef m;
@@ -869,9 +1031,15 @@ ACTOR Future<Void> saveMutationsToFile(BackupData* self,
 		std::vector<Future<Void>> adds;
 		if (m.type != MutationRef::Type::ClearRange) {
 			for (int index : keyRangeMap[m.param1]) {
-				if (message.getVersion() >= beginVersions[index]) {
+				if (message.getVersion() < beginVersions[index]) {
+					continue;
+				}
+				if (compressedFiles.empty()) {
 					adds.push_back(
 					    addMutation(logFiles[index], message, message.message, &blockEnds[index], blockSize));
+				} else {
+					adds.push_back(addCompressedMutation(
+					    &compressedFiles[index], message, message.message, blockSize, self->logCompressionFilter));
 				}
 			}
 		} else {
@@ -887,9 +1055,15 @@ ACTOR Future<Void> saveMutationsToFile(BackupData* self,
 				wr << subm;
 				mutations.push_back(wr.toValue());
 				for (int index : range.value()) {
-					if (message.getVersion() >= beginVersions[index]) {
+					if (message.getVersion() < beginVersions[index]) {
+						continue;
+					}
+					if (compressedFiles.empty()) {
 						adds.push_back(
 						    addMutation(logFiles[index], message, mutations.back(), &blockEnds[index], blockSize));
+					} else {
+						adds.push_back(addCompressedMutation(
+						    &compressedFiles[index], message, mutations.back(), blockSize, self->logCompressionFilter));
 					}
 				}
 			}
@@ -898,6 +1072,12 @@ ACTOR Future<Void> saveMutationsToFile(BackupData* self,
 		mutations.clear();
 	}
 
+	std::vector<Future<Void>> flushes;
+	for (auto& file : compressedFiles) {
+		flushes.push_back(writeCompressedLogBlocks(&file, blockSize, self->logCompressionFilter, true));
+	}
+	wait(waitForAll(flushes));
+
 	std::vector<Future<Void>> finished;
 	std::transform(logFiles.begin(), logFiles.end(), std::back_inserter(finished), [](const Reference<IBackupFile>& f) {
 		return f->finish();
@@ -378,15 +378,37 @@ ACTOR Future<BulkLoadFileSet> bulkLoadDownloadTaskFileSet(BulkLoadTransportMetho
 	}
 }
 
+// Downloads a file set once the lock allows, so that the file sets of a task are downloaded a few at a time.
+ACTOR static Future<BulkLoadFileSet> bulkLoadDownloadTaskFileSetWithLock(FlowLock* lock,
+                                                                         BulkLoadTransportMethod transportMethod,
+                                                                         BulkLoadFileSet fromRemoteFileSet,
+                                                                         std::string toLocalRoot,
+                                                                         UID logId) {
+	wait(lock->take());
+	state FlowLock::Releaser releaser(*lock);
+	BulkLoadFileSet localFileSet =
+	    wait(bulkLoadDownloadTaskFileSet(transportMethod, fromRemoteFileSet, toLocalRoot, logId));
+	return localFileSet;
+}
+
 ACTOR Future<Void> bulkLoadDownloadTaskFileSets(BulkLoadTransportMethod transportMethod,
                                                 std::shared_ptr<BulkLoadFileSetKeyMap> fromRemoteFileSets,
                                                 std::shared_ptr<BulkLoadFileSetKeyMap> localFileSets,
                                                 std::string toLocalRoot,
                                                 UID logId) {
-	state BulkLoadFileSetKeyMap::iterator iter = fromRemoteFileSets->begin();
-	state KeyRange keys;
-	for (; iter != fromRemoteFileSets->end(); iter++) {
-		keys = iter->first;
+	state FlowLock downloadLock(SERVER_KNOBS->BULKLOAD_DOWNLOAD_FILESET_PARALLELISM);
+	state std::vector<Future<BulkLoadFileSet>> downloads;
+	for (const auto& remoteFileSet : *fromRemoteFileSets) {
+		if (remoteFileSet.second.hasDataFile()) {
+			downloads.push_back(bulkLoadDownloadTaskFileSetWithLock(
+			    &downloadLock, transportMethod, remoteFileSet.second, toLocalRoot, logId));
+		}
+	}
+	wait(waitForAll(downloads));
+
+	int downloadIndex = 0;
+	for (auto iter = fromRemoteFileSets->begin(); iter != fromRemoteFileSets->end(); iter++) {
+		const KeyRange& keys = iter->first;
 		if (!iter->second.hasDataFile()) {
 			// For empty ranges (no data file), create an empty local fileSet entry so FetchKeys knows this range was
 			// processed
@@ -403,9 +425,7 @@ ACTOR Future<Void> bulkLoadDownloadTaskFileSets(BulkLoadTransportMethod transpor
 			localFileSets->push_back(std::make_pair(keys, emptyLocalFileSet));
 			continue;
 		}
-		BulkLoadFileSet localFileSet =
-		    wait(bulkLoadDownloadTaskFileSet(transportMethod, iter->second, toLocalRoot, logId));
-		localFileSets->push_back(std::make_pair(keys, localFileSet));
+		localFileSets->push_back(std::make_pair(keys, downloads[downloadIndex++].get()));
 	}
 	return Void();
 }
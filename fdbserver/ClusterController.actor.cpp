@@ -1594,6 +1594,10 @@ ACTOR Future<Void> statusServer(FutureStream<StatusRequest> requests,
 	// Place to accumulate a batch of requests to respond to
 	state std::vector<StatusRequest> requests_batch;
 
+	// The last status generated, and when, to answer requests which arrive within STATUS_CACHE_TIME of it
+	state Optional<StatusReply> cachedStatus;
+	state double cachedStatusTime = 0.0;
+
 	loop {
 		try {
 			// Wait til first request is ready
@@ -1626,48 +1630,63 @@ ACTOR Future<Void> statusServer(FutureStream<StatusRequest> requests,
 				}
 			}
 
-			// Get status but trap errors to send back to client.
-			std::vector<WorkerDetails> workers;
-			std::vector<ProcessIssues> workerIssues;
+			state ErrorOr<StatusReply> result;
+			if (SERVER_KNOBS->STATUS_CACHE_TIME > 0.0 && cachedStatus.present() &&
+			    now() - cachedStatusTime < SERVER_KNOBS->STATUS_CACHE_TIME) {
+				// Generating status fetches metrics from every worker, so frequent pollers share one result
+				CODE_PROBE(true, "Status request answered from the cached status");
+				result = cachedStatus.get();
+			} else {
+				// Get status but trap errors to send back to client.
+				std::vector<WorkerDetails> workers;
+				std::vector<ProcessIssues> workerIssues;
+
+				for (auto& it : self->id_worker) {
+					workers.push_back(it.second.details);
+					if (it.second.issues.size()) {
+						workerIssues.emplace_back(it.second.details.interf.address(), it.second.issues);
+					}
+				}
 
-			for (auto& it : self->id_worker) {
-				workers.push_back(it.second.details);
-				if (it.second.issues.size()) {
-					workerIssues.emplace_back(it.second.details.interf.address(), it.second.issues);
+				std::vector<NetworkAddress> incompatibleConnections;
+				for (auto it = self->db.incompatibleConnections.begin();
+				     it != self->db.incompatibleConnections.end();) {
+					if (it->second < now()) {
+						it = self->db.incompatibleConnections.erase(it);
+					} else {
+						incompatibleConnections.push_back(it->first);
+						it++;
+					}
 				}
-			}
 
-			std::vector<NetworkAddress> incompatibleConnections;
-			for (auto it = self->db.incompatibleConnections.begin(); it != self->db.incompatibleConnections.end();) {
-				if (it->second < now()) {
-					it = self->db.incompatibleConnections.erase(it);
-				} else {
-					incompatibleConnections.push_back(it->first);
-					it++;
+				wait(store(result,
+				           errorOr(clusterGetStatus(self->db.serverInfo,
+				                                    self->cx,
+				                                    workers,
+				                                    workerIssues,
+				                                    self->storageStatusInfos,
+				                                    &self->db.clientStatus,
+				                                    coordinators,
+				                                    incompatibleConnections,
+				                                    self->datacenterVersionDifference,
+				                                    self->dcLogServerVersionDifference,
+				                                    self->dcStorageServerVersionDifference,
+				                                    configBroadcaster,
+				                                    self->excludedDegradedServers))));
+
+				if (result.isError() && result.getError().code() == error_code_actor_cancelled)
+					throw result.getError();
+
+				// Update last_request_time now because GetStatus is finished and the delay is to be measured between
+				// requests
+				last_request_time = now();
+
+				if (!result.isError()) {
+					cachedStatus = result.get();
+					cachedStatusTime = now();
 				}
 			}
 
-			state ErrorOr<StatusReply> result = wait(errorOr(clusterGetStatus(self->db.serverInfo,
-			                                                                  self->cx,
-			                                                                  workers,
-			                                                                  workerIssues,
-			                                                                  self->storageStatusInfos,
-			                                                                  &self->db.clientStatus,
-			                                                                  coordinators,
-			                                                                  incompatibleConnections,
-			                                                                  self->datacenterVersionDifference,
-			                                                                  self->dcLogServerVersionDifference,
-			                                                                  self->dcStorageServerVersionDifference,
-			                                                                  configBroadcaster,
-			                                                                  self->excludedDegradedServers)));
-
-			if (result.isError() && result.getError().code() == error_code_actor_cancelled)
-				throw result.getError();
-
-			// Update last_request_time now because GetStatus is finished and the delay is to be measured between
-			// requests
-			last_request_time = now();
-
 			state Optional<StatusReply> faultToleranceRelatedStatus;
 			while (!requests_batch.empty()) {
 				if (result.isError())
@@ -19,6 +19,7 @@
  */
 
 #include <cmath>
+#include <deque>
 #include <utility>
 
 #include "fdbclient/FDBTypes.h"
@@ -1313,7 +1314,8 @@ ACTOR Future<Void> sendInitialCommitToResolvers(Reference<ClusterRecoveryData> s
 	    self->txnStateStore
 	        ->readRange(txnKeys, BUGGIFY ? 3 : SERVER_KNOBS->DESIRED_TOTAL_BYTES, SERVER_KNOBS->DESIRED_TOTAL_BYTES)
 	        .get();
-	state std::vector<Future<Void>> txnReplies;
+	// Replies to the parts still being broadcast, with the memory each holds, oldest first
+	state std::deque<std::pair<Future<Void>, int64_t>> txnReplies;
 	state int64_t dataOutstanding = 0;
 
 	state std::vector<Endpoint> endpoints;
@@ -1341,20 +1343,26 @@ ACTOR Future<Void> sendInitialCommitToResolvers(Reference<ClusterRecoveryData> s
 		req.sequence = txnSequence;
 		req.last = !nextData.size();
 		req.broadcastInfo = endpoints;
-		txnReplies.push_back(broadcastTxnRequest(req, SERVER_KNOBS->TXN_STATE_SEND_AMOUNT, false));
-		dataOutstanding += SERVER_KNOBS->TXN_STATE_SEND_AMOUNT * data.arena().getSize();
+		int64_t partMemory = SERVER_KNOBS->TXN_STATE_SEND_AMOUNT * data.arena().getSize();
+		txnReplies.emplace_back(broadcastTxnRequest(req, SERVER_KNOBS->TXN_STATE_SEND_AMOUNT, false), partMemory);
+		dataOutstanding += partMemory;
 		data = nextData;
 		txnSequence++;
 
-		if (dataOutstanding > SERVER_KNOBS->MAX_TXS_SEND_MEMORY) {
-			wait(waitForAll(txnReplies));
-			txnReplies = std::vector<Future<Void>>();
-			dataOutstanding = 0;
+		// Keep the pipeline full: rather than draining every outstanding part once the limit is hit, only wait for
+		// the oldest parts until there is room for the next one.
+		while (dataOutstanding > SERVER_KNOBS->MAX_TXS_SEND_MEMORY) {
+			wait(txnReplies.front().first);
+			dataOutstanding -= txnReplies.front().second;
+			txnReplies.pop_front();
 		}
 
 		wait(yield());
 	}
-	wait(waitForAll(txnReplies));
+	while (!txnReplies.empty()) {
+		wait(txnReplies.front().first);
+		txnReplies.pop_front();
+	}
 	TraceEvent("RecoveryInternal", self->dbgid)
 	    .detail("StatusCode", RecoveryStatus::recovery_transaction)
 	    .detail("Status", RecoveryStatus::names[RecoveryStatus::recovery_transaction])
@@ -1531,6 +1539,12 @@ ACTOR Future<Void> recoverFrom(Reference<ClusterRecoveryData> self,
 ACTOR Future<Void> clusterRecoveryCore(Reference<ClusterRecoveryData> self) {
 	state TraceInterval recoveryInterval("ClusterRecovery");
 	state double recoverStartTime = now();
+	// Times at which recovery milestones were reached, reported with the recovery duration
+	state double cstateReadTime = 0;
+	state double cstateLockedTime = 0;
+	state double oldLogsLockedTime = 0;
+	state double recruitedTime = 0;
+	state double recoveryCommittedTime = 0;
 
 	self->addActor.send(waitFailureServer(self->masterInterface.waitFailure.getFuture()));
 
@@ -1543,6 +1557,7 @@ ACTOR Future<Void> clusterRecoveryCore(Reference<ClusterRecoveryData> self) {
 	    .trackLatest(self->clusterRecoveryStateEventHolder->trackingKey);
 
 	wait(self->cstate.read());
+	cstateReadTime = now();
 
 	// Unless the cluster database is 'empty', the cluster's EncryptionAtRest status is readable once cstate is
 	// recovered
@@ -1616,6 +1631,7 @@ ACTOR Future<Void> clusterRecoveryCore(Reference<ClusterRecoveryData> self) {
 		newState.lowestCompatibleProtocolVersion = minCompatibleProtocolVersion;
 	}
 	wait(self->cstate.write(newState) || recoverAndEndEpoch);
+	cstateLockedTime = now();
 
 	TraceEvent("ProtocolVersionCompatibilityChecked", self->dbgid)
 	    .detail("NewestProtocolVersion", self->cstate.myDBState.newestProtocolVersion)
@@ -1635,6 +1651,7 @@ ACTOR Future<Void> clusterRecoveryCore(Reference<ClusterRecoveryData> self) {
 		if (oldLogSystem) {
 			logChanges = triggerUpdates(self, oldLogSystem);
 			if (!minRecoveryDuration.isValid()) {
+				oldLogsLockedTime = now();
 				minRecoveryDuration = delay(SERVER_KNOBS->ENFORCED_MIN_RECOVERY_DURATION);
 				poppedTxsVersion = oldLogSystem->getTxsPoppedVersion();
 			}
@@ -1660,6 +1677,7 @@ ACTOR Future<Void> clusterRecoveryCore(Reference<ClusterRecoveryData> self) {
 		}
 	}
 
+	recruitedTime = now();
 	if (self->neverCreated) {
 		recoverStartTime = now();
 	}
@@ -1802,6 +1820,7 @@ ACTOR Future<Void> clusterRecoveryCore(Reference<ClusterRecoveryData> self) {
 		CODE_PROBE(true, "Cluster recovery failed because of the initial commit failed");
 		throw cluster_recovery_failed();
 	}
+	recoveryCommittedTime = now();
 
 	ASSERT(self->recoveryTransactionVersion != 0);
 
@@ -1843,11 +1862,22 @@ ACTOR Future<Void> clusterRecoveryCore(Reference<ClusterRecoveryData> self) {
 	self->recoveryState = RecoveryState::ACCEPTING_COMMITS;
 	double recoveryDuration = now() - recoverStartTime;
 
-	TraceEvent((recoveryDuration > 4 && !g_network->isSimulated()) ? SevWarnAlways : SevInfo,
-	           getRecoveryEventName(ClusterRecoveryEventType::CLUSTER_RECOVERY_DURATION_EVENT_NAME).c_str(),
-	           self->dbgid)
-	    .detail("RecoveryDuration", recoveryDuration)
-	    .trackLatest(self->clusterRecoveryDurationEventHolder->trackingKey);
+	{
+		TraceEvent durationEvent(
+		    (recoveryDuration > 4 && !g_network->isSimulated()) ? SevWarnAlways : SevInfo,
+		    getRecoveryEventName(ClusterRecoveryEventType::CLUSTER_RECOVERY_DURATION_EVENT_NAME).c_str(),
+		    self->dbgid);
+		durationEvent.detail("RecoveryDuration", recoveryDuration);
+		// A new database's recovery is timed from after recruitment, so the earlier milestones do not apply
+		if (!self->neverCreated) {
+			durationEvent.detail("CoordinatedStateRead", cstateReadTime - recoverStartTime)
+			    .detail("CoordinatedStateLocked", cstateLockedTime - recoverStartTime)
+			    .detail("OldLogsLocked", oldLogsLockedTime - recoverStartTime)
+			    .detail("TransactionServersRecruited", recruitedTime - recoverStartTime);
+		}
+		durationEvent.detail("RecoveryTransactionCommitted", recoveryCommittedTime - recoverStartTime)
+		    .trackLatest(self->clusterRecoveryDurationEventHolder->trackingKey);
+	}
 
 	TraceEvent(getRecoveryEventName(ClusterRecoveryEventType::CLUSTER_RECOVERY_STATE_EVENT_NAME).c_str(), self->dbgid)
 	    .detail("StatusCode", RecoveryStatus::accepting_commits)
@@ -274,7 +274,6 @@ struct ResolutionRequestBuilder {
 ACTOR Future<Void> commitBatcher(ProxyCommitData* commitData,
                                  PromiseStream<std::pair<std::vector<CommitTransactionRequest>, int>> out,
                                  FutureStream<CommitTransactionRequest> in,
-                                 int desiredBytes,
                                  int64_t memBytesLimit) {
 	wait(delayJittered(commitData->commitBatchInterval, TaskPriority::ProxyCommitBatcher));
 
@@ -284,6 +283,7 @@ ACTOR Future<Void> commitBatcher(ProxyCommitData* commitData,
 		state Future<Void> timeout;
 		state std::vector<CommitTransactionRequest> batch;
 		state int batchBytes = 0;
+		state int desiredBytes = commitData->commitBatchDesiredBytes;
 		// TODO: Enable this assertion (currently failing with gcc)
 		// static_assert(std::is_nothrow_move_constructible_v<CommitTransactionRequest>);
 
@@ -551,6 +551,9 @@ struct CommitBatchContext {
 	Future<Void> releaseDelay;
 	Future<Void> releaseFuture;
 
+	double resolutionLatency = 0;
+	double loggingLatency = 0;
+
 	std::vector<ResolveTransactionBatchReply> resolution;
 
 	double computeStart;
@@ -816,6 +819,42 @@ double computeReleaseDelay(CommitBatchContext* self, double latencyBucket) {
 	                self->batchOperations * self->pProxyCommitData->commitComputePerOperation[latencyBucket]);
 }
 
+// Chooses the next batch interval and byte target from the smoothed resolution and TLog push latencies. While
+// more batches are queued behind this one than COMMIT_BATCH_ADAPTIVE_QUEUED_BATCHES, the proxy is throughput
+// bound and batches grow; otherwise they shrink back toward the minimums to keep commit latency low.
+void updateAdaptiveCommitBatching(CommitBatchContext* self) {
+	ProxyCommitData* const pProxyCommitData = self->pProxyCommitData;
+	const double alpha = SERVER_KNOBS->COMMIT_TRANSACTION_BATCH_INTERVAL_SMOOTHER_ALPHA;
+	pProxyCommitData->smoothedResolutionLatency =
+	    alpha * self->resolutionLatency + (1 - alpha) * pProxyCommitData->smoothedResolutionLatency;
+	pProxyCommitData->smoothedLoggingLatency =
+	    alpha * self->loggingLatency + (1 - alpha) * pProxyCommitData->smoothedLoggingLatency;
+
+	const bool backlogged = pProxyCommitData->localCommitBatchesStarted - self->localBatchNumber >
+	                        SERVER_KNOBS->COMMIT_BATCH_ADAPTIVE_QUEUED_BATCHES;
+	CODE_PROBE(backlogged, "Adaptive commit batching grows batches");
+
+	double targetInterval = SERVER_KNOBS->COMMIT_TRANSACTION_BATCH_INTERVAL_LATENCY_FRACTION *
+	                        (pProxyCommitData->smoothedResolutionLatency + pProxyCommitData->smoothedLoggingLatency);
+	double desiredBytes = pProxyCommitData->commitBatchDesiredBytes;
+	if (backlogged) {
+		targetInterval *= SERVER_KNOBS->COMMIT_BATCH_ADAPTIVE_GROWTH;
+		desiredBytes *= SERVER_KNOBS->COMMIT_BATCH_ADAPTIVE_GROWTH;
+	} else {
+		desiredBytes /= SERVER_KNOBS->COMMIT_BATCH_ADAPTIVE_GROWTH;
+	}
+
+	pProxyCommitData->commitBatchInterval =
+	    std::clamp(alpha * targetInterval + (1 - alpha) * pProxyCommitData->commitBatchInterval,
+	               SERVER_KNOBS->COMMIT_TRANSACTION_BATCH_INTERVAL_MIN,
+	               SERVER_KNOBS->COMMIT_TRANSACTION_BATCH_INTERVAL_MAX);
+	pProxyCommitData->commitBatchDesiredBytes =
+	    (int)std::clamp<double>(desiredBytes,
+	                            SERVER_KNOBS->COMMIT_TRANSACTION_BATCH_BYTES_MIN,
+	                            std::max(SERVER_KNOBS->COMMIT_TRANSACTION_BATCH_BYTES_MIN,
+	                                     SERVER_KNOBS->COMMIT_BATCH_ADAPTIVE_BYTES_MAX));
+}
+
 ACTOR Future<Void> preresolutionProcessing(CommitBatchContext* self) {
 
 	state ProxyCommitData* const pProxyCommitData = self->pProxyCommitData;
@@ -868,7 +907,14 @@ ACTOR Future<Void> preresolutionProcessing(CommitBatchContext* self) {
 		return Void();
 	}
 
-	self->releaseDelay = delay(computeReleaseDelay(self, latencyBucket), TaskPriority::ProxyMasterVersionReply);
+	if (SERVER_KNOBS->PROXY_PIPELINED_RESOLUTION) {
+		// Resolution of the following batches overlaps with this batch's post-resolution processing and log push;
+		// only their post-resolution processing has to wait for this batch (see postResolution()).
+		self->releaseDelay = pProxyCommitData->latestLocalCommitBatchLogging.whenAtLeast(
+		    localBatchNumber - std::max(1, SERVER_KNOBS->PROXY_PIPELINED_RESOLUTION_DEPTH));
+	} else {
+		self->releaseDelay = delay(computeReleaseDelay(self, latencyBucket), TaskPriority::ProxyMasterVersionReply);
+	}
 
 	if (debugID.present()) {
 		g_traceBatch.addEvent(
@@ -895,8 +941,9 @@ ACTOR Future<Void> preresolutionProcessing(CommitBatchContext* self) {
 
 	pProxyCommitData->stats.txnCommitVersionAssigned += trs.size();
 	pProxyCommitData->stats.lastCommitVersionAssigned = versionReply.version;
-	pProxyCommitData->stats.getCommitVersionDist->sampleSeconds(g_network->timer_monotonic() -
-	                                                            beforeGettingCommitVersion);
+	double getCommitVersionLatency = g_network->timer_monotonic() - beforeGettingCommitVersion;
+	pProxyCommitData->stats.getCommitVersionDist->sampleSeconds(getCommitVersionLatency);
+	pProxyCommitData->stats.getCommitVersionSample.addMeasurement(getCommitVersionLatency);
 
 	self->commitVersion = versionReply.version;
 	self->prevVersion = versionReply.prevVersion;
@@ -1011,7 +1058,9 @@ ACTOR Future<Void> getResolution(CommitBatchContext* self) {
 	std::vector<ResolveTransactionBatchReply> resolutionResp = wait(getAll(replies));
 	self->resolution.swap(*const_cast<std::vector<ResolveTransactionBatchReply>*>(&resolutionResp));
 
-	self->pProxyCommitData->stats.resolutionDist->sampleSeconds(g_network->timer_monotonic() - resolutionStart);
+	self->resolutionLatency = g_network->timer_monotonic() - resolutionStart;
+	self->pProxyCommitData->stats.resolutionDist->sampleSeconds(self->resolutionLatency);
+	self->pProxyCommitData->stats.resolutionSample.addMeasurement(self->resolutionLatency);
 	if (self->debugID.present()) {
 		g_traceBatch.addEvent(
 		    "CommitDebug", self->debugID.get().first(), "CommitProxyServer.commitBatch.AfterResolution");
@@ -1404,6 +1453,11 @@ void rejectMutationsForReadLockOnRange(CommitBatchContext* self) {
 ACTOR Future<Void> assignMutationsToStorageServers(CommitBatchContext* self) {
 	state ProxyCommitData* const pProxyCommitData = self->pProxyCommitData;
 	state std::vector<CommitTransactionRequest>& trs = self->trs;
+	// The shard the last mutation fell in. Mutations of a batch often land in the same shard as the one before, and
+	// this saves a descent of keyInfo for each of them. keyInfo does not change while this actor runs, except across
+	// a yield, so the cache is dropped whenever it yields.
+	state KeyRangeRef lastShard;
+	state ServerCacheInfo* lastShardInfo = nullptr;
 
 	for (; self->transactionNum < trs.size(); self->transactionNum++) {
 		if (!(self->committed[self->transactionNum] == ConflictBatch::TransactionCommitted &&
@@ -1430,6 +1484,7 @@ ACTOR Future<Void> assignMutationsToStorageServers(CommitBatchContext* self) {
 				self->yieldBytes = 0;
 				if (g_network->check_yield(TaskPriority::ProxyCommitYield1)) {
 					self->computeDuration += g_network->timer_monotonic() - self->computeStart;
+					lastShardInfo = nullptr;
 					wait(delay(0, TaskPriority::ProxyCommitYield1));
 					self->computeStart = g_network->timer_monotonic();
 				}
@@ -1447,19 +1502,25 @@ ACTOR Future<Void> assignMutationsToStorageServers(CommitBatchContext* self) {
 			// Determine the set of tags (responsible storage servers) for the mutation, splitting it
 			// if necessary.  Serialize (splits of) the mutation into the message buffer and add the tags.
 			if (isSingleKeyMutation((MutationRef::Type)m.type)) {
-				auto& tags = pProxyCommitData->tagsForKey(m.param1);
+				if (lastShardInfo == nullptr || !lastShard.contains(m.param1)) {
+					auto shard = pProxyCommitData->keyInfo.rangeContaining(m.param1);
+					shard.value().populateTags();
+					lastShard = shard.range();
+					lastShardInfo = &shard.value();
+				}
+				auto& tags = lastShardInfo->tags;
 
 				// sample single key mutation based on cost
 				// the expectation of sampling is every COMMIT_SAMPLE_COST sample once
 				if (checkSample) {
 					double totalCosts = trCost->get().writeCosts;
-					double cost = getWriteOperationCost(m.expectedSize());
+					double cost = getMutationOperationCost(m);
 					double mul = std::max(1.0, totalCosts / std::max(1.0, (double)CLIENT_KNOBS->COMMIT_SAMPLE_COST));
 					ASSERT(totalCosts > 0);
 					double prob = mul * cost / totalCosts;
 
 					if (deterministicRandom()->random01() < prob) {
-						const auto& storageServers = pProxyCommitData->keyInfo[m.param1].src_info;
+						const auto& storageServers = lastShardInfo->src_info;
 						for (const auto& ssInfo : storageServers) {
 							auto id = ssInfo->interf.id();
 							// scale cost
@@ -1471,7 +1532,7 @@ ACTOR Future<Void> assignMutationsToStorageServers(CommitBatchContext* self) {
 				}
 
 				if (pProxyCommitData->singleKeyMutationEvent->enabled) {
-					KeyRangeRef shard = pProxyCommitData->keyInfo.rangeContaining(m.param1).range();
+					KeyRangeRef shard = lastShard;
 					pProxyCommitData->singleKeyMutationEvent->tag1 = (int64_t)tags[0].id;
 					pProxyCommitData->singleKeyMutationEvent->tag2 = (int64_t)tags[1].id;
 					pProxyCommitData->singleKeyMutationEvent->tag3 = (int64_t)tags[2].id;
@@ -1626,6 +1687,7 @@ ACTOR Future<Void> postResolution(CommitBatchContext* self) {
 	wait(pProxyCommitData->latestLocalCommitBatchLogging.whenAtLeast(localBatchNumber - 1));
 	state double postResolutionQueuing = g_network->timer_monotonic();
 	pProxyCommitData->stats.postResolutionDist->sampleSeconds(postResolutionQueuing - postResolutionStart);
+	pProxyCommitData->stats.postResolutionSample.addMeasurement(postResolutionQueuing - postResolutionStart);
 	wait(yield(TaskPriority::ProxyCommitYield1));
 
 	self->computeStart = g_network->timer_monotonic();
@@ -1739,19 +1801,28 @@ ACTOR Future<Void> postResolution(CommitBatchContext* self) {
 	    pProxyCommitData->db->get().logSystemConfig.numLogs() == self->tpcvMap.size()) {
 		state int i = 0;
 		for (i = 0; i < pProxyCommitData->idempotencyClears.size(); i++) {
-			auto& tags = pProxyCommitData->tagsForKey(pProxyCommitData->idempotencyClears[i].param1);
-			self->toCommit.addTags(tags);
+			// Adjacent idempotency clears are merged, so a clear can extend past a shard boundary
+			MutationRef& clear = pProxyCommitData->idempotencyClears[i];
+			std::set<Tag> allSources;
+			auto range = pProxyCommitData->keyInfo.rangeContaining(clear.param1);
+			CODE_PROBE(range.end() < clear.param2, "An idempotency clear extends past a shard boundary");
+			while (range.begin() < clear.param2) {
+				range.value().populateTags();
+				allSources.insert(range.value().tags.begin(), range.value().tags.end());
+				++range;
+			}
+			self->toCommit.addTags(allSources);
 			if (pProxyCommitData->acsBuilder != nullptr) {
 				updateMutationWithAcsAndAddMutationToAcsBuilder(
 				    pProxyCommitData->acsBuilder,
-				    pProxyCommitData->idempotencyClears[i],
-				    tags,
+				    clear,
+				    allSources,
 				    getCommitProxyAccumulativeChecksumIndex(pProxyCommitData->commitProxyIndex),
 				    pProxyCommitData->epoch,
 				    self->commitVersion,
 				    pProxyCommitData->dbgid);
 			}
-			WriteMutationRefVar var = writeMutation(self, &pProxyCommitData->idempotencyClears[i]);
+			WriteMutationRefVar var = writeMutation(self, &clear);
 			ASSERT(std::holds_alternative<MutationRef>(var));
 		}
 		pProxyCommitData->idempotencyClears = Standalone<VectorRef<MutationRef>>();
@@ -1897,7 +1968,9 @@ ACTOR Future<Void> postResolution(CommitBatchContext* self) {
 		}
 	}
 
-	pProxyCommitData->stats.processingMutationDist->sampleSeconds(g_network->timer_monotonic() - postResolutionQueuing);
+	double processingMutationLatency = g_network->timer_monotonic() - postResolutionQueuing;
+	pProxyCommitData->stats.processingMutationDist->sampleSeconds(processingMutationLatency);
+	pProxyCommitData->stats.processingMutationSample.addMeasurement(processingMutationLatency);
 	return Void();
 }
 
@@ -1939,7 +2012,9 @@ ACTOR Future<Void> transactionLogging(CommitBatchContext* self) {
 		pProxyCommitData->txsPopVersions.emplace_back(self->commitVersion, self->msg.popTo);
 	}
 	pProxyCommitData->logSystem->popTxs(self->msg.popTo);
-	pProxyCommitData->stats.tlogLoggingDist->sampleSeconds(g_network->timer_monotonic() - tLoggingStart);
+	self->loggingLatency = g_network->timer_monotonic() - tLoggingStart;
+	pProxyCommitData->stats.tlogLoggingDist->sampleSeconds(self->loggingLatency);
+	pProxyCommitData->stats.tlogLoggingSample.addMeasurement(self->loggingLatency);
 	return Void();
 }
 
@@ -2132,19 +2207,26 @@ ACTOR Future<Void> reply(CommitBatchContext* self) {
 	}
 
 	// Dynamic batching for commits
-	double target_latency =
-	    (now() - self->startTime) * SERVER_KNOBS->COMMIT_TRANSACTION_BATCH_INTERVAL_LATENCY_FRACTION;
-	pProxyCommitData->commitBatchInterval =
-	    std::max(SERVER_KNOBS->COMMIT_TRANSACTION_BATCH_INTERVAL_MIN,
-	             std::min(SERVER_KNOBS->COMMIT_TRANSACTION_BATCH_INTERVAL_MAX,
-	                      target_latency * SERVER_KNOBS->COMMIT_TRANSACTION_BATCH_INTERVAL_SMOOTHER_ALPHA +
-	                          pProxyCommitData->commitBatchInterval *
-	                              (1 - SERVER_KNOBS->COMMIT_TRANSACTION_BATCH_INTERVAL_SMOOTHER_ALPHA)));
+	if (SERVER_KNOBS->COMMIT_BATCH_ADAPTIVE_ENABLED) {
+		updateAdaptiveCommitBatching(self);
+	} else {
+		double target_latency =
+		    (now() - self->startTime) * SERVER_KNOBS->COMMIT_TRANSACTION_BATCH_INTERVAL_LATENCY_FRACTION;
+		pProxyCommitData->commitBatchInterval =
+		    std::max(SERVER_KNOBS->COMMIT_TRANSACTION_BATCH_INTERVAL_MIN,
+		             std::min(SERVER_KNOBS->COMMIT_TRANSACTION_BATCH_INTERVAL_MAX,
+		                      target_latency * SERVER_KNOBS->COMMIT_TRANSACTION_BATCH_INTERVAL_SMOOTHER_ALPHA +
+		                          pProxyCommitData->commitBatchInterval *
+		                              (1 - SERVER_KNOBS->COMMIT_TRANSACTION_BATCH_INTERVAL_SMOOTHER_ALPHA)));
+	}
 	pProxyCommitData->stats.commitBatchingWindowSize.addMeasurement(pProxyCommitData->commitBatchInterval);
+	pProxyCommitData->stats.commitBatchingDesiredBytes.addMeasurement(pProxyCommitData->commitBatchDesiredBytes);
 	pProxyCommitData->commitBatchesMemBytesCount -= self->currentBatchMemBytesCount;
 	ASSERT_ABORT(pProxyCommitData->commitBatchesMemBytesCount >= 0);
 	wait(self->releaseFuture);
-	pProxyCommitData->stats.replyCommitDist->sampleSeconds(g_network->timer_monotonic() - replyStart);
+	double replyCommitLatency = g_network->timer_monotonic() - replyStart;
+	pProxyCommitData->stats.replyCommitDist->sampleSeconds(replyCommitLatency);
+	pProxyCommitData->stats.replyCommitSample.addMeasurement(replyCommitLatency);
 	return Void();
 }
 
@@ -2707,10 +2789,7 @@ ACTOR static Future<Void> idempotencyIdsExpireServer(
 		}
 		if (status->initialized) {
 			if (status->receivedCount == status->expectedCount) {
-				auto keyRange =
-				    makeIdempotencySingleKeyRange(idempotencyClears->arena(), key.version, key.highOrderBatchIndex);
-				idempotencyClears->push_back(idempotencyClears->arena(),
-				                             MutationRef(MutationRef::ClearRange, keyRange.begin, keyRange.end));
+				addIdempotencyClear(*idempotencyClears, key.version, key.highOrderBatchIndex);
 				idStatus.erase(key);
 			}
 		} else {
@@ -3087,8 +3166,9 @@ ACTOR Future<Void> commitProxyServerCore(CommitProxyInterface proxy,
 	                                               pow(commitData.db->get().client.commitProxies.size(),
 	                                                   SERVER_KNOBS->COMMIT_TRANSACTION_BATCH_BYTES_SCALE_POWER)));
 
-	commitBatcherActor = commitBatcher(
-	    &commitData, batchedCommits, proxy.commit.getFuture(), commitBatchByteLimit, commitBatchesMemoryLimit);
+	commitData.commitBatchDesiredBytes = commitBatchByteLimit;
+	commitBatcherActor =
+	    commitBatcher(&commitData, batchedCommits, proxy.commit.getFuture(), commitBatchesMemoryLimit);
 
 	// This has to be declared after the commitData.txnStateStore get initialized
 	state TransactionStateResolveContext transactionStateResolveContext(&commitData, &addActor);
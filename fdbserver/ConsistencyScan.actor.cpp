@@ -60,6 +60,7 @@ struct ConsistencyScanStats {
 	Counter inconsistencies;
 	Counter databasePollSuccesses;
 	Counter databasePollErrors;
+	Counter busyBackoffs;
 
 	bool waitingBetweenRounds = false;
 	int targetRate = 0;
@@ -68,7 +69,8 @@ struct ConsistencyScanStats {
 	  : cc("ConsistencyScanStats", id.toString()), logicalBytesScanned("LogicalBytesScanned", cc),
 	    replicatedBytesRead("ReplicatedBytesRead", cc), requests("Requests", cc), failedRequests("FailedRequests", cc),
 	    scanLoops("ScanLoops", cc), inconsistencies("Inconsistencies", cc),
-	    databasePollSuccesses("DatabasePollSuccesses", cc), databasePollErrors("DatabasePollErrors", cc) {
+	    databasePollSuccesses("DatabasePollSuccesses", cc), databasePollErrors("DatabasePollErrors", cc),
+	    busyBackoffs("BusyBackoffs", cc) {
 		specialCounter(cc, "WaitingBetweenRounds", [this]() { return this->waitingBetweenRounds; });
 		specialCounter(cc, "TargetRate", [this]() { return this->targetRate; });
 		logger = cc.traceCounters("ConsistencyScanMetrics", id, interval, "ConsistencyScanMetrics");
@@ -867,6 +869,7 @@ ACTOR Future<Void> consistencyScanCore(Database db,
 							state Optional<int> firstValidServer;
 							memState->stats.requests += storageServerInterfaces.size();
 							state int64_t replicatedBytesReadThisLoop = 0;
+							state double readStart = now();
 							int newErrors = wait(consistencyCheckReadData(memState->csId,
 							                                              db,
 							                                              targetRange,
@@ -878,6 +881,7 @@ ACTOR Future<Void> consistencyScanCore(Database db,
 							                                              statsCurrentRound.startVersion));
 							errors += newErrors;
 							memState->stats.inconsistencies += newErrors;
+							state double readLatency = now() - readStart;
 
 							// If any shard experienced an error, retry this key range
 							for (int i = 0; i < storageServerInterfaces.size(); i++) {
@@ -964,6 +968,15 @@ ACTOR Future<Void> consistencyScanCore(Database db,
 							int sleepBytes = (int)(totalReadBytesFromStorageServers * ratio);
 							totalReadBytesFromStorageServers -= sleepBytes;
 							wait(readRateControl->getAllowance(sleepBytes));
+
+							// The configured rate does not know how busy the replicas are. Slow replies mean their
+							// disks are busy serving other work, so leave them idle for as long as this read took.
+							if (SERVER_KNOBS->CONSISTENCY_SCAN_BUSY_READ_LATENCY > 0 &&
+							    readLatency > SERVER_KNOBS->CONSISTENCY_SCAN_BUSY_READ_LATENCY) {
+								CODE_PROBE(true, "Consistency Scan backing off from busy storage servers");
+								++memState->stats.busyBackoffs;
+								wait(delay(readLatency));
+							}
 						}
 
 						statsCurrentRound.errorCount += errors;
@@ -480,8 +480,11 @@ int getSrcWorkFactor(RelocateData const& relocation, int singleRegionTeamSize) {
 	}
 }
 
-int getDestWorkFactor() {
-	// Work of moving a shard is even across destination servers
+int getDestWorkFactor(int priority) {
+	// Work of moving a shard is even across destination servers. Restoring replicas of a team which has lost all but
+	// one of them is allowed to use more of a destination, so that the cluster becomes fault tolerant sooner.
+	if (priority == SERVER_KNOBS->PRIORITY_TEAM_1_LEFT || priority == SERVER_KNOBS->PRIORITY_TEAM_0_LEFT)
+		return WORK_FULL_UTILIZATION / SERVER_KNOBS->HEALING_RELOCATION_PARALLELISM_PER_DEST_SERVER;
 	return WORK_FULL_UTILIZATION / SERVER_KNOBS->RELOCATION_PARALLELISM_PER_DEST_SERVER;
 }
 
@@ -539,7 +542,7 @@ bool canLaunchDest(const std::vector<std::pair<Reference<IDataDistributionTeam>,
 	if (SERVER_KNOBS->RELOCATION_PARALLELISM_PER_DEST_SERVER <= 0) {
 		return true;
 	}
-	int workFactor = getDestWorkFactor();
+	int workFactor = getDestWorkFactor(priority);
 	for (auto& [team, _] : candidateTeams) {
 		for (UID id : team->getServerIDs()) {
 			if (!busymapDest[id].canLaunch(priority, workFactor)) {
@@ -562,7 +565,7 @@ void launchDest(RelocateData& relocation,
                 const std::vector<std::pair<Reference<IDataDistributionTeam>, bool>>& candidateTeams,
                 std::map<UID, Busyness>& destBusymap) {
 	ASSERT(relocation.completeDests.empty());
-	int destWorkFactor = getDestWorkFactor();
+	int destWorkFactor = getDestWorkFactor(relocation.priority);
 	for (auto& [team, _] : candidateTeams) {
 		for (UID id : team->getServerIDs()) {
 			relocation.completeDests.push_back(id);
@@ -571,7 +574,7 @@ void launchDest(RelocateData& relocation,
 	}
 }
 void completeDest(RelocateData const& relocation, std::map<UID, Busyness>& destBusymap) {
-	int destWorkFactor = getDestWorkFactor();
+	int destWorkFactor = getDestWorkFactor(relocation.priority);
 	for (UID id : relocation.completeDests) {
 		destBusymap[id].removeWork(relocation.priority, destWorkFactor);
 	}
@@ -1028,11 +1031,16 @@ void DDQueue::launchQueuedWork(RelocateData launchData, const DDEnabledState* dd
 	launchQueuedWork(combined, ddEnabledState);
 }
 
-DataMoveType newDataMoveType(bool doBulkLoading) {
+DataMoveType newDataMoveType(bool doBulkLoading, DataMovementReason reason) {
 	DataMoveType type = DataMoveType::LOGICAL;
 	if (deterministicRandom()->random01() < SERVER_KNOBS->DD_PHYSICAL_SHARD_MOVE_PROBABILITY) {
 		type = DataMoveType::PHYSICAL;
 	}
+	// A wiggle moves every shard off a storage server, so copying whole shards from a checkpoint rather than reading
+	// them through fetchKeys shortens it the most
+	if (SERVER_KNOBS->DD_PHYSICAL_SHARD_MOVE_FOR_WIGGLE && reason == DataMovementReason::PERPETUAL_STORAGE_WIGGLE) {
+		type = DataMoveType::PHYSICAL;
+	}
 	if (type != DataMoveType::PHYSICAL && SERVER_KNOBS->ENABLE_PHYSICAL_SHARD_MOVE_EXPERIMENT) {
 		type = DataMoveType::PHYSICAL_EXP;
 	}
@@ -1225,7 +1233,7 @@ void DDQueue::launchQueuedWork(std::set<RelocateData, std::greater<RelocateData>
 						// For details, see the comment in dataDistributionRelocator.
 						rrs.dataMoveId = UID();
 					} else {
-						DataMoveType dataMoveType = newDataMoveType(rrs.bulkLoadTask.present());
+						DataMoveType dataMoveType = newDataMoveType(rrs.bulkLoadTask.present(), rrs.dmReason);
 						rrs.dataMoveId = newDataMoveId(
 						    deterministicRandom()->randomUInt64(), AssignEmptyRange::False, dataMoveType, rrs.dmReason);
 						TraceEvent(SevInfo, "NewDataMoveWithRandomDestID", this->distributorId)
@@ -1434,7 +1442,9 @@ void traceRelocateDecision(TraceEvent& ev, const UID& pairId, const RelocateDeci
 		// tell if the splitter acted as expected for write bandwidth splitting
 		// SOMEDAY: trace the source team write bytes if necessary
 		ev.detail("ShardWriteBytes", decision.metrics.bytesWrittenPerKSecond)
-		    .detail("ParentShardWriteBytes", decision.parentMetrics.get().bytesWrittenPerKSecond);
+		    .detail("ParentShardWriteBytes", decision.parentMetrics.get().bytesWrittenPerKSecond)
+		    .detail("ShardWriteOps", decision.metrics.iosPerKSecond)
+		    .detail("ParentShardWriteOps", decision.parentMetrics.get().iosPerKSecond);
 	} else if (decision.rd.reason == RelocateReason::SIZE_SPLIT) {
 		ev.detail("ShardSize", decision.metrics.bytes).detail("ParentShardSize", decision.parentMetrics.get().bytes);
 	}
@@ -1606,7 +1616,7 @@ ACTOR Future<Void> dataDistributionRelocator(DDQueue* self,
 						wait(tr.onError(e));
 					}
 				}
-				DataMoveType dataMoveType = newDataMoveType(doBulkLoading);
+				DataMoveType dataMoveType = newDataMoveType(doBulkLoading, rd.dmReason);
 				rd.dataMoveId = newDataMoveId(
 				    deterministicRandom()->randomUInt64(), AssignEmptyRange::False, dataMoveType, rd.dmReason);
 				TraceEvent(bulkLoadVerboseEventSev(), "DDBulkLoadTaskNewDataMoveID", self->distributorId)
@@ -2011,8 +2021,10 @@ ACTOR Future<Void> dataDistributionRelocator(DDQueue* self,
 					} else {
 						self->moveCreateNewPhysicalShard++;
 					}
-					rd.dataMoveId = newDataMoveId(
-					    physicalShardIDCandidate, AssignEmptyRange::False, newDataMoveType(doBulkLoading), rd.dmReason);
+					rd.dataMoveId = newDataMoveId(physicalShardIDCandidate,
+					                              AssignEmptyRange::False,
+					                              newDataMoveType(doBulkLoading, rd.dmReason),
+					                              rd.dmReason);
 					TraceEvent(SevInfo, "NewDataMoveWithPhysicalShard")
 					    .detail("DataMoveID", rd.dataMoveId.toString())
 					    .detail("Reason", rd.reason.toString())
@@ -38,6 +38,9 @@ enum BandwidthStatus { BandwidthStatusLow, BandwidthStatusNormal, BandwidthStatu
 
 enum ReadBandwidthStatus { ReadBandwidthStatusNormal, ReadBandwidthStatusHigh };
 
+// Whether a shard takes so many writes that it should be split, however small they are
+enum WriteOpsStatus { WriteOpsStatusNormal, WriteOpsStatusHigh };
+
 BandwidthStatus getBandwidthStatus(StorageMetrics const& metrics) {
 	if (metrics.bytesWrittenPerKSecond > SERVER_KNOBS->SHARD_MAX_BYTES_PER_KSEC)
 		return BandwidthStatusHigh;
@@ -57,6 +60,14 @@ ReadBandwidthStatus getReadBandwidthStatus(StorageMetrics const& metrics) {
 	}
 }
 
+WriteOpsStatus getWriteOpsStatus(StorageMetrics const& metrics) {
+	if (SERVER_KNOBS->ENABLE_WRITE_BASED_SHARD_SPLIT &&
+	    metrics.iosPerKSecond > SERVER_KNOBS->SHARD_MAX_WRITE_OPS_PER_KSEC) {
+		return WriteOpsStatusHigh;
+	}
+	return WriteOpsStatusNormal;
+}
+
 ACTOR Future<Void> updateMaxShardSize(Reference<AsyncVar<int64_t>> dbSizeEstimate,
                                       Reference<AsyncVar<Optional<int64_t>>> maxShardSize) {
 	state int64_t lastDbSize = 0;
@@ -205,6 +216,19 @@ std::pair<ShardSizeBounds, bool> calculateShardSizeBounds(
 		bounds.min.opsReadPerKSecond =
 		    std::max((int64_t)0, currentReadOps - SERVER_KNOBS->SHARD_READ_OPS_CHANGE_THRESHOLD);
 		bounds.permittedError.opsReadPerKSecond = currentReadOps * 0.25;
+
+		// 5. write ops bound
+		if (SERVER_KNOBS->ENABLE_WRITE_BASED_SHARD_SPLIT) {
+			if (getWriteOpsStatus(shardMetrics->get().get().metrics) == WriteOpsStatusNormal) {
+				bounds.max.iosPerKSecond = SERVER_KNOBS->SHARD_MAX_WRITE_OPS_PER_KSEC;
+				bounds.min.iosPerKSecond = 0;
+				bounds.permittedError.iosPerKSecond = bounds.max.iosPerKSecond / 4;
+			} else {
+				bounds.max.iosPerKSecond = bounds.max.infinity;
+				bounds.min.iosPerKSecond = SERVER_KNOBS->SHARD_MAX_WRITE_OPS_PER_KSEC;
+				bounds.permittedError.iosPerKSecond = bounds.min.iosPerKSecond / 4;
+			}
+		}
 	}
 	return { bounds, readHotShard };
 }
@@ -586,7 +610,10 @@ ACTOR Future<Void> shardSplitter(DataDistributionTracker* self,
 	splitMetrics.bytes = shardBounds.max.bytes / 2;
 	splitMetrics.bytesWrittenPerKSecond =
 	    keys.begin >= keyServersKeys.begin ? splitMetrics.infinity : SERVER_KNOBS->SHARD_SPLIT_BYTES_PER_KSEC;
-	splitMetrics.iosPerKSecond = splitMetrics.infinity;
+	// Many small writes to a few keys, such as appends at a sequential key, are split off at the keys taking them
+	splitMetrics.iosPerKSecond = keys.begin >= keyServersKeys.begin || !SERVER_KNOBS->ENABLE_WRITE_BASED_SHARD_SPLIT
+	                                 ? splitMetrics.infinity
+	                                 : SERVER_KNOBS->SHARD_SPLIT_WRITE_OPS_PER_KSEC;
 	splitMetrics.bytesReadPerKSecond = splitMetrics.infinity; // Don't split by readBandwidthSec
 
 	state Standalone<VectorRef<KeyRef>> splitKeys =
@@ -608,6 +635,7 @@ ACTOR Future<Void> shardSplitter(DataDistributionTracker* self,
 	            : bandwidthStatus == BandwidthStatusNormal ? "Normal"
 	                                                       : "Low")
 	    .detail("BytesWrittenPerKSec", metrics.bytesWrittenPerKSecond)
+	    .detail("WriteOpsPerKSec", metrics.iosPerKSecond)
 	    .detail("NumShards", numShards);
 
 	if (numShards > 1) {
@@ -941,7 +969,8 @@ ACTOR Future<Void> shardEvaluator(DataDistributionTracker* self,
 	auto bandwidthStatus = getBandwidthStatus(stats);
 
 	bool sizeSplit = stats.bytes > shardBounds.max.bytes,
-	     writeSplit = bandwidthStatus == BandwidthStatusHigh && keys.begin < keyServersKeys.begin;
+	     writeSplit = (bandwidthStatus == BandwidthStatusHigh || getWriteOpsStatus(stats) == WriteOpsStatusHigh) &&
+	                  keys.begin < keyServersKeys.begin;
 	bool shouldSplit = sizeSplit || writeSplit;
 
 	auto prevIter = self->shards->rangeContaining(keys.begin);
@@ -953,6 +982,7 @@ ACTOR Future<Void> shardEvaluator(DataDistributionTracker* self,
 		++nextIter;
 
 	bool shouldMerge = stats.bytes < shardBounds.min.bytes && bandwidthStatus == BandwidthStatusLow &&
+	                   getWriteOpsStatus(stats) == WriteOpsStatusNormal &&
 	                   (shardForwardMergeFeasible(self, keys, nextIter.range()) ||
 	                    shardBackwardMergeFeasible(self, keys, prevIter.range()));
 
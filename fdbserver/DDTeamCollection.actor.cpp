@@ -362,6 +362,7 @@ public:
 	                                                              bool preferWithinShardLimit,
 	                                                              int& numSkippedSSFailedGetQueueLength,
 	                                                              int& numSkippedSSQueueTooLong,
+	                                                              int& numSkippedSSOverloaded,
 	                                                              Optional<int64_t> storageQueueThreshold) {
 		ASSERT(!req.storageQueueAware || storageQueueThreshold.present());
 		auto& startIndex = req.preferLowerDiskUtil ? self->lowestUtilizationTeam : self->highestUtilizationTeam;
@@ -390,6 +391,9 @@ public:
 					} else if (storageQueueSize.get() > storageQueueThreshold.get()) {
 						numSkippedSSQueueTooLong++;
 						continue; // this team has a SS with a too long storage queue, skip
+					} else if (self->teams[currentIndex]->hasOverloadedServer()) {
+						numSkippedSSOverloaded++;
+						continue; // this team has a SS with a busy disk or a long durability lag, skip
 					}
 				}
 
@@ -507,6 +511,7 @@ public:
 			Optional<Reference<IDataDistributionTeam>> bestOption;
 			state int numSkippedSSFailedGetQueueLength = 0;
 			state int numSkippedSSQueueTooLong = 0;
+			state int numSkippedSSOverloaded = 0;
 
 			if (ddLargeTeamEnabled() && req.keys.present()) {
 				int customReplicas = self->configuration.storageTeamSize;
@@ -575,6 +580,7 @@ public:
 					                         /*preferWithinShardLimit=*/true,
 					                         numSkippedSSFailedGetQueueLength,
 					                         numSkippedSSQueueTooLong,
+					                         numSkippedSSOverloaded,
 					                         storageQueueThreshold);
 					if (!bestOption.present()) {
 						// In case, we may return a team whose shard count is more than DESIRED_MAX_SHARDS_PER_TEAM.
@@ -587,6 +593,7 @@ public:
 					                         /*preferWithinShardLimit=*/false,
 					                         numSkippedSSFailedGetQueueLength,
 					                         numSkippedSSQueueTooLong,
+					                         numSkippedSSOverloaded,
 					                         storageQueueThreshold);
 				}
 			} else {
@@ -625,6 +632,9 @@ public:
 						} else if (storageQueueSize.get() > storageQueueThreshold.get()) {
 							numSkippedSSQueueTooLong++;
 							ok = false; // this team has a SS with a too long storage queue, skip
+						} else if (dest->hasOverloadedServer()) {
+							numSkippedSSOverloaded++;
+							ok = false; // this team has a SS with a busy disk or a long durability lag, skip
 						}
 					}
 
@@ -685,7 +695,8 @@ public:
 				    .detail("PivotDiskSpace", self->teamPivots.pivotAvailableSpaceRatio)
 				    .detail("StorageQueueAware", req.storageQueueAware)
 				    .detail("NumSkippedSSFailedGetQueueLength", numSkippedSSFailedGetQueueLength)
-				    .detail("NumSkippedSSQueueTooLong", numSkippedSSQueueTooLong);
+				    .detail("NumSkippedSSQueueTooLong", numSkippedSSQueueTooLong)
+				    .detail("NumSkippedSSOverloaded", numSkippedSSOverloaded);
 				// self->traceAllInfo(true);
 			}
 
@@ -5088,6 +5099,37 @@ void DDTeamCollection::rebuildMachineLocalityMap() {
 	}
 }
 
+std::vector<Reference<TCMachineInfo>> DDTeamCollection::getLeastUsedMachines() const {
+	std::vector<Reference<TCMachineInfo>> leastUsedMachines; // A less used machine has less number of teams
+	int minTeamCount = std::numeric_limits<int>::max();
+	for (auto& [_, machine] : machine_info) {
+		// Skip invalid machine whose representative server is not in server_info
+		ASSERT_WE_THINK(server_info.find(machine->serversOnMachine[0]->getId()) != server_info.end());
+		// Skip unhealthy machines
+		if (!isMachineHealthy(machine))
+			continue;
+		// Skip machine with incomplete locality
+		if (!isValidLocality(configuration.storagePolicy,
+		                     machine->serversOnMachine[0]->getLastKnownInterface().locality)) {
+			continue;
+		}
+
+		// Invariant: We only create correct size machine teams.
+		// When configuration (e.g., team size) is changed, the DDTeamCollection will be destroyed and rebuilt
+		// so that the invariant will not be violated.
+		int teamCount = machine->machineTeams.size();
+
+		if (teamCount < minTeamCount) {
+			leastUsedMachines.clear();
+			minTeamCount = teamCount;
+		}
+		if (teamCount == minTeamCount) {
+			leastUsedMachines.push_back(machine);
+		}
+	}
+	return leastUsedMachines;
+}
+
 int DDTeamCollection::addBestMachineTeams(int machineTeamsToBuild) {
 	int addedMachineTeams = 0;
 
@@ -5100,35 +5142,16 @@ int DDTeamCollection::addBestMachineTeams(int machineTeamsToBuild) {
 	// Step 1: Create machineLocalityMap which will be used in building machine team
 	rebuildMachineLocalityMap();
 
+	// The least used machines only change when a machine team is added on them, so instead of scanning every machine
+	// for each machine team they are found once, and the members of each added machine team are dropped until none
+	// are left.
+	std::vector<Reference<TCMachineInfo>> leastUsedMachines;
+
 	// Add a team in each iteration
 	while (addedMachineTeams < machineTeamsToBuild || notEnoughMachineTeamsForAMachine()) {
 		// Step 2: Get least used machines from which we choose machines as a machine team
-		std::vector<Reference<TCMachineInfo>> leastUsedMachines; // A less used machine has less number of teams
-		int minTeamCount = std::numeric_limits<int>::max();
-		for (auto& machine : machine_info) {
-			// Skip invalid machine whose representative server is not in server_info
-			ASSERT_WE_THINK(server_info.find(machine.second->serversOnMachine[0]->getId()) != server_info.end());
-			// Skip unhealthy machines
-			if (!isMachineHealthy(machine.second))
-				continue;
-			// Skip machine with incomplete locality
-			if (!isValidLocality(configuration.storagePolicy,
-			                     machine.second->serversOnMachine[0]->getLastKnownInterface().locality)) {
-				continue;
-			}
-
-			// Invariant: We only create correct size machine teams.
-			// When configuration (e.g., team size) is changed, the DDTeamCollection will be destroyed and rebuilt
-			// so that the invariant will not be violated.
-			int teamCount = machine.second->machineTeams.size();
-
-			if (teamCount < minTeamCount) {
-				leastUsedMachines.clear();
-				minTeamCount = teamCount;
-			}
-			if (teamCount == minTeamCount) {
-				leastUsedMachines.push_back(machine.second);
-			}
+		if (leastUsedMachines.empty()) {
+			leastUsedMachines = getLeastUsedMachines();
 		}
 
 		std::vector<UID*> team;
@@ -5218,8 +5241,16 @@ int DDTeamCollection::addBestMachineTeams(int machineTeamsToBuild) {
 				machines.push_back(machine);
 			}
 
+			size_t minTeamCount = leastUsedMachines.front()->machineTeams.size();
 			addMachineTeam(machines);
 			addedMachineTeams++;
+
+			leastUsedMachines.erase(std::remove_if(leastUsedMachines.begin(),
+			                                       leastUsedMachines.end(),
+			                                       [minTeamCount](const auto& machine) {
+				                                       return machine->machineTeams.size() > minTeamCount;
+			                                       }),
+			                        leastUsedMachines.end());
 		} else {
 			// When too many teams exist in simulation, traceAllInfo will buffer too many trace logs before
 			// trace has a chance to flush its buffer, which causes assertion failure.
@@ -5236,7 +5267,7 @@ int DDTeamCollection::addBestMachineTeams(int machineTeamsToBuild) {
 	return addedMachineTeams;
 }
 
-Reference<TCServerInfo> DDTeamCollection::findOneLeastUsedServer() const {
+std::vector<Reference<TCServerInfo>> DDTeamCollection::getLeastUsedServers() const {
 	std::vector<Reference<TCServerInfo>> leastUsedServers;
 	int minTeams = std::numeric_limits<int>::max();
 	for (auto& [serverID, server] : server_info) {
@@ -5255,7 +5286,15 @@ Reference<TCServerInfo> DDTeamCollection::findOneLeastUsedServer() const {
 			leastUsedServers.push_back(server);
 		}
 	}
+	return leastUsedServers;
+}
+
+Reference<TCServerInfo> DDTeamCollection::findOneLeastUsedServer() const {
+	return chooseLeastUsedServer(getLeastUsedServers());
+}
 
+Reference<TCServerInfo> DDTeamCollection::chooseLeastUsedServer(
+    std::vector<Reference<TCServerInfo>> const& leastUsedServers) const {
 	if (leastUsedServers.empty()) {
 		// If we cannot find a healthy server with valid locality
 		TraceEvent("NoHealthyAndValidLocalityServers")
@@ -5552,14 +5591,20 @@ int DDTeamCollection::addTeamsBestOf(int teamsToBuild, int desiredTeams, int max
 		}
 	}
 
+	// The least used servers only change when a team is added on them, so instead of scanning every server for each
+	// attempt they are found once, and the members of each added team are dropped until none are left.
+	std::vector<Reference<TCServerInfo>> leastUsedServers;
 	while (addedTeams < teamsToBuild || notEnoughTeamsForAServer()) {
+		if (leastUsedServers.empty()) {
+			leastUsedServers = getLeastUsedServers();
+		}
 		std::vector<UID> bestServerTeam;
 		int bestScore = std::numeric_limits<int>::max();
 		int maxAttempts = SERVER_KNOBS->BEST_OF_AMT; // BEST_OF_AMT = 4
 		bool earlyQuitBuild = false;
 		for (int i = 0; i < maxAttempts && i < 100; ++i) {
 			// Step 1: Choose 1 least used server and then choose 1 least used machine team from the server
-			Reference<TCServerInfo> chosenServer = findOneLeastUsedServer();
+			Reference<TCServerInfo> chosenServer = chooseLeastUsedServer(leastUsedServers);
 			if (!chosenServer.isValid()) {
 				TraceEvent(SevWarn, "NoValidServer").detail("Primary", primary);
 				earlyQuitBuild = true;
@@ -5645,8 +5690,15 @@ int DDTeamCollection::addTeamsBestOf(int teamsToBuild, int desiredTeams, int max
 		}
 
 		// Step 4: Add the server team
+		size_t minTeams = leastUsedServers.front()->getTeams().size();
 		addTeam(bestServerTeam.begin(), bestServerTeam.end(), IsInitialTeam::False);
 		addedTeams++;
+
+		leastUsedServers.erase(
+		    std::remove_if(leastUsedServers.begin(),
+		                   leastUsedServers.end(),
+		                   [minTeams](const auto& server) { return server->getTeams().size() > minTeams; }),
+		    leastUsedServers.end());
 	}
 
 	healthyMachineTeamCount = getHealthyMachineTeamCount();
@@ -6338,6 +6390,31 @@ public:
 		return Void();
 	}
 
+	// Records how the time to build all teams from scratch grows with the number of storage processes
+	static void AddTeamsBestOf_Scalability() {
+		int teamSize = 3; // replication size
+		Reference<IReplicationPolicy> policy =
+		    makeReference<PolicyAcross>(teamSize, "zoneid", makeReference<PolicyOne>());
+
+		for (int processSize = 60; processSize <= 960; processSize *= 2) {
+			int desiredTeams = SERVER_KNOBS->DESIRED_TEAMS_PER_SERVER * processSize;
+			int maxTeams = SERVER_KNOBS->MAX_TEAMS_PER_SERVER * processSize;
+			std::unique_ptr<DDTeamCollection> collection = testMachineTeamCollection(teamSize, policy, processSize);
+
+			double start = timer_monotonic();
+			int addedTeams = collection->addTeamsBestOf(desiredTeams, desiredTeams, maxTeams);
+			double elapsed = timer_monotonic() - start;
+
+			TraceEvent("AddTeamsBestOfScalability")
+			    .detail("Processes", processSize)
+			    .detail("MachineTeams", collection->machineTeams.size())
+			    .detail("ServerTeams", addedTeams)
+			    .detail("Elapsed", elapsed);
+			ASSERT_GT(addedTeams, 0);
+			ASSERT(collection->sanityCheckTeams());
+		}
+	}
+
 	static void AddAllTeams_isExhaustive() {
 		Reference<IReplicationPolicy> policy = makeReference<PolicyAcross>(3, "zoneid", makeReference<PolicyOne>());
 		int processSize = 10;
@@ -6970,6 +7047,44 @@ public:
 		return Void();
 	}
 
+	// Skip teams with a server that is far behind in making its writes durable
+	ACTOR static Future<Void> GetTeam_SkipOverloadedServer() {
+		Reference<IReplicationPolicy> policy = makeReference<PolicyAcross>(1, "zoneid", makeReference<PolicyOne>());
+		state int processSize = 2;
+		state int teamSize = 1;
+		state std::unique_ptr<DDTeamCollection> collection = testTeamCollection(teamSize, policy, processSize);
+		state GetTeamRequest req(TeamSelect::WANT_TRUE_BEST,
+		                         PreferLowerDiskUtil::False,
+		                         TeamMustHaveShards::False,
+		                         PreferLowerReadUtil::False,
+		                         PreferWithinShardLimit::False);
+		req.storageQueueAware = true;
+
+		GetStorageMetricsReply metrics;
+		metrics.capacity.bytes = SERVER_KNOBS->MIN_AVAILABLE_SPACE * 20;
+		metrics.available.bytes = SERVER_KNOBS->MIN_AVAILABLE_SPACE * 5;
+		metrics.load.bytes = 90 * 1024 * 1024;
+
+		HealthMetrics::StorageStats keepingUp, lagging;
+		lagging.storageDurabilityLag = SERVER_KNOBS->MAX_DEST_DURABILITY_LAG_VERSIONS + 1;
+
+		collection->addTeam(std::set<UID>({ UID(1, 0) }), IsInitialTeam::True);
+		collection->server_info[UID(1, 0)]->setMetrics(metrics);
+		collection->server_info[UID(1, 0)]->setStorageStats(keepingUp);
+		collection->addTeam(std::set<UID>({ UID(2, 0) }), IsInitialTeam::True);
+		collection->server_info[UID(2, 0)]->setMetrics(metrics);
+		collection->server_info[UID(2, 0)]->setStorageStats(lagging);
+
+		collection->disableBuildingTeams();
+		collection->setCheckTeamDelay();
+
+		wait(collection->getTeam(req));
+		const auto [resTeam, srcFound] = req.reply.getFuture().get();
+		ASSERT(resTeam.present());
+		ASSERT_EQ(resTeam.get()->getServerIDs(), std::vector<UID>{ UID(1, 0) });
+		return Void();
+	}
+
 	ACTOR static Future<Void> GetTeam_PreferShardsWithinLimit() {
 		ASSERT(SERVER_KNOBS->ENFORCE_SHARD_COUNT_PER_TEAM);
 		Reference<IReplicationPolicy> policy = makeReference<PolicyAcross>(3, "zoneid", makeReference<PolicyOne>());
@@ -7030,6 +7145,11 @@ TEST_CASE("DataDistribution/AddTeamsBestOf/NotUseMachineID") {
 	return Void();
 }
 
+TEST_CASE("noSim/DataDistribution/AddTeamsBestOf/Scalability") {
+	DDTeamCollectionUnitTest::AddTeamsBestOf_Scalability();
+	return Void();
+}
+
 TEST_CASE("DataDistribution/AddAllTeams/isExhaustive") {
 	DDTeamCollectionUnitTest::AddAllTeams_isExhaustive();
 	return Void();
@@ -7169,6 +7289,11 @@ TEST_CASE("/DataDistribution/GetTeam/CutOffByCpu") {
 	return Void();
 }
 
+TEST_CASE("/DataDistribution/GetTeam/SkipOverloadedServer") {
+	wait(DDTeamCollectionUnitTest::GetTeam_SkipOverloadedServer());
+	return Void();
+}
+
 TEST_CASE("/DataDistribution/GetTeam/PreferWithinShardRange") {
 	if (!SERVER_KNOBS->ENFORCE_SHARD_COUNT_PER_TEAM) {
 		return Void();
@@ -104,6 +104,32 @@ struct StringBuffer {
 	}
 };
 
+// Groups the syncs of every disk queue file in the process, such as those of several TLogs sharing a device, into
+// batches issued at the end of a DISK_QUEUE_SYNC_BATCH_WINDOW which begins at the first sync requested after the last
+// batch.
+class DiskQueueSyncBatcher {
+public:
+	static DiskQueueSyncBatcher* batcher() {
+		auto res = g_network->global(INetwork::enDiskQueueSyncBatcher);
+		if (!res) {
+			res = new DiskQueueSyncBatcher();
+			g_network->setGlobal(INetwork::enDiskQueueSyncBatcher, res);
+		}
+		return static_cast<DiskQueueSyncBatcher*>(res);
+	}
+
+	// Returns a future which is ready when the syncs requested now should be issued
+	Future<Void> nextBatch() {
+		if (!batch.isValid() || batch.isReady()) {
+			batch = delay(SERVER_KNOBS->DISK_QUEUE_SYNC_BATCH_WINDOW, TaskPriority::DiskWrite);
+		}
+		return batch;
+	}
+
+private:
+	Future<Void> batch;
+};
+
 struct SyncQueue : ReferenceCounted<SyncQueue> {
 	SyncQueue(int outstandingLimit, Reference<IAsyncFile> file) : outstandingLimit(outstandingLimit), file(file) {
 		for (int i = 0; i < outstandingLimit; i++)
@@ -124,6 +150,9 @@ private:
 	ACTOR static Future<Void> waitAndSync(SyncQueue* self) {
 		wait(self->outstanding.front());
 		self->outstanding.pop_front();
+		if (SERVER_KNOBS->DISK_QUEUE_SYNC_BATCH_WINDOW > 0) {
+			wait(DiskQueueSyncBatcher::batcher()->nextBatch());
+		}
 		wait(self->file->sync());
 		return Void();
 	}
@@ -49,6 +49,7 @@ struct GrvProxyStats {
 	Counter txnStartIn;
 	Counter txnStartOut;
 	Counter txnStartBatch;
+	Counter txnStartBatchFromCache;
 	Counter txnSystemPriorityStartIn;
 	Counter txnSystemPriorityStartOut;
 	Counter txnBatchPriorityStartIn;
@@ -138,6 +139,7 @@ struct GrvProxyStats {
 
 	    txnRequestIn("TxnRequestIn", cc), txnRequestOut("TxnRequestOut", cc), txnRequestErrors("TxnRequestErrors", cc),
 	    txnStartIn("TxnStartIn", cc), txnStartOut("TxnStartOut", cc), txnStartBatch("TxnStartBatch", cc),
+	    txnStartBatchFromCache("TxnStartBatchFromCache", cc),
 	    txnSystemPriorityStartIn("TxnSystemPriorityStartIn", cc),
 	    txnSystemPriorityStartOut("TxnSystemPriorityStartOut", cc),
 	    txnBatchPriorityStartIn("TxnBatchPriorityStartIn", cc),
@@ -220,6 +222,12 @@ struct GrvProxyData {
 	Version version;
 	Version minKnownCommittedVersion; // we should ask master for this version.
 
+	// The last reply to getLiveCommittedVersion from the master, and when it was received. Its lock state and metadata
+	// version are those as of its version, so once it ages they may no longer be current.
+	Optional<GetRawCommittedVersionReply> lastMasterReply;
+	double lastMasterReplyTime;
+	Future<Void> lastMasterReplyRefresh;
+
 	GrvProxyTagThrottler tagThrottler;
 
 	// Cache of the latest commit versions of storage servers.
@@ -242,6 +250,15 @@ struct GrvProxyData {
 		latencyBandConfig = newLatencyBandConfig;
 	}
 
+	void updateLastMasterReply(GetRawCommittedVersionReply const& reply) {
+		if (!lastMasterReply.present() || lastMasterReply.get().version <= reply.version) {
+			lastMasterReply = reply;
+			lastMasterReplyTime = now();
+		}
+		version = std::max(version, reply.version);
+		minKnownCommittedVersion = std::max(minKnownCommittedVersion, reply.minKnownCommittedVersion);
+	}
+
 	GrvProxyData(UID dbgid,
 	             MasterInterface master,
 	             PublicRequestStream<GetReadVersionRequest> getConsistentReadVersion,
@@ -249,7 +266,7 @@ struct GrvProxyData {
 	  : dbgid(dbgid), stats(dbgid), master(master), getConsistentReadVersion(getConsistentReadVersion),
 	    cx(openDBOnServer(db, TaskPriority::DefaultEndpoint, LockAware::True)), db(db), lastStartCommit(0),
 	    lastCommitLatency(SERVER_KNOBS->REQUIRED_MIN_RECOVERY_DURATION), updateCommitRequests(0), lastCommitTime(0),
-	    version(0), minKnownCommittedVersion(invalidVersion),
+	    version(0), minKnownCommittedVersion(invalidVersion), lastMasterReplyTime(0),
 	    tagThrottler(CLIENT_KNOBS->PROXY_MAX_TAG_THROTTLE_DURATION) {
 		if (SERVER_KNOBS->ENABLE_VERSION_VECTOR) {
 			versionVectorSizeOnGRVReply =
@@ -508,6 +525,15 @@ void dropRequestFromQueue(Deque<GetReadVersionRequest>* queue, GrvProxyStats* st
 	queue->pop_front();
 }
 
+// Respond with an error to a GetReadVersion request which has been queued for too long.
+void proxyGRVQueueTimeExceeded(const GetReadVersionRequest* req, GrvProxyStats* stats) {
+	++stats->txnRequestErrors;
+	req->reply.sendError(grv_proxy_memory_limit_exceeded());
+	TraceEvent(g_network->isSimulated() ? SevInfo : SevWarnAlways, "ProxyGRVQueueTimeExceeded")
+	    .suppressFor(60)
+	    .detail("Priority", req->priority);
+}
+
 // Put a GetReadVersion request into the queue corresponding to its priority.
 ACTOR Future<Void> queueGetReadVersionRequests(Reference<AsyncVar<ServerDBInfo> const> db,
                                                Deque<GetReadVersionRequest>* systemQueue,
@@ -654,6 +680,16 @@ ACTOR Future<Void> lastCommitUpdater(GrvProxyData* self, PromiseStream<Future<Vo
 	}
 }
 
+// Asks the master for its live committed version in the background, so that the lock state and metadata version which
+// causal read risky batches are answered with from lastMasterReply keep up with the master
+ACTOR Future<Void> refreshLastMasterReply(GrvProxyData* self) {
+	GetRawCommittedVersionReply reply = wait(self->master.getLiveCommittedVersion.getReply(
+	    GetRawCommittedVersionRequest(SpanContext(), Optional<UID>(), self->ssVersionVectorCache.getMaxVersion()),
+	    TaskPriority::GetLiveCommittedVersionReply));
+	self->updateLastMasterReply(reply);
+	return Void();
+}
+
 ACTOR Future<GetReadVersionReply> getLiveCommittedVersion(std::vector<SpanContext> spanContexts,
                                                           GrvProxyData* grvProxyData,
                                                           uint32_t flags,
@@ -674,35 +710,53 @@ ACTOR Future<GetReadVersionReply> getLiveCommittedVersion(std::vector<SpanContex
 	++grvProxyData->stats.txnStartBatch;
 
 	state double grvStart = now();
+	state double grvConfirmEpochLive;
 	state Future<GetRawCommittedVersionReply> replyFromMasterFuture;
-	replyFromMasterFuture = grvProxyData->master.getLiveCommittedVersion.getReply(
-	    GetRawCommittedVersionRequest(span.context, debugID, grvProxyData->ssVersionVectorCache.getMaxVersion()),
-	    TaskPriority::GetLiveCommittedVersionReply);
-
-	if (!SERVER_KNOBS->ALWAYS_CAUSAL_READ_RISKY && !(flags & GetReadVersionRequest::FLAG_CAUSAL_READ_RISKY)) {
-		wait(transformError(updateLastCommit(grvProxyData, debugID), broken_promise(), tlog_failed()));
-	} else if (SERVER_KNOBS->REQUIRED_MIN_RECOVERY_DURATION > 0 &&
-	           now() - SERVER_KNOBS->REQUIRED_MIN_RECOVERY_DURATION > grvProxyData->lastCommitTime.get()) {
-		wait(grvProxyData->lastCommitTime.whenAtLeast(now() - SERVER_KNOBS->REQUIRED_MIN_RECOVERY_DURATION));
-	}
+	state GetRawCommittedVersionReply repFromMaster;
+	// Batches which accept the risk of a causal read violation may be answered with the last version from the
+	// master, if it was received recently enough, rather than asking the master again
+	if ((SERVER_KNOBS->ALWAYS_CAUSAL_READ_RISKY || (flags & GetReadVersionRequest::FLAG_CAUSAL_READ_RISKY)) &&
+	    !SERVER_KNOBS->ENABLE_VERSION_VECTOR && grvProxyData->lastMasterReply.present() &&
+	    grvStart - grvProxyData->lastMasterReplyTime < SERVER_KNOBS->GRV_PROXY_CAUSAL_READ_RISKY_CACHE_TIME &&
+	    (SERVER_KNOBS->REQUIRED_MIN_RECOVERY_DURATION <= 0 ||
+	     grvStart - SERVER_KNOBS->REQUIRED_MIN_RECOVERY_DURATION <= grvProxyData->lastCommitTime.get())) {
+		++grvProxyData->stats.txnStartBatchFromCache;
+		repFromMaster = grvProxyData->lastMasterReply.get();
+		// Refresh the reply well before it expires, so that a lock or metadata version change reaches the batches
+		// answered from it within about a master round trip rather than the whole cache time
+		if (grvStart - grvProxyData->lastMasterReplyTime >= SERVER_KNOBS->GRV_PROXY_CAUSAL_READ_RISKY_CACHE_TIME / 2 &&
+		    (!grvProxyData->lastMasterReplyRefresh.isValid() || grvProxyData->lastMasterReplyRefresh.isReady())) {
+			grvProxyData->lastMasterReplyRefresh = refreshLastMasterReply(grvProxyData);
+		}
+	} else {
+		replyFromMasterFuture = grvProxyData->master.getLiveCommittedVersion.getReply(
+		    GetRawCommittedVersionRequest(span.context, debugID, grvProxyData->ssVersionVectorCache.getMaxVersion()),
+		    TaskPriority::GetLiveCommittedVersionReply);
+
+		if (!SERVER_KNOBS->ALWAYS_CAUSAL_READ_RISKY && !(flags & GetReadVersionRequest::FLAG_CAUSAL_READ_RISKY)) {
+			wait(transformError(updateLastCommit(grvProxyData, debugID), broken_promise(), tlog_failed()));
+		} else if (SERVER_KNOBS->REQUIRED_MIN_RECOVERY_DURATION > 0 &&
+		           now() - SERVER_KNOBS->REQUIRED_MIN_RECOVERY_DURATION > grvProxyData->lastCommitTime.get()) {
+			wait(grvProxyData->lastCommitTime.whenAtLeast(now() - SERVER_KNOBS->REQUIRED_MIN_RECOVERY_DURATION));
+		}
 
-	state double grvConfirmEpochLive = now();
-	grvProxyData->stats.grvConfirmEpochLiveDist->sampleSeconds(grvConfirmEpochLive - grvStart);
-	if (debugID.present()) {
-		g_traceBatch.addEvent(
-		    "TransactionDebug", debugID.get().first(), "GrvProxyServer.getLiveCommittedVersion.confirmEpochLive");
-	}
+		grvConfirmEpochLive = now();
+		grvProxyData->stats.grvConfirmEpochLiveDist->sampleSeconds(grvConfirmEpochLive - grvStart);
+		if (debugID.present()) {
+			g_traceBatch.addEvent(
+			    "TransactionDebug", debugID.get().first(), "GrvProxyServer.getLiveCommittedVersion.confirmEpochLive");
+		}
 
-	GetRawCommittedVersionReply repFromMaster =
-	    wait(transformError(replyFromMasterFuture, broken_promise(), master_failed()));
-	grvProxyData->version = std::max(grvProxyData->version, repFromMaster.version);
-	grvProxyData->minKnownCommittedVersion =
-	    std::max(grvProxyData->minKnownCommittedVersion, repFromMaster.minKnownCommittedVersion);
-	if (SERVER_KNOBS->ENABLE_VERSION_VECTOR) {
-		// TODO add to "status json"
-		grvProxyData->ssVersionVectorCache.applyDelta(repFromMaster.ssVersionVectorDelta);
+		GetRawCommittedVersionReply reply =
+		    wait(transformError(replyFromMasterFuture, broken_promise(), master_failed()));
+		repFromMaster = reply;
+		grvProxyData->updateLastMasterReply(reply);
+		if (SERVER_KNOBS->ENABLE_VERSION_VECTOR) {
+			// TODO add to "status json"
+			grvProxyData->ssVersionVectorCache.applyDelta(repFromMaster.ssVersionVectorDelta);
+		}
+		grvProxyData->stats.grvGetCommittedVersionRpcDist->sampleSeconds(now() - grvConfirmEpochLive);
 	}
-	grvProxyData->stats.grvGetCommittedVersionRpcDist->sampleSeconds(now() - grvConfirmEpochLive);
 	GetReadVersionReply rep;
 	rep.version = repFromMaster.version;
 	rep.locked = repFromMaster.locked;
@@ -979,6 +1033,23 @@ ACTOR static Future<Void> transactionStarter(GrvProxyInterface proxy,
 			auto& req = transactionQueue->front();
 			int tc = req.transactionCount;
 
+			// A request which has already waited this long is likely to be retried or abandoned by the time it would
+			// be started, so shed it rather than let it hold up the requests behind it. Time spent throttled by its
+			// tags is not counted, as the tag throttler bounds that itself.
+			if (req.priority < TransactionPriority::IMMEDIATE && SERVER_KNOBS->START_TRANSACTION_MAX_QUEUE_TIME > 0 &&
+			    g_network->timer() - req.requestTime() - req.proxyTagThrottledDuration >
+			        SERVER_KNOBS->START_TRANSACTION_MAX_QUEUE_TIME) {
+				proxyGRVQueueTimeExceeded(&req, &grvProxyData->stats);
+				if (req.priority >= TransactionPriority::DEFAULT) {
+					--grvProxyData->stats.defaultGRVQueueSize;
+				} else {
+					--grvProxyData->stats.batchGRVQueueSize;
+				}
+				++grvProxyData->stats.txnRequestOut;
+				transactionQueue->pop_front();
+				continue;
+			}
+
 			if (req.priority < TransactionPriority::DEFAULT &&
 			    !batchRateInfo.canStart(transactionsStarted[0] + transactionsStarted[1], tc)) {
 				break;
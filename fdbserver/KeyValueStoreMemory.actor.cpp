@@ -34,6 +34,7 @@
 #include "flow/ActorCollection.h"
 #include "flow/EncryptUtils.h"
 #include "flow/Knobs.h"
+#include "flow/UnitTest.h"
 #include "flow/actorcompiler.h" // This must be the last #include.
 
 #define OP_DISK_OVERHEAD (sizeof(OpHeader) + 1)
@@ -417,26 +418,43 @@ private:
 		int64_t total = 0, count = 0;
 		IDiskQueue::location log_location = 0;
 
+		// With 'sequential', sets are gathered in dataSets and inserted as one batch. The batched insert requires
+		// strictly increasing keys, so a set which does not follow the last gathered key inserts the batch first; a
+		// later set of the same key then replaces the earlier one, as it would have without batching. A clear only
+		// needs the batch inserted first if it covers one of its keys, otherwise the two can be applied in either
+		// order. Snapshot items are each preceded by a clear of the gap before them, so without this check they would
+		// be inserted one by one.
+		auto insertSetsBeforeClear = [&](KeyRef begin, Optional<KeyRef> end) {
+			if (dataSets.empty() || dataSets.back().first.key < begin ||
+			    (end.present() && dataSets.front().first.key >= end.get())) {
+				return;
+			}
+			data.insert(dataSets);
+			dataSets.clear();
+		};
+
 		for (auto o = ops.begin(); o != ops.end(); ++o) {
 			++count;
 			total += o->p1.size() + o->p2.size() + OP_DISK_OVERHEAD;
 			if (o->op == OpSet) {
 				if (sequential) {
 					KeyValueMapPair pair(o->p1, o->p2);
+					if (!dataSets.empty() && pair.key <= dataSets.back().first.key) {
+						data.insert(dataSets);
+						dataSets.clear();
+					}
 					dataSets.emplace_back(pair, pair.arena.getSize() + data.getElementBytes());
 				} else {
 					data.insert(o->p1, o->p2);
 				}
 			} else if (o->op == OpClear) {
 				if (sequential) {
-					data.insert(dataSets);
-					dataSets.clear();
+					insertSetsBeforeClear(o->p1, o->p2);
 				}
 				data.erase(data.lower_bound(o->p1), data.lower_bound(o->p2));
 			} else if (o->op == OpClearToEnd) {
 				if (sequential) {
-					data.insert(dataSets);
-					dataSets.clear();
+					insertSetsBeforeClear(o->p1, Optional<KeyRef>());
 				}
 				data.erase(data.lower_bound(o->p1), data.end());
 			} else
@@ -734,7 +752,10 @@ private:
 						} else if (h.op == OpClearToEnd) { // clear all data from begin key to end
 							recoveryQueue.clear_to_end(p1, &data.arena());
 						} else if (h.op == OpCommit) { // commit previous transaction
-							self->commit_queue(recoveryQueue, false);
+							// Recovered snapshots are in key order, so their items can be inserted in batches. Sets
+							// from ordinary commits are in any order, which commit_queue handles by inserting the
+							// batch whenever keys stop increasing.
+							self->commit_queue(recoveryQueue, false, true);
 							++dbgCommitCount;
 							self->recoveredSnapshotKey = uncommittedNextKey;
 							self->previousSnapshotEnd = uncommittedPrevSnapshotEnd;
@@ -1120,3 +1141,37 @@ IKeyValueStore* keyValueStoreLogSystem(class IDiskQueue* queue,
 	                                                   exactRecovery,
 	                                                   enableEncryption);
 }
+
+TEST_CASE("noSim/fdbserver/KeyValueStoreMemory/RecoverUnsortedSets") {
+	state std::string basename = "kvsmemory-recover-unsorted-test-";
+	state IKeyValueStore* store = keyValueStoreMemory(basename, deterministicRandom()->randomUniqueID(), 100e6);
+	wait(store->init());
+
+	// One commit with keys out of order and a key set twice, as ordinary transactions write them
+	store->set(KeyValueRef("c"_sr, "c"_sr));
+	store->set(KeyValueRef("a"_sr, "a1"_sr));
+	store->set(KeyValueRef("d"_sr, "d"_sr));
+	store->set(KeyValueRef("b"_sr, "b"_sr));
+	store->set(KeyValueRef("a"_sr, "a2"_sr));
+	store->set(KeyValueRef("d"_sr, "d2"_sr));
+	store->clear(KeyRangeRef("c"_sr, "d"_sr));
+	wait(store->commit(false));
+
+	state Future<Void> closed = store->onClosed();
+	store->close();
+	wait(closed);
+
+	// Recovery replays the commit through the batched insert
+	store = keyValueStoreMemory(basename, deterministicRandom()->randomUniqueID(), 100e6);
+	wait(store->init());
+	RangeResult result = wait(store->readRange(KeyRangeRef(""_sr, "\xff"_sr)));
+	ASSERT_EQ(result.size(), 3);
+	ASSERT(result[0] == KeyValueRef("a"_sr, "a2"_sr));
+	ASSERT(result[1] == KeyValueRef("b"_sr, "b"_sr));
+	ASSERT(result[2] == KeyValueRef("d"_sr, "d2"_sr));
+
+	closed = store->onClosed();
+	store->dispose();
+	wait(closed);
+	return Void();
+}
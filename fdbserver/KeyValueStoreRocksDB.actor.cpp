@@ -289,6 +289,10 @@ rocksdb::DBOptions SharedRocksDBState::initialDbOptions() {
 		options.compaction_readahead_size = SERVER_KNOBS->ROCKSDB_COMPACTION_READAHEAD_SIZE;
 	}
 	options.wal_recovery_mode = getWalRecoveryMode();
+	// Pipelining lets the WAL write of one write group overlap the memtable insert of the previous group, and
+	// concurrent memtable writes let the writers of a group insert into the memtable in parallel.
+	options.enable_pipelined_write = SERVER_KNOBS->ROCKSDB_ENABLE_PIPELINED_WRITE;
+	options.allow_concurrent_memtable_write = SERVER_KNOBS->ROCKSDB_ALLOW_CONCURRENT_MEMTABLE_WRITE;
 	// The following two fields affect how archived logs will be deleted.
 	// 1. If both set to 0, logs will be deleted asap and will not get into
 	//    the archive.
@@ -331,6 +335,7 @@ rocksdb::ReadOptions SharedRocksDBState::initialReadOptions() {
 	rocksdb::ReadOptions options;
 	options.background_purge_on_iterator_cleanup = true;
 	options.auto_prefix_mode = (SERVER_KNOBS->ROCKSDB_PREFIX_LEN > 0);
+	options.async_io = SERVER_KNOBS->ROCKSDB_READ_ASYNC_IO;
 	return options;
 }
 
@@ -442,6 +447,7 @@ const StringRef ROCKSDB_READ_RANGE_BYTES_RETURNED_HISTOGRAM = "RocksDBReadRangeB
 const StringRef ROCKSDB_READ_RANGE_KV_PAIRS_RETURNED_HISTOGRAM = "RocksDBReadRangeKVPairsReturned"_sr;
 const StringRef ROCKSDB_DELETES_PER_COMMIT_HISTOGRAM = "RocksDBDeletesPerCommit"_sr;
 const StringRef ROCKSDB_DELETE_RANGES_PER_COMMIT_HISTOGRAM = "RocksDBDeleteRangesPerCommit"_sr;
+const StringRef ROCKSDB_COMMIT_BATCH_BYTES_HISTOGRAM = "RocksDBCommitBatchBytes"_sr;
 
 rocksdb::ExportImportFilesMetaData getMetaData(const CheckpointMetaData& checkpoint) {
 	rocksdb::ExportImportFilesMetaData metaData;
@@ -537,13 +543,15 @@ struct Counters {
 	Counter convertedDeleteRangeReqs;
 	Counter rocksdbReadRangeQueries;
 	Counter commitDelayed;
+	Counter largeCommits;
 
 	Counters()
 	  : cc("RocksDBThrottle"), immediateThrottle("ImmediateThrottle", cc), failedToAcquire("FailedToAcquire", cc),
 	    deleteKeyReqs("DeleteKeyRequests", cc), deleteRangeReqs("DeleteRangeRequests", cc),
 	    convertedDeleteKeyReqs("ConvertedDeleteKeyRequests", cc),
 	    convertedDeleteRangeReqs("ConvertedDeleteRangeRequests", cc),
-	    rocksdbReadRangeQueries("RocksdbReadRangeQueries", cc), commitDelayed("CommitDelayed", cc) {}
+	    rocksdbReadRangeQueries("RocksdbReadRangeQueries", cc), commitDelayed("CommitDelayed", cc),
+	    largeCommits("LargeCommits", cc) {}
 };
 
 struct ReadIterator {
@@ -729,6 +737,9 @@ public:
 	void reset();
 	void set(int index);
 	void log(bool ignoreZeroMetric);
+	// Traces the perf context of the calling thread for a single read, so that a slow or debugged request can be
+	// broken down into time spent queued, in the memtables, in the block cache and on disk.
+	void trace(UID id, const char* method, Optional<UID> debugID, double queueWait, double duration, int reads = 1);
 
 private:
 	std::vector<std::tuple<const char*, int, std::vector<uint64_t>>> metrics;
@@ -844,6 +855,27 @@ void PerfContextMetrics::log(bool ignoreZeroMetric) {
 	}
 }
 
+void PerfContextMetrics::trace(UID id,
+                               const char* method,
+                               Optional<UID> debugID,
+                               double queueWait,
+                               double duration,
+                               int reads) {
+	TraceEvent e(SevInfo, "RocksDBReadPerfContext", id);
+	e.setMaxEventLength(20000);
+	e.detail("Method", method);
+	if (debugID.present()) {
+		e.detail("DebugID", debugID.get());
+	}
+	e.detail("Reads", reads).detail("QueueWait", queueWait).detail("Duration", duration);
+	for (auto& [name, metric, vals] : metrics) {
+		uint64_t v = getRocksdbPerfcontextMetric(metric);
+		if (v != 0) {
+			e.detail(name, v);
+		}
+	}
+}
+
 uint64_t PerfContextMetrics::getRocksdbPerfcontextMetric(int metric) {
 	switch (metric) {
 	case rocksdb_user_key_comparison_count:
@@ -1587,8 +1619,16 @@ struct RocksDBKeyValueStore : IKeyValueStore {
 
 			rocksdb::WriteOptions options;
 			options.sync = !SERVER_KNOBS->ROCKSDB_UNSAFE_AUTO_FSYNC;
+			double writeBeginTime = timer_monotonic();
 			rocksdb::Status s = db->Write(options, a.batchToCommit.get());
 			readIterPool->update();
+			if (a.batchToCommit->GetDataSize() >= SERVER_KNOBS->ROCKSDB_LARGE_COMMIT_BYTES) {
+				TraceEvent(SevInfo, "RocksDBLargeCommit", id)
+				    .detail("Bytes", a.batchToCommit->GetDataSize())
+				    .detail("Operations", a.batchToCommit->Count())
+				    .detail("QueueWait", commitBeginTime - a.startTime)
+				    .detail("WriteDuration", timer_monotonic() - writeBeginTime);
+			}
 
 			if (!s.ok()) {
 				logRocksDBError(id, s, "Commit");
@@ -1712,7 +1752,8 @@ struct RocksDBKeyValueStore : IKeyValueStore {
 			readValuePrefixTimeout = SERVER_KNOBS->ROCKSDB_READ_VALUE_PREFIX_TIMEOUT;
 			readRangeTimeout = SERVER_KNOBS->ROCKSDB_READ_RANGE_TIMEOUT;
 
-			if (SERVER_KNOBS->ROCKSDB_PERFCONTEXT_ENABLE) {
+			if (SERVER_KNOBS->ROCKSDB_PERFCONTEXT_ENABLE ||
+			    SERVER_KNOBS->ROCKSDB_PERFCONTEXT_READ_TRACE_SAMPLE_RATE > 0) {
 				// Enable perf context on the same thread with the db thread
 				rocksdb::SetPerfLevel(rocksdb::PerfLevel::kEnableTimeExceptForMutex);
 				perfContextMetrics->reset();
@@ -1721,6 +1762,17 @@ struct RocksDBKeyValueStore : IKeyValueStore {
 
 		void init() override {}
 
+		// Reads carrying a debug ID are always traced so their breakdown can be matched with the request's
+		// GetValueDebug events, other reads are traced at the sample rate.
+		bool sampleReadPerfContext(const Optional<UID>& debugID) const {
+			if (!SERVER_KNOBS->ROCKSDB_PERFCONTEXT_ENABLE &&
+			    SERVER_KNOBS->ROCKSDB_PERFCONTEXT_READ_TRACE_SAMPLE_RATE <= 0) {
+				return false;
+			}
+			return debugID.present() ||
+			       deterministicRandom()->random01() < SERVER_KNOBS->ROCKSDB_PERFCONTEXT_READ_TRACE_SAMPLE_RATE;
+		}
+
 		struct ReadValueAction : TypedAction<Reader, ReadValueAction> {
 			Key key;
 			ReadType type;
@@ -1738,7 +1790,8 @@ struct RocksDBKeyValueStore : IKeyValueStore {
 			bool doPerfContextMetrics =
 			    SERVER_KNOBS->ROCKSDB_PERFCONTEXT_ENABLE &&
 			    (deterministicRandom()->random01() < SERVER_KNOBS->ROCKSDB_PERFCONTEXT_SAMPLE_RATE);
-			if (doPerfContextMetrics) {
+			bool tracePerfContext = sampleReadPerfContext(a.debugID);
+			if (doPerfContextMetrics || tracePerfContext) {
 				perfContextMetrics->reset();
 			}
 			const double readBeginTime = timer_monotonic();
@@ -1797,6 +1850,129 @@ struct RocksDBKeyValueStore : IKeyValueStore {
 				metricPromiseStream->send(
 				    std::make_pair(ROCKSDB_READVALUE_LATENCY_HISTOGRAM.toString(), endTime - a.startTime));
 			}
+			if (tracePerfContext) {
+				perfContextMetrics->trace(
+				    id, "ReadValue", a.debugID, readBeginTime - a.startTime, endTime - readBeginTime);
+			}
+			if (doPerfContextMetrics) {
+				perfContextMetrics->set(threadIndex);
+			}
+		}
+
+		// Point reads posted in the same run loop tick, served by a single MultiGet so that RocksDB can batch the
+		// bloom filter probes and issue the block reads in parallel.
+		struct ReadValueBatchAction : TypedAction<Reader, ReadValueBatchAction> {
+			std::vector<std::unique_ptr<ReadValueAction>> reads;
+			double getTimeEstimate() const override { return SERVER_KNOBS->READ_VALUE_TIME_ESTIMATE * reads.size(); }
+			// The debug ID of the first read being traced, if any
+			Optional<UID> debugID() const {
+				for (auto& r : reads) {
+					if (r->debugID.present()) {
+						return r->debugID;
+					}
+				}
+				return Optional<UID>();
+			}
+		};
+		void action(ReadValueBatchAction& batch) {
+			ASSERT(cf != nullptr);
+			if (batch.reads.size() == 1) {
+				action(*batch.reads[0]);
+				return;
+			}
+			bool doPerfContextMetrics =
+			    SERVER_KNOBS->ROCKSDB_PERFCONTEXT_ENABLE &&
+			    (deterministicRandom()->random01() < SERVER_KNOBS->ROCKSDB_PERFCONTEXT_SAMPLE_RATE);
+			bool tracePerfContext = sampleReadPerfContext(batch.debugID());
+			if (doPerfContextMetrics || tracePerfContext) {
+				perfContextMetrics->reset();
+			}
+			const double readBeginTime = timer_monotonic();
+			std::vector<ReadValueAction*> reads;
+			std::vector<rocksdb::Slice> keys;
+			Optional<TraceBatch> traceBatch;
+			// The deadline applies to the whole MultiGet, so it is only set when every read in it may time out
+			bool setDeadline = SERVER_KNOBS->ROCKSDB_SET_READ_TIMEOUT;
+			double timeLeft = readValueTimeout;
+			for (auto& r : batch.reads) {
+				ReadValueAction& a = *r;
+				if (a.getHistograms) {
+					metricPromiseStream->send(
+					    std::make_pair(ROCKSDB_READVALUE_QUEUEWAIT_HISTOGRAM.toString(), readBeginTime - a.startTime));
+				}
+				if (a.debugID.present()) {
+					if (!traceBatch.present()) {
+						traceBatch = { TraceBatch{} };
+					}
+					traceBatch.get().addEvent("GetValueDebug", a.debugID.get().first(), "Reader.Before");
+				}
+				if (!shouldThrottle(a.type, a.key)) {
+					setDeadline = false;
+				} else if (SERVER_KNOBS->ROCKSDB_SET_READ_TIMEOUT) {
+					if (readBeginTime - a.startTime > readValueTimeout) {
+						TraceEvent(SevWarn, "KVSTimeout", id)
+						    .detail("Error", "Read value request timedout")
+						    .detail("Method", "ReadValueBatchAction")
+						    .detail("TimeoutValue", readValueTimeout);
+						a.result.sendError(transaction_too_old());
+						continue;
+					}
+					timeLeft = std::min(timeLeft, readValueTimeout - (readBeginTime - a.startTime));
+				}
+				reads.push_back(&a);
+				keys.push_back(toSlice(a.key));
+			}
+			if (reads.empty()) {
+				if (traceBatch.present()) {
+					traceBatch.get().dump();
+				}
+				return;
+			}
+
+			rocksdb::ReadOptions readOptions = sharedState->getReadOptions();
+			if (setDeadline) {
+				uint64_t deadlineMircos = db->GetEnv()->NowMicros() + timeLeft * 1000000;
+				std::chrono::seconds deadlineSeconds(deadlineMircos / 1000000);
+				readOptions.deadline = std::chrono::duration_cast<std::chrono::microseconds>(deadlineSeconds);
+			}
+
+			std::vector<rocksdb::PinnableSlice> values(reads.size());
+			std::vector<rocksdb::Status> statuses(reads.size());
+			db->MultiGet(readOptions, cf, reads.size(), keys.data(), values.data(), statuses.data());
+
+			const double endTime = timer_monotonic();
+			for (int i = 0; i < reads.size(); i++) {
+				ReadValueAction& a = *reads[i];
+				const rocksdb::Status& s = statuses[i];
+				if (a.debugID.present()) {
+					traceBatch.get().addEvent("GetValueDebug", a.debugID.get().first(), "Reader.After");
+				}
+				if (s.ok()) {
+					a.result.send(Value(toStringRef(values[i])));
+				} else if (s.IsNotFound()) {
+					a.result.send(Optional<Value>());
+				} else {
+					logRocksDBError(id, s, "ReadValueBatch");
+					a.result.sendError(statusToError(s));
+				}
+				if (a.getHistograms) {
+					metricPromiseStream->send(
+					    std::make_pair(ROCKSDB_READVALUE_ACTION_HISTOGRAM.toString(), endTime - readBeginTime));
+					metricPromiseStream->send(
+					    std::make_pair(ROCKSDB_READVALUE_LATENCY_HISTOGRAM.toString(), endTime - a.startTime));
+				}
+			}
+			if (traceBatch.present()) {
+				traceBatch.get().dump();
+			}
+			if (tracePerfContext) {
+				perfContextMetrics->trace(id,
+				                          "ReadValueBatch",
+				                          batch.debugID(),
+				                          readBeginTime - batch.reads[0]->startTime,
+				                          endTime - readBeginTime,
+				                          batch.reads.size());
+			}
 			if (doPerfContextMetrics) {
 				perfContextMetrics->set(threadIndex);
 			}
@@ -1819,7 +1995,8 @@ struct RocksDBKeyValueStore : IKeyValueStore {
 			bool doPerfContextMetrics =
 			    SERVER_KNOBS->ROCKSDB_PERFCONTEXT_ENABLE &&
 			    (deterministicRandom()->random01() < SERVER_KNOBS->ROCKSDB_PERFCONTEXT_SAMPLE_RATE);
-			if (doPerfContextMetrics) {
+			bool tracePerfContext = sampleReadPerfContext(a.debugID);
+			if (doPerfContextMetrics || tracePerfContext) {
 				perfContextMetrics->reset();
 			}
 			const double readBeginTime = timer_monotonic();
@@ -1877,6 +2054,10 @@ struct RocksDBKeyValueStore : IKeyValueStore {
 				metricPromiseStream->send(
 				    std::make_pair(ROCKSDB_READPREFIX_LATENCY_HISTOGRAM.toString(), endTime - a.startTime));
 			}
+			if (tracePerfContext) {
+				perfContextMetrics->trace(
+				    id, "ReadValuePrefix", a.debugID, readBeginTime - a.startTime, endTime - readBeginTime);
+			}
 			if (doPerfContextMetrics) {
 				perfContextMetrics->set(threadIndex);
 			}
@@ -1886,11 +2067,13 @@ struct RocksDBKeyValueStore : IKeyValueStore {
 			KeyRange keys;
 			int rowLimit, byteLimit;
 			ReadType type;
+			Optional<UID> debugID;
 			double startTime;
 			bool getHistograms;
 			ThreadReturnPromise<RangeResult> result;
-			ReadRangeAction(KeyRange keys, int rowLimit, int byteLimit, ReadType type)
-			  : keys(keys), rowLimit(rowLimit), byteLimit(byteLimit), type(type), startTime(timer_monotonic()),
+			ReadRangeAction(KeyRange keys, int rowLimit, int byteLimit, ReadType type, Optional<UID> debugID)
+			  : keys(keys), rowLimit(rowLimit), byteLimit(byteLimit), type(type), debugID(debugID),
+			    startTime(timer_monotonic()),
 			    getHistograms(deterministicRandom()->random01() < SERVER_KNOBS->ROCKSDB_HISTOGRAMS_SAMPLE_RATE) {}
 			double getTimeEstimate() const override { return SERVER_KNOBS->READ_RANGE_TIME_ESTIMATE; }
 		};
@@ -1898,7 +2081,8 @@ struct RocksDBKeyValueStore : IKeyValueStore {
 			bool doPerfContextMetrics =
 			    SERVER_KNOBS->ROCKSDB_PERFCONTEXT_ENABLE &&
 			    (deterministicRandom()->random01() < SERVER_KNOBS->ROCKSDB_PERFCONTEXT_SAMPLE_RATE);
-			if (doPerfContextMetrics) {
+			bool tracePerfContext = sampleReadPerfContext(a.debugID);
+			if (doPerfContextMetrics || tracePerfContext) {
 				perfContextMetrics->reset();
 			}
 			const double readBeginTime = timer_monotonic();
@@ -2009,6 +2193,10 @@ struct RocksDBKeyValueStore : IKeyValueStore {
 				metricPromiseStream->send(
 				    std::make_pair(ROCKSDB_READRANGE_LATENCY_HISTOGRAM.toString(), endTime - a.startTime));
 			}
+			if (tracePerfContext) {
+				perfContextMetrics->trace(
+				    id, "ReadRange", a.debugID, readBeginTime - a.startTime, endTime - readBeginTime);
+			}
 			if (doPerfContextMetrics) {
 				perfContextMetrics->set(threadIndex);
 			}
@@ -2033,7 +2221,10 @@ struct RocksDBKeyValueStore : IKeyValueStore {
 	                                                           ROCKSDB_DELETE_RANGES_PER_COMMIT_HISTOGRAM,
 	                                                           Histogram::Unit::countLinear,
 	                                                           0,
-	                                                           10000)) {
+	                                                           10000)),
+	    commitBatchBytesHistogram(Histogram::getHistogram(ROCKSDBSTORAGE_HISTOGRAM_GROUP,
+	                                                      ROCKSDB_COMMIT_BATCH_BYTES_HISTOGRAM,
+	                                                      Histogram::Unit::bytes)) {
 		eventListener = std::make_shared<RocksDBEventListener>(sharedState);
 		// In simluation, run the reader/writer threads as Coro threads (i.e. in the network thread. The storage engine
 		// is still multi-threaded as background compaction threads are still present. Reads/writes to disk will also
@@ -2201,6 +2392,7 @@ struct RocksDBKeyValueStore : IKeyValueStore {
 		// The metrics future retains a reference to the DB, so stop it before we delete it.
 		self->metrics.reset();
 
+		self->postReadValueBatch();
 		wait(self->readThreads->stop());
 		self->readIterPool.reset();
 		auto a = new Writer::CloseAction(self->path, deleteOnClose);
@@ -2373,6 +2565,10 @@ struct RocksDBKeyValueStore : IKeyValueStore {
 		self->maxDeletes = SERVER_KNOBS->ROCKSDB_SINGLEKEY_DELETES_MAX;
 		self->deletesPerCommitHistogram->sampleRecordCounter(self->deletesPerCommit);
 		self->deleteRangesPerCommitHistogram->sampleRecordCounter(self->deleteRangesPerCommit);
+		self->commitBatchBytesHistogram->sample(std::min<size_t>(a->batchToCommit->GetDataSize(), UINT32_MAX));
+		if (a->batchToCommit->GetDataSize() >= SERVER_KNOBS->ROCKSDB_LARGE_COMMIT_BYTES) {
+			++self->counters.largeCommits;
+		}
 		if (self->deletesPerCommit > 8000 || self->deleteRangesPerCommit > 1000)
 			TraceEvent("RocksDBDeletesCount", self->id)
 			    .detail("DeletesPerCommit", self->deletesPerCommit)
@@ -2419,6 +2615,59 @@ struct RocksDBKeyValueStore : IKeyValueStore {
 		return result;
 	}
 
+	// Point reads are not posted to the reader threads individually, but collected until the end of the current
+	// run loop tick (or until the batch is full) and then posted as one ReadValueBatchAction.
+	void postReadValue(Reader::ReadValueAction* a) {
+		if (SERVER_KNOBS->ROCKSDB_READ_VALUE_BATCH_MAX_KEYS <= 1) {
+			readThreads->post(a);
+			return;
+		}
+		if (!pendingReadValues) {
+			pendingReadValues = std::make_unique<Reader::ReadValueBatchAction>();
+			if (!readValueBatchFlush.isValid() || readValueBatchFlush.isReady()) {
+				readValueBatchFlush = flushReadValueBatch(this);
+			}
+		}
+		pendingReadValues->reads.emplace_back(a);
+		if (pendingReadValues->reads.size() >= SERVER_KNOBS->ROCKSDB_READ_VALUE_BATCH_MAX_KEYS) {
+			postReadValueBatch();
+		}
+	}
+
+	void postReadValueBatch() {
+		if (pendingReadValues) {
+			readThreads->post(pendingReadValues.release());
+		}
+	}
+
+	// A flush may find a batch that was started after the one it was scheduled for, in which case that batch is
+	// just posted early.
+	ACTOR static Future<Void> flushReadValueBatch(RocksDBKeyValueStore* self) {
+		wait(delay(0));
+		self->postReadValueBatch();
+		return Void();
+	}
+
+	ACTOR static Future<Optional<Value>> read(Reader::ReadValueAction* action,
+	                                          FlowLock* semaphore,
+	                                          RocksDBKeyValueStore* self,
+	                                          Counter* counter) {
+		state std::unique_ptr<Reader::ReadValueAction> a(action);
+		state Optional<Void> slot = wait(timeout(semaphore->take(), SERVER_KNOBS->ROCKSDB_READ_QUEUE_WAIT));
+		if (!slot.present()) {
+			++(*counter);
+			throw server_overloaded();
+		}
+
+		state FlowLock::Releaser release(*semaphore);
+
+		auto fut = a->result.getFuture();
+		self->postReadValue(a.release());
+		Optional<Value> result = wait(fut);
+
+		return result;
+	}
+
 	Future<Optional<Value>> readValue(KeyRef key, Optional<ReadOptions> options) override {
 		ReadType type = ReadType::NORMAL;
 		Optional<UID> debugID;
@@ -2431,7 +2680,7 @@ struct RocksDBKeyValueStore : IKeyValueStore {
 		if (!shouldThrottle(type, key)) {
 			auto a = new Reader::ReadValueAction(key, type, debugID);
 			auto res = a->result.getFuture();
-			readThreads->post(a);
+			postReadValue(a);
 			return res;
 		}
 
@@ -2440,7 +2689,7 @@ struct RocksDBKeyValueStore : IKeyValueStore {
 
 		checkWaiters(semaphore, maxWaiters);
 		auto a = std::make_unique<Reader::ReadValueAction>(key, type, debugID);
-		return read(a.release(), &semaphore, readThreads.getPtr(), &counters.failedToAcquire);
+		return read(a.release(), &semaphore, this, &counters.failedToAcquire);
 	}
 
 	Future<Optional<Value>> readValuePrefix(KeyRef key, int maxLength, Optional<ReadOptions> options) override {
@@ -2492,14 +2741,16 @@ struct RocksDBKeyValueStore : IKeyValueStore {
 	                              int byteLimit,
 	                              Optional<ReadOptions> options) override {
 		ReadType type = ReadType::NORMAL;
+		Optional<UID> debugID;
 
 		if (options.present()) {
 			type = options.get().type;
+			debugID = options.get().debugID;
 		}
 
 		if (!shouldThrottle(type, keys.begin)) {
 			++counters.rocksdbReadRangeQueries;
-			auto a = new Reader::ReadRangeAction(keys, rowLimit, byteLimit, type);
+			auto a = new Reader::ReadRangeAction(keys, rowLimit, byteLimit, type, debugID);
 			auto res = a->result.getFuture();
 			readThreads->post(a);
 			return res;
@@ -2510,7 +2761,7 @@ struct RocksDBKeyValueStore : IKeyValueStore {
 
 		checkWaiters(semaphore, maxWaiters);
 		++counters.rocksdbReadRangeQueries;
-		auto a = std::make_unique<Reader::ReadRangeAction>(keys, rowLimit, byteLimit, type);
+		auto a = std::make_unique<Reader::ReadRangeAction>(keys, rowLimit, byteLimit, type, debugID);
 		return read(a.release(), &semaphore, readThreads.getPtr(), &counters.failedToAcquire);
 	}
 
@@ -2619,12 +2870,15 @@ struct RocksDBKeyValueStore : IKeyValueStore {
 	int deleteRangesPerCommit;
 	Reference<Histogram> deletesPerCommitHistogram;
 	Reference<Histogram> deleteRangesPerCommitHistogram;
+	Reference<Histogram> commitBatchBytesHistogram;
 	Optional<Future<Void>> metrics;
 	FlowLock readSemaphore;
 	int numReadWaiters;
 	FlowLock fetchSemaphore;
 	int numFetchWaiters;
 	std::shared_ptr<ReadIteratorPool> readIterPool;
+	std::unique_ptr<Reader::ReadValueBatchAction> pendingReadValues;
+	Future<Void> readValueBatchFlush;
 	std::vector<std::unique_ptr<ThreadReturnPromiseStream<std::pair<std::string, double>>>> metricPromiseStreams;
 	// ThreadReturnPromiseStream pair.first stores the histogram name and
 	// pair.second stores the corresponding measured latency (seconds)
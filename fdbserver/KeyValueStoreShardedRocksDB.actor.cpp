@@ -15,6 +15,7 @@
 #include <rocksdb/listener.h>
 #include <rocksdb/metadata.h>
 #include <rocksdb/options.h>
+#include <rocksdb/convenience.h>
 #include <rocksdb/perf_context.h>
 #include <rocksdb/rate_limiter.h>
 #include <rocksdb/advanced_options.h>
@@ -22,8 +23,10 @@
 #include <rocksdb/statistics.h>
 #include <rocksdb/table.h>
 #include <rocksdb/utilities/checkpoint.h>
+#include <rocksdb/utilities/options_util.h>
 #include <rocksdb/utilities/table_properties_collectors.h>
 #include <rocksdb/version.h>
+#include <rocksdb/write_buffer_manager.h>
 #if defined __has_include
 #if __has_include(<liburing.h>)
 #include <liburing.h>
@@ -493,15 +496,25 @@ struct ShardedRocksDBState {
 	bool closing = false;
 	Counters counters;
 	std::shared_ptr<rocksdb::Cache> blockCache = nullptr;
+	// Charges the memtables of all physical shards to blockCache, so both draw from one memory budget
+	std::shared_ptr<rocksdb::WriteBufferManager> writeBufferManager = nullptr;
 	std::shared_ptr<CompactOnRangeDeletionCollectorFactory> compactOnRangeDeletionFactory = nullptr;
+	// Key prefixes whose physical shards use a prefix filter of the given length, parsed from
+	// SHARDED_ROCKSDB_PREFIX_FILTER_RANGES. Other shards use SHARDED_ROCKSDB_PREFIX_LEN.
+	std::vector<std::pair<Key, int>> prefixFilterRanges;
 
 	ShardedRocksDBState() {
+		prefixFilterRanges = parsePrefixFilterRanges(SERVER_KNOBS->SHARDED_ROCKSDB_PREFIX_FILTER_RANGES);
 		if (SERVER_KNOBS->SHARDED_ROCKSDB_BLOCK_CACHE_SIZE > 0) {
 			blockCache =
 			    rocksdb::NewLRUCache(SERVER_KNOBS->SHARDED_ROCKSDB_BLOCK_CACHE_SIZE,
 			                         -1, /* num_shard_bits, default value:-1*/
 			                         false, /* strict_capacity_limit, default value:false */
 			                         SERVER_KNOBS->SHARDED_ROCKSDB_CACHE_HIGH_PRI_POOL_RATIO /* high_pri_pool_ratio */);
+			if (SERVER_KNOBS->SHARDED_ROCKSDB_CHARGE_MEMTABLES_TO_BLOCK_CACHE) {
+				writeBufferManager = std::make_shared<rocksdb::WriteBufferManager>(
+				    SERVER_KNOBS->SHARDED_ROCKSDB_TOTAL_WRITE_BUFFER_SIZE, blockCache);
+			}
 		}
 		if (SERVER_KNOBS->SHARDED_ROCKSDB_COMPACT_ON_RANGE_DELETION_THRESHOLD > 0) {
 			compactOnRangeDeletionFactory = std::make_shared<CompactOnRangeDeletionCollectorFactory>(
@@ -509,7 +522,40 @@ struct ShardedRocksDBState {
 		}
 	}
 
-	rocksdb::ColumnFamilyOptions getCFOptions() {
+	// Parses a comma separated list of <key prefix>:<prefix length> entries, where the key prefix is in printable form
+	static std::vector<std::pair<Key, int>> parsePrefixFilterRanges(const std::string& config) {
+		std::vector<std::pair<Key, int>> ranges;
+		for (const auto& entry : parseStringToVector<std::string>(config, ',')) {
+			const size_t sep = entry.rfind(':');
+			if (entry.empty() || sep == std::string::npos) {
+				TraceEvent(SevWarnAlways, "ShardedRocksDBInvalidPrefixFilterRange").detail("Entry", entry);
+				continue;
+			}
+			const int prefixLen = atoi(entry.substr(sep + 1).c_str());
+			if (prefixLen < 0) {
+				TraceEvent(SevWarnAlways, "ShardedRocksDBInvalidPrefixFilterRange").detail("Entry", entry);
+				continue;
+			}
+			ranges.emplace_back(Key(unprintable(entry.substr(0, sep))), prefixLen);
+		}
+		return ranges;
+	}
+
+	// Returns the prefix filter length for a new physical shard whose first range begins at the given key. The
+	// longest matching key prefix wins.
+	int prefixLength(KeyRef begin) const {
+		int prefixLen = SERVER_KNOBS->SHARDED_ROCKSDB_PREFIX_LEN;
+		int matchedLen = -1;
+		for (const auto& [prefix, len] : prefixFilterRanges) {
+			if (begin.startsWith(prefix) && prefix.size() > matchedLen) {
+				prefixLen = len;
+				matchedLen = prefix.size();
+			}
+		}
+		return prefixLen;
+	}
+
+	rocksdb::ColumnFamilyOptions getCFOptions(int prefixLen = SERVER_KNOBS->SHARDED_ROCKSDB_PREFIX_LEN) {
 		rocksdb::ColumnFamilyOptions options;
 
 		if (SERVER_KNOBS->ROCKSDB_LEVEL_COMPACTION_DYNAMIC_LEVEL_BYTES) {
@@ -563,9 +609,9 @@ struct ShardedRocksDBState {
 		}
 
 		rocksdb::BlockBasedTableOptions bbOpts;
-		if (SERVER_KNOBS->SHARDED_ROCKSDB_PREFIX_LEN > 0) {
+		if (prefixLen > 0) {
 			// Prefix blooms are used during Seek.
-			options.prefix_extractor.reset(rocksdb::NewFixedPrefixTransform(SERVER_KNOBS->SHARDED_ROCKSDB_PREFIX_LEN));
+			options.prefix_extractor.reset(rocksdb::NewFixedPrefixTransform(prefixLen));
 
 			// Also turn on bloom filters in the memtable.
 			options.memtable_prefix_bloom_size_ratio = SERVER_KNOBS->SHARDED_ROCKSDB_MEMTABLE_BLOOM_FILTER_RATIO;
@@ -579,7 +625,15 @@ struct ShardedRocksDBState {
 			// Create and apply a bloom filter using the 10 bits
 			// which should yield a ~1% false positive rate:
 			// https://github.com/facebook/rocksdb/wiki/RocksDB-Bloom-Filter#full-filters-new-format
-			bbOpts.filter_policy.reset(rocksdb::NewBloomFilterPolicy(SERVER_KNOBS->SHARDED_ROCKSDB_BLOOM_FILTER_BITS));
+			// Ribbon filters take about 30% less memory than Bloom filters for the same false positive rate, at the
+			// cost of more CPU when building them.
+			if (SERVER_KNOBS->SHARDED_ROCKSDB_USE_RIBBON_FILTER) {
+				bbOpts.filter_policy.reset(
+				    rocksdb::NewRibbonFilterPolicy(SERVER_KNOBS->SHARDED_ROCKSDB_BLOOM_FILTER_BITS));
+			} else {
+				bbOpts.filter_policy.reset(
+				    rocksdb::NewBloomFilterPolicy(SERVER_KNOBS->SHARDED_ROCKSDB_BLOOM_FILTER_BITS));
+			}
 
 			// The whole key blooms are only used for point lookups.
 			// https://github.com/facebook/rocksdb/wiki/RocksDB-Bloom-Filter#prefix-vs-whole-key
@@ -603,8 +657,9 @@ struct ShardedRocksDBState {
 		return options;
 	}
 
-	rocksdb::ColumnFamilyOptions getCFOptionsForInactiveShard() {
-		auto options = getCFOptions();
+	rocksdb::ColumnFamilyOptions getCFOptionsForInactiveShard(
+	    int prefixLen = SERVER_KNOBS->SHARDED_ROCKSDB_PREFIX_LEN) {
+		auto options = getCFOptions(prefixLen);
 		// never slowdown ingest.
 		options.level0_file_num_compaction_trigger = (1 << 30);
 		options.level0_slowdown_writes_trigger = (1 << 30);
@@ -850,7 +905,8 @@ rocksdb::DBOptions getOptions() {
 rocksdb::ReadOptions getReadOptions() {
 	rocksdb::ReadOptions options;
 	options.background_purge_on_iterator_cleanup = true;
-	options.auto_prefix_mode = (SERVER_KNOBS->SHARDED_ROCKSDB_PREFIX_LEN > 0);
+	options.auto_prefix_mode =
+	    (SERVER_KNOBS->SHARDED_ROCKSDB_PREFIX_LEN > 0 || !SERVER_KNOBS->SHARDED_ROCKSDB_PREFIX_FILTER_RANGES.empty());
 	options.async_io = SERVER_KNOBS->SHARDED_ROCKSDB_READ_ASYNC_IO;
 	return options;
 }
@@ -864,9 +920,10 @@ struct ReadIterator {
 	ReadIterator(rocksdb::ColumnFamilyHandle* cf, rocksdb::DB* db)
 	  : creationTime(now()), iter(db->NewIterator(getReadOptions(), cf)) {}
 
-	ReadIterator(rocksdb::ColumnFamilyHandle* cf, rocksdb::DB* db, const KeyRange& range)
+	ReadIterator(rocksdb::ColumnFamilyHandle* cf, rocksdb::DB* db, const KeyRange& range, bool fillCache = true)
 	  : creationTime(now()), keyRange(range) {
 		auto options = getReadOptions();
+		options.fill_cache = fillCache;
 		beginSlice = std::unique_ptr<rocksdb::Slice>(new rocksdb::Slice(toSlice(keyRange.begin)));
 		options.iterate_lower_bound = beginSlice.get();
 		endSlice = std::unique_ptr<rocksdb::Slice>(new rocksdb::Slice(toSlice(keyRange.end)));
@@ -1041,6 +1098,9 @@ struct PhysicalShard {
 			if (!sstFiles.empty()) {
 				rocksdb::IngestExternalFileOptions ingestOptions;
 				ingestOptions.move_files = SERVER_KNOBS->ROCKSDB_IMPORT_MOVE_FILES;
+				// Fetched files may be hard links to the source server's checkpoint files, which must not be
+				// rewritten, so the global sequence number is kept in the manifest instead.
+				ingestOptions.write_global_seqno = false;
 				ingestOptions.verify_checksums_before_ingest = SERVER_KNOBS->ROCKSDB_VERIFY_CHECKSUM_BEFORE_RESTORE;
 				status = db->IngestExternalFile(cf, sstFiles, ingestOptions);
 			} else {
@@ -1131,6 +1191,20 @@ struct PhysicalShard {
 	uint64_t numRangeDeletions = 0;
 	double deleteTimeSec = 0.0;
 	double lastCompactionTime = 0.0;
+
+	// Bytes returned by reads of this shard, updated by the reader threads
+	std::atomic<int64_t> readBytes = 0;
+	// Value of readBytes at the last metrics interval and the read rate over that interval
+	int64_t lastReadBytes = 0;
+	double readBytesPerSec = 0.0;
+	// Set while this shard reads less than SHARDED_ROCKSDB_CACHE_FILL_MIN_READ_FRACTION of the average shard read
+	// rate, in which case its reads use blocks already in the block cache but do not insert new ones.
+	std::atomic<bool> skipCacheFill = false;
+	// Last time the read rate of this shard was above SHARDED_ROCKSDB_COLD_SHARD_MAX_READ_BYTES_PER_SEC, or when the
+	// metrics logger first saw it. The shard is cold once it has stayed below that rate for
+	// SHARDED_ROCKSDB_COLD_SHARD_MIN_IDLE_TIME.
+	double lastHotTime = 0.0;
+	bool cold = false;
 };
 
 int readRangeInDb(PhysicalShard* shard,
@@ -1138,7 +1212,8 @@ int readRangeInDb(PhysicalShard* shard,
                   int rowLimit,
                   int byteLimit,
                   RangeResult* result,
-                  std::shared_ptr<IteratorPool> iteratorPool) {
+                  std::shared_ptr<IteratorPool> iteratorPool,
+                  bool fillCache = true) {
 	if (rowLimit == 0 || byteLimit == 0) {
 		return 0;
 	}
@@ -1147,7 +1222,9 @@ int readRangeInDb(PhysicalShard* shard,
 	rocksdb::Status s;
 	std::shared_ptr<ReadIterator> readIter = nullptr;
 
-	bool reuseIterator = SERVER_KNOBS->SHARDED_ROCKSDB_REUSE_ITERATORS && iteratorPool != nullptr;
+	// Pooled iterators are shared by all reads of the shard, so reads which skip cache fills use their own iterator
+	fillCache = fillCache && !shard->skipCacheFill.load();
+	bool reuseIterator = SERVER_KNOBS->SHARDED_ROCKSDB_REUSE_ITERATORS && iteratorPool != nullptr && fillCache;
 	if (g_network->isSimulated() &&
 	    deterministicRandom()->random01() > SERVER_KNOBS->ROCKSDB_PROBABILITY_REUSE_ITERATOR_SIM) {
 		// Reduce probability of reusing iterators in simulation.
@@ -1161,7 +1238,7 @@ int readRangeInDb(PhysicalShard* shard,
 			readIter = std::make_shared<ReadIterator>(shard->cf, shard->db);
 		}
 	} else {
-		readIter = std::make_shared<ReadIterator>(shard->cf, shard->db, range);
+		readIter = std::make_shared<ReadIterator>(shard->cf, shard->db, range, fillCache);
 	}
 	// When using a prefix extractor, ensure that keys are returned in order even if they cross
 	// a prefix boundary.
@@ -1223,6 +1300,9 @@ public:
 	             std::shared_ptr<IteratorPool> iteratorPool)
 	  : path(path), logId(logId), rState(rState), dbOptions(options), dataShardMap(nullptr, specialKeys.end),
 	    counters(cc), iteratorPool(iteratorPool) {
+		if (rState->writeBufferManager) {
+			dbOptions.write_buffer_manager = rState->writeBufferManager;
+		}
 		if (!g_network->isSimulated()) {
 			// Generating trace events in non-FDB thread will cause errors. The event listener is tested with local FDB
 			// cluster.
@@ -1239,6 +1319,7 @@ public:
 	                                             ShardManager* shardManager) {
 		state std::unordered_map<std::string, std::shared_ptr<PhysicalShard>>* physicalShards =
 		    shardManager->getAllShards();
+		state double lastLogTime = now();
 
 		try {
 			wait(openFuture);
@@ -1248,7 +1329,55 @@ public:
 					break;
 				}
 
+				const double elapsed = std::max(now() - lastLogTime, 1e-6);
+				lastLogTime = now();
+				double totalReadBytesPerSec = 0.0;
+				for (auto& [id, shard] : *physicalShards) {
+					const int64_t readBytes = shard->readBytes.load();
+					shard->readBytesPerSec = (readBytes - shard->lastReadBytes) / elapsed;
+					shard->lastReadBytes = readBytes;
+					totalReadBytesPerSec += shard->readBytesPerSec;
+				}
+				// Shards reading far less than the average are cold, and stop filling the block cache so that they
+				// cannot evict the blocks of the hot shards
+				const double minReadFraction = SERVER_KNOBS->SHARDED_ROCKSDB_CACHE_FILL_MIN_READ_FRACTION;
+				const double averageReadBytesPerSec =
+				    physicalShards->empty() ? 0.0 : totalReadBytesPerSec / physicalShards->size();
+				const bool skipColdShards = minReadFraction > 0 && physicalShards->size() > 1;
+				int numCacheFillSkippedShards = 0;
+				for (auto& [id, shard] : *physicalShards) {
+					const bool skip =
+					    skipColdShards && shard->readBytesPerSec < minReadFraction * averageReadBytesPerSec;
+					if (skip != shard->skipCacheFill.load()) {
+						TraceEvent(SevInfo, "PhysicalShardCacheFillSkipped")
+						    .detail("ShardId", id)
+						    .detail("Skipped", skip)
+						    .detail("ReadBytesPerSec", shard->readBytesPerSec)
+						    .detail("AverageReadBytesPerSec", averageReadBytesPerSec);
+						shard->skipCacheFill.store(skip);
+					}
+					numCacheFillSkippedShards += skip;
+
+					if (shard->lastHotTime == 0.0 ||
+					    shard->readBytesPerSec > SERVER_KNOBS->SHARDED_ROCKSDB_COLD_SHARD_MAX_READ_BYTES_PER_SEC) {
+						shard->lastHotTime = now();
+					}
+					const double idleTime = now() - shard->lastHotTime;
+					const bool cold = idleTime >= SERVER_KNOBS->SHARDED_ROCKSDB_COLD_SHARD_MIN_IDLE_TIME;
+					if (cold != shard->cold) {
+						TraceEvent(SevInfo, "PhysicalShardCold")
+						    .detail("ShardId", id)
+						    .detail("Cold", cold)
+						    .detail("ReadBytesPerSec", shard->readBytesPerSec)
+						    .detail("IdleTime", idleTime);
+						shard->cold = cold;
+					}
+				}
+
 				uint64_t numSstFiles = 0;
+				uint64_t totalMemtableBytes = 0;
+				int numColdShards = 0;
+				uint64_t coldShardBytes = 0;
 				for (auto& [id, shard] : *physicalShards) {
 					if (!shard->initialized()) {
 						continue;
@@ -1256,9 +1385,21 @@ public:
 					uint64_t liveDataSize = 0;
 					ASSERT(shard->db->GetIntProperty(
 					    shard->cf, rocksdb::DB::Properties::kEstimateLiveDataSize, &liveDataSize));
+					uint64_t memtableBytes = 0;
+					ASSERT(shard->db->GetIntProperty(
+					    shard->cf, rocksdb::DB::Properties::kCurSizeAllMemTables, &memtableBytes));
+					totalMemtableBytes += memtableBytes;
+					if (shard->cold) {
+						++numColdShards;
+						coldShardBytes += liveDataSize;
+					}
 
 					TraceEvent e(SevInfo, "PhysicalShardStats");
 					e.detail("ShardId", id).detail("LiveDataSize", liveDataSize);
+					e.detail("MemtableBytes", memtableBytes);
+					e.detail("ReadBytesPerSec", shard->readBytesPerSec);
+					e.detail("SkipCacheFill", shard->skipCacheFill.load());
+					e.detail("Cold", shard->cold);
 
 					// Get compression ratio for each level.
 					rocksdb::ColumnFamilyMetaData cfMetadata;
@@ -1281,10 +1422,21 @@ public:
 					}
 					e.detail("NumLevels", numLevels);
 				}
-				TraceEvent(SevInfo, "KVSPhysialShardMetrics")
-				    .detail("NumActiveShards", shardManager->numActiveShards())
+				TraceEvent e(SevInfo, "KVSPhysialShardMetrics");
+				e.detail("NumActiveShards", shardManager->numActiveShards())
 				    .detail("TotalPhysicalShards", shardManager->numPhysicalShards())
-				    .detail("NumSstFiles", numSstFiles);
+				    .detail("NumSstFiles", numSstFiles)
+				    .detail("MemtableBytes", totalMemtableBytes)
+				    .detail("ReadBytesPerSec", totalReadBytesPerSec)
+				    .detail("NumCacheFillSkippedShards", numCacheFillSkippedShards)
+				    .detail("NumColdShards", numColdShards)
+				    .detail("ColdShardBytes", coldShardBytes);
+				if (rState->blockCache) {
+					e.detail("BlockCacheUsage", rState->blockCache->GetUsage());
+				}
+				if (rState->writeBufferManager) {
+					e.detail("WriteBufferManagerUsage", rState->writeBufferManager->memory_usage());
+				}
 			}
 		} catch (Error& e) {
 			if (e.code() != error_code_actor_cancelled) {
@@ -1294,6 +1446,33 @@ public:
 		return Void();
 	}
 
+	// Returns the prefix extractor length of each column family, as recorded in the latest OPTIONS file of the
+	// instance. Column families without a fixed prefix extractor are recorded with length 0.
+	static std::unordered_map<std::string, int> loadPrefixLengths(const std::string& path) {
+		std::unordered_map<std::string, int> prefixLengths;
+		rocksdb::ConfigOptions configOptions;
+		configOptions.ignore_unknown_options = true;
+		rocksdb::DBOptions dbOptions;
+		std::vector<rocksdb::ColumnFamilyDescriptor> cfDescriptors;
+		rocksdb::Status s = rocksdb::LoadLatestOptions(configOptions, path, &dbOptions, &cfDescriptors);
+		if (!s.ok()) {
+			// Expected for a new instance
+			TraceEvent(SevDebug, "ShardedRocksDBLoadOptionsFailed").detail("Path", path).detail("Status", s.ToString());
+			return prefixLengths;
+		}
+		for (const auto& cfDesc : cfDescriptors) {
+			int prefixLen = 0;
+			// The ID of a fixed prefix extractor is "rocksdb.FixedPrefix.<length>"
+			const auto& extractor = cfDesc.options.prefix_extractor;
+			if (extractor != nullptr && extractor->Name() == std::string("rocksdb.FixedPrefix")) {
+				const std::string id = extractor->GetId();
+				prefixLen = atoi(id.substr(id.rfind('.') + 1).c_str());
+			}
+			prefixLengths[cfDesc.name] = prefixLen;
+		}
+		return prefixLengths;
+	}
+
 	rocksdb::Status init() {
 		const double start = now();
 		// Open instance.
@@ -1327,13 +1506,21 @@ public:
 		std::vector<std::string> columnFamilies;
 		rocksdb::Status status = rocksdb::DB::ListColumnFamilies(dbOptions, path, &columnFamilies);
 
+		// Shards keep the prefix filter length they were created with
+		std::unordered_map<std::string, int> prefixLengths;
+		if (!rState->prefixFilterRanges.empty()) {
+			prefixLengths = loadPrefixLengths(path);
+		}
+
 		std::vector<rocksdb::ColumnFamilyDescriptor> descriptors;
 		bool foundMetadata = false;
 		for (const auto& name : columnFamilies) {
 			if (name == METADATA_SHARD_ID) {
 				foundMetadata = true;
 			}
-			descriptors.push_back(rocksdb::ColumnFamilyDescriptor(name, rState->getCFOptions()));
+			auto it = prefixLengths.find(name);
+			descriptors.push_back(rocksdb::ColumnFamilyDescriptor(
+			    name, it != prefixLengths.end() ? rState->getCFOptions(it->second) : rState->getCFOptions()));
 		}
 
 		// Add default column family if it's a newly opened database.
@@ -1611,7 +1798,9 @@ public:
 				}
 			}
 		} else {
-			auto currentCfOptions = active ? rState->getCFOptions() : rState->getCFOptionsForInactiveShard();
+			const int prefixLen = rState->prefixLength(range.begin);
+			auto currentCfOptions =
+			    active ? rState->getCFOptions(prefixLen) : rState->getCFOptionsForInactiveShard(prefixLen);
 			auto [it, inserted] = physicalShards.emplace(id, std::make_shared<PhysicalShard>(db, id, currentCfOptions));
 			physicalShard = it->second;
 		}
@@ -1677,9 +1866,12 @@ public:
 					existingShard->deleteTimeSec = now();
 					pendingDeletionShards.push_back(existingShard->id);
 					activePhysicalShardIds.erase(existingShard->id);
+				} else {
+					addVacatedRange(existingShard, shardRange);
 				}
 				continue;
 			}
+			addVacatedRange(existingShard, shardRange & range);
 
 			// Range modification could result in more than one segments. Remove the original segment key here.
 			existingShard->dataShards.erase(shardRange.begin.toString());
@@ -1789,6 +1981,43 @@ public:
 		return emptyShards;
 	}
 
+	// Ranges removed from a physical shard that still holds other data shards stay behind as range tombstones, which
+	// slow down iterators over the shard until compaction drops them. They are queued here so that their files can be
+	// deleted and the remaining tombstones compacted away once in-flight reads of the range have finished.
+	void addVacatedRange(PhysicalShard* shard, KeyRange range) {
+		if (!SERVER_KNOBS->SHARDED_ROCKSDB_CLEAN_UP_VACATED_RANGES || range.empty()) {
+			return;
+		}
+		vacatedRanges.push_back({ shard->id, range, now() });
+	}
+
+	// Returns up to limit vacated ranges removed more than cleanUpDelay seconds ago which no data shard has been
+	// assigned to since.
+	std::vector<std::pair<std::shared_ptr<PhysicalShard>, KeyRange>> getVacatedRanges(double cleanUpDelay, int limit) {
+		std::vector<std::pair<std::shared_ptr<PhysicalShard>, KeyRange>> ranges;
+		double currentTime = now();
+		while (!vacatedRanges.empty() && ranges.size() < limit) {
+			const VacatedRange& vacated = vacatedRanges.front();
+			if (currentTime - vacated.removeTimeSec <= cleanUpDelay) {
+				break;
+			}
+			auto it = physicalShards.find(vacated.shardId);
+			bool reassigned = false;
+			for (auto r : dataShardMap.intersectingRanges(vacated.range)) {
+				if (r.value()) {
+					reassigned = true;
+					break;
+				}
+			}
+			if (it != physicalShards.end() && it->second->initialized() && !it->second->deletePending &&
+			    !reassigned) {
+				ranges.emplace_back(it->second, vacated.range);
+			}
+			vacatedRanges.pop_front();
+		}
+		return ranges;
+	}
+
 	void put(KeyRef key, ValueRef value) {
 		auto it = dataShardMap.rangeContaining(key);
 		if (!it.value()) {
@@ -2094,6 +2323,12 @@ private:
 	std::unique_ptr<std::set<PhysicalShard*>> dirtyShards;
 	KeyRangeMap<DataShard*> dataShardMap;
 	std::deque<std::string> pendingDeletionShards;
+	struct VacatedRange {
+		std::string shardId;
+		KeyRange range;
+		double removeTimeSec;
+	};
+	std::deque<VacatedRange> vacatedRanges;
 	Counters* counters;
 	std::shared_ptr<IteratorPool> iteratorPool;
 };
@@ -2465,6 +2700,36 @@ struct ShardedRocksDBKeyValueStore : IKeyValueStore {
 			    .detail("Duration", now() - start);
 			a.done.send(Void());
 		}
+
+		struct CompactRangesAction : TypedAction<CompactionWorker, CompactRangesAction> {
+			std::vector<std::pair<std::shared_ptr<PhysicalShard>, KeyRange>> ranges;
+			ThreadReturnPromise<Void> done;
+			CompactRangesAction(std::vector<std::pair<std::shared_ptr<PhysicalShard>, KeyRange>> ranges)
+			  : ranges(std::move(ranges)) {}
+			double getTimeEstimate() const override { return SERVER_KNOBS->COMMIT_TIME_ESTIMATE; }
+		};
+
+		void action(CompactRangesAction& a) {
+			auto start = now();
+			for (auto& [shard, range] : a.ranges) {
+				if (shard->deletePending) {
+					continue;
+				}
+				auto begin = toSlice(range.begin);
+				auto end = toSlice(range.end);
+				rocksdb::CompactRangeOptions compactOptions;
+				// The tombstones are only dropped once they reach the last level.
+				compactOptions.bottommost_level_compaction = rocksdb::BottommostLevelCompaction::kForceOptimized;
+				auto s = shard->db->CompactRange(compactOptions, shard->cf, &begin, &end);
+				if (!s.ok()) {
+					logRocksDBError(s, "CompactVacatedRange");
+				}
+			}
+			TraceEvent("ShardedRocksDBCompactVacatedRanges", logId)
+			    .detail("Ranges", a.ranges.size())
+			    .detail("Duration", now() - start);
+			a.done.send(Void());
+		}
 	};
 
 	struct Writer : IThreadPoolReceiver {
@@ -2563,6 +2828,49 @@ struct ShardedRocksDBKeyValueStore : IKeyValueStore {
 			a.done.send(Void());
 		}
 
+		struct ClearVacatedRangesAction : TypedAction<Writer, ClearVacatedRangesAction> {
+			std::vector<std::pair<std::shared_ptr<PhysicalShard>, KeyRange>> ranges;
+			ThreadReturnPromise<Void> done;
+
+			ClearVacatedRangesAction(std::vector<std::pair<std::shared_ptr<PhysicalShard>, KeyRange>> ranges)
+			  : ranges(std::move(ranges)) {}
+			double getTimeEstimate() const override { return SERVER_KNOBS->COMMIT_TIME_ESTIMATE; }
+		};
+
+		void action(ClearVacatedRangesAction& a) {
+			auto start = now();
+			int deleted = 0;
+			for (auto& [shard, range] : a.ranges) {
+				if (shard->deletePending) {
+					continue;
+				}
+				auto begin = toSlice(range.begin);
+				auto end = toSlice(range.end);
+				// The files deleted below may hold the range tombstones hiding older versions in files which are kept,
+				// so a new tombstone covering all of them is made durable first.
+				rocksdb::WriteOptions options;
+				options.sync = !SERVER_KNOBS->ROCKSDB_UNSAFE_AUTO_FSYNC;
+				auto s = shard->db->DeleteRange(options, shard->cf, begin, end);
+				if (!s.ok()) {
+					logRocksDBError(s, "ClearVacatedRange");
+					a.done.sendError(statusToError(s));
+					return;
+				}
+				// Drops the SST files which lie entirely inside the range without rewriting them.
+				s = rocksdb::DeleteFilesInRange(shard->db, shard->cf, &begin, &end, /*include_end=*/false);
+				if (!s.ok()) {
+					logRocksDBError(s, "DeleteFilesInRange");
+					continue;
+				}
+				++deleted;
+			}
+			TraceEvent("ShardedRocksDBClearVacatedRanges", logId)
+			    .detail("Ranges", a.ranges.size())
+			    .detail("Cleared", deleted)
+			    .detail("Duration", now() - start);
+			a.done.send(Void());
+		}
+
 		struct CommitAction : TypedAction<Writer, CommitAction> {
 			rocksdb::DB* db;
 			std::unique_ptr<rocksdb::WriteBatch> writeBatch;
@@ -3187,7 +3495,9 @@ struct ShardedRocksDBKeyValueStore : IKeyValueStore {
 				std::chrono::seconds deadlineSeconds(deadlineMircos / 1000000);
 				options.deadline = std::chrono::duration_cast<std::chrono::microseconds>(deadlineSeconds);
 			}
+			options.fill_cache = !a.shard->skipCacheFill.load();
 			auto s = db->Get(options, a.shard->cf, toSlice(a.key), &value);
+			a.shard->readBytes += a.key.size() + value.size();
 
 			if (a.sample) {
 				latencyMetrics->readValueLatency->sampleSeconds(timer_monotonic() - a.startTime);
@@ -3207,6 +3517,98 @@ struct ShardedRocksDBKeyValueStore : IKeyValueStore {
 			}
 		}
 
+		// Point reads posted in the same run loop tick. Reads to the same physical shard are served by a single
+		// MultiGet so that RocksDB can batch the bloom filter probes and issue the block reads in parallel.
+		struct ReadValueBatchAction : TypedAction<Reader, ReadValueBatchAction> {
+			std::vector<std::unique_ptr<ReadValueAction>> reads;
+			double getTimeEstimate() const override { return SERVER_KNOBS->READ_VALUE_TIME_ESTIMATE * reads.size(); }
+		};
+
+		void action(ReadValueBatchAction& batch) {
+			if (batch.reads.size() == 1) {
+				action(*batch.reads[0]);
+				return;
+			}
+			double readBeginTime = timer_monotonic();
+			Optional<TraceBatch> traceBatch;
+			std::unordered_map<PhysicalShard*, std::vector<ReadValueAction*>> readsByShard;
+			for (auto& r : batch.reads) {
+				ReadValueAction& a = *r;
+				if (a.sample) {
+					latencyMetrics->readActionQueueWait->sampleSeconds(readBeginTime - a.startTime);
+				}
+				if (a.debugID.present()) {
+					if (!traceBatch.present()) {
+						traceBatch = { TraceBatch{} };
+					}
+					traceBatch.get().addEvent("GetValueDebug", a.debugID.get().first(), "Reader.Before");
+				}
+				if (shouldThrottle(a.type, a.key) && SERVER_KNOBS->ROCKSDB_SET_READ_TIMEOUT &&
+				    readBeginTime - a.startTime > readValueTimeout) {
+					TraceEvent(SevWarn, "ShardedRocksDBError")
+					    .detail("Error", "Read value request timedout")
+					    .detail("Method", "ReadValueBatchAction")
+					    .detail("Timeout value", readValueTimeout);
+					if (SERVER_KNOBS->ROCKSDB_RETURN_OVERLOADED_ON_TIMEOUT) {
+						a.result.sendError(server_overloaded());
+					} else {
+						a.result.sendError(key_value_store_deadline_exceeded());
+					}
+					continue;
+				}
+				readsByShard[a.shard].push_back(&a);
+			}
+
+			for (auto& [shard, reads] : readsByShard) {
+				auto options = getReadOptions();
+				auto db = shard->db;
+				// The deadline applies to the whole MultiGet, so it is only set when every read in it may time out
+				bool setDeadline = SERVER_KNOBS->ROCKSDB_SET_READ_TIMEOUT;
+				double timeLeft = readValueTimeout;
+				std::vector<rocksdb::Slice> keys;
+				for (ReadValueAction* a : reads) {
+					if (!shouldThrottle(a->type, a->key)) {
+						setDeadline = false;
+					}
+					timeLeft = std::min(timeLeft, readValueTimeout - (timer_monotonic() - a->startTime));
+					keys.push_back(toSlice(a->key));
+				}
+				if (setDeadline) {
+					uint64_t deadlineMircos = db->GetEnv()->NowMicros() + timeLeft * 1000000;
+					std::chrono::seconds deadlineSeconds(deadlineMircos / 1000000);
+					options.deadline = std::chrono::duration_cast<std::chrono::microseconds>(deadlineSeconds);
+				}
+				options.fill_cache = !shard->skipCacheFill.load();
+
+				std::vector<rocksdb::PinnableSlice> values(reads.size());
+				std::vector<rocksdb::Status> statuses(reads.size());
+				db->MultiGet(options, shard->cf, reads.size(), keys.data(), values.data(), statuses.data());
+
+				for (int i = 0; i < reads.size(); i++) {
+					ReadValueAction& a = *reads[i];
+					const rocksdb::Status& s = statuses[i];
+					shard->readBytes += a.key.size() + values[i].size();
+					if (a.sample) {
+						latencyMetrics->readValueLatency->sampleSeconds(timer_monotonic() - a.startTime);
+					}
+					if (a.debugID.present()) {
+						traceBatch.get().addEvent("GetValueDebug", a.debugID.get().first(), "Reader.After");
+					}
+					if (s.ok()) {
+						a.result.send(Value(toStringRef(values[i])));
+					} else if (s.IsNotFound()) {
+						a.result.send(Optional<Value>());
+					} else {
+						logRocksDBError(s, "ReadValueBatch");
+						a.result.sendError(statusToError(s));
+					}
+				}
+			}
+			if (traceBatch.present()) {
+				traceBatch.get().dump();
+			}
+		}
+
 		struct ReadValuePrefixAction : TypedAction<Reader, ReadValuePrefixAction> {
 			Key key;
 			int maxLength;
@@ -3264,7 +3666,9 @@ struct ShardedRocksDBKeyValueStore : IKeyValueStore {
 				options.deadline = std::chrono::duration_cast<std::chrono::microseconds>(deadlineSeconds);
 			}
 
+			options.fill_cache = !a.shard->skipCacheFill.load();
 			auto s = db->Get(options, a.shard->cf, toSlice(a.key), &value);
+			a.shard->readBytes += a.key.size() + std::min(value.size(), size_t(a.maxLength));
 
 			if (a.sample) {
 				latencyMetrics->readPrefixLatency->sampleSeconds(timer_monotonic() - readBeginTime);
@@ -3292,12 +3696,19 @@ struct ShardedRocksDBKeyValueStore : IKeyValueStore {
 			std::vector<std::pair<PhysicalShard*, KeyRange>> shardRanges;
 			int rowLimit, byteLimit;
 			ReadType type;
+			bool fillCache;
 			double startTime;
 			bool sample;
 			bool logShardMemUsage;
 			ThreadReturnPromise<RangeResult> result;
-			ReadRangeAction(KeyRange keys, std::vector<DataShard*> shards, int rowLimit, int byteLimit, ReadType type)
-			  : keys(keys), rowLimit(rowLimit), byteLimit(byteLimit), type(type), startTime(timer_monotonic()),
+			ReadRangeAction(KeyRange keys,
+			                std::vector<DataShard*> shards,
+			                int rowLimit,
+			                int byteLimit,
+			                ReadType type,
+			                bool fillCache)
+			  : keys(keys), rowLimit(rowLimit), byteLimit(byteLimit), type(type), fillCache(fillCache),
+			    startTime(timer_monotonic()),
 			    sample((deterministicRandom()->random01() < SERVER_KNOBS->SHARDED_ROCKSDB_HISTOGRAMS_SAMPLE_RATE)
 			               ? true
 			               : false) {
@@ -3363,12 +3774,13 @@ struct ShardedRocksDBKeyValueStore : IKeyValueStore {
 					    .detail("Reason", shard == nullptr ? "Not Exist" : "Not Initialized");
 					continue;
 				}
-				auto bytesRead = readRangeInDb(shard, range, rowLimit, byteLimit, &result, iteratorPool);
+				auto bytesRead = readRangeInDb(shard, range, rowLimit, byteLimit, &result, iteratorPool, a.fillCache);
 				if (bytesRead < 0) {
 					// Error reading an instance.
 					a.result.sendError(internal_error());
 					return;
 				}
+				shard->readBytes += bytesRead;
 				byteLimit -= bytesRead;
 				accumulatedBytes += bytesRead;
 				++numShards;
@@ -3463,8 +3875,10 @@ struct ShardedRocksDBKeyValueStore : IKeyValueStore {
 		self->refreshHolder.cancel();
 		self->refreshRocksDBBackgroundWorkHolder.cancel();
 		self->cleanUpJob.cancel();
+		self->vacatedRangeCleanUpJob.cancel();
 		self->counterLogger.cancel();
 
+		self->postReadValueBatch();
 		try {
 			wait(self->readThreads->stop());
 		} catch (Error& e) {
@@ -3529,6 +3943,8 @@ struct ShardedRocksDBKeyValueStore : IKeyValueStore {
 			this->refreshRocksDBBackgroundWorkHolder =
 			    refreshRocksDBBackgroundEventCounter(this->id, this->eventListener);
 			this->cleanUpJob = emptyShardCleaner(this->rState, openFuture, &shardManager, writeThread);
+			this->vacatedRangeCleanUpJob = vacatedRangeCleaner(
+			    this->rState, openFuture, &shardManager, writeThread, compactionThread, this->path);
 			writeThread->post(a.release());
 			counterLogger = counters.cc.traceCounters("RocksDBCounters", id, SERVER_KNOBS->ROCKSDB_METRICS_DELAY);
 			return openFuture;
@@ -3634,6 +4050,59 @@ struct ShardedRocksDBKeyValueStore : IKeyValueStore {
 		return result;
 	}
 
+	// Point reads are not posted to the reader threads individually, but collected until the end of the current
+	// run loop tick (or until the batch is full) and then posted as one ReadValueBatchAction.
+	void postReadValue(Reader::ReadValueAction* a) {
+		if (SERVER_KNOBS->ROCKSDB_READ_VALUE_BATCH_MAX_KEYS <= 1) {
+			readThreads->post(a);
+			return;
+		}
+		if (!pendingReadValues) {
+			pendingReadValues = std::make_unique<Reader::ReadValueBatchAction>();
+			if (!readValueBatchFlush.isValid() || readValueBatchFlush.isReady()) {
+				readValueBatchFlush = flushReadValueBatch(this);
+			}
+		}
+		pendingReadValues->reads.emplace_back(a);
+		if (pendingReadValues->reads.size() >= SERVER_KNOBS->ROCKSDB_READ_VALUE_BATCH_MAX_KEYS) {
+			postReadValueBatch();
+		}
+	}
+
+	void postReadValueBatch() {
+		if (pendingReadValues) {
+			readThreads->post(pendingReadValues.release());
+		}
+	}
+
+	// A flush may find a batch that was started after the one it was scheduled for, in which case that batch is
+	// just posted early.
+	ACTOR static Future<Void> flushReadValueBatch(ShardedRocksDBKeyValueStore* self) {
+		wait(delay(0));
+		self->postReadValueBatch();
+		return Void();
+	}
+
+	ACTOR static Future<Optional<Value>> read(Reader::ReadValueAction* action,
+	                                          FlowLock* semaphore,
+	                                          ShardedRocksDBKeyValueStore* self,
+	                                          Counter* counter) {
+		state std::unique_ptr<Reader::ReadValueAction> a(action);
+		state Optional<Void> slot = wait(timeout(semaphore->take(), SERVER_KNOBS->ROCKSDB_READ_QUEUE_WAIT));
+		if (!slot.present()) {
+			++(*counter);
+			throw server_overloaded();
+		}
+
+		state FlowLock::Releaser release(*semaphore);
+
+		auto fut = a->result.getFuture();
+		self->postReadValue(a.release());
+		Optional<Value> result = wait(fut);
+
+		return result;
+	}
+
 	Future<Optional<Value>> readValue(KeyRef key, Optional<ReadOptions> options) override {
 		auto* shard = shardManager.getDataShard(key);
 		if (shard == nullptr || !shard->physicalShard->initialized()) {
@@ -3655,7 +4124,7 @@ struct ShardedRocksDBKeyValueStore : IKeyValueStore {
 		if (!shouldThrottle(type, key)) {
 			auto a = new Reader::ReadValueAction(key, shard->physicalShard, type, debugID);
 			auto res = a->result.getFuture();
-			readThreads->post(a);
+			postReadValue(a);
 			return res;
 		}
 
@@ -3664,7 +4133,7 @@ struct ShardedRocksDBKeyValueStore : IKeyValueStore {
 
 		checkWaiters(semaphore, maxWaiters);
 		auto a = std::make_unique<Reader::ReadValueAction>(key, shard->physicalShard, type, debugID);
-		return read(a.release(), &semaphore, readThreads.getPtr(), &counters.failedToAcquire);
+		return read(a.release(), &semaphore, this, &counters.failedToAcquire);
 	}
 
 	Future<Optional<Value>> readValuePrefix(KeyRef key, int maxLength, Optional<ReadOptions> options) override {
@@ -3728,12 +4197,15 @@ struct ShardedRocksDBKeyValueStore : IKeyValueStore {
 		auto shards = shardManager.getDataShardsByRange(keys);
 
 		ReadType type = ReadType::NORMAL;
+		// Scans, such as fetches and reads which ask not to be cached, must not evict the blocks of other reads
+		bool fillCache = true;
 		if (options.present()) {
 			type = options.get().type;
+			fillCache = options.get().cacheResult && type != ReadType::FETCH;
 		}
 
 		if (!shouldThrottle(type, keys.begin)) {
-			auto a = new Reader::ReadRangeAction(keys, shards, rowLimit, byteLimit, type);
+			auto a = new Reader::ReadRangeAction(keys, shards, rowLimit, byteLimit, type, fillCache);
 			auto res = a->result.getFuture();
 			readThreads->post(a);
 			return res;
@@ -3743,7 +4215,7 @@ struct ShardedRocksDBKeyValueStore : IKeyValueStore {
 		int maxWaiters = (type == ReadType::FETCH) ? numFetchWaiters : numReadWaiters;
 		checkWaiters(semaphore, maxWaiters);
 
-		auto a = std::make_unique<Reader::ReadRangeAction>(keys, shards, rowLimit, byteLimit, type);
+		auto a = std::make_unique<Reader::ReadRangeAction>(keys, shards, rowLimit, byteLimit, type, fillCache);
 		return read(a.release(), &semaphore, readThreads.getPtr(), &counters.failedToAcquire);
 	}
 
@@ -3858,6 +4330,76 @@ struct ShardedRocksDBKeyValueStore : IKeyValueStore {
 		return Void();
 	}
 
+	// Returns the fraction of the time since the previous call that the disk holding path was busy, or 0 if it is
+	// unknown. Simulated processes share the real disk, so its utilization is not meaningful for them.
+	static double diskUtilization(const std::string& path, DiskStatistics* last, double* lastTime) {
+		if (g_network->isSimulated()) {
+			return 0.0;
+		}
+		try {
+			DiskStatistics current = getDiskStatistics(path);
+			double currentTime = timer();
+			double elapsed = currentTime - *lastTime;
+			double busy = (current.IOMilliSecs - last->IOMilliSecs) / 1000.0;
+			*last = current;
+			*lastTime = currentTime;
+			return elapsed > 0 ? std::min(1.0, busy / elapsed) : 0.0;
+		} catch (Error& e) {
+			if (e.code() != error_code_platform_error) {
+				throw;
+			}
+			return 0.0;
+		}
+	}
+
+	// Deletes the files of ranges vacated by shard moves and compacts away the tombstones left behind. Vacated ranges
+	// are only cleaned up while the disk is not busy, so that the clean up does not compete with foreground IO.
+	ACTOR static Future<Void> vacatedRangeCleaner(std::shared_ptr<ShardedRocksDBState> rState,
+	                                              Future<Void> openFuture,
+	                                              ShardManager* shardManager,
+	                                              Reference<IThreadPool> writeThread,
+	                                              Reference<IThreadPool> compactionThread,
+	                                              std::string path) {
+		state DiskStatistics lastDiskStats;
+		state double lastDiskStatsTime = timer();
+		try {
+			wait(openFuture);
+			diskUtilization(path, &lastDiskStats, &lastDiskStatsTime);
+			loop {
+				wait(delay(SERVER_KNOBS->SHARDED_ROCKSDB_VACATED_RANGE_CLEAN_UP_INTERVAL));
+				if (rState->closing) {
+					break;
+				}
+				double utilization = diskUtilization(path, &lastDiskStats, &lastDiskStatsTime);
+				if (utilization > SERVER_KNOBS->SHARDED_ROCKSDB_VACATED_RANGE_MAX_DISK_UTILIZATION) {
+					TraceEvent("ShardedRocksDBVacatedRangeCleanUpSkipped").detail("DiskUtilization", utilization);
+					continue;
+				}
+				state std::vector<std::pair<std::shared_ptr<PhysicalShard>, KeyRange>> ranges =
+				    shardManager->getVacatedRanges(SERVER_KNOBS->ROCKSDB_PHYSICAL_SHARD_CLEAN_UP_DELAY,
+				                                   SERVER_KNOBS->SHARDED_ROCKSDB_VACATED_RANGE_CLEAN_UP_LIMIT);
+				if (ranges.empty()) {
+					continue;
+				}
+				// Runs on the writer thread so that it is ordered with commits to ranges added after this point.
+				auto clear = new Writer::ClearVacatedRangesAction(ranges);
+				Future<Void> cleared = clear->done.getFuture();
+				writeThread->post(clear);
+				wait(cleared);
+
+				auto compact = new CompactionWorker::CompactRangesAction(std::move(ranges));
+				Future<Void> compacted = compact->done.getFuture();
+				compactionThread->post(compact);
+				wait(compacted);
+			}
+		} catch (Error& e) {
+			if (e.code() != error_code_actor_cancelled) {
+				TraceEvent(SevError, "ShardedRocksDBVacatedRangeCleanerError").errorUnsuppressed(e);
+			}
+		}
+		return Void();
+	}
+
 	StorageBytes getStorageBytes() const override {
 		uint64_t live = 0;
 		ASSERT(shardManager.getDb()->GetAggregatedIntProperty(rocksdb::DB::Properties::kLiveSstFilesSize, &live));
@@ -3875,6 +4417,17 @@ struct ShardedRocksDBKeyValueStore : IKeyValueStore {
 		return StorageBytes(free, total, live, free);
 	}
 
+	int64_t getMemoryBytes() const override {
+		uint64_t memtableBytes = 0;
+		ASSERT(shardManager.getDb()->GetAggregatedIntProperty(rocksdb::DB::Properties::kCurSizeAllMemTables,
+		                                                      &memtableBytes));
+		// Memtables charged to the block cache through the write buffer manager are already part of its usage
+		if (rState->writeBufferManager) {
+			memtableBytes = 0;
+		}
+		return (rState->blockCache ? rState->blockCache->GetUsage() : 0) + memtableBytes;
+	}
+
 	Future<CheckpointMetaData> checkpoint(const CheckpointRequest& request) override {
 		auto a = new Writer::CheckpointAction(&shardManager, request);
 
@@ -3922,6 +4475,8 @@ struct ShardedRocksDBKeyValueStore : IKeyValueStore {
 	Reference<IThreadPool> writeThread;
 	Reference<IThreadPool> compactionThread;
 	Reference<IThreadPool> readThreads;
+	std::unique_ptr<Reader::ReadValueBatchAction> pendingReadValues;
+	Future<Void> readValueBatchFlush;
 	Future<Void> errorFuture;
 	Promise<Void> closePromise;
 	Future<Void> openFuture;
@@ -3935,6 +4490,7 @@ struct ShardedRocksDBKeyValueStore : IKeyValueStore {
 	Future<Void> refreshHolder;
 	Future<Void> refreshRocksDBBackgroundWorkHolder;
 	Future<Void> cleanUpJob;
+	Future<Void> vacatedRangeCleanUpJob;
 	Future<Void> counterLogger;
 };
 
@@ -4024,6 +4580,19 @@ TEST_CASE("noSim/ShardedRocksDB/Initialization") {
 	return Void();
 }
 
+TEST_CASE("noSim/ShardedRocksDB/PrefixFilterRanges") {
+	ShardedRocksDBState rState;
+	rState.prefixFilterRanges = ShardedRocksDBState::parsePrefixFilterRanges("\\x15\\x01:4,\\x15:2,invalid");
+	ASSERT_EQ(rState.prefixFilterRanges.size(), 2);
+	ASSERT(rState.prefixFilterRanges[0].first == "\x15\x01"_sr);
+
+	// The longest matching prefix wins, and unmatched shards use the default length
+	ASSERT_EQ(rState.prefixLength("\x15\x01\x02"_sr), 4);
+	ASSERT_EQ(rState.prefixLength("\x15\x02"_sr), 2);
+	ASSERT_EQ(rState.prefixLength("a"_sr), SERVER_KNOBS->SHARDED_ROCKSDB_PREFIX_LEN);
+	return Void();
+}
+
 TEST_CASE("noSim/ShardedRocksDB/SingleShardRead") {
 	state const std::string rocksDBTestDir = "sharded-rocksdb-test-db";
 	platform::eraseDirectoryRecursive(rocksDBTestDir);
@@ -4547,6 +5116,62 @@ TEST_CASE("noSim/ShardedRocksDBRangeOps/RemoveSplitRange") {
 	return Void();
 }
 
+TEST_CASE("noSim/ShardedRocksDBRangeOps/CleanUpVacatedRange") {
+	state std::string rocksDBTestDir = "sharded-rocksdb-kvs-test-db";
+	platform::eraseDirectoryRecursive(rocksDBTestDir);
+
+	state ShardedRocksDBKeyValueStore* rocksdbStore =
+	    new ShardedRocksDBKeyValueStore(rocksDBTestDir, deterministicRandom()->randomUniqueID());
+	state IKeyValueStore* kvStore = rocksdbStore;
+	wait(kvStore->init());
+
+	wait(kvStore->addRange(KeyRangeRef("a"_sr, "d"_sr), "shard-1"));
+	state std::vector<std::string> keys = { "a", "b", "c" };
+	for (auto key : keys) {
+		kvStore->set(KeyValueRef(key, key));
+	}
+	wait(kvStore->commit());
+
+	// A range which is added back before it is cleaned up is skipped.
+	kvStore->clear(KeyRangeRef("b"_sr, "c"_sr));
+	wait(kvStore->commit());
+	ASSERT(kvStore->removeRange(KeyRangeRef("b"_sr, "c"_sr)).empty());
+	wait(kvStore->addRange(KeyRangeRef("b"_sr, "c"_sr), "shard-1"));
+	ASSERT(rocksdbStore->shardManager.getVacatedRanges(-1.0, 10).empty());
+
+	ASSERT(kvStore->removeRange(KeyRangeRef("b"_sr, "c"_sr)).empty());
+	state std::vector<std::pair<std::shared_ptr<PhysicalShard>, KeyRange>> ranges =
+	    rocksdbStore->shardManager.getVacatedRanges(-1.0, 10);
+	ASSERT_EQ(ranges.size(), 1);
+	ASSERT(ranges[0].second == KeyRangeRef("b"_sr, "c"_sr));
+	ASSERT(ranges[0].first->id == "shard-1");
+
+	{
+		auto clear = new ShardedRocksDBKeyValueStore::Writer::ClearVacatedRangesAction(ranges);
+		Future<Void> cleared = clear->done.getFuture();
+		rocksdbStore->writeThread->post(clear);
+		wait(cleared);
+	}
+	{
+		auto compact = new ShardedRocksDBKeyValueStore::CompactionWorker::CompactRangesAction(ranges);
+		Future<Void> compacted = compact->done.getFuture();
+		rocksdbStore->compactionThread->post(compact);
+		wait(compacted);
+	}
+
+	state RangeResult result = wait(kvStore->readRange(KeyRangeRef("a"_sr, "d"_sr)));
+	ASSERT_EQ(result.size(), 2);
+	ASSERT(result[0].key == "a"_sr && result[1].key == "c"_sr);
+
+	{
+		Future<Void> closed = kvStore->onClosed();
+		kvStore->dispose();
+		wait(closed);
+	}
+	ASSERT(!directoryExists(rocksDBTestDir));
+	return Void();
+}
+
 TEST_CASE("noSim/ShardedRocksDBCheckpoint/CheckpointBasic") {
 	state std::string rocksDBTestDir = "sharded-rocks-checkpoint-restore";
 	state std::map<Key, Value> kvs({ { "a"_sr, "TestValueA"_sr },
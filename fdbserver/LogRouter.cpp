@@ -80,7 +80,9 @@ struct LogRouterData {
 	                                  // A LR's durable version is the maximum version of mutations that have been
 	                                  // popped by remote tLog.
 	Version poppedVersion;
-	Deque<std::pair<Version, Standalone<VectorRef<uint8_t>>>> messageBlocks;
+	// The arenas of the peek replies holding the messages of each version, into which every tag's version_messages
+	// points.  Each arena is kept until the last version with messages in it is popped.
+	Deque<std::pair<Version, Arena>> messageBlocks;
 	Tag routerTag;
 	bool allowPops;
 	LogSet logSet;
@@ -213,8 +215,11 @@ struct LogRouterData {
 		return tagData->popped;
 	}
 
-	// Copy pulled messages into memory blocks owned by each tag, i.e., tag_data.
-	void commitMessages(Version version, const std::vector<TagsAndMessage>& taggedMessages);
+	// Index pulled messages by each of their tags, i.e., in tag_data.  The messages are not copied, so they must be
+	// allocated in the given arenas.
+	void commitMessages(Version version,
+	                    const std::vector<TagsAndMessage>& taggedMessages,
+	                    const std::vector<Arena>& arenas);
 
 	Future<Void> waitForVersion(Version ver);
 	Future<Void> waitForVersionAndLog(Version ver);
@@ -245,36 +250,24 @@ struct LogRouterData {
 	Future<Void> cleanupPeekTrackers();
 };
 
-void LogRouterData::commitMessages(Version version, const std::vector<TagsAndMessage>& taggedMessages) {
+void LogRouterData::commitMessages(Version version,
+                                   const std::vector<TagsAndMessage>& taggedMessages,
+                                   const std::vector<Arena>& arenas) {
 	if (!taggedMessages.size()) {
 		return;
 	}
 
-	int msgSize = 0;
-	for (const auto& i : taggedMessages) {
-		msgSize += i.message.size();
-	}
-
-	// Grab the last block in the blocks list so we can share its arena
-	// We pop all of the elements of it to create a "fresh" vector that starts at the end of the previous vector
-	Standalone<VectorRef<uint8_t>> block;
-	if (messageBlocks.empty()) {
-		block = Standalone<VectorRef<uint8_t>>();
-		block.reserve(block.arena(), std::max<int64_t>(SERVER_KNOBS->TLOG_MESSAGE_BLOCK_BYTES, msgSize));
-	} else {
-		block = messageBlocks.back().second;
+	// Every tag buffered by the log router shares the peeked copy of each message, so the peek replies are kept
+	// until all tags have popped them rather than copying their messages into buffers of our own
+	for (const Arena& arena : arenas) {
+		if (messageBlocks.empty() || !messageBlocks.back().second.sameArena(arena)) {
+			messageBlocks.emplace_back(version, arena);
+		} else {
+			messageBlocks.back().first = version;
+		}
 	}
 
-	block.pop_front(block.size());
-
 	for (const auto& msg : taggedMessages) {
-		if (msg.message.size() > block.capacity() - block.size()) {
-			messageBlocks.emplace_back(version, block);
-			block = Standalone<VectorRef<uint8_t>>();
-			block.reserve(block.arena(), std::max<int64_t>(SERVER_KNOBS->TLOG_MESSAGE_BLOCK_BYTES, msgSize));
-		}
-
-		block.append(block.arena(), msg.message.begin(), msg.message.size());
 		for (const auto& tag : msg.tags) {
 			auto tagData = getTagData(tag);
 			if (!tagData) {
@@ -282,18 +275,15 @@ void LogRouterData::commitMessages(Version version, const std::vector<TagsAndMes
 			}
 
 			if (version >= tagData->popped) {
-				tagData->version_messages.emplace_back(
-				    version, LengthPrefixedStringRef((uint32_t*)(block.end() - msg.message.size())));
+				tagData->version_messages.emplace_back(version,
+				                                       LengthPrefixedStringRef((uint32_t*)msg.message.begin()));
 				if (tagData->version_messages.back().second.expectedSize() > SERVER_KNOBS->MAX_MESSAGE_SIZE) {
 					TraceEvent(SevWarnAlways, "LargeMessage")
 					    .detail("Size", tagData->version_messages.back().second.expectedSize());
 				}
 			}
 		}
-
-		msgSize -= msg.message.size();
 	}
-	messageBlocks.emplace_back(version, block);
 }
 
 Future<Void> LogRouterData::waitForVersion(Version ver) {
@@ -467,6 +457,7 @@ Future<Void> LogRouterData::pullAsyncData() {
 
 		Version ver = 0;
 		std::vector<TagsAndMessage> messages;
+		std::vector<Arena> messageArenas;
 		Arena arena;
 		while (true) {
 			bool foundMessage = r->hasMessage();
@@ -480,7 +471,7 @@ Future<Void> LogRouterData::pullAsyncData() {
 					    .detail("ToVersion", ver)
 					    .detail("MessageCount", messages.size());
 
-					commitMessages(ver, messages);
+					commitMessages(ver, messages, messageArenas);
 					version.set(ver);
 					co_await yield(TaskPriority::TLogCommit);
 					//TraceEvent("LogRouterVersion").detail("Ver",ver);
@@ -488,6 +479,7 @@ Future<Void> LogRouterData::pullAsyncData() {
 				lastVer = ver;
 				ver = r->version().version;
 				messages.clear();
+				messageArenas.clear();
 				arena = Arena();
 
 				if (!foundMessage) {
@@ -511,6 +503,9 @@ Future<Void> LogRouterData::pullAsyncData() {
 				tagAndMsg.tags.push_back(arena, Tag(tagLocalityRemoteLog, t));
 			}
 			messages.push_back(std::move(tagAndMsg));
+			if (messageArenas.empty() || !messageArenas.back().sameArena(r->arena())) {
+				messageArenas.push_back(r->arena());
+			}
 
 			r->nextMessage();
 		}
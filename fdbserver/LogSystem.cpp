@@ -20,6 +20,7 @@
 
 #include "fdbserver/LogSystem.h"
 #include "fdbclient/FDBTypes.h"
+#include "fdbserver/Knobs.h"
 #include "fdbserver/OTELSpanContextMessage.h"
 #include "fdbserver/SpanContextMessage.h"
 #include "flow/serialize.h"
@@ -278,12 +279,14 @@ void LogSet::getPushLocations(VectorRef<Tag> tags,
 	//	.detail("Included", alsoServers.size()).detail("Duration", timer() - t);
 }
 
-LogPushData::LogPushData(Reference<ILogSystem> logSystem, int tlogCount) : logSystem(logSystem), subsequence(1) {
+LogPushData::LogPushData(Reference<ILogSystem> logSystem, int tlogCount)
+  : logSystem(logSystem), sharedMutationMinBytes(SERVER_KNOBS->LOG_PUSH_SHARED_MUTATION_MIN_BYTES), subsequence(1) {
 	ASSERT(tlogCount > 0);
 	messagesWriter.reserve(tlogCount);
 	for (int i = 0; i < tlogCount; i++) {
 		messagesWriter.emplace_back(AssumeVersion(g_network->protocolVersion()));
 	}
+	sharedMessages.resize(tlogCount);
 	messagesWritten = std::vector<bool>(tlogCount, false);
 }
 
@@ -323,6 +326,53 @@ void LogPushData::writeMessage(StringRef rawMessageWithoutLength, bool usePrevio
 	}
 }
 
+void LogPushData::writeSharedMessage(Standalone<StringRef> message, uint32_t subseq) {
+	sharedMessagesArena.dependsOn(message.arena());
+	uint32_t msgsize = message.size() + sizeof(subseq) + sizeof(uint16_t) + sizeof(Tag) * prev_tags.size();
+	for (int loc : msg_locations) {
+		BinaryWriter& wr = messagesWriter[loc];
+		wr << msgsize << subseq << uint16_t(prev_tags.size());
+		for (auto& tag : prev_tags)
+			wr << tag;
+		sharedMessages[loc].emplace_back(wr.getLength(), message);
+	}
+	if (MUTATION_TRACKING_ENABLED) {
+		// The header and the message are only contiguous once getMessages() splices them, so trace a joined copy.
+		BinaryWriter traced(AssumeVersion(g_network->protocolVersion()));
+		traced << msgsize << subseq << uint16_t(prev_tags.size());
+		for (auto& tag : prev_tags)
+			traced << tag;
+		traced.serializeBytes(message);
+		DEBUG_TAGS_AND_MESSAGE("ProxyPushLocations", invalidVersion, traced.toValue())
+		    .detail("PushLocations", msg_locations);
+	}
+}
+
+Standalone<StringRef> LogPushData::getMessages(int loc) const {
+	Standalone<StringRef> written = messagesWriter[loc].toValue();
+	const auto& shared = sharedMessages[loc];
+	if (shared.empty()) {
+		return written;
+	}
+
+	int totalBytes = written.size();
+	for (const auto& [offset, message] : shared) {
+		totalBytes += message.size();
+	}
+	Standalone<StringRef> result = makeString(totalBytes);
+	uint8_t* out = mutateString(result);
+	int copied = 0;
+	for (const auto& [offset, message] : shared) {
+		memcpy(out, written.begin() + copied, offset - copied);
+		out += offset - copied;
+		copied = offset;
+		memcpy(out, message.begin(), message.size());
+		out += message.size();
+	}
+	memcpy(out, written.begin() + copied, written.size() - copied);
+	return result;
+}
+
 std::vector<Standalone<StringRef>> LogPushData::getAllMessages() const {
 	std::vector<Standalone<StringRef>> results;
 	results.reserve(messagesWriter.size());
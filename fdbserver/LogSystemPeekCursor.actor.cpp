@@ -732,8 +732,13 @@ void ILogSystem::MergedPeekCursor::calcHasMessage() {
 			currentCursor = bestServer;
 			hasNextMessage = true;
 
-			for (auto& c : serverCursors) {
-				c->advanceTo(messageVersion);
+			// The other cursors are only read once the best server runs out of messages, and are then advanced to
+			// it, so skipping each message of a version on every cursor is deferred to the start of the next version
+			if (messageVersion.version != advancedAllTo) {
+				advancedAllTo = messageVersion.version;
+				for (auto& c : serverCursors) {
+					c->advanceTo(messageVersion);
+				}
 			}
 
 			return;
@@ -1036,9 +1041,13 @@ void ILogSystem::SetPeekCursor::calcHasMessage() {
 
 			//TraceEvent("LPC_Calc1").detail("Ver", messageVersion.toString()).detail("Tag", tag.toString()).detail("HasNextMessage", hasNextMessage);
 
-			for (auto& cursors : serverCursors) {
-				for (auto& c : cursors) {
-					c->advanceTo(messageVersion);
+			// As in MergedPeekCursor, the other cursors are advanced once per version rather than once per message
+			if (messageVersion.version != advancedAllTo) {
+				advancedAllTo = messageVersion.version;
+				for (auto& cursors : serverCursors) {
+					for (auto& c : cursors) {
+						c->advanceTo(messageVersion);
+					}
 				}
 			}
 
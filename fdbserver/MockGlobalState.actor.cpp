@@ -519,6 +519,7 @@ void MockStorageServer::notifyWriteMetrics(KeyRef const& key, int64_t size) {
 
 void MockStorageServer::signalFetchKeys(const KeyRangeRef& range, int64_t rangeTotalBytes) {
 	if (!allShardStatusEqual(range, MockShardStatus::COMPLETED)) {
+		fetchedBytes += rangeTotalBytes;
 		actors.add(MockStorageServerImpl::waitFetchKeysFinish(this, { range, rangeTotalBytes }));
 	}
 }
@@ -757,14 +757,22 @@ void Ratekeeper::updateRate(RatekeeperLimits* limits) {
 
 		storageDurabilityLagReverseIndex.insert(std::make_pair(-1 * storageDurabilityLag, &ss));
 
-		double targetRateRatio = std::min((storageQueue - targetBytes + springBytes) / (double)springBytes, 2.0);
+		// Throttle on where the queue will be if it keeps growing at its current rate, so that a burst is slowed down
+		// before the queue reaches its target rather than after it has overshot
+		double inputRate = ss.getSmoothInputBytesRate();
+		int64_t projectedStorageQueue = storageQueue;
+		if (SERVER_KNOBS->RATEKEEPER_QUEUE_PROJECTION_SECONDS > 0) {
+			double growthRate = inputRate - ss.getVerySmoothDurableBytesRate();
+			projectedStorageQueue += std::max(0.0, growthRate * SERVER_KNOBS->RATEKEEPER_QUEUE_PROJECTION_SECONDS);
+		}
+
+		double targetRateRatio =
+		    std::min((projectedStorageQueue - targetBytes + springBytes) / (double)springBytes, 2.0);
 
 		if (limits->priority == TransactionPriority::DEFAULT) {
 			addActor.send(tagThrottler->tryUpdateAutoThrottling(ss));
 		}
 
-		double inputRate = ss.getSmoothInputBytesRate();
-
 		/*if( deterministicRandom()->random01() < 0.1 ) {
 		  std::string name = "RatekeeperUpdateRate" + limits.context;
 		  TraceEvent(name, ss.id)
@@ -817,6 +825,7 @@ void Ratekeeper::updateRate(RatekeeperLimits* limits) {
 						    .detail("SSLastReplyBytesInput", ss.lastReply.bytesInput)
 						    .detail("SSSmoothDurableBytes", ss.getSmoothDurableBytes())
 						    .detail("StorageQueue", storageQueue)
+						    .detail("ProjectedStorageQueue", projectedStorageQueue)
 						    .detail("TargetBytes", targetBytes)
 						    .detail("SpringBytes", springBytes)
 						    .detail("SSVerySmoothDurableBytesRate", ss.getVerySmoothDurableBytesRate())
@@ -41,6 +41,7 @@ ReadLatencySamples::Entry::Entry(std::string_view prefix, UID serverId)
               createSample(prefix, "ReadVersionWaitMetrics", serverId),
               createSample(prefix, "ReadQueueWaitMetrics", serverId),
               createSample(prefix, "KVGetRangeMetrics", serverId),
+              createSample(prefix, "KVGetValueMetrics", serverId),
               createSample(prefix, "GetMappedRangeMetrics", serverId),
               createSample(prefix, "GetMappedRangeRemoteMetrics", serverId),
               createSample(prefix, "GetMappedRangeLocalMetrics", serverId) }) {}
@@ -127,22 +127,29 @@ ACTOR Future<Void> ResolutionBalancer::resolutionBalancing_impl(ResolutionBalanc
 			futures.push_back(
 			    brokenPromiseToNever(p.metrics.getReply(ResolutionMetricsRequest(), TaskPriority::ResolutionMetrics)));
 		wait(waitForAll(futures));
-		state IndexedSet<std::pair<int64_t, int>, NoMetric> metrics;
+		state std::vector<std::pair<int64_t, int>> metrics;
 
 		int64_t total = 0;
 		for (int i = 0; i < futures.size(); i++) {
 			total += futures[i].get().value;
-			metrics.insert(std::make_pair(futures[i].get().value, i), NoMetric());
+			metrics.emplace_back(futures[i].get().value, i);
 			//TraceEvent("ResolverMetric").detail("I", i).detail("Metric", futures[i].get());
 		}
-		if (metrics.lastItem()->first - metrics.begin()->first > SERVER_KNOBS->MIN_BALANCE_DIFFERENCE) {
+		std::sort(metrics.begin(), metrics.end());
+		state int64_t average = total / self->resolvers.size();
+		state Standalone<VectorRef<ResolverMoveRef>> movedRanges;
+		state int pair = 0;
+		// Pair the busiest resolvers with the least busy ones, so that with many resolvers a single round can even
+		// out more than the two furthest apart
+		for (; pair < SERVER_KNOBS->RESOLUTION_BALANCE_PAIRS && pair < metrics.size() / 2; pair++) {
+			if (metrics[metrics.size() - 1 - pair].first - metrics[pair].first <= SERVER_KNOBS->MIN_BALANCE_DIFFERENCE)
+				break;
 			try {
-				state int src = metrics.lastItem()->second;
-				state int dest = metrics.begin()->second;
-				state int64_t amount = std::min(metrics.lastItem()->first - total / self->resolvers.size(),
-				                                total / self->resolvers.size() - metrics.begin()->first) /
+				state int src = metrics[metrics.size() - 1 - pair].second;
+				state int dest = metrics[pair].second;
+				state int64_t amount = std::min(metrics[metrics.size() - 1 - pair].first - average,
+				                                average - metrics[pair].first) /
 				                       2;
-				state Standalone<VectorRef<ResolverMoveRef>> movedRanges;
 
 				loop {
 					state std::pair<KeyRangeRef, bool> range = findRange(key_resolver, movedRanges, src, dest);
@@ -152,9 +159,8 @@ ACTOR Future<Void> ResolutionBalancer::resolutionBalancing_impl(ResolutionBalanc
 					req.offset = amount;
 					req.range = range.first;
 
-					ResolutionSplitReply split =
-					    wait(brokenPromiseToNever(self->resolvers[metrics.lastItem()->second].split.getReply(
-					        req, TaskPriority::ResolutionMetrics)));
+					ResolutionSplitReply split = wait(brokenPromiseToNever(
+					    self->resolvers[src].split.getReply(req, TaskPriority::ResolutionMetrics)));
 					KeyRangeRef moveRange = range.second ? KeyRangeRef(range.first.begin, split.key)
 					                                     : KeyRangeRef(split.key, range.first.end);
 					movedRanges.push_back_deep(movedRanges.arena(), ResolverMoveRef(moveRange, dest));
@@ -170,19 +176,22 @@ ACTOR Future<Void> ResolutionBalancer::resolutionBalancing_impl(ResolutionBalanc
 					if (moveRange != range.first || amount <= 0)
 						break;
 				}
-				for (auto& it : movedRanges)
-					key_resolver.insert(it.range, it.dest);
-				// for(auto& it : key_resolver.ranges())
-				//	TraceEvent("KeyResolver").detail("Range", it.range()).detail("Value", it.value());
-
-				self->resolverChangesVersion = *self->pVersion + 1;
-				for (auto& p : self->commitProxies)
-					self->resolverNeedingChanges.insert(p.id());
-				self->resolverChanges.set(movedRanges);
 			} catch (Error& e) {
 				if (e.code() != error_code_operation_failed)
 					throw;
 			}
 		}
+		if (!movedRanges.empty()) {
+			CODE_PROBE(pair > 1, "resolution balancing moves keyranges between several pairs of resolvers");
+			for (auto& it : movedRanges)
+				key_resolver.insert(it.range, it.dest);
+			// for(auto& it : key_resolver.ranges())
+			//	TraceEvent("KeyResolver").detail("Range", it.range()).detail("Value", it.value());
+
+			self->resolverChangesVersion = *self->pVersion + 1;
+			for (auto& p : self->commitProxies)
+				self->resolverNeedingChanges.insert(p.id());
+			self->resolverChanges.set(movedRanges);
+		}
 	}
 }
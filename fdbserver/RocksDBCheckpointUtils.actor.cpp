@@ -155,11 +155,15 @@ Error statusToError(const rocksdb::Status& s) {
 }
 
 // Fetch a single sst file from storage server. The progress is checkpointed via cFun.
+// If the storage server runs on the same host, sourceFile is its local path to the file, and it has sourceSize bytes
+// (or sourceSize is negative), the file is hard linked instead of being sent over the network.
 ACTOR Future<int64_t> doFetchCheckpointFile(Database cx,
                                             std::string remoteFile,
                                             std::string localFile,
                                             UID ssId,
                                             UID checkpointId,
+                                            Optional<std::string> sourceFile = Optional<std::string>(),
+                                            int64_t sourceSize = -1,
                                             int maxRetries = 3) {
 	state Transaction tr(cx);
 	state StorageServerInterface ssi;
@@ -177,6 +181,24 @@ ACTOR Future<int64_t> doFetchCheckpointFile(Database cx,
 		}
 	}
 
+	if (SERVER_KNOBS->CHECKPOINT_HARD_LINK_LOCAL_FILES && sourceFile.present() &&
+	    ssi.address().ip == g_network->getLocalAddress().ip) {
+		wait(IAsyncFileSystem::filesystem()->deleteFile(localFile, true));
+		// Checkpoint files are immutable, so the link can be shared safely. When the source is on another file system
+		// the link cannot be created and the file is fetched over the network.
+		if (fileExists(sourceFile.get()) && (sourceSize < 0 || fileSize(sourceFile.get()) == sourceSize) &&
+		    hardLinkFile(sourceFile.get(), localFile)) {
+			int64_t size = fileSize(localFile);
+			TraceEvent(SevDebug, "FetchCheckpointFileLinked")
+			    .detail("SourceFile", sourceFile.get())
+			    .detail("LocalFile", localFile)
+			    .detail("TargetUID", ssId)
+			    .detail("CheckpointId", checkpointId)
+			    .detail("FileSize", size);
+			return size;
+		}
+	}
+
 	state int attempt = 0;
 	state int64_t offset = 0;
 	state Reference<IAsyncFile> asyncFile;
@@ -255,7 +277,8 @@ ACTOR Future<Void> fetchCheckpointBytesSampleFile(Database cx,
 	ASSERT(!metaData->src.empty());
 	state UID ssId = metaData->src.front();
 
-	wait(success(doFetchCheckpointFile(cx, metaData->bytesSampleFile.get(), localFile, ssId, metaData->checkpointID)));
+	wait(success(doFetchCheckpointFile(
+	    cx, metaData->bytesSampleFile.get(), localFile, ssId, metaData->checkpointID, metaData->bytesSampleFile)));
 	metaData->bytesSampleFile = localFile;
 	if (cFun) {
 		wait(cFun(*metaData));
@@ -1046,7 +1069,9 @@ ACTOR Future<Void> fetchCheckpointFile(Database cx,
 	ASSERT_EQ(metaData->src.size(), 1);
 	const UID ssId = metaData->src.front();
 
-	wait(success(doFetchCheckpointFile(cx, remoteFile, localFile, ssId, metaData->checkpointID)));
+	const std::string sourceFile = rocksCF.sstFiles[idx].db_path + rocksCF.sstFiles[idx].name;
+	wait(success(doFetchCheckpointFile(
+	    cx, remoteFile, localFile, ssId, metaData->checkpointID, sourceFile, rocksCF.sstFiles[idx].size)));
 	rocksCF.sstFiles[idx].db_path = dir;
 	rocksCF.sstFiles[idx].fetched = true;
 	metaData->setSerializedCheckpoint(ObjectWriter::toValue(rocksCF, IncludeVersion()));
@@ -2284,6 +2284,12 @@ void setupSimulatedSystem(std::vector<Future<Void>>* systemActors,
 		g_knobs.setKnob("remote_kv_store", KnobValueRef::create(bool{ false }));
 		TraceEvent(SevDebug, "DisableRemoteKVS");
 	}
+	// Not in the first part of a restarting test, since the second part may run a version which cannot find the queues
+	if (!testConfig.isFirstTestInRestart && BUGGIFY) {
+		const std::string tLogDiskQueueFolder = joinPath(baseFolder, "tlogqueues");
+		g_knobs.setKnob("tlog_disk_queue_folder", KnobValueRef::create(tLogDiskQueueFolder));
+		TraceEvent("SimulatedTLogDiskQueueFolder").detail("Folder", tLogDiskQueueFolder);
+	}
 	auto configDBType = testConfig.getConfigDBType();
 	startingConfigString += DatabaseConfiguration::configureStringFromJSON(startingConfigJSON);
 
@@ -22,8 +22,13 @@
 #include <memory.h>
 #include <stdio.h>
 #include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
 #include <numeric>
+#include <set>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "flow/Platform.h"
@@ -33,6 +38,7 @@
 #include "fdbclient/KeyRangeMap.h"
 #include "fdbclient/SystemData.h"
 #include "fdbserver/ConflictSet.h"
+#include "fdbserver/Knobs.h"
 #include "flow/UnitTest.h"
 
 static std::vector<PerfDoubleCounter*> skc;
@@ -49,12 +55,12 @@ PerfDoubleCounter g_buildTest("Build", skc), g_add("Add", skc), g_detectConflict
     g_merge("D.MergeWrite", skc), g_removeBefore("D.RemoveBefore", skc);
 
 static force_inline int compare(const StringRef& a, const StringRef& b) {
-	const size_t aSize = a.size();
-	const size_t bSize = b.size();
-	const size_t minSize = std::min(aSize, bSize);
-	int c = memcmp(a.begin(), b.begin(), minSize);
-	if (c)
-		return (c > 0) - (c < 0); // normalize to +1/-1
+	const int aSize = a.size();
+	const int bSize = b.size();
+	const int minSize = std::min(aSize, bSize);
+	const int p = commonPrefixLength(a.begin(), b.begin(), minSize);
+	if (p < minSize)
+		return a[p] < b[p] ? -1 : 1;
 	return (aSize > bSize) - (aSize < bSize);
 }
 
@@ -120,9 +126,9 @@ force_inline bool getCharacter(const KeyInfo& ki, int character, int& outputChar
 
 bool operator<(const KeyInfo& lhs, const KeyInfo& rhs) {
 	int i = std::min(lhs.key.size(), rhs.key.size());
-	int c = memcmp(lhs.key.begin(), rhs.key.begin(), i);
-	if (c != 0)
-		return c < 0;
+	int p = commonPrefixLength(lhs.key.begin(), rhs.key.begin(), i);
+	if (p < i)
+		return lhs.key[p] < rhs.key[p];
 
 	// Always sort shorter keys before longer keys.
 	if (lhs.key.size() < rhs.key.size()) {
@@ -311,11 +317,23 @@ private:
 	};
 
 	static force_inline bool less(const uint8_t* a, int aLen, const uint8_t* b, int bLen) {
-		int c = memcmp(a, b, std::min(aLen, bLen));
-		if (c < 0)
-			return true;
-		if (c > 0)
-			return false;
+		return lessSkippingPrefix(a, aLen, b, bLen, 0, nullptr);
+	}
+
+	// Compares a < b given that their first skip bytes are already known to be equal. If prefix is
+	// non-null, the length of the common prefix of a and b is stored there.
+	static force_inline bool lessSkippingPrefix(const uint8_t* a,
+	                                            int aLen,
+	                                            const uint8_t* b,
+	                                            int bLen,
+	                                            int skip,
+	                                            int* prefix) {
+		const int minLen = std::min(aLen, bLen);
+		const int p = skip + commonPrefixLength(a + skip, b + skip, minLen - skip);
+		if (prefix)
+			*prefix = p;
+		if (p < minLen)
+			return a[p] < b[p];
 		return aLen < bLen;
 	}
 
@@ -339,6 +357,11 @@ public:
 		int level = MaxLevels;
 		Node* x = nullptr;
 		Node* alreadyChecked = nullptr;
+		// Length of the common prefix of value with x and with alreadyChecked. Every node visited
+		// between x and alreadyChecked shares at least the smaller of the two with value, so those
+		// bytes are skipped when comparing. Zero whenever unknown (or alreadyChecked is null).
+		int xPrefix = 0;
+		int checkedPrefix = 0;
 		StringRef value;
 
 		Finger() = default;
@@ -348,6 +371,7 @@ public:
 			this->value = value;
 			x = header;
 			alreadyChecked = nullptr;
+			xPrefix = checkedPrefix = 0;
 			level = MaxLevels;
 		}
 
@@ -367,13 +391,22 @@ public:
 		force_inline bool advance() {
 			Node* next = x->getNext(level - 1);
 
-			if (next == alreadyChecked || !less(next->value(), next->length(), value.begin(), value.size())) {
+			if (next == alreadyChecked) {
+				level--;
+				finger[level] = x;
+				return true;
+			}
+			int prefix;
+			const int skip = alreadyChecked ? std::min(xPrefix, checkedPrefix) : 0;
+			if (!lessSkippingPrefix(next->value(), next->length(), value.begin(), value.size(), skip, &prefix)) {
 				alreadyChecked = next;
+				checkedPrefix = prefix;
 				level--;
 				finger[level] = x;
 				return true;
 			} else {
 				x = next;
+				xPrefix = prefix;
 				return false;
 			}
 		}
@@ -521,6 +554,14 @@ public:
 		swap(input[0]);
 	}
 
+	void insert(const StringRef& value, Version version) {
+		Finger f(header, value);
+		while (!f.finished())
+			f.nextLevel();
+		// SOMEDAY: equality?
+		insert(f, version);
+	}
+
 	void find(const StringRef* values, Finger* results, int* temp, int count) {
 		// Relying on the ordering of values, descend until the values aren't all in the
 		// same part of the tree
@@ -546,6 +587,7 @@ public:
 			results[i].level = startLevel;
 			results[i].x = x;
 			results[i].alreadyChecked = nullptr;
+			results[i].xPrefix = results[i].checkedPrefix = 0;
 			results[i].value = values[i];
 			for (int j = startLevel; j < MaxLevels; j++)
 				results[i].finger[j] = results[0].finger[j];
@@ -652,14 +694,6 @@ private:
 		}
 	}
 
-	void insert(const StringRef& value, Version version) {
-		Finger f(header, value);
-		while (!f.finished())
-			f.nextLevel();
-		// SOMEDAY: equality?
-		insert(f, version);
-	}
-
 	struct CheckMax {
 		Finger start, end;
 		Version version;
@@ -704,6 +738,7 @@ private:
 						return false;
 					}
 					end.x = start.x;
+					end.xPrefix = 0;
 					while (!end.advance())
 						;
 
@@ -784,20 +819,248 @@ private:
 	}
 };
 
+// Owns the adaptive radix tree from art.h, which is declared inside the class that includes it.
+struct ConflictArt {
+#include "fdbserver/art.h"
+};
+
+#define ART_IMPL_OWNER ConflictArt
+#include "fdbserver/art_impl.h"
+
+// An alternative to SkipList for the version history, selected by RESOLVER_USE_ART_CONFLICT_SET. Like the
+// SkipList, every boundary key maps to the newest write version of the range from it up to the next
+// boundary, and the empty key is always a boundary. Lookups cost O(key length) rather than O(log n) full
+// key comparisons, which helps with long shared prefixes. Unlike the SkipList, the tree keeps no max-version
+// summaries, so checking a read range visits every boundary it covers instead of skipping old subranges; it
+// only pays off when conflict ranges are short. The tree never frees memory, so it is rebuilt
+// into a fresh arena once most of its arena is garbage. Lookups share static state inside art_tree, so
+// the history must only be used from one thread.
+class ArtConflictHistory : NonCopyable {
+	using art_tree = ConflictArt::art_tree;
+	using art_iterator = ConflictArt::art_iterator;
+
+	std::unique_ptr<Arena> arena;
+	art_tree* tree;
+	art_iterator last; // the boundary with the largest key
+	int64_t boundaryCount;
+	int64_t boundaryBytes;
+
+	static Version versionOf(const art_iterator& it) { return (Version)(intptr_t)it.value(); }
+	static void* encode(Version v) { return (void*)(intptr_t)v; }
+
+	void reset(Version version) {
+		arena = std::make_unique<Arena>();
+		tree = new (*arena) art_tree(*arena);
+		KeyRef empty;
+		last = tree->insert(empty, encode(version));
+		boundaryCount = 1;
+		boundaryBytes = 0;
+	}
+
+	// Returns the boundary of the range containing k.
+	art_iterator rangeContaining(const KeyRef& k) {
+		art_iterator it = tree->upper_bound(k);
+		if (it == art_iterator())
+			return last;
+		return --it;
+	}
+
+	art_iterator set(KeyRef k, Version version) {
+		int existing = 0;
+		art_iterator it = tree->insert_if_absent(k, encode(version), &existing);
+		if (existing) {
+			*it.value_ptr() = encode(version);
+		} else {
+			boundaryCount++;
+			boundaryBytes += k.size();
+			if (last.key() < k)
+				last = it;
+		}
+		return it;
+	}
+
+	void erase(art_iterator it) {
+		if (it == last)
+			last = --art_iterator(it);
+		boundaryCount--;
+		boundaryBytes -= it.key().size();
+		tree->erase(it);
+	}
+
+	void compactIfNeeded() {
+		const int64_t liveBytes = boundaryBytes + boundaryCount * 64;
+		if (arena->getSize(FastInaccurateEstimate::True) < std::max<int64_t>(1e6, liveBytes * 4))
+			return;
+		std::vector<std::pair<KeyRef, Version>> boundaries;
+		boundaries.reserve(boundaryCount);
+		Arena keys;
+		art_iterator it = tree->lower_bound(KeyRef());
+		for (; it != art_iterator(); ++it)
+			boundaries.emplace_back(KeyRef(keys, it.key()), versionOf(it));
+		reset(boundaries[0].second);
+		for (int i = 1; i < boundaries.size(); i++)
+			set(boundaries[i].first, boundaries[i].second);
+	}
+
+public:
+	explicit ArtConflictHistory(Version version) { reset(version); }
+
+	void detectConflicts(ReadConflictRange* ranges, int count, bool* transactionConflictStatus) {
+		for (int i = 0; i < count; i++) {
+			const ReadConflictRange& r = ranges[i];
+			for (art_iterator it = rangeContaining(r.begin); it != art_iterator() && it.key() < r.end; ++it) {
+				if (versionOf(it) > r.version) {
+					transactionConflictStatus[r.transaction] = true;
+					if (r.conflictingKeyRange != nullptr)
+						r.conflictingKeyRange->push_back(*r.cKRArena, r.indexInTx);
+					break;
+				}
+			}
+		}
+	}
+
+	// ranges must be sorted and non-overlapping
+	void addConflictRanges(const std::pair<StringRef, StringRef>* ranges, int count, Version version) {
+		for (int r = 0; r < count; r++) {
+			const auto& [begin, end] = ranges[r];
+			art_iterator e = tree->lower_bound(end);
+			if (e == art_iterator() || e.key() != end)
+				set(end, versionOf(rangeContaining(end)));
+
+			art_iterator it = tree->lower_bound(begin);
+			while (it.key() < end) {
+				art_iterator next = it;
+				++next;
+				erase(it);
+				it = next;
+			}
+			set(begin, version);
+		}
+		compactIfNeeded();
+	}
+
+	// Merges boundaries below version v into the preceding boundary when that one is below v too, examining
+	// at most nodeCount boundaries from removalKey. Returns the key to resume from, or the empty key once
+	// the end of the history is reached. As with SkipList::removeBefore(), the first boundary examined is
+	// always kept and the empty key is never examined.
+	KeyRef removeBefore(Version v, const KeyRef& removalKey, int nodeCount) {
+		art_iterator it = removalKey.size() ? tree->lower_bound(removalKey) : tree->upper_bound(removalKey);
+		bool wasAbove = true;
+		while (nodeCount-- && it != art_iterator()) {
+			art_iterator next = it;
+			++next;
+			bool isAbove = versionOf(it) >= v;
+			if (!isAbove && !wasAbove)
+				erase(it);
+			wasAbove = isAbove;
+			it = next;
+		}
+		return it == art_iterator() ? KeyRef() : it.key();
+	}
+
+	int64_t count() const { return boundaryCount; }
+};
+
+// A fork-join pool used to check the read conflict ranges of large batches against the version history
+// in parallel. The calling thread takes the first share of the work, so a pool of size() partitions
+// starts size() - 1 threads. Workers only read the version history, which is not modified until run()
+// returns. Simulation must stay deterministic, so there the calling thread works through every partition in
+// order instead.
+class ConflictCheckWorkers : NonCopyable {
+public:
+	explicit ConflictCheckWorkers(int partitions) : partitions(partitions) {
+		if (g_network->isSimulated())
+			return;
+		for (int i = 1; i < partitions; i++)
+			threads.emplace_back([this, i]() { workerLoop(i); });
+	}
+
+	~ConflictCheckWorkers() {
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			stopping = true;
+		}
+		wake.notify_all();
+		for (auto& t : threads)
+			t.join();
+	}
+
+	int size() const { return partitions; }
+
+	// Calls work(i) for every partition i in [0, size()) and returns once all of them are done.
+	void run(const std::function<void(int)>& work) {
+		if (threads.empty()) {
+			for (int i = 0; i < partitions; i++)
+				work(i);
+			return;
+		}
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			this->work = &work;
+			remaining = partitions - 1;
+			generation++;
+		}
+		wake.notify_all();
+		work(0);
+		std::unique_lock<std::mutex> lock(mutex);
+		finished.wait(lock, [this]() { return remaining == 0; });
+		this->work = nullptr;
+	}
+
+private:
+	void workerLoop(int partition) {
+		uint64_t seen = 0;
+		while (true) {
+			const std::function<void(int)>* w;
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				wake.wait(lock, [&]() { return stopping || generation != seen; });
+				if (stopping)
+					return;
+				seen = generation;
+				w = work;
+			}
+			(*w)(partition);
+			std::unique_lock<std::mutex> lock(mutex);
+			if (--remaining == 0)
+				finished.notify_one();
+		}
+	}
+
+	const int partitions;
+	std::vector<std::thread> threads;
+	std::mutex mutex;
+	std::condition_variable wake, finished;
+	const std::function<void(int)>* work = nullptr;
+	uint64_t generation = 0;
+	int remaining = 0;
+	bool stopping = false;
+};
+
 struct ConflictSet {
-	ConflictSet() : removalKey(makeString(0)), oldestVersion(0) {}
+	ConflictSet(int conflictThreads, bool useArt) : removalKey(makeString(0)), oldestVersion(0) {
+		if (useArt)
+			artHistory = std::make_unique<ArtConflictHistory>(0);
+		else if (conflictThreads > 1)
+			workers = std::make_unique<ConflictCheckWorkers>(conflictThreads);
+	}
 	~ConflictSet() {}
 
-	SkipList versionHistory;
+	SkipList versionHistory; // unused if artHistory is set
+	std::unique_ptr<ArtConflictHistory> artHistory;
 	Key removalKey;
 	Version oldestVersion;
+	std::unique_ptr<ConflictCheckWorkers> workers; // nullptr if conflicts are checked on the calling thread
 };
 
 ConflictSet* newConflictSet() {
-	return new ConflictSet;
+	return new ConflictSet(SERVER_KNOBS->RESOLVER_CONFLICT_THREADS, SERVER_KNOBS->RESOLVER_USE_ART_CONFLICT_SET);
 }
 void clearConflictSet(ConflictSet* cs, Version v) {
-	SkipList(v).swap(cs->versionHistory);
+	if (cs->artHistory)
+		cs->artHistory = std::make_unique<ArtConflictHistory>(v);
+	else
+		SkipList(v).swap(cs->versionHistory);
 }
 void destroyConflictSet(ConflictSet* cs) {
 	delete cs;
@@ -1017,7 +1280,11 @@ void ConflictBatch::detectConflicts(Version now,
 	delete[] transactionConflictStatus;
 
 	t = timer();
-	if (newOldestVersion > cs->oldestVersion) {
+	if (newOldestVersion > cs->oldestVersion && cs->artHistory) {
+		cs->oldestVersion = newOldestVersion;
+		cs->removalKey = cs->artHistory->removeBefore(
+		    cs->oldestVersion, cs->removalKey, combinedWriteConflictRanges.size() * 3 + 10);
+	} else if (newOldestVersion > cs->oldestVersion) {
 		cs->oldestVersion = newOldestVersion;
 		SkipList::Finger finger;
 		int temp;
@@ -1032,10 +1299,59 @@ void ConflictBatch::checkReadConflictRanges() {
 	if (combinedReadConflictRanges.empty())
 		return;
 
+	if (cs->artHistory) {
+		cs->artHistory->detectConflicts(
+		    &combinedReadConflictRanges[0], combinedReadConflictRanges.size(), transactionConflictStatus);
+		return;
+	}
+
+	if (cs->workers && combinedReadConflictRanges.size() >= SERVER_KNOBS->RESOLVER_PARALLEL_CONFLICT_MIN_RANGES) {
+		checkReadConflictRangesParallel();
+		return;
+	}
+
 	cs->versionHistory.detectConflicts(
 	    &combinedReadConflictRanges[0], combinedReadConflictRanges.size(), transactionConflictStatus);
 }
 
+// Partitions the read conflict ranges by key into one contiguous chunk per worker. Each range records its
+// result in its own slot, so workers never write the same memory, and the results are applied to the
+// transactions afterwards on the calling thread in a fixed order, which keeps the outcome deterministic.
+void ConflictBatch::checkReadConflictRangesParallel() {
+	const int count = combinedReadConflictRanges.size();
+	std::vector<ReadConflictRange> ranges;
+	ranges.reserve(count);
+	for (int i = 0; i < count; i++) {
+		const ReadConflictRange& r = combinedReadConflictRanges[i];
+		ranges.emplace_back(r.begin, r.end, r.version, i, r.indexInTx);
+	}
+	std::sort(ranges.begin(), ranges.end());
+
+	// "transaction" now indexes the per-range result; origin maps it back to combinedReadConflictRanges.
+	std::vector<int> origin(count);
+	for (int i = 0; i < count; i++) {
+		origin[i] = ranges[i].transaction;
+		ranges[i].transaction = i;
+	}
+
+	std::unique_ptr<bool[]> rangeConflict(new bool[count]());
+	const int partitions = cs->workers->size();
+	cs->workers->run([&](int partition) {
+		const int begin = (int64_t)count * partition / partitions;
+		const int end = (int64_t)count * (partition + 1) / partitions;
+		cs->versionHistory.detectConflicts(&ranges[begin], end - begin, rangeConflict.get());
+	});
+
+	for (int i = 0; i < count; i++) {
+		if (!rangeConflict[i])
+			continue;
+		const ReadConflictRange& r = combinedReadConflictRanges[origin[i]];
+		transactionConflictStatus[r.transaction] = true;
+		if (r.conflictingKeyRange != nullptr)
+			r.conflictingKeyRange->push_back(*r.cKRArena, r.indexInTx);
+	}
+}
+
 void ConflictBatch::addConflictRanges(Version now,
                                       std::vector<std::pair<StringRef, StringRef>>::iterator begin,
                                       std::vector<std::pair<StringRef, StringRef>>::iterator end,
@@ -1063,6 +1379,12 @@ void ConflictBatch::mergeWriteConflictRanges(Version now) {
 	if (combinedWriteConflictRanges.empty())
 		return;
 
+	if (cs->artHistory) {
+		cs->artHistory->addConflictRanges(
+		    combinedWriteConflictRanges.data(), combinedWriteConflictRanges.size(), now);
+		return;
+	}
+
 	addConflictRanges(now, combinedWriteConflictRanges.begin(), combinedWriteConflictRanges.end(), &cs->versionHistory);
 }
 
@@ -1152,6 +1474,8 @@ void operatorLessThanTest() {
 }
 } // namespace
 
+static void conflictSetPerfTest(ConflictSet* cs, const VectorRef<VectorRef<KeyRangeRef>>& testData);
+
 void skipListTest() {
 	printf("Skip list test\n");
 
@@ -1161,10 +1485,6 @@ void skipListTest() {
 
 	setAffinity(0);
 
-	double start;
-
-	ConflictSet* cs = newConflictSet();
-
 	Arena testDataArena;
 	VectorRef<VectorRef<KeyRangeRef>> testData;
 	const int batches = 500; // deterministicRandom()->randomInt(500, 5000);
@@ -1184,7 +1504,18 @@ void skipListTest() {
 	}
 	printf("Test data generated: %d batches, %d/batch\n", batches, data_per_batch);
 
-	printf("Running\n");
+	for (bool useArt : { false, true }) {
+		printf("Running with the %s version history\n", useArt ? "ART" : "SkipList");
+		for (auto* counter : skc)
+			counter->clear();
+		ConflictSet cs(0, useArt);
+		conflictSetPerfTest(&cs, testData);
+	}
+}
+
+static void conflictSetPerfTest(ConflictSet* cs, const VectorRef<VectorRef<KeyRangeRef>>& testData) {
+	const int batches = testData.size();
+	double start;
 
 	int readCount = 1, writeCount = 1;
 	int cranges = 0, tcount = 0;
@@ -1246,7 +1577,8 @@ void skipListTest() {
 		printf("%20s: %s\n", counter->getMetric().name().c_str(), counter->getMetric().formatted().c_str());
 	}
 
-	printf("%d entries in version history\n", cs->versionHistory.count());
+	printf("%d entries in version history\n",
+	       cs->artHistory ? (int)cs->artHistory->count() : cs->versionHistory.count());
 }
 
 TEST_CASE("/fdbserver/skiplist/miniConflictSetCompatibility") {
@@ -1546,3 +1878,103 @@ TEST_CASE("/fdbserver/skiplist/miniConflictSetCompatibility") {
 
 	return Void();
 }
+
+TEST_CASE("/fdbserver/skiplist/prefixSkippingSearch") {
+	// Keys share long prefixes so that searches cross the vector, word and byte comparison paths and
+	// exercise the prefix skipping in Finger::advance().
+	Arena arena;
+	std::set<StringRef> reference;
+	std::vector<StringRef> keys;
+	for (int i = 0; i < 2000; i++) {
+		int prefixLen = deterministicRandom()->randomChoice(std::vector<int>{ 0, 7, 15, 16, 31, 32, 33, 70 });
+		int suffixLen = deterministicRandom()->randomInt(0, 4);
+		uint8_t* s = new (arena) uint8_t[prefixLen + suffixLen];
+		memset(s, 'p', prefixLen);
+		for (int j = 0; j < suffixLen; j++)
+			s[prefixLen + j] = deterministicRandom()->randomChoice(std::vector<uint8_t>{ 0, 'a', 'p', 0xff });
+		keys.emplace_back(s, prefixLen + suffixLen);
+	}
+
+	SkipList list;
+	for (int i = 0; i < keys.size() / 2; i++) {
+		if (reference.insert(keys[i]).second)
+			list.insert(keys[i], 1);
+	}
+
+	for (int i = 0; i < keys.size(); i++) {
+		int p = commonPrefixLength(keys[i], keys[0]);
+		ASSERT(p == std::mismatch(keys[i].begin(),
+		                          keys[i].begin() + std::min(keys[i].size(), keys[0].size()),
+		                          keys[0].begin())
+		                    .first -
+		                keys[i].begin());
+		ASSERT((compare(keys[i], keys[0]) < 0) == (keys[i] < keys[0]));
+	}
+
+	std::sort(keys.begin(), keys.end());
+	std::vector<SkipList::Finger> fingers(keys.size());
+	std::vector<int> temp(keys.size());
+	list.find(keys.data(), fingers.data(), temp.data(), keys.size());
+	for (int i = 0; i < keys.size(); i++) {
+		ASSERT((fingers[i].found() != nullptr) == (reference.count(keys[i]) > 0));
+		auto it = reference.lower_bound(keys[i]);
+		ASSERT(fingers[i].getValue() == (it == reference.end() ? StringRef() : *it));
+	}
+
+	return Void();
+}
+
+// Resolves the same random batches with both conflict sets and checks that they agree for every transaction.
+static void checkConflictSetsAgree(ConflictSet* a, ConflictSet* b, int rangesPerBatch, int keySpace) {
+	for (Version version = 10; version < 60; version++) {
+		Arena arena;
+		std::vector<CommitTransactionRef> trs;
+		for (int ranges = 0; ranges < rangesPerBatch;) {
+			CommitTransactionRef tr;
+			tr.report_conflicting_keys = deterministicRandom()->coinflip();
+			tr.read_snapshot = version - deterministicRandom()->randomInt(1, 5);
+			for (int k = deterministicRandom()->randomInt(1, 4); k > 0; k--, ranges++) {
+				int key = deterministicRandom()->randomInt(0, keySpace);
+				tr.read_conflict_ranges.push_back(
+				    arena, KeyRangeRef(setK(arena, key), setK(arena, key + 1 + deterministicRandom()->randomInt(0, 20))));
+			}
+			int key = deterministicRandom()->randomInt(0, keySpace);
+			tr.write_conflict_ranges.push_back(
+			    arena, KeyRangeRef(setK(arena, key), setK(arena, key + 1 + deterministicRandom()->randomInt(0, 5))));
+			trs.push_back(tr);
+		}
+
+		std::vector<int> nonConflicting[2];
+		std::map<int, VectorRef<int>> conflictingKeys[2];
+		Arena replyArena[2];
+		ConflictSet* sets[2] = { a, b };
+		for (int i = 0; i < 2; i++) {
+			ConflictBatch batch(sets[i], &conflictingKeys[i], &replyArena[i]);
+			for (const auto& tr : trs)
+				batch.addTransaction(tr, version - 10);
+			batch.detectConflicts(version, version - 10, nonConflicting[i]);
+		}
+
+		ASSERT(nonConflicting[0] == nonConflicting[1]);
+		ASSERT(conflictingKeys[0].size() == conflictingKeys[1].size());
+		for (auto& [t, keys] : conflictingKeys[0]) {
+			VectorRef<int>& other = conflictingKeys[1][t];
+			ASSERT(std::set<int>(keys.begin(), keys.end()) == std::set<int>(other.begin(), other.end()));
+		}
+	}
+}
+
+TEST_CASE("/fdbserver/skiplist/parallelReadConflictCheck") {
+	ConflictSet serial(0, false);
+	ConflictSet parallel(4, false);
+	checkConflictSetsAgree(&serial, &parallel, SERVER_KNOBS->RESOLVER_PARALLEL_CONFLICT_MIN_RANGES + 100, 20000);
+	return Void();
+}
+
+TEST_CASE("/fdbserver/skiplist/artConflictSet") {
+	ConflictSet skipList(0, false);
+	ConflictSet art(0, true);
+	checkConflictSetsAgree(&skipList, &art, 500, 2000);
+	ASSERT(skipList.versionHistory.count() + 1 == art.artHistory->count()); // the ART also counts the empty key
+	return Void();
+}
@@ -453,6 +453,25 @@ struct MachineMemoryInfo {
 	void invalidate() { memoryUsage = -1; }
 };
 
+// Latency of each stage of a commit batch on the commit proxies, as {status field, latency metrics event}
+static const std::vector<std::pair<std::string, std::string>> commitStageLatencyMetrics = {
+	{ "batch_queuing", "ComputeLatency" },
+	{ "get_commit_version", "CommitGetVersionLatency" },
+	{ "resolution", "CommitResolutionLatency" },
+	{ "post_resolution_queuing", "CommitPostResolutionQueuingLatency" },
+	{ "processing_mutations", "CommitProcessingMutationLatency" },
+	{ "tlog_logging", "CommitTLogLoggingLatency" },
+	{ "reply", "CommitReplyLatency" },
+};
+
+// Latency of each stage of a read on the storage servers, as {status field, latency metrics event}
+static const std::vector<std::pair<std::string, std::string>> readStageLatencyMetrics = {
+	{ "queue_wait", "ReadQueueWaitMetrics" },
+	{ "version_wait", "ReadVersionWaitMetrics" },
+	{ "kv_get_value", "KVGetValueMetrics" },
+	{ "kv_get_range", "KVGetRangeMetrics" },
+};
+
 struct RolesInfo {
 	std::multimap<NetworkAddress, JsonBuilderObject> roles;
 
@@ -525,6 +544,7 @@ struct RolesInfo {
 			obj.setKeyRawNumber("kvstore_total_size", storageMetrics.getValue("KvstoreSizeTotal"));
 			obj.setKeyRawNumber("kvstore_total_nodes", storageMetrics.getValue("KvstoreNodeTotal"));
 			obj.setKeyRawNumber("kvstore_inline_keys", storageMetrics.getValue("KvstoreInlineKey"));
+			obj.setKeyRawNumber("kvstore_memory_bytes", storageMetrics.getValue("KvstoreMemoryBytes"));
 			obj["input_bytes"] = StatusCounter(storageMetrics.getValue("BytesInput")).getStatus();
 			obj["durable_bytes"] = StatusCounter(storageMetrics.getValue("BytesDurable")).getStatus();
 			obj.setKeyRawNumber("query_queue_max", storageMetrics.getValue("QueryQueueMax"));
@@ -570,6 +590,17 @@ struct RolesInfo {
 				obj["read_latency_bands"] = addLatencyBandInfo(readLatencyBands);
 			}
 
+			JsonBuilderObject stageStats;
+			for (const auto& [stage, eventName] : readStageLatencyMetrics) {
+				TraceEventFields const& stageMetrics = metrics.at(eventName);
+				if (stageMetrics.size()) {
+					stageStats[stage] = addLatencyStatistics(stageMetrics);
+				}
+			}
+			if (stageStats.size()) {
+				obj["read_stage_latency_statistics"] = stageStats;
+			}
+
 			obj["data_lag"] = getLagObject(versionLag);
 			obj["durability_lag"] = getLagObject(version - durableVersion);
 			dataLagSeconds = versionLag / (double)SERVER_KNOBS->VERSIONS_PER_SECOND;
@@ -689,6 +720,22 @@ struct RolesInfo {
 			if (commitBatchingWindowSize.size()) {
 				obj["commit_batching_window_size"] = addLatencyStatistics(commitBatchingWindowSize);
 			}
+
+			TraceEventFields const& commitBatchingDesiredBytes = metrics.at("CommitBatchingDesiredBytes");
+			if (commitBatchingDesiredBytes.size()) {
+				obj["commit_batching_desired_bytes"] = addLatencyStatistics(commitBatchingDesiredBytes);
+			}
+
+			JsonBuilderObject stageStats;
+			for (const auto& [stage, eventName] : commitStageLatencyMetrics) {
+				TraceEventFields const& stageMetrics = metrics.at(eventName);
+				if (stageMetrics.size()) {
+					stageStats[stage] = addLatencyStatistics(stageMetrics);
+				}
+			}
+			if (stageStats.size()) {
+				obj["commit_stage_latency_statistics"] = stageStats;
+			}
 		} catch (Error& e) {
 			if (e.code() != error_code_attribute_not_found) {
 				throw e;
@@ -1224,10 +1271,15 @@ ACTOR static Future<JsonBuilderObject> recoveryStateStatusFetcher(Database cx,
 		    timeoutError(ccWorker.interf.eventLogRequest.getReply(EventLogRequest(StringRef(
 		                     getRecoveryEventName(ClusterRecoveryEventType::CLUSTER_RECOVERY_AVAILABLE_EVENT_NAME)))),
 		                 1.0);
+		state Future<TraceEventFields> mDurationF =
+		    timeoutError(ccWorker.interf.eventLogRequest.getReply(EventLogRequest(StringRef(
+		                     getRecoveryEventName(ClusterRecoveryEventType::CLUSTER_RECOVERY_DURATION_EVENT_NAME)))),
+		                 1.0);
 		tr.setOption(FDBTransactionOptions::PRIORITY_SYSTEM_IMMEDIATE);
 		state Future<ErrorOr<Version>> rvF = errorOr(timeoutError(tr.getReadVersion(), 1.0));
 
-		wait(success(mdActiveGensF) && success(mdF) && success(rvF) && success(mDBAvailableF));
+		wait(success(mdActiveGensF) && success(mdF) && success(rvF) && success(mDBAvailableF) &&
+		     success(mDurationF));
 
 		const TraceEventFields& md = mdF.get();
 		int mStatusCode = md.getInt("StatusCode");
@@ -1268,8 +1320,29 @@ ACTOR static Future<JsonBuilderObject> recoveryStateStatusFetcher(Database cx,
 			message["missing_logs"] = md.getValue("MissingIDs").c_str();
 		}
 
-		// TODO:  time_in_recovery: 0.5
-		//        time_in_state: 0.1
+		double stateTime;
+		if (md.tryGetDouble("Time", stateTime)) {
+			message["seconds_in_state"] = std::max(0.0, now() - stateTime);
+		}
+
+		// When the last recovery reached each milestone, in seconds from its start
+		const TraceEventFields& durationMsg = mDurationF.get();
+		if (durationMsg.size() > 0) {
+			JsonBuilderObject timeline;
+			for (const auto& [field, name] : std::vector<std::pair<std::string, std::string>>{
+			         { "CoordinatedStateRead", "coordinated_state_read" },
+			         { "CoordinatedStateLocked", "coordinated_state_locked" },
+			         { "OldLogsLocked", "old_logs_locked" },
+			         { "TransactionServersRecruited", "transaction_servers_recruited" },
+			         { "RecoveryTransactionCommitted", "recovery_transaction_committed" },
+			         { "RecoveryDuration", "accepting_commits" } }) {
+				double seconds;
+				if (durationMsg.tryGetDouble(field, seconds)) {
+					timeline[name] = seconds;
+				}
+			}
+			message["last_recovery_timeline"] = timeline;
+		}
 
 		const TraceEventFields& mdActiveGens = mdActiveGensF.get();
 		if (mdActiveGens.size()) {
@@ -1987,8 +2060,11 @@ static Future<std::vector<std::pair<iface, EventMap>>> getServerMetrics(
 
 namespace {
 
-const std::vector<std::string> STORAGE_SERVER_METRICS_LIST{ "StorageMetrics", "ReadLatencyMetrics", "ReadLatencyBands",
-	                                                        "BusiestReadTag", "BusiestWriteTag",    "RocksDBMetrics" };
+const std::vector<std::string> STORAGE_SERVER_METRICS_LIST{ "StorageMetrics",         "ReadLatencyMetrics",
+	                                                        "ReadLatencyBands",       "BusiestReadTag",
+	                                                        "BusiestWriteTag",        "RocksDBMetrics",
+	                                                        "ReadQueueWaitMetrics",   "ReadVersionWaitMetrics",
+	                                                        "KVGetValueMetrics",      "KVGetRangeMetrics" };
 
 } // namespace
 
@@ -2023,10 +2099,14 @@ ACTOR static Future<std::vector<std::pair<TLogInterface, EventMap>>> getTLogsAnd
 ACTOR static Future<std::vector<std::pair<CommitProxyInterface, EventMap>>> getCommitProxiesAndMetrics(
     Reference<AsyncVar<ServerDBInfo>> db,
     std::unordered_map<NetworkAddress, WorkerInterface> address_workers) {
-	std::vector<std::pair<CommitProxyInterface, EventMap>> results = wait(getServerMetrics(
-	    db->get().client.commitProxies,
-	    address_workers,
-	    std::vector<std::string>{ "CommitLatencyMetrics", "CommitLatencyBands", "CommitBatchingWindowSize" }));
+	state std::vector<std::string> eventNames{
+		"CommitLatencyMetrics", "CommitLatencyBands", "CommitBatchingWindowSize", "CommitBatchingDesiredBytes"
+	};
+	for (const auto& stage : commitStageLatencyMetrics) {
+		eventNames.push_back(stage.second);
+	}
+	std::vector<std::pair<CommitProxyInterface, EventMap>> results =
+	    wait(getServerMetrics(db->get().client.commitProxies, address_workers, eventNames));
 
 	return results;
 }
@@ -176,6 +176,22 @@ void StorageServerMetrics::notifyBytesReadPerKSecond(const Key& key, int64_t in)
 	}
 }
 
+void StorageServerMetrics::notifyReadCost(const Key& key, int64_t in) {
+	double expire = now() + SERVER_KNOBS->STORAGE_METRICS_AVERAGE_INTERVAL;
+	int64_t bytesReadPerKSecond =
+	    bytesReadSample.addAndExpire(key, in, expire) * SERVER_KNOBS->STORAGE_METRICS_AVERAGE_INTERVAL_PER_KSECONDS;
+
+	if (bytesReadPerKSecond > 0) {
+		StorageMetrics notifyMetrics;
+		notifyMetrics.bytesReadPerKSecond = bytesReadPerKSecond;
+		auto& v = waitMetricsMap[key];
+		for (int i = 0; i < v.size(); i++) {
+			CODE_PROBE(true, "ShardNotifyMetrics readCost");
+			v[i].send(notifyMetrics);
+		}
+	}
+}
+
 // Called by StorageServerDisk when the size of a key in byteSample changes, to notify WaitMetricsRequest
 // Should not be called for keys past allKeys.end
 void StorageServerMetrics::notifyBytes(
@@ -286,6 +302,7 @@ KeyRef StorageServerMetrics::getSplitKey(int64_t remaining,
 void StorageServerMetrics::splitMetrics(SplitMetricsRequest req) const {
 	int minSplitBytes = req.minSplitBytes.present() ? req.minSplitBytes.get() : SERVER_KNOBS->MIN_SHARD_BYTES;
 	int minSplitWriteTraffic = SERVER_KNOBS->SHARD_SPLIT_BYTES_PER_KSEC;
+	int64_t minSplitWriteOps = SERVER_KNOBS->SHARD_SPLIT_WRITE_OPS_PER_KSEC;
 	try {
 		SplitMetricsReply reply;
 		KeyRef lastKey = req.keys.begin;
@@ -296,8 +313,9 @@ void StorageServerMetrics::splitMetrics(SplitMetricsRequest req) const {
 		//TraceEvent("SplitMetrics").detail("Begin", req.keys.begin).detail("End", req.keys.end).detail("Remaining", remaining.bytes).detail("Used", used.bytes).detail("MinSplitBytes", minSplitBytes);
 
 		while (true) {
-			if (remaining.bytes < 2 * minSplitBytes && (!SERVER_KNOBS->ENABLE_WRITE_BASED_SHARD_SPLIT ||
-			                                            remaining.bytesWrittenPerKSecond < minSplitWriteTraffic))
+			if (remaining.bytes < 2 * minSplitBytes &&
+			    (!SERVER_KNOBS->ENABLE_WRITE_BASED_SHARD_SPLIT ||
+			     (remaining.bytesWrittenPerKSecond < minSplitWriteTraffic && remaining.iosPerKSecond < minSplitWriteOps)))
 				break;
 			KeyRef key = req.keys.end;
 			bool hasUsed = used.bytes != 0 || used.bytesWrittenPerKSecond != 0 || used.iosPerKSecond != 0;
@@ -523,8 +541,8 @@ std::vector<ReadHotRangeWithMetrics> StorageServerMetrics::_getReadHotRanges(
 			                      bytesReadSample.getEstimate(range) / SERVER_KNOBS->STORAGE_METRICS_AVERAGE_INTERVAL);
 		}
 		beginKey = *endKey;
-		endKey =
-		    byteSample.sample.index(byteSample.sample.sumTo(byteSample.sample.lower_bound(beginKey)) + baseChunkSize);
+		// endKey is already the first sample at or after beginKey, so it need not be searched for again
+		endKey = byteSample.sample.index(byteSample.sample.sumTo(endKey) + baseChunkSize);
 	}
 	return toReturn;
 }
@@ -576,7 +594,8 @@ std::vector<KeyRef> StorageServerMetrics::getSplitPoints(KeyRangeRef range,
 		}
 		toReturn.push_back(splitPoint);
 		beginKey = *endKey;
-		endKey = byteSample.sample.index(byteSample.sample.sumTo(byteSample.sample.lower_bound(beginKey)) + chunkSize);
+		// endKey is already the first sample at or after beginKey, so it need not be searched for again
+		endKey = byteSample.sample.index(byteSample.sample.sumTo(endKey) + chunkSize);
 	}
 	return toReturn;
 }
@@ -815,6 +834,20 @@ TEST_CASE("/fdbserver/StorageMetricSample/readHotDetect/simple") {
 	return Void();
 }
 
+TEST_CASE("/fdbserver/StorageMetricSample/readHotDetect/readCost") {
+
+	int64_t sampleUnit = SERVER_KNOBS->BYTES_READ_UNITS_PER_SAMPLE;
+	StorageServerMetrics ssm;
+
+	// Read cost counts toward read bandwidth but not toward read operations
+	ssm.notifyReadCost("Banana"_sr, 10 * sampleUnit);
+	ASSERT_EQ(ssm.bytesReadSample.getEstimate(KeyRangeRef("A"_sr, "C"_sr)), 10 * sampleUnit);
+	ASSERT_EQ(ssm.bytesReadSample.getEstimate(KeyRangeRef("C"_sr, "D"_sr)), 0);
+	ASSERT_EQ(ssm.opsReadSample.getEstimate(KeyRangeRef("A"_sr, "C"_sr)), 0);
+
+	return Void();
+}
+
 TEST_CASE("/fdbserver/StorageMetricSample/readHotDetect/moreThanOneRange") {
 
 	int64_t sampleUnit = SERVER_KNOBS->BYTES_READ_UNITS_PER_SAMPLE;
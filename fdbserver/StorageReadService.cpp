@@ -0,0 +1,273 @@
+/*
+ * StorageReadService.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2025 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifdef FLOW_GRPC_ENABLED
+#include <fmt/format.h>
+
+#include "fdbserver/StorageReadService.h"
+#include "fdbclient/Knobs.h"
+#include "flow/ThreadHelper.actor.h"
+#include "flow/UnitTest.h"
+
+namespace {
+
+// Reads the next chunk of [begin, end) at the version from the first local storage server which serves the range
+Future<GetKeyValuesReply> readLocalRange(std::shared_ptr<LocalStorageServers> servers,
+                                         Key begin,
+                                         Key end,
+                                         Version version,
+                                         int chunkBytes) {
+	// Storage servers may come and go while a request is outstanding
+	std::vector<StorageServerInterface> candidates;
+	for (auto const& [id, ssi] : servers->interfaces) {
+		candidates.push_back(ssi);
+	}
+
+	for (auto const& ssi : candidates) {
+		GetKeyValuesRequest req;
+		req.begin = firstGreaterOrEqual(KeyRef(req.arena, begin));
+		req.end = firstGreaterOrEqual(KeyRef(req.arena, end));
+		req.version = version;
+		req.limit = chunkBytes;
+		req.limitBytes = chunkBytes;
+		req.options = ReadOptions(ReadType::LOW, CacheResult::False);
+		ErrorOr<GetKeyValuesReply> reply = co_await errorOr(ssi.getKeyValues.getReply(req));
+		Error error = reply.isError() ? reply.getError() : reply.get().error.orDefault(success());
+		if (error.code() == error_code_success) {
+			co_return reply.get();
+		}
+		// Another local storage server may serve the range
+		if (error.code() != error_code_wrong_shard_server && error.code() != error_code_broken_promise) {
+			throw error;
+		}
+	}
+	throw wrong_shard_server();
+}
+
+Future<Version> getReadVersion(Database db) {
+	Transaction tr(db);
+	while (true) {
+		Error err;
+		try {
+			Version version = co_await tr.getReadVersion();
+			co_return version;
+		} catch (Error& e) {
+			if (e.code() == error_code_actor_cancelled) {
+				throw;
+			}
+
+			err = e;
+		}
+
+		co_await tr.onError(err);
+	}
+}
+
+grpc::Status toStatus(Error const& e) {
+	switch (e.code()) {
+	case error_code_wrong_shard_server:
+		return grpc::Status(grpc::StatusCode::FAILED_PRECONDITION,
+		                    "Range is not within a shard served by a storage server of this process");
+	case error_code_transaction_too_old:
+		return grpc::Status(grpc::StatusCode::OUT_OF_RANGE, "Read version is too old");
+	case error_code_future_version:
+	case error_code_process_behind:
+		return grpc::Status(grpc::StatusCode::UNAVAILABLE, "Storage server has not caught up to the read version");
+	default:
+		return grpc::Status(grpc::StatusCode::INTERNAL, fmt::format("Unknown error '{}'", e.name()));
+	}
+}
+
+} // namespace
+
+StorageReadServiceImpl::StorageReadServiceImpl(Database db, std::shared_ptr<LocalStorageServers> servers)
+  : Service(), db_(db), servers_(servers) {}
+
+grpc::Status StorageReadServiceImpl::ReadRange(grpc::ServerContext* context,
+                                               const fdbserver::ReadRangeRequest* request,
+                                               grpc::ServerWriter<fdbserver::ReadRangeChunk>* writer) {
+	Key begin = StringRef(request->begin());
+	const Key end = StringRef(request->end());
+	if (begin >= end) {
+		return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT, "Range is empty");
+	}
+	const int chunkBytes = request->chunk_bytes() > 0 ? request->chunk_bytes() : CLIENT_KNOBS->REPLY_BYTE_LIMIT;
+
+	try {
+		// db_ is only touched on the main thread, since references are not thread safe
+		Version version = request->read_version();
+		if (version <= 0) {
+			version = onMainThread([this]() { return getReadVersion(db_); }).getBlocking();
+		}
+
+		while (true) {
+			if (context->IsCancelled()) {
+				return grpc::Status(grpc::StatusCode::CANCELLED, "Reader cancelled the stream");
+			}
+
+			GetKeyValuesReply reply =
+			    onMainThread([=, this]() { return readLocalRange(servers_, begin, end, version, chunkBytes); })
+			        .getBlocking();
+
+			fdbserver::ReadRangeChunk chunk;
+			chunk.set_read_version(version);
+			for (const auto& kv : reply.data) {
+				fdbserver::KeyValue* out = chunk.add_data();
+				out->set_key(kv.key.begin(), kv.key.size());
+				out->set_value(kv.value.begin(), kv.value.size());
+			}
+			// Blocks while HTTP/2 flow control holds the stream back
+			if (!writer->Write(chunk)) {
+				return grpc::Status(grpc::StatusCode::CANCELLED, "Stream closed by the reader");
+			}
+
+			if (!reply.more || reply.data.empty()) {
+				break;
+			}
+			begin = keyAfter(reply.data.back().key);
+		}
+	} catch (Error& e) {
+		return toStatus(e);
+	}
+
+	return grpc::Status::OK;
+}
+
+namespace {
+
+// Serves reads of data at the version like a storage server would, or fails them all with wrong_shard_server
+Future<Void> fakeStorageServer(StorageServerInterface ssi,
+                               Standalone<VectorRef<KeyValueRef>> data,
+                               Version version,
+                               bool wrongShard) {
+	while (true) {
+		GetKeyValuesRequest req = co_await ssi.getKeyValues.getFuture();
+		if (wrongShard) {
+			req.reply.sendError(wrong_shard_server());
+			continue;
+		}
+		ASSERT_EQ(req.version, version);
+		ASSERT(req.begin.isFirstGreaterOrEqual() && req.end.isFirstGreaterOrEqual());
+
+		GetKeyValuesReply reply;
+		reply.version = version;
+		int bytes = 0;
+		for (const auto& kv : data) {
+			if (kv.key < req.begin.getKey() || kv.key >= req.end.getKey()) {
+				continue;
+			}
+			if (bytes >= req.limitBytes) {
+				reply.more = true;
+				break;
+			}
+			reply.data.push_back_deep(reply.arena, kv);
+			bytes += kv.expectedSize();
+		}
+		req.reply.send(reply);
+	}
+}
+
+// Reads the whole stream, or returns the error it ended with
+Future<ErrorOr<std::vector<fdbserver::ReadRangeChunk>>> readStream(
+    AsyncGrpcClient<fdbserver::StorageReadService>& client,
+    fdbserver::ReadRangeRequest request) {
+	std::vector<fdbserver::ReadRangeChunk> chunks;
+	auto stream = client.call(&fdbserver::StorageReadService::Stub::ReadRange, request);
+	try {
+		while (true) {
+			fdbserver::ReadRangeChunk chunk = co_await stream;
+			chunks.push_back(chunk);
+		}
+	} catch (Error& e) {
+		if (e.code() != error_code_end_of_stream) {
+			co_return ErrorOr<std::vector<fdbserver::ReadRangeChunk>>(e);
+		}
+	}
+	co_return chunks;
+}
+
+} // namespace
+
+TEST_CASE("/fdbserver/StorageReadService/ReadRange") {
+	const Version version = deterministicRandom()->randomInt64(1, 1e9);
+	Standalone<VectorRef<KeyValueRef>> data;
+	for (int i = 0; i < 100; i++) {
+		data.push_back_deep(data.arena(),
+		                    KeyValueRef(StringRef(fmt::format("key{:03d}", i)),
+		                                StringRef(deterministicRandom()->randomAlphaNumeric(100))));
+	}
+
+	// Only one of the local storage servers serves the range, so the other's replies must be skipped
+	StorageServerInterface servingSS(deterministicRandom()->randomUniqueID());
+	StorageServerInterface otherSS(deterministicRandom()->randomUniqueID());
+	servingSS.initEndpoints();
+	otherSS.initEndpoints();
+	auto servers = std::make_shared<LocalStorageServers>();
+	servers->interfaces[servingSS.id()] = servingSS;
+	servers->interfaces[otherSS.id()] = otherSS;
+	Future<Void> serving = fakeStorageServer(servingSS, data, version, false);
+	Future<Void> other = fakeStorageServer(otherSS, data, version, true);
+
+	NetworkAddress addr(NetworkAddress::parse("127.0.0.1:50520"));
+	GrpcServer server(addr);
+	server.registerService(std::make_shared<StorageReadServiceImpl>(Database(), servers));
+	Future<Void> _ = server.run();
+	co_await server.onRunning();
+
+	auto pool = std::make_shared<AsyncTaskExecutor>(1);
+	AsyncGrpcClient<fdbserver::StorageReadService> client(addr.toString(), pool);
+
+	// A small chunk size splits the range over several chunks, all at the requested version
+	fdbserver::ReadRangeRequest request;
+	request.set_begin("key010");
+	request.set_end("key090");
+	request.set_read_version(version);
+	request.set_chunk_bytes(1000);
+	ErrorOr<std::vector<fdbserver::ReadRangeChunk>> chunks = co_await readStream(client, request);
+	ASSERT(chunks.present());
+	ASSERT(chunks.get().size() > 1);
+	int next = 10;
+	for (const auto& chunk : chunks.get()) {
+		ASSERT_EQ(chunk.read_version(), version);
+		for (const auto& kv : chunk.data()) {
+			ASSERT(StringRef(kv.key()) == data[next].key);
+			ASSERT(StringRef(kv.value()) == data[next].value);
+			next++;
+		}
+	}
+	ASSERT_EQ(next, 90);
+
+	// The client does not pass on the status, so the error mapping is checked separately below
+	request.set_end("key010");
+	ErrorOr<std::vector<fdbserver::ReadRangeChunk>> empty = co_await readStream(client, request);
+	ASSERT(empty.isError() && empty.getError().code() == error_code_grpc_error);
+
+	servers->interfaces.erase(servingSS.id());
+	request.set_end("key090");
+	ErrorOr<std::vector<fdbserver::ReadRangeChunk>> wrongShard = co_await readStream(client, request);
+	ASSERT(wrongShard.isError() && wrongShard.getError().code() == error_code_grpc_error);
+
+	ASSERT(toStatus(wrong_shard_server()).error_code() == grpc::StatusCode::FAILED_PRECONDITION);
+	ASSERT(toStatus(transaction_too_old()).error_code() == grpc::StatusCode::OUT_OF_RANGE);
+	ASSERT(toStatus(future_version()).error_code() == grpc::StatusCode::UNAVAILABLE);
+	ASSERT(toStatus(process_behind()).error_code() == grpc::StatusCode::UNAVAILABLE);
+	ASSERT(toStatus(io_error()).error_code() == grpc::StatusCode::INTERNAL);
+}
+#endif // FLOW_GRPC_ENABLED
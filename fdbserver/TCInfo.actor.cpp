@@ -450,6 +450,17 @@ Optional<int64_t> TCTeamInfo::getLongestStorageQueueSize() const {
 	return longestQueueSize;
 }
 
+bool TCTeamInfo::hasOverloadedServer() const {
+	for (const auto& server : servers) {
+		auto& stats = server->getStorageStats();
+		if (stats.present() && (stats.get().diskUsage > SERVER_KNOBS->MAX_DEST_DISK_BUSY_PERCENT ||
+		                        stats.get().storageDurabilityLag > SERVER_KNOBS->MAX_DEST_DURABILITY_LAG_VERSIONS)) {
+			return true;
+		}
+	}
+	return false;
+}
+
 Optional<int> TCTeamInfo::getMaxOngoingBulkLoadTaskCount() const {
 	int count = 0;
 	for (const auto& server : servers) {
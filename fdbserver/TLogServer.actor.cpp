@@ -43,10 +43,12 @@
 #include "fdbserver/WaitFailure.h"
 #include "fdbserver/RecoveryState.h"
 #include "fdbserver/FDBExecHelper.actor.h"
+#include "flow/CompressionUtils.h"
 #include "flow/Histogram.h"
 #include "flow/DebugTrace.h"
 #include "flow/genericactors.actor.h"
 #include "flow/network.h"
+#include "flow/ScopeExit.h"
 #include "flow/actorcompiler.h" // This must be the last #include.
 
 struct TLogQueueEntryRef {
@@ -100,14 +102,63 @@ typedef Standalone<TLogQueueEntryRef> TLogQueueEntry;
 struct LogData;
 struct TLogData;
 
+// Values of the valid flag which ends each packet in the TLogQueue
+static constexpr uint8_t TLOG_QUEUE_PACKET_VALID = 0x01;
+// The payload is a CompressionFilter byte followed by the versioned entry compressed with that filter.  Versions which
+// do not know this flag cannot recover a queue containing such packets, so compression must stay off until downgrades
+// to them are no longer needed.
+static constexpr uint8_t TLOG_QUEUE_PACKET_VALID_COMPRESSED = 0x02;
+
+// Returns the versioned entry held by the payload of a queue packet ending in the given valid flag
+static StringRef decodeTLogQueuePayload(StringRef payload, uint8_t validFlag, Arena& arena) {
+	if (validFlag == TLOG_QUEUE_PACKET_VALID_COMPRESSED) {
+		CODE_PROBE(true, "TLog read a compressed queue entry");
+		ASSERT(payload.size() > 1 && payload[0] < (uint8_t)CompressionFilter::LAST);
+		return CompressionUtils::decompress((CompressionFilter)payload[0], payload.substr(1), arena);
+	}
+	ASSERT(validFlag == TLOG_QUEUE_PACKET_VALID);
+	return payload;
+}
+
+// Frames the versioned entry which was written to wr after a uint32_t placeholder for its length as a queue packet.
+// The entry is compressed with filter if it is large enough and compression makes it small enough.
+static Standalone<StringRef> encodeTLogQueuePacket(BinaryWriter& wr, CompressionFilter filter) {
+	const int payloadSize = wr.getLength() - sizeof(uint32_t);
+	if (filter != CompressionFilter::NONE && payloadSize >= SERVER_KNOBS->TLOG_QUEUE_COMPRESSION_MIN_BYTES) {
+		Arena arena;
+		StringRef compressed = CompressionUtils::compress(
+		    filter, StringRef((const uint8_t*)wr.getData() + sizeof(uint32_t), payloadSize), arena);
+		if (compressed.size() + 1 <= payloadSize * SERVER_KNOBS->TLOG_QUEUE_COMPRESSION_MAX_RATIO) {
+			BinaryWriter cwr(Unversioned());
+			cwr << uint32_t(compressed.size() + 1) << uint8_t(filter);
+			cwr.serializeBytes(compressed);
+			cwr << TLOG_QUEUE_PACKET_VALID_COMPRESSED;
+			return cwr.toValue();
+		}
+	}
+	wr << TLOG_QUEUE_PACKET_VALID;
+	*(uint32_t*)wr.getData() = payloadSize;
+	return wr.toValue();
+}
+
 struct TLogQueue final : public IClosable {
 public:
-	TLogQueue(IDiskQueue* queue, UID dbgid) : queue(queue), dbgid(dbgid) {}
+	TLogQueue(IDiskQueue* queue, UID dbgid) : queue(queue), dbgid(dbgid), compressionFilter(CompressionFilter::NONE) {
+		CompressionFilter filter = CompressionUtils::fromFilterString(SERVER_KNOBS->TLOG_QUEUE_COMPRESSION_FILTER);
+		if (CompressionUtils::supportedFilters.contains(filter)) {
+			compressionFilter = filter;
+		} else {
+			TraceEvent(SevWarn, "TLogQueueCompressionDisabled", dbgid)
+			    .detail("Filter", SERVER_KNOBS->TLOG_QUEUE_COMPRESSION_FILTER);
+		}
+	}
 
 	// Each packet in the queue is
 	//    uint32_t payloadSize
 	//    uint8_t payload[payloadSize]  (begins with uint64_t protocolVersion via IncludeVersion)
 	//    uint8_t validFlag
+	// or, for entries which TLOG_QUEUE_COMPRESSION_FILTER made smaller, the payload is the filter followed by the
+	// compressed bytes of the payload above and validFlag is TLOG_QUEUE_PACKET_VALID_COMPRESSED.
 
 	// TLogQueue is a durable queue of TLogQueueEntry objects with an interface similar to IDiskQueue
 
@@ -143,6 +194,7 @@ public:
 private:
 	IDiskQueue* queue;
 	UID dbgid;
+	CompressionFilter compressionFilter;
 
 	void updateVersionSizes(const TLogQueueEntry& result,
 	                        TLogData* tLog,
@@ -178,9 +230,9 @@ private:
 			}
 
 			if (e[payloadSize]) {
-				ASSERT(e[payloadSize] == 1);
 				Arena a = e.arena();
-				ArenaReader ar(a, e.substr(0, payloadSize), IncludeVersion());
+				ArenaReader ar(
+				    a, decodeTLogQueuePayload(e.substr(0, payloadSize), e[payloadSize], a), IncludeVersion());
 				ar >> result;
 				const IDiskQueue::location endloc = self->queue->getNextReadLocation();
 				self->updateVersionSizes(result, tLog, startloc, endloc);
@@ -217,6 +269,7 @@ static const KeyRangeRef persistTxsTagsKeys = KeyRangeRef("TxsTags/"_sr, "TxsTag
 static const KeyRange persistTagMessagesKeys = prefixRange("TagMsg/"_sr);
 static const KeyRange persistTagMessageRefsKeys = prefixRange("TagMsgRef/"_sr);
 static const KeyRange persistTagPoppedKeys = prefixRange("TagPop/"_sr);
+static const KeyRange persistTagCompactedKeys = prefixRange("TagCompact/"_sr);
 
 static const KeyRef persistEncryptionAtRestModeKey = "encryptionAtRestMode"_sr;
 
@@ -246,6 +299,21 @@ static Key persistTagPoppedKey(UID id, Tag tag) {
 	return wr.toValue();
 }
 
+static Key persistTagCompactedKey(UID id, Tag tag) {
+	BinaryWriter wr(Unversioned());
+	wr.serializeBytes(persistTagCompactedKeys.begin);
+	wr << id;
+	wr << tag;
+	return wr.toValue();
+}
+
+static Tag decodeTagCompactedKey(KeyRef id, KeyRef key) {
+	Tag s;
+	BinaryReader rd(key.removePrefix(persistTagCompactedKeys.begin).removePrefix(id), Unversioned());
+	rd >> s;
+	return s;
+}
+
 static Value persistTagPoppedValue(Version popped) {
 	return BinaryWriter::toValue(popped, Unversioned());
 }
@@ -285,6 +353,52 @@ struct SpilledData {
 	uint32_t mutationBytes = 0;
 };
 
+// The offset and length of each message in a commit read back from the disk queue, by each tag of the message.  When
+// data is spilled by reference every tag in a commit peeks the whole commit, so this lets the commit be parsed once
+// rather than once per tag.
+struct SpilledCommitIndex {
+	std::unordered_map<Tag, std::vector<std::pair<uint32_t, uint32_t>>> messages;
+	int64_t bytes = 0;
+};
+
+// The indexes of recently peeked spilled commits of a log generation, by version.  The oldest versions are evicted
+// first, since peeks move forward through the spilled data.
+struct SpilledCommitIndexCache {
+	std::shared_ptr<SpilledCommitIndex> get(Version version) const {
+		auto i = indexes.find(version);
+		return i == indexes.end() ? std::shared_ptr<SpilledCommitIndex>() : i->second;
+	}
+
+	void insert(Version version, std::shared_ptr<SpilledCommitIndex> index) {
+		if (!indexes.emplace(version, index).second) {
+			return;
+		}
+		bytes += index->bytes;
+		while (bytes > SERVER_KNOBS->TLOG_SPILLED_COMMIT_INDEX_BYTES && !indexes.empty()) {
+			bytes -= indexes.begin()->second->bytes;
+			indexes.erase(indexes.begin());
+		}
+	}
+
+	std::map<Version, std::shared_ptr<SpilledCommitIndex>> indexes;
+	int64_t bytes = 0;
+};
+
+// Commits read back from the disk queue for a peek of a tag spilled by reference
+struct SpilledPeekBatch : ReferenceCounted<SpilledPeekBatch> {
+	std::vector<Standalone<StringRef>> packets; // TLogQueue packets of the commits, in version order
+	Version durableVersion = invalidVersion; // Only commits at or before this version were read
+	bool earlyEnd = false; // True if the tag has spilled commits after those read
+	FlowLock::Releaser memoryReservation;
+};
+
+// A batch being read ahead of the peek of a tag which is expected to need it
+struct SpilledPeekReadahead {
+	Version begin;
+	double started;
+	Future<Reference<SpilledPeekBatch>> batch;
+};
+
 struct TLogData : NonCopyable {
 	AsyncTrigger newLogData;
 	// A process has only 1 SharedTLog, which holds data for multiple logs, so that it obeys its assigned memory limit.
@@ -409,6 +523,9 @@ struct LogData : NonCopyable, public ReferenceCounted<LogData> {
 		Version persistentPopped; // The popped version recorded in the btree.
 		Version versionForPoppedLocation; // `poppedLocation` was calculated at this popped version
 		IDiskQueue::location poppedLocation; // The location of the earliest commit with data for this tag.
+		// Spilled messages of a tag spilled by reference up to this version were copied into persistentData by value,
+		// see compactOldGeneration()
+		Version compactedVersion;
 		bool unpoppedRecovered;
 		Tag tag;
 
@@ -419,14 +536,14 @@ struct LogData : NonCopyable, public ReferenceCounted<LogData> {
 		        bool poppedRecently,
 		        bool unpoppedRecovered)
 		  : nothingPersistent(nothingPersistent), poppedRecently(poppedRecently), popped(popped), persistentPopped(0),
-		    versionForPoppedLocation(0), poppedLocation(poppedLocation), unpoppedRecovered(unpoppedRecovered),
-		    tag(tag) {}
+		    versionForPoppedLocation(0), poppedLocation(poppedLocation), compactedVersion(invalidVersion),
+		    unpoppedRecovered(unpoppedRecovered), tag(tag) {}
 
 		TagData(TagData&& r) noexcept
 		  : versionMessages(std::move(r.versionMessages)), nothingPersistent(r.nothingPersistent),
 		    poppedRecently(r.poppedRecently), popped(r.popped), persistentPopped(r.persistentPopped),
 		    versionForPoppedLocation(r.versionForPoppedLocation), poppedLocation(r.poppedLocation),
-		    unpoppedRecovered(r.unpoppedRecovered), tag(r.tag) {}
+		    compactedVersion(r.compactedVersion), unpoppedRecovered(r.unpoppedRecovered), tag(r.tag) {}
 		void operator=(TagData&& r) noexcept {
 			versionMessages = std::move(r.versionMessages);
 			nothingPersistent = r.nothingPersistent;
@@ -435,6 +552,7 @@ struct LogData : NonCopyable, public ReferenceCounted<LogData> {
 			persistentPopped = r.persistentPopped;
 			versionForPoppedLocation = r.versionForPoppedLocation;
 			poppedLocation = r.poppedLocation;
+			compactedVersion = r.compactedVersion;
 			tag = r.tag;
 			unpoppedRecovered = r.unpoppedRecovered;
 		}
@@ -575,8 +693,12 @@ struct LogData : NonCopyable, public ReferenceCounted<LogData> {
 	Counter nonEmptyPeeks;
 	Counter persistentDataUpdateBatches;
 	Counter dirtyTagsProcessed;
+	Counter queueCompressedBytesIn; // Bytes of queue entries which were compressed, before compression
+	Counter queueCompressedBytesOut; // Bytes those entries occupy in the queue
 	std::map<Tag, LatencySample> blockingPeekLatencies;
 	std::map<Tag, LatencySample> peekVersionCounts;
+	std::map<Tag, LatencySample> spilledPeekThroughput; // MB/s at which peeks read each tag's spilled commits
+	std::map<Tag, SpilledPeekReadahead> spilledPeekReadaheads;
 
 	UID logId;
 	ProtocolVersion protocolVersion;
@@ -637,6 +759,7 @@ struct LogData : NonCopyable, public ReferenceCounted<LogData> {
 	Tag remoteTag;
 	bool isPrimary;
 	int logRouterTags;
+	SpilledCommitIndexCache spilledCommitIndexes;
 	Version logRouterPoppedVersion;
 	Version logRouterPopToVersion;
 	int8_t locality;
@@ -668,7 +791,8 @@ struct LogData : NonCopyable, public ReferenceCounted<LogData> {
 	    tagMessageCount("tagMessageCount", cc), bytesDurable("BytesDurable", cc), blockingPeeks("BlockingPeeks", cc),
 	    blockingPeekTimeouts("BlockingPeekTimeouts", cc), emptyPeeks("EmptyPeeks", cc),
 	    nonEmptyPeeks("NonEmptyPeeks", cc), persistentDataUpdateBatches("PersistentDataUpdateBatches", cc),
-	    dirtyTagsProcessed("DirtyTagsProcessed", cc), logId(interf.id()), protocolVersion(protocolVersion),
+	    dirtyTagsProcessed("DirtyTagsProcessed", cc), queueCompressedBytesIn("QueueCompressedBytesIn", cc),
+	    queueCompressedBytesOut("QueueCompressedBytesOut", cc), logId(interf.id()), protocolVersion(protocolVersion),
 	    newPersistentDataVersion(invalidVersion), tLogData(tLogData), unrecoveredBefore(1), recoveredAt(1),
 	    recoveryTxnVersion(1), logSystem(new AsyncVar<Reference<ILogSystem>>()), remoteTag(remoteTag),
 	    isPrimary(isPrimary), logRouterTags(logRouterTags), logRouterPoppedVersion(0), logRouterPopToVersion(0),
@@ -740,6 +864,8 @@ struct LogData : NonCopyable, public ReferenceCounted<LogData> {
 			tLogData->persistentData->clear(KeyRangeRef(msgRefKey, strinc(msgRefKey)));
 			Key poppedKey = logIdKey.withPrefix(persistTagPoppedKeys.begin);
 			tLogData->persistentData->clear(KeyRangeRef(poppedKey, strinc(poppedKey)));
+			Key compactedKey = logIdKey.withPrefix(persistTagCompactedKeys.begin);
+			tLogData->persistentData->clear(KeyRangeRef(compactedKey, strinc(compactedKey)));
 		}
 
 		for (auto it = peekTracker.begin(); it != peekTracker.end(); ++it) {
@@ -767,6 +893,9 @@ struct LogData : NonCopyable, public ReferenceCounted<LogData> {
 
 	bool shouldSpillByReference(Tag t) const { return !shouldSpillByValue(t); }
 
+	// True if all of the spilled messages of a tag spilled by reference are now stored by value
+	bool isCompacted(const TagData& tagData) const { return tagData.compactedVersion >= persistentDataDurableVersion; }
+
 	void unblockWaitingPeeks() {
 		if (SERVER_KNOBS->ENABLE_VERSION_VECTOR) {
 			for (auto& iter : waitingTags) {
@@ -795,11 +924,17 @@ void TLogQueue::push(T const& qe, Reference<LogData> logData) {
 	wr << uint32_t(0);
 	IncludeVersion(ProtocolVersion::withTLogQueueEntryRef()).write(wr); // payload is versioned
 	wr << qe;
-	wr << uint8_t(1);
-	*(uint32_t*)wr.getData() = wr.getLength() - sizeof(uint32_t) - sizeof(uint8_t);
+
+	const int payloadSize = wr.getLength() - sizeof(uint32_t);
+	Standalone<StringRef> packet = encodeTLogQueuePacket(wr, compressionFilter);
+	if (packet.end()[-1] == TLOG_QUEUE_PACKET_VALID_COMPRESSED) {
+		logData->queueCompressedBytesIn += payloadSize;
+		logData->queueCompressedBytesOut += packet.size() - sizeof(uint32_t) - sizeof(uint8_t);
+	}
+
 	const IDiskQueue::location startloc = queue->getNextPushLocation();
 	// FIXME: push shouldn't return anything.  We should call getNextPushLocation() again.
-	const IDiskQueue::location endloc = queue->push(wr.toValue());
+	const IDiskQueue::location endloc = queue->push(packet);
 	//TraceEvent("TLogQueueVersionWritten", dbgid).detail("Size", wr.getLength() - sizeof(uint32_t) - sizeof(uint8_t)).detail("Loc", loc);
 	logData->versionLocation[qe.version] = std::make_pair(startloc, endloc);
 }
@@ -896,6 +1031,10 @@ void updatePersistentPopped(TLogData* self, Reference<LogData> logData, Referenc
 	} else {
 		self->persistentData->clear(KeyRangeRef(persistTagMessageRefsKey(logData->logId, data->tag, Version(0)),
 		                                        persistTagMessageRefsKey(logData->logId, data->tag, data->popped)));
+		if (data->compactedVersion != invalidVersion) {
+			self->persistentData->clear(KeyRangeRef(persistTagMessagesKey(logData->logId, data->tag, Version(0)),
+			                                        persistTagMessagesKey(logData->logId, data->tag, data->popped)));
+		}
 	}
 
 	if (data->popped > logData->persistentDataVersion) {
@@ -905,7 +1044,7 @@ void updatePersistentPopped(TLogData* self, Reference<LogData> logData, Referenc
 
 ACTOR Future<Void> updatePoppedLocation(TLogData* self, Reference<LogData> logData, Reference<LogData::TagData> data) {
 	// For anything spilled by value, we do not need to track its popped location.
-	if (logData->shouldSpillByValue(data->tag)) {
+	if (logData->shouldSpillByValue(data->tag) || logData->isCompacted(*data)) {
 		return Void();
 	}
 
@@ -988,7 +1127,7 @@ ACTOR Future<Void> popDiskQueue(TLogData* self, Reference<LogData> logData) {
 	for (int tagLocality = 0; tagLocality < logData->tag_data.size(); tagLocality++) {
 		for (int tagId = 0; tagId < logData->tag_data[tagLocality].size(); tagId++) {
 			Reference<LogData::TagData> tagData = logData->tag_data[tagLocality][tagId];
-			if (tagData && logData->shouldSpillByReference(tagData->tag)) {
+			if (tagData && logData->shouldSpillByReference(tagData->tag) && !logData->isCompacted(*tagData)) {
 				if (!tagData->nothingPersistent) {
 					minLocation = std::min(minLocation, tagData->poppedLocation);
 					minVersion = std::min(minVersion, tagData->popped);
@@ -1016,6 +1155,79 @@ ACTOR Future<Void> popDiskQueue(TLogData* self, Reference<LogData> logData) {
 	return Void();
 }
 
+typedef Deque<std::pair<Version, Standalone<VectorRef<uint8_t>>>> MessageBlocks;
+
+// Starts the block that a commit of msgSize bytes is copied into, sharing the arena of the last block if there is one,
+// and returns the bytes charged to bytesInput for it
+static int64_t beginMessageBlock(const MessageBlocks& messageBlocks,
+                                 Standalone<VectorRef<uint8_t>>& block,
+                                 int msgSize) {
+	int64_t addedBytes = 0;
+	// We pop all of the elements of the last block to create a "fresh" vector that starts at its end
+	if (messageBlocks.empty()) {
+		block = Standalone<VectorRef<uint8_t>>();
+		block.reserve(block.arena(), std::max<int64_t>(SERVER_KNOBS->TLOG_MESSAGE_BLOCK_BYTES, msgSize));
+		if (SERVER_KNOBS->TLOG_EXACT_MESSAGE_BLOCK_ACCOUNTING) {
+			addedBytes += block.capacity();
+		}
+	} else {
+		block = messageBlocks.back().second;
+	}
+	block.pop_front(block.size());
+	return addedBytes;
+}
+
+// Copies message into block, first moving block to messageBlocks and reserving a new one when it is full.  msgSize is
+// the size of the remaining messages of the commit.  Returns the bytes charged to bytesInput.
+static int64_t appendMessageBlock(MessageBlocks& messageBlocks,
+                                  Standalone<VectorRef<uint8_t>>& block,
+                                  Version version,
+                                  StringRef message,
+                                  int msgSize) {
+	int64_t addedBytes = 0;
+	if (message.size() > block.capacity() - block.size()) {
+		messageBlocks.emplace_back(version, block);
+		block = Standalone<VectorRef<uint8_t>>();
+		block.reserve(block.arena(), std::max<int64_t>(SERVER_KNOBS->TLOG_MESSAGE_BLOCK_BYTES, msgSize));
+		if (SERVER_KNOBS->TLOG_EXACT_MESSAGE_BLOCK_ACCOUNTING) {
+			addedBytes += block.capacity();
+		} else {
+			addedBytes +=
+			    int64_t(messageBlocks.back().second.size()) * SERVER_KNOBS->TLOG_MESSAGE_BLOCK_OVERHEAD_FACTOR;
+		}
+	}
+	block.append(block.arena(), message.begin(), message.size());
+	return addedBytes;
+}
+
+// Moves the last block of a commit to messageBlocks and returns the bytes charged to bytesInput
+static int64_t endMessageBlock(MessageBlocks& messageBlocks,
+                               const Standalone<VectorRef<uint8_t>>& block,
+                               Version version) {
+	messageBlocks.emplace_back(version, block);
+	if (SERVER_KNOBS->TLOG_EXACT_MESSAGE_BLOCK_ACCOUNTING) {
+		return 0;
+	}
+	return int64_t(block.size()) * SERVER_KNOBS->TLOG_MESSAGE_BLOCK_OVERHEAD_FACTOR;
+}
+
+// Pops the first of messageBlocks and returns the bytes credited to bytesDurable, which sum to the bytes charged to
+// bytesInput once all of the blocks are popped
+static int64_t popMessageBlock(MessageBlocks& messageBlocks) {
+	int64_t bytesErased;
+	const auto& block = messageBlocks.front().second;
+	if (SERVER_KNOBS->TLOG_EXACT_MESSAGE_BLOCK_ACCOUNTING) {
+		// The blocks sharing an arena are contiguous, so the arena is released with the last of them, which also
+		// accounts for the unused space at its end
+		bool lastInArena = messageBlocks.size() == 1 || messageBlocks[1].second.begin() != block.end();
+		bytesErased = lastInArena ? block.capacity() : block.size();
+	} else {
+		bytesErased = int64_t(block.size()) * SERVER_KNOBS->TLOG_MESSAGE_BLOCK_OVERHEAD_FACTOR;
+	}
+	messageBlocks.pop_front();
+	return bytesErased;
+}
+
 ACTOR Future<Void> updatePersistentData(TLogData* self, Reference<LogData> logData, Version newPersistentDataVersion) {
 	state BinaryWriter wr(Unversioned());
 	// PERSIST: Changes self->persistentDataVersion and writes and commits the relevant changes
@@ -1182,11 +1394,9 @@ ACTOR Future<Void> updatePersistentData(TLogData* self, Reference<LogData> logDa
 	wait(yield(TaskPriority::UpdateStorage));
 
 	while (!logData->messageBlocks.empty() && logData->messageBlocks.front().first <= newPersistentDataVersion) {
-		int64_t bytesErased =
-		    int64_t(logData->messageBlocks.front().second.size()) * SERVER_KNOBS->TLOG_MESSAGE_BLOCK_OVERHEAD_FACTOR;
+		int64_t bytesErased = popMessageBlock(logData->messageBlocks);
 		logData->bytesDurable += bytesErased;
 		self->bytesDurable += bytesErased;
-		logData->messageBlocks.pop_front();
 		wait(yield(TaskPriority::UpdateStorage));
 	}
 
@@ -1261,6 +1471,12 @@ ACTOR Future<Void> tLogPopCore(TLogData* self, Tag inputTag, Version to, Referen
 		tagData->popped = upTo;
 		tagData->poppedRecently = true;
 
+		// The tag will not be peeked from before where it was popped, so a batch read ahead from there is not needed
+		auto readahead = logData->spilledPeekReadaheads.find(tag);
+		if (readahead != logData->spilledPeekReadaheads.end() && readahead->second.begin < upTo) {
+			logData->spilledPeekReadaheads.erase(readahead);
+		}
+
 		if (tagData->unpoppedRecovered) {
 			// Check for `tag`, if earlier generations are no longer needed. This is by comparing the `upTo` value with
 			// start version of the second earliest generation. If `upTo` > secondEarliestGenStartVersion, the earliest
@@ -1370,6 +1586,8 @@ ACTOR Future<Void> tLogPop(TLogData* self, TLogPopRequest req, Reference<LogData
 	return Void();
 }
 
+ACTOR Future<Void> compactOldGeneration(TLogData* self, Reference<LogData> logData);
+
 // This function (and updatePersistentData, which is called by this function) run at a low priority and can soak up all
 // CPU resources. For this reason, they employ aggressive use of yields to avoid causing slow tasks that could introduce
 // latencies for more important work (e.g. commits).
@@ -1476,6 +1694,10 @@ ACTOR Future<Void> updateStorage(TLogData* self) {
 			if (self->popOrder.size()) {
 				wait(popDiskQueue(self, self->id_data[self->popOrder.front()]));
 			}
+			if (SERVER_KNOBS->TLOG_OLD_GENERATION_COMPACTION_BYTES > 0 && self->popOrder.size() &&
+			    self->popOrder.front() != logData->logId) {
+				wait(compactOldGeneration(self, self->id_data[self->popOrder.front()]));
+			}
 			commitLockReleaser.release();
 		}
 
@@ -1527,28 +1749,13 @@ void commitMessages(TLogData* self,
 	}
 
 	// Grab the last block in the blocks list so we can share its arena
-	// We pop all of the elements of it to create a "fresh" vector that starts at the end of the previous vector
 	Standalone<VectorRef<uint8_t>> block;
-	if (logData->messageBlocks.empty()) {
-		block = Standalone<VectorRef<uint8_t>>();
-		block.reserve(block.arena(), std::max<int64_t>(SERVER_KNOBS->TLOG_MESSAGE_BLOCK_BYTES, msgSize));
-	} else {
-		block = logData->messageBlocks.back().second;
-	}
-
-	block.pop_front(block.size());
+	addedBytes += beginMessageBlock(logData->messageBlocks, block, msgSize);
 
 	for (auto& msg : taggedMessages) {
-		if (msg.message.size() > block.capacity() - block.size()) {
-			logData->messageBlocks.emplace_back(version, block);
-			addedBytes += int64_t(block.size()) * SERVER_KNOBS->TLOG_MESSAGE_BLOCK_OVERHEAD_FACTOR;
-			block = Standalone<VectorRef<uint8_t>>();
-			block.reserve(block.arena(), std::max<int64_t>(SERVER_KNOBS->TLOG_MESSAGE_BLOCK_BYTES, msgSize));
-		}
-
 		DEBUG_TAGS_AND_MESSAGE("TLogCommitMessages", version, msg.getRawMessage(), logData->logId)
 		    .detail("DebugID", self->dbgid);
-		block.append(block.arena(), msg.message.begin(), msg.message.size());
+		addedBytes += appendMessageBlock(logData->messageBlocks, block, version, msg.message, msgSize);
 		for (auto tag : msg.tags) {
 			if (logData->locality == tagLocalitySatellite) {
 				if (!(tag.locality == tagLocalityTxs || tag.locality == tagLocalityLogRouter || tag == txsTag)) {
@@ -1609,8 +1816,7 @@ void commitMessages(TLogData* self,
 
 		msgSize -= msg.message.size();
 	}
-	logData->messageBlocks.emplace_back(version, block);
-	addedBytes += int64_t(block.size()) * SERVER_KNOBS->TLOG_MESSAGE_BLOCK_OVERHEAD_FACTOR;
+	addedBytes += endMessageBlock(logData->messageBlocks, block, version);
 	addedBytes += overheadBytes;
 
 	logData->version_sizes[version] = std::make_pair(expectedBytes, txsBytes);
@@ -1754,6 +1960,381 @@ ACTOR Future<std::vector<StringRef>> parseMessagesForTag(StringRef commitBlob, T
 	return relevantMessages;
 }
 
+ACTOR Future<std::shared_ptr<SpilledCommitIndex>> indexCommitBlob(StringRef commitBlob) {
+	state std::shared_ptr<SpilledCommitIndex> index = std::make_shared<SpilledCommitIndex>();
+	state BinaryReader rd(commitBlob, AssumeVersion(g_network->protocolVersion()));
+	while (!rd.empty()) {
+		TagsAndMessage tagsAndMessage;
+		tagsAndMessage.loadFromArena(&rd, nullptr);
+		StringRef message = tagsAndMessage.getRawMessage();
+		uint32_t offset = message.begin() - commitBlob.begin();
+		for (Tag t : tagsAndMessage.tags) {
+			auto& offsets = index->messages[t];
+			if (offsets.empty() || offsets.back().first != offset) {
+				offsets.emplace_back(offset, message.size());
+			}
+		}
+		index->bytes += tagsAndMessage.tags.size() * sizeof(std::pair<uint32_t, uint32_t>);
+		wait(yield());
+	}
+	index->bytes += index->messages.size() * (sizeof(Tag) + sizeof(std::vector<std::pair<uint32_t, uint32_t>>) + 32);
+	return index;
+}
+
+// Returns the same messages as parseMessagesForTag(), using the index of the commit
+std::vector<StringRef> messagesForTag(SpilledCommitIndex const& index, StringRef commitBlob, Tag tag, int logRouters) {
+	std::vector<std::pair<uint32_t, uint32_t>> found;
+	if (tag.locality == tagLocalityLogRouter) {
+		// As in parseMessagesForTag(), log router tags are modded down to the number of log routers which now exist
+		for (auto const& [t, offsets] : index.messages) {
+			if (t.locality == tagLocalityLogRouter && t.id % logRouters == tag.id) {
+				found.insert(found.end(), offsets.begin(), offsets.end());
+			}
+		}
+		std::sort(found.begin(), found.end());
+		found.resize(std::unique(found.begin(), found.end()) - found.begin());
+	} else {
+		auto i = index.messages.find(tag);
+		if (i != index.messages.end()) {
+			found = i->second;
+		}
+	}
+
+	std::vector<StringRef> messages;
+	messages.reserve(found.size());
+	for (auto const& [offset, length] : found) {
+		messages.push_back(commitBlob.substr(offset, length));
+	}
+	return messages;
+}
+
+ACTOR Future<std::vector<StringRef>> spilledMessagesForTag(Reference<LogData> logData,
+                                                           Version version,
+                                                           StringRef commitBlob,
+                                                           Tag tag) {
+	if (SERVER_KNOBS->TLOG_SPILLED_COMMIT_INDEX_BYTES <= 0) {
+		std::vector<StringRef> messages = wait(parseMessagesForTag(commitBlob, tag, logData->logRouterTags));
+		return messages;
+	}
+	state std::shared_ptr<SpilledCommitIndex> index = logData->spilledCommitIndexes.get(version);
+	if (!index) {
+		std::shared_ptr<SpilledCommitIndex> built = wait(indexCommitBlob(commitBlob));
+		index = built;
+		logData->spilledCommitIndexes.insert(version, index);
+	}
+	return messagesForTag(*index, commitBlob, tag, logData->logRouterTags);
+}
+
+// Reads the commits containing tag from begin up to the persistent data durable version, limited by
+// TLOG_SPILL_REFERENCE_MAX_BATCHES_PER_PEEK and DESIRED_TOTAL_BYTES.  Commits which are adjacent in the disk queue are
+// read together, so that a tag catching up through a long run of spilled commits is read at disk bandwidth rather than
+// one commit at a time.
+ACTOR Future<Reference<SpilledPeekBatch>> readSpilledPeekBatch(TLogData* self,
+                                                               Reference<LogData> logData,
+                                                               Tag tag,
+                                                               Version begin) {
+	state Reference<SpilledPeekBatch> batch = makeReference<SpilledPeekBatch>();
+	state double startTime = now();
+	batch->durableVersion = logData->persistentDataDurableVersion;
+
+	// FIXME: Limit to approximately DESIRED_TOTATL_BYTES somehow.
+	RangeResult kvrefs = wait(self->persistentData->readRange(
+	    KeyRangeRef(persistTagMessageRefsKey(logData->logId, tag, begin),
+	                persistTagMessageRefsKey(logData->logId, tag, batch->durableVersion + 1)),
+	    SERVER_KNOBS->TLOG_SPILL_REFERENCE_MAX_BATCHES_PER_PEEK + 1));
+
+	state std::vector<std::pair<IDiskQueue::location, IDiskQueue::location>> commitLocations;
+	uint32_t mutationBytes = 0;
+	state uint64_t commitBytes = 0;
+	for (int i = 0; i < kvrefs.size() && i < SERVER_KNOBS->TLOG_SPILL_REFERENCE_MAX_BATCHES_PER_PEEK; i++) {
+		auto& kv = kvrefs[i];
+		VectorRef<SpilledData> spilledData;
+		BinaryReader r(kv.value, AssumeVersion(logData->protocolVersion));
+		r >> spilledData;
+		for (const SpilledData& sd : spilledData) {
+			if (mutationBytes >= SERVER_KNOBS->DESIRED_TOTAL_BYTES) {
+				batch->earlyEnd = true;
+				break;
+			}
+			if (sd.version >= begin) {
+				const IDiskQueue::location end = sd.start.lo + sd.length;
+				commitLocations.emplace_back(sd.start, end);
+				// This isn't perfect, because we aren't accounting for page boundaries, but should be
+				// close enough.
+				commitBytes += sd.length;
+				mutationBytes += sd.mutationBytes;
+			}
+		}
+		if (batch->earlyEnd)
+			break;
+	}
+	batch->earlyEnd =
+	    batch->earlyEnd || (kvrefs.size() >= SERVER_KNOBS->TLOG_SPILL_REFERENCE_MAX_BATCHES_PER_PEEK + 1);
+	wait(self->peekMemoryLimiter.take(TaskPriority::TLogSpilledPeekReply, commitBytes));
+	batch->memoryReservation = FlowLock::Releaser(self->peekMemoryLimiter, commitBytes);
+
+	state std::vector<Future<Standalone<StringRef>>> reads;
+	for (int i = 0; i < commitLocations.size();) {
+		const IDiskQueue::location start = commitLocations[i].first;
+		IDiskQueue::location end = commitLocations[i].second;
+		for (++i; i < commitLocations.size() && commitLocations[i].first == end &&
+		          commitLocations[i].second.lo - start.lo <= SERVER_KNOBS->TLOG_SPILL_REFERENCE_MAX_READ_BYTES;
+		     ++i) {
+			end = commitLocations[i].second;
+		}
+		reads.push_back(self->rawPersistentQueue->read(start, end, CheckHashes::True));
+	}
+	wait(waitForAll(reads));
+
+	// Split the reads back into the packets of each commit
+	int64_t bytesRead = 0;
+	batch->packets.reserve(commitLocations.size());
+	for (const auto& read : reads) {
+		Standalone<StringRef> data = read.get();
+		bytesRead += data.size();
+		while (!data.empty()) {
+			const uint32_t length = *(uint32_t*)data.begin();
+			const int packetSize = sizeof(uint32_t) + length + sizeof(uint8_t);
+			ASSERT(packetSize <= data.size());
+			batch->packets.emplace_back(data.substr(0, packetSize), data.arena());
+			data.contents() = data.substr(packetSize);
+		}
+	}
+	ASSERT_EQ(batch->packets.size(), commitLocations.size());
+
+	const double elapsed = now() - startTime;
+	if (bytesRead > 0 && elapsed > 0) {
+		auto [it, _] = logData->spilledPeekThroughput.try_emplace(tag,
+		                                                          "SpilledPeekMBps-" + tag.toString(),
+		                                                          nondeterministicRandom()->randomUniqueID(),
+		                                                          SERVER_KNOBS->LATENCY_METRICS_LOGGING_INTERVAL,
+		                                                          SERVER_KNOBS->LATENCY_SKETCH_ACCURACY);
+		it->second.addMeasurement(bytesRead / elapsed / 1e6);
+	}
+	return batch;
+}
+
+TEST_CASE("/fdbserver/tlogserver/queuePacketCompression") {
+	for (CompressionFilter filter : CompressionUtils::supportedFilters) {
+		BinaryWriter wr(Unversioned());
+		wr << uint32_t(0);
+		IncludeVersion(ProtocolVersion::withTLogQueueEntryRef()).write(wr);
+		std::string messages(deterministicRandom()->randomInt(4096, 100000), 'm');
+		wr.serializeBytes(messages);
+		const std::string payload((const char*)wr.getData() + sizeof(uint32_t), wr.getLength() - sizeof(uint32_t));
+
+		Standalone<StringRef> packet = encodeTLogQueuePacket(wr, filter);
+		const uint32_t length = *(uint32_t*)packet.begin();
+		ASSERT_EQ(length + sizeof(uint32_t) + sizeof(uint8_t), packet.size());
+		const uint8_t valid = packet.end()[-1];
+		ASSERT_EQ(valid,
+		          filter == CompressionFilter::NONE ? TLOG_QUEUE_PACKET_VALID : TLOG_QUEUE_PACKET_VALID_COMPRESSED);
+
+		Arena arena;
+		StringRef decoded = decodeTLogQueuePayload(packet.substr(sizeof(uint32_t), length), valid, arena);
+		ASSERT(decoded == StringRef(payload));
+	}
+	return Void();
+}
+
+TEST_CASE("/fdbserver/tlogserver/spilledCommitIndex") {
+	state Standalone<StringRef> blob;
+	{
+		BinaryWriter wr(Unversioned());
+		auto addMessage = [&wr](std::vector<Tag> const& tags, StringRef payload) {
+			int32_t length = TagsAndMessage::getHeaderSize(tags.size()) - sizeof(int32_t) + payload.size();
+			wr << length << uint32_t(1) << uint16_t(tags.size());
+			for (const Tag& t : tags) {
+				wr.serializeBytes(&t, sizeof(Tag));
+			}
+			wr.serializeBytes(payload);
+		};
+		addMessage({ Tag(0, 1), Tag(0, 2) }, "a"_sr);
+		addMessage({ Tag(tagLocalityLogRouter, 5) }, "b"_sr);
+		addMessage({ Tag(0, 2), Tag(tagLocalityLogRouter, 1) }, "c"_sr);
+		addMessage({ Tag(tagLocalityLogRouter, 3), Tag(tagLocalityLogRouter, 1) }, "d"_sr);
+		blob = wr.toValue();
+	}
+
+	state std::shared_ptr<SpilledCommitIndex> index = wait(indexCommitBlob(blob));
+	state std::vector<Tag> tags = {
+		Tag(0, 1), Tag(0, 2), Tag(0, 3), Tag(tagLocalityLogRouter, 0), Tag(tagLocalityLogRouter, 1)
+	};
+	state int i = 0;
+	for (; i < tags.size(); i++) {
+		std::vector<StringRef> expected = wait(parseMessagesForTag(blob, tags[i], 2));
+		ASSERT(messagesForTag(*index, blob, tags[i], 2) == expected);
+	}
+	// Every log router tag maps to log router 1, and a message is returned once even if it has several such tags
+	ASSERT_EQ(messagesForTag(*index, blob, Tag(tagLocalityLogRouter, 1), 2).size(), 3);
+	return Void();
+}
+
+TEST_CASE("/fdbserver/tlogserver/tagCompactedKey") {
+	UID logId = deterministicRandom()->randomUniqueID();
+	Tag tag(deterministicRandom()->randomInt(-2, 3), deterministicRandom()->randomInt(0, 100));
+	Key key = persistTagCompactedKey(logId, tag);
+	ASSERT(persistTagCompactedKeys.contains(key));
+	ASSERT(decodeTagCompactedKey(BinaryWriter::toValue(logId, Unversioned()), key) == tag);
+	return Void();
+}
+
+TEST_CASE("/fdbserver/tlogserver/messageBlockAccounting") {
+	ScopeExit restoreKnobs([exact = SERVER_KNOBS->TLOG_EXACT_MESSAGE_BLOCK_ACCOUNTING,
+	                        blockBytes = SERVER_KNOBS->TLOG_MESSAGE_BLOCK_BYTES]() {
+		IKnobCollection::getMutableGlobalKnobCollection().setKnob("tlog_exact_message_block_accounting",
+		                                                          KnobValueRef::create(bool{ exact }));
+		IKnobCollection::getMutableGlobalKnobCollection().setKnob("tlog_message_block_bytes",
+		                                                          KnobValueRef::create(int64_t{ blockBytes }));
+	});
+	bool exact = deterministicRandom()->coinflip();
+	IKnobCollection::getMutableGlobalKnobCollection().setKnob("tlog_exact_message_block_accounting",
+	                                                          KnobValueRef::create(bool{ exact }));
+	IKnobCollection::getMutableGlobalKnobCollection().setKnob("tlog_message_block_bytes",
+	                                                          KnobValueRef::create(int64_t{ 1000 }));
+
+	MessageBlocks messageBlocks;
+	int64_t bytesInput = 0;
+	int64_t bytesDurable = 0;
+	for (Version version = 1; version <= 1000; version++) {
+		std::vector<std::string> messages(deterministicRandom()->randomInt(1, 10));
+		int msgSize = 0;
+		for (auto& message : messages) {
+			message = std::string(deterministicRandom()->randomInt(1, 1500), 'x');
+			msgSize += message.size();
+		}
+		Standalone<VectorRef<uint8_t>> block;
+		bytesInput += beginMessageBlock(messageBlocks, block, msgSize);
+		for (const auto& message : messages) {
+			bytesInput += appendMessageBlock(messageBlocks, block, version, StringRef(message), msgSize);
+			ASSERT(block.size() >= message.size() &&
+			       StringRef(block.end() - message.size(), message.size()) == StringRef(message));
+			msgSize -= message.size();
+		}
+		bytesInput += endMessageBlock(messageBlocks, block, version);
+
+		// Pop the blocks of some of the versions committed so far, as updatePersistentData does
+		Version popVersion = deterministicRandom()->randomInt64(0, version + 1);
+		while (!messageBlocks.empty() && messageBlocks.front().first <= popVersion) {
+			bytesDurable += popMessageBlock(messageBlocks);
+		}
+		ASSERT_LE(bytesDurable, bytesInput);
+	}
+	while (!messageBlocks.empty()) {
+		bytesDurable += popMessageBlock(messageBlocks);
+	}
+	ASSERT_EQ(bytesDurable, bytesInput);
+	return Void();
+}
+
+// Copies the next batch of a tag's commits spilled by reference into persistentData by value, and returns the version
+// through which the tag has then been copied.  The references are cleared once all of them have been copied.
+ACTOR Future<Version> compactSpilledTag(TLogData* self,
+                                        Reference<LogData> logData,
+                                        Reference<LogData::TagData> tagData,
+                                        int64_t* compactedBytes) {
+	state Version compactedVersion = tagData->compactedVersion;
+	state Reference<SpilledPeekBatch> batch = wait(readSpilledPeekBatch(
+	    self, logData, tagData->tag, std::max(tagData->persistentPopped, tagData->compactedVersion + 1)));
+	state int index = 0;
+	for (; index < batch->packets.size(); index++) {
+		StringRef queueEntryData = batch->packets[index];
+		const uint32_t length = *(uint32_t*)queueEntryData.begin();
+		queueEntryData = queueEntryData.substr(4, queueEntryData.size() - 4);
+		ASSERT(length + sizeof(uint8_t) == queueEntryData.size());
+		const uint8_t valid = queueEntryData[length];
+		Arena decoded;
+		BinaryReader rd(decodeTLogQueuePayload(queueEntryData.substr(0, length), valid, decoded), IncludeVersion());
+		state TLogQueueEntry entry;
+		rd >> entry;
+		entry.arena().dependsOn(decoded);
+
+		std::vector<StringRef> rawMessages =
+		    wait(spilledMessagesForTag(logData, entry.version, entry.messages, tagData->tag));
+		BinaryWriter wr(Unversioned());
+		for (const StringRef& msg : rawMessages) {
+			wr.serializeBytes(msg);
+		}
+		self->persistentData->set(
+		    KeyValueRef(persistTagMessagesKey(logData->logId, tagData->tag, entry.version), wr.toValue()));
+		*compactedBytes += wr.getLength();
+		compactedVersion = entry.version;
+	}
+	if (!batch->earlyEnd) {
+		compactedVersion = batch->durableVersion;
+		self->persistentData->clear(
+		    KeyRangeRef(persistTagMessageRefsKey(logData->logId, tagData->tag, Version(0)),
+		                persistTagMessageRefsKey(logData->logId, tagData->tag, compactedVersion + 1)));
+	}
+	self->persistentData->set(KeyValueRef(persistTagCompactedKey(logData->logId, tagData->tag),
+	                                      BinaryWriter::toValue(compactedVersion, Unversioned())));
+	return compactedVersion;
+}
+
+// A stopped generation is kept on disk until every tag has popped all of its data, and since its spilled commits are
+// referenced from the disk queue, a single lagging tag keeps the queue from being popped past it for every newer
+// generation as well.  Once the queue data kept for the oldest generation exceeds TLOG_OLD_GENERATION_COMPACTION_BYTES,
+// pops received since it was spilled are applied to persistentData, and the remaining tags' spilled commits are copied
+// into persistentData by value so that the disk queue can be popped without them.
+ACTOR Future<Void> compactOldGeneration(TLogData* self, Reference<LogData> logData) {
+	if (!logData->stopped() || !logData->initialized || logData->removed.isReady() ||
+	    logData->persistentDataDurableVersion != logData->version.get()) {
+		return Void();
+	}
+
+	state std::vector<Reference<LogData::TagData>> tags;
+	state Optional<IDiskQueue::location> minLocation;
+	for (const auto& tagDataByLocality : logData->tag_data) {
+		for (const auto& tagData : tagDataByLocality) {
+			if (tagData && logData->shouldSpillByReference(tagData->tag) && !logData->isCompacted(*tagData) &&
+			    !tagData->nothingPersistent) {
+				tags.push_back(tagData);
+				if (!minLocation.present() || tagData->poppedLocation < minLocation.get()) {
+					minLocation = tagData->poppedLocation;
+				}
+			}
+		}
+	}
+	if (!minLocation.present() || self->rawPersistentQueue->getNextPushLocation().lo - minLocation.get().lo <
+	                                  SERVER_KNOBS->TLOG_OLD_GENERATION_COMPACTION_BYTES) {
+		return Void();
+	}
+
+	// Tags holding the earliest data are copied first, so that the queue can be popped as soon as possible
+	std::sort(
+	    tags.begin(), tags.end(), [](const auto& a, const auto& b) { return a->poppedLocation < b->poppedLocation; });
+
+	state std::vector<std::pair<Reference<LogData::TagData>, Version>> compacted;
+	state int64_t compactedBytes = 0;
+	state int i = 0;
+	for (; i < tags.size() && compactedBytes < SERVER_KNOBS->REFERENCE_SPILL_UPDATE_STORAGE_BYTE_LIMIT; i++) {
+		state Reference<LogData::TagData> tagData = tags[i];
+		if (tagData->poppedRecently) {
+			updatePersistentPopped(self, logData, tagData);
+		}
+		if (tagData->nothingPersistent) {
+			continue;
+		}
+		Version compactedVersion = wait(compactSpilledTag(self, logData, tagData, &compactedBytes));
+		compacted.emplace_back(tagData, compactedVersion);
+		wait(yield(TaskPriority::UpdateStorage));
+	}
+
+	wait(ioTimeoutError(self->persistentData->commit(), SERVER_KNOBS->TLOG_MAX_CREATE_DURATION, "TLogCommit"));
+
+	for (auto& [compactedTag, compactedVersion] : compacted) {
+		compactedTag->compactedVersion = compactedVersion;
+		if (logData->isCompacted(*compactedTag)) {
+			logData->spilledPeekReadaheads.erase(compactedTag->tag);
+		}
+	}
+	CODE_PROBE(!compacted.empty(), "TLog copied old generation spilled data by value");
+	TraceEvent("TLogCompactedOldGeneration", logData->logId)
+	    .detail("Tags", compacted.size())
+	    .detail("MinLocation", minLocation.get().lo);
+	return Void();
+}
+
 // Common logics to peek TLog and create TLogPeekReply that serves both streaming peek or normal peek request
 ACTOR template <typename PromiseType>
 Future<Void> tLogPeekMessages(PromiseType replyPromise,
@@ -1837,6 +2418,13 @@ Future<Void> tLogPeekMessages(PromiseType replyPromise,
 
 	state double blockStart = now();
 
+	// A batch read ahead for the tag is only of use to a peek beginning where it does, so once the tag is peeked from
+	// anywhere else it is dropped, which releases its peek memory
+	auto staleReadahead = logData->spilledPeekReadaheads.find(reqTag);
+	if (staleReadahead != logData->spilledPeekReadaheads.end() && staleReadahead->second.begin != reqBegin) {
+		logData->spilledPeekReadaheads.erase(staleReadahead);
+	}
+
 	// We need to return data that the caller doesn't already have.
 	// If the requested version is beyond what the tLog currently has, we'll wait for new data.
 	// However, there's a catch:
@@ -2005,11 +2593,18 @@ Future<Void> tLogPeekMessages(PromiseType replyPromise,
 				peekMessagesFromMemory(logData, reqTag, reqBegin, messages2, endVersion);
 			}
 
-			if (logData->shouldSpillByValue(reqTag)) {
+			// Data spilled by reference may have been copied by value up to some version, see compactOldGeneration()
+			state Version valueEndVersion = logData->persistentDataDurableVersion;
+			if (logData->shouldSpillByReference(reqTag)) {
+				auto tagData = logData->getTagData(reqTag);
+				valueEndVersion = tagData ? std::min(valueEndVersion, tagData->compactedVersion) : invalidVersion;
+			}
+			state bool valuesEndEarly = valueEndVersion < logData->persistentDataDurableVersion;
+
+			if (reqBegin <= valueEndVersion) {
 				RangeResult kvs = wait(self->persistentData->readRange(
-				    KeyRangeRef(
-				        persistTagMessagesKey(logData->logId, reqTag, reqBegin),
-				        persistTagMessagesKey(logData->logId, reqTag, logData->persistentDataDurableVersion + 1)),
+				    KeyRangeRef(persistTagMessagesKey(logData->logId, reqTag, reqBegin),
+				                persistTagMessagesKey(logData->logId, reqTag, valueEndVersion + 1)),
 				    SERVER_KNOBS->DESIRED_TOTAL_BYTES,
 				    SERVER_KNOBS->DESIRED_TOTAL_BYTES));
 
@@ -2022,77 +2617,50 @@ Future<Void> tLogPeekMessages(PromiseType replyPromise,
 				if (kvs.expectedSize() >= SERVER_KNOBS->DESIRED_TOTAL_BYTES) {
 					endVersion = decodeTagMessagesKey(kvs.end()[-1].key) + 1;
 					onlySpilled = true;
+				} else if (valuesEndEarly) {
+					CODE_PROBE(true, "TLog peek read old generation data copied by value before references");
+					endVersion = valueEndVersion + 1;
+					onlySpilled = true;
 				} else {
 					messages.serializeBytes(messages2.toValue());
 				}
 			} else {
-				// FIXME: Limit to approximately DESIRED_TOTATL_BYTES somehow.
-				RangeResult kvrefs = wait(self->persistentData->readRange(
-				    KeyRangeRef(
-				        persistTagMessageRefsKey(logData->logId, reqTag, reqBegin),
-				        persistTagMessageRefsKey(logData->logId, reqTag, logData->persistentDataDurableVersion + 1)),
-				    SERVER_KNOBS->TLOG_SPILL_REFERENCE_MAX_BATCHES_PER_PEEK + 1));
-
-				//TraceEvent("TLogPeekResults", self->dbgid).detail("ForAddress", replyPromise.getEndpoint().getPrimaryAddress()).detail("Tag1Results", s1).detail("Tag2Results", s2).detail("Tag1ResultsLim", kv1.size()).detail("Tag2ResultsLim", kv2.size()).detail("Tag1ResultsLast", kv1.size() ? kv1[0].key : "").detail("Tag2ResultsLast", kv2.size() ? kv2[0].key : "").detail("Limited", limited).detail("NextEpoch", next_pos.epoch).detail("NextSeq", next_pos.sequence).detail("NowEpoch", self->epoch()).detail("NowSeq", self->sequence.getNextSequence());
-
-				state std::vector<std::pair<IDiskQueue::location, IDiskQueue::location>> commitLocations;
-				state bool earlyEnd = false;
-				uint32_t mutationBytes = 0;
-				state uint64_t commitBytes = 0;
-				state Version firstVersion = std::numeric_limits<Version>::max();
-				for (int i = 0; i < kvrefs.size() && i < SERVER_KNOBS->TLOG_SPILL_REFERENCE_MAX_BATCHES_PER_PEEK; i++) {
-					auto& kv = kvrefs[i];
-					VectorRef<SpilledData> spilledData;
-					BinaryReader r(kv.value, AssumeVersion(logData->protocolVersion));
-					r >> spilledData;
-					for (const SpilledData& sd : spilledData) {
-						if (mutationBytes >= SERVER_KNOBS->DESIRED_TOTAL_BYTES) {
-							earlyEnd = true;
-							break;
-						}
-						if (sd.version >= reqBegin) {
-							firstVersion = std::min(firstVersion, sd.version);
-							const IDiskQueue::location end = sd.start.lo + sd.length;
-							commitLocations.emplace_back(sd.start, end);
-							// This isn't perfect, because we aren't accounting for page boundaries, but should be
-							// close enough.
-							commitBytes += sd.length;
-							mutationBytes += sd.mutationBytes;
-						}
+				state Version memoryDurableVersion = logData->persistentDataDurableVersion;
+				state Reference<SpilledPeekBatch> batch;
+				auto readahead = logData->spilledPeekReadaheads.find(reqTag);
+				if (readahead != logData->spilledPeekReadaheads.end() && readahead->second.begin == reqBegin) {
+					CODE_PROBE(true, "TLog spilled peek served by readahead");
+					Future<Reference<SpilledPeekBatch>> readaheadBatch = readahead->second.batch;
+					logData->spilledPeekReadaheads.erase(readahead);
+					wait(store(batch, readaheadBatch));
+				} else {
+					if (readahead != logData->spilledPeekReadaheads.end()) {
+						logData->spilledPeekReadaheads.erase(readahead);
 					}
-					if (earlyEnd)
-						break;
-				}
-				earlyEnd = earlyEnd || (kvrefs.size() >= SERVER_KNOBS->TLOG_SPILL_REFERENCE_MAX_BATCHES_PER_PEEK + 1);
-				wait(self->peekMemoryLimiter.take(TaskPriority::TLogSpilledPeekReply, commitBytes));
-				state FlowLock::Releaser memoryReservation(self->peekMemoryLimiter, commitBytes);
-				state std::vector<Future<Standalone<StringRef>>> messageReads;
-				messageReads.reserve(commitLocations.size());
-				for (const auto& pair : commitLocations) {
-					messageReads.push_back(self->rawPersistentQueue->read(pair.first, pair.second, CheckHashes::True));
+					wait(store(batch, readSpilledPeekBatch(self, logData, reqTag, reqBegin)));
 				}
-				commitLocations.clear();
-				wait(waitForAll(messageReads));
 
 				state Version lastRefMessageVersion = 0;
 				state int index = 0;
 				loop {
-					if (index >= messageReads.size())
+					if (index >= batch->packets.size())
 						break;
-					Standalone<StringRef> queueEntryData = messageReads[index].get();
-					uint8_t valid;
+					StringRef queueEntryData = batch->packets[index];
 					const uint32_t length = *(uint32_t*)queueEntryData.begin();
 					queueEntryData = queueEntryData.substr(4, queueEntryData.size() - 4);
-					BinaryReader rd(queueEntryData, IncludeVersion());
+					ASSERT(length + sizeof(uint8_t) == queueEntryData.size());
+					const uint8_t valid = queueEntryData[length];
+					Arena decoded;
+					BinaryReader rd(decodeTLogQueuePayload(queueEntryData.substr(0, length), valid, decoded),
+					                IncludeVersion());
 					state TLogQueueEntry entry;
-					rd >> entry >> valid;
-					ASSERT(valid == 0x01);
-					ASSERT(length + sizeof(valid) == queueEntryData.size());
+					rd >> entry;
+					entry.arena().dependsOn(decoded);
 
 					messages << VERSION_HEADER << entry.version;
 
 					std::vector<StringRef> rawMessages =
-					    wait(parseMessagesForTag(entry.messages, reqTag, logData->logRouterTags));
+					    wait(spilledMessagesForTag(logData, entry.version, entry.messages, reqTag));
 					for (const StringRef& msg : rawMessages) {
 						messages.serializeBytes(msg);
 						DEBUG_TAGS_AND_MESSAGE("TLogPeekFromDisk", entry.version, msg, logData->logId)
@@ -2104,12 +2672,26 @@ Future<Void> tLogPeekMessages(PromiseType replyPromise,
 					index++;
 				}
 
-				messageReads.clear();
-				memoryReservation.release();
+				const bool earlyEnd = batch->earlyEnd;
+				const Version batchDurableVersion = batch->durableVersion;
+				batch.clear();
+
+				// The next peek of the tag will begin after this one, so read its commits while this reply is sent
+				if (earlyEnd && lastRefMessageVersion >= reqBegin && SERVER_KNOBS->TLOG_SPILL_REFERENCE_READAHEAD) {
+					logData->spilledPeekReadaheads[reqTag] = SpilledPeekReadahead{
+						lastRefMessageVersion + 1,
+						now(),
+						readSpilledPeekBatch(self, logData, reqTag, lastRefMessageVersion + 1)
+					};
+				}
 
 				if (earlyEnd) {
 					endVersion = lastRefMessageVersion + 1;
 					onlySpilled = true;
+				} else if (batchDurableVersion < memoryDurableVersion) {
+					// A batch read ahead may end before data which was spilled since, and which is no longer in memory
+					endVersion = batchDurableVersion + 1;
+					onlySpilled = true;
 				} else {
 					messages.serializeBytes(messages2.toValue());
 				}
@@ -2221,6 +2803,7 @@ ACTOR Future<Void> tLogPeekStream(TLogData* self, TLogPeekStreamRequest req, Ref
 
 	state Version begin = req.begin;
 	state bool onlySpilled = false;
+	state TaskPriority taskID = g_network->getCurrentTask();
 	req.reply.setByteLimit(std::min(SERVER_KNOBS->MAXIMUM_PEEK_BYTES, req.limitBytes));
 	loop {
 		state TLogPeekStreamReply reply;
@@ -2243,7 +2826,11 @@ ACTOR Future<Void> tLogPeekStream(TLogData* self, TLogPeekStreamRequest req, Ref
 			req.reply.send(reply);
 			begin = reply.rep.end;
 			onlySpilled = reply.rep.onlySpilled;
-			if (reply.rep.end > logData->version.get()) {
+			if (reply.rep.end > logData->version.get() && !logData->stopped()) {
+				// Push the next commit as soon as it arrives rather than polling for it
+				wait(logData->version.whenAtLeast(reply.rep.end) || logData->stoppedPromise.getFuture());
+				wait(delay(SERVER_KNOBS->TLOG_PEEK_STREAM_DELAY, taskID));
+			} else if (reply.rep.end > logData->version.get()) {
 				wait(delay(SERVER_KNOBS->TLOG_PEEK_DELAY, g_network->getCurrentTask()));
 			} else {
 				wait(delay(0, g_network->getCurrentTask()));
@@ -2717,6 +3304,19 @@ ACTOR Future<Void> cleanupPeekTrackers(LogData* logData) {
 			}
 		}
 
+		// Drop batches read ahead for tags which have stopped peeking altogether, to release their peek memory
+		auto readahead = logData->spilledPeekReadaheads.begin();
+		while (readahead != logData->spilledPeekReadaheads.end()) {
+			double timeUntilExpiration =
+			    readahead->second.started + SERVER_KNOBS->PEEK_TRACKER_EXPIRATION_TIME - now();
+			if (timeUntilExpiration < 1.0e-6) {
+				readahead = logData->spilledPeekReadaheads.erase(readahead);
+			} else {
+				minTimeUntilExpiration = std::min(minTimeUntilExpiration, timeUntilExpiration);
+				++readahead;
+			}
+		}
+
 		wait(delay(minTimeUntilExpiration));
 	}
 }
@@ -3409,6 +4009,26 @@ ACTOR Future<Void> restorePersistentState(TLogData* self,
 				logData->getTagData(tag)->persistentPopped = popped;
 			}
 		}
+
+		tagKeys = prefixRange(rawId.withPrefix(persistTagCompactedKeys.begin));
+		loop {
+			if (logData->removed.isReady())
+				break;
+			RangeResult data = wait(self->persistentData->readRange(tagKeys, BUGGIFY ? 3 : 1 << 30, 1 << 20));
+			if (!data.size())
+				break;
+			((KeyRangeRef&)tagKeys) = KeyRangeRef(keyAfter(data.back().key, tagKeys.arena()), tagKeys.end);
+
+			for (auto& kv : data) {
+				Tag tag = decodeTagCompactedKey(rawId, kv.key);
+				auto tagData = logData->getTagData(tag);
+				if (!tagData) {
+					tagData = logData->createTagData(tag, 0, false, false, false);
+				}
+				tagData->compactedVersion = BinaryReader::fromStringRef<Version>(kv.value, Unversioned());
+				CODE_PROBE(true, "TLog recovered a tag of an old generation copied by value");
+			}
+		}
 	}
 
 	std::sort(logsByVersion.begin(), logsByVersion.end());
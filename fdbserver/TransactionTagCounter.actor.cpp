@@ -25,19 +25,31 @@
 #include "flow/actorcompiler.h"
 
 class TransactionTagCounterImpl {
+	// The cost counted for a tag, of which up to error may have been incurred by the tags it replaced
+	struct TagCost {
+		double cost;
+		double error;
+	};
+
 	UID thisServerID;
-	TransactionTagMap<double> intervalCosts;
+	TransactionTagMap<TagCost> intervalCosts;
+	// The counted tags ordered by cost, which is only kept once maxTagsCounted tags are counted in an interval
+	std::set<std::pair<double, TransactionTagRef>> tagsByCost;
 	double intervalTotalCost = 0;
 	double intervalStart = 0;
 	int maxTagsTracked;
 	double minRateTracked;
+	int maxTagsCounted;
 
 	std::vector<BusyTagInfo> previousBusiestTags;
 	Reference<EventCacheHolder> busiestReadTagEventHolder;
 
 	std::vector<BusyTagInfo> getBusiestTagsFromLastInterval(double elapsed) const {
 		std::priority_queue<BusyTagInfo, std::vector<BusyTagInfo>, std::greater<BusyTagInfo>> topKTags;
-		for (auto const& [tag, cost] : intervalCosts) {
+		for (auto const& [tag, tagCost] : intervalCosts) {
+			// Only the part of the cost which certainly belongs to the tag is used, so that a tag which replaced a
+			// busier one is not throttled in its place
+			auto const cost = tagCost.cost - tagCost.error;
 			auto const rate = cost / elapsed;
 			auto const fractionalBusyness = std::min(1.0, cost / intervalTotalCost);
 			if (rate < minRateTracked) {
@@ -58,17 +70,49 @@ class TransactionTagCounterImpl {
 	}
 
 public:
-	TransactionTagCounterImpl(UID thisServerID, int maxTagsTracked, double minRateTracked)
+	TransactionTagCounterImpl(UID thisServerID, int maxTagsTracked, double minRateTracked, int maxTagsCounted)
 	  : thisServerID(thisServerID), maxTagsTracked(maxTagsTracked), minRateTracked(minRateTracked),
+	    maxTagsCounted(maxTagsCounted),
 	    busiestReadTagEventHolder(makeReference<EventCacheHolder>(thisServerID.toString() + "/BusiestReadTag")) {}
 
+	void addTagCost(TransactionTagRef tag, Arena const& arena, double cost) {
+		auto it = intervalCosts.find(TransactionTag(tag, arena));
+		if (it != intervalCosts.end()) {
+			if (!tagsByCost.empty()) {
+				tagsByCost.erase(std::make_pair(it->second.cost, TransactionTagRef(it->first)));
+				tagsByCost.emplace(it->second.cost + cost, it->first);
+			}
+			it->second.cost += cost;
+			return;
+		}
+
+		// Copy the tag rather than keeping the request's arena alive for the rest of the interval
+		if (maxTagsCounted <= 0 || intervalCosts.size() < maxTagsCounted) {
+			intervalCosts.emplace(TransactionTag(tag), TagCost{ cost, 0 });
+			return;
+		}
+
+		CODE_PROBE(true, "TransactionTagCounter replacing the least busy tag");
+		if (tagsByCost.empty()) {
+			for (auto const& [countedTag, tagCost] : intervalCosts) {
+				tagsByCost.emplace(tagCost.cost, countedTag);
+			}
+		}
+		double minCost = tagsByCost.begin()->first;
+		TransactionTag minTag = tagsByCost.begin()->second;
+		tagsByCost.erase(tagsByCost.begin());
+		intervalCosts.erase(minTag);
+		it = intervalCosts.emplace(TransactionTag(tag), TagCost{ minCost + cost, minCost }).first;
+		tagsByCost.emplace(it->second.cost, it->first);
+	}
+
 	void addRequest(Optional<TagSet> const& tags, int64_t bytes) {
 		auto const cost = getReadOperationCost(bytes);
 		intervalTotalCost += cost;
 		if (tags.present()) {
 			for (auto const& tag : tags.get()) {
 				CODE_PROBE(true, "Tracking transaction tag in TransactionTagCounter");
-				intervalCosts[TransactionTag(tag, tags.get().getArena())] += cost / CLIENT_KNOBS->READ_TAG_SAMPLE_RATE;
+				addTagCost(tag, tags.get().getArena(), cost / CLIENT_KNOBS->READ_TAG_SAMPLE_RATE);
 			}
 		}
 	}
@@ -105,6 +149,7 @@ public:
 		}
 
 		intervalCosts.clear();
+		tagsByCost.clear();
 		intervalTotalCost = 0;
 		intervalStart = now();
 	}
@@ -112,8 +157,11 @@ public:
 	std::vector<BusyTagInfo> const& getBusiestTags() const { return previousBusiestTags; }
 };
 
-TransactionTagCounter::TransactionTagCounter(UID thisServerID, int maxTagsTracked, double minRateTracked)
-  : impl(PImpl<TransactionTagCounterImpl>::create(thisServerID, maxTagsTracked, minRateTracked)) {}
+TransactionTagCounter::TransactionTagCounter(UID thisServerID,
+                                             int maxTagsTracked,
+                                             double minRateTracked,
+                                             int maxTagsCounted)
+  : impl(PImpl<TransactionTagCounterImpl>::create(thisServerID, maxTagsTracked, minRateTracked, maxTagsCounted)) {}
 
 TransactionTagCounter::~TransactionTagCounter() = default;
 
@@ -183,3 +231,29 @@ TEST_CASE("/fdbserver/TransactionTagCounter/IgnoreBelowMinRate") {
 	}
 	return Void();
 }
+
+TEST_CASE("/fdbserver/TransactionTagCounter/BoundedTagCount") {
+	state TransactionTagCounter counter(UID(),
+	                                    /*maxTagsTracked=*/2,
+	                                    /*minRateTracked=*/10.0 * CLIENT_KNOBS->TAG_THROTTLING_PAGE_SIZE /
+	                                        CLIENT_KNOBS->READ_TAG_SAMPLE_RATE,
+	                                    /*maxTagsCounted=*/3);
+	counter.startNewInterval();
+	{
+		wait(delay(1.0));
+		counter.addRequest(getTagSet("tagA"_sr), 30 * CLIENT_KNOBS->TAG_THROTTLING_PAGE_SIZE);
+		counter.addRequest(getTagSet("tagB"_sr), 40 * CLIENT_KNOBS->TAG_THROTTLING_PAGE_SIZE);
+		// Small tags only replace each other in the last slot, since tags with more than a third of the total cost
+		// are always counted
+		for (int i = 0; i < 10; ++i) {
+			counter.addRequest(getTagSet(StringRef(format("small%d", i))), CLIENT_KNOBS->TAG_THROTTLING_PAGE_SIZE);
+		}
+		counter.addRequest(getTagSet("tagA"_sr), 10 * CLIENT_KNOBS->TAG_THROTTLING_PAGE_SIZE);
+		counter.startNewInterval();
+		auto const busiestTags = counter.getBusiestTags();
+		ASSERT_EQ(busiestTags.size(), 2);
+		ASSERT(containsTag(busiestTags, "tagA"_sr));
+		ASSERT(containsTag(busiestTags, "tagB"_sr));
+	}
+	return Void();
+}
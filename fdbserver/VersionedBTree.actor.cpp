@@ -24,6 +24,7 @@
 #include "fdbclient/RandomKeyValueUtils.h"
 #include "fdbclient/Tuple.h"
 #include "fdbrpc/DDSketch.h"
+#include "fdbrpc/PageCacheBudget.h"
 #include "fdbrpc/simulator.h"
 #include "fdbserver/DeltaTree.h"
 #include "fdbserver/IKeyValueStore.h"
@@ -33,6 +34,7 @@
 #include "fdbserver/VersionedBTreeDebug.h"
 #include "fdbserver/WorkerInterface.actor.h"
 #include "flow/ActorCollection.h"
+#include "flow/CompressionUtils.h"
 #include "flow/Error.h"
 #include "flow/FastRef.h"
 #include "flow/flow.h"
@@ -40,9 +42,11 @@
 #include "flow/Histogram.h"
 #include "flow/IAsyncFile.h"
 #include "flow/IRandom.h"
+#include "flow/IRateControl.h"
 #include "flow/Knobs.h"
 #include "flow/ObjectSerializer.h"
 #include "flow/PriorityMultiLock.actor.h"
+#include "flow/ScopeExit.h"
 #include "flow/network.h"
 #include "flow/serialize.h"
 #include "flow/Trace.h"
@@ -51,8 +55,10 @@
 
 #include <boost/intrusive/list.hpp>
 #include <cinttypes>
+#include <functional>
 #include <limits>
 #include <map>
+#include <optional>
 #include <random>
 #include <string>
 #include <unordered_map>
@@ -495,7 +501,7 @@ public:
 			debug_printf(
 			    "FIFOQueue::Cursor(%s) loadPage start id=%s\n", toString().c_str(), ::toString(nextPageID).c_str());
 			nextPageReader = queue->pager->readPage(
-			    PagerEventReasons::MetaData, nonBtreeLevel, nextPageID, ioMaxPriority, true, false);
+			    PagerEventReasons::MetaData, nonBtreeLevel, nextPageID, ioMaxPriority, true, false, false);
 			if (!nextPageReader.isReady()) {
 				nextPageReader = waitOrError(nextPageReader, queue->pagerError);
 			}
@@ -1446,6 +1452,7 @@ struct RedwoodMetrics {
 		unsigned int opClear;
 		unsigned int opClearKey;
 		unsigned int opCommit;
+		unsigned int lazyClearFreedPages;
 		unsigned int opGet;
 		unsigned int opGetRange;
 		unsigned int pagerDiskWrite;
@@ -1453,17 +1460,28 @@ struct RedwoodMetrics {
 		unsigned int pagerRemapFree;
 		unsigned int pagerRemapCopy;
 		unsigned int pagerRemapSkip;
+		unsigned int pagerRemapPaced;
 		unsigned int pagerCacheHit;
 		unsigned int pagerCacheMiss;
 		unsigned int pagerProbeHit;
 		unsigned int pagerProbeMiss;
 		unsigned int pagerEvictUnhit;
 		unsigned int pagerEvictFail;
+		unsigned int pagerCachePromote;
+		unsigned int pagerCompressedHit;
+		unsigned int pagerCompressedAdmit;
+		unsigned int pagerCompressedReject;
 		unsigned int btreeLeafPreload;
 		unsigned int btreeLeafPreloadExt;
 		unsigned int readRequestDecryptTimeNS;
 	};
 
+	// Current sizes rather than counts of events, so clear() leaves them alone between reporting intervals.
+	struct gauges {
+		unsigned int lazyClearBacklog;
+		unsigned int pagerRemapBacklog;
+	};
+
 	RedwoodMetrics() {
 		// All histograms have reset their buckets to 0 in the constructor.
 		kvSizeWritten = Reference<Histogram>(
@@ -1474,6 +1492,7 @@ struct RedwoodMetrics {
 		    new Histogram(Reference<HistogramRegistry>(), "kvSize", "ReadByGetRange", Histogram::Unit::bytes));
 
 		ioLock = nullptr;
+		gauge = {};
 
 		// These histograms are used for Btree events, hence level > 0
 		unsigned int levelCounter = 0;
@@ -1517,6 +1536,7 @@ struct RedwoodMetrics {
 	// btree levels and one extra level for non btree level.
 	Level levels[btreeLevels + 1];
 	metrics metric;
+	gauges gauge;
 	// pointer to the priority multi lock used in pager
 	PriorityMultiLock* ioLock;
 
@@ -1636,55 +1656,93 @@ class ObjectCache : NonCopyable {
 	typedef std::unordered_map<IndexType, Entry> CacheT;
 
 	struct Entry : public boost::intrusive::list_base_hook<> {
-		Entry() : hits(0), size(0) {}
+		Entry() : hits(0), size(0), isProtected(false) {}
 		IndexType index;
 		ObjectType item;
 		int hits;
 		int size;
 		bool ownedByEvictor;
-		CacheT* pCache;
+		// True if the entry is in the Evictor's protected order rather than its probationary order
+		bool isProtected;
+		ObjectCache* pCache;
 	};
 
 	typedef boost::intrusive::list<Entry> EvictionOrderT;
 
 public:
 	// Object evictor, manages the eviction order for one or more ObjectCaches
-	// Not all objects tracked by the Evictor are in its evictionOrder, as ObjectCaches
+	// Not all objects tracked by the Evictor are in its eviction orders, as ObjectCaches
 	// using this Evictor can temporarily remove entries to an external order but they
 	// must eventually give them back with moveIn() or remove them with reclaim().
+	//
+	// Eviction is segmented in the style of 2Q.  New entries enter the probationary order and are only promoted
+	// to the protected order when they are hit again by a non-scan access.  Eviction always takes from the
+	// probationary order first, and the protected order is limited to protectedFraction of sizeLimit by demoting
+	// its oldest entries back to probation, so a large scan can only displace other entries that were never reused.
+	// A protectedFraction of 0 disables promotion, which makes the eviction order plain LRU.
 	class Evictor : NonCopyable {
 	public:
-		Evictor(int64_t sizeLimit = 0) : sizeLimit(sizeLimit) {}
+		// If budget is given then the evictor also keeps the combined size of itself and the other page caches
+		// sharing the budget within the budget's limit.
+		Evictor(int64_t sizeLimit = 0, PageCacheBudget* budget = nullptr)
+		  : sizeLimit(sizeLimit), protectedFraction(SERVER_KNOBS->REDWOOD_PAGE_CACHE_PROTECTED_FRACTION),
+		    budget(budget) {
+			if (budget != nullptr) {
+				budgetConsumer.bytesUsed = [this]() { return getSizeUsed(); };
+				budgetConsumer.trimTo = [this](int64_t target) { evictTo(target - reservedSize); };
+				budget->add(&budgetConsumer);
+			}
+		}
+
+		~Evictor() {
+			if (budget != nullptr) {
+				budget->remove(&budgetConsumer);
+			}
+		}
 
 		// Evictors are normally singletons, either one per real process or one per virtual process in simulation
 		static Evictor* getEvictor() {
-			static Evictor nonSimEvictor;
-			static std::map<NetworkAddress, Evictor> simEvictors;
-
 			if (g_network->isSimulated()) {
-				return &simEvictors[g_network->getLocalAddress()];
-			} else {
-				return &nonSimEvictor;
+				static std::map<NetworkAddress, Evictor> simEvictors;
+				return &simEvictors.try_emplace(g_network->getLocalAddress(), 0, PageCacheBudget::get()).first->second;
 			}
+			static Evictor nonSimEvictor(0, PageCacheBudget::get());
+			return &nonSimEvictor;
 		}
 
 		// Move an entry to a different eviction order, stored outside of the Evictor,
 		// but the entry size is still counted against the evictor
 		void moveOut(Entry& e, EvictionOrderT& dest) {
 			ASSERT(e.ownedByEvictor);
-			dest.splice(dest.end(), evictionOrder, EvictionOrderT::s_iterator_to(e));
+			dest.splice(dest.end(), orderOf(e), EvictionOrderT::s_iterator_to(e));
+			if (e.isProtected) {
+				protectedSize -= e.size;
+				e.isProtected = false;
+			}
 			e.ownedByEvictor = false;
 			++movedOutCount;
 		}
 
-		// Move an entry to the back of the eviction order if it is in the eviction order
-		void moveToBack(Entry& e) {
+		// Record a hit on an entry in the eviction orders.  Protected entries move to the back of the protected
+		// order.  Probationary entries are promoted to the protected order unless the access is part of a scan,
+		// in which case they only move to the back of the probationary order.
+		void moveToBack(Entry& e, bool scan = false) {
 			ASSERT(e.ownedByEvictor);
-			evictionOrder.splice(evictionOrder.end(), evictionOrder, EvictionOrderT::s_iterator_to(e));
+			if (e.isProtected) {
+				protectedOrder.splice(protectedOrder.end(), protectedOrder, EvictionOrderT::s_iterator_to(e));
+			} else if (!scan && protectedFraction > 0) {
+				protectedOrder.splice(protectedOrder.end(), evictionOrder, EvictionOrderT::s_iterator_to(e));
+				e.isProtected = true;
+				protectedSize += e.size;
+				++g_redwoodMetrics.metric.pagerCachePromote;
+				demoteExcessProtected();
+			} else {
+				evictionOrder.splice(evictionOrder.end(), evictionOrder, EvictionOrderT::s_iterator_to(e));
+			}
 		}
 
 		// Move entire contents of an external eviction order containing entries whose size is part of
-		// this Evictor to the front of its eviction order.
+		// this Evictor to the front of its probationary eviction order.
 		void moveIn(EvictionOrderT& otherOrder) {
 			for (auto& e : otherOrder) {
 				ASSERT(!e.ownedByEvictor);
@@ -1694,20 +1752,25 @@ public:
 			evictionOrder.splice(evictionOrder.begin(), otherOrder);
 		}
 
-		// Add a new item to the back of the eviction order
+		// Add a new item to the back of the probationary eviction order
 		void addNew(Entry& e) {
 			sizeUsed += e.size;
 			evictionOrder.push_back(e);
 			e.ownedByEvictor = true;
+			e.isProtected = false;
 		}
 
 		// Claim ownership of an entry, removing its size from the current size and removing it
 		// from the eviction order if it exists there
 		void reclaim(Entry& e) {
 			sizeUsed -= e.size;
-			// If e is in evictionOrder then remove it
+			// If e is in one of the eviction orders then remove it
 			if (e.ownedByEvictor) {
-				evictionOrder.erase(EvictionOrderT::s_iterator_to(e));
+				orderOf(e).erase(EvictionOrderT::s_iterator_to(e));
+				if (e.isProtected) {
+					protectedSize -= e.size;
+					e.isProtected = false;
+				}
 				e.ownedByEvictor = false;
 			} else {
 				// Otherwise, it wasn't so it had to be a movedOut item so decrement the count
@@ -1716,59 +1779,77 @@ public:
 		}
 
 		void trim(int additionalSpaceNeeded = 0) {
+			if (budget != nullptr) {
+				budget->makeRoom(&budgetConsumer, additionalSpaceNeeded);
+			}
+			evictTo(sizeLimit - reservedSize - additionalSpaceNeeded);
+		}
+
+		// While the cache entries are larger than target, evict the oldest entry until the oldest entry can't be
+		// evicted.  Probationary entries are always evicted before protected ones.
+		void evictTo(int64_t target) {
 			int attemptsLeft = FLOW_KNOBS->MAX_EVICT_ATTEMPTS;
-			// While the cache is too big, evict the oldest entry until the oldest entry can't be evicted.
-			while (attemptsLeft-- > 0 && sizeUsed > (sizeLimit - reservedSize - additionalSpaceNeeded) &&
-			       !evictionOrder.empty()) {
-				Entry& toEvict = evictionOrder.front();
+			while (attemptsLeft-- > 0 && sizeUsed > target &&
+			       (!evictionOrder.empty() || !protectedOrder.empty())) {
+				EvictionOrderT& order = evictionOrder.empty() ? protectedOrder : evictionOrder;
+				Entry& toEvict = order.front();
 
 				debug_printf("Evictor count=%d sizeUsed=%" PRId64 " sizeLimit=%" PRId64 " sizePenalty=%" PRId64
-				             " needed=%d  Trying to evict %s evictable %d\n",
-				             (int)evictionOrder.size(),
+				             " target=%" PRId64 "  Trying to evict %s protected %d evictable %d\n",
+				             (int)(evictionOrder.size() + protectedOrder.size()),
 				             sizeUsed,
 				             sizeLimit,
 				             reservedSize,
-				             additionalSpaceNeeded,
+				             target,
 				             ::toString(toEvict.index).c_str(),
+				             toEvict.isProtected,
 				             toEvict.item.evictable());
 
 				if (!toEvict.item.evictable()) {
 					// shift the front to the back
-					evictionOrder.shift_forward(1);
+					order.shift_forward(1);
 					++g_redwoodMetrics.metric.pagerEvictFail;
 					break;
 				} else {
 					if (toEvict.hits == 0) {
 						++g_redwoodMetrics.metric.pagerEvictUnhit;
 					}
+					if (toEvict.isProtected) {
+						protectedSize -= toEvict.size;
+					}
 					sizeUsed -= toEvict.size;
 					debug_printf("Evicting %s\n", ::toString(toEvict.index).c_str());
-					evictionOrder.pop_front();
-					toEvict.pCache->erase(toEvict.index);
+					order.pop_front();
+					toEvict.pCache->evict(toEvict);
 				}
 			}
 		}
 
-		int64_t getCountUsed() const { return evictionOrder.size() + movedOutCount; }
+		int64_t getCountUsed() const { return evictionOrder.size() + protectedOrder.size() + movedOutCount; }
 		int64_t getCountMoved() const { return movedOutCount; }
 		int64_t getSizeUsed() const { return sizeUsed + reservedSize; }
+		int64_t getSizeProtected() const { return protectedSize; }
 
 		// Only to be used in tests at a point where all ObjectCache instances should be destroyed.
 		bool empty() const { return reservedSize == 0 && sizeUsed == 0 && getCountUsed() == 0; }
 
 		std::string toString() const {
 			std::string s = format("Evictor {sizeLimit=%" PRId64 " sizeUsed=%" PRId64 " countUsed=%" PRId64
-			                       " sizePenalty=%" PRId64 " movedOutCount=%" PRId64,
+			                       " sizePenalty=%" PRId64 " movedOutCount=%" PRId64 " protectedSize=%" PRId64,
 			                       sizeLimit,
 			                       sizeUsed,
 			                       getCountUsed(),
 			                       reservedSize,
-			                       movedOutCount);
-			for (auto& entry : evictionOrder) {
-				s += format("\n\tindex %s  size %d  evictable %d\n",
-				            ::toString(entry.index).c_str(),
-				            entry.size,
-				            entry.item.evictable());
+			                       movedOutCount,
+			                       protectedSize);
+			for (auto* order : { &evictionOrder, &protectedOrder }) {
+				for (auto& entry : *order) {
+					s += format("\n\tindex %s  size %d  protected %d  evictable %d\n",
+					            ::toString(entry.index).c_str(),
+					            entry.size,
+					            entry.isProtected,
+					            entry.item.evictable());
+				}
 			}
 			s += "}\n";
 			return s;
@@ -1778,11 +1859,35 @@ public:
 		// budget should add their usage to this total and keep it updated.
 		int64_t reservedSize = 0;
 		int64_t sizeLimit;
+		// Fraction of sizeLimit that entries which have been hit more than once may occupy
+		double protectedFraction;
+		// Memory budget shared with other page caches in the process, if any
+		PageCacheBudget* budget;
+		PageCacheBudget::Consumer budgetConsumer;
 
 	private:
+		EvictionOrderT& orderOf(const Entry& e) { return e.isProtected ? protectedOrder : evictionOrder; }
+
+		// Demote the oldest protected entries to the back of the probationary order until the
+		// protected order fits within its share of the size limit.
+		void demoteExcessProtected() {
+			const int64_t protectedLimit = (sizeLimit - reservedSize) * protectedFraction;
+			while (protectedSize > protectedLimit && !protectedOrder.empty()) {
+				Entry& e = protectedOrder.front();
+				evictionOrder.splice(evictionOrder.end(), protectedOrder, protectedOrder.begin());
+				e.isProtected = false;
+				protectedSize -= e.size;
+			}
+		}
+
+		// Probationary order, the next entry to evict is at the front
 		EvictionOrderT evictionOrder;
-		// Size of all entries in the eviction order or held in external eviction orders
+		// Entries that have been hit since they were added, only evicted when the probationary order is empty
+		EvictionOrderT protectedOrder;
+		// Size of all entries in the eviction orders or held in external eviction orders
 		int64_t sizeUsed = 0;
+		// Size of all entries in protectedOrder
+		int64_t protectedSize = 0;
 		// Number of items that have been moveOut()'d to other evictionOrders and aren't back yet
 		int64_t movedOutCount = 0;
 	};
@@ -1810,6 +1915,24 @@ public:
 		return nullptr;
 	}
 
+	// Remove the object for index from the cache if it exists, returning true if it did.
+	// The object must be evictable and is dropped without calling onEvict.
+	bool remove(const IndexType& index) {
+		auto i = cache.find(index);
+		if (i == cache.end()) {
+			return false;
+		}
+		Entry& entry = i->second;
+		ASSERT(entry.item.evictable());
+		bool prioritized = !entry.ownedByEvictor;
+		pEvictor->reclaim(entry);
+		if (prioritized) {
+			prioritizedEvictions.erase(EvictionOrderT::s_iterator_to(entry));
+		}
+		cache.erase(i);
+		return true;
+	}
+
 	// If index is in cache and not on the prioritized eviction order list, move it there.
 	void prioritizeEviction(const IndexType& index) {
 		auto i = cache.find(index);
@@ -1819,10 +1942,11 @@ public:
 	}
 
 	// Get the object for i or create a new one.
-	// After a get(), the object for i is the last in evictionOrder.
+	// After a get(), the object for i is the last in its eviction order.
 	// If noHit is set, do not consider this access to be cache hit if the object is present
 	// If noMiss is set, do not consider this access to be a cache miss if the object is not present
-	ObjectType& get(const IndexType& index, int size, bool noHit = false) {
+	// If scan is set, a hit will not promote the object out of the evictor's probationary order
+	ObjectType& get(const IndexType& index, int size, bool noHit = false, bool scan = false) {
 		Entry& entry = cache[index];
 
 		// If entry is linked into an evictionOrder
@@ -1832,7 +1956,7 @@ public:
 				++entry.hits;
 				// If item eviction is not prioritized, move to end of eviction order
 				if (entry.ownedByEvictor) {
-					pEvictor->moveToBack(entry);
+					pEvictor->moveToBack(entry, scan);
 				}
 			}
 		} else {
@@ -1840,7 +1964,7 @@ public:
 
 			// Finish initializing entry
 			entry.index = index;
-			entry.pCache = &cache;
+			entry.pCache = this;
 			entry.hits = 0;
 			entry.size = size;
 
@@ -1877,7 +2001,17 @@ public:
 	// Move the prioritized evictions queued to the front of the eviction order
 	void flushPrioritizedEvictions() { pEvictor->moveIn(prioritizedEvictions); }
 
+	// If set, called with each object just before the Evictor evicts it
+	std::function<void(const IndexType&, const ObjectType&)> onEvict;
+
 private:
+	void evict(Entry& e) {
+		if (onEvict) {
+			onEvict(e.index, e.item);
+		}
+		cache.erase(e.index);
+	}
+
 	Evictor* pEvictor;
 	CacheT cache;
 	EvictionOrderT prioritizedEvictions;
@@ -1917,6 +2051,8 @@ public:
 	struct PageCacheEntry {
 		Future<Reference<ArenaPage>> readFuture;
 		Future<Void> writeFuture;
+		// Whether the page may be kept in the compressed page cache once it is evicted
+		bool compressible = false;
 
 		bool initialized() const { return readFuture.isValid(); }
 
@@ -1942,8 +2078,20 @@ public:
 	};
 	typedef ObjectCache<LogicalPageID, PageCacheEntry> PageCacheT;
 
+	// A compressed copy of the on-disk bytes of a page which was evicted from the page cache
+	struct CompressedPageEntry {
+		Standalone<StringRef> data;
+
+		bool evictable() const { return true; }
+		Future<Void> onEvictable() const { return Void(); }
+		Future<Void> cancel() const { return Void(); }
+	};
+	typedef ObjectCache<PhysicalPageID, CompressedPageEntry> CompressedPageCacheT;
+
 	int64_t* getPageCachePenaltySource() override { return &pageCache.evictor().reservedSize; }
 
+	int getIOWaitersCount() const override { return ioLock->getWaitersCount(); }
+
 	constexpr static PhysicalPageID primaryHeaderPageID = 0;
 	constexpr static PhysicalPageID backupHeaderPageID = 1;
 
@@ -2026,9 +2174,31 @@ public:
 	    filename(filename), memoryOnly(memoryOnly), remapCleanupWindowBytes(remapCleanupWindowBytes),
 	    concurrentExtentReads(new FlowLock(concurrentExtentReads)) {
 
+		if (SERVER_KNOBS->REDWOOD_REMAP_CLEANUP_PAGES_PER_SECOND > 0) {
+			remapCleanupRateLimit =
+			    makeReference<SpeedLimit>(SERVER_KNOBS->REDWOOD_REMAP_CLEANUP_PAGES_PER_SECOND, 1.0);
+		}
+
 		// This sets the page cache size for all PageCacheT instances using the same evictor
 		pageCache.evictor().sizeLimit = pageCacheBytes;
 
+		compressedPageCacheEvictor.sizeLimit = memoryOnly ? 0 : SERVER_KNOBS->REDWOOD_COMPRESSED_PAGE_CACHE_BYTES;
+		if (compressedPageCacheEvictor.sizeLimit > 0) {
+			compressedPageFilter =
+			    CompressionUtils::fromFilterString(SERVER_KNOBS->REDWOOD_COMPRESSED_PAGE_CACHE_FILTER);
+			if (compressedPageFilter == CompressionFilter::NONE ||
+			    !CompressionUtils::supportedFilters.contains(compressedPageFilter)) {
+				TraceEvent(SevWarn, "RedwoodCompressedPageCacheDisabled")
+				    .detail("Filename", filename)
+				    .detail("Filter", SERVER_KNOBS->REDWOOD_COMPRESSED_PAGE_CACHE_FILTER);
+				compressedPageCacheEvictor.sizeLimit = 0;
+			} else {
+				pageCache.onEvict = [this](const LogicalPageID& id, const PageCacheEntry& entry) {
+					compressEvictedPage(id, entry);
+				};
+			}
+		}
+
 		g_redwoodMetrics.ioLock = ioLock.getPtr();
 		if (!g_redwoodMetricsActor.isValid()) {
 			g_redwoodMetricsActor = redwoodMetricsLogger();
@@ -2584,6 +2754,13 @@ public:
 
 		page->preWrite(pageIDs.front());
 
+		// Any compressed copy of the previous contents of these pages is now stale
+		if (!header && compressedPageCacheEvictor.sizeLimit > 0) {
+			for (PhysicalPageID id : pageIDs) {
+				compressedPageCache.remove(id);
+			}
+		}
+
 		int blockSize = header ? smallestPhysicalBlock : physicalPageSize;
 		Future<Void> f;
 		if (pageIDs.size() == 1) {
@@ -2651,6 +2828,7 @@ public:
 
 		// Always update the page contents immediately regardless of what happened above.
 		cacheEntry.readFuture = data;
+		cacheEntry.compressible = level == 1 && pageIDs.size() == 1;
 	}
 
 	Future<LogicalPageID> atomicUpdatePage(PagerEventReasons reason,
@@ -2795,6 +2973,68 @@ public:
 		return bytes;
 	}
 
+	// Keep a compressed copy of a leaf page being evicted from the page cache if its buffer holds exactly what is
+	// on disk, which is the case for pages that are not encrypted, and it compresses well enough to be worth it.
+	void compressEvictedPage(PhysicalPageID pageID, const PageCacheEntry& entry) {
+		if (!entry.compressible || !entry.readFuture.isReady() || entry.readFuture.isError()) {
+			return;
+		}
+		const Reference<ArenaPage>& page = entry.readFuture.get();
+		if (page->isEncrypted() || page->rawSize() != physicalPageSize) {
+			return;
+		}
+
+		CompressedPageEntry compressed;
+		compressed.data.contents() = CompressionUtils::compress(
+		    compressedPageFilter, StringRef(page->rawData(), page->rawSize()), compressed.data.arena());
+		if (compressed.data.size() > page->rawSize() * SERVER_KNOBS->REDWOOD_COMPRESSED_PAGE_CACHE_MAX_RATIO) {
+			++g_redwoodMetrics.metric.pagerCompressedReject;
+			return;
+		}
+
+		compressedPageCache.remove(pageID);
+		compressedPageCache.get(pageID, compressed.data.size()) = std::move(compressed);
+		++g_redwoodMetrics.metric.pagerCompressedAdmit;
+	}
+
+	// If pageID is in the compressed page cache, move it from there into page and verify it as if it was just read
+	// from disk.  Returns false if the page must be read from disk.
+	bool readCompressedPage(PhysicalPageID pageID, Reference<ArenaPage> page) {
+		if (compressedPageCacheEvictor.sizeLimit == 0) {
+			return false;
+		}
+		CompressedPageEntry* pEntry = compressedPageCache.getIfExists(pageID);
+		if (pEntry == nullptr) {
+			return false;
+		}
+		Standalone<StringRef> data = pEntry->data;
+		compressedPageCache.remove(pageID);
+
+		try {
+			Arena arena;
+			StringRef raw = CompressionUtils::decompress(compressedPageFilter, data, arena);
+			if (raw.size() != page->rawSize()) {
+				return false;
+			}
+			memcpy(page->rawData(), raw.begin(), raw.size());
+			page->postReadHeader(pageID);
+			if (page->isEncrypted()) {
+				return false;
+			}
+			page->postReadPayload(pageID);
+		} catch (Error& e) {
+			debug_printf("DWALPager(%s) op=readCompressedFailed %s %s\n",
+			             filename.c_str(),
+			             toString(pageID).c_str(),
+			             e.what());
+			return false;
+		}
+
+		++g_redwoodMetrics.metric.pagerCompressedHit;
+		debug_printf("DWALPager(%s) op=readCompressedHit %s\n", filename.c_str(), toString(pageID).c_str());
+		return true;
+	}
+
 	// Read a physical page from the page file.  Note that header pages use a page size of smallestPhysicalBlock.
 	// If the user chosen physical page size is larger, then there will be a gap of unused space after the header pages
 	// and before the user-chosen sized pages.
@@ -2813,6 +3053,10 @@ public:
 		             page->rawData(),
 		             header);
 
+		if (!header && self->readCompressedPage(pageID, page)) {
+			return page;
+		}
+
 		int readBytes =
 		    wait(readPhysicalBlock(self, page, 0, page->rawSize(), (int64_t)pageID * page->rawSize(), priority));
 		debug_printf("DWALPager(%s) op=readPhysicalDiskReadComplete %s ptr=%p bytes=%d\n",
@@ -2969,7 +3213,8 @@ public:
 	                                      PhysicalPageID pageID,
 	                                      int priority,
 	                                      bool cacheable,
-	                                      bool noHit) override {
+	                                      bool noHit,
+	                                      bool scan) override {
 		// Use cached page if present, without triggering a cache hit.
 		// Otherwise, read the page and return it but don't add it to the cache
 		debug_printf("DWALPager(%s) op=read %s reason=%s  noHit=%d\n",
@@ -2991,7 +3236,7 @@ public:
 			debug_printf("DWALPager(%s) op=readUncachedMiss %s\n", filename.c_str(), toString(pageID).c_str());
 			return forwardError(readPhysicalPage(this, pageID, priority, false, reason), errorPromise);
 		}
-		PageCacheEntry& cacheEntry = pageCache.get(pageID, physicalPageSize, noHit);
+		PageCacheEntry& cacheEntry = pageCache.get(pageID, physicalPageSize, noHit, scan);
 		debug_printf("DWALPager(%s) op=read %s cached=%d reading=%d writing=%d noHit=%d\n",
 		             filename.c_str(),
 		             toString(pageID).c_str(),
@@ -3003,6 +3248,7 @@ public:
 			debug_printf("DWALPager(%s) issuing actual read of %s\n", filename.c_str(), toString(pageID).c_str());
 			cacheEntry.readFuture = forwardError(readPhysicalPage(this, pageID, priority, false, reason), errorPromise);
 			cacheEntry.writeFuture = Void();
+			cacheEntry.compressible = level == 1;
 
 			++g_redwoodMetrics.metric.pagerCacheMiss;
 			eventReasons.addEventReason(PagerEvents::CacheMiss, reason);
@@ -3018,7 +3264,8 @@ public:
 	                                           VectorRef<PhysicalPageID> pageIDs,
 	                                           int priority,
 	                                           bool cacheable,
-	                                           bool noHit) override {
+	                                           bool noHit,
+	                                           bool scan) override {
 		// Use cached page if present, without triggering a cache hit.
 		// Otherwise, read the page and return it but don't add it to the cache
 		debug_printf("DWALPager(%s) op=read %s reason=%s noHit=%d\n",
@@ -3041,7 +3288,7 @@ public:
 			return forwardError(readPhysicalMultiPage(this, pageIDs, priority, reason), errorPromise);
 		}
 
-		PageCacheEntry& cacheEntry = pageCache.get(pageIDs.front(), pageIDs.size() * physicalPageSize, noHit);
+		PageCacheEntry& cacheEntry = pageCache.get(pageIDs.front(), pageIDs.size() * physicalPageSize, noHit, scan);
 		debug_printf("DWALPager(%s) op=read %s cached=%d reading=%d writing=%d noHit=%d\n",
 		             filename.c_str(),
 		             toString(pageIDs).c_str(),
@@ -3098,9 +3345,10 @@ public:
 	                                               int priority,
 	                                               Version v,
 	                                               bool cacheable,
-	                                               bool noHit) {
+	                                               bool noHit,
+	                                               bool scan) {
 		PhysicalPageID physicalID = getPhysicalPageID(logicalID, v);
-		return readPage(reason, level, physicalID, priority, cacheable, noHit);
+		return readPage(reason, level, physicalID, priority, cacheable, noHit, scan);
 	}
 
 	void releaseExtentReadLock() override { concurrentExtentReads->release(); }
@@ -3350,8 +3598,8 @@ public:
 			debug_printf("DWALPager(%s) remapCleanup copy %s\n", self->filename.c_str(), p.toString().c_str());
 
 			// Read the data from the page that the original was mapped to
-			Reference<ArenaPage> data = wait(
-			    self->readPage(PagerEventReasons::MetaData, nonBtreeLevel, p.newPageID, ioLeafPriority, false, true));
+			Reference<ArenaPage> data = wait(self->readPage(
+			    PagerEventReasons::MetaData, nonBtreeLevel, p.newPageID, ioLeafPriority, false, true, false));
 
 			// Write the data to the original page so it can be read using its original pageID
 			self->updatePage(
@@ -3442,6 +3690,11 @@ public:
 		state uint64_t minRemapEntries = static_cast<uint64_t>(remapCleanupWindowEntries * (1.0 - toleranceRatio));
 		state uint64_t maxRemapEntries = static_cast<uint64_t>(remapCleanupWindowEntries * (1.0 + toleranceRatio));
 
+		// When cleanup IO is paced, the backlog may grow past maxRemapEntries up to this limit rather than
+		// blocking a commit on a burst of cleanup, and pacing is abandoned beyond it so the backlog stays bounded.
+		state bool paced = self->remapCleanupRateLimit.isValid();
+		state uint64_t pacedRemapEntries = maxRemapEntries * 2;
+
 		debug_printf("DWALPager(%s) remapCleanup oldestRetainedVersion=%" PRId64 " remapCleanupWindowBytes=%" PRId64
 		             " pageSize=%" PRIu32 " minRemapEntries=%" PRId64 " maxRemapEntries=%" PRId64 " items=%" PRId64
 		             "\n",
@@ -3461,9 +3714,9 @@ public:
 		loop {
 			// Stop if we have cleanup enough remap entries, or if the stop flag is set and the remaining remap
 			// entries are less than that allowed by the lag.
-			int64_t remainingEntries = self->remapQueue.numEntries;
+			state int64_t remainingEntries = self->remapQueue.numEntries;
 			if (remainingEntries <= minRemapEntries ||
-			    (self->remapCleanupStop && remainingEntries <= maxRemapEntries)) {
+			    (self->remapCleanupStop && remainingEntries <= (paced ? pacedRemapEntries : maxRemapEntries))) {
 				debug_printf("DWALPager(%s) remapCleanup finished remainingEntries=%" PRId64 " minRemapEntries=%" PRId64
 				             " maxRemapEntries=%" PRId64,
 				             self->filename.c_str(),
@@ -3490,6 +3743,15 @@ public:
 			Future<Void> task = removeRemapEntry(self, p.get(), oldestRetainedVersion);
 			if (!task.isReady()) {
 				tasks.add(task);
+
+				// Only entries which resulted in IO count against the cleanup rate
+				if (paced && remainingEntries <= pacedRemapEntries) {
+					state Future<Void> allowance = self->remapCleanupRateLimit->getAllowance(1);
+					if (!allowance.isReady()) {
+						++g_redwoodMetrics.metric.pagerRemapPaced;
+						wait(allowance);
+					}
+				}
 			}
 
 			// Yield to prevent slow task in case no IO waits are encountered
@@ -3506,6 +3768,7 @@ public:
 		             self->remapQueue.numEntries,
 		             self->freeList.numEntries,
 		             self->delayedFreeList.numEntries);
+		g_redwoodMetrics.gauge.pagerRemapBacklog = self->remapQueue.numEntries;
 		signal.send(Void());
 		wait(tasks.getResult());
 		return Void();
@@ -3676,6 +3939,7 @@ public:
 		debug_printf("DWALPager(%s) shutdown destroy page cache\n", self->filename.c_str());
 		wait(self->extentCache.clear());
 		wait(self->pageCache.clear());
+		wait(self->compressedPageCache.clear());
 
 		debug_printf("DWALPager(%s) shutdown remappedPagesMap: %s\n",
 		             self->filename.c_str(),
@@ -3915,6 +4179,12 @@ private:
 	PageCacheT::Evictor extentCacheDummyEvictor{ std::numeric_limits<int64_t>::max() };
 	PageCacheT extentCache{ &extentCacheDummyEvictor };
 
+	// Compressed copies of recently evicted leaf pages, consulted before reading a page from disk.
+	// Its size limit is 0 when it is disabled.
+	CompressedPageCacheT::Evictor compressedPageCacheEvictor;
+	CompressedPageCacheT compressedPageCache{ &compressedPageCacheEvictor };
+	CompressionFilter compressedPageFilter = CompressionFilter::NONE;
+
 	Promise<Void> closedPromise;
 	Promise<Void> errorPromise;
 	Future<Void> commitFuture;
@@ -3926,6 +4196,8 @@ private:
 	Future<Void> recoverFuture;
 	Future<Void> remapCleanupFuture;
 	bool remapCleanupStop;
+	// Paces the IO done by remapCleanup if REDWOOD_REMAP_CLEANUP_PAGES_PER_SECOND is set
+	Reference<IRateControl> remapCleanupRateLimit;
 
 	Reference<IAsyncFile> pageFile;
 
@@ -3972,9 +4244,10 @@ public:
 	                                                   LogicalPageID pageID,
 	                                                   int priority,
 	                                                   bool cacheable,
-	                                                   bool noHit) override {
+	                                                   bool noHit,
+	                                                   bool scan) override {
 
-		return map(pager->readPageAtVersion(reason, level, pageID, priority, version, cacheable, noHit),
+		return map(pager->readPageAtVersion(reason, level, pageID, priority, version, cacheable, noHit, scan),
 		           [=](Reference<ArenaPage> p) { return Reference<const ArenaPage>(std::move(p)); });
 	}
 
@@ -3983,9 +4256,10 @@ public:
 	                                                        VectorRef<PhysicalPageID> pageIDs,
 	                                                        int priority,
 	                                                        bool cacheable,
-	                                                        bool noHit) override {
+	                                                        bool noHit,
+	                                                        bool scan) override {
 
-		return map(pager->readMultiPage(reason, level, pageIDs, priority, cacheable, noHit),
+		return map(pager->readMultiPage(reason, level, pageIDs, priority, cacheable, noHit, scan),
 		           [=](Reference<ArenaPage> p) { return Reference<const ArenaPage>(std::move(p)); });
 	}
 
@@ -5009,26 +5283,17 @@ public:
 		++g_redwoodMetrics.metric.opSet;
 		g_redwoodMetrics.metric.opSetKeyBytes += keyValue.key.size();
 		g_redwoodMetrics.metric.opSetValueBytes += keyValue.value.size();
-		m_pBuffer->insert(keyValue.key).mutation().setBoundaryValue(m_pBuffer->copyToArena(keyValue.value));
+		(this->*m_bufferSet)(keyValue);
 	}
 
 	void clear(KeyRangeRef clearedRange) {
 		++m_mutationCount;
 		ASSERT(!clearedRange.empty());
-		// Optimization for single key clears to create just one mutation boundary instead of two
 		if (clearedRange.singleKeyRange()) {
-			++g_redwoodMetrics.metric.opClear;
 			++g_redwoodMetrics.metric.opClearKey;
-			m_pBuffer->insert(clearedRange.begin).mutation().clearBoundary();
-			return;
 		}
 		++g_redwoodMetrics.metric.opClear;
-		MutationBuffer::iterator iBegin = m_pBuffer->insert(clearedRange.begin);
-		MutationBuffer::iterator iEnd = m_pBuffer->insert(clearedRange.end);
-
-		iBegin.mutation().clearAll();
-		++iBegin;
-		m_pBuffer->erase(iBegin, iEnd);
+		(this->*m_bufferClear)(clearedRange);
 	}
 
 	void setOldestReadableVersion(Version v) { m_newOldestVersion = v; }
@@ -5048,8 +5313,13 @@ public:
 	               Reference<GetEncryptCipherKeysMonitor> encryptionMonitor = {})
 	  : m_pager(pager), m_db(db), m_expectedEncryptionMode(expectedEncryptionMode), m_encodingType(encodingType),
 	    m_enforceEncodingType(false), m_keyProvider(keyProvider), m_encryptionMonitor(encryptionMonitor),
-	    m_pBuffer(nullptr), m_mutationCount(0), m_name(name), m_logID(logID),
+	    m_mutationCount(0), m_name(name), m_logID(logID),
 	    m_pBoundaryVerifier(DecodeBoundaryVerifier::getVerifier(name)) {
+		if (SERVER_KNOBS->REDWOOD_ART_MUTATION_BUFFER) {
+			useMutationBuffer<MutationBufferART>();
+		} else {
+			useMutationBuffer<MutationBufferStdMap>();
+		}
 		m_pDecodeCacheMemory = m_pager->getPageCachePenaltySource();
 		m_lazyClearActor = 0;
 		m_init = init_impl(this);
@@ -5075,6 +5345,7 @@ public:
 	void toTraceEvent(TraceEvent& e) const {
 		m_pager->toTraceEvent(e);
 		m_lazyClearQueue.toTraceEvent(e, "LazyClearQueue");
+		e.detail("LazyClearFreedPages", m_lazyClearFreedPages);
 	}
 
 	ACTOR static Future<int> incrementalLazyClear(VersionedBTree* self) {
@@ -5085,17 +5356,22 @@ public:
 		state Reference<IPagerSnapshot> snapshot =
 		    self->m_pager->getReadSnapshot(self->m_pager->getLastCommittedVersion());
 		state int freedPages = 0;
+		// Queue entries whose pages are being read, in the order they were popped
+		state Deque<std::pair<LazyClearQueueEntry, Future<Reference<const ArenaPage>>>> entries;
+		state bool queueExhausted = false;
 
 		loop {
-			state int toPop = SERVER_KNOBS->REDWOOD_LAZY_CLEAR_BATCH_SIZE_PAGES;
-			state std::vector<std::pair<LazyClearQueueEntry, Future<Reference<const ArenaPage>>>> entries;
-			entries.reserve(toPop);
-
-			// Take up to batchSize pages from front of queue
-			while (toPop > 0) {
+			// Keep a rolling window of page reads in flight so that processing one page overlaps the reads of the
+			// pages behind it.  The window grows to the idle size while no other pager IO is waiting for a slot.
+			state int window = self->m_pager->getIOWaitersCount() == 0
+			                       ? std::max(SERVER_KNOBS->REDWOOD_LAZY_CLEAR_IDLE_BATCH_SIZE_PAGES,
+			                                  SERVER_KNOBS->REDWOOD_LAZY_CLEAR_BATCH_SIZE_PAGES)
+			                       : SERVER_KNOBS->REDWOOD_LAZY_CLEAR_BATCH_SIZE_PAGES;
+			while (!queueExhausted && (int)entries.size() < window) {
 				Optional<LazyClearQueueEntry> q = wait(self->m_lazyClearQueue.pop());
 				debug_printf("LazyClear: popped %s\n", toString(q).c_str());
 				if (!q.present()) {
+					queueExhausted = true;
 					break;
 				}
 
@@ -5108,71 +5384,82 @@ public:
 				                                    q.get().pageID,
 				                                    ioLeafPriority,
 				                                    true,
+				                                    false,
 				                                    false));
-				--toPop;
-			}
-
-			state int i;
-			for (i = 0; i < entries.size(); ++i) {
-				Reference<const ArenaPage> p = wait(entries[i].second);
-				const LazyClearQueueEntry& entry = entries[i].first;
-				const BTreePage& btPage = *(const BTreePage*)p->data();
-				ASSERT(btPage.height == entry.height);
-				auto& metrics = g_redwoodMetrics.level(entry.height).metrics;
-
-				debug_printf("LazyClear: processing %s\n", toString(entry).c_str());
-
-				// Level 1 (leaf) nodes should never be in the lazy delete queue
-				ASSERT(entry.height > 1);
-
-				// Iterate over page entries, skipping key decoding using BTreePage::ValueTree which uses
-				// RedwoodRecordRef::DeltaValueOnly as the delta type type to skip key decoding
-				BTreePage::ValueTree::Cursor c(makeReference<BTreePage::ValueTree::DecodeCache>(dbBegin, dbEnd),
-				                               btPage.valueTree());
-				ASSERT(c.moveFirst());
-				Version v = entry.version;
-				while (1) {
-					if (c.get().value.present()) {
-						BTreeNodeLinkRef btChildPageID = c.get().getChildPage();
-						// If this page is height 2, then the children are leaves so free them directly
-						if (entry.height == 2) {
-							debug_printf("LazyClear: freeing leaf child %s\n", toString(btChildPageID).c_str());
-							self->freeBTreePage(1, btChildPageID, v);
-							freedPages += btChildPageID.size();
-							metrics.lazyClearFree += 1;
-							metrics.lazyClearFreeExt += (btChildPageID.size() - 1);
-						} else {
-							// Otherwise, queue them for lazy delete.
-							debug_printf("LazyClear: queuing child %s\n", toString(btChildPageID).c_str());
-							self->m_lazyClearQueue.pushFront(
-							    LazyClearQueueEntry{ (uint8_t)(entry.height - 1), v, btChildPageID });
-							metrics.lazyClearRequeue += 1;
-							metrics.lazyClearRequeueExt += (btChildPageID.size() - 1);
-						}
-					}
-					if (!c.moveNext()) {
-						break;
+			}
+
+			if (entries.empty()) {
+				break;
+			}
+
+			Reference<const ArenaPage> p = wait(entries.front().second);
+			const LazyClearQueueEntry& entry = entries.front().first;
+			const BTreePage& btPage = *(const BTreePage*)p->data();
+			ASSERT(btPage.height == entry.height);
+			auto& metrics = g_redwoodMetrics.level(entry.height).metrics;
+
+			debug_printf("LazyClear: processing %s\n", toString(entry).c_str());
+
+			// Level 1 (leaf) nodes should never be in the lazy delete queue
+			ASSERT(entry.height > 1);
+
+			// Iterate over page entries, skipping key decoding using BTreePage::ValueTree which uses
+			// RedwoodRecordRef::DeltaValueOnly as the delta type type to skip key decoding
+			BTreePage::ValueTree::Cursor c(makeReference<BTreePage::ValueTree::DecodeCache>(dbBegin, dbEnd),
+			                               btPage.valueTree());
+			ASSERT(c.moveFirst());
+			Version v = entry.version;
+			while (1) {
+				if (c.get().value.present()) {
+					BTreeNodeLinkRef btChildPageID = c.get().getChildPage();
+					// If this page is height 2, then the children are leaves so free them directly
+					if (entry.height == 2) {
+						debug_printf("LazyClear: freeing leaf child %s\n", toString(btChildPageID).c_str());
+						self->freeBTreePage(1, btChildPageID, v);
+						freedPages += btChildPageID.size();
+						metrics.lazyClearFree += 1;
+						metrics.lazyClearFreeExt += (btChildPageID.size() - 1);
+					} else {
+						// Otherwise, queue them for lazy delete.
+						debug_printf("LazyClear: queuing child %s\n", toString(btChildPageID).c_str());
+						self->m_lazyClearQueue.pushFront(
+						    LazyClearQueueEntry{ (uint8_t)(entry.height - 1), v, btChildPageID });
+						metrics.lazyClearRequeue += 1;
+						metrics.lazyClearRequeueExt += (btChildPageID.size() - 1);
+						queueExhausted = false;
 					}
 				}
-
-				// Free the page, now that its children have either been freed or queued
-				debug_printf("LazyClear: freeing queue entry %s\n", toString(entry.pageID).c_str());
-				self->freeBTreePage(entry.height, entry.pageID, v);
-				freedPages += entry.pageID.size();
-				metrics.lazyClearFree += 1;
-				metrics.lazyClearFreeExt += entry.pageID.size() - 1;
+				if (!c.moveNext()) {
+					break;
+				}
 			}
 
+			// Free the page, now that its children have either been freed or queued
+			debug_printf("LazyClear: freeing queue entry %s\n", toString(entry.pageID).c_str());
+			self->freeBTreePage(entry.height, entry.pageID, v);
+			freedPages += entry.pageID.size();
+			metrics.lazyClearFree += 1;
+			metrics.lazyClearFreeExt += entry.pageID.size() - 1;
+			entries.pop_front();
+
 			// Stop if
-			//   - the poppable items in the queue have already been exhausted
 			//   - stop flag is set and we've freed the minimum number of pages required
 			//   - maximum number of pages to free met or exceeded
-			if (toPop > 0 || (freedPages >= SERVER_KNOBS->REDWOOD_LAZY_CLEAR_MIN_PAGES && self->m_lazyClearStop) ||
+			if ((freedPages >= SERVER_KNOBS->REDWOOD_LAZY_CLEAR_MIN_PAGES && self->m_lazyClearStop) ||
 			    (freedPages >= SERVER_KNOBS->REDWOOD_LAZY_CLEAR_MAX_PAGES)) {
 				break;
 			}
 		}
 
+		// Entries still being read were popped but not processed, so return them to the front of the queue
+		while (!entries.empty()) {
+			self->m_lazyClearQueue.pushFront(entries.back().first);
+			entries.pop_back();
+		}
+
+		self->m_lazyClearFreedPages += freedPages;
+		g_redwoodMetrics.metric.lazyClearFreedPages += freedPages;
+		g_redwoodMetrics.gauge.lazyClearBacklog = self->m_lazyClearQueue.numEntries;
 		debug_printf("LazyClear: freed %d pages, %s has %" PRId64 " entries\n",
 		             freedPages,
 		             self->m_lazyClearQueue.name.c_str(),
@@ -5247,7 +5534,6 @@ public:
 
 	ACTOR static Future<Void> init_impl(VersionedBTree* self) {
 		wait(self->m_pager->init());
-		self->m_pBuffer.reset(new MutationBuffer());
 
 		self->m_blockSize = self->m_pager->getLogicalPageSize();
 		self->m_newOldestVersion = self->m_pager->getOldestReadableVersion();
@@ -5392,7 +5678,7 @@ public:
 
 	Future<Void> commit(Version v) {
 		// Replace latest commit with a new one which waits on the old one
-		m_latestCommit = commit_impl(this, v, m_latestCommit);
+		m_latestCommit = m_bufferCommit(this, v, m_latestCommit);
 		return m_latestCommit;
 	}
 
@@ -5595,15 +5881,44 @@ public:
 			return ib;
 		}
 	};
-#define USE_ART_MUTATION_BUFFER 1
-
-#ifdef USE_ART_MUTATION_BUFFER
-	typedef struct MutationBufferART MutationBuffer;
-#else
-	typedef struct MutationBufferStdMap MutationBuffer;
-#endif
 
 private:
+	template <class MutationBuffer>
+	std::unique_ptr<MutationBuffer>& mutationBuffer() {
+		return std::get<std::unique_ptr<MutationBuffer>>(m_buffers);
+	}
+
+	// Bind writes and commits to MutationBuffer for the lifetime of the tree
+	template <class MutationBuffer>
+	void useMutationBuffer() {
+		mutationBuffer<MutationBuffer>().reset(new MutationBuffer());
+		m_bufferSet = &VersionedBTree::bufferSet<MutationBuffer>;
+		m_bufferClear = &VersionedBTree::bufferClear<MutationBuffer>;
+		m_bufferCommit = &VersionedBTree::commit_impl<MutationBuffer>;
+	}
+
+	template <class MutationBuffer>
+	void bufferSet(KeyValueRef keyValue) {
+		MutationBuffer& buffer = *mutationBuffer<MutationBuffer>();
+		buffer.insert(keyValue.key).mutation().setBoundaryValue(buffer.copyToArena(keyValue.value));
+	}
+
+	template <class MutationBuffer>
+	void bufferClear(KeyRangeRef clearedRange) {
+		MutationBuffer& buffer = *mutationBuffer<MutationBuffer>();
+		// Optimization for single key clears to create just one mutation boundary instead of two
+		if (clearedRange.singleKeyRange()) {
+			buffer.insert(clearedRange.begin).mutation().clearBoundary();
+			return;
+		}
+		typename MutationBuffer::iterator iBegin = buffer.insert(clearedRange.begin);
+		typename MutationBuffer::iterator iEnd = buffer.insert(clearedRange.end);
+
+		iBegin.mutation().clearAll();
+		++iBegin;
+		buffer.erase(iBegin, iEnd);
+	}
+
 	/* Mutation Buffer Overview
 	 *
 	 * This structure's organization is meant to put pending updates for the btree in an order
@@ -5666,8 +5981,12 @@ private:
 	// Counter to update with DecodeCache memory usage
 	int64_t* m_pDecodeCacheMemory = nullptr;
 
-	// The mutation buffer currently being written to
-	std::unique_ptr<MutationBuffer> m_pBuffer;
+	// The mutation buffer currently being written to.  Only the one chosen by REDWOOD_ART_MUTATION_BUFFER when the
+	// tree is constructed is used, and the functions below are bound to its type so no buffer operation branches on it.
+	std::tuple<std::unique_ptr<MutationBufferART>, std::unique_ptr<MutationBufferStdMap>> m_buffers;
+	void (VersionedBTree::*m_bufferSet)(KeyValueRef);
+	void (VersionedBTree::*m_bufferClear)(KeyRangeRef);
+	Future<Void> (*m_bufferCommit)(VersionedBTree*, Version, Future<Void>);
 	int64_t m_mutationCount;
 	DecodeBoundaryVerifier* m_pBoundaryVerifier;
 
@@ -5675,7 +5994,6 @@ private:
 		Version readVersion;
 		Version writeVersion;
 		Version newOldestVersion;
-		std::unique_ptr<MutationBuffer> mutations;
 		int64_t mutationCount;
 		Reference<IPagerSnapshot> snapshot;
 	};
@@ -5693,6 +6011,8 @@ private:
 	LazyClearQueueT m_lazyClearQueue;
 	Future<int> m_lazyClearActor;
 	bool m_lazyClearStop;
+	// Pages freed by lazy clear since the tree was opened
+	int64_t m_lazyClearFreedPages = 0;
 
 	// Describes a range of a vector of records that should be built into a single BTreePage
 	struct PageToBuild {
@@ -6299,7 +6619,8 @@ private:
 	                                                         BTreeNodeLinkRef id,
 	                                                         int priority,
 	                                                         bool forLazyClear,
-	                                                         bool cacheable) {
+	                                                         bool cacheable,
+	                                                         bool scan) {
 
 		debug_printf("readPage() op=read%s %s @%" PRId64 "\n",
 		             forLazyClear ? "ForDeferredClear" : "",
@@ -6309,12 +6630,12 @@ private:
 		state Reference<const ArenaPage> page;
 		if (id.size() == 1) {
 			Reference<const ArenaPage> p =
-			    wait(snapshot->getPhysicalPage(reason, level, id.front(), priority, cacheable, false));
+			    wait(snapshot->getPhysicalPage(reason, level, id.front(), priority, cacheable, false, scan));
 			page = std::move(p);
 		} else {
 			ASSERT(!id.empty());
 			Reference<const ArenaPage> p =
-			    wait(snapshot->getMultiPhysicalPage(reason, level, id, priority, cacheable, false));
+			    wait(snapshot->getMultiPhysicalPage(reason, level, id, priority, cacheable, false, scan));
 			page = std::move(p);
 		}
 		debug_printf("readPage() op=readComplete %s @%" PRId64 " \n", toString(id).c_str(), snapshot->getVersion());
@@ -6369,15 +6690,15 @@ private:
 		                                     ((BTreePage*)page->mutateData())->tree());
 	}
 
-	static void preLoadPage(IPagerSnapshot* snapshot, BTreeNodeLinkRef pageIDs, int priority) {
+	static void preLoadPage(IPagerSnapshot* snapshot, BTreeNodeLinkRef pageIDs, int priority, bool scan) {
 		g_redwoodMetrics.metric.btreeLeafPreload += 1;
 		g_redwoodMetrics.metric.btreeLeafPreloadExt += (pageIDs.size() - 1);
 		if (pageIDs.size() == 1) {
 			snapshot->getPhysicalPage(
-			    PagerEventReasons::RangePrefetch, nonBtreeLevel, pageIDs.front(), priority, true, true);
+			    PagerEventReasons::RangePrefetch, nonBtreeLevel, pageIDs.front(), priority, true, true, scan);
 		} else {
 			snapshot->getMultiPhysicalPage(
-			    PagerEventReasons::RangePrefetch, nonBtreeLevel, pageIDs, priority, true, true);
+			    PagerEventReasons::RangePrefetch, nonBtreeLevel, pageIDs, priority, true, true, scan);
 		}
 	}
 
@@ -6789,14 +7110,16 @@ private:
 		}
 	};
 
-	ACTOR static Future<Void> commitSubtree(
+	ACTOR template <class MutationBuffer>
+	static Future<Void> commitSubtree(
 	    VersionedBTree* self,
 	    CommitBatch* batch,
+	    MutationBuffer const* mutations,
 	    BTreeNodeLinkRef rootID,
 	    LogicalPageID parentID,
 	    unsigned int height,
-	    MutationBuffer::const_iterator mBegin, // greatest mutation boundary <= subtreeLowerBound->key
-	    MutationBuffer::const_iterator mEnd, // least boundary >= subtreeUpperBound->key
+	    typename MutationBuffer::const_iterator mBegin, // greatest mutation boundary <= subtreeLowerBound->key
+	    typename MutationBuffer::const_iterator mEnd, // least boundary >= subtreeUpperBound->key
 	    InternalPageSliceUpdate* update) {
 
 		state std::string context;
@@ -6826,8 +7149,8 @@ private:
 			}
 		}
 
-		state Reference<const ArenaPage> page = wait(
-		    readPage(self, PagerEventReasons::Commit, height, batch->snapshot.getPtr(), rootID, height, false, true));
+		state Reference<const ArenaPage> page = wait(readPage(
+		    self, PagerEventReasons::Commit, height, batch->snapshot.getPtr(), rootID, height, false, true, false));
 
 		// If the page exists in the cache, it must be copied before modification.
 		// That copy will be referenced by pageCopy, as page must stay in scope in case anything references its
@@ -7253,7 +7576,7 @@ private:
 				u.skipLen = 0; // TODO: set this
 
 				// Find the mutation buffer range that includes all changes to the range described by u
-				mEnd = batch->mutations->lower_bound(u.subtreeUpperBound.key);
+				mEnd = mutations->lower_bound(u.subtreeUpperBound.key);
 
 				// If the mutation range described by mBegin extends to mEnd, then see if the part of that range
 				// that overlaps with u's subtree range is being fully cleared or fully unchanged.
@@ -7355,8 +7678,8 @@ private:
 				debug_printf("%s Recursing for %s\n", context.c_str(), toString(pageID).c_str());
 				debug_print(addPrefix(context, u.toString()));
 
-				recursions.push_back(
-				    self->commitSubtree(self, batch, pageID, rootID.front(), height - 1, mBegin, mEnd, &u));
+				recursions.push_back(commitSubtree<MutationBuffer>(
+				    self, batch, mutations, pageID, rootID.front(), height - 1, mBegin, mEnd, &u));
 			}
 
 			debug_printf("%s Recursions from internal page started. pageSize=%d level=%d children=%d slices=%zu "
@@ -7568,11 +7891,12 @@ private:
 		}
 	}
 
-	ACTOR static Future<Void> commit_impl(VersionedBTree* self, Version writeVersion, Future<Void> previousCommit) {
+	ACTOR template <class MutationBuffer>
+	static Future<Void> commit_impl(VersionedBTree* self, Version writeVersion, Future<Void> previousCommit) {
 		// Take ownership of the current mutation buffer and make a new one
 		state CommitBatch batch;
-		batch.mutations = std::move(self->m_pBuffer);
-		self->m_pBuffer.reset(new MutationBuffer());
+		state std::unique_ptr<MutationBuffer> mutations = std::move(self->mutationBuffer<MutationBuffer>());
+		self->mutationBuffer<MutationBuffer>().reset(new MutationBuffer());
 		batch.mutationCount = self->m_mutationCount;
 		self->m_mutationCount = 0;
 
@@ -7612,12 +7936,19 @@ private:
 		all.decodeUpperBound = dbEnd;
 		all.skipLen = 0;
 
-		MutationBuffer::const_iterator mBegin = batch.mutations->upper_bound(all.subtreeLowerBound.key);
+		typename MutationBuffer::const_iterator mBegin = mutations->upper_bound(all.subtreeLowerBound.key);
 		--mBegin;
-		MutationBuffer::const_iterator mEnd = batch.mutations->lower_bound(all.subtreeUpperBound.key);
-
-		wait(
-		    commitSubtree(self, &batch, rootNodeLink, invalidLogicalPageID, self->m_header.height, mBegin, mEnd, &all));
+		typename MutationBuffer::const_iterator mEnd = mutations->lower_bound(all.subtreeUpperBound.key);
+
+		wait(commitSubtree<MutationBuffer>(self,
+		                                   &batch,
+		                                   mutations.get(),
+		                                   rootNodeLink,
+		                                   invalidLogicalPageID,
+		                                   self->m_header.height,
+		                                   mBegin,
+		                                   mEnd,
+		                                   &all));
 
 		// If the old root was deleted, write a new empty tree root node and free the old roots
 		if (all.childrenChanged) {
@@ -7679,16 +8010,21 @@ public:
 	private:
 		PagerEventReasons reason;
 		Optional<ReadOptions> options;
+		// Reads made by this cursor should not promote pages into the page cache's protected set
+		bool scan;
 		VersionedBTree* btree;
 		Reference<IPagerSnapshot> pager;
 		bool valid;
 		std::vector<PathEntry> path;
+		// Bytes of the pages this cursor had to wait to read, which approximates the cache miss cost of its reads
+		int64_t pageWaitBytes;
 
 	public:
-		BTreeCursor() : reason(PagerEventReasons::MAXEVENTREASONS) {}
+		BTreeCursor() : reason(PagerEventReasons::MAXEVENTREASONS), scan(false), pageWaitBytes(0) {}
 
 		bool initialized() const { return pager.isValid(); }
 		bool isValid() const { return valid; }
+		int64_t getPageWaitBytes() const { return pageWaitBytes; }
 
 		// path entries at dumpHeight or below will have their entire pages printed
 		std::string toString(int dumpHeight = 0) const {
@@ -7737,14 +8073,20 @@ public:
 
 		Future<Void> pushPage(const BTreePage::BinaryTree::Cursor& link) {
 			debug_printf("pushPage(link=%s)\n", link.get().toString(false).c_str());
-			return map(readPage(btree,
-			                    reason,
-			                    path.back().btPage()->height - 1,
-			                    pager.getPtr(),
-			                    link.get().getChildPage(),
-			                    ioMaxPriority,
-			                    false,
-			                    !options.present() || options.get().cacheResult || path.back().btPage()->height != 2),
+			Future<Reference<const ArenaPage>> page =
+			    readPage(btree,
+			             reason,
+			             path.back().btPage()->height - 1,
+			             pager.getPtr(),
+			             link.get().getChildPage(),
+			             ioMaxPriority,
+			             false,
+			             !options.present() || options.get().cacheResult || path.back().btPage()->height != 2,
+			             scan);
+			if (!page.isReady()) {
+				pageWaitBytes += link.get().getChildPage().size() * btree->m_blockSize;
+			}
+			return map(page,
 			           [=](Reference<const ArenaPage> p) {
 				           BTreePage::BinaryTree::Cursor cursor = btree->getCursor(p.getPtr(), link);
 #if REDWOOD_DEBUG
@@ -7771,15 +8113,21 @@ public:
 
 		Future<Void> pushPage(BTreeNodeLinkRef id) {
 			debug_printf("pushPage(root=%s)\n", ::toString(id).c_str());
-			return map(readPage(btree, reason, btree->m_header.height, pager.getPtr(), id, ioMaxPriority, false, true),
-			           [=](Reference<const ArenaPage> p) {
+			Future<Reference<const ArenaPage>> page =
+			    readPage(btree, reason, btree->m_header.height, pager.getPtr(), id, ioMaxPriority, false, true, scan);
+			if (!page.isReady()) {
+				pageWaitBytes += id.size() * btree->m_blockSize;
+			}
+			return map(
+			    page,
+			    [=](Reference<const ArenaPage> p) {
 #if REDWOOD_DEBUG
-				           path.push_back({ p, btree->getCursor(p.getPtr(), dbBegin, dbEnd), id });
+				    path.push_back({ p, btree->getCursor(p.getPtr(), dbBegin, dbEnd), id });
 #else
-					    path.push_back({ p, btree->getCursor(p.getPtr(), dbBegin, dbEnd) });
+				    path.push_back({ p, btree->getCursor(p.getPtr(), dbBegin, dbEnd) });
 #endif
-				           return Void();
-			           });
+				    return Void();
+			    });
 		}
 
 		// Initialize or reinitialize cursor
@@ -7791,7 +8139,14 @@ public:
 			btree = btree_in;
 			reason = reason_in;
 			options = options_in;
+			// Fetches and low priority reads such as consistency scans and backups tend to touch a large range
+			// exactly once, so they must not displace the working set of other reads.
+			scan = reason == PagerEventReasons::FetchRange ||
+			       (options.present() &&
+			        (options.get().type == ReadType::FETCH || options.get().type == ReadType::LOW));
 			pager = pager_in;
+			prefetchState = PrefetchState();
+			pageWaitBytes = 0;
 			path.clear();
 			path.reserve(6);
 			valid = false;
@@ -7855,7 +8210,9 @@ public:
 
 		Future<Void> seekGTE(RedwoodRecordRef query) { return seekGTE_impl(this, query); }
 
-		// Start fetching sibling nodes in the forward or backward direction, stopping after recordLimit or byteLimit
+		// Start fetching sibling nodes in the forward or backward direction, stopping after recordLimit or byteLimit.
+		// At most REDWOOD_KVSTORE_RANGE_PREFETCH_WINDOW_PAGES siblings are read ahead of the cursor at a time, and
+		// continuePrefetch() must be called each time the cursor moves to another leaf to keep the window full.
 		void prefetch(KeyRef rangeEnd, bool directionForward, int recordLimit, int byteLimit) {
 			// Prefetch scans level 2 so if there are less than 2 nodes in the path there is no level 2
 			if (path.size() < 2) {
@@ -7866,48 +8223,34 @@ public:
 
 			// We know the first leaf's record count, so assume they are all relevant to the query,
 			// even though some may not be.
-			int recordsRead = firstLeaf->tree()->numItems;
-
 			// We can't know for sure how many records are in a node without reading it, so just guess
 			// that siblings have about the same record count as the first leaf.
-			int estRecordsPerPage = recordsRead;
+			prefetchState.estRecordsPerPage = firstLeaf->tree()->numItems;
+			prefetchState.recordsLeft = recordLimit - prefetchState.estRecordsPerPage;
 
 			// Use actual KVBytes stored for the first leaf, but use node capacity for siblings below
-			int bytesRead = firstLeaf->kvBytes;
+			prefetchState.bytesLeft = byteLimit - firstLeaf->kvBytes;
 
-			// Cursor for moving through siblings.
-			// Note that only immediate siblings under the same parent are considered for prefetch so far.
-			BTreePage::BinaryTree::Cursor c = path[path.size() - 2].cursor;
-			ASSERT(path[path.size() - 2].btPage()->height == 2);
+			prefetchState.rangeEnd = rangeEnd;
+			prefetchState.directionForward = directionForward;
+			prefetchState.active = true;
+			startPrefetchUnderParent();
+		}
 
-			// The loop conditions are split apart into different if blocks for readability.
-			// While query limits are not exceeded
-			while (recordsRead < recordLimit && bytesRead < byteLimit) {
-				// If prefetching right siblings
-				if (directionForward) {
-					// If there is no right sibling or its lower boundary is greater
-					// or equal to than the range end then stop.
-					if (!c.moveNext() || c.get().key >= rangeEnd) {
-						break;
-					}
-				} else {
-					// Prefetching left siblings
-					// If the current leaf lower boundary is less than or equal to the range end
-					// or there is no left sibling then stop
-					if (c.get().key <= rangeEnd || !c.movePrev()) {
-						break;
-					}
-				}
+		// Keep the prefetch window started by prefetch() full after the cursor has moved to another leaf
+		void continuePrefetch() {
+			if (!prefetchState.active || path.size() < 2) {
+				return;
+			}
 
-				// Prefetch the sibling if the link is not null
-				if (c.get().value.present()) {
-					BTreeNodeLinkRef childPage = c.get().getChildPage();
-					if (childPage.size() > 0)
-						preLoadPage(pager.getPtr(), childPage, ioLeafPriority);
-					recordsRead += estRecordsPerPage;
-					// Use sibling node capacity as an estimate of bytes read.
-					bytesRead += childPage.size() * this->btree->m_blockSize;
-				}
+			if (path[path.size() - 2].page != prefetchState.parent) {
+				// The cursor moved on to the children of another parent, the leaf it is now on was read on demand
+				prefetchState.recordsLeft -= prefetchState.estRecordsPerPage;
+				prefetchState.bytesLeft -= path.back().btPage()->kvBytes;
+				startPrefetchUnderParent();
+			} else {
+				// The leaf the cursor moved to was the oldest prefetch in the window, so issue one more
+				prefetchSiblings(1);
 			}
 		}
 
@@ -7983,6 +8326,85 @@ public:
 
 		Future<Void> moveNext() { return path.empty() ? Void() : move_impl(this, true); }
 		Future<Void> movePrev() { return path.empty() ? Void() : move_impl(this, false); }
+
+	private:
+		void startPrefetchUnderParent() {
+			// Cursor for moving through siblings.
+			// Note that only immediate siblings under the same parent are considered until the cursor reaches
+			// the next parent.
+			ASSERT(path[path.size() - 2].btPage()->height == 2);
+			prefetchState.parent = path[path.size() - 2].page;
+			prefetchState.siblings = path[path.size() - 2].cursor;
+			prefetchState.parentDone = false;
+			prefetchSiblings(SERVER_KNOBS->REDWOOD_KVSTORE_RANGE_PREFETCH_WINDOW_PAGES);
+		}
+
+		// Issue reads for up to count more siblings of the current leaf that are within the prefetch limits
+		void prefetchSiblings(int count) {
+			BTreePage::BinaryTree::Cursor& c = prefetchState.siblings;
+
+			// The loop conditions are split apart into different if blocks for readability.
+			// While query limits are not exceeded
+			while (count > 0 && !prefetchState.parentDone) {
+				if (prefetchState.recordsLeft <= 0 || prefetchState.bytesLeft <= 0) {
+					prefetchState.active = false;
+					break;
+				}
+
+				// If prefetching right siblings
+				if (prefetchState.directionForward) {
+					// If there is no right sibling then stop until the cursor reaches the next parent, and if its
+					// lower boundary is greater or equal to than the range end then stop for good.
+					if (!c.moveNext()) {
+						prefetchState.parentDone = true;
+						break;
+					}
+					if (c.get().key >= prefetchState.rangeEnd) {
+						prefetchState.active = false;
+						break;
+					}
+				} else {
+					// Prefetching left siblings
+					// If the current leaf lower boundary is less than or equal to the range end then stop for good,
+					// and if there is no left sibling then stop until the cursor reaches the next parent.
+					if (c.get().key <= prefetchState.rangeEnd) {
+						prefetchState.active = false;
+						break;
+					}
+					if (!c.movePrev()) {
+						prefetchState.parentDone = true;
+						break;
+					}
+				}
+
+				// Prefetch the sibling if the link is not null
+				if (c.get().value.present()) {
+					BTreeNodeLinkRef childPage = c.get().getChildPage();
+					if (childPage.size() > 0)
+						preLoadPage(pager.getPtr(), childPage, ioLeafPriority, scan);
+					prefetchState.recordsLeft -= prefetchState.estRecordsPerPage;
+					// Use sibling node capacity as an estimate of bytes read.
+					prefetchState.bytesLeft -= childPage.size() * this->btree->m_blockSize;
+					--count;
+				}
+			}
+		}
+
+		// Read-ahead position and remaining budget of a range read using prefetch()
+		struct PrefetchState {
+			bool active = false;
+			// Whether all siblings under parent have been prefetched
+			bool parentDone = false;
+			bool directionForward;
+			Key rangeEnd;
+			int estRecordsPerPage;
+			int recordsLeft;
+			int bytesLeft;
+			// Parent of the leaves being prefetched and a cursor at the last sibling prefetched
+			Reference<const ArenaPage> parent;
+			BTreePage::BinaryTree::Cursor siblings;
+		};
+		PrefetchState prefetchState;
 	};
 
 	Future<Void> initBTreeCursor(BTreeCursor* cursor,
@@ -8231,6 +8653,9 @@ public:
 				}
 				cur.popPath();
 				wait(cur.moveNext());
+				if (self->prefetch) {
+					cur.continuePrefetch();
+				}
 			}
 		} else {
 			f = cur.seekLT(keys.end);
@@ -8286,11 +8711,15 @@ public:
 				}
 				cur.popPath();
 				wait(cur.movePrev());
+				if (self->prefetch) {
+					cur.continuePrefetch();
+				}
 			}
 		}
 
 		result.more = rowLimit == 0 || accumulatedBytes >= byteLimit;
 		g_redwoodMetrics.kvSizeReadByGetRange->sample(accumulatedBytes);
+		self->sampleReadCost(keys.begin, cur);
 		return result;
 	}
 
@@ -8303,6 +8732,7 @@ public:
 
 		++g_redwoodMetrics.metric.opGet;
 		wait(cur.seekGTE(key));
+		self->sampleReadCost(key, cur);
 		if (cur.isValid() && cur.get().key == key) {
 			// Return a Value whose arena depends on the source page arena
 			Value v;
@@ -8328,9 +8758,26 @@ public:
 		}));
 	}
 
+	std::vector<std::pair<Key, int64_t>> takeReadCostSamples() override {
+		std::vector<std::pair<Key, int64_t>> samples;
+		samples.swap(m_readCostSamples);
+		return samples;
+	}
+
 	~KeyValueStoreRedwood() override {};
 
 private:
+	// Record the page read cost a read waited on beyond the cache, attributed to the first key of the read
+	void sampleReadCost(KeyRef key, const VersionedBTree::BTreeCursor& cur) {
+		if (cur.getPageWaitBytes() > 0 && SERVER_KNOBS->READ_SAMPLING_ENABLED) {
+			if (m_readCostSamples.size() < SERVER_KNOBS->REDWOOD_READ_COST_SAMPLES_MAX) {
+				m_readCostSamples.emplace_back(key, cur.getPageWaitBytes());
+			} else {
+				CODE_PROBE(true, "Redwood read cost samples dropped");
+			}
+		}
+	}
+
 	std::string m_filename;
 	VersionedBTree* m_tree;
 	Future<Void> m_init;
@@ -8340,6 +8787,8 @@ private:
 	Version m_nextCommitVersion;
 	Reference<IPageEncryptionKeyProvider> m_keyProvider;
 	Future<Void> m_lastCommit = Void();
+	// Read costs not yet taken by takeReadCostSamples()
+	std::vector<std::pair<Key, int64_t>> m_readCostSamples;
 
 	template <typename T>
 	inline Future<T> catchError(Future<T> f) {
@@ -8868,6 +9317,9 @@ void RedwoodMetrics::getFields(TraceEvent* e, std::string* s, bool skipZeroes) {
 		                                               { "OpGetRange", metric.opGetRange },
 		                                               { "OpCommit", metric.opCommit },
 		                                               { "", 0 },
+		                                               { "LazyClearFreedPages", metric.lazyClearFreedPages },
+		                                               { "LazyClearBacklog", gauge.lazyClearBacklog },
+		                                               { "", 0 },
 		                                               { "PagerDiskWrite", metric.pagerDiskWrite },
 		                                               { "PagerDiskRead", metric.pagerDiskRead },
 		                                               { "PagerCacheHit", metric.pagerCacheHit },
@@ -8877,10 +9329,17 @@ void RedwoodMetrics::getFields(TraceEvent* e, std::string* s, bool skipZeroes) {
 		                                               { "PagerProbeMiss", metric.pagerProbeMiss },
 		                                               { "PagerEvictUnhit", metric.pagerEvictUnhit },
 		                                               { "PagerEvictFail", metric.pagerEvictFail },
+		                                               { "PagerCachePromote", metric.pagerCachePromote },
+		                                               { "", 0 },
+		                                               { "PagerCompressedHit", metric.pagerCompressedHit },
+		                                               { "PagerCompressedAdmit", metric.pagerCompressedAdmit },
+		                                               { "PagerCompressedReject", metric.pagerCompressedReject },
 		                                               { "", 0 },
 		                                               { "PagerRemapFree", metric.pagerRemapFree },
 		                                               { "PagerRemapCopy", metric.pagerRemapCopy },
 		                                               { "PagerRemapSkip", metric.pagerRemapSkip },
+		                                               { "PagerRemapPaced", metric.pagerRemapPaced },
+		                                               { "PagerRemapBacklog", gauge.pagerRemapBacklog },
 		                                               { "", 0 },
 		                                               { "ReadRequestDecryptTimeNS", metric.readRequestDecryptTimeNS },
 		                                               { "", 0 } };
@@ -9329,6 +9788,60 @@ TEST_CASE("Lredwood/correctness/unit/deltaTree/RedwoodRecordRef") {
 	return Void();
 }
 
+// Records on a page are delta encoded against whichever of their ancestors or page boundaries shares the longest
+// key prefix, so a prefix shared by every record and by the page boundaries should not be stored in the page at all.
+TEST_CASE("/redwood/correctness/unit/deltaTree/SharedPrefix") {
+	const int N = deterministicRandom()->randomInt(50, 200);
+	const std::string prefix = deterministicRandom()->randomAlphaNumeric(deterministicRandom()->randomInt(30, 61));
+
+	Arena arena;
+	std::set<std::string> suffixes;
+	while (suffixes.size() < N) {
+		suffixes.insert(deterministicRandom()->randomAlphaNumeric(deterministicRandom()->randomInt(1, 20)));
+	}
+
+	std::vector<RedwoodRecordRef> plain;
+	std::vector<RedwoodRecordRef> prefixed;
+	for (auto& suffix : suffixes) {
+		ValueRef v = StringRef(arena, deterministicRandom()->randomAlphaNumeric(8));
+		plain.push_back(RedwoodRecordRef(StringRef(arena, suffix), v));
+		prefixed.push_back(RedwoodRecordRef(StringRef(arena, prefix + suffix), v));
+	}
+
+	RedwoodRecordRef plainPrev;
+	RedwoodRecordRef plainNext("\xff"_sr);
+	RedwoodRecordRef prefixedPrev(StringRef(arena, prefix));
+	RedwoodRecordRef prefixedNext(StringRef(arena, prefix + "\xff"));
+
+	int bufferSize = N * 100;
+	std::unique_ptr<uint8_t[]> plainBuffer(new uint8_t[bufferSize]);
+	std::unique_ptr<uint8_t[]> prefixedBuffer(new uint8_t[bufferSize]);
+	DeltaTree2<RedwoodRecordRef>* plainTree = (DeltaTree2<RedwoodRecordRef>*)plainBuffer.get();
+	DeltaTree2<RedwoodRecordRef>* prefixedTree = (DeltaTree2<RedwoodRecordRef>*)prefixedBuffer.get();
+	plainTree->build(bufferSize, &plain[0], &plain[plain.size()], &plainPrev, &plainNext);
+	prefixedTree->build(bufferSize, &prefixed[0], &prefixed[prefixed.size()], &prefixedPrev, &prefixedNext);
+
+	printf("Count=%d  PrefixLen=%d  PlainSize=%d  PrefixedSize=%d\n",
+	       N,
+	       (int)prefix.size(),
+	       (int)plainTree->size(),
+	       (int)prefixedTree->size());
+	ASSERT(prefixedTree->size() == plainTree->size());
+
+	DeltaTree2<RedwoodRecordRef>::Cursor c(
+	    makeReference<DeltaTree2<RedwoodRecordRef>::DecodeCache>(prefixedPrev, prefixedNext), prefixedTree);
+	int i = 0;
+	c.moveFirst();
+	while (c.valid()) {
+		ASSERT(c.get() == prefixed[i]);
+		c.moveNext();
+		++i;
+	}
+	ASSERT(i == N);
+
+	return Void();
+}
+
 TEST_CASE("Lredwood/correctness/unit/deltaTree/RedwoodRecordRef2") {
 	// Sanity check on delta tree node format
 	ASSERT(DeltaTree2<RedwoodRecordRef>::Node::headerSize(false) == 4);
@@ -10057,6 +10570,103 @@ struct ReallySimpleCounter {
 	std::string toString() { return format("%" PRId64 "/%.2f/%.2f", x, rate() / 1e6, avgRate() / 1e6); }
 };
 
+template <class Buffer>
+static void mutationBufferSet(Buffer& buffer, KeyRef key, ValueRef value) {
+	buffer.insert(key).mutation().setBoundaryValue(buffer.copyToArena(value));
+}
+
+template <class Buffer>
+static void mutationBufferClear(Buffer& buffer, KeyRangeRef range) {
+	auto iBegin = buffer.insert(range.begin);
+	auto iEnd = buffer.insert(range.end);
+	iBegin.mutation().clearAll();
+	++iBegin;
+	buffer.erase(iBegin, iEnd);
+}
+
+// Returns the boundaries of buffer in order, checking that iterating backwards visits the same boundaries
+template <class Buffer>
+static std::vector<std::string> mutationBufferContents(Buffer& buffer) {
+	std::vector<std::string> contents;
+	auto i = buffer.lower_bound(VersionedBTree::dbBegin.key);
+	while (true) {
+		contents.push_back(printable(i.key()) + " " + i.mutation().toString());
+		if (i.key() == VersionedBTree::dbEnd.key) {
+			break;
+		}
+		++i;
+	}
+	for (int j = contents.size() - 1; j >= 0; --j) {
+		ASSERT(contents[j] == printable(i.key()) + " " + i.mutation().toString());
+		if (j > 0) {
+			--i;
+		}
+	}
+	return contents;
+}
+
+TEST_CASE("/redwood/correctness/unit/mutationBuffer") {
+	VersionedBTree::MutationBufferART art;
+	VersionedBTree::MutationBufferStdMap map;
+	Arena arena;
+
+	// Short keys make boundaries collide often, and a few keys are longer than the radix tree's initial search stack
+	std::string longPrefix(deterministicRandom()->randomInt(10000, 20000), 'a');
+	auto randomKey = [&]() {
+		KeyRef suffix = randomString(arena, deterministicRandom()->randomInt(0, 4));
+		if (deterministicRandom()->random01() < 0.05) {
+			return KeyRef(arena, longPrefix + suffix.toString());
+		}
+		return suffix;
+	};
+
+	int ops = deterministicRandom()->randomInt(100, 2000);
+	for (int i = 0; i < ops; ++i) {
+		KeyRef key = randomKey();
+		if (deterministicRandom()->coinflip()) {
+			ValueRef value = randomString(arena, deterministicRandom()->randomInt(0, 10));
+			mutationBufferSet(art, key, value);
+			mutationBufferSet(map, key, value);
+		} else {
+			KeyRef end = randomKey();
+			if (end < key) {
+				std::swap(key, end);
+			}
+			if (key == end) {
+				end = keyAfter(end, arena);
+			}
+			mutationBufferClear(art, KeyRangeRef(key, end));
+			mutationBufferClear(map, KeyRangeRef(key, end));
+		}
+
+		KeyRef probe = randomKey();
+		ASSERT(art.lower_bound(probe).key() == map.lower_bound(probe).key());
+		ASSERT(art.upper_bound(probe).key() == map.upper_bound(probe).key());
+	}
+
+	ASSERT(mutationBufferContents(art) == mutationBufferContents(map));
+
+	return Void();
+}
+
+template <class Buffer>
+static void mutationBufferInsertFind(const char* name, const std::vector<KeyRef>& strings) {
+	fmt::print("{}: Inserting {} elements and then finding each string...\n", name, strings.size());
+	double start = timer();
+	double startCPU = getProcessorTimeThread();
+	Buffer m;
+	for (const KeyRef& key : strings) {
+		auto a = m.insert(key);
+		auto b = m.lower_bound(key);
+		ASSERT(a == b);
+		m.erase(a, b);
+	}
+
+	double elapsed = timer() - start;
+	double cpu = getProcessorTimeThread() - startCPU;
+	printf("%s: count=%zu elapsed=%f cpu=%f\n", name, strings.size(), elapsed, cpu);
+}
+
 TEST_CASE(":/redwood/performance/mutationBuffer") {
 	// This test uses pregenerated short random keys
 	int count = 10e6;
@@ -10068,19 +10678,59 @@ TEST_CASE(":/redwood/performance/mutationBuffer") {
 		strings.push_back(randomString(arena, 5));
 	}
 
-	fmt::print("Inserting {} elements and then finding each string...\n", count);
-	double start = timer();
-	VersionedBTree::MutationBuffer m;
-	for (int i = 0; i < count; ++i) {
-		KeyRef key = strings[i];
-		auto a = m.insert(key);
-		auto b = m.lower_bound(key);
-		ASSERT(a == b);
-		m.erase(a, b);
+	mutationBufferInsertFind<VersionedBTree::MutationBufferART>("ART", strings);
+	mutationBufferInsertFind<VersionedBTree::MutationBufferStdMap>("std::map", strings);
+
+	return Void();
+}
+
+struct AlwaysEvictable {
+	bool evictable() const { return true; }
+	Future<Void> onEvictable() const { return Void(); }
+	Future<Void> cancel() const { return Void(); }
+};
+
+// Touch a hot set twice, then scan many more objects than fit in the cache and count how many hot objects survived
+static int hotObjectsAfterScan(double protectedFraction, bool scanHint) {
+	typedef ObjectCache<LogicalPageID, AlwaysEvictable> CacheT;
+	const int hotCount = 20;
+	CacheT::Evictor evictor(100);
+	evictor.protectedFraction = protectedFraction;
+	int survivors = 0;
+	{
+		CacheT cache(&evictor);
+		for (int round = 0; round < 2; ++round) {
+			for (LogicalPageID id = 0; id < hotCount; ++id) {
+				cache.get(id, 1);
+			}
+		}
+		for (LogicalPageID id = 1000; id < 2000; ++id) {
+			// Scans commonly touch each page more than once as a cursor moves through it
+			cache.get(id, 1, false, scanHint);
+			cache.get(id, 1, false, scanHint);
+		}
+		ASSERT(evictor.getSizeUsed() <= evictor.sizeLimit);
+		for (LogicalPageID id = 0; id < hotCount; ++id) {
+			if (cache.getIfExists(id) != nullptr) {
+				++survivors;
+			}
+		}
+		Future<Void> cleared = cache.clear();
+		ASSERT(cleared.isReady());
 	}
+	ASSERT(evictor.empty());
+	return survivors;
+}
 
-	double elapsed = timer() - start;
-	printf("count=%d elapsed=%f\n", count, elapsed);
+TEST_CASE("/redwood/correctness/unit/ObjectCache/ScanResistance") {
+	// Plain LRU loses the whole hot set to a large scan
+	ASSERT(hotObjectsAfterScan(0, false) == 0);
+	ASSERT(hotObjectsAfterScan(0, true) == 0);
+
+	// With a protected segment, objects that were reused survive a scan as long as the scan does not reuse its pages
+	ASSERT(hotObjectsAfterScan(0.5, true) == 20);
+	// A scan which does reuse its pages without the hint churns through the protected segment
+	ASSERT(hotObjectsAfterScan(0.5, false) == 0);
 
 	return Void();
 }
@@ -11628,3 +12278,114 @@ TEST_CASE("/redwood/correctness/EnforceEncodingType") {
 	}
 	return Void();
 }
+
+// Returns sorted records with keys prefix + [begin, end)
+static Standalone<VectorRef<KeyValueRef>> replaceRangeRecords(std::string prefix, int begin, int end, int valueSize) {
+	Standalone<VectorRef<KeyValueRef>> records;
+	for (int i = begin; i < end; ++i) {
+		records.push_back_deep(records.arena(),
+		                       KeyValueRef(StringRef(prefix + format("%08d", i)),
+		                                   StringRef(deterministicRandom()->randomAlphaNumeric(valueSize))));
+	}
+	return records;
+}
+
+ACTOR static Future<Void> verifyReplaceRangeContents(IKeyValueStore* kvs, Standalone<VectorRef<KeyValueRef>> expected) {
+	RangeResult result = wait(kvs->readRange(KeyRangeRef(""_sr, "\xff"_sr)));
+	ASSERT_EQ(result.size(), expected.size());
+	for (int i = 0; i < expected.size(); ++i) {
+		ASSERT(result[i] == expected[i]);
+	}
+	return Void();
+}
+
+// Replaces ranges the way fetchKeys does, with storage metadata written in the same commits
+TEST_CASE("/redwood/correctness/ReplaceRange") {
+	state int valueSize = deterministicRandom()->randomInt(0, 500);
+	state Standalone<VectorRef<KeyValueRef>> first = replaceRangeRecords("a", 0, 20000, valueSize);
+	state Standalone<VectorRef<KeyValueRef>> second = replaceRangeRecords("b", 0, 5000, valueSize);
+	state Standalone<VectorRef<KeyValueRef>> expected;
+
+	deleteFile("test.redwood-v1");
+	state IKeyValueStore* kvs = openKVStore(KeyValueStoreType::SSD_REDWOOD_V1, "test.redwood-v1", UID(), 0);
+	wait(kvs->init());
+
+	wait(kvs->replaceRange(KeyRangeRef("a"_sr, "b"_sr), first));
+	wait(kvs->replaceRange(KeyRangeRef("b"_sr, "c"_sr), second));
+	kvs->set(KeyValueRef("\xff\xff/version"_sr, "1"_sr));
+	wait(kvs->commit());
+	expected.append_deep(expected.arena(), first.begin(), first.size());
+	expected.append_deep(expected.arena(), second.begin(), second.size());
+	wait(verifyReplaceRangeContents(kvs, expected));
+
+	// Replacing a range drops the records it held, and a set after the replacement wins
+	state Standalone<VectorRef<KeyValueRef>> replacement = replaceRangeRecords("a", 10000, 15000, valueSize);
+	wait(kvs->replaceRange(KeyRangeRef("a"_sr, "b"_sr), replacement));
+	kvs->set(KeyValueRef("a99999999"_sr, "x"_sr));
+	kvs->set(KeyValueRef("\xff\xff/version"_sr, "2"_sr));
+	wait(kvs->commit());
+	expected = replacement;
+	expected.push_back_deep(expected.arena(), KeyValueRef("a99999999"_sr, "x"_sr));
+	expected.append_deep(expected.arena(), second.begin(), second.size());
+	wait(verifyReplaceRangeContents(kvs, expected));
+
+	// Reopen and verify again
+	wait(closeKVS(kvs));
+	kvs = openKVStore(KeyValueStoreType::SSD_REDWOOD_V1, "test.redwood-v1", UID(), 0);
+	wait(kvs->init());
+	wait(verifyReplaceRangeContents(kvs, expected));
+	Optional<Value> version = wait(kvs->readValue("\xff\xff/version"_sr));
+	ASSERT(version.present() && version.get() == "2"_sr);
+
+	wait(closeKVS(kvs, true /*dispose*/));
+	return Void();
+}
+
+// Reads a store whose page cache holds a fraction of its leaf pages, so that they are evicted into the compressed page
+// cache and read back from it
+TEST_CASE("/redwood/correctness/CompressedPageCache") {
+	if (!CompressionUtils::supportedFilters.contains(
+	        CompressionUtils::fromFilterString(SERVER_KNOBS->REDWOOD_COMPRESSED_PAGE_CACHE_FILTER))) {
+		return Void();
+	}
+	// Restore the knob however the test ends, so a failure does not leak the setting into later tests
+	state ScopeExit<std::function<void()>> restoreKnob(
+	    [compressedPageCacheBytes = SERVER_KNOBS->REDWOOD_COMPRESSED_PAGE_CACHE_BYTES]() {
+		    IKnobCollection::getMutableGlobalKnobCollection().setKnob("redwood_compressed_page_cache_bytes",
+		                                                              KnobValueRef::create(compressedPageCacheBytes));
+	    });
+	IKnobCollection::getMutableGlobalKnobCollection().setKnob("redwood_compressed_page_cache_bytes",
+	                                                          KnobValueRef::create(int64_t{ 100000000 }));
+
+	// Values repeat a single character, so that leaf pages compress well
+	state Standalone<VectorRef<KeyValueRef>> expected;
+	for (int i = 0; i < 20000; ++i) {
+		expected.push_back_deep(expected.arena(),
+		                        KeyValueRef(StringRef(format("%08d", i)), StringRef(std::string(100, 'a' + i % 4))));
+	}
+
+	deleteFile("test.redwood-v1");
+	state IKeyValueStore* kvs = new KeyValueStoreRedwood("test.redwood-v1",
+	                                                     UID(),
+	                                                     {}, // db
+	                                                     EncryptionAtRestMode::DISABLED,
+	                                                     EncodingType::XXHash64,
+	                                                     makeReference<NullEncryptionKeyProvider>(),
+	                                                     100000 /* pageCacheBytes */);
+	wait(kvs->init());
+	for (const auto& kv : expected) {
+		kvs->set(kv);
+	}
+	wait(kvs->commit());
+
+	// Pages read back from the compressed page cache are verified like pages read from disk
+	state int pass = 0;
+	for (; pass < 3; ++pass) {
+		wait(verifyReplaceRangeContents(kvs, expected));
+	}
+	ASSERT(g_redwoodMetrics.metric.pagerCompressedAdmit > 0);
+	ASSERT(g_redwoodMetrics.metric.pagerCompressedHit > 0);
+
+	wait(closeKVS(kvs, true /*dispose*/));
+	return Void();
+}
@@ -106,6 +106,10 @@ public:
 		mutations->insert(dbEnd.key, rm);
 	}
 
+	// The tree allocates from arena by address, so the buffer can be neither copied nor moved
+	MutationBufferART(const MutationBufferART&) = delete;
+	MutationBufferART& operator=(const MutationBufferART&) = delete;
+
 	// Return a T constructed in arena
 	template <typename T>
 	T copyToArena(const T& object) {
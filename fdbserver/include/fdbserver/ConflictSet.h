@@ -75,6 +75,7 @@ private:
 	void checkIntraBatchConflicts();
 	void combineWriteConflictRanges();
 	void checkReadConflictRanges();
+	void checkReadConflictRangesParallel();
 	void mergeWriteConflictRanges(Version now);
 	void addConflictRanges(Version now,
 	                       std::vector<std::pair<StringRef, StringRef>>::iterator begin,
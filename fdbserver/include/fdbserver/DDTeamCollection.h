@@ -388,9 +388,18 @@ protected:
 
 	bool isMachineHealthy(Reference<TCMachineInfo> const& machine) const;
 
+	// Return the healthy machines with valid locality which are on the least number of machine teams
+	std::vector<Reference<TCMachineInfo>> getLeastUsedMachines() const;
+
+	// Return the healthy servers with the least number of correct-size server teams
+	std::vector<Reference<TCServerInfo>> getLeastUsedServers() const;
+
 	// Return the healthy server with the least number of correct-size server teams
 	Reference<TCServerInfo> findOneLeastUsedServer() const;
 
+	// Return a random one of leastUsedServers, as found by getLeastUsedServers()
+	Reference<TCServerInfo> chooseLeastUsedServer(std::vector<Reference<TCServerInfo>> const& leastUsedServers) const;
+
 	// A server team should always come from servers on a machine team
 	// Check if it is true
 	bool isOnSameMachineTeam(TCTeamInfo const& team) const;
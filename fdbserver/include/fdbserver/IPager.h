@@ -728,13 +728,15 @@ public:
 	                                                           LogicalPageID pageID,
 	                                                           int priority,
 	                                                           bool cacheable,
-	                                                           bool nohit) = 0;
+	                                                           bool nohit,
+	                                                           bool scan) = 0;
 	virtual Future<Reference<const ArenaPage>> getMultiPhysicalPage(PagerEventReasons reason,
 	                                                                unsigned int level,
 	                                                                VectorRef<LogicalPageID> pageIDs,
 	                                                                int priority,
 	                                                                bool cacheable,
-	                                                                bool nohit) = 0;
+	                                                                bool nohit,
+	                                                                bool scan) = 0;
 	virtual Version getVersion() const = 0;
 
 	virtual Key getMetaKey() const = 0;
@@ -810,18 +812,22 @@ public:
 	// Cacheable indicates that the page should be added to the page cache (if applicable?) as a result of this read.
 	// NoHit indicates that the read should not be considered a cache hit, such as when preloading pages that are
 	// considered likely to be needed soon.
+	// Scan indicates that the read is part of a large or low priority scan, so a cache hit should not promote the
+	// page into the page cache's protected set.
 	virtual Future<Reference<ArenaPage>> readPage(PagerEventReasons reason,
 	                                              unsigned int level,
 	                                              PhysicalPageID pageIDs,
 	                                              int priority,
 	                                              bool cacheable,
-	                                              bool noHit) = 0;
+	                                              bool noHit,
+	                                              bool scan) = 0;
 	virtual Future<Reference<ArenaPage>> readMultiPage(PagerEventReasons reason,
 	                                                   unsigned int level,
 	                                                   VectorRef<PhysicalPageID> pageIDs,
 	                                                   int priority,
 	                                                   bool cacheable,
-	                                                   bool noHit) = 0;
+	                                                   bool noHit,
+	                                                   bool scan) = 0;
 
 	virtual Future<Reference<ArenaPage>> readExtent(LogicalPageID pageID) = 0;
 	virtual void releaseExtentReadLock() = 0;
@@ -878,6 +884,10 @@ public:
 	// increment/decrement the value at this pointer based on their memory footprint.
 	virtual int64_t* getPageCachePenaltySource() = 0;
 
+	// Returns the number of page reads and writes waiting for an IO slot, which background work can use to tell
+	// whether the disk has spare capacity.
+	virtual int getIOWaitersCount() const = 0;
+
 protected:
 	~IPager2() {} // Destruction should be done using close()/dispose() from the IClosable interface
 };
@@ -283,6 +283,8 @@ struct ILogSystem {
 		int bestServer, currentCursor, readQuorum;
 		Optional<LogMessageVersion> nextVersion;
 		LogMessageVersion messageVersion;
+		// The commit version to which every server cursor was last advanced while reading from the best server
+		Version advancedAllTo = invalidVersion;
 		bool hasNextMessage;
 		UID randomID;
 		int tLogReplicationFactor;
@@ -344,6 +346,8 @@ struct ILogSystem {
 		std::vector<std::pair<LogMessageVersion, int>> sortedVersions;
 		Optional<LogMessageVersion> nextVersion;
 		LogMessageVersion messageVersion;
+		// The commit version to which every server cursor was last advanced while reading from the best server
+		Version advancedAllTo = invalidVersion;
 		bool hasNextMessage;
 		bool useBestSet;
 		UID randomID;
@@ -821,7 +825,9 @@ struct LogPushData : NonCopyable {
 	template <class T>
 	void writeTypedMessage(T const& item, bool metadataMessage = false, bool allLocations = false);
 
-	Standalone<StringRef> getMessages(int loc) const { return messagesWriter[loc].toValue(); }
+	// Returns the messages for the given location as one contiguous, exactly sized buffer. Shared mutations are
+	// still copied into it, once per location: TLogCommitRequest needs contiguous messages.
+	Standalone<StringRef> getMessages(int loc) const;
 
 	// Returns all locations' messages, including empty ones.
 	std::vector<Standalone<StringRef>> getAllMessages() const;
@@ -851,6 +857,11 @@ private:
 	std::vector<Tag> prev_tags;
 	std::set<Tag> written_tags;
 	std::vector<BinaryWriter> messagesWriter;
+	// Large mutations going to several locations are serialized once; each location records the offset in its
+	// writer where those bytes belong, and getMessages() copies them in there.
+	std::vector<std::vector<std::pair<int, StringRef>>> sharedMessages;
+	Arena sharedMessagesArena;
+	int sharedMutationMinBytes;
 	std::vector<bool> messagesWritten; // if messagesWriter has written anything
 	std::vector<int> msg_locations;
 	Optional<std::vector<Reference<LocalitySet>>> fromLocations;
@@ -868,6 +879,10 @@ private:
 	// written.
 	bool writeTransactionInfo(int location, uint32_t subseq);
 
+	// Writes the message header for each of msg_locations and defers copying the already serialized message into
+	// each location until getMessages(), so it is neither serialized again nor copied into growing writers.
+	void writeSharedMessage(Standalone<StringRef> message, uint32_t subseq);
+
 	Tag chooseRouterTag() {
 		return savedRandomRouterTag.present() ? savedRandomRouterTag.get() : logSystem->getRandomRouterTag();
 	}
@@ -914,6 +929,16 @@ void LogPushData::writeTypedMessage(T const& item, bool metadataMessage, bool al
 	}
 
 	uint32_t subseq = this->subsequence++;
+	if constexpr (std::is_same_v<T, MutationRef>) {
+		if (msg_locations.size() > 1 && item.expectedSize() >= sharedMutationMinBytes) {
+			CODE_PROBE(true, "Mutation shared between TLog messages");
+			writeSharedMessage(BinaryWriter::toValue(item, AssumeVersion(g_network->protocolVersion())), subseq);
+			written_tags.insert(next_message_tags.begin(), next_message_tags.end());
+			next_message_tags.clear();
+			return;
+		}
+	}
+
 	bool first = true;
 	int firstOffset = -1, firstLength = -1;
 	for (int loc : msg_locations) {
@@ -105,6 +105,7 @@ public:
 
 	// control plane statistics associated with a real storage server
 	uint64_t totalDiskSpace = DEFAULT_DISK_SPACE, usedDiskSpace = DEFAULT_DISK_SPACE;
+	int64_t fetchedBytes = 0; // bytes of all the shards moved onto this server
 
 	// In-memory counterpart of the `serverKeys` in system keyspace
 	// the value ShardStatus is [InFlight, Completed, Empty] and metrics uint64_t is the shard size, the caveat is the
@@ -75,9 +75,18 @@ struct ProxyStats {
 	LatencySample commitBatchingEmptyMessageRatio;
 
 	LatencySample commitBatchingWindowSize;
+	LatencySample commitBatchingDesiredBytes;
 
 	LatencySample computeLatency;
 
+	// Latency of each stage of a commit batch after it has been queued (computeLatency), reported in status
+	LatencySample getCommitVersionSample;
+	LatencySample resolutionSample;
+	LatencySample postResolutionSample;
+	LatencySample processingMutationSample;
+	LatencySample tlogLoggingSample;
+	LatencySample replyCommitSample;
+
 	Future<Void> logger;
 
 	int64_t maxComputeNS;
@@ -147,10 +156,38 @@ struct ProxyStats {
 	                             id,
 	                             SERVER_KNOBS->LATENCY_METRICS_LOGGING_INTERVAL,
 	                             SERVER_KNOBS->LATENCY_SKETCH_ACCURACY),
+	    commitBatchingDesiredBytes("CommitBatchingDesiredBytes",
+	                               id,
+	                               SERVER_KNOBS->LATENCY_METRICS_LOGGING_INTERVAL,
+	                               SERVER_KNOBS->LATENCY_SKETCH_ACCURACY),
 	    computeLatency("ComputeLatency",
 	                   id,
 	                   SERVER_KNOBS->LATENCY_METRICS_LOGGING_INTERVAL,
 	                   SERVER_KNOBS->LATENCY_SKETCH_ACCURACY),
+	    getCommitVersionSample("CommitGetVersionLatency",
+	                           id,
+	                           SERVER_KNOBS->LATENCY_METRICS_LOGGING_INTERVAL,
+	                           SERVER_KNOBS->LATENCY_SKETCH_ACCURACY),
+	    resolutionSample("CommitResolutionLatency",
+	                     id,
+	                     SERVER_KNOBS->LATENCY_METRICS_LOGGING_INTERVAL,
+	                     SERVER_KNOBS->LATENCY_SKETCH_ACCURACY),
+	    postResolutionSample("CommitPostResolutionQueuingLatency",
+	                         id,
+	                         SERVER_KNOBS->LATENCY_METRICS_LOGGING_INTERVAL,
+	                         SERVER_KNOBS->LATENCY_SKETCH_ACCURACY),
+	    processingMutationSample("CommitProcessingMutationLatency",
+	                             id,
+	                             SERVER_KNOBS->LATENCY_METRICS_LOGGING_INTERVAL,
+	                             SERVER_KNOBS->LATENCY_SKETCH_ACCURACY),
+	    tlogLoggingSample("CommitTLogLoggingLatency",
+	                      id,
+	                      SERVER_KNOBS->LATENCY_METRICS_LOGGING_INTERVAL,
+	                      SERVER_KNOBS->LATENCY_SKETCH_ACCURACY),
+	    replyCommitSample("CommitReplyLatency",
+	                      id,
+	                      SERVER_KNOBS->LATENCY_METRICS_LOGGING_INTERVAL,
+	                      SERVER_KNOBS->LATENCY_SKETCH_ACCURACY),
 	    maxComputeNS(0), minComputeNS(1e12),
 	    commitBatchQueuingDist(
 	        Histogram::getHistogram("CommitProxy"_sr, "CommitBatchQueuing"_sr, Histogram::Unit::milliseconds)),
@@ -216,6 +253,10 @@ struct ProxyCommitData {
 	bool locked;
 	Optional<Value> metadataVersion;
 	double commitBatchInterval;
+	int commitBatchDesiredBytes = 0; // Byte size at which the batcher closes a batch
+	// Smoothed per-batch resolution and TLog push latencies, used when COMMIT_BATCH_ADAPTIVE_ENABLED
+	double smoothedResolutionLatency = 0;
+	double smoothedLoggingLatency = 0;
 	bool provisional;
 
 	int64_t localCommitBatchesStarted;
@@ -22,6 +22,7 @@
 #define FLOW__RADIXTREE_H
 #pragma once
 
+#include <algorithm>
 #include <cassert>
 #include <string>
 #include <utility>
@@ -339,6 +340,7 @@ private:
 	void delete_child4(node* parent, node* child);
 	// access
 	static int find_child(node* parent, int16_t ch); // return index
+	static int child_vector_lower_bound(internalNode* parent, int16_t ch); // index of the first child >= ch
 	static int child_size(node* parent); // how many children does parent node have
 	static node* get_child(node* parent, int index); // return node pointer
 
@@ -431,12 +433,7 @@ void radix_tree::add_child4(node* parent, node* child) {
 void radix_tree::add_child_vector(node* parent, node* child) {
 	int16_t ch = child->getFirstByte();
 	internalNode* parent_ref = (internalNode*)parent;
-	int i = 0;
-
-	for (; i < parent_ref->m_children.size(); ++i) {
-		if (parent_ref->m_children[i].first >= ch)
-			break;
-	}
+	int i = child_vector_lower_bound(parent_ref, ch);
 
 	if (parent_ref->m_children.empty() || i == parent_ref->m_children.size() || parent_ref->m_children[i].first > ch) {
 		parent_ref->m_children.insert(parent_ref->m_children.begin() + i, std::make_pair(ch, child));
@@ -480,13 +477,8 @@ void radix_tree::delete_child4(radix_tree::node* parent, radix_tree::node* child
 void radix_tree::delete_child_vector(radix_tree::node* parent, radix_tree::node* child) {
 	int16_t ch = child->getFirstByte();
 	internalNode* parent_ref = (internalNode*)parent;
-	int i = 0;
-
-	for (; i < parent_ref->m_children.size(); i++) {
-		if (parent_ref->m_children[i].first == ch)
-			break;
-	}
-	ASSERT(i != parent_ref->m_children.size());
+	int i = child_vector_lower_bound(parent_ref, ch);
+	ASSERT(i != parent_ref->m_children.size() && parent_ref->m_children[i].first == ch);
 	parent_ref->m_children.erase(parent_ref->m_children.begin() + i);
 	total_bytes -= (getElementBytes(child) + child->getArenaSize() + sizeof(std::pair<int16_t, void*>));
 	if (parent_ref->m_children.size() && parent_ref->m_children.size() <= parent_ref->m_children.capacity() / 4)
@@ -503,14 +495,23 @@ int radix_tree::find_child(radix_tree::node* parent, int16_t ch) {
 		}
 	} else {
 		internalNode* parent_ref = (internalNode*)parent;
-		for (; i != parent_ref->m_children.size(); ++i) {
-			if (parent_ref->m_children[i].first == ch)
-				return i;
+		i = child_vector_lower_bound(parent_ref, ch);
+		if (i != parent_ref->m_children.size() && parent_ref->m_children[i].first != ch) {
+			i = parent_ref->m_children.size();
 		}
 	}
 	return i;
 }
 
+// The children of an internalNode are kept sorted by their first byte, and there can be up to 257 of them
+int radix_tree::child_vector_lower_bound(internalNode* parent, int16_t ch) {
+	auto it = std::lower_bound(parent->m_children.begin(),
+	                           parent->m_children.end(),
+	                           ch,
+	                           [](const std::pair<int16_t, node*>& child, int16_t c) { return child.first < c; });
+	return it - parent->m_children.begin();
+}
+
 int radix_tree::child_size(radix_tree::node* parent) {
 	if (parent->m_is_fixed) {
 		return ((internalNode4*)parent)->num_children;
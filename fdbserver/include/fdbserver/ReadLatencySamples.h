@@ -35,6 +35,7 @@ public:
 		READ_VERSION_WAIT,
 		READ_QUEUE_WAIT,
 		KV_READ_RANGE,
+		KV_READ_VALUE,
 		MAPPED_RANGE,
 		MAPPED_RANGE_REMOTE,
 		MAPPED_RANGE_LOCAL,
@@ -101,6 +101,10 @@ struct StorageServerMetrics {
 
 	void notifyBytesReadPerKSecond(const Key& key, int64_t in);
 
+	// Adds read cost which is not part of any read's result size, such as storage engine cache misses, to the read
+	// bandwidth sample without counting another read operation
+	void notifyReadCost(const Key& key, int64_t in);
+
 	void notifyBytes(RangeMap<Key, std::vector<PromiseStream<StorageMetrics>>, KeyRangeRef>::iterator shard,
 	                 int64_t bytes);
 
@@ -0,0 +1,62 @@
+/*
+ * StorageReadService.h
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2025 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FDBSERVER_STORAGE_READ_SERVICE_H
+#define FDBSERVER_STORAGE_READ_SERVICE_H
+#pragma once
+
+#include <map>
+#include <memory>
+
+#include "fdbclient/NativeAPI.actor.h"
+#include "fdbclient/StorageServerInterface.h"
+
+// The storage servers running in this process. The worker keeps it up to date so that StorageReadService can read
+// from them. Only used on the main thread.
+struct LocalStorageServers {
+	std::map<UID, StorageServerInterface> interfaces;
+};
+
+#ifdef FLOW_GRPC_ENABLED
+#include <grpcpp/server_context.h>
+#include <grpcpp/support/status.h>
+
+#include "fdbrpc/FlowGrpc.h"
+#include "fdbserver/storage_read/storage_read.pb.h"
+#include "fdbserver/storage_read/storage_read.grpc.pb.h"
+
+// Streams snapshots of key ranges from the local storage servers to external bulk readers, see storage_read.proto.
+// Each chunk is read on the main thread and written from the gRPC thread, which blocks while HTTP/2 flow control
+// holds the stream back, so a slow reader never has more than one chunk read ahead.
+class StorageReadServiceImpl final : public fdbserver::StorageReadService::Service {
+public:
+	StorageReadServiceImpl(Database db, std::shared_ptr<LocalStorageServers> servers);
+
+	grpc::Status ReadRange(grpc::ServerContext* context,
+	                       const fdbserver::ReadRangeRequest* request,
+	                       grpc::ServerWriter<fdbserver::ReadRangeChunk>* writer) override;
+
+private:
+	Database db_;
+	std::shared_ptr<LocalStorageServers> servers_;
+};
+#endif // FLOW_GRPC_ENABLED
+
+#endif // FDBSERVER_STORAGE_READ_SERVICE_H
@@ -222,6 +222,10 @@ public:
 
 	Optional<int64_t> getLongestStorageQueueSize() const override;
 
+	// Whether a server of this team has its disk too busy, or is too far from making its writes durable, to take on
+	// more data
+	bool hasOverloadedServer() const;
+
 	Optional<int> getMaxOngoingBulkLoadTaskCount() const override;
 
 	int64_t getLoadBytes(bool includeInFlight = true, double inflightPenalty = 1.0) const override;
@@ -28,7 +28,10 @@ class TransactionTagCounter {
 	PImpl<class TransactionTagCounterImpl> impl;
 
 public:
-	TransactionTagCounter(UID thisServerID, int maxTagsTracked, double minRateTracked);
+	// At most maxTagsCounted distinct tags are counted in an interval, if it is positive. Beyond that, the tag with the
+	// lowest cost is replaced by each new one, so that any tag with more than 1/maxTagsCounted of the total cost is
+	// still counted.
+	TransactionTagCounter(UID thisServerID, int maxTagsTracked, double minRateTracked, int maxTagsCounted = 0);
 	~TransactionTagCounter();
 
 	// Update counters tracking the busyness of each tag in the current interval
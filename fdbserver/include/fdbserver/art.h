@@ -64,7 +64,8 @@ struct art_tree {
 #define ART_FAT_NODE_LEAF(node_ptr) (*((art_leaf**)(((char*)(node_ptr)) + ART_LEAF_DISPL(node_ptr))))
 
 // In Bytes
-// This is needed so that we can pre-allocate a static stack to perform efficient backtracking in iterative_bound
+// Initial size of the static stack used to perform efficient backtracking in iterative_bound, which grows if
+// longer keys are searched for
 #define ART_MAX_KEY_LEN 10000
 
 #define _mm_cmpge_epu8(a, b) _mm_cmpeq_epi8(_mm_max_epu8(a, b), a)
@@ -21,7 +21,12 @@
 #ifndef ART_IMPL_H
 #define ART_IMPL_H
 
-using art_tree = VersionedBTree::art_tree;
+// art.h is included inside a class body; the translation unit including this file names that class.
+#ifndef ART_IMPL_OWNER
+#define ART_IMPL_OWNER VersionedBTree
+#endif
+
+using art_tree = ART_IMPL_OWNER::art_tree;
 using art_leaf = art_tree::art_leaf;
 #define art_node art_tree::art_node
 
@@ -38,7 +43,7 @@ int art_tree::node_sizes[] = { 0,
 	                           sizeof(art_node48_kv),
 	                           sizeof(art_node256_kv) };
 
-VersionedBTree::art_iterator art_tree::insert(KeyRef& k, void* value) {
+ART_IMPL_OWNER::art_iterator art_tree::insert(KeyRef& k, void* value) {
 #define INIT_DEPTH 0
 #define REPLACE 1
 	int old_val = 0;
@@ -46,19 +51,19 @@ VersionedBTree::art_iterator art_tree::insert(KeyRef& k, void* value) {
 
 	if (!old_val)
 		this->size++;
-	return VersionedBTree::art_iterator(l);
+	return ART_IMPL_OWNER::art_iterator(l);
 }
 
-VersionedBTree::art_iterator art_tree::insert_if_absent(KeyRef& k, void* value, int* existing) {
+ART_IMPL_OWNER::art_iterator art_tree::insert_if_absent(KeyRef& k, void* value, int* existing) {
 #define INIT_DEPTH 0
 #define DONTREPLACE 0
 	art_leaf* l = iterative_insert(this->root, &this->root, k, value, INIT_DEPTH, existing, DONTREPLACE);
 	if (!existing)
 		this->size++;
-	return VersionedBTree::art_iterator(l);
+	return ART_IMPL_OWNER::art_iterator(l);
 }
 
-VersionedBTree::art_iterator art_tree::lower_bound(const KeyRef& key) {
+ART_IMPL_OWNER::art_iterator art_tree::lower_bound(const KeyRef& key) {
 	if (!size)
 		return art_iterator(nullptr);
 	art_node* n = root;
@@ -70,7 +75,7 @@ VersionedBTree::art_iterator art_tree::lower_bound(const KeyRef& key) {
 	return art_iterator(res);
 }
 
-VersionedBTree::art_iterator art_tree::upper_bound(const KeyRef& key) {
+ART_IMPL_OWNER::art_iterator art_tree::upper_bound(const KeyRef& key) {
 	if (!size)
 		return art_iterator(nullptr);
 	art_node* n = root;
@@ -164,9 +169,14 @@ art_leaf* art_tree::maximum(art_node* n) {
 
 void art_tree::art_bound_iterative(art_node* n, const KeyRef& k, int depth, art_leaf** result, bool strict) {
 
-	static stack_entry arena[ART_MAX_KEY_LEN]; // Single threaded implementation.
+	// Single threaded implementation. Each level descended consumes a byte of k, so the backtracking stack needs at
+	// most k.size() + 1 entries; grow it for keys longer than any seen so far rather than overrunning it.
+	static std::vector<stack_entry> arena(ART_MAX_KEY_LEN);
+	if (arena.size() <= k.size()) {
+		arena.resize(k.size() + 1);
+	}
 
-	stack_entry *head = nullptr, *curr_arena = arena;
+	stack_entry *head = nullptr, *curr_arena = arena.data();
 	int ret;
 	art_node** child;
 	unsigned char* key = (unsigned char*)k.begin();
@@ -20,6 +20,7 @@
 
 #include "fmt/format.h"
 #include "fdbserver/NetworkTest.h"
+#include "fdbrpc/DDSketch.h"
 #include "flow/Knobs.h"
 #include "flow/ActorCollection.h"
 #include "flow/UnitTest.h"
@@ -29,12 +30,14 @@
 #include "flow/actorcompiler.h" // This must be the last #include.
 
 constexpr int WLTOKEN_NETWORKTEST = WLTOKEN_FIRST_AVAILABLE;
+constexpr int WLTOKEN_NETWORKTEST_STREAM = WLTOKEN_FIRST_AVAILABLE + 1;
 
 struct LatencyStats {
 	using sample = double;
 	double x = 0;
 	double x2 = 0;
 	double n = 0;
+	DDSketch<double> sketch;
 
 	sample tick() {
 		// now() returns the timestamp when we were scheduled; count
@@ -50,22 +53,30 @@ struct LatencyStats {
 		x += delta;
 		x2 += (delta * delta);
 		n++;
+		sketch.addSample(delta);
 	}
 
 	void reset() { *this = LatencyStats(); }
 	double mean() { return x / n; }
 	double stddev() { return sqrt(x2 / n - (x / n) * (x / n)); }
+	double percentile(double p) { return sketch.percentile(p); }
 };
 
+// Returns a size drawn uniformly from [size, maxSize], or size if maxSize does not exceed it
+static int networkTestSize(int size, int maxSize) {
+	return maxSize > size ? deterministicRandom()->randomInt(size, maxSize + 1) : size;
+}
+
 NetworkTestInterface::NetworkTestInterface(NetworkAddress remote)
-  : test(Endpoint::wellKnown({ remote }, WLTOKEN_NETWORKTEST)) {}
+  : test(Endpoint::wellKnown({ remote }, WLTOKEN_NETWORKTEST)),
+    testStream(Endpoint::wellKnown({ remote }, WLTOKEN_NETWORKTEST_STREAM)) {}
 
 NetworkTestInterface::NetworkTestInterface(INetwork* local) {
 	test.makeWellKnownEndpoint(WLTOKEN_NETWORKTEST, TaskPriority::DefaultEndpoint);
+	testStream.makeWellKnownEndpoint(WLTOKEN_NETWORKTEST_STREAM, TaskPriority::DefaultEndpoint);
 }
 
-ACTOR Future<Void> networkTestServer() {
-	state NetworkTestInterface interf(g_network);
+ACTOR Future<Void> networkTestUnaryServer(NetworkTestInterface interf) {
 	state Future<Void> logging = delay(1.0);
 	state double lastTime = now();
 	state int sent = 0;
@@ -95,8 +106,7 @@ ACTOR Future<Void> networkTestServer() {
 	}
 }
 
-ACTOR Future<Void> networkTestStreamingServer() {
-	state NetworkTestInterface interf(g_network);
+ACTOR Future<Void> networkTestStreamingServer(NetworkTestInterface interf) {
 	state Future<Void> logging = delay(1.0);
 	state double lastTime = now();
 	state int sent = 0;
@@ -118,7 +128,9 @@ ACTOR Future<Void> networkTestStreamingServer() {
 				}
 				when(wait(logging)) {
 					auto spd = sent / (now() - lastTime);
-					if (FLOW_KNOBS->NETWORK_TEST_SCRIPT_MODE) {
+					if (sent == 0) {
+						// Stay quiet while the clients only send unary requests
+					} else if (FLOW_KNOBS->NETWORK_TEST_SCRIPT_MODE) {
 						fprintf(stderr, "%f\t%.3f\t%.3f\n", spd, latency.mean() * 1e6, latency.stddev() * 1e6);
 					} else {
 						fprintf(stderr, "responses per second: %f (%f us)\n", spd, latency.mean() * 1e6);
@@ -137,6 +149,11 @@ ACTOR Future<Void> networkTestStreamingServer() {
 	}
 }
 
+Future<Void> networkTestServer() {
+	NetworkTestInterface interf(g_network);
+	return networkTestUnaryServer(interf) && networkTestStreamingServer(interf);
+}
+
 static bool moreRequestsPending(int count) {
 	if (count == -1) {
 		return false;
@@ -158,15 +175,21 @@ ACTOR Future<Void> testClient(std::vector<NetworkTestInterface> interfs,
                               int* sent,
                               int* completed,
                               LatencyStats* latency) {
-	state std::string request_payload(FLOW_KNOBS->NETWORK_TEST_REQUEST_SIZE, '.');
+	state std::string request_payload(
+	    std::max(FLOW_KNOBS->NETWORK_TEST_REQUEST_SIZE, FLOW_KNOBS->NETWORK_TEST_REQUEST_SIZE_MAX), '.');
 	state LatencyStats::sample sample;
 
 	while (moreRequestsPending(*sent)) {
 		(*sent)++;
 		sample = latency->tick();
-		NetworkTestReply rep = wait(
-		    retryBrokenPromise(interfs[deterministicRandom()->randomInt(0, interfs.size())].test,
-		                       NetworkTestRequest(StringRef(request_payload), FLOW_KNOBS->NETWORK_TEST_REPLY_SIZE)));
+		NetworkTestReply rep = wait(retryBrokenPromise(
+		    interfs[deterministicRandom()->randomInt(0, interfs.size())].test,
+		    NetworkTestRequest(
+		        StringRef(request_payload)
+		            .substr(0,
+		                    networkTestSize(FLOW_KNOBS->NETWORK_TEST_REQUEST_SIZE,
+		                                    FLOW_KNOBS->NETWORK_TEST_REQUEST_SIZE_MAX)),
+		        networkTestSize(FLOW_KNOBS->NETWORK_TEST_REPLY_SIZE, FLOW_KNOBS->NETWORK_TEST_REPLY_SIZE_MAX))));
 		latency->tock(sample);
 		(*completed)++;
 	}
@@ -177,7 +200,6 @@ ACTOR Future<Void> testClientStream(std::vector<NetworkTestInterface> interfs,
                                     int* sent,
                                     int* completed,
                                     LatencyStats* latency) {
-	state std::string request_payload(FLOW_KNOBS->NETWORK_TEST_REQUEST_SIZE, '.');
 	state LatencyStats::sample sample;
 
 	while (moreRequestsPending(*sent)) {
@@ -204,21 +226,39 @@ ACTOR Future<Void> testClientStream(std::vector<NetworkTestInterface> interfs,
 
 ACTOR Future<Void> logger(int* sent, int* completed, LatencyStats* latency) {
 	state double lastTime = now();
+	state double lastCpuTime = getProcessorTimeProcess();
 	state int logged = 0;
 	state int iteration = 0;
 	while (moreLoggingNeeded(logged, ++iteration)) {
 		wait(delay(1.0));
 		auto spd = (*completed - logged) / (now() - lastTime);
+		// CPU time of the whole client process, including the network thread, per completed message
+		double cpuPerMessage = (getProcessorTimeProcess() - lastCpuTime) / std::max(*completed - logged, 1);
 		if (FLOW_KNOBS->NETWORK_TEST_SCRIPT_MODE) {
 			if (iteration == 2) {
 				// We don't report the first iteration because of warm-up effects.
-				printf("%f\t%.3f\t%.3f\n", spd, latency->mean() * 1e6, latency->stddev() * 1e6);
+				printf("%f\t%.3f\t%.3f\t%.3f\t%.3f\t%.3f\t%.3f\n",
+				       spd,
+				       latency->mean() * 1e6,
+				       latency->stddev() * 1e6,
+				       latency->percentile(0.5) * 1e6,
+				       latency->percentile(0.99) * 1e6,
+				       latency->percentile(0.999) * 1e6,
+				       cpuPerMessage * 1e6);
 			}
 		} else {
-			fprintf(stderr, "messages per second: %f (%6.3f us)\n", spd, latency->mean() * 1e6);
+			fprintf(stderr,
+			        "messages per second: %f (%6.3f us, p50 %6.3f us, p99 %6.3f us, p99.9 %6.3f us, %6.3f us CPU)\n",
+			        spd,
+			        latency->mean() * 1e6,
+			        latency->percentile(0.5) * 1e6,
+			        latency->percentile(0.99) * 1e6,
+			        latency->percentile(0.999) * 1e6,
+			        cpuPerMessage * 1e6);
 		}
 		latency->reset();
 		lastTime = now();
+		lastCpuTime = getProcessorTimeProcess();
 		logged = *completed;
 	}
 	// tell the clients to shut down
@@ -303,7 +343,8 @@ ACTOR Future<Void> networkTestClient(std::string testServers) {
 	state std::vector<Future<Void>> clients;
 	clients.reserve(FLOW_KNOBS->NETWORK_TEST_CLIENT_COUNT);
 	for (int i = 0; i < FLOW_KNOBS->NETWORK_TEST_CLIENT_COUNT; i++) {
-		clients.push_back(testClient(interfs, &sent, &completed, &latency));
+		clients.push_back(FLOW_KNOBS->NETWORK_TEST_STREAMING ? testClientStream(interfs, &sent, &completed, &latency)
+		                                                     : testClient(interfs, &sent, &completed, &latency));
 	}
 	clients.push_back(logger(&sent, &completed, &latency));
 
@@ -147,6 +147,9 @@ bool canReplyWith(Error e) {
 	case error_code_process_behind:
 	case error_code_watch_cancelled:
 	case error_code_server_overloaded:
+	case error_code_unknown_change_feed:
+	case error_code_change_feed_popped:
+	case error_code_storage_too_many_feed_streams:
 	// getMappedRange related exceptions that are not retriable:
 	case error_code_mapper_bad_index:
 	case error_code_mapper_no_such_key:
@@ -618,8 +621,119 @@ public:
 	}
 };
 
+// Caches values read from the storage engine for point reads of keys which are not in the versioned window, such as
+// frequently read configuration keys or counters.  An entry holds the engine's current value of its key, so every
+// write to the engine must invalidate the keys it covers.  A read which was in flight while any write happened may
+// have returned the value from before it, so it is not cached.
+struct StorageReadCache : NonCopyable {
+	// Approximate memory used by an entry in addition to its key and value
+	static constexpr int64_t entryOverhead = 96;
+
+	explicit StorageReadCache(int64_t capacity) : capacity(capacity) {}
+
+	bool enabled() const { return capacity > 0; }
+
+	// The generation to pass to insert() for a read from the engine which is about to start
+	uint64_t readGeneration() const { return generation; }
+
+	Optional<Optional<Value>> get(KeyRef key) {
+		auto i = entries.find(key);
+		if (i == entries.end()) {
+			return Optional<Optional<Value>>();
+		}
+		lru.splice(lru.begin(), lru, i->second.lruPosition);
+		return i->second.value;
+	}
+
+	void insert(KeyRef key, Optional<Value> const& value, uint64_t readGeneration) {
+		int64_t size = key.size() + value.expectedSize() + entryOverhead;
+		if (readGeneration != generation || size > capacity || entries.count(key)) {
+			return;
+		}
+		auto i = entries.emplace(Key(key), Entry{ value, lru.end() }).first;
+		i->second.lruPosition = lru.insert(lru.begin(), i);
+		bytes += size;
+		while (bytes > capacity) {
+			erase(lru.back());
+		}
+	}
+
+	void invalidate(KeyRangeRef keys) {
+		++generation;
+		auto i = entries.lower_bound(keys.begin);
+		while (i != entries.end() && i->first < keys.end) {
+			erase(i++);
+		}
+	}
+
+	void invalidate(KeyRef key) {
+		++generation;
+		auto i = entries.find(key);
+		if (i != entries.end()) {
+			erase(i);
+		}
+	}
+
+	void clear() {
+		++generation;
+		entries.clear();
+		lru.clear();
+		bytes = 0;
+	}
+
+private:
+	struct Entry;
+	using Entries = std::map<Key, Entry, std::less<>>;
+	struct Entry {
+		Optional<Value> value;
+		std::list<Entries::iterator>::iterator lruPosition;
+	};
+
+	void erase(Entries::iterator i) {
+		bytes -= i->first.size() + i->second.value.expectedSize() + entryOverhead;
+		lru.erase(i->second.lruPosition);
+		entries.erase(i);
+	}
+
+	int64_t capacity;
+	int64_t bytes = 0;
+	uint64_t generation = 0;
+	Entries entries;
+	// Most recently used first
+	std::list<Entries::iterator> lru;
+};
+
+TEST_CASE("/fdbserver/storageserver/readCache") {
+	StorageReadCache cache(3 * (StorageReadCache::entryOverhead + 2));
+	cache.insert("a"_sr, "1"_sr, cache.readGeneration());
+	cache.insert("b"_sr, Optional<Value>(), cache.readGeneration());
+	ASSERT(cache.get("a"_sr).get().get() == "1"_sr);
+	ASSERT(!cache.get("b"_sr).get().present());
+	ASSERT(!cache.get("c"_sr).present());
+
+	// The least recently used entry is evicted to make room
+	cache.get("a"_sr);
+	cache.insert("c"_sr, "3"_sr, cache.readGeneration());
+	cache.insert("d"_sr, "4"_sr, cache.readGeneration());
+	ASSERT(!cache.get("b"_sr).present());
+	ASSERT(cache.get("a"_sr).present() && cache.get("c"_sr).present() && cache.get("d"_sr).present());
+
+	// A read which was in flight during a write is not cached
+	uint64_t generation = cache.readGeneration();
+	cache.invalidate("z"_sr);
+	cache.insert("b"_sr, "2"_sr, generation);
+	ASSERT(!cache.get("b"_sr).present());
+
+	cache.invalidate(KeyRangeRef("b"_sr, "d"_sr));
+	ASSERT(cache.get("a"_sr).present() && !cache.get("c"_sr).present() && cache.get("d"_sr).present());
+	cache.clear();
+	ASSERT(!cache.get("a"_sr).present() && !cache.get("d"_sr).present());
+	return Void();
+}
+
 struct StorageServerDisk {
-	explicit StorageServerDisk(struct StorageServer* data, IKeyValueStore* storage) : data(data), storage(storage) {}
+	explicit StorageServerDisk(struct StorageServer* data, IKeyValueStore* storage)
+	  : data(data), storage(storage), readCache(SERVER_KNOBS->STORAGE_SERVER_READ_CACHE_BYTES) {}
 
 	IKeyValueStore* getKeyValueStore() const { return this->storage; }
 
@@ -647,11 +761,15 @@ struct StorageServerDisk {
 		return storage->addRange(range, id, !SERVER_KNOBS->SHARDED_ROCKSDB_DELAY_COMPACTION_FOR_DATA_MOVE);
 	}
 
-	std::vector<std::string> removeRange(KeyRangeRef range) { return storage->removeRange(range); }
+	std::vector<std::string> removeRange(KeyRangeRef range) {
+		readCache.invalidate(range);
+		return storage->removeRange(range);
+	}
 
 	void markRangeAsActive(KeyRangeRef range) { storage->markRangeAsActive(range); }
 
 	Future<Void> replaceRange(KeyRange range, Standalone<VectorRef<KeyValueRef>> data) {
+		readCache.invalidate(range);
 		return storage->replaceRange(range, data);
 	}
 
@@ -679,7 +797,20 @@ struct StorageServerDisk {
 		return readFirstKey(storage, KeyRangeRef(key, allKeys.end), options);
 	}
 	Future<Optional<Value>> readValue(KeyRef key, Optional<ReadOptions> options = Optional<ReadOptions>()) {
-		++(*kvGets);
+		if (readCache.enabled()) {
+			Optional<Optional<Value>> cached = readCache.get(key);
+			if (cached.present()) {
+				++(*readCacheHits);
+				return cached.get();
+			}
+			++(*readCacheMisses);
+			++(*kvGets);
+			if (!options.present() || options.get().cacheResult) {
+				return readValueAndCache(this, Key(key), options);
+			}
+		} else {
+			++(*kvGets);
+		}
 		return storage->readValue(key, options);
 	}
 	Future<Optional<Value>> readValuePrefix(KeyRef key,
@@ -696,13 +827,20 @@ struct StorageServerDisk {
 		return storage->readRange(keys, rowLimit, byteLimit, options);
 	}
 
+	// Must be called after writing to the storage engine other than through this class
+	void invalidateReadCache(KeyRangeRef keys) { readCache.invalidate(keys); }
+
 	Future<CheckpointMetaData> checkpoint(const CheckpointRequest& request) { return storage->checkpoint(request); }
 
-	Future<Void> restore(const std::vector<CheckpointMetaData>& checkpoints) { return storage->restore(checkpoints); }
+	Future<Void> restore(const std::vector<CheckpointMetaData>& checkpoints) {
+		readCache.clear();
+		return storage->restore(checkpoints);
+	}
 
 	Future<Void> restore(const std::string& shardId,
 	                     const std::vector<KeyRange>& ranges,
 	                     const std::vector<CheckpointMetaData>& checkpoints) {
+		readCache.clear();
 		return storage->restore(shardId, ranges, checkpoints);
 	}
 
@@ -713,6 +851,7 @@ struct StorageServerDisk {
 	KeyValueStoreType getKeyValueStoreType() const { return storage->getType(); }
 	StorageBytes getStorageBytes() const { return storage->getStorageBytes(); }
 	std::tuple<size_t, size_t, size_t> getSize() const { return storage->getSize(); }
+	int64_t getMemoryBytes() const { return storage->getMemoryBytes(); }
 
 	Future<EncryptionAtRestMode> encryptionMode() { return storage->encryptionMode(); }
 
@@ -723,10 +862,22 @@ struct StorageServerDisk {
 	Counter* kvGets;
 	Counter* kvScans;
 	Counter* kvCommits;
+	Counter* readCacheHits;
+	Counter* readCacheMisses;
 
 private:
 	struct StorageServer* data;
 	IKeyValueStore* storage;
+	StorageReadCache readCache;
+
+	ACTOR static Future<Optional<Value>> readValueAndCache(StorageServerDisk* self,
+	                                                       Key key,
+	                                                       Optional<ReadOptions> options) {
+		state uint64_t generation = self->readCache.readGeneration();
+		Optional<Value> value = wait(self->storage->readValue(key, options));
+		self->readCache.insert(key, value, generation);
+		return value;
+	}
 	void writeMutations(const VectorRef<MutationRef>& mutations, Version debugVersion, const char* debugContext);
 	void writeMutationsBuggy(const VectorRef<MutationRef>& mutations, Version debugVersion, const char* debugContext);
 
@@ -843,6 +994,98 @@ public:
 	  : key(key), value(value), version(version), tags(tags), debugID(debugID) {}
 };
 
+// Memory held by the in-memory change feeds of all storage servers in this process. A storage server with feeds stops
+// pulling new versions from the tlogs while the total is over CHANGE_FEED_PROCESS_MAX_BYTES, until feeds are popped,
+// trimmed or removed.
+struct ChangeFeedMemoryBudget : NonCopyable {
+	int64_t bytes = 0;
+	AsyncTrigger released;
+
+	void update(int64_t delta) {
+		bytes += delta;
+		if (delta < 0) {
+			released.trigger();
+		}
+	}
+
+	bool exceeded() const { return bytes > SERVER_KNOBS->CHANGE_FEED_PROCESS_MAX_BYTES; }
+
+	// Returns the budget of this process, or of the current virtual process in simulation
+	static ChangeFeedMemoryBudget* get() {
+		// Never destroyed, so feeds can release their memory no matter when they are destroyed
+		static std::map<NetworkAddress, ChangeFeedMemoryBudget>* budgets =
+		    new std::map<NetworkAddress, ChangeFeedMemoryBudget>();
+		return &(*budgets)[g_network->isSimulated() ? g_network->getLocalAddress() : NetworkAddress()];
+	}
+};
+
+// An in-memory change feed over a key range. Feeds are registered by the first stream request naming them and are
+// fed by StorageServer::addMutation, so they only contain mutations this storage server applied after registration.
+// Feeds are not persisted and do not follow data movement: a reboot or a shard move away from this server ends them.
+struct ChangeFeedInfo : ReferenceCounted<ChangeFeedInfo> {
+	Key id;
+	KeyRange range;
+	// There are no mutations in the feed at or before emptyVersion
+	Version emptyVersion = invalidVersion;
+	// Mutations before popVersion have been discarded, either by a pop request or by the memory limit
+	Version popVersion = invalidVersion;
+	Version stopVersion = MAX_VERSION;
+	std::deque<Standalone<MutationsAndVersionRef>> mutations; // ordered by version, one entry per version
+	int64_t bytes = 0;
+	int activeStreams = 0;
+	double lastActive = 0;
+	ChangeFeedMemoryBudget* memoryBudget; // nullptr if the feed's memory is not counted against a budget
+
+	ChangeFeedInfo(Key id, KeyRange range, Version emptyVersion, ChangeFeedMemoryBudget* memoryBudget = nullptr)
+	  : id(id), range(range), emptyVersion(emptyVersion), popVersion(emptyVersion + 1), lastActive(now()),
+	    memoryBudget(memoryBudget) {}
+
+	~ChangeFeedInfo() { addBytes(-bytes); }
+
+	void addBytes(int64_t delta) {
+		bytes += delta;
+		if (memoryBudget != nullptr) {
+			memoryBudget->update(delta);
+		}
+	}
+
+	void push(Version version, Version knownCommittedVersion, MutationRef const& m) {
+		if (mutations.empty() || mutations.back().version != version) {
+			mutations.emplace_back(MutationsAndVersionRef(version, knownCommittedVersion));
+			addBytes(sizeof(MutationsAndVersionRef));
+		}
+		mutations.back().mutations.push_back_deep(mutations.back().arena(), m);
+		addBytes(mutationBytes(m));
+	}
+
+	static int64_t mutationBytes(MutationRef const& m) { return sizeof(MutationRef) + m.expectedSize(); }
+
+	// Discards all mutations before version
+	void pop(Version version) {
+		if (version <= popVersion) {
+			return;
+		}
+		popVersion = version;
+		int64_t freed = 0;
+		while (!mutations.empty() && mutations.front().version < version) {
+			freed += sizeof(MutationsAndVersionRef);
+			for (auto& m : mutations.front().mutations) {
+				freed += mutationBytes(m);
+			}
+			mutations.pop_front();
+		}
+		addBytes(-freed);
+		emptyVersion = std::max(emptyVersion, version - 1);
+	}
+
+	// Keeps the feed under maxBytes by discarding whole versions from the front
+	void trim(int64_t maxBytes) {
+		while (bytes > maxBytes && mutations.size() > 1) {
+			pop(mutations[1].version);
+		}
+	}
+};
+
 struct BusiestWriteTagContext {
 	const std::string busiestWriteTagTrackingKey;
 	UID ratekeeperID;
@@ -906,6 +1149,14 @@ private:
 	WatchMap_t watchMap; // keep track of server watches
 
 public:
+	std::unordered_map<Key, Reference<ChangeFeedInfo>> uidChangeFeed;
+	KeyRangeMap<std::vector<Reference<ChangeFeedInfo>>> keyChangeFeed;
+	int activeFeedStreams = 0;
+
+	Reference<ChangeFeedInfo> registerChangeFeed(Key const& id, KeyRange const& range);
+	void removeChangeFeed(Reference<ChangeFeedInfo> feed);
+	void applyChangeFeedMutation(MutationRef const& m, Version version);
+
 	struct PendingNewShard {
 		PendingNewShard(uint64_t shardId, KeyRangeRef range) : shardId(format("%016llx", shardId)), range(range) {}
 
@@ -1249,10 +1500,24 @@ public:
 	Reference<PriorityMultiLock> ssLock;
 	std::vector<int> readPriorityRanks;
 
-	Future<PriorityMultiLock::Lock> getReadLock(const Optional<ReadOptions>& options) {
+	Future<PriorityMultiLock::Lock> getReadLock(const Optional<ReadOptions>& options,
+	                                            const Optional<TagSet>& tags = Optional<TagSet>()) {
 		int readType = (int)(options.present() ? options.get().type : ReadType::NORMAL);
 		readType = std::clamp<int>(readType, 0, readPriorityRanks.size() - 1);
-		return ssLock->lock(readPriorityRanks[readType]);
+		if (!SERVER_KNOBS->STORAGE_SERVER_READ_FAIR_QUEUEING || !tags.present() || tags.get().size() == 0) {
+			return ssLock->lock(readPriorityRanks[readType]);
+		}
+
+		// Reads are queued by their first tag, and untagged reads share flow 0
+		TransactionTagRef tag = *tags.get().begin();
+		double cost = 1.0;
+		for (auto const& busyTag : transactionTagCounter.getBusiestTags()) {
+			if (busyTag.tag == tag) {
+				cost += busyTag.fractionalBusyness * SERVER_KNOBS->STORAGE_SERVER_READ_FAIR_QUEUEING_BUSY_TAG_COST;
+				break;
+			}
+		}
+		return ssLock->lock(readPriorityRanks[readType], std::max<uint64_t>(1, std::hash<StringRef>()(tag)), cost);
 	}
 
 	FlowLock serveAuditStorageParallelismLock;
@@ -1333,6 +1598,8 @@ public:
 		Counter fetchWaitingMS, fetchWaitingCount, fetchExecutingMS, fetchExecutingCount;
 		Counter readsRejected;
 		Counter wrongShardServer;
+		// Reads served at an older version than requested, as allowed by ReadOptions::maxStaleness
+		Counter staleVersionReads;
 		Counter fetchedVersions;
 		Counter fetchesFromLogs;
 		// The following counters measure how many of lookups in the getMappedRangeQueries are effective. "Miss"
@@ -1346,12 +1613,16 @@ public:
 		Counter kvGetBytes;
 		// The number of keys read from storage engine by eagerReads.
 		Counter eagerReadsKeys;
+		// The number of atomic op keys eagerReads did not read because their latest value was in memory.
+		Counter eagerReadsInMemory;
 		// The count of readValue operation to the storage engine.
 		Counter kvGets;
 		// The count of readValue operation to the storage engine.
 		Counter kvScans;
 		// The count of commit operation to the storage engine.
 		Counter kvCommits;
+		// The count of readValue operations answered by, or which missed, the storage server's read cache.
+		Counter readCacheHits, readCacheMisses;
 		// The count of change feed reads that hit disk
 		Counter changeFeedDiskReads;
 		// The count of ChangeServerKeys actions.
@@ -1391,11 +1662,14 @@ public:
 		    updateVersions("UpdateVersions", cc), loops("Loops", cc), fetchWaitingMS("FetchWaitingMS", cc),
 		    fetchWaitingCount("FetchWaitingCount", cc), fetchExecutingMS("FetchExecutingMS", cc),
 		    fetchExecutingCount("FetchExecutingCount", cc), readsRejected("ReadsRejected", cc),
-		    wrongShardServer("WrongShardServer", cc), fetchedVersions("FetchedVersions", cc),
+		    wrongShardServer("WrongShardServer", cc), staleVersionReads("StaleVersionReads", cc),
+		    fetchedVersions("FetchedVersions", cc),
 		    fetchesFromLogs("FetchesFromLogs", cc), quickGetValueHit("QuickGetValueHit", cc),
 		    quickGetValueMiss("QuickGetValueMiss", cc), quickGetKeyValuesHit("QuickGetKeyValuesHit", cc),
 		    quickGetKeyValuesMiss("QuickGetKeyValuesMiss", cc), kvScanBytes("KVScanBytes", cc),
-		    kvGetBytes("KVGetBytes", cc), eagerReadsKeys("EagerReadsKeys", cc), kvGets("KVGets", cc),
+		    kvGetBytes("KVGetBytes", cc), eagerReadsKeys("EagerReadsKeys", cc),
+		    eagerReadsInMemory("EagerReadsInMemory", cc), kvGets("KVGets", cc),
+		    readCacheHits("ReadCacheHits", cc), readCacheMisses("ReadCacheMisses", cc),
 		    kvScans("KVScans", cc), kvCommits("KVCommits", cc), changeFeedDiskReads("ChangeFeedDiskReads", cc),
 		    getMappedRangeBytesQueried("GetMappedRangeBytesQueried", cc),
 		    finishedGetMappedRangeQueries("FinishedGetMappedRangeQueries", cc),
@@ -1451,6 +1725,7 @@ public:
 			specialCounter(cc, "KvstoreSizeTotal", [self]() { return std::get<0>(self->storage.getSize()); });
 			specialCounter(cc, "KvstoreNodeTotal", [self]() { return std::get<1>(self->storage.getSize()); });
 			specialCounter(cc, "KvstoreInlineKey", [self]() { return std::get<2>(self->storage.getSize()); });
+			specialCounter(cc, "KvstoreMemoryBytes", [self]() { return self->storage.getMemoryBytes(); });
 		}
 	} counters;
 
@@ -1522,7 +1797,8 @@ public:
 	    transactionTagCounter(ssi.id(),
 	                          /*maxTagsTracked=*/SERVER_KNOBS->SS_THROTTLE_TAGS_TRACKED,
 	                          /*minRateTracked=*/SERVER_KNOBS->MIN_TAG_READ_PAGES_RATE *
-	                              CLIENT_KNOBS->TAG_THROTTLING_PAGE_SIZE),
+	                              CLIENT_KNOBS->TAG_THROTTLING_PAGE_SIZE,
+	                          /*maxTagsCounted=*/SERVER_KNOBS->SS_THROTTLE_TAGS_COUNTED),
 	    busiestWriteTagContext(ssi.id()), getEncryptCipherKeysMonitor(encryptionMonitor), counters(this),
 	    storageServerSourceTLogIDEventHolder(
 	        makeReference<EventCacheHolder>(ssi.id().toString() + "/StorageServerSourceTLogID")),
@@ -1554,6 +1830,8 @@ public:
 		this->storage.kvGets = &counters.kvGets;
 		this->storage.kvScans = &counters.kvScans;
 		this->storage.kvCommits = &counters.kvCommits;
+		this->storage.readCacheHits = &counters.readCacheHits;
+		this->storage.readCacheMisses = &counters.readCacheMisses;
 	}
 
 	//~StorageServer() { fclose(log); }
@@ -1856,6 +2134,73 @@ void StorageServer::clearWatchMetadata() {
 	watchMap.clear();
 }
 
+// change feed operations
+Reference<ChangeFeedInfo> StorageServer::registerChangeFeed(Key const& id, KeyRange const& range) {
+	auto it = uidChangeFeed.find(id);
+	if (it != uidChangeFeed.end()) {
+		return it->second;
+	}
+
+	auto feed = makeReference<ChangeFeedInfo>(id, range, version.get(), ChangeFeedMemoryBudget::get());
+	uidChangeFeed[id] = feed;
+	auto rs = keyChangeFeed.modify(range);
+	for (auto r = rs.begin(); r != rs.end(); ++r) {
+		r->value().push_back(feed);
+	}
+	keyChangeFeed.coalesce(range.contents());
+
+	TraceEvent(SevDebug, "ChangeFeedRegistered", thisServerID)
+	    .detail("FeedID", id)
+	    .detail("Range", range)
+	    .detail("EmptyVersion", feed->emptyVersion);
+	return feed;
+}
+
+void StorageServer::removeChangeFeed(Reference<ChangeFeedInfo> feed) {
+	auto rs = keyChangeFeed.modify(feed->range);
+	for (auto r = rs.begin(); r != rs.end(); ++r) {
+		auto& feeds = r->value();
+		feeds.erase(std::remove(feeds.begin(), feeds.end(), feed), feeds.end());
+	}
+	keyChangeFeed.coalesce(feed->range.contents());
+	uidChangeFeed.erase(feed->id);
+	// Storage servers waiting on the memory budget recheck whether they still have feeds
+	ChangeFeedMemoryBudget::get()->released.trigger();
+
+	TraceEvent(SevDebug, "ChangeFeedRemoved", thisServerID)
+	    .detail("FeedID", feed->id)
+	    .detail("Range", feed->range)
+	    .detail("PopVersion", feed->popVersion);
+}
+
+// Appends m to every feed whose range it intersects. Clears are clipped to each feed's range.
+void StorageServer::applyChangeFeedMutation(MutationRef const& m, Version version) {
+	if (m.type == MutationRef::SetValue) {
+		for (auto& feed : keyChangeFeed.rangeContaining(m.param1).value()) {
+			if (version > feed->emptyVersion && version < feed->stopVersion) {
+				feed->push(version, knownCommittedVersion.get(), m);
+				feed->trim(SERVER_KNOBS->CHANGE_FEED_MAX_BYTES);
+				++counters.changeFeedMutations;
+			}
+		}
+	} else if (m.type == MutationRef::ClearRange) {
+		std::unordered_set<ChangeFeedInfo*> applied;
+		for (auto& r : keyChangeFeed.intersectingRanges(KeyRangeRef(m.param1, m.param2))) {
+			for (auto& feed : r.value()) {
+				if (version > feed->emptyVersion && version < feed->stopVersion && applied.insert(feed.getPtr()).second) {
+					feed->push(version,
+					           knownCommittedVersion.get(),
+					           MutationRef(MutationRef::ClearRange,
+					                       std::max(m.param1, feed->range.begin),
+					                       std::min(m.param2, feed->range.end)));
+					feed->trim(SERVER_KNOBS->CHANGE_FEED_MAX_BYTES);
+					++counters.changeFeedMutations;
+				}
+			}
+		}
+	}
+}
+
 #ifndef __INTEL_COMPILER
 #pragma endregion
 #endif
@@ -2116,6 +2461,24 @@ Future<Version> waitForVersion(StorageServer* data,
 	return waitForVersionActor(data, std::max(commitVersion, data->oldestVersion.get()), spanContext);
 }
 
+// Reads which tolerate staleness are served at the latest version available here if the storage server is behind the
+// read version by no more than the allowed staleness, rather than waiting for it to catch up.
+Future<Version> waitForVersion(StorageServer* data,
+                               Version commitVersion,
+                               Version readVersion,
+                               SpanContext spanContext,
+                               Optional<ReadOptions> const& options) {
+	if (options.present() && options.get().maxStaleness.present() && readVersion != latestVersion) {
+		Version current = data->version.get();
+		if (current < readVersion && readVersion - current <= options.get().maxStaleness.get() && current > 0 &&
+		    current >= data->oldestVersion.get()) {
+			++data->counters.staleVersionReads;
+			return current;
+		}
+	}
+	return waitForVersion(data, commitVersion, readVersion, spanContext);
+}
+
 ACTOR Future<Version> waitForVersionNoTooOld(StorageServer* data, Version version) {
 	// This could become an Actor transparently, but for now it just does the lookup
 	if (version == latestVersion)
@@ -2219,7 +2582,7 @@ ACTOR Future<Void> getValueQ(StorageServer* data, GetValueRequest req) {
 		// Active load balancing runs at a very high priority (to obtain accurate queue lengths)
 		// so we need to downgrade here
 		wait(data->getQueryDelay());
-		state PriorityMultiLock::Lock readLock = wait(data->getReadLock(req.options));
+		state PriorityMultiLock::Lock readLock = wait(data->getReadLock(req.options, req.tags));
 
 		// Track time from requestTime through now as read queueing wait time
 		state double queueWaitEnd = g_network->timer();
@@ -2233,7 +2596,8 @@ ACTOR Future<Void> getValueQ(StorageServer* data, GetValueRequest req) {
 
 		state Optional<Value> v;
 		Version commitVersion = getLatestCommitVersion(req.ssLatestCommitVersions, data->tag);
-		state Version version = wait(waitForVersion(data, commitVersion, req.version, req.spanContext));
+		state Version version =
+		    wait(waitForVersion(data, commitVersion, req.version, req.spanContext, req.options));
 		data->counters.readLatencySamples.sample(
 		    g_network->timer() - queueWaitEnd, ReadLatencySamples::READ_VERSION_WAIT, trackedReadType(req));
 
@@ -2256,7 +2620,10 @@ ACTOR Future<Void> getValueQ(StorageServer* data, GetValueRequest req) {
 			path = 1;
 		} else if (!i || !i->isClearTo() || i->getEndKey() <= req.key) {
 			path = 2;
+			state double kvReadStart = g_network->timer();
 			Optional<Value> vv = wait(data->storage.readValue(req.key, req.options));
+			data->counters.readLatencySamples.sample(
+			    g_network->timer() - kvReadStart, ReadLatencySamples::KV_READ_VALUE, trackedReadType(req));
 			data->counters.kvGetBytes += vv.expectedSize();
 			// Validate that while we were reading the data we didn't lose the version or shard
 			if (version < data->storageVersion()) {
@@ -2314,6 +2681,9 @@ ACTOR Future<Void> getValueQ(StorageServer* data, GetValueRequest req) {
 		//	TraceEvent(SevDebug, "SSGetValueCached").detail("Key", req.key);
 
 		GetValueReply reply(v, cached);
+		if (version < req.version && req.options.present() && req.options.get().maxStaleness.present()) {
+			reply.version = version;
+		}
 		reply.penalty = data->getPenalty();
 		req.reply.send(reply);
 	} catch (Error& e) {
@@ -2340,6 +2710,132 @@ ACTOR Future<Void> getValueQ(StorageServer* data, GetValueRequest req) {
 	return Void();
 }
 
+// Reads a batch of keys at one version.  The version wait, read lock and queueing are paid once for the whole batch,
+// and the keys which are not in the versioned data are read from the storage engine concurrently so that engines
+// which batch point reads can serve them together.
+ACTOR Future<Void> getValuesQ(StorageServer* data, GetValuesRequest req) {
+	state int64_t resultSize = 0;
+	state int64_t keyBytes = 0;
+	Span span("SS:getValues"_loc, req.spanContext);
+
+	for (auto& key : req.keys) {
+		keyBytes += key.size();
+	}
+
+	try {
+		data->counters.getValueQueries += req.keys.size();
+		++data->counters.allQueries;
+		if (std::any_of(req.keys.begin(), req.keys.end(), [](KeyRef k) { return k.startsWith(systemKeys.begin); })) {
+			++data->counters.systemKeyQueries;
+		}
+		data->maxQueryQueue = std::max<int>(
+		    data->maxQueryQueue, data->counters.allQueries.getValue() - data->counters.finishedQueries.getValue());
+
+		wait(data->getQueryDelay());
+		state PriorityMultiLock::Lock readLock = wait(data->getReadLock(req.options, req.tags));
+
+		state double queueWaitEnd = g_network->timer();
+		data->counters.readLatencySamples.sample(
+		    queueWaitEnd - req.requestTime(), ReadLatencySamples::READ_QUEUE_WAIT, trackedReadType(req));
+
+		if (req.options.present() && req.options.get().debugID.present())
+			g_traceBatch.addEvent("GetValueDebug", req.options.get().debugID.get().first(), "getValuesQ.DoRead");
+
+		Version commitVersion = getLatestCommitVersion(req.ssLatestCommitVersions, data->tag);
+		state Version version = wait(waitForVersion(data, commitVersion, req.version, req.spanContext));
+		data->counters.readLatencySamples.sample(
+		    g_network->timer() - queueWaitEnd, ReadLatencySamples::READ_VERSION_WAIT, trackedReadType(req));
+
+		state uint64_t changeCounter = data->shardChangeCounter;
+
+		for (auto& key : req.keys) {
+			if (!data->shards[key]->isReadable()) {
+				throw wrong_shard_server();
+			}
+		}
+
+		state std::vector<Optional<Value>> values(req.keys.size());
+		state std::vector<int> engineReadIndexes;
+		state std::vector<Future<Optional<Value>>> engineReads;
+		{
+			auto view = data->data().at(version);
+			for (int k = 0; k < req.keys.size(); k++) {
+				const KeyRef& key = req.keys[k];
+				auto i = view.lastLessOrEqual(key);
+				if (i && i->isValue() && i.key() == key) {
+					values[k] = (Value)i->getValue();
+				} else if (!i || !i->isClearTo() || i->getEndKey() <= key) {
+					engineReadIndexes.push_back(k);
+					engineReads.push_back(data->storage.readValue(key, req.options));
+				}
+			}
+		}
+
+		if (!engineReads.empty()) {
+			wait(waitForAll(engineReads));
+			// Validate that while we were reading the data we didn't lose the version or shard
+			if (version < data->storageVersion()) {
+				CODE_PROBE(true, "transaction_too_old after batched readValue");
+				throw transaction_too_old();
+			}
+			for (int j = 0; j < engineReads.size(); j++) {
+				int k = engineReadIndexes[j];
+				data->checkChangeCounter(changeCounter, req.keys[k]);
+				values[k] = engineReads[j].get();
+				data->counters.kvGetBytes += values[k].expectedSize();
+			}
+		}
+
+		GetValuesReply reply;
+		for (int k = 0; k < req.keys.size(); k++) {
+			const KeyRef& key = req.keys[k];
+			const Optional<Value>& v = values[k];
+			if (v.present()) {
+				++data->counters.rowsQueried;
+				resultSize += v.get().size();
+				data->counters.bytesQueried += v.get().size();
+			} else {
+				++data->counters.emptyQueries;
+			}
+
+			if (SERVER_KNOBS->READ_SAMPLING_ENABLED) {
+				int64_t bytesReadPerKSecond =
+				    v.present() ? std::max((int64_t)(key.size() + v.get().size()), SERVER_KNOBS->EMPTY_READ_PENALTY)
+				                : SERVER_KNOBS->EMPTY_READ_PENALTY;
+				data->metrics.notifyBytesReadPerKSecond(key, bytesReadPerKSecond);
+			}
+
+			reply.cached = reply.cached || data->cachedRangeMap[key];
+		}
+
+		if (req.options.present() && req.options.get().debugID.present())
+			g_traceBatch.addEvent("GetValueDebug", req.options.get().debugID.get().first(), "getValuesQ.AfterRead");
+
+		reply.values = std::move(values);
+		reply.penalty = data->getPenalty();
+		req.reply.send(reply);
+	} catch (Error& e) {
+		if (!canReplyWith(e))
+			throw;
+		data->sendErrorWithPenalty(req.reply, e, data->getPenalty());
+	}
+
+	data->transactionTagCounter.addRequest(req.tags, keyBytes + resultSize);
+
+	++data->counters.finishedQueries;
+
+	double duration = g_network->timer() - req.requestTime();
+	data->counters.readLatencySamples.sample(duration, ReadLatencySamples::READ, trackedReadType(req));
+	data->counters.readLatencySamples.sample(duration, ReadLatencySamples::READ_VALUE, trackedReadType(req));
+	if (data->latencyBandConfig.present()) {
+		int maxReadBytes =
+		    data->latencyBandConfig.get().readConfig.maxReadBytes.orDefault(std::numeric_limits<int>::max());
+		data->counters.readLatencyBands.addMeasurement(duration, 1, Filtered(resultSize > maxReadBytes));
+	}
+
+	return Void();
+}
+
 // Pessimistic estimate the number of overhead bytes used by each
 // watch. Watch key references are stored in an AsyncMap<Key,bool>, and actors
 // must be kept alive until the watch is finished.
@@ -3001,15 +3497,103 @@ ACTOR Future<GetValueReqAndResultRef> quickGetValue(StorageServer* data,
 	}
 }
 
+// Looks up a batch of mapped keys.  The keys readable on this server are read with one local getValues request, so
+// the version wait is paid once and the storage engine can batch the point reads.  The other keys, and any key whose
+// local read fails, are read through quickGetValue concurrently.
+ACTOR Future<Void> quickGetValues(StorageServer* data,
+                                  std::vector<KeyRef> keys,
+                                  Version version,
+                                  Arena* a,
+                                  // To provide span context, tags, debug ID to underlying lookups.
+                                  GetMappedKeyValuesRequest* pOriginalReq,
+                                  std::vector<GetValueReqAndResultRef>* results) {
+	state double getValuesStart = g_network->timer();
+	state std::vector<int> localIndexes;
+	state std::vector<int> otherIndexes;
+	state std::vector<Future<GetValueReqAndResultRef>> otherLookups;
+	state GetValuesRequest req(
+	    pOriginalReq->spanContext, VectorRef<KeyRef>(), version, pOriginalReq->tags, pOriginalReq->options, {});
+
+	results->resize(keys.size());
+	for (int i = 0; i < keys.size(); i++) {
+		(*results)[i].key = keys[i];
+		if (data->shards[keys[i]]->isReadable()) {
+			localIndexes.push_back(i);
+			// Copied, since the local read is not cancelled with the mapped read that owns the keys
+			req.keys.push_back_deep(req.arena, keys[i]);
+		} else {
+			otherIndexes.push_back(i);
+			otherLookups.push_back(quickGetValue(data, keys[i], version, a, pOriginalReq));
+		}
+	}
+
+	if (!localIndexes.empty()) {
+		state bool localHit = false;
+		try {
+			// As in quickGetValue, readGuard is not used since throttling is enforced on the original request
+			data->actors.add(getValuesQ(data, req));
+			GetValuesReply reply = wait(req.reply.getFuture());
+			if (!reply.error.present()) {
+				localHit = true;
+				data->counters.quickGetValueHit += localIndexes.size();
+				for (int j = 0; j < localIndexes.size(); j++) {
+					copyOptionalValue(a, (*results)[localIndexes[j]], reply.values[j]);
+				}
+				data->counters.readLatencySamples.sample(g_network->timer() - getValuesStart,
+				                                         ReadLatencySamples::MAPPED_RANGE_LOCAL,
+				                                         trackedReadType(*pOriginalReq));
+			}
+		} catch (Error& e) {
+			if (e.code() == error_code_actor_cancelled) {
+				throw;
+			}
+		}
+		if (!localHit) {
+			CODE_PROBE(true, "Batched local mapped lookup fell back to individual lookups");
+			for (int i : localIndexes) {
+				otherIndexes.push_back(i);
+				otherLookups.push_back(quickGetValue(data, keys[i], version, a, pOriginalReq));
+			}
+		}
+	}
+
+	wait(waitForAll(otherLookups));
+	for (int j = 0; j < otherIndexes.size(); j++) {
+		(*results)[otherIndexes[j]] = otherLookups[j].get();
+	}
+	return Void();
+}
+
+// Removes the rows of data from index begin on which do not match filter, keeping the order of the rest
+void applyReadFilter(Arena& arena,
+                     const ReadFilterRef& filter,
+                     VectorRef<KeyValueRef, VecSerStrategy::String>& data,
+                     int begin) {
+	int out = begin;
+	for (int i = begin; i < data.size(); i++) {
+		if (filter.matches(data[i])) {
+			data[out] = data[i];
+			if (filter.keysOnly) {
+				data[out].value = ValueRef();
+			}
+			out++;
+		}
+	}
+	data.resize(arena, out);
+}
+
 // If limit>=0, it returns the first rows in the range (sorted ascending), otherwise the last rows (sorted descending).
 // readRange has O(|result|) + O(log |data|) cost
+// If filter is present, only the rows matching it are returned and counted against limit and *pLimitBytes.  A filtered
+// read stops once it has scanned STORAGE_FILTERED_READ_SCAN_BYTES, setting scanEnd in the reply.
 ACTOR Future<GetKeyValuesReply> readRange(StorageServer* data,
                                           Version version,
                                           KeyRange range,
                                           int limit,
                                           int* pLimitBytes,
                                           SpanContext parentSpan,
-                                          Optional<ReadOptions> options) {
+                                          Optional<ReadOptions> options,
+                                          Optional<ReadFilterRef> filter = Optional<ReadFilterRef>()) {
 	state GetKeyValuesReply result;
 	state StorageServer::VersionedData::ViewAtVersion view = data->data().at(version);
 	state StorageServer::VersionedData::iterator vCurrent = view.end();
@@ -3020,6 +3604,7 @@ ACTOR Future<GetKeyValuesReply> readRange(StorageServer* data,
 	state Span span("SS:readRange"_loc, parentSpan);
 	state int resultLogicalSize = 0;
 	state int logicalSize = 0;
+	state int64_t scannedBytes = 0;
 
 	// for caching the storage queue results during the first PTree traversal
 	state VectorRef<KeyValueRef> resultCache;
@@ -3116,6 +3701,13 @@ ACTOR Future<GetKeyValuesReply> readRange(StorageServer* data,
 			      atStorageVersion.more,
 			      pos,
 			      *pLimitBytes);
+			KeyRef lastMergedKey = result.data.size() > prevSize ? result.data.back().key : KeyRef();
+			if (filter.present()) {
+				for (auto i = result.data.begin() + prevSize; i != result.data.end(); i++) {
+					scannedBytes += sizeof(KeyValueRef) + i->expectedSize();
+				}
+				applyReadFilter(result.arena, filter.get(), result.data, prevSize);
+			}
 			limit -= result.data.size() - prevSize;
 
 			for (auto i = result.data.begin() + prevSize; i != result.data.end(); i++) {
@@ -3131,8 +3723,8 @@ ACTOR Future<GetKeyValuesReply> readRange(StorageServer* data,
 
 			// if there might be more data, begin reading right after what we already found to find out
 			if (atStorageVersion.more) {
-				ASSERT(atStorageVersion.end()[-1].key.size() == result.data.end()[-1].key.size() &&
-				       atStorageVersion.end()[-1].key.endsWith(result.data.end()[-1].key));
+				ASSERT(atStorageVersion.end()[-1].key.size() == lastMergedKey.size() &&
+				       atStorageVersion.end()[-1].key.endsWith(lastMergedKey));
 
 				readBegin = readBeginTemp = keyAfter(atStorageVersion.end()[-1].key);
 			}
@@ -3147,6 +3739,12 @@ ACTOR Future<GetKeyValuesReply> readRange(StorageServer* data,
 				ASSERT(readEnd == range.end);
 				break;
 			}
+
+			if (scannedBytes >= SERVER_KNOBS->STORAGE_FILTERED_READ_SCAN_BYTES && readBegin < range.end) {
+				CODE_PROBE(true, "Filtered read stopped by scan limit");
+				result.scanEnd = KeyRef(result.arena, readBegin);
+				break;
+			}
 		}
 	} else {
 		vCurrent = view.lastLess(range.end);
@@ -3212,6 +3810,13 @@ ACTOR Future<GetKeyValuesReply> readRange(StorageServer* data,
 			      atStorageVersion.more,
 			      pos,
 			      *pLimitBytes);
+			KeyRef lastMergedKey = result.data.size() > prevSize ? result.data.back().key : KeyRef();
+			if (filter.present()) {
+				for (auto i = result.data.begin() + prevSize; i != result.data.end(); i++) {
+					scannedBytes += sizeof(KeyValueRef) + i->expectedSize();
+				}
+				applyReadFilter(result.arena, filter.get(), result.data, prevSize);
+			}
 			limit += result.data.size() - prevSize;
 
 			for (auto i = result.data.begin() + prevSize; i != result.data.end(); i++) {
@@ -3223,8 +3828,8 @@ ACTOR Future<GetKeyValuesReply> readRange(StorageServer* data,
 			}
 
 			if (atStorageVersion.more) {
-				ASSERT(atStorageVersion.end()[-1].key.size() == result.data.end()[-1].key.size() &&
-				       atStorageVersion.end()[-1].key.endsWith(result.data.end()[-1].key));
+				ASSERT(atStorageVersion.end()[-1].key.size() == lastMergedKey.size() &&
+				       atStorageVersion.end()[-1].key.endsWith(lastMergedKey));
 
 				readEnd = atStorageVersion.end()[-1].key;
 			} else if (vCurrent && vCurrent->isClearTo()) {
@@ -3235,6 +3840,12 @@ ACTOR Future<GetKeyValuesReply> readRange(StorageServer* data,
 				ASSERT(readBegin == range.begin);
 				break;
 			}
+
+			if (scannedBytes >= SERVER_KNOBS->STORAGE_FILTERED_READ_SCAN_BYTES && readEnd > range.begin) {
+				CODE_PROBE(true, "Filtered reverse read stopped by scan limit");
+				result.scanEnd = KeyRef(result.arena, readEnd);
+				break;
+			}
 		}
 	}
 	data->readRangeBytesReturnedHistogram->sample(resultLogicalSize);
@@ -3242,7 +3853,7 @@ ACTOR Future<GetKeyValuesReply> readRange(StorageServer* data,
 
 	// all but the last item are less than *pLimitBytes
 	ASSERT(result.data.size() == 0 || *pLimitBytes + result.data.end()[-1].expectedSize() + sizeof(KeyValueRef) > 0);
-	result.more = limit == 0 || *pLimitBytes <= 0; // FIXME: Does this have to be exact?
+	result.more = limit == 0 || *pLimitBytes <= 0 || result.scanEnd.present(); // FIXME: Does this have to be exact?
 	result.version = version;
 	return result;
 }
@@ -3471,7 +4082,7 @@ ACTOR Future<Void> getKeyValuesQ(StorageServer* data, GetKeyValuesRequest req)
 	// Active load balancing runs at a very high priority (to obtain accurate queue lengths)
 	// so we need to downgrade here
 	wait(data->getQueryDelay());
-	state PriorityMultiLock::Lock readLock = wait(data->getReadLock(req.options));
+	state PriorityMultiLock::Lock readLock = wait(data->getReadLock(req.options, req.tags));
 
 	// Track time from requestTime through now as read queueing wait time
 	state double queueWaitEnd = g_network->timer();
@@ -3484,7 +4095,7 @@ ACTOR Future<Void> getKeyValuesQ(StorageServer* data, GetKeyValuesRequest req)
 			    "TransactionDebug", req.options.get().debugID.get().first(), "storageserver.getKeyValues.Before");
 
 		Version commitVersion = getLatestCommitVersion(req.ssLatestCommitVersions, data->tag);
-		state Version version = wait(waitForVersion(data, commitVersion, req.version, span.context));
+		state Version version = wait(waitForVersion(data, commitVersion, req.version, span.context, req.options));
 		DisabledTraceEvent("VVV", data->thisServerID)
 		    .detail("Version", version)
 		    .detail("ReqVersion", req.version)
@@ -3582,8 +4193,14 @@ ACTOR Future<Void> getKeyValuesQ(StorageServer* data, GetKeyValuesRequest req)
 			state int remainingLimitBytes = req.limitBytes;
 
 			state double kvReadRange = g_network->timer();
-			GetKeyValuesReply _r = wait(readRange(
-			    data, version, KeyRangeRef(begin, end), req.limit, &remainingLimitBytes, span.context, req.options));
+			GetKeyValuesReply _r = wait(readRange(data,
+			                                      version,
+			                                      KeyRangeRef(begin, end),
+			                                      req.limit,
+			                                      &remainingLimitBytes,
+			                                      span.context,
+			                                      req.options,
+			                                      req.filter));
 			const double duration = g_network->timer() - kvReadRange;
 			data->counters.readLatencySamples.sample(duration, ReadLatencySamples::KV_READ_RANGE, trackedReadType(req));
 			GetKeyValuesReply r = _r;
@@ -3625,6 +4242,9 @@ ACTOR Future<Void> getKeyValuesQ(StorageServer* data, GetKeyValuesRequest req)
 			if (g_network->isSimulated()) {
 				maybeInjectConsistencyScanCorruption(data->thisServerID, req, r);
 			}
+			if (req.compressKeyPrefixes) {
+				r.compressKeyPrefixes();
+			}
 			req.reply.send(r);
 
 			resultSize = req.limitBytes - remainingLimitBytes;
@@ -4390,6 +5010,7 @@ static Future<ErrorOr<GetKeyValuesReply>> issueGetKeyValuesRequest(StorageServer
 	req.limitBytes = limitBytes;
 	req.version = version;
 	req.tags = TagSet();
+	req.options = ReadOptions(ReadType::LOW, CacheResult::False);
 	data->actors.add(getKeyValuesQ(data, req));
 	return errorOr(req.reply.getFuture());
 }
@@ -4880,6 +5501,9 @@ ACTOR Future<Void> auditStorageShardReplicaQ(StorageServer* data, AuditStorageRe
 					req.limitBytes = limitBytes;
 					req.version = version;
 					req.tags = TagSet();
+					// An audit reads every byte once, so it should neither delay foreground reads nor evict their
+					// pages from the cache
+					req.options = ReadOptions(ReadType::LOW, CacheResult::False);
 					fs.push_back(remoteServer.getKeyValues.getReplyUnlessFailedFor(req, 2, 0));
 				}
 
@@ -4891,6 +5515,7 @@ ACTOR Future<Void> auditStorageShardReplicaQ(StorageServer* data, AuditStorageRe
 				localReq.limitBytes = limitBytes;
 				localReq.version = version;
 				localReq.tags = TagSet();
+				localReq.options = ReadOptions(ReadType::LOW, CacheResult::False);
 				data->actors.add(getKeyValuesQ(data, localReq));
 				fs.push_back(errorOr(localReq.reply.getFuture()));
 				std::vector<ErrorOr<GetKeyValuesReply>> reps = wait(getAll(fs));
@@ -5614,18 +6239,24 @@ ACTOR Future<GetMappedKeyValuesReply> mapKeyValues(StorageServer* data,
 	preprocessMappedKey(mappedKeyFormatTuple, vt, isRangeQuery);
 
 	state int sz = input.data.size();
-	const int k = std::min(sz, SERVER_KNOBS->MAX_PARALLEL_QUICK_GET_VALUE);
+	// Batched point lookups cost one local request per batch, so they can look up more keys at a time
+	state bool batchGetValues = !isRangeQuery && SERVER_KNOBS->QUICK_GET_VALUES_BATCHED;
+	state int parallelism =
+	    batchGetValues ? SERVER_KNOBS->QUICK_GET_VALUES_BATCH_SIZE : SERVER_KNOBS->MAX_PARALLEL_QUICK_GET_VALUE;
+	const int k = std::min(sz, parallelism);
 	state std::vector<MappedKeyValueRef> kvms(k);
 	state std::vector<Future<Void>> subqueries;
+	state std::vector<KeyRef> mappedKeys;
+	state std::vector<GetValueReqAndResultRef> mappedValues;
 	state int offset = 0;
 	if (pOriginalReq->options.present() && pOriginalReq->options.get().debugID.present())
 		g_traceBatch.addEvent("TransactionDebug",
 		                      pOriginalReq->options.get().debugID.get().first(),
 		                      "storageserver.mapKeyValues.BeforeLoop");
 
-	for (; (offset < sz) && (*remainingLimitBytes > 0); offset += SERVER_KNOBS->MAX_PARALLEL_QUICK_GET_VALUE) {
-		// Divide into batches of MAX_PARALLEL_QUICK_GET_VALUE subqueries
-		for (int i = 0; i + offset < sz && i < SERVER_KNOBS->MAX_PARALLEL_QUICK_GET_VALUE; i++) {
+	for (; (offset < sz) && (*remainingLimitBytes > 0); offset += parallelism) {
+		// Divide into batches of at most parallelism subqueries
+		for (int i = 0; i + offset < sz && i < parallelism; i++) {
 			KeyValueRef* it = &input.data[i + offset];
 			MappedKeyValueRef* kvm = &kvms[i];
 			// Clear key value to the default.
@@ -5638,16 +6269,28 @@ ACTOR Future<GetMappedKeyValuesReply> mapKeyValues(StorageServer* data,
 			// std::cout << "key:" << printable(kvm->key) << ", value:" << printable(kvm->value)
 			//          << ", mappedKey:" << printable(mappedKey) << std::endl;
 
-			subqueries.push_back(
-			    mapSubquery(data, input.version, pOriginalReq, &result.arena, isRangeQuery, it, kvm, mappedKey));
+			if (batchGetValues) {
+				mappedKeys.push_back(mappedKey);
+			} else {
+				subqueries.push_back(
+				    mapSubquery(data, input.version, pOriginalReq, &result.arena, isRangeQuery, it, kvm, mappedKey));
+			}
+		}
+		if (batchGetValues) {
+			wait(quickGetValues(data, mappedKeys, input.version, &result.arena, pOriginalReq, &mappedValues));
+			for (int i = 0; i < mappedValues.size(); i++) {
+				kvms[i].reqAndResult = mappedValues[i];
+			}
+			mappedKeys.clear();
+		} else {
+			wait(waitForAll(subqueries));
 		}
-		wait(waitForAll(subqueries));
 		if (pOriginalReq->options.present() && pOriginalReq->options.get().debugID.present())
 			g_traceBatch.addEvent("TransactionDebug",
 			                      pOriginalReq->options.get().debugID.get().first(),
 			                      "storageserver.mapKeyValues.AfterBatch");
 		subqueries.clear();
-		for (int i = 0; i + offset < sz && i < SERVER_KNOBS->MAX_PARALLEL_QUICK_GET_VALUE; i++) {
+		for (int i = 0; i + offset < sz && i < parallelism; i++) {
 			// since we always read the index, so always consider the index size
 			int indexSize = sizeof(KeyValueRef) + input.data[i + offset].expectedSize();
 			int size = indexSize + getMappedKeyValueSize(kvms[i]);
@@ -5676,6 +6319,101 @@ ACTOR Future<GetMappedKeyValuesReply> mapKeyValues(StorageServer* data,
 	return result;
 }
 
+// Aggregates the range in chunks read with readRange, so the memory used is bounded by the chunk size rather than the
+// size of the range.  The read lock is released and reacquired between chunks.  The reply covers at most
+// STORAGE_RANGE_AGGREGATE_SCAN_BYTES of data, and says where to continue.
+ACTOR Future<Void> getRangeAggregateQ(StorageServer* data, GetRangeAggregateRequest req) {
+	state Span span("SS:getRangeAggregate"_loc, req.spanContext);
+	state int64_t resultSize = 0;
+
+	++data->counters.allQueries;
+	data->maxQueryQueue = std::max<int>(
+	    data->maxQueryQueue, data->counters.allQueries.getValue() - data->counters.finishedQueries.getValue());
+
+	wait(data->getQueryDelay());
+	state PriorityMultiLock::Lock readLock = wait(data->getReadLock(req.options, req.tags));
+
+	state double queueWaitEnd = g_network->timer();
+	data->counters.readLatencySamples.sample(
+	    queueWaitEnd - req.requestTime(), ReadLatencySamples::READ_QUEUE_WAIT, trackedReadType(req));
+
+	try {
+		Version commitVersion = getLatestCommitVersion(req.ssLatestCommitVersions, data->tag);
+		state Version version = wait(waitForVersion(data, commitVersion, req.version, span.context));
+		data->counters.readLatencySamples.sample(
+		    g_network->timer() - queueWaitEnd, ReadLatencySamples::READ_VERSION_WAIT, trackedReadType(req));
+
+		state uint64_t changeCounter = data->shardChangeCounter;
+		state KeyRange shard = getShardKeyRange(data, firstGreaterOrEqual(req.range.begin));
+		if (req.range.end > shard.end) {
+			throw wrong_shard_server();
+		}
+
+		state GetRangeAggregateReply reply;
+		state Key begin = req.range.begin;
+		loop {
+			if (begin >= req.range.end) {
+				break;
+			}
+			if (resultSize >= SERVER_KNOBS->STORAGE_RANGE_AGGREGATE_SCAN_BYTES) {
+				reply.more = true;
+				reply.end = begin;
+				break;
+			}
+
+			state int limitBytes = CLIENT_KNOBS->REPLY_BYTE_LIMIT;
+			GetKeyValuesReply r = wait(readRange(data,
+			                                     version,
+			                                     KeyRangeRef(begin, req.range.end),
+			                                     CLIENT_KNOBS->TOO_MANY,
+			                                     &limitBytes,
+			                                     span.context,
+			                                     req.options));
+			data->checkChangeCounter(changeCounter, KeyRangeRef(begin, req.range.end));
+			reply.aggregate.add(r.data.begin(), r.data.size());
+			resultSize += CLIENT_KNOBS->REPLY_BYTE_LIMIT - limitBytes;
+			if (!r.more) {
+				break;
+			}
+			begin = keyAfter(r.data.back().key);
+
+			// Let other reads through between chunks instead of holding a read slot for the whole scan
+			readLock.release();
+			PriorityMultiLock::Lock nextReadLock = wait(data->getReadLock(req.options, req.tags));
+			readLock = nextReadLock;
+		}
+
+		data->counters.rowsQueried += reply.aggregate.count;
+		data->counters.bytesQueried += resultSize;
+		if (reply.aggregate.count == 0) {
+			++data->counters.emptyQueries;
+		}
+
+		if (resultSize > 0 && SERVER_KNOBS->READ_SAMPLING_ENABLED) {
+			// As for range reads, the cost is billed to the first and last keys
+			int64_t bytesReadPerKSecond = std::max(resultSize, SERVER_KNOBS->EMPTY_READ_PENALTY) / 2;
+			data->metrics.notifyBytesReadPerKSecond(reply.aggregate.minKey.get(), bytesReadPerKSecond);
+			data->metrics.notifyBytesReadPerKSecond(reply.aggregate.maxKey.get(), bytesReadPerKSecond);
+		}
+
+		reply.cached = data->cachedRangeMap[req.range.begin];
+		reply.penalty = data->getPenalty();
+		req.reply.send(reply);
+	} catch (Error& e) {
+		if (!canReplyWith(e))
+			throw;
+		data->sendErrorWithPenalty(req.reply, e, data->getPenalty());
+	}
+
+	data->transactionTagCounter.addRequest(req.tags, resultSize);
+	++data->counters.finishedQueries;
+
+	double duration = g_network->timer() - req.requestTime();
+	data->counters.readLatencySamples.sample(duration, ReadLatencySamples::READ, trackedReadType(req));
+
+	return Void();
+}
+
 // Most of the actor is copied from getKeyValuesQ. I tried to use templates but things become nearly impossible after
 // combining actor shenanigans with template shenanigans.
 ACTOR Future<Void> getMappedKeyValuesQ(StorageServer* data, GetMappedKeyValuesRequest req)
@@ -5698,7 +6436,7 @@ ACTOR Future<Void> getMappedKeyValuesQ(StorageServer* data, GetMappedKeyValuesRe
 	// Active load balancing runs at a very high priority (to obtain accurate queue lengths)
 	// so we need to downgrade here
 	wait(data->getQueryDelay());
-	state PriorityMultiLock::Lock readLock = wait(data->getReadLock(req.options));
+	state PriorityMultiLock::Lock readLock = wait(data->getReadLock(req.options, req.tags));
 
 	// Track time from requestTime through now as read queueing wait time
 	state double queueWaitEnd = g_network->timer();
@@ -5860,12 +6598,83 @@ ACTOR Future<Void> getMappedKeyValuesQ(StorageServer* data, GetMappedKeyValuesRe
 	return Void();
 }
 
+// Sizes the flow control window of a range stream to keep enough data in flight to use the bandwidth of the client's
+// connection.  The window covers the bandwidth-delay product estimated from the highest recent rate at which the
+// client acknowledged data and the lowest time observed between sending a reply and its acknowledgement, times a gain
+// so that the window keeps growing while the connection has spare bandwidth.
+struct RangeStreamWindow {
+	RangeStreamWindow(int64_t minBytes, int64_t maxBytes)
+	  : minBytes(minBytes), maxBytes(std::max(minBytes, maxBytes)) {}
+
+	void sent(int64_t bytesSent, double time) {
+		if (bytesSent > lastSent) {
+			inFlight.emplace_back(bytesSent, time);
+			lastSent = bytesSent;
+		}
+	}
+
+	// Returns the window size given the bytes acknowledged by the client so far
+	int64_t update(int64_t bytesAcknowledged, double time) {
+		if (bytesAcknowledged < lastAcknowledged) {
+			// The acknowledged bytes have wrapped, so start over
+			*this = RangeStreamWindow(minBytes, maxBytes);
+			return minBytes;
+		}
+		while (!inFlight.empty() && inFlight.front().first <= bytesAcknowledged) {
+			minRtt = std::min(minRtt, time - inFlight.front().second);
+			inFlight.pop_front();
+		}
+		if (bytesAcknowledged > lastAcknowledged) {
+			if (lastAcknowledgedTime > 0 && time > lastAcknowledgedTime) {
+				double rate = (bytesAcknowledged - lastAcknowledged) / (time - lastAcknowledgedTime);
+				// Decay the highest rate so the window follows a connection which has become slower
+				maxRate = std::max(rate, maxRate * 0.9);
+			}
+			lastAcknowledged = bytesAcknowledged;
+			lastAcknowledgedTime = time;
+		}
+		if (maxRate == 0 || minRtt == std::numeric_limits<double>::max()) {
+			return minBytes;
+		}
+		double bdp = SERVER_KNOBS->RANGESTREAM_WINDOW_GAIN * maxRate * std::max(minRtt, 1e-6);
+		return std::clamp<int64_t>(bdp, minBytes, maxBytes);
+	}
+
+	int64_t minBytes, maxBytes;
+	// Cumulative bytes sent after each reply which has not been acknowledged, and when it was sent
+	std::deque<std::pair<int64_t, double>> inFlight;
+	int64_t lastSent = 0;
+	int64_t lastAcknowledged = 0;
+	double lastAcknowledgedTime = 0;
+	double maxRate = 0;
+	double minRtt = std::numeric_limits<double>::max();
+};
+
+TEST_CASE("/fdbserver/storageserver/rangeStreamWindow") {
+	RangeStreamWindow window(100, 10000);
+	window.sent(1000, 1.0);
+	ASSERT_EQ(window.update(0, 1.0), 100);
+	// The first acknowledgement gives a round trip time but no rate yet
+	ASSERT_EQ(window.update(1000, 1.01), 100);
+
+	// 2000 bytes acknowledged in 10ms with a 10ms round trip
+	window.sent(3000, 1.01);
+	int64_t expected = std::clamp<int64_t>(SERVER_KNOBS->RANGESTREAM_WINDOW_GAIN * 2000, 100, 10000);
+	ASSERT(std::abs(window.update(3000, 1.02) - expected) <= 2);
+
+	// The window is capped
+	window.sent(1e6, 1.02);
+	ASSERT_EQ(window.update(1e6, 1.03), 10000);
+	return Void();
+}
+
 ACTOR Future<Void> getKeyValuesStreamQ(StorageServer* data, GetKeyValuesStreamRequest req)
 // Throws a wrong_shard_server if the keys in the request or result depend on data outside this server OR if a large
 // selector offset prevents all data from being read in one range read
 {
 	state Span span("SS:getKeyValuesStream"_loc, req.spanContext);
 	state int64_t resultSize = 0;
+	state RangeStreamWindow window(SERVER_KNOBS->RANGESTREAM_LIMIT_BYTES, SERVER_KNOBS->RANGESTREAM_MAX_LIMIT_BYTES);
 
 	req.reply.setByteLimit(SERVER_KNOBS->RANGESTREAM_LIMIT_BYTES);
 	++data->counters.getRangeStreamQueries;
@@ -5955,9 +6764,10 @@ ACTOR Future<Void> getKeyValuesStreamQ(StorageServer* data, GetKeyValuesStreamRe
 			req.reply.send(none);
 			req.reply.sendError(end_of_stream());
 		} else {
+			// Each reply is read before waiting for the client to have room for it, so the read from the storage
+			// engine overlaps with the previous replies being sent
 			loop {
-				wait(req.reply.onReady());
-				state PriorityMultiLock::Lock readLock = wait(data->getReadLock(req.options));
+				state PriorityMultiLock::Lock readLock = wait(data->getReadLock(req.options, req.tags));
 
 				if (version < data->oldestVersion.get()) {
 					throw transaction_too_old();
@@ -5976,10 +6786,17 @@ ACTOR Future<Void> getKeyValuesStreamQ(StorageServer* data, GetKeyValuesStreamRe
 				    .detail("Begin", begin.printable())
 				    .detail("End", end.printable());
 
-				GetKeyValuesReply _r = wait(readRange(
-				    data, version, KeyRangeRef(begin, end), req.limit, &byteLimit, span.context, req.options));
+				GetKeyValuesReply _r = wait(readRange(data,
+				                                      version,
+				                                      KeyRangeRef(begin, end),
+				                                      req.limit,
+				                                      &byteLimit,
+				                                      span.context,
+				                                      req.options,
+				                                      req.filter));
 				readLock.release();
-				GetKeyValuesStreamReply r(_r);
+				state Optional<Key> scanEnd = _r.scanEnd.castTo<Key>();
+				state GetKeyValuesStreamReply r(_r);
 
 				if (req.options.present() && req.options.get().debugID.present())
 					g_traceBatch.addEvent("TransactionDebug",
@@ -6004,7 +6821,7 @@ ACTOR Future<Void> getKeyValuesStreamQ(StorageServer* data, GetKeyValuesStreamRe
 					totalByteSize += r.data[i].expectedSize();
 				}
 
-				KeyRef lastKey;
+				state KeyRef lastKey;
 				if (!r.data.empty()) {
 					lastKey = r.data.back().key;
 				}
@@ -6015,7 +6832,10 @@ ACTOR Future<Void> getKeyValuesStreamQ(StorageServer* data, GetKeyValuesStreamRe
 					data->metrics.notifyBytesReadPerKSecond(lastKey, bytesReadPerKSecond);
 				}
 
+				req.reply.setByteLimit(window.update(req.reply.getBytesAcknowledged(), now()));
+				wait(req.reply.onReady());
 				req.reply.send(r);
+				window.sent(req.reply.getBytesSent(), now());
 
 				data->counters.rowsQueried += r.data.size();
 				if (r.data.size() == 0) {
@@ -6025,12 +6845,20 @@ ACTOR Future<Void> getKeyValuesStreamQ(StorageServer* data, GetKeyValuesStreamRe
 					req.reply.sendError(end_of_stream());
 					break;
 				}
-				ASSERT(r.data.size());
 
-				if (req.limit >= 0) {
-					begin = keyAfter(lastKey);
+				if (scanEnd.present()) {
+					if (req.limit >= 0) {
+						begin = scanEnd.get();
+					} else {
+						end = scanEnd.get();
+					}
 				} else {
-					end = lastKey;
+					ASSERT(r.data.size());
+					if (req.limit >= 0) {
+						begin = keyAfter(lastKey);
+					} else {
+						end = lastKey;
+					}
 				}
 
 				data->transactionTagCounter.addRequest(req.tags, resultSize);
@@ -6065,7 +6893,7 @@ ACTOR Future<Void> getKeyQ(StorageServer* data, GetKeyRequest req) {
 	// Active load balancing runs at a very high priority (to obtain accurate queue lengths)
 	// so we need to downgrade here
 	wait(data->getQueryDelay());
-	state PriorityMultiLock::Lock readLock = wait(data->getReadLock(req.options));
+	state PriorityMultiLock::Lock readLock = wait(data->getReadLock(req.options, req.tags));
 
 	// Track time from requestTime through now as read queueing wait time
 	state double queueWaitEnd = g_network->timer();
@@ -6192,9 +7020,23 @@ ACTOR Future<Void> doEagerReads(StorageServer* data, UpdateEagerReadInfo* eager)
 		eager->keyEnd = keyEndVal;
 	}
 
+	// Atomic ops on keys whose latest value or clear is in the versioned data are converted without their eager
+	// read (see convertAtomicOp), so only read the other keys.  The update holds durableVersionLock, so no entries
+	// leave the versioned data before the mutations are applied.
 	std::vector<Future<Optional<Value>>> value(eager->keys.size());
-	for (int i = 0; i < value.size(); i++)
-		value[i] = data->storage.readValuePrefix(eager->keys[i].first, eager->keys[i].second, options);
+	auto const& latest = data->data().atLatest();
+	state int inMemory = 0;
+	for (int i = 0; i < value.size(); i++) {
+		KeyRef key = eager->keys[i].first;
+		auto it = latest.lastLessOrEqual(key);
+		if (it != latest.end() &&
+		    ((it->isValue() && it.key() == key) || (it->isClearTo() && it->getEndKey() > key))) {
+			value[i] = Optional<Value>();
+			++inMemory;
+		} else {
+			value[i] = data->storage.readValuePrefix(key, eager->keys[i].second, options);
+		}
+	}
 
 	state Future<std::vector<Optional<Value>>> futureValues = getAll(value);
 	std::vector<Optional<Value>> optionalValues = wait(futureValues);
@@ -6203,7 +7045,8 @@ ACTOR Future<Void> doEagerReads(StorageServer* data, UpdateEagerReadInfo* eager)
 			data->counters.kvGetBytes += value.expectedSize();
 		}
 	}
-	data->counters.eagerReadsKeys += eager->keys.size();
+	data->counters.eagerReadsKeys += eager->keys.size() - inMemory;
+	data->counters.eagerReadsInMemory += inMemory;
 	eager->value = optionalValues;
 
 	return Void();
@@ -6647,12 +7490,13 @@ public:
 	}
 };
 
-ACTOR Future<Void> tryGetRange(PromiseStream<RangeResult> results, Transaction* tr, KeyRange keys) {
-	if (SERVER_KNOBS->FETCH_USING_STREAMING) {
-		wait(tr->getRangeStream(results, keys, GetRangeLimits(), Snapshot::True));
-		return Void();
-	}
-
+// Reads keys in blocks of FETCH_BLOCK_BYTES. Unless keys is the last sub-range of a larger fetch, the block which
+// exhausts it is sent with more set and a readThrough of keys.end, so that the blocks of consecutive sub-ranges read
+// as one range. The next block is only read once the last one sent has been taken from results.
+ACTOR Future<Void> tryGetSubRange(PromiseStream<RangeResult> results,
+                                  Transaction* tr,
+                                  KeyRange keys,
+                                  bool lastSubRange) {
 	state KeySelectorRef begin = firstGreaterOrEqual(keys.begin);
 	state KeySelectorRef end = firstGreaterOrEqual(keys.end);
 
@@ -6661,6 +7505,13 @@ ACTOR Future<Void> tryGetRange(PromiseStream<RangeResult> results, Transaction*
 			GetRangeLimits limits(GetRangeLimits::ROW_LIMIT_UNLIMITED, SERVER_KNOBS->FETCH_BLOCK_BYTES);
 			limits.minRows = 0;
 			state RangeResult rep = wait(tr->getRange(begin, end, limits, Snapshot::True));
+			if (!rep.more && !lastSubRange) {
+				rep.more = true;
+				rep.setReadThrough(KeyRef(rep.arena(), keys.end));
+				results.send(rep);
+				results.sendError(end_of_stream());
+				return Void();
+			}
 			results.send(rep);
 
 			if (!rep.more) {
@@ -6669,6 +7520,7 @@ ACTOR Future<Void> tryGetRange(PromiseStream<RangeResult> results, Transaction*
 			}
 
 			begin = rep.nextBeginKeySelector();
+			wait(results.onEmpty());
 		}
 	} catch (Error& e) {
 		if (e.code() == error_code_actor_cancelled) {
@@ -6679,6 +7531,73 @@ ACTOR Future<Void> tryGetRange(PromiseStream<RangeResult> results, Transaction*
 	}
 }
 
+// Splits keys into sub-ranges of about FETCH_BLOCK_BYTES and reads up to FETCH_KEYS_PARALLEL_SUBRANGES of them at once,
+// so that a large fetch is not bound by the latency of one read at a time. The reads are load balanced over the
+// source replicas, and their blocks are sent in key order. Blocks are read ahead of fetchKeys, which only charges them
+// to its byte budget as it writes them, so each sub-range read and results hold at most one block which has not been
+// taken, bounding the blocks read ahead to FETCH_KEYS_PARALLEL_SUBRANGES + 1.
+ACTOR Future<Void> tryGetRangeParallel(PromiseStream<RangeResult> results, Transaction* tr, KeyRange keys) {
+	state std::deque<PromiseStream<RangeResult>> subRangeResults;
+	state std::deque<Future<Void>> subRangeReads;
+
+	try {
+		state Standalone<VectorRef<KeyRef>> splitPoints =
+		    wait(tr->getRangeSplitPoints(keys, SERVER_KNOBS->FETCH_BLOCK_BYTES));
+		ASSERT(splitPoints.size() >= 2);
+		state int nextSubRange = 0;
+		loop {
+			while (nextSubRange + 1 < splitPoints.size() &&
+			       subRangeReads.size() < SERVER_KNOBS->FETCH_KEYS_PARALLEL_SUBRANGES) {
+				PromiseStream<RangeResult> subRangeResult;
+				subRangeReads.push_back(
+				    tryGetSubRange(subRangeResult,
+				                   tr,
+				                   KeyRangeRef(splitPoints[nextSubRange], splitPoints[nextSubRange + 1]),
+				                   nextSubRange + 2 == splitPoints.size()));
+				subRangeResults.push_back(subRangeResult);
+				++nextSubRange;
+			}
+			if (subRangeResults.empty()) {
+				break;
+			}
+
+			loop {
+				try {
+					RangeResult rep = waitNext(subRangeResults.front().getFuture());
+					results.send(rep);
+					wait(results.onEmpty());
+				} catch (Error& e) {
+					if (e.code() != error_code_end_of_stream) {
+						throw;
+					}
+					break;
+				}
+			}
+			subRangeResults.pop_front();
+			subRangeReads.pop_front();
+		}
+		results.sendError(end_of_stream());
+		return Void();
+	} catch (Error& e) {
+		if (e.code() == error_code_actor_cancelled) {
+			throw;
+		}
+		results.sendError(e);
+		throw;
+	}
+}
+
+ACTOR Future<Void> tryGetRange(PromiseStream<RangeResult> results, Transaction* tr, KeyRange keys) {
+	if (SERVER_KNOBS->FETCH_USING_STREAMING) {
+		wait(tr->getRangeStream(results, keys, GetRangeLimits(), Snapshot::True));
+	} else if (SERVER_KNOBS->FETCH_KEYS_PARALLEL_SUBRANGES > 1) {
+		wait(tryGetRangeParallel(results, tr, keys));
+	} else {
+		wait(tryGetSubRange(results, tr, keys, true));
+	}
+	return Void();
+}
+
 bool fetchKeyCanRetry(const Error& e) {
 	switch (e.code()) {
 	case error_code_end_of_stream:
@@ -7229,6 +8148,7 @@ ACTOR Future<Void> fetchKeys(StorageServer* data, AddingShard* shard) {
 					// Clear the key range before ingestion. This mirrors the replaceRange done in the case were
 					// we do not ingest SST files.
 					data->storage.getKeyValueStore()->clear(keys);
+					data->storage.invalidateReadCache(keys);
 
 					// Now wait on the durableVersion to be updated so clear has been committed.
 					wait(data->durableVersion.whenAtLeast(data->storageVersion() + 1));
@@ -7240,6 +8160,7 @@ ACTOR Future<Void> fetchKeys(StorageServer* data, AddingShard* shard) {
 					// Measure duration at this level so we capture the inter-thread handoff time.
 					state double ingestStartTime = g_network->timer(); // Record start time
 					wait(data->storage.getKeyValueStore()->ingestSSTFiles(localBulkLoadFileSets));
+					data->storage.invalidateReadCache(keys);
 					const double ingestDuration = g_network->timer() - ingestStartTime;
 					data->counters.ingestDurationLatencySample->addMeasurement(ingestDuration);
 
@@ -9344,9 +10265,11 @@ void StorageServer::addMutation(Version version,
 	    .detail("ShardEnd", shard.end);
 
 	if (!fromFetch) {
-		// TODO(gglass): it might be possible to delete code in this condition.
 		// have to do change feed before applyMutation because nonExpanded wasn't copied into the mutation log
 		// arena, and thus would go out of scope if it wasn't copied into the change feed arena
+		if (!uidChangeFeed.empty()) {
+			applyChangeFeedMutation(nonExpanded.type == MutationRef::ClearRange ? nonExpanded : expanded, version);
+		}
 
 		MutationRefAndCipherKeys encrypt = encryptedMutation;
 		if (encrypt.mutation.isEncrypted() && mutation.type != MutationRef::SetValue &&
@@ -9712,6 +10635,21 @@ ACTOR Future<Void> tssDelayForever() {
 	}
 }
 
+// Returns how many fewer versions than MAX_READ_TRANSACTION_LIFE_VERSIONS the storage server should keep in memory.
+// The window shrinks linearly from STORAGE_VERSION_WINDOW_SHRINK_BYTES of queued bytes to the hard limit, but never
+// below STORAGE_MIN_VERSIONS_IN_MEMORY.
+Version versionWindowShrink(StorageServer* data) {
+	const int64_t shrinkBytes = SERVER_KNOBS->STORAGE_VERSION_WINDOW_SHRINK_BYTES;
+	if (shrinkBytes <= 0 || data->queueSize() <= shrinkBytes) {
+		return 0;
+	}
+	const int64_t range = std::max<int64_t>(SERVER_KNOBS->STORAGE_HARD_LIMIT_BYTES - shrinkBytes, 1);
+	const double fraction = std::min(1.0, double(data->queueSize() - shrinkBytes) / range);
+	const Version maxShrink = std::max<Version>(
+	    SERVER_KNOBS->MAX_READ_TRANSACTION_LIFE_VERSIONS - SERVER_KNOBS->STORAGE_MIN_VERSIONS_IN_MEMORY, 0);
+	return fraction * maxShrink;
+}
+
 ACTOR Future<Void> update(StorageServer* data, bool* pReceivedUpdate) {
 	state double updateStart = g_network->timer();
 	state double decryptionTime = 0;
@@ -9786,6 +10724,18 @@ ACTOR Future<Void> update(StorageServer* data, bool* pReceivedUpdate) {
 			wait(data->byteSampleClearsTooLarge.onChange());
 		}
 
+		state ChangeFeedMemoryBudget* feedMemory = ChangeFeedMemoryBudget::get();
+		if (!data->uidChangeFeed.empty() && feedMemory->exceeded()) {
+			CODE_PROBE(true, "Storage server update waits for change feed memory");
+			TraceEvent(SevWarn, "ChangeFeedMemoryWait", data->thisServerID)
+			    .detail("Version", data->version.get())
+			    .detail("Bytes", feedMemory->bytes)
+			    .detail("Limit", SERVER_KNOBS->CHANGE_FEED_PROCESS_MAX_BYTES);
+			while (!data->uidChangeFeed.empty() && feedMemory->exceeded()) {
+				wait(feedMemory->released.onTrigger());
+			}
+		}
+
 		state Reference<ILogSystem::IPeekCursor> cursor = data->logCursor;
 
 		state double beforeTLogCursorReads = now();
@@ -10199,6 +11149,16 @@ ACTOR Future<Void> update(StorageServer* data, bool* pReceivedUpdate) {
 			if (data->primaryLocality == tagLocalitySpecial || data->tag.locality == data->primaryLocality) {
 				proposedOldestVersion = std::max(proposedOldestVersion, data->lastTLogVersion - maxVersionsInMemory);
 			}
+			// Under memory pressure keep fewer versions in memory, so that updateStorage makes them durable and frees
+			// the versioned data sooner. Reads older than the shortened window fail with transaction_too_old. Only
+			// versions known to be committed may be made durable early, since a rollback restores from disk.
+			Version windowShrink = versionWindowShrink(data);
+			if (windowShrink > 0) {
+				CODE_PROBE(true, "Storage server shrinks its in-memory version window under memory pressure");
+				proposedOldestVersion =
+				    std::max(proposedOldestVersion,
+				             std::min(proposedOldestVersion + windowShrink, cursor->getMinKnownCommittedVersion()));
+			}
 			proposedOldestVersion = std::min(proposedOldestVersion, data->version.get() - 1);
 			proposedOldestVersion = std::max(proposedOldestVersion, data->oldestVersion.get());
 			proposedOldestVersion = std::max(proposedOldestVersion, data->desiredOldestVersion.get());
@@ -11001,6 +11961,7 @@ void setRangeBasedBulkLoadStatus(StorageServer* self, KeyRangeRef keys, const SS
 }
 
 void StorageServerDisk::clearRange(KeyRangeRef keys) {
+	readCache.invalidate(keys);
 	storage->clear(keys);
 	++(*kvClearRanges);
 	if (keys.singleKeyRange()) {
@@ -11009,15 +11970,18 @@ void StorageServerDisk::clearRange(KeyRangeRef keys) {
 }
 
 void StorageServerDisk::writeKeyValue(KeyValueRef kv) {
+	readCache.invalidate(kv.key);
 	storage->set(kv);
 	*kvCommitLogicalBytes += kv.expectedSize();
 }
 
 void StorageServerDisk::writeMutation(MutationRef mutation) {
 	if (mutation.type == MutationRef::SetValue) {
+		readCache.invalidate(mutation.param1);
 		storage->set(KeyValueRef(mutation.param1, mutation.param2));
 		*kvCommitLogicalBytes += mutation.expectedSize();
 	} else if (mutation.type == MutationRef::ClearRange) {
+		readCache.invalidate(KeyRangeRef(mutation.param1, mutation.param2));
 		storage->clear(KeyRangeRef(mutation.param1, mutation.param2));
 		++(*kvClearRanges);
 		if (KeyRangeRef(mutation.param1, mutation.param2).singleKeyRange()) {
@@ -11057,9 +12021,11 @@ void StorageServerDisk::writeMutations(const VectorRef<MutationRef>& mutations,
 		DEBUG_MUTATION(debugContext, debugVersion, m, data->thisServerID);
 		ASSERT(m.validateChecksum());
 		if (m.type == MutationRef::SetValue) {
+			readCache.invalidate(m.param1);
 			storage->set(KeyValueRef(m.param1, m.param2));
 			*kvCommitLogicalBytes += m.expectedSize();
 		} else if (m.type == MutationRef::ClearRange) {
+			readCache.invalidate(KeyRangeRef(m.param1, m.param2));
 			storage->clear(KeyRangeRef(m.param1, m.param2));
 			++(*kvClearRanges);
 			if (KeyRangeRef(m.param1, m.param2).singleKeyRange()) {
@@ -11209,6 +12175,7 @@ ACTOR Future<Void> restoreByteSample(StorageServer* data,
 	byteSampleSampleRecovered.send(Void());
 	wait(startRestore);
 	wait(delay(SERVER_KNOBS->BYTE_SAMPLE_START_DELAY));
+	state double loadStart = now();
 
 	size_t bytes_per_fetch = 0;
 	// Since the expected size also includes (as of now) the space overhead of the container, we calculate our own
@@ -11239,7 +12206,9 @@ ACTOR Future<Void> restoreByteSample(StorageServer* data,
 	sampleRanges.push_back(applyByteSampleResult(data, storage, lastStart, persistByteSampleKeys.end));
 
 	wait(waitForAll(sampleRanges));
-	TraceEvent("RecoveredByteSampleChunkedRead", data->thisServerID).detail("Ranges", sampleRanges.size());
+	TraceEvent("RecoveredByteSampleChunkedRead", data->thisServerID)
+	    .detail("Ranges", sampleRanges.size())
+	    .detail("Duration", now() - loadStart);
 
 	if (BUGGIFY)
 		wait(delay(deterministicRandom()->random01() * 10.0));
@@ -11248,6 +12217,7 @@ ACTOR Future<Void> restoreByteSample(StorageServer* data,
 }
 
 ACTOR Future<bool> restoreDurableState(StorageServer* data, IKeyValueStore* storage) {
+	state double restoreStart = now();
 	state Future<Optional<Value>> fFormat = storage->readValue(persistFormat.key);
 	state Future<Optional<Value>> fID = storage->readValue(persistID);
 	state Future<Optional<Value>> ftssPairID = storage->readValue(persistTssPairID);
@@ -11282,7 +12252,8 @@ ACTOR Future<bool> restoreDurableState(StorageServer* data, IKeyValueStore* stor
 	                             fAccumulativeChecksum,
 	                             fBulkLoadTask }));
 	wait(byteSampleSampleRecovered.getFuture());
-	TraceEvent("RestoringDurableState", data->thisServerID).log();
+	state double readDone = now();
+	TraceEvent("RestoringDurableState", data->thisServerID).detail("ReadDuration", readDone - restoreStart);
 
 	if (!fFormat.get().present()) {
 		// The DB was never initialized
@@ -11564,6 +12535,14 @@ ACTOR Future<bool> restoreDurableState(StorageServer* data, IKeyValueStore* stor
 	validate(data, true);
 	startByteSampleRestore.send(Void());
 
+	// The byte sample keeps loading in the background after this, see RecoveredByteSampleChunkedRead
+	TraceEvent("RestoredDurableState", data->thisServerID)
+	    .detail("ReadDuration", readDone - restoreStart)
+	    .detail("RestoreDuration", now() - readDone)
+	    .detail("BytesRestored", data->bytesRestored)
+	    .detail("AssignedRanges", assigned.size())
+	    .detail("AvailableRanges", available.size());
+
 	return true;
 }
 
@@ -11946,6 +12925,24 @@ ACTOR Future<Void> checkBehind(StorageServer* self) {
 	}
 }
 
+// Feeds the read costs the storage engine sampled, such as pages it read from disk on cache misses, into read sampling
+// so that read hot shard detection reflects the IO a range actually causes
+ACTOR Future<Void> sampleStorageReadCost(StorageServer* self) {
+	loop {
+		wait(delay(SERVER_KNOBS->STORAGE_READ_COST_SAMPLE_DELAY));
+		std::vector<std::pair<Key, int64_t>> samples = self->storage.getKeyValueStore()->takeReadCostSamples();
+		if (!SERVER_KNOBS->READ_SAMPLING_ENABLED) {
+			continue;
+		}
+		for (const auto& [key, cost] : samples) {
+			// Reads of the storage server's own metadata are not attributed to any shard
+			if (key < allKeys.end) {
+				self->metrics.notifyReadCost(key, cost);
+			}
+		}
+	}
+}
+
 ACTOR Future<Void> serveGetValueRequests(StorageServer* self, FutureStream<GetValueRequest> getValue) {
 	getCurrentLineage()->modify(&TransactionLineage::operation) = TransactionLineage::Operation::GetValue;
 	loop {
@@ -11964,6 +12961,30 @@ ACTOR Future<Void> serveGetValueRequests(StorageServer* self, FutureStream<GetVa
 	}
 }
 
+ACTOR Future<Void> serveGetValuesRequests(StorageServer* self, FutureStream<GetValuesRequest> getValues) {
+	getCurrentLineage()->modify(&TransactionLineage::operation) = TransactionLineage::Operation::GetValue;
+	loop {
+		GetValuesRequest req = waitNext(getValues);
+		// Warning: This code is executed at extremely high priority (TaskPriority::LoadBalancedEndpoint), so
+		// downgrade before doing real work
+		if (req.options.present() && req.options.get().debugID.present())
+			g_traceBatch.addEvent("GetValueDebug", req.options.get().debugID.get().first(), "storageServer.received");
+
+		self->actors.add(self->readGuard(req, getValuesQ));
+	}
+}
+
+ACTOR Future<Void> serveGetRangeAggregateRequests(StorageServer* self,
+                                                  FutureStream<GetRangeAggregateRequest> getRangeAggregate) {
+	getCurrentLineage()->modify(&TransactionLineage::operation) = TransactionLineage::Operation::GetKeyValues;
+	loop {
+		GetRangeAggregateRequest req = waitNext(getRangeAggregate);
+		// Warning: This code is executed at extremely high priority (TaskPriority::LoadBalancedEndpoint), so
+		// downgrade before doing real work
+		self->actors.add(self->readGuard(req, getRangeAggregateQ));
+	}
+}
+
 ACTOR Future<Void> serveGetKeyValuesRequests(StorageServer* self, FutureStream<GetKeyValuesRequest> getKeyValues) {
 	getCurrentLineage()->modify(&TransactionLineage::operation) = TransactionLineage::Operation::GetKeyValues;
 	loop {
@@ -12142,14 +13163,219 @@ ACTOR Future<Void> serveWatchValueRequests(StorageServer* self, FutureStream<Wat
 	}
 }
 
-// Change feed related message handlers that exist but do nothing.
-// The reason for these existing is that we do not want to change the StorageServerInterface
-// to remove change feed related interfaces.  Figure out how to do that later.
+// Change feeds are served from memory. A feed is registered by the first ChangeFeedStreamRequest naming its rangeID
+// and from then on accumulates the mutations applied to its range, until it is popped or trimmed to
+// CHANGE_FEED_MAX_BYTES. Feeds without a stream for CHANGE_FEED_IDLE_TIMEOUT seconds are removed.
+
+// Returns a reply with the mutations in [begin, end) of the feed that intersect range, up to byteLimit bytes.
+// Versions with no mutations in range are compacted away, but if the reply would otherwise be empty the latest
+// version the feed is known to be complete through is included as an empty entry so the reader can make progress.
+ChangeFeedStreamReply getChangeFeedMutations(StorageServer* data,
+                                             Reference<ChangeFeedInfo> feed,
+                                             KeyRangeRef range,
+                                             Version begin,
+                                             Version end,
+                                             int byteLimit) {
+	ChangeFeedStreamReply reply;
+	reply.popVersion = feed->popVersion;
+	reply.minStreamVersion = invalidVersion;
+
+	// The feed is complete through the storage server's version, since mutations are added before version is set
+	Version completeVersion = std::min(data->version.get(), end - 1);
+	Version lastVersion = begin - 1;
+	int bytes = 0;
+
+	auto it = std::lower_bound(feed->mutations.begin(),
+	                           feed->mutations.end(),
+	                           MutationsAndVersionRef(begin, 0),
+	                           MutationsAndVersionRef::OrderByVersion());
+	for (; it != feed->mutations.end() && it->version <= completeVersion; ++it) {
+		if (bytes >= byteLimit) {
+			break;
+		}
+		MutationsAndVersionRef filtered(it->version, it->knownCommittedVersion);
+		for (auto& m : it->mutations) {
+			if (m.type == MutationRef::SetValue ? range.contains(m.param1)
+			                                    : range.intersects(KeyRangeRef(m.param1, m.param2))) {
+				MutationRef clipped = m;
+				if (m.type == MutationRef::ClearRange) {
+					clipped.param1 = std::max(m.param1, range.begin);
+					clipped.param2 = std::min(m.param2, range.end);
+				}
+				filtered.mutations.push_back_deep(reply.arena, clipped);
+				bytes += clipped.expectedSize();
+			}
+		}
+		if (!filtered.mutations.empty()) {
+			reply.mutations.push_back(reply.arena, filtered);
+			bytes += sizeof(MutationsAndVersionRef);
+		}
+		lastVersion = it->version;
+	}
+
+	if (it == feed->mutations.end() || it->version > completeVersion) {
+		// Everything up to completeVersion has been returned
+		lastVersion = std::max(lastVersion, completeVersion);
+		reply.atLatestVersion = completeVersion == data->version.get();
+	}
+	if (lastVersion >= begin &&
+	    (reply.mutations.empty() || reply.mutations.back().version != lastVersion)) {
+		reply.mutations.push_back(reply.arena,
+		                          MutationsAndVersionRef(lastVersion, data->knownCommittedVersion.get()));
+	}
+	reply.minStreamVersion = lastVersion;
+	data->counters.feedBytesFetched += bytes;
+	return reply;
+}
+
+ACTOR Future<Void> changeFeedStreamQ(StorageServer* data, ChangeFeedStreamRequest req) {
+	state Span span("SS:getChangeFeedStream"_loc, req.spanContext);
+	state Reference<ChangeFeedInfo> feed;
+	state Version begin = req.begin;
+	state int64_t streamBytes =
+	    req.replyBufferSize > 0 ? std::min<int64_t>(req.replyBufferSize, SERVER_KNOBS->CHANGEFEEDSTREAM_LIMIT_BYTES)
+	                            : SERVER_KNOBS->CHANGEFEEDSTREAM_LIMIT_BYTES;
+	req.reply.setByteLimit(streamBytes);
+
+	++data->activeFeedStreams;
+	wait(delay(0, TaskPriority::DefaultEndpoint));
+
+	try {
+		if (data->activeFeedStreams > SERVER_KNOBS->STORAGE_FEED_STREAM_HARD_LIMIT) {
+			throw storage_too_many_feed_streams();
+		}
+		if (req.range.empty() || req.range.end > allKeys.end || req.end <= req.begin) {
+			throw unknown_change_feed();
+		}
+		for (auto& shard : data->shards.intersectingRanges(req.range)) {
+			if (!shard.value()->isReadable()) {
+				throw wrong_shard_server();
+			}
+		}
+
+		feed = data->registerChangeFeed(req.rangeID, req.range);
+		if (!feed->range.contains(req.range)) {
+			throw unknown_change_feed();
+		}
+		++feed->activeStreams;
+
+		loop {
+			if (begin < feed->popVersion) {
+				if (!req.canReadPopped) {
+					throw change_feed_popped();
+				}
+				begin = feed->popVersion;
+			}
+
+			if (begin > data->version.get()) {
+				// Wait for the next version, then briefly for more versions to accumulate into the same reply. The
+				// heartbeat makes sure shard ownership is rechecked on idle feeds.
+				choose {
+					when(wait(data->version.whenAtLeast(begin))) {}
+					when(wait(delay(SERVER_KNOBS->CHANGE_FEED_HEARTBEAT_INTERVAL))) {}
+				}
+				if (SERVER_KNOBS->CHANGE_FEED_STREAM_BATCH_DELAY > 0 && data->version.get() >= begin) {
+					wait(delay(SERVER_KNOBS->CHANGE_FEED_STREAM_BATCH_DELAY, TaskPriority::DefaultEndpoint));
+				}
+			}
+			wait(req.reply.onReady());
+
+			for (auto& shard : data->shards.intersectingRanges(req.range)) {
+				if (!shard.value()->isReadable()) {
+					throw wrong_shard_server();
+				}
+			}
+
+			int byteLimit = (BUGGIFY && g_network->isSimulated()) ? 1 : CLIENT_KNOBS->REPLY_BYTE_LIMIT;
+			ChangeFeedStreamReply reply = getChangeFeedMutations(data, feed, req.range, begin, req.end, byteLimit);
+			feed->lastActive = now();
+			if (!reply.mutations.empty()) {
+				begin = reply.mutations.back().version + 1;
+				req.reply.send(reply);
+			}
+			if (begin >= req.end) {
+				req.reply.sendError(end_of_stream());
+				break;
+			}
+		}
+	} catch (Error& e) {
+		--data->activeFeedStreams;
+		if (feed.isValid()) {
+			--feed->activeStreams;
+			feed->lastActive = now();
+		}
+		if (e.code() != error_code_operation_obsolete) {
+			if (!canReplyWith(e))
+				throw;
+			req.reply.sendError(e);
+		}
+		return Void();
+	}
+
+	--data->activeFeedStreams;
+	--feed->activeStreams;
+	feed->lastActive = now();
+	return Void();
+}
+
+ACTOR Future<Void> changeFeedPopQ(StorageServer* data, ChangeFeedPopRequest req) {
+	wait(delay(0, TaskPriority::DefaultEndpoint));
+	auto it = data->uidChangeFeed.find(req.rangeID);
+	if (it == data->uidChangeFeed.end()) {
+		req.reply.sendError(unknown_change_feed());
+		return Void();
+	}
+	TraceEvent(SevDebug, "ChangeFeedPop", data->thisServerID)
+	    .detail("FeedID", req.rangeID)
+	    .detail("Version", req.version)
+	    .detail("PopVersion", it->second->popVersion);
+	it->second->pop(req.version);
+	req.reply.send(Void());
+	return Void();
+}
+
+ACTOR Future<Void> overlappingChangeFeedsQ(StorageServer* data, OverlappingChangeFeedsRequest req) {
+	wait(delay(0, TaskPriority::DefaultEndpoint));
+	try {
+		wait(success(waitForVersionNoTooOld(data, req.minVersion)));
+	} catch (Error& e) {
+		if (!canReplyWith(e)) {
+			throw;
+		}
+		req.reply.sendError(e);
+		return Void();
+	}
+
+	Version metadataVersion = data->version.get();
+	OverlappingChangeFeedsReply reply;
+	reply.feedMetadataVersion = metadataVersion;
+	std::unordered_set<ChangeFeedInfo*> seen;
+	for (auto& r : data->keyChangeFeed.intersectingRanges(req.range)) {
+		for (auto& feed : r.value()) {
+			if (seen.insert(feed.getPtr()).second) {
+				reply.feeds.push_back_deep(
+				    reply.arena,
+				    OverlappingChangeFeedEntry(
+				        feed->id, feed->range, feed->emptyVersion, feed->stopVersion, metadataVersion));
+			}
+		}
+	}
+	req.reply.send(reply);
+	return Void();
+}
+
+ACTOR Future<Void> changeFeedVersionUpdateQ(StorageServer* data, ChangeFeedVersionUpdateRequest req) {
+	wait(data->version.whenAtLeast(req.minVersion));
+	wait(delay(0, TaskPriority::DefaultEndpoint));
+	req.reply.send(ChangeFeedVersionUpdateReply(data->version.get()));
+	return Void();
+}
+
 ACTOR Future<Void> serveChangeFeedStreamRequests(StorageServer* self,
                                                  FutureStream<ChangeFeedStreamRequest> changeFeedStream) {
 	loop {
 		ChangeFeedStreamRequest req = waitNext(changeFeedStream);
-		TraceEvent(SevWarn, "serveChangeFeedStreamRequests").detail("Unexpected", "Invocation");
+		self->actors.add(changeFeedStreamQ(self, req));
 	}
 }
 
@@ -12158,14 +13384,14 @@ ACTOR Future<Void> serveOverlappingChangeFeedsRequests(
     FutureStream<OverlappingChangeFeedsRequest> overlappingChangeFeeds) {
 	loop {
 		OverlappingChangeFeedsRequest req = waitNext(overlappingChangeFeeds);
-		TraceEvent(SevWarn, "serveOverlappingChangeFeedsRequests").detail("Unexpected", "Invocation");
+		self->actors.add(overlappingChangeFeedsQ(self, req));
 	}
 }
 
 ACTOR Future<Void> serveChangeFeedPopRequests(StorageServer* self, FutureStream<ChangeFeedPopRequest> changeFeedPops) {
 	loop {
 		ChangeFeedPopRequest req = waitNext(changeFeedPops);
-		TraceEvent(SevWarn, "serveChangeFeedPopRequests").detail("Unexpected", "Invocation");
+		self->actors.add(changeFeedPopQ(self, req));
 	}
 }
 
@@ -12174,7 +13400,74 @@ ACTOR Future<Void> serveChangeFeedVersionUpdateRequests(
     FutureStream<ChangeFeedVersionUpdateRequest> changeFeedVersionUpdate) {
 	loop {
 		ChangeFeedVersionUpdateRequest req = waitNext(changeFeedVersionUpdate);
-		TraceEvent(SevWarn, "serveChangeFeedVersionUpdateRequests").detail("Unexpected", "Invocation");
+		self->actors.add(changeFeedVersionUpdateQ(self, req));
+	}
+}
+
+TEST_CASE("/fdbserver/storageserver/changeFeedInfo") {
+	auto feed = makeReference<ChangeFeedInfo>("feed"_sr, KeyRangeRef("a"_sr, "m"_sr), 10);
+	ASSERT_EQ(feed->popVersion, 11);
+
+	feed->push(11, 5, MutationRef(MutationRef::SetValue, "b"_sr, "1"_sr));
+	feed->push(11, 5, MutationRef(MutationRef::SetValue, "c"_sr, "2"_sr));
+	feed->push(12, 5, MutationRef(MutationRef::ClearRange, "a"_sr, "d"_sr));
+	feed->push(14, 6, MutationRef(MutationRef::SetValue, "b"_sr, "3"_sr));
+	ASSERT(feed->mutations.size() == 3);
+	ASSERT(feed->mutations[0].mutations.size() == 2);
+
+	// Popping in between versions keeps the later ones
+	feed->pop(13);
+	ASSERT_EQ(feed->popVersion, 13);
+	ASSERT_EQ(feed->emptyVersion, 12);
+	ASSERT(feed->mutations.size() == 1);
+	ASSERT_EQ(feed->mutations[0].version, 14);
+
+	// Popping backwards does nothing
+	feed->pop(12);
+	ASSERT_EQ(feed->popVersion, 13);
+
+	// Trimming never discards the latest version
+	feed->push(15, 6, MutationRef(MutationRef::SetValue, "e"_sr, "4"_sr));
+	feed->trim(0);
+	ASSERT(feed->mutations.size() == 1);
+	ASSERT_EQ(feed->mutations[0].version, 15);
+	ASSERT_EQ(feed->popVersion, 15);
+
+	feed->pop(16);
+	ASSERT(feed->mutations.empty());
+	ASSERT_EQ(feed->bytes, 0);
+
+	// Feeds sharing a budget count their memory against it until they are destroyed
+	ChangeFeedMemoryBudget budget;
+	auto a = makeReference<ChangeFeedInfo>("a"_sr, KeyRangeRef("a"_sr, "m"_sr), 10, &budget);
+	auto b = makeReference<ChangeFeedInfo>("b"_sr, KeyRangeRef("c"_sr, "z"_sr), 10, &budget);
+	a->push(11, 5, MutationRef(MutationRef::SetValue, "b"_sr, "1"_sr));
+	b->push(11, 5, MutationRef(MutationRef::SetValue, "d"_sr, "2"_sr));
+	b->push(12, 5, MutationRef(MutationRef::SetValue, "e"_sr, "3"_sr));
+	ASSERT_EQ(budget.bytes, a->bytes + b->bytes);
+	b->pop(12);
+	ASSERT_EQ(budget.bytes, a->bytes + b->bytes);
+	a.clear();
+	ASSERT_EQ(budget.bytes, b->bytes);
+	b.clear();
+	ASSERT_EQ(budget.bytes, 0);
+
+	return Void();
+}
+
+// Removes feeds which have had no stream attached to them for CHANGE_FEED_IDLE_TIMEOUT seconds
+ACTOR Future<Void> changeFeedExpirer(StorageServer* self) {
+	loop {
+		wait(delay(SERVER_KNOBS->CHANGE_FEED_IDLE_TIMEOUT / 2));
+		std::vector<Reference<ChangeFeedInfo>> expired;
+		for (auto& [id, feed] : self->uidChangeFeed) {
+			if (feed->activeStreams == 0 && now() - feed->lastActive > SERVER_KNOBS->CHANGE_FEED_IDLE_TIMEOUT) {
+				expired.push_back(feed);
+			}
+		}
+		for (auto& feed : expired) {
+			self->removeChangeFeed(feed);
+		}
 	}
 }
 
@@ -12294,7 +13587,10 @@ ACTOR Future<Void> storageServerCore(StorageServer* self, StorageServerInterface
 	self->actors.add(metricsCore(self, ssi));
 	self->actors.add(logLongByteSampleRecovery(self->byteSampleRecovery));
 	self->actors.add(checkBehind(self));
+	self->actors.add(sampleStorageReadCost(self));
 	self->actors.add(serveGetValueRequests(self, ssi.getValue.getFuture()));
+	self->actors.add(serveGetValuesRequests(self, ssi.getValues.getFuture()));
+	self->actors.add(serveGetRangeAggregateRequests(self, ssi.getRangeAggregate.getFuture()));
 	self->actors.add(serveGetKeyValuesRequests(self, ssi.getKeyValues.getFuture()));
 	self->actors.add(serveGetMappedKeyValuesRequests(self, ssi.getMappedKeyValues.getFuture()));
 	self->actors.add(serveGetKeyValuesStreamRequests(self, ssi.getKeyValuesStream.getFuture()));
@@ -12304,6 +13600,7 @@ ACTOR Future<Void> storageServerCore(StorageServer* self, StorageServerInterface
 	self->actors.add(serveOverlappingChangeFeedsRequests(self, ssi.overlappingChangeFeeds.getFuture()));
 	self->actors.add(serveChangeFeedPopRequests(self, ssi.changeFeedPop.getFuture()));
 	self->actors.add(serveChangeFeedVersionUpdateRequests(self, ssi.changeFeedVersionUpdate.getFuture()));
+	self->actors.add(changeFeedExpirer(self));
 	self->actors.add(traceRole(Role::STORAGE_SERVER, ssi.id()));
 	self->actors.add(reportStorageServerState(self));
 	self->actors.add(storageEngineConsistencyCheck(self));
@@ -78,6 +78,7 @@
 #include "fdbclient/ThreadSafeTransaction.h"
 #include "flow/ApiVersion.h"
 #include "fdbctl/ControlService.h"
+#include "fdbserver/StorageReadService.h"
 
 #ifdef __linux__
 #include <fcntl.h>
@@ -362,6 +363,49 @@ StringRef fileVersionedLogDataPrefix = "log2-"_sr;
 StringRef fileLogQueuePrefix = "logqueue-"_sr;
 StringRef tlogQueueExtension = "fdq"_sr;
 
+// Returns the basename of the disk queue named name for a TLog whose data store is in folder.  New queues are created
+// in TLOG_DISK_QUEUE_FOLDER when it is set, so that queue commits are synced on a different device than the spilled
+// data.  Where a queue was created is recorded in a file beside the data store, so an existing queue is always opened
+// where it lives even if the knob has since been changed or unset; opening a new, empty queue instead would silently
+// lose the TLog's committed data.
+static std::string tLogQueueBasename(std::string const& folder, std::string const& name) {
+	const std::string local = joinPath(folder, name);
+	const std::string locationFile = local + "location";
+	if (fileExists(local + "0." + tlogQueueExtension.toString())) {
+		return local;
+	}
+	if (fileExists(locationFile)) {
+		std::string basename = readFileBytes(locationFile, 1e5);
+		if (SERVER_KNOBS->TLOG_DISK_QUEUE_FOLDER.empty() ||
+		    basename != joinPath(SERVER_KNOBS->TLOG_DISK_QUEUE_FOLDER, name)) {
+			TraceEvent(SevWarnAlways, "TLogDiskQueueFolderMismatch")
+			    .detail("Queue", basename)
+			    .detail("TLogDiskQueueFolder", SERVER_KNOBS->TLOG_DISK_QUEUE_FOLDER);
+		}
+		return basename;
+	}
+	if (SERVER_KNOBS->TLOG_DISK_QUEUE_FOLDER.empty()) {
+		return local;
+	}
+	platform::createDirectory(SERVER_KNOBS->TLOG_DISK_QUEUE_FOLDER);
+	const std::string basename = joinPath(SERVER_KNOBS->TLOG_DISK_QUEUE_FOLDER, name);
+	atomicReplace(locationFile, basename);
+	return basename;
+}
+
+// Waits for the disk queue named name to close, then removes the file recording where it lives if the queue's files
+// are gone, i.e. the queue was disposed of along with its TLog.  A queue that is only closed, such as on shutdown,
+// keeps its location file so that it is found again on restart.
+ACTOR Future<Void> removeTLogQueueLocation(Future<Void> queueClosed, std::string folder, std::string name) {
+	wait(queueClosed);
+	state std::string locationFile = joinPath(folder, name) + "location";
+	if (fileExists(locationFile) &&
+	    !fileExists(readFileBytes(locationFile, 1e5) + "0." + tlogQueueExtension.toString())) {
+		wait(IAsyncFileSystem::filesystem()->deleteFile(locationFile, true));
+	}
+	return Void();
+}
+
 enum class FilesystemCheck {
 	FILES_ONLY,
 	DIRECTORIES_ONLY,
@@ -1778,6 +1822,8 @@ ACTOR Future<Void> storageServerRollbackRebooter(std::set<std::pair<UID, KeyValu
 		recruited.initEndpoints();
 
 		DUMPTOKEN(recruited.getValue);
+		DUMPTOKEN(recruited.getValues);
+		DUMPTOKEN(recruited.getRangeAggregate);
 		DUMPTOKEN(recruited.getKey);
 		DUMPTOKEN(recruited.getKeyValues);
 		DUMPTOKEN(recruited.getMappedKeyValues);
@@ -2152,7 +2198,9 @@ bool skipInitRspInSim(const UID workerInterfID, const bool allowDropInSim) {
 }
 
 #ifdef FLOW_GRPC_ENABLED
-ACTOR Future<Void> registerWorkerGrpcServices(UID id, Reference<IClusterConnectionRecord> ccr) {
+ACTOR Future<Void> registerWorkerGrpcServices(UID id,
+                                              Reference<IClusterConnectionRecord> ccr,
+                                              std::shared_ptr<LocalStorageServers> storageServers) {
 	if (GrpcServer::instance() == nullptr) {
 		return Never();
 	} else if (g_network->isSimulated()) {
@@ -2161,17 +2209,35 @@ ACTOR Future<Void> registerWorkerGrpcServices(UID id, Reference<IClusterConnecti
 
 	auto db = Database::createDatabase(ccr, ApiVersion::LATEST_VERSION);
 	Reference<IDatabase> idb = wait(safeThreadFutureToFuture(ThreadSafeDatabase::createFromExistingDatabase(db)));
-	auto services = GrpcServer::ServiceList{ std::make_shared<fdbctl::ControlServiceImpl>(idb) };
+	auto services = GrpcServer::ServiceList{ std::make_shared<fdbctl::ControlServiceImpl>(idb),
+		                                     std::make_shared<StorageReadServiceImpl>(db, storageServers) };
 	GrpcServer::instance()->registerRoleServices(UID(), services);
 	TraceEvent("WorkerGrpcServerStart").detail("Address", GrpcServer::instance()->getAddress());
 	return Never();
 }
 #else
-ACTOR Future<Void> registerWorkerGrpcServices(UID id, Reference<IClusterConnectionRecord> ccr) {
+ACTOR Future<Void> registerWorkerGrpcServices(UID id,
+                                              Reference<IClusterConnectionRecord> ccr,
+                                              std::shared_ptr<LocalStorageServers> storageServers) {
 	return Never();
 }
 #endif
 
+// Makes the storage server readable through StorageReadService for as long as it runs
+ACTOR Future<Void> addLocalStorageServer(std::shared_ptr<LocalStorageServers> storageServers,
+                                         StorageServerInterface ssi,
+                                         Future<Void> storageServer) {
+	storageServers->interfaces[ssi.id()] = ssi;
+	try {
+		wait(storageServer);
+	} catch (Error& e) {
+		storageServers->interfaces.erase(ssi.id());
+		throw;
+	}
+	storageServers->interfaces.erase(ssi.id());
+	return Void();
+}
+
 ACTOR Future<Void> workerServer(Reference<IClusterConnectionRecord> connRecord,
                                 Reference<AsyncVar<Optional<ClusterControllerFullInterface>> const> ccInterface,
                                 LocalityData locality,
@@ -2248,7 +2314,8 @@ ACTOR Future<Void> workerServer(Reference<IClusterConnectionRecord> connRecord,
 	state Reference<AsyncVar<bool>> enablePrimaryTxnSystemHealthCheck = makeReference<AsyncVar<bool>>(false);
 
 	wait(yield());
-	state Future<Void> grpc = registerWorkerGrpcServices(interf.id(), connRecord);
+	state std::shared_ptr<LocalStorageServers> localStorageServers = std::make_shared<LocalStorageServers>();
+	state Future<Void> grpc = registerWorkerGrpcServices(interf.id(), connRecord, localStorageServers);
 
 	if (FLOW_KNOBS->ENABLE_CHAOS_FEATURES) {
 		TraceEvent(SevInfo, "ChaosFeaturesEnabled");
@@ -2389,6 +2456,8 @@ ACTOR Future<Void> workerServer(Reference<IClusterConnectionRecord> connRecord,
 				startRole(ssRole, recruited.id(), interf.id(), details, "Restored");
 
 				DUMPTOKEN(recruited.getValue);
+				DUMPTOKEN(recruited.getValues);
+				DUMPTOKEN(recruited.getRangeAggregate);
 				DUMPTOKEN(recruited.getKey);
 				DUMPTOKEN(recruited.getKeyValues);
 				DUMPTOKEN(recruited.getMappedKeyValues);
@@ -2429,6 +2498,9 @@ ACTOR Future<Void> workerServer(Reference<IClusterConnectionRecord> connRecord,
 				                                  validateDataFiles,
 				                                  &rebootKVSPromise,
 				                                  encryptionMonitor);
+				if (!isTss) {
+					f = addLocalStorageServer(localStorageServers, recruited, f);
+				}
 				errorForwarders.add(forwardError(errors, ssRole, recruited.id(), f));
 			} else if (s.storedComponent == DiskStore::TLogData) {
 				LocalLineage _;
@@ -2454,13 +2526,14 @@ ACTOR Future<Void> workerServer(Reference<IClusterConnectionRecord> connRecord,
 				const DiskQueueVersion dqv = s.tLogOptions.getDiskQueueVersion();
 				const int64_t diskQueueWarnSize =
 				    s.tLogOptions.spillType == TLogSpillType::VALUE ? 10 * SERVER_KNOBS->TARGET_BYTES_PER_TLOG : -1;
-				IDiskQueue* queue = openDiskQueue(joinPath(folder, logQueueBasename + s.storeID.toString() + "-"),
+				const std::string queueName = logQueueBasename + s.storeID.toString() + "-";
+				IDiskQueue* queue = openDiskQueue(tLogQueueBasename(folder, queueName),
 				                                  tlogQueueExtension.toString(),
 				                                  s.storeID,
 				                                  dqv,
 				                                  diskQueueWarnSize);
 				filesClosed.add(kv->onClosed());
-				filesClosed.add(queue->onClosed());
+				filesClosed.add(removeTLogQueueLocation(queue->onClosed(), folder, queueName));
 
 				std::map<std::string, std::string> details;
 				details["StorageEngine"] = s.storeType.toString();
@@ -2856,14 +2929,12 @@ ACTOR Future<Void> workerServer(Reference<IClusterConnectionRecord> connRecord,
 					                                   dbInfo,
 					                                   EncryptionAtRestMode());
 					const DiskQueueVersion dqv = tLogOptions.getDiskQueueVersion();
+					const std::string queueName =
+					    fileLogQueuePrefix.toString() + tLogOptions.toPrefix() + logId.toString() + "-";
 					IDiskQueue* queue = openDiskQueue(
-					    joinPath(folder,
-					             fileLogQueuePrefix.toString() + tLogOptions.toPrefix() + logId.toString() + "-"),
-					    tlogQueueExtension.toString(),
-					    logId,
-					    dqv);
+					    tLogQueueBasename(folder, queueName), tlogQueueExtension.toString(), logId, dqv);
 					filesClosed.add(data->onClosed());
-					filesClosed.add(queue->onClosed());
+					filesClosed.add(removeTLogQueueLocation(queue->onClosed(), folder, queueName));
 
 					logData.push_back(SharedLogsValue());
 					Future<Void> tLogCore = tLogFn(data,
@@ -2944,6 +3015,8 @@ ACTOR Future<Void> workerServer(Reference<IClusterConnectionRecord> connRecord,
 					    .detail("WorkerID", interf.id());
 
 					DUMPTOKEN(recruited.getValue);
+					DUMPTOKEN(recruited.getValues);
+					DUMPTOKEN(recruited.getRangeAggregate);
 					DUMPTOKEN(recruited.getKey);
 					DUMPTOKEN(recruited.getKeyValues);
 					DUMPTOKEN(recruited.getMappedKeyValues);
@@ -3025,6 +3098,9 @@ ACTOR Future<Void> workerServer(Reference<IClusterConnectionRecord> connRecord,
 					                                  false,
 					                                  &rebootKVSPromise2,
 					                                  encryptionMonitor);
+					if (!isTss) {
+						s = addLocalStorageServer(localStorageServers, recruited, s);
+					}
 					errorForwarders.add(forwardError(errors, ssRole, recruited.id(), s));
 				} else {
 					TraceEvent("AttemptedDoubleRecruitment", interf.id()).detail("ForRole", "StorageServer");
@@ -174,10 +174,22 @@ ACTOR Future<Void> testKVRead(KVTest* test, Key key, TestHistogram<float>* laten
 	return Void();
 }
 
-ACTOR Future<Void> testKVReadSaturation(KVTest* test, TestHistogram<float>* latency, PerfIntCounter* count) {
+// Reads single keys, or ranges of up to rangeReadRows rows starting at a random key if rangeReadRows is positive.
+ACTOR Future<Void> testKVReadSaturation(KVTest* test,
+                                        int rangeReadRows,
+                                        TestHistogram<float>* latency,
+                                        PerfIntCounter* count,
+                                        PerfIntCounter* rows) {
 	while (true) {
 		state double begin = timer();
-		Optional<Value> val = wait(test->store->readValue(test->randomKey()));
+		if (rangeReadRows > 0) {
+			RangeResult kv = wait(test->store->readRange(KeyRangeRef(test->randomKey(), "\xff\xff\xff\xff"_sr),
+			                                             rangeReadRows));
+			*rows += kv.size();
+		} else {
+			Optional<Value> val = wait(test->store->readValue(test->randomKey()));
+			++*rows;
+		}
 		latency->addSample(timer() - begin);
 		++*count;
 		wait(delay(0));
@@ -203,15 +215,16 @@ struct KVStoreTestWorkload : TestWorkload {
 	double testDuration, operationsPerSecond;
 	double commitFraction, setFraction;
 	int nodeCount, keyBytes, valueBytes;
+	int readers, rangeReadRows;
 	bool doSetup, doClear, doCount;
 	std::string filename;
-	PerfIntCounter reads, sets, commits;
+	PerfIntCounter reads, rowsRead, sets, commits;
 	TestHistogram<float> readLatency, commitLatency;
 	double setupTook;
 	KeyValueStoreType storeType;
 
 	KVStoreTestWorkload(WorkloadContext const& wcx)
-	  : TestWorkload(wcx), reads("Reads"), sets("Sets"), commits("Commits"), setupTook(0) {
+	  : TestWorkload(wcx), reads("Reads"), rowsRead("RowsRead"), sets("Sets"), commits("Commits"), setupTook(0) {
 		enabled = !clientId; // only do this on the "first" client
 		testDuration = getOption(options, "testDuration"_sr, 10.0);
 		operationsPerSecond = getOption(options, "operationsPerSecond"_sr, 100e3);
@@ -220,6 +233,8 @@ struct KVStoreTestWorkload : TestWorkload {
 		nodeCount = getOption(options, "nodeCount"_sr, 100000);
 		keyBytes = getOption(options, "keyBytes"_sr, 8);
 		valueBytes = getOption(options, "valueBytes"_sr, 8);
+		readers = getOption(options, "readers"_sr, 100);
+		rangeReadRows = getOption(options, "rangeReadRows"_sr, 0);
 		doSetup = getOption(options, "setup"_sr, false);
 		doClear = getOption(options, "clear"_sr, false);
 		doCount = getOption(options, "count"_sr, false);
@@ -246,6 +261,7 @@ struct KVStoreTestWorkload : TestWorkload {
 			m.emplace_back("SetupTook", setupTook, Averaged::False);
 
 		m.push_back(reads.getMetric());
+		m.push_back(rowsRead.getMetric());
 		m.push_back(sets.getMetric());
 		m.push_back(commits.getMetric());
 		metricsFromHistogram(m, "Read Latency (ms)", readLatency);
@@ -322,9 +338,13 @@ ACTOR Future<Void> testKVStoreMain(KVStoreTestWorkload* workload, KVTest* ptest)
 			}
 		} else {
 			std::vector<Future<Void>> actors;
-			actors.reserve(100);
-			for (int a = 0; a < 100; a++)
-				actors.push_back(testKVReadSaturation(&test, &workload->readLatency, &workload->reads));
+			actors.reserve(workload->readers);
+			for (int a = 0; a < workload->readers; a++)
+				actors.push_back(testKVReadSaturation(&test,
+				                                      workload->rangeReadRows,
+				                                      &workload->readLatency,
+				                                      &workload->reads,
+				                                      &workload->rowsRead));
 			wait(timeout(waitForAll(actors), workload->testDuration, Void()));
 		}
 	} else {
@@ -31,12 +31,42 @@ public:
 	MockDataDistributor dataDistributor;
 	ActorCollection actors;
 
+	// --- placement quality, sampled every second while DD runs ---
+	double peakLoadRatio = 0; // the highest ratio of the most loaded server's bytes to the mean
+	double lastLoadRatio = 0;
+	double convergenceTime = 0; // when the load ratio last rose above balancedLoadRatio
+
 	// --- test configs ---
+	double balancedLoadRatio = 1.1;
 
 	explicit MockDDReadWriteWorkload(WorkloadContext const& wcx)
 	  : MockDDTestWorkload(wcx),
 	    ddcx(makeReference<DDSharedContext>(
-	        DataDistributorInterface(LocalityData(), deterministicRandom()->randomUniqueID()))) {}
+	        DataDistributorInterface(LocalityData(), deterministicRandom()->randomUniqueID()))) {
+		balancedLoadRatio = getOption(options, "balancedLoadRatio"_sr, balancedLoadRatio);
+	}
+
+	// The ratio of the bytes on the most loaded storage server to the mean
+	double getLoadRatio() const {
+		int64_t total = 0, most = 0;
+		for (const auto& [_, server] : sharedMgs->allServers) {
+			total += server->usedDiskSpace;
+			most = std::max<int64_t>(most, server->usedDiskSpace);
+		}
+		return total > 0 ? most * (double)sharedMgs->allServers.size() / total : 1.0;
+	}
+
+	ACTOR static Future<Void> sampleLoad(MockDDReadWriteWorkload* self) {
+		state double start = now();
+		loop {
+			self->lastLoadRatio = self->getLoadRatio();
+			self->peakLoadRatio = std::max(self->peakLoadRatio, self->lastLoadRatio);
+			if (self->lastLoadRatio > self->balancedLoadRatio) {
+				self->convergenceTime = now() - start;
+			}
+			wait(delay(1.0));
+		}
+	}
 
 	Future<Void> setup(Database const& cx) override {
 		if (!enabled)
@@ -57,6 +87,7 @@ public:
 		actors.add(waitForAll(sharedMgs->runAllMockServers()));
 		// start data distributor
 		actors.add(dataDistributor.run(ddcx, mock));
+		actors.add(sampleLoad(this));
 
 		return delay(testDuration);
 	}
@@ -67,7 +98,19 @@ public:
 		return true;
 	}
 
-	void getMetrics(std::vector<PerfMetric>& m) override {}
+	void getMetrics(std::vector<PerfMetric>& m) override {
+		if (!enabled)
+			return;
+		int64_t bytesMoved = 0;
+		for (const auto& [_, server] : sharedMgs->allServers) {
+			bytesMoved += server->fetchedBytes;
+		}
+		m.emplace_back("Bytes Moved", bytesMoved, Averaged::False);
+		m.emplace_back("Shards", sharedMgs->shardMapping->getNumberOfShards(), Averaged::False);
+		m.emplace_back("Peak Load Ratio", peakLoadRatio, Averaged::False);
+		m.emplace_back("Final Load Ratio", lastLoadRatio, Averaged::False);
+		m.emplace_back("Convergence Time (s)", convergenceTime, Averaged::False);
+	}
 };
 
 WorkloadFactory<MockDDReadWriteWorkload> MockDDReadWriteWorkload;
\ No newline at end of file
@@ -0,0 +1,149 @@
+/*
+ * RYWPrefetch.actor.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2025 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "fdbclient/NativeAPI.actor.h"
+#include "fdbclient/ReadYourWrites.h"
+#include "fdbserver/TesterInterface.actor.h"
+#include "fdbserver/workloads/workloads.actor.h"
+#include "flow/actorcompiler.h" // This must be the last #include.
+
+// Checks that ReadYourWritesTransaction::prefetch() answers later reads within the prefetched part of its ranges from
+// the cache, and that only those later reads, not the prefetch itself, add read conflict ranges.
+struct RYWPrefetchWorkload : TestWorkload {
+	static constexpr auto NAME = "RYWPrefetch";
+
+	int nodes;
+	double testDuration;
+	PerfIntCounter prefetches, cachedReads, conflicts;
+
+	RYWPrefetchWorkload(WorkloadContext const& wcx)
+	  : TestWorkload(wcx), prefetches("Prefetches"), cachedReads("CachedReads"), conflicts("Conflicts") {
+		testDuration = getOption(options, "testDuration"_sr, 30.0);
+		nodes = getOption(options, "nodes"_sr, 100);
+	}
+
+	Future<Void> setup(Database const& cx) override {
+		if (clientId == 0)
+			return _setup(cx, this);
+		return Void();
+	}
+
+	Future<Void> start(Database const& cx) override {
+		if (clientId == 0)
+			return timeout(_start(cx, this), testDuration, Void());
+		return Void();
+	}
+
+	Future<bool> check(Database const& cx) override { return true; }
+
+	void getMetrics(std::vector<PerfMetric>& m) override {
+		m.push_back(prefetches.getMetric());
+		m.push_back(cachedReads.getMetric());
+		m.push_back(conflicts.getMetric());
+	}
+
+	Key keyForIndex(int index) const { return StringRef(format("rywPrefetch/%06d", index)); }
+
+	// Written by the prefetching transactions, outside of every prefetched range
+	static Key writtenKey() { return "rywPrefetchWritten"_sr; }
+
+	ACTOR static Future<Void> _setup(Database cx, RYWPrefetchWorkload* self) {
+		state Transaction tr(cx);
+		loop {
+			try {
+				for (int i = 0; i < self->nodes; i++) {
+					tr.set(self->keyForIndex(i), StringRef(format("%d", i)));
+				}
+				wait(tr.commit());
+				return Void();
+			} catch (Error& e) {
+				wait(tr.onError(e));
+			}
+		}
+	}
+
+	// Changes a key so that a transaction which read it, with a conflict range, fails to commit
+	ACTOR static Future<Void> writeKey(Database cx, Key key) {
+		state Transaction tr(cx);
+		loop {
+			try {
+				tr.set(key, deterministicRandom()->randomAlphaNumeric(8));
+				wait(tr.commit());
+				return Void();
+			} catch (Error& e) {
+				wait(tr.onError(e));
+			}
+		}
+	}
+
+	ACTOR static Future<Void> _start(Database cx, RYWPrefetchWorkload* self) {
+		loop {
+			state ReadYourWritesTransaction tr(cx);
+			loop {
+				try {
+					// Every key exists, so exactly the first rows keys of each range are prefetched
+					state int rows = deterministicRandom()->randomInt(1, self->nodes + 1);
+					state Standalone<VectorRef<KeyRangeRef>> ranges;
+					state std::vector<int> cached;
+					int rangeCount = deterministicRandom()->randomInt(1, 4);
+					for (int i = 0; i < rangeCount; i++) {
+						int a = deterministicRandom()->randomInt(0, self->nodes);
+						int b = deterministicRandom()->randomInt(a + 1, self->nodes + 1);
+						ranges.push_back_deep(ranges.arena(),
+						                      KeyRangeRef(self->keyForIndex(a), self->keyForIndex(b)));
+						for (int j = a; j < std::min(b, a + rows); j++) {
+							cached.push_back(j);
+						}
+					}
+					wait(tr.prefetch(ranges, GetRangeLimits(rows)));
+					++self->prefetches;
+
+					state bool readCached = deterministicRandom()->coinflip();
+					if (readCached) {
+						for (int i : cached) {
+							Future<Optional<Value>> value = tr.get(self->keyForIndex(i));
+							ASSERT(value.isReady() && value.get().present());
+							++self->cachedReads;
+						}
+					}
+
+					// Only reads served from the cache conflict with the write, the prefetch by itself does not
+					wait(writeKey(cx, self->keyForIndex(cached.front())));
+					tr.set(writtenKey(), StringRef());
+					try {
+						wait(tr.commit());
+						ASSERT(!readCached);
+					} catch (Error& e) {
+						if (e.code() != error_code_not_committed) {
+							throw;
+						}
+						ASSERT(readCached);
+						++self->conflicts;
+					}
+					break;
+				} catch (Error& e) {
+					wait(tr.onError(e));
+				}
+			}
+		}
+	}
+};
+
+WorkloadFactory<RYWPrefetchWorkload> RYWPrefetchWorkloadFactory;
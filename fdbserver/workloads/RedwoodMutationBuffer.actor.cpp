@@ -0,0 +1,142 @@
+/*
+ * RedwoodMutationBuffer.actor.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2024 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "fdbclient/IKnobCollection.h"
+#include "fdbserver/IKeyValueStore.h"
+#include "fdbserver/Knobs.h"
+#include "fdbserver/ServerDBInfo.actor.h"
+#include "fdbserver/workloads/workloads.actor.h"
+#include "flow/DeterministicRandom.h"
+#include "flow/Platform.h"
+#include "flow/actorcompiler.h" // This must be the last #include.
+
+// Applies the same stream of sets and range clears to a local Redwood store once with each mutation buffer
+// implementation and reports the thread CPU time spent per mutation, covering both buffering the mutations and
+// committing them.
+struct RedwoodMutationBufferWorkload : TestWorkload {
+	static constexpr auto NAME = "RedwoodMutationBuffer";
+
+	bool enabled;
+	int commits, mutationsPerCommit, nodeCount, keyBytes, valueBytes;
+	double clearFraction;
+	std::string filename;
+	std::vector<PerfMetric> results;
+
+	RedwoodMutationBufferWorkload(WorkloadContext const& wcx) : TestWorkload(wcx) {
+		enabled = !clientId; // only do this on the "first" client
+		commits = getOption(options, "commits"_sr, 100);
+		mutationsPerCommit = getOption(options, "mutationsPerCommit"_sr, 10000);
+		nodeCount = getOption(options, "nodeCount"_sr, 1000000);
+		keyBytes = std::max(getOption(options, "keyBytes"_sr, 16), 8);
+		valueBytes = getOption(options, "valueBytes"_sr, 96);
+		clearFraction = getOption(options, "clearFraction"_sr, 0.01);
+		filename = getOption(options, "filename"_sr, "redwood-mutation-buffer"_sr).toString();
+	}
+
+	Future<Void> setup(Database const& cx) override { return Void(); }
+
+	Future<Void> start(Database const& cx) override {
+		if (enabled) {
+			return _start(this);
+		}
+		return Void();
+	}
+
+	Future<bool> check(Database const& cx) override { return true; }
+
+	void getMetrics(std::vector<PerfMetric>& m) override { m.insert(m.end(), results.begin(), results.end()); }
+
+	Key makeKey(int i) const {
+		std::string k = format("%08d", i);
+		k.resize(keyBytes, '.');
+		return Key(k);
+	}
+
+	static void setArtMutationBuffer(bool art) {
+		IKnobCollection::getMutableGlobalKnobCollection().setKnob("redwood_art_mutation_buffer",
+		                                                          KnobValueRef::create(bool{ art }));
+	}
+
+	ACTOR static Future<Void> measure(RedwoodMutationBufferWorkload* self, bool art, uint32_t seed) {
+		state std::string name = art ? "ART" : "std::map";
+		state std::string fn = self->filename + (art ? ".art" : ".map");
+		state DeterministicRandom random(seed);
+		state IKeyValueStore* store = nullptr;
+		state int64_t mutations = 0;
+		state double cpu = 0;
+		state double start = 0;
+		state int c = 0;
+
+		deleteFile(fn);
+		// The buffer implementation is chosen when the tree is constructed
+		setArtMutationBuffer(art);
+		store = keyValueStoreRedwoodV1(fn, deterministicRandom()->randomUniqueID());
+		wait(store->init());
+
+		state Value value = Value(std::string(self->valueBytes, 'v'));
+		for (c = 0; c < self->commits; ++c) {
+			start = getProcessorTimeThread();
+			for (int i = 0; i < self->mutationsPerCommit; ++i) {
+				int k = random.randomInt(0, self->nodeCount);
+				if (random.random01() < self->clearFraction) {
+					store->clear(KeyRangeRef(self->makeKey(k), self->makeKey(k + random.randomInt(1, 100))));
+				} else {
+					store->set(KeyValueRef(self->makeKey(k), value));
+				}
+			}
+			mutations += self->mutationsPerCommit;
+			cpu += getProcessorTimeThread() - start;
+
+			// Other actors may run while the commit waits on IO, but commit CPU is dominated by merging the buffer
+			start = getProcessorTimeThread();
+			wait(store->commit());
+			cpu += getProcessorTimeThread() - start;
+		}
+
+		TraceEvent("RedwoodMutationBufferResult")
+		    .detail("Buffer", name)
+		    .detail("Mutations", mutations)
+		    .detail("CPUSeconds", cpu)
+		    .detail("CPUMicrosPerMutation", 1e6 * cpu / mutations);
+		self->results.emplace_back(name + " Mutations", mutations, Averaged::False);
+		self->results.emplace_back(name + " Commit CPU per mutation (us)", 1e6 * cpu / mutations, Averaged::True);
+
+		state Future<Void> closed = store->onClosed();
+		store->dispose();
+		wait(closed);
+		return Void();
+	}
+
+	ACTOR static Future<Void> _start(RedwoodMutationBufferWorkload* self) {
+		state bool original = SERVER_KNOBS->REDWOOD_ART_MUTATION_BUFFER;
+		state uint32_t seed = deterministicRandom()->randomUInt32();
+		try {
+			wait(measure(self, true, seed));
+			wait(measure(self, false, seed));
+		} catch (Error& e) {
+			setArtMutationBuffer(original);
+			throw;
+		}
+		setArtMutationBuffer(original);
+		return Void();
+	}
+};
+
+WorkloadFactory<RedwoodMutationBufferWorkload> RedwoodMutationBufferWorkloadFactory;
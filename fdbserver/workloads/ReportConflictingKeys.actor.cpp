@@ -127,6 +127,33 @@ struct ReportConflictingKeysWorkload : TestWorkload {
 		} while (deterministicRandom()->random01() < addWriteConflictRangeProb);
 	}
 
+	// Whether every key of kr is in a read conflict range which intersects one of the write conflict ranges
+	static bool coveredByConflictingReads(KeyRangeRef kr,
+	                                      std::vector<KeyRange> const& readConflictRanges,
+	                                      std::vector<KeyRange> const& writeConflictRanges) {
+		std::vector<KeyRange> conflictingReads;
+		for (const KeyRange& rCR : readConflictRanges) {
+			if (std::any_of(writeConflictRanges.begin(), writeConflictRanges.end(), [&rCR](KeyRange wCR) {
+				    return wCR.intersects(rCR);
+			    })) {
+				conflictingReads.push_back(rCR);
+			}
+		}
+		std::sort(conflictingReads.begin(), conflictingReads.end(), [](KeyRange const& a, KeyRange const& b) {
+			return a.begin < b.begin;
+		});
+		Key covered = kr.begin;
+		for (const KeyRange& rCR : conflictingReads) {
+			if (covered >= kr.end || rCR.begin > covered) {
+				break;
+			}
+			if (rCR.end > covered) {
+				covered = rCR.end;
+			}
+		}
+		return covered >= kr.end;
+	}
+
 	void emptyConflictingKeysTest(const Reference<ReadYourWritesTransaction>& ryw) {
 		// This test is called when you want to make sure there is no conflictingKeys,
 		// which means you will get an empty result form getRange(\xff\xff/transaction/conflicting_keys/,
@@ -142,6 +169,7 @@ struct ReportConflictingKeysWorkload : TestWorkload {
 		state Reference<ReadYourWritesTransaction> tr2(new ReadYourWritesTransaction(cx));
 		state std::vector<KeyRange> readConflictRanges;
 		state std::vector<KeyRange> writeConflictRanges;
+		state bool tr2RywDisabled = false;
 
 		loop {
 			try {
@@ -155,7 +183,8 @@ struct ReportConflictingKeysWorkload : TestWorkload {
 				// where overlapped conflict ranges are not merged.
 				if (deterministicRandom()->coinflip())
 					tr1->setOption(FDBTransactionOptions::READ_YOUR_WRITES_DISABLE);
-				if (deterministicRandom()->coinflip())
+				tr2RywDisabled = deterministicRandom()->coinflip();
+				if (tr2RywDisabled)
 					tr2->setOption(FDBTransactionOptions::READ_YOUR_WRITES_DISABLE);
 				// We have the two tx with same grv, then commit the first
 				// If the second one is not able to commit due to conflicts, verify the returned conflicting keys
@@ -255,6 +284,14 @@ struct ReportConflictingKeysWorkload : TestWorkload {
 							    .detail("Reason", "Returned keyrange is not conflicting with any writeConflictRange")
 							    .detail("ConflictingKeyRange", kr.toString())
 							    .detail("WriteConflictRanges", allWriteConflictRanges);
+						} else if (tr2RywDisabled &&
+						           !coveredByConflictingReads(kr, readConflictRanges, writeConflictRanges)) {
+							// A native transaction sends its read conflict ranges as they were added, so the reported
+							// keys must all be in ranges which conflicted, even if other ranges overlap them
+							++self->invalidReports;
+							TraceEvent(SevError, "TestFailure")
+							    .detail("Reason", "Returned keyrange is not covered by conflicting readConflictRanges")
+							    .detail("ConflictingKeyRange", kr.toString());
 						}
 					}
 				} else {
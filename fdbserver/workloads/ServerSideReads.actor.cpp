@@ -0,0 +1,375 @@
+/*
+ * ServerSideReads.actor.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2024 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "fdbclient/NativeAPI.actor.h"
+#include "fdbclient/StorageServerInterface.h"
+#include "fdbclient/Tuple.h"
+#include "fdbrpc/LoadBalance.actor.h"
+#include "fdbserver/TesterInterface.actor.h"
+#include "fdbserver/workloads/workloads.actor.h"
+#include "flow/actorcompiler.h" // This must be the last #include.
+
+// Checks reads which the storage servers evaluate on behalf of the client against the same reads evaluated by the
+// client on plain range reads.  Keys are tuples ("serverSideReads", i / 10, i % 10).
+struct ServerSideReadsWorkload : TestWorkload {
+	static constexpr auto NAME = "ServerSideReads";
+	int nodeCount;
+	double testDuration;
+	bool failed = false;
+	PerfIntCounter filteredReads, aggregateReads, staleReads;
+
+	ServerSideReadsWorkload(WorkloadContext const& wcx)
+	  : TestWorkload(wcx), filteredReads("FilteredReads"), aggregateReads("AggregateReads"), staleReads("StaleReads") {
+		nodeCount = getOption(options, "nodeCount"_sr, 1000);
+		testDuration = getOption(options, "testDuration"_sr, 60.0);
+	}
+
+	static Key keyForIndex(int i) { return Tuple::makeTuple("serverSideReads"_sr, i / 10, i % 10).pack(); }
+
+	static KeyRange allKeys() { return prefixRange(Tuple::makeTuple("serverSideReads"_sr).pack()); }
+
+	// Holds the version of the latest commit of stampWriter(), outside of allKeys()
+	static Key stampKey() { return Tuple::makeTuple("serverSideReadsStamp"_sr).pack(); }
+
+	Future<Void> setup(Database const& cx) override {
+		if (clientId != 0) {
+			return Void();
+		}
+		return _setup(cx, this);
+	}
+
+	Future<Void> start(Database const& cx) override {
+		std::vector<Future<Void>> clients;
+		clients.push_back(filterClient(cx, this));
+		clients.push_back(aggregateClient(cx, this));
+		clients.push_back(staleClient(cx, this));
+		if (clientId == 0) {
+			clients.push_back(stampWriter(cx));
+		}
+		return timeout(reportErrors(waitForAll(clients), "ServerSideReadsError"), testDuration, Void());
+	}
+
+	Future<bool> check(Database const& cx) override { return !failed; }
+
+	void getMetrics(std::vector<PerfMetric>& m) override {
+		m.push_back(filteredReads.getMetric());
+		m.push_back(aggregateReads.getMetric());
+		m.push_back(staleReads.getMetric());
+	}
+
+	ACTOR static Future<Void> _setup(Database cx, ServerSideReadsWorkload* self) {
+		state int i = 0;
+		while (i < self->nodeCount) {
+			state Transaction tr(cx);
+			loop {
+				try {
+					for (int j = i; j < std::min(i + 100, self->nodeCount); j++) {
+						// Values start with one of a few letters and vary in length, for prefix and length filters
+						std::string value(1, 'a' + j % 3);
+						value += deterministicRandom()->randomAlphaNumeric(deterministicRandom()->randomInt(0, 100));
+						tr.set(keyForIndex(j), value);
+					}
+					wait(tr.commit());
+					break;
+				} catch (Error& e) {
+					wait(tr.onError(e));
+				}
+			}
+			i += 100;
+		}
+		return Void();
+	}
+
+	// Returns a random range of the workload's keys
+	static KeyRange randomRange(ServerSideReadsWorkload* self) {
+		int a = deterministicRandom()->randomInt(0, self->nodeCount + 1);
+		int b = deterministicRandom()->randomInt(0, self->nodeCount + 1);
+		Key begin = a == 0 ? allKeys().begin : keyForIndex(std::min(a, b));
+		Key end = b == self->nodeCount ? allKeys().end : keyForIndex(std::max(a, b));
+		return KeyRangeRef(begin, std::max(begin, end));
+	}
+
+	static Standalone<ReadFilterRef> randomFilter() {
+		Standalone<ReadFilterRef> filter;
+		Arena& arena = filter.arena();
+		int predicates = deterministicRandom()->randomInt(0, 3);
+		for (int i = 0; i < predicates; i++) {
+			// Index 3 is past the end of every key, so it never matches
+			int index = deterministicRandom()->randomInt(1, 4);
+			auto op = (KeyTuplePredicateRef::Op)deterministicRandom()->randomInt(0, 6);
+			Key element = Tuple::makeTuple(deterministicRandom()->randomInt(0, 10)).pack();
+			filter.keyTuple.push_back(arena, KeyTuplePredicateRef(arena, index, op, element));
+		}
+		if (deterministicRandom()->random01() < 0.2) {
+			filter.keyPrefix =
+			    KeyRef(arena, Tuple::makeTuple("serverSideReads"_sr, deterministicRandom()->randomInt(0, 100)).pack());
+		}
+		if (deterministicRandom()->random01() < 0.3) {
+			std::string valuePrefix(1, 'a' + deterministicRandom()->randomInt(0, 3));
+			filter.valuePrefix = ValueRef(arena, StringRef(valuePrefix));
+		}
+		if (deterministicRandom()->random01() < 0.3) {
+			filter.minValueBytes = deterministicRandom()->randomInt(0, 50);
+			filter.maxValueBytes = filter.minValueBytes + deterministicRandom()->randomInt(0, 60);
+		}
+		filter.keysOnly = deterministicRandom()->coinflip();
+		return filter;
+	}
+
+	// Reads range at version with filter, one shard at a time, following each reply's continuation
+	ACTOR static Future<RangeResult> readFiltered(Database cx,
+	                                              KeyRange range,
+	                                              Version version,
+	                                              Standalone<ReadFilterRef> filter) {
+		state RangeResult result;
+		state Key begin = range.begin;
+		while (begin < range.end) {
+			state KeyRangeLocationInfo location = wait(getKeyLocation_internal(
+			    cx, begin, SpanContext(), Optional<UID>(), UseProvisionalProxies::False, Reverse::False, version));
+			state Key end = location.range.end < range.end ? Key(location.range.end) : Key(range.end);
+			state GetKeyValuesRequest req;
+			req.arena.dependsOn(begin.arena());
+			req.arena.dependsOn(end.arena());
+			req.begin = firstGreaterOrEqual(begin);
+			req.end = firstGreaterOrEqual(end);
+			req.limit = deterministicRandom()->randomInt(1, 100);
+			req.limitBytes = CLIENT_KNOBS->REPLY_BYTE_LIMIT;
+			req.version = version;
+			req.filter = ReadFilterRef(req.arena, filter);
+			try {
+				GetKeyValuesReply rep =
+				    wait(loadBalance(location.locations->locations(), &StorageServerInterface::getKeyValues, req));
+				result.append_deep(result.arena(), rep.data.begin(), rep.data.size());
+				if (!rep.more) {
+					begin = end;
+				} else if (rep.scanEnd.present()) {
+					begin = Key(rep.scanEnd.get());
+				} else {
+					ASSERT(!rep.data.empty());
+					begin = keyAfter(rep.data.back().key);
+				}
+			} catch (Error& e) {
+				if (e.code() != error_code_wrong_shard_server && e.code() != error_code_all_alternatives_failed) {
+					throw;
+				}
+				cx->invalidateCache(begin);
+				wait(delay(CLIENT_KNOBS->WRONG_SHARD_SERVER_DELAY));
+			}
+		}
+		return result;
+	}
+
+	ACTOR static Future<Void> filterClient(Database cx, ServerSideReadsWorkload* self) {
+		state Transaction tr(cx);
+		loop {
+			state KeyRange range = randomRange(self);
+			state Standalone<ReadFilterRef> filter = randomFilter();
+			loop {
+				try {
+					state Version version = wait(tr.getReadVersion());
+					state RangeResult all = wait(tr.getRange(range, CLIENT_KNOBS->TOO_MANY));
+					ASSERT(!all.more);
+					RangeResult filtered = wait(readFiltered(cx, range, version, filter));
+
+					RangeResult expected;
+					expected.arena().dependsOn(all.arena());
+					for (const KeyValueRef& kv : all) {
+						if (filter.matches(kv)) {
+							ValueRef value = filter.keysOnly ? ValueRef() : kv.value;
+							expected.push_back(expected.arena(), KeyValueRef(kv.key, value));
+						}
+					}
+					if (filtered.size() != expected.size() ||
+					    !std::equal(filtered.begin(), filtered.end(), expected.begin())) {
+						TraceEvent(SevError, "ServerSideReadsFilterMismatch")
+						    .detail("Begin", range.begin)
+						    .detail("End", range.end)
+						    .detail("Version", version)
+						    .detail("Expected", expected.size())
+						    .detail("Returned", filtered.size());
+						self->failed = true;
+					}
+					++self->filteredReads;
+					break;
+				} catch (Error& e) {
+					wait(tr.onError(e));
+				}
+			}
+			tr.reset();
+			wait(delay(deterministicRandom()->random01() * 0.1));
+		}
+	}
+
+	// Compares Transaction::getRangeAggregate, which may span several shards and replies, with the same aggregate
+	// computed over a plain range read in the same transaction
+	ACTOR static Future<Void> aggregateClient(Database cx, ServerSideReadsWorkload* self) {
+		state Transaction tr(cx);
+		loop {
+			state KeyRange range = randomRange(self);
+			loop {
+				try {
+					state Future<RangeAggregate> aggregate =
+					    tr.getRangeAggregate(range, Snapshot(deterministicRandom()->coinflip()));
+					state RangeResult all = wait(tr.getRange(range, CLIENT_KNOBS->TOO_MANY));
+					ASSERT(!all.more);
+					RangeAggregate returned = wait(aggregate);
+
+					RangeAggregate expected;
+					for (const KeyValueRef& kv : all) {
+						expected.add(kv);
+					}
+					if (!(returned == expected)) {
+						TraceEvent(SevError, "ServerSideReadsAggregateMismatch")
+						    .detail("Begin", range.begin)
+						    .detail("End", range.end)
+						    .detail("ExpectedCount", expected.count)
+						    .detail("ReturnedCount", returned.count)
+						    .detail("ExpectedSum", expected.sum)
+						    .detail("ReturnedSum", returned.sum)
+						    .detail("ExpectedBytes", expected.bytes)
+						    .detail("ReturnedBytes", returned.bytes);
+						self->failed = true;
+					}
+					++self->aggregateReads;
+					break;
+				} catch (Error& e) {
+					wait(tr.onError(e));
+				}
+			}
+			tr.reset();
+			wait(delay(deterministicRandom()->random01() * 0.1));
+		}
+	}
+
+	ACTOR static Future<Void> stampWriter(Database cx) {
+		state Transaction tr(cx);
+		loop {
+			try {
+				// A 10 byte versionstamp followed by its offset
+				tr.atomicOp(stampKey(), StringRef(std::string(14, '\0')), MutationRef::SetVersionstampedValue);
+				wait(tr.commit());
+				tr.reset();
+				wait(delay(0.1));
+			} catch (Error& e) {
+				wait(tr.onError(e));
+			}
+		}
+	}
+
+	ACTOR static Future<Version> latestReadVersion(Database cx) {
+		state Transaction tr(cx);
+		loop {
+			try {
+				Version version = wait(tr.getReadVersion());
+				return version;
+			} catch (Error& e) {
+				wait(tr.onError(e));
+			}
+		}
+	}
+
+	ACTOR static Future<RangeResult> readLatest(Database cx, KeyRange range) {
+		state Transaction tr(cx);
+		loop {
+			try {
+				RangeResult result = wait(tr.getRange(range, CLIENT_KNOBS->TOO_MANY));
+				ASSERT(!result.more);
+				return result;
+			} catch (Error& e) {
+				wait(tr.onError(e));
+			}
+		}
+	}
+
+	// Reads with a random read_staleness_budget.  Reads may be served at older versions, but never older than the
+	// budget allows, and the transaction must refuse to commit writes.
+	ACTOR static Future<Void> staleClient(Database cx, ServerSideReadsWorkload* self) {
+		state Transaction tr(cx);
+		state int maxBudgetMs = 5000;
+
+		// Reads must not be served at versions from before setup wrote the workload's keys
+		state Version setupVersion = wait(latestReadVersion(cx));
+		loop {
+			Version version = wait(latestReadVersion(cx));
+			if (version - setupVersion > maxBudgetMs * (CLIENT_KNOBS->CORE_VERSIONSPERSECOND / 1000)) {
+				break;
+			}
+			wait(delay(1.0));
+		}
+
+		loop {
+			state KeyRange range = randomRange(self);
+			state int64_t budgetMs = deterministicRandom()->randomInt(1, maxBudgetMs + 1);
+			loop {
+				try {
+					tr.setOption(FDBTransactionOptions::READ_STALENESS_BUDGET,
+					             StringRef((uint8_t*)&budgetMs, sizeof(int64_t)));
+					state Version readVersion = wait(tr.getReadVersion());
+					state Future<RangeResult> staleRange = tr.getRange(range, CLIENT_KNOBS->TOO_MANY);
+					state Future<Optional<Value>> staleStamp = tr.get(stampKey());
+					wait(success(staleRange) && success(staleStamp));
+					// The workload's keys do not change after setup, so stale reads of them see the latest values
+					RangeResult latest = wait(readLatest(cx, range));
+
+					bool ok = staleRange.get().size() == latest.size() &&
+					          std::equal(latest.begin(), latest.end(), staleRange.get().begin());
+					Optional<Version> staleVersion = tr.getStaleReadVersion();
+					Version oldestAllowed = readVersion - budgetMs * (CLIENT_KNOBS->CORE_VERSIONSPERSECOND / 1000);
+					if (staleVersion.present()) {
+						++self->staleReads;
+						ok = ok && staleVersion.get() < readVersion && staleVersion.get() >= oldestAllowed;
+					}
+					if (staleStamp.get().present()) {
+						ok = ok && bigEndian64(*(const Version*)staleStamp.get().get().begin()) <= readVersion;
+					}
+					if (!ok) {
+						TraceEvent(SevError, "ServerSideReadsStaleReadMismatch")
+						    .detail("Begin", range.begin)
+						    .detail("End", range.end)
+						    .detail("ReadVersion", readVersion)
+						    .detail("StaleReadVersion", staleVersion.orDefault(invalidVersion))
+						    .detail("BudgetMs", budgetMs)
+						    .detail("Expected", latest.size())
+						    .detail("Returned", staleRange.get().size());
+						self->failed = true;
+					}
+
+					tr.clear(Tuple::makeTuple("serverSideReadsUnused"_sr).pack());
+					try {
+						wait(tr.commit());
+						TraceEvent(SevError, "ServerSideReadsStaleCommitSucceeded").detail("BudgetMs", budgetMs);
+						self->failed = true;
+					} catch (Error& e) {
+						if (e.code() != error_code_transaction_read_only) {
+							throw;
+						}
+					}
+					break;
+				} catch (Error& e) {
+					wait(tr.onError(e));
+				}
+			}
+			tr.reset();
+			wait(delay(deterministicRandom()->random01() * 0.1));
+		}
+	}
+};
+
+WorkloadFactory<ServerSideReadsWorkload> ServerSideReadsWorkloadFactory;
@@ -138,6 +138,26 @@ class TransactionCostWorkload : public TestWorkload {
 		}
 	};
 
+	class AtomicOpTest : public ITest {
+	public:
+		explicit AtomicOpTest(int64_t testNumber) : ITest(testNumber) {}
+
+		Future<Void> exec(TransactionCostWorkload const& workload, Reference<ReadYourWritesTransaction> tr) override {
+			tr->atomicOp(workload.getKey(testNumber), getValue(8), MutationRef::AddValue);
+			return Void();
+		}
+
+		// The key and operand together fit in one page, so the read of the current value is charged for one page
+		int64_t expectedFinalCost() const override {
+			int64_t const writeCost =
+			    CLIENT_KNOBS->GLOBAL_TAG_THROTTLING_RW_FUNGIBILITY_RATIO * CLIENT_KNOBS->TAG_THROTTLING_PAGE_SIZE;
+			if (CLIENT_KNOBS->TAG_THROTTLING_CHARGE_ATOMIC_OP_READS) {
+				return writeCost + CLIENT_KNOBS->TAG_THROTTLING_PAGE_SIZE;
+			}
+			return writeCost;
+		}
+	};
+
 	class ClearTest : public ITest {
 	public:
 		explicit ClearTest(int64_t testNumber) : ITest(testNumber) {}
@@ -252,7 +272,7 @@ class TransactionCostWorkload : public TestWorkload {
 	};
 
 	static std::unique_ptr<ITest> createRandomTest(int64_t testNumber) {
-		auto const rand = deterministicRandom()->randomInt(0, 9);
+		auto const rand = deterministicRandom()->randomInt(0, 10);
 		if (rand == 0) {
 			return std::make_unique<ReadEmptyTest>(testNumber);
 		} else if (rand == 1) {
@@ -269,6 +289,8 @@ class TransactionCostWorkload : public TestWorkload {
 			return std::make_unique<ClearTest>(testNumber);
 		} else if (rand == 7) {
 			return std::make_unique<ReadRangeTest>(testNumber);
+		} else if (rand == 8) {
+			return std::make_unique<AtomicOpTest>(testNumber);
 		} else {
 			return std::make_unique<LargeReadRangeTest>(testNumber);
 		}
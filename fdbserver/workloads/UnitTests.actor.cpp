@@ -46,6 +46,7 @@ void forceLinkAtomicTests();
 void forceLinkIdempotencyIdTests();
 void forceLinkActorCollectionTests();
 void forceLinkDDSketchTests();
+void forceLinkAsyncFileReadAheadTests();
 void forceLinkCommitProxyTests();
 void forceLinkWipedStringTests();
 void forceLinkRandomKeyValueUtilsTests();
@@ -122,6 +123,7 @@ struct UnitTestWorkload : TestWorkload {
 		forceLinkIdempotencyIdTests();
 		forceLinkActorCollectionTests();
 		forceLinkDDSketchTests();
+		forceLinkAsyncFileReadAheadTests();
 		forceLinkWipedStringTests();
 		forceLinkRandomKeyValueUtilsTests();
 		forceLinkSimKmsVaultTests();
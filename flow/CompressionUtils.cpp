@@ -27,8 +27,33 @@
 
 #ifdef ZSTD_LIB_SUPPORTED
 #define ZSTD_STATIC_LINKING_ONLY
+#include <zdict.h>
 #include <zstd.h>
 static constexpr int ZSTD_COMPRESSION_LEVEL_1 = 1;
+
+namespace {
+// Creating a context allocates and initializes several hundred KB, which would cost more than compressing a small
+// value, so each thread keeps one of each for all its calls
+ZSTD_CCtx* getCompressionContext() {
+	static thread_local std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> ctx(ZSTD_createCCtx(), ZSTD_freeCCtx);
+	return ctx.get();
+}
+
+ZSTD_DCtx* getDecompressionContext() {
+	static thread_local std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> ctx(ZSTD_createDCtx(), ZSTD_freeDCtx);
+	return ctx.get();
+}
+
+// Returns the size the given zstd frames decompress to, as recorded in their headers. Frames which do not record it
+// or which would decompress to more than maxSize are rejected before anything is allocated for them.
+size_t getDecompressedSize(const StringRef& data, size_t maxSize) {
+	unsigned long long size = ZSTD_findDecompressedSize(data.begin(), data.size());
+	if (size == ZSTD_CONTENTSIZE_UNKNOWN || size == ZSTD_CONTENTSIZE_ERROR || size > maxSize) {
+		throw serialization_failed();
+	}
+	return size;
+}
+} // namespace
 #endif
 
 namespace {
@@ -72,7 +97,7 @@ StringRef CompressionUtils::compress(const CompressionFilter filter, const Strin
 		const char* src = reinterpret_cast<const char*>(data.begin());
 		size_t destSize = ZSTD_compressBound(data.size());
 		std::unique_ptr<uint8_t[]> dest = std::make_unique<uint8_t[]>(destSize);
-		size_t bytes = ZSTD_compress(dest.get(), destSize, src, data.size(), level);
+		size_t bytes = ZSTD_compressCCtx(getCompressionContext(), dest.get(), destSize, src, data.size(), level);
 		if (ZSTD_isError(bytes)) {
 			throw internal_error();
 		}
@@ -82,7 +107,10 @@ StringRef CompressionUtils::compress(const CompressionFilter filter, const Strin
 	throw internal_error(); // We should never get here
 }
 
-StringRef CompressionUtils::decompress(const CompressionFilter filter, const StringRef& data, Arena& arena) {
+StringRef CompressionUtils::decompress(const CompressionFilter filter,
+                                      const StringRef& data,
+                                      Arena& arena,
+                                      size_t maxSize) {
 	checkFilterSupported(filter);
 
 	if (filter == CompressionFilter::NONE) {
@@ -90,10 +118,68 @@ StringRef CompressionUtils::decompress(const CompressionFilter filter, const Str
 	}
 #ifdef ZSTD_LIB_SUPPORTED
 	if (filter == CompressionFilter::ZSTD) {
-		const char* src = reinterpret_cast<const char*>(data.begin());
-		size_t destSize = ZSTD_decompressBound(src, data.size());
+		size_t destSize = getDecompressedSize(data, maxSize);
+		uint8_t* dest = new (arena) uint8_t[destSize];
+		size_t bytes = ZSTD_decompressDCtx(getDecompressionContext(), dest, destSize, data.begin(), data.size());
+		if (ZSTD_isError(bytes)) {
+			throw internal_error();
+		}
+		return StringRef(dest, bytes);
+	}
+#endif
+	throw internal_error(); // We should never get here
+}
+
+Standalone<StringRef> CompressionUtils::trainDictionary(const CompressionFilter filter,
+                                                        const std::vector<StringRef>& samples,
+                                                        int maxSize) {
+	checkFilterSupported(filter);
+
+	if (filter == CompressionFilter::NONE) {
+		return Standalone<StringRef>();
+	}
+#ifdef ZSTD_LIB_SUPPORTED
+	if (filter == CompressionFilter::ZSTD) {
+		std::string sampleBuffer;
+		std::vector<size_t> sampleSizes;
+		sampleSizes.reserve(samples.size());
+		for (const auto& sample : samples) {
+			sampleBuffer.append(reinterpret_cast<const char*>(sample.begin()), sample.size());
+			sampleSizes.push_back(sample.size());
+		}
+		Standalone<StringRef> dictionary = makeString(maxSize);
+		size_t bytes = ZDICT_trainFromBuffer(
+		    mutateString(dictionary), maxSize, sampleBuffer.data(), sampleSizes.data(), sampleSizes.size());
+		if (ZDICT_isError(bytes)) {
+			return Standalone<StringRef>();
+		}
+		return Standalone<StringRef>(dictionary.substr(0, bytes), dictionary.arena());
+	}
+#endif
+	throw internal_error(); // We should never get here
+}
+
+StringRef CompressionUtils::compressWithDictionary(const CompressionFilter filter,
+                                                   const StringRef& data,
+                                                   const StringRef& dictionary,
+                                                   Arena& arena) {
+	checkFilterSupported(filter);
+
+	if (filter == CompressionFilter::NONE) {
+		return StringRef(arena, data);
+	}
+#ifdef ZSTD_LIB_SUPPORTED
+	if (filter == CompressionFilter::ZSTD) {
+		size_t destSize = ZSTD_compressBound(data.size());
 		std::unique_ptr<uint8_t[]> dest = std::make_unique<uint8_t[]>(destSize);
-		size_t bytes = ZSTD_decompress(dest.get(), destSize, src, data.size());
+		size_t bytes = ZSTD_compress_usingDict(getCompressionContext(),
+		                                       dest.get(),
+		                                       destSize,
+		                                       data.begin(),
+		                                       data.size(),
+		                                       dictionary.begin(),
+		                                       dictionary.size(),
+		                                       ZSTD_COMPRESSION_LEVEL_1);
 		if (ZSTD_isError(bytes)) {
 			throw internal_error();
 		}
@@ -103,6 +189,36 @@ StringRef CompressionUtils::decompress(const CompressionFilter filter, const Str
 	throw internal_error(); // We should never get here
 }
 
+StringRef CompressionUtils::decompressWithDictionary(const CompressionFilter filter,
+                                                     const StringRef& data,
+                                                     const StringRef& dictionary,
+                                                     Arena& arena,
+                                                     size_t maxSize) {
+	checkFilterSupported(filter);
+
+	if (filter == CompressionFilter::NONE) {
+		return StringRef(arena, data);
+	}
+#ifdef ZSTD_LIB_SUPPORTED
+	if (filter == CompressionFilter::ZSTD) {
+		size_t destSize = getDecompressedSize(data, maxSize);
+		uint8_t* dest = new (arena) uint8_t[destSize];
+		size_t bytes = ZSTD_decompress_usingDict(getDecompressionContext(),
+		                                         dest,
+		                                         destSize,
+		                                         data.begin(),
+		                                         data.size(),
+		                                         dictionary.begin(),
+		                                         dictionary.size());
+		if (ZSTD_isError(bytes)) {
+			throw internal_error();
+		}
+		return StringRef(dest, bytes);
+	}
+#endif
+	throw internal_error(); // We should never get here
+}
+
 int CompressionUtils::getDefaultCompressionLevel(CompressionFilter filter) {
 	checkFilterSupported(filter);
 
@@ -206,4 +322,67 @@ TEST_CASE("/CompressionUtils/zstdCompression2") {
 
 	return Void();
 }
+
+TEST_CASE("/CompressionUtils/zstdDictionaryCompression") {
+	Arena arena;
+	auto makeValue = [&arena](int i) {
+		return StringRef(arena,
+		                 format("{\"id\":%d,\"name\":\"user%d\",\"email\":\"user%d@example.com\",\"active\":%s}",
+		                        i,
+		                        i * 7,
+		                        i * 7,
+		                        i % 2 ? "true" : "false"));
+	};
+	std::vector<StringRef> samples;
+	for (int i = 0; i < 1000; ++i) {
+		samples.push_back(makeValue(i));
+	}
+	Standalone<StringRef> dictionary = CompressionUtils::trainDictionary(CompressionFilter::ZSTD, samples, 4096);
+	ASSERT_GT(dictionary.size(), 0);
+
+	StringRef uncompressed = makeValue(deterministicRandom()->randomInt(1000, 2000));
+	StringRef compressed =
+	    CompressionUtils::compressWithDictionary(CompressionFilter::ZSTD, uncompressed, dictionary, arena);
+	ASSERT_LT(compressed.size(), CompressionUtils::compress(CompressionFilter::ZSTD, uncompressed, arena).size());
+
+	StringRef verify =
+	    CompressionUtils::decompressWithDictionary(CompressionFilter::ZSTD, compressed, dictionary, arena);
+	ASSERT_EQ(verify.compare(uncompressed), 0);
+	TraceEvent("ZstdDictionaryCompressionDone");
+
+	return Void();
+}
+
+TEST_CASE("/CompressionUtils/zstdDecompressionLimit") {
+	Arena arena;
+	// A few hundred bytes which would decompress to 16MB
+	std::string zeros(16 << 20, '\0');
+	StringRef bomb = CompressionUtils::compress(CompressionFilter::ZSTD, StringRef(zeros), arena);
+	ASSERT_LT(bomb.size(), 4096);
+	ASSERT_EQ(CompressionUtils::decompress(CompressionFilter::ZSTD, bomb, arena, zeros.size()).size(), zeros.size());
+	try {
+		CompressionUtils::decompress(CompressionFilter::ZSTD, bomb, arena, zeros.size() - 1);
+		ASSERT(false);
+	} catch (Error& e) {
+		ASSERT_EQ(e.code(), error_code_serialization_failed);
+	}
+
+	// A frame which does not record its content size is rejected however small it is
+	std::string value(100, 'x');
+	size_t destSize = ZSTD_compressBound(value.size());
+	uint8_t* dest = new (arena) uint8_t[destSize];
+	ZSTD_CCtx* ctx = ZSTD_createCCtx();
+	ZSTD_CCtx_setParameter(ctx, ZSTD_c_contentSizeFlag, 0);
+	size_t bytes = ZSTD_compress2(ctx, dest, destSize, value.data(), value.size());
+	ZSTD_freeCCtx(ctx);
+	ASSERT(!ZSTD_isError(bytes));
+	try {
+		CompressionUtils::decompress(CompressionFilter::ZSTD, StringRef(dest, bytes), arena);
+		ASSERT(false);
+	} catch (Error& e) {
+		ASSERT_EQ(e.code(), error_code_serialization_failed);
+	}
+
+	return Void();
+}
 #endif
@@ -30,6 +30,7 @@
 
 #include <atomic>
 #include <cstdint>
+#include <mutex>
 #include <unordered_map>
 
 #ifdef WIN32
@@ -113,6 +114,7 @@ template <int Size>
 void* FastAllocator<Size>::freelist = nullptr;
 
 std::atomic<int64_t> g_hugeArenaMemory(0);
+thread_local CoroFrameAllocations g_coroFrameAllocations;
 
 double hugeArenaLastLogged = 0;
 std::map<std::string, std::pair<int, int64_t>> hugeArenaTraces;
@@ -568,6 +570,89 @@ FastAllocator<Size>::ThreadData::ThreadData() {
 	count = 0;
 }
 
+std::atomic<int64_t> g_hugePageSlabMemory(0);
+std::atomic<int64_t> g_hugePageSlabUnusedMemory(0);
+
+int64_t getHugePageSlabMemory() {
+	return g_hugePageSlabMemory.load();
+}
+
+int64_t getHugePageSlabUnusedMemory() {
+	return g_hugePageSlabUnusedMemory.load();
+}
+
+#ifdef __linux__
+namespace {
+
+// Carves magazines out of 2MiB slabs which are aligned and advised as transparent huge pages, so that every size
+// class shares the slab rather than each magazine stranding most of a huge page (see issue #909). Magazines are never
+// returned to the OS, so neither are slabs.
+class HugePageSlabs {
+public:
+	static constexpr size_t slabBytes = 2 << 20;
+
+	// Returns bytes (rounded up to a page) from the current slab, mapping a new slab when it has too few left. Returns
+	// nullptr if the request is larger than a slab or the mapping fails, and the caller should fall back to allocate().
+	static void* allocate(size_t bytes) {
+		bytes = (bytes + pageBytes - 1) & ~(pageBytes - 1);
+		if (bytes > slabBytes) {
+			return nullptr;
+		}
+		std::lock_guard<std::mutex> lock(instance().mutex);
+		HugePageSlabs& slabs = instance();
+		if (slabs.remaining < bytes) {
+			uint8_t* slab = mapSlab();
+			if (!slab) {
+				return nullptr;
+			}
+			// The tail of the previous slab is too small to be used and stays counted as unused
+			slabs.next = slab;
+			slabs.remaining = slabBytes;
+			g_hugePageSlabMemory.fetch_add(slabBytes);
+			g_hugePageSlabUnusedMemory.fetch_add(slabBytes);
+		}
+		void* result = slabs.next;
+		slabs.next += bytes;
+		slabs.remaining -= bytes;
+		g_hugePageSlabUnusedMemory.fetch_sub(bytes);
+		return result;
+	}
+
+private:
+	static constexpr size_t pageBytes = 4096;
+
+	std::mutex mutex;
+	uint8_t* next = nullptr;
+	size_t remaining = 0;
+
+	static HugePageSlabs& instance() {
+		static HugePageSlabs slabs;
+		return slabs;
+	}
+
+	// Maps twice the slab size and trims it to a slab aligned to a huge page, which THP needs to back it
+	static uint8_t* mapSlab() {
+		void* mapped = mmap(nullptr, 2 * slabBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (mapped == MAP_FAILED) {
+			return nullptr;
+		}
+		uintptr_t start = uintptr_t(mapped);
+		uintptr_t aligned = (start + slabBytes - 1) & ~uintptr_t(slabBytes - 1);
+		if (aligned > start) {
+			munmap(mapped, aligned - start);
+		}
+		if (aligned + slabBytes < start + 2 * slabBytes) {
+			munmap((void*)(aligned + slabBytes), start + 2 * slabBytes - aligned - slabBytes);
+		}
+		// Advice is best effort; without THP the slab is still usable as ordinary pages
+		madvise((void*)aligned, slabBytes, MADV_HUGEPAGE);
+		return (uint8_t*)aligned;
+	}
+};
+
+} // namespace
+#endif
+
 template <int Size>
 void FastAllocator<Size>::getMagazine() {
 	ThreadData& thr = threadData();
@@ -617,9 +702,8 @@ void FastAllocator<Size>::getMagazine() {
 	ASSERT(block == desiredBlock);
 #endif
 #else
-	// FIXME: We should be able to allocate larger magazine sizes here if we
-	// detect that the underlying system supports hugepages.  Using hugepages
-	// with smaller-than-2MiB magazine sizes strands memory.  See issue #909.
+	// Using hugepages with smaller-than-2MiB magazine sizes strands memory (see issue #909), so when
+	// FAST_ALLOC_HUGE_PAGES is set magazines are carved out of shared 2MiB slabs instead.
 #if !DEBUG_DETERMINISM
 	if (FLOW_KNOBS && g_allocation_tracing_disabled == 0 &&
 	    nondeterministicRandom()->random01() < (magazine_size * Size) / FLOW_KNOBS->FAST_ALLOC_LOGGING_BYTES) {
@@ -632,10 +716,18 @@ void FastAllocator<Size>::getMagazine() {
 	const bool includeGuardPages = false;
 #else
 	const bool includeGuardPages = true;
+#endif
+#ifdef __linux__
+	// Slab magazines are packed together, so they cannot have guard pages of their own
+	if (FLOW_KNOBS && FLOW_KNOBS->FAST_ALLOC_HUGE_PAGES) {
+		block = (void**)HugePageSlabs::allocate(magazine_size * Size);
+	}
 #endif
 	// NOTE: rely on lower level metrics in allocate() (and whatever it calls)
 	// for accounting the allocations it does.
-	block = (void**)::allocate(magazine_size * Size, /*allowLargePages*/ false, includeGuardPages);
+	if (!block) {
+		block = (void**)::allocate(magazine_size * Size, /*allowLargePages*/ false, includeGuardPages);
+	}
 #endif
 
 	// void** block = new void*[ magazine_size * PSize ];
@@ -21,29 +21,32 @@
 #include "flow/IThreadPool.h"
 
 #include <algorithm>
-// The ifndef's allow us to compile with pre-built boost.  Otherwise, we get
-// errors about double-defines.  As of this writing, the automatically downloaded
-// build of boost doesn't define these, but the pre-built version does.  (The old
-// prebuilt version was being silently ignored by cmake, so it's unclear when the
-// compatibility divergence started)
-#ifndef BOOST_SYSTEM_NO_LIB
-#define BOOST_SYSTEM_NO_LIB
-#endif
-#ifndef BOOST_DATE_TIME_NO_LIB
-#define BOOST_DATE_TIME_NO_LIB
-#endif
-#ifndef BOOST_REGEX_NO_LIB
-#define BOOST_REGEX_NO_LIB
-#endif
-#include "boost/asio.hpp"
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 
+// Actions are spread over per-thread lanes, each with its own lock, so that posting and running small actions do not
+// all contend on one queue. A thread runs its own lane in FIFO order and steals the oldest action from another lane
+// when its own is empty, so no action waits behind a busy thread while another is idle.
 class ThreadPool final : public IThreadPool, public ReferenceCounted<ThreadPool> {
+	struct Lane {
+		std::mutex mutex;
+		std::deque<PThreadAction> actions;
+	};
+
+	// Threads beyond this share lanes, which keeps the lanes at fixed addresses while threads are being added
+	static constexpr int maxLanes = 64;
+
 	struct Thread {
 		ThreadPool* pool;
 		IThreadPoolReceiver* userObject;
+		int lane;
 		THREAD_HANDLE handle; // Owned by main thread
 		static thread_local IThreadPoolReceiver* threadUserObject;
-		explicit Thread(ThreadPool* pool, IThreadPoolReceiver* userObject) : pool(pool), userObject(userObject) {}
+		explicit Thread(ThreadPool* pool, IThreadPoolReceiver* userObject, int lane)
+		  : pool(pool), userObject(userObject), lane(lane) {}
 		~Thread() { ASSERT_ABORT(!userObject); }
 
 		void run() {
@@ -51,8 +54,9 @@ class ThreadPool final : public IThreadPool, public ReferenceCounted<ThreadPool>
 			threadUserObject = userObject;
 			try {
 				userObject->init();
-				while (pool->ios.run_one() && (pool->mode == Mode::Run))
-					;
+				while (PThreadAction action = pool->next(lane)) {
+					dispatch(action);
+				}
 			} catch (Error& e) {
 				TraceEvent(SevError, "ThreadPoolError").error(e);
 			}
@@ -67,40 +71,73 @@ class ThreadPool final : public IThreadPool, public ReferenceCounted<ThreadPool>
 	}
 
 	std::vector<Thread*> threads;
-	boost::asio::io_service ios;
-	boost::asio::io_service::work dontstop;
+	std::array<Lane, maxLanes> lanes;
+	std::atomic<int> laneCount;
+	std::atomic<unsigned> nextLane;
+	// Actions posted but not yet taken, and threads waiting for one
+	std::atomic<int64_t> pending;
+	std::mutex sleepMutex;
+	std::condition_variable wake;
+	std::atomic<int> sleeping;
 	enum Mode { Run = 0, Shutdown = 2 };
-	volatile int mode;
+	std::atomic<int> mode;
 	int stackSize;
 	int pri;
 
-	struct ActionWrapper {
-		PThreadAction action;
-		ActionWrapper(PThreadAction action) : action(action) {}
-		// HACK: Boost won't use move constructors, so we just assume the last copy made is the one that will be called
-		// or cancelled
-		ActionWrapper(ActionWrapper const& r) : action(r.action) { const_cast<ActionWrapper&>(r).action = nullptr; }
-		void operator()() {
-			Thread::dispatch(action);
-			action = nullptr;
+	PThreadAction take(int lane) {
+		Lane& l = lanes[lane];
+		std::lock_guard<std::mutex> lock(l.mutex);
+		if (l.actions.empty()) {
+			return nullptr;
 		}
-		~ActionWrapper() {
-			if (action) {
-				action->cancel();
+		PThreadAction action = l.actions.front();
+		l.actions.pop_front();
+		pending.fetch_sub(1);
+		return action;
+	}
+
+	// Returns the next action for a thread on the given lane, waiting for one, or nullptr once the pool is stopped
+	PThreadAction next(int lane) {
+		while (mode.load() == Mode::Run) {
+			if (pending.load() > 0) {
+				int count = std::max(laneCount.load(), 1);
+				for (int i = 0; i < count; i++) {
+					if (PThreadAction action = take((lane + i) % count)) {
+						return action;
+					}
+				}
+			}
+			std::unique_lock<std::mutex> lock(sleepMutex);
+			// Announcing the sleep before checking pending pairs with post(), which adds to pending before checking
+			// for sleepers, so one of the two always sees the other
+			++sleeping;
+			if (pending.load() <= 0 && mode.load() == Mode::Run) {
+				wake.wait(lock);
 			}
+			--sleeping;
 		}
-		ActionWrapper& operator=(ActionWrapper const&) = delete;
-	};
+		return nullptr;
+	}
 
 public:
-	ThreadPool(int stackSize, int pri) : dontstop(ios), mode(Run), stackSize(stackSize), pri(pri) {}
-	~ThreadPool() override {}
+	ThreadPool(int stackSize, int pri)
+	  : laneCount(0), nextLane(0), pending(0), sleeping(0), mode(Run), stackSize(stackSize), pri(pri) {}
+	~ThreadPool() override {
+		for (Lane& lane : lanes) {
+			for (PThreadAction action : lane.actions) {
+				action->cancel();
+			}
+		}
+	}
 	Future<Void> stop(Error const& e = success()) override {
 		if (mode == Shutdown)
 			return Void();
 		ReferenceCounted<ThreadPool>::addref();
-		ios.stop(); // doesn't work?
-		mode = Shutdown;
+		{
+			std::lock_guard<std::mutex> lock(sleepMutex);
+			mode = Shutdown;
+		}
+		wake.notify_all();
 		for (int i = 0; i < threads.size(); i++) {
 			waitThread(threads[i]->handle);
 			delete threads[i];
@@ -129,10 +166,25 @@ public:
 		}
 	}
 	void addThread(IThreadPoolReceiver* userData, const char* name) override {
-		threads.push_back(new Thread(this, userData));
+		int lane = threads.size() % maxLanes;
+		threads.push_back(new Thread(this, userData, lane));
+		laneCount = std::min<int>(threads.size(), maxLanes);
 		threads.back()->handle = g_network->startThread(start, threads.back(), stackSize, name);
 	}
-	void post(PThreadAction action) override { ios.post(ActionWrapper(action)); }
+	void post(PThreadAction action) override {
+		int count = std::max(laneCount.load(), 1);
+		Lane& lane = lanes[nextLane.fetch_add(1) % count];
+		{
+			std::lock_guard<std::mutex> lock(lane.mutex);
+			lane.actions.push_back(action);
+		}
+		pending.fetch_add(1);
+		if (sleeping.load() > 0) {
+			// Taking the lock makes sure a thread which has announced it is sleeping is waiting before it is notified
+			std::lock_guard<std::mutex> lock(sleepMutex);
+			wake.notify_one();
+		}
+	}
 	int priority() const { return pri; }
 };
 
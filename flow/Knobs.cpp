@@ -73,6 +73,7 @@ void FlowKnobs::initialize(Randomize randomize, IsSimulated isSimulated) {
 
 	init( FAST_ALLOC_LOGGING_BYTES,                           10e6 );
 	init( FAST_ALLOC_ALLOW_GUARD_PAGES,                      false );
+	init( FAST_ALLOC_HUGE_PAGES,                             false ); // Linux only; carves magazines out of 2MiB slabs advised as transparent huge pages
 	init( HUGE_ARENA_LOGGING_BYTES,                          100e6 );
 	init( HUGE_ARENA_LOGGING_INTERVAL,                         5.0 );
 	init( ABORT_ON_FAILURE,                                  false );
@@ -139,9 +140,12 @@ void FlowKnobs::initialize(Randomize randomize, IsSimulated isSimulated) {
 	init( TLS_HANDSHAKE_FLOWLOCK_PRIORITY, static_cast<int>(TaskPriority::DefaultYield) );
 	init( NETWORK_TEST_CLIENT_COUNT,                            30 );
 	init( NETWORK_TEST_REPLY_SIZE,                           600e3 );
+	init( NETWORK_TEST_REPLY_SIZE_MAX,                           0 ); // > NETWORK_TEST_REPLY_SIZE -> uniformly random reply sizes
 	init( NETWORK_TEST_REQUEST_COUNT,                            0 ); // 0 -> run forever
 	init( NETWORK_TEST_REQUEST_SIZE,                             1 );
+	init( NETWORK_TEST_REQUEST_SIZE_MAX,                         0 ); // > NETWORK_TEST_REQUEST_SIZE -> uniformly random request sizes
 	init( NETWORK_TEST_SCRIPT_MODE,                          false );
+	init( NETWORK_TEST_STREAMING,                            false );
 
 	//Authorization
 	init( ALLOW_TOKENLESS_TENANT_ACCESS,                     false );
@@ -155,6 +159,7 @@ void FlowKnobs::initialize(Randomize randomize, IsSimulated isSimulated) {
 	//AsyncFileCached
 	init( PAGE_CACHE_4K,                                   2LL<<30 );
 	init( PAGE_CACHE_64K,                                200LL<<20 );
+	init( PAGE_CACHE_SHARED_BUDGET,                          false ); if( randomize && BUGGIFY ) PAGE_CACHE_SHARED_BUDGET = true;
 	init( SIM_PAGE_CACHE_4K,                                   1e8 );
 	init( SIM_PAGE_CACHE_64K,                                  1e7 );
 	init( BUGGIFY_SIM_PAGE_CACHE_4K,                           1e6 );
@@ -186,6 +191,13 @@ void FlowKnobs::initialize(Randomize randomize, IsSimulated isSimulated) {
 
 	init( PAGE_WRITE_CHECKSUM_HISTORY,                           0 ); if( randomize && BUGGIFY ) PAGE_WRITE_CHECKSUM_HISTORY = 10000000;
 	init( DISABLE_POSIX_KERNEL_AIO,                              0 );
+	init( REAP_IO_IN_RUN_LOOP,                               false );
+
+	//AsyncFileIOUring
+	init( USE_IO_URING,                                          0 );
+	init( IO_URING_ENTRIES,                                    256 );
+	init( IO_URING_SQPOLL,                                       0 );
+	init( IO_URING_SQPOLL_IDLE_MS,                            1000 );
 
 	//AsyncFileNonDurable
 	init( NON_DURABLE_MAX_WRITE_DELAY,                         2.0 ); if( randomize && BUGGIFY ) NON_DURABLE_MAX_WRITE_DELAY = 5.0;
@@ -220,11 +232,14 @@ void FlowKnobs::initialize(Randomize randomize, IsSimulated isSimulated) {
 	init( MIN_LOGGED_PRIORITY_BUSY_FRACTION,                  0.05 );
 	init( CERT_FILE_MAX_SIZE,                      5 * 1024 * 1024 );
 	init( READY_QUEUE_RESERVED_SIZE,                          8192 );
+	init( THREAD_READY_QUEUE_CAPACITY,                           0 ); if( randomize && BUGGIFY ) THREAD_READY_QUEUE_CAPACITY = deterministicRandom()->coinflip() ? 4 : 4096;
 	init( TASKS_PER_REACTOR_CHECK,                             100 );
 
 	//Network
 	init( PACKET_LIMIT,                                  100LL<<20 );
 	init( PACKET_WARNING,                                  2LL<<20 );  // 2MB packet warning quietly allows for 1MB system messages
+	init( TRANSPORT_COMPRESSION_THRESHOLD,                       0 ); if( randomize && BUGGIFY ) TRANSPORT_COMPRESSION_THRESHOLD = deterministicRandom()->randomInt(1, 64 * 1024);
+	init( TRANSPORT_COMPRESSION_LEVEL,                           1 );
 	init( TIME_OFFSET_LOGGING_INTERVAL,                       60.0 );
 	init( MAX_PACKET_SEND_BYTES,                        128 * 1024 );
 	init( MIN_PACKET_BUFFER_BYTES,                        4 * 1024 );
@@ -296,7 +311,12 @@ void FlowKnobs::initialize(Randomize randomize, IsSimulated isSimulated) {
 	init( FUTURE_VERSION_MAX_BACKOFF,                          8.0 );
 	init( FUTURE_VERSION_BACKOFF_GROWTH,                       2.0 );
 	init( LOAD_BALANCE_MAX_BAD_OPTIONS,                          1 ); //should be the same as MAX_MACHINES_FALLING_BEHIND
+	init( LOAD_BALANCE_NEAREST_MAX_OUTSTANDING,                0.0 ); if( randomize && BUGGIFY ) LOAD_BALANCE_NEAREST_MAX_OUTSTANDING = deterministicRandom()->randomInt(1, 10); // Also consider farther alternatives when the nearest have this many requests outstanding, 0 for never
 	init( LOAD_BALANCE_PENALTY_IS_BAD,                        true );
+	init( LOAD_BALANCE_TAIL_LATENCY_AWARE,                   false ); if( randomize && BUGGIFY ) LOAD_BALANCE_TAIL_LATENCY_AWARE = true;
+	init( LOAD_BALANCE_TAIL_LATENCY_PERCENTILE,               0.95 );
+	init( LOAD_BALANCE_TAIL_LATENCY_SAMPLES,                   100 ); if( randomize && BUGGIFY ) LOAD_BALANCE_TAIL_LATENCY_SAMPLES = 5;
+	init( LOAD_BALANCE_LATENCY_SKETCH_ACCURACY,               0.05 );
 	init( BASIC_LOAD_BALANCE_UPDATE_RATE,                     10.0 ); //should be longer than the rate we log network metrics
 	init( BASIC_LOAD_BALANCE_MAX_CHANGE,                      0.10 );
 	init( BASIC_LOAD_BALANCE_MAX_PROB,                         2.0 );
@@ -305,6 +325,7 @@ void FlowKnobs::initialize(Randomize randomize, IsSimulated isSimulated) {
 	init( BASIC_LOAD_BALANCE_BUCKETS,                           40 ); //proxies bin recent GRV requests into 40 time bins
 	init( BASIC_LOAD_BALANCE_COMPUTE_PRECISION,              10000 ); //determines how much of the LB usage is holding the CPU usage of the proxy
 	init( LOAD_BALANCE_TSS_TIMEOUT,                            5.0 );
+	init( LOAD_BALANCE_TSS_SAMPLE_RATE,                        1.0 ); if( randomize && BUGGIFY ) LOAD_BALANCE_TSS_SAMPLE_RATE = deterministicRandom()->random01(); // Fraction of requests to a storage server which are duplicated to its TSS pair
 	init( LOAD_BALANCE_TSS_MISMATCH_VERIFY_SS,                true ); if( randomize && BUGGIFY ) LOAD_BALANCE_TSS_MISMATCH_VERIFY_SS = false; // Whether the client should validate the SS teams all agree on TSS mismatch
 	init( LOAD_BALANCE_TSS_MISMATCH_TRACE_FULL,              false ); if( randomize && BUGGIFY ) LOAD_BALANCE_TSS_MISMATCH_TRACE_FULL = true; // If true, saves the full details of the mismatch in a trace event. If false, saves them in the DB and the trace event references the DB row.
 	init( TSS_LARGE_TRACE_SIZE,                              50000 );
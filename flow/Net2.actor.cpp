@@ -262,6 +262,8 @@ public:
 	uint64_t numYields;
 
 	NetworkMetrics::PriorityStats* lastPriorityStats;
+	NetworkMetrics::TaskStats* lastTaskStats;
+	TaskPriority lastTaskStatsPriority;
 
 	struct PromiseTask final : public FastAllocated<PromiseTask> {
 		Promise<Void> promise;
@@ -289,6 +291,15 @@ public:
 	void checkForSlowTask(int64_t tscBegin, int64_t tscEnd, double duration, TaskPriority priority);
 	bool check_yield(TaskPriority taskId, int64_t tscNow);
 	void trackAtPriority(TaskPriority priority, double now);
+	void trackTask(TaskPriority priority, double duration) {
+		// Consecutive tasks usually share a priority, so the map is only consulted when it changes
+		if (lastTaskStats == nullptr || priority != lastTaskStatsPriority) {
+			lastTaskStats = &networkInfo.metrics.taskStats[priority];
+			lastTaskStatsPriority = priority;
+		}
+		lastTaskStats->duration += duration;
+		++lastTaskStats->count;
+	}
 	void stopImmediately() {
 #ifdef ADDRESS_SANITIZER
 		// Do leak check before intentionally leaking a bunch of memory
@@ -1399,7 +1410,7 @@ Net2::Net2(const TLSConfig& tlsConfig, bool useThreadPool, bool useMetrics)
     sslHandshakerThreadsStarted(0), sslPoolHandshakesInProgress(0), tlsConfig(tlsConfig),
     tlsInitializedState(ETLSInitState::NONE), network(this), tscBegin(0), tscEnd(0), taskBegin(0),
     currentTaskID(TaskPriority::DefaultYield), stopped(false), started(false), numYields(0),
-    lastPriorityStats(nullptr) {
+    lastPriorityStats(nullptr), lastTaskStats(nullptr), lastTaskStatsPriority(TaskPriority::Zero) {
 	// Until run() is called, yield() will always yield
 	TraceEvent("Net2Starting").log();
 
@@ -1606,6 +1617,9 @@ void Net2::run() {
 	typedef void (*runCycleFuncPtr)();
 	runCycleFuncPtr runFunc = reinterpret_cast<runCycleFuncPtr>(
 	    reinterpret_cast<flowGlobalType>(g_network->global(INetwork::enRunCycleFunc)));
+	// And to the disk completion poller, called wherever the reactor is polled
+	runCycleFuncPtr ioPollFunc = reinterpret_cast<runCycleFuncPtr>(
+	    reinterpret_cast<flowGlobalType>(g_network->global(INetwork::enIOPollFunc)));
 
 	started.store(true);
 	double nnow = timer_monotonic();
@@ -1648,6 +1662,9 @@ void Net2::run() {
 		taskBegin = timer_monotonic();
 		trackAtPriority(TaskPriority::ASIOReactor, taskBegin);
 		reactor.react();
+		if (ioPollFunc) {
+			ioPollFunc();
+		}
 		tasksSinceReact = 0;
 
 		updateNow();
@@ -1700,11 +1717,15 @@ void Net2::run() {
 					runFunc();
 				}
 				reactor.react();
+				if (ioPollFunc) {
+					ioPollFunc();
+				}
 				tasksSinceReact = 0;
 			}
 
 			double tscNow = timestampCounter();
 			double newTaskBegin = timer_monotonic();
+			trackTask(currentTaskID, newTaskBegin - taskBegin);
 			if (check_yield(TaskPriority::Max, tscNow)) {
 				checkForSlowTask(tscBegin, tscNow, newTaskBegin - taskBegin, currentTaskID);
 				taskBegin = newTaskBegin;
@@ -2386,6 +2407,91 @@ TEST_CASE("flow/Net2/ThreadSafeQueue/Threaded") {
 	return Void();
 }
 
+TEST_CASE("flow/Net2/ThreadSafeRingQueue/Interface") {
+	ThreadSafeRingQueue<int> tq(2);
+	ASSERT(!tq.pop().present());
+	ASSERT(tq.canSleep());
+
+	ASSERT(tq.push(1) == true);
+	ASSERT(!tq.canSleep());
+	ASSERT(tq.push(2) == false);
+	// The ring holds two elements, so these spill over, and 5 must follow them even once the ring has room.
+	ASSERT(tq.push(3) == false);
+	ASSERT(tq.push(4) == false);
+
+	ASSERT(tq.pop().get() == 1);
+	ASSERT(tq.push(5) == false);
+	ASSERT(!tq.canSleep());
+	ASSERT(tq.pop().get() == 2);
+	ASSERT(tq.pop().get() == 3);
+	ASSERT(tq.pop().get() == 4);
+	ASSERT(tq.pop().get() == 5);
+	ASSERT(!tq.pop().present());
+	ASSERT(tq.canSleep());
+	ASSERT(tq.push(6) == true);
+	ASSERT(tq.push(7) == false);
+	ASSERT(tq.pop().get() == 6);
+	ASSERT(tq.pop().get() == 7);
+	return Void();
+}
+
+TEST_CASE("flow/Net2/ThreadSafeRingQueue/Threaded") {
+	// Same as ThreadSafeQueue/Threaded, with a ring small enough that producers regularly overflow it.
+	noUnseed = true; // multi-threading inherently non-deterministic
+
+	ThreadSafeRingQueue<int> queue(deterministicRandom()->randomSkewedUInt32(1, 1024));
+	state std::vector<QueueTestThreadState> perThread = { QueueTestThreadState(0, 1000000),
+		                                                  QueueTestThreadState(1, 100000),
+		                                                  QueueTestThreadState(2, 1000000) };
+	state std::vector<Future<Void>> doneProducing;
+
+	int total = 0;
+	for (int t = 0; t < perThread.size(); ++t) {
+		auto& s = perThread[t];
+		doneProducing.push_back(s.doneProducing.getFuture());
+		total += s.toProduce;
+		s.handle = startThreadF([&queue, &s]() {
+			int nextYield = 0;
+			while (s.produced < s.toProduce) {
+				queue.push(s.nextProduced());
+				if (nextYield-- == 0) {
+					std::this_thread::yield();
+					nextYield = nondeterministicRandom()->randomInt(0, 100);
+				}
+			}
+			s.doneProducing.send(Void());
+		});
+	}
+	int consumed = 0;
+	while (consumed < total) {
+		Optional<int> element = queue.pop();
+		if (element.present()) {
+			int v = element.get();
+			auto& s = perThread[QueueTestThreadState::valueToThreadId(v)];
+			++consumed;
+			ASSERT(v == s.nextConsumed());
+		} else {
+			std::this_thread::yield();
+		}
+		if ((consumed & 3) == 0)
+			queue.canSleep();
+	}
+
+	wait(waitForAll(doneProducing));
+
+	// Make sure we continue on the main thread.
+	Promise<Void> signal;
+	state Future<Void> doneConsuming = signal.getFuture();
+	g_network->onMainThread(std::move(signal), TaskPriority::DefaultOnMainThread);
+	wait(doneConsuming);
+
+	for (int t = 0; t < perThread.size(); ++t) {
+		waitThread(perThread[t].handle);
+		perThread[t].checkDone();
+	}
+	return Void();
+}
+
 TEST_CASE("noSim/flow/Net2/onMainThreadFIFO") {
 	// Verifies that signals processed by onMainThread() are executed in order.
 	noUnseed = true; // multi-threading inherently non-deterministic
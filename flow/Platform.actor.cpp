@@ -2269,6 +2269,22 @@ void renameFile(std::string const& fromPath, std::string const& toPath) {
 	throw io_error();
 }
 
+bool hardLinkFile(std::string const& fromPath, std::string const& toPath) {
+#ifdef _WIN32
+	if (CreateHardLinkA(toPath.c_str(), fromPath.c_str(), nullptr)) {
+		return true;
+	}
+#elif (defined(__linux__) || defined(__APPLE__) || defined(__FreeBSD__))
+	if (!link(fromPath.c_str(), toPath.c_str())) {
+		return true;
+	}
+#else
+#error Port me!
+#endif
+	TraceEvent("HardLinkFileFailed").detail("FromPath", fromPath).detail("ToPath", toPath).GetLastError();
+	return false;
+}
+
 #if defined(__linux__)
 #define FOPEN_CLOEXEC_MODE "e"
 #elif defined(_WIN32)
@@ -98,6 +98,18 @@ std::string capitalizeCgroupKey(const std::string& key) {
 
 	return result;
 }
+
+// Returns the bytes of this process's anonymous memory backed by transparent huge pages, or 0 if unknown
+int64_t getAnonHugePagesBytes() {
+	std::ifstream rollup("/proc/self/smaps_rollup", std::ifstream::in);
+	std::string line;
+	while (std::getline(rollup, line)) {
+		if (line.rfind("AnonHugePages:", 0) == 0) {
+			return std::strtoll(line.c_str() + strlen("AnonHugePages:"), nullptr, 10) * 1024;
+		}
+	}
+	return 0;
+}
 #endif // __linux__
 
 } // anonymous namespace
@@ -118,6 +130,11 @@ SystemStatistics customSystemMonitor(std::string const& eventName, StatisticsSta
 			    .detail("Memory", currentStats.processMemory)
 			    .detail("ResidentMemory", currentStats.processResidentMemory)
 			    .detail("UnusedAllocatedMemory", getTotalUnusedAllocatedMemory())
+			    .detail("HugePageSlabMemory", getHugePageSlabMemory())
+			    .detail("HugePageSlabUnusedMemory", getHugePageSlabUnusedMemory())
+#ifdef __linux__
+			    .detail("AnonHugePagesMemory", getAnonHugePagesBytes())
+#endif
 			    .detail("MbpsSent",
 			            ((netData.bytesSent - statState->networkState.bytesSent) * 8e-6) / currentStats.elapsed)
 			    .detail("MbpsReceived",
@@ -202,6 +219,9 @@ SystemStatistics customSystemMonitor(std::string const& eventName, StatisticsSta
 			    .DETAILALLOCATORMEMUSAGE(8192)
 			    .DETAILALLOCATORMEMUSAGE(16384)
 			    .detail("HugeArenaMemory", g_hugeArenaMemory.load())
+			    .detail("CoroFramesAllocated", g_coroFrameAllocations.frames)
+			    .detail("CoroFrameBytesAllocated", g_coroFrameAllocations.bytes)
+			    .detail("CoroOversizedFramesAllocated", g_coroFrameAllocations.oversized)
 			    .detail("DCID", machineState.dcId)
 			    .detail("ZoneID", machineState.zoneId)
 			    .detail("MachineID", machineState.machineId);
@@ -295,6 +315,15 @@ SystemStatistics customSystemMonitor(std::string const& eventName, StatisticsSta
 				n.detail(format("PriorityBusy%d", itr.first).c_str(), itr.second);
 			}
 
+			for (auto& itr : g_network->networkInfo.metrics.taskStats) {
+				// PriorityCpuX and PriorityTasksX measure the time spent running tasks of priority X, and their number
+				if (itr.second.duration / currentStats.elapsed >= FLOW_KNOBS->MIN_LOGGED_PRIORITY_BUSY_FRACTION) {
+					n.detail(format("PriorityCpu%d", itr.first).c_str(), itr.second.duration);
+					n.detail(format("PriorityTasks%d", itr.first).c_str(), itr.second.count);
+				}
+				itr.second = NetworkMetrics::TaskStats();
+			}
+
 			bool firstTracker = true;
 			for (auto& itr : g_network->networkInfo.metrics.starvationTrackers) {
 				if (itr.active) {
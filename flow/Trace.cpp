@@ -261,7 +261,7 @@ public:
 		struct WriteBuffer final : TypedAction<WriterThread, WriteBuffer> {
 			std::vector<TraceEventFields> events;
 
-			WriteBuffer(std::vector<TraceEventFields> events) : events(events) {}
+			WriteBuffer(std::vector<TraceEventFields> events) : events(std::move(events)) {}
 			double getTimeEstimate() const override { return .001; }
 		};
 		void action(WriteBuffer& a) {
@@ -386,7 +386,8 @@ public:
 		fields.setAnnotated();
 	}
 
-	void writeEvent(TraceEventFields fields, std::string trackLatestKey, bool trackError) {
+	// Takes ownership of the fields, so that an event is not copied on its way to the writer thread
+	void writeEvent(TraceEventFields&& fields, const std::string& trackLatestKey, bool trackError) {
 		MutexHolder hold(mutex);
 
 		annotateEvent(fields);
@@ -403,8 +404,14 @@ public:
 
 		// FIXME: What if we are using way too much memory for buffer?
 		ASSERT(!isOpen() || fields.isAnnotated());
-		eventBuffer.push_back(fields);
+		if (trackError) {
+			latestEventCache.setLatestError(fields);
+		}
+		if (!trackLatestKey.empty()) {
+			latestEventCache.set(trackLatestKey, fields);
+		}
 		bufferLength += fields.sizeBytes();
+		eventBuffer.push_back(std::move(fields));
 
 		if (g_network && g_network->isSimulated()) {
 			// Throw an error if we have queued up a large number of events in simulation. This makes it easier to
@@ -413,7 +420,7 @@ public:
 			// identify where the process is actually stuck.
 			if (bufferLength > 1e8) {
 				fprintf(stderr, "Trace log buffer overflow\n");
-				fprintf(stderr, "Last event: %s\n", fields.toString().c_str());
+				fprintf(stderr, "Last event: %s\n", eventBuffer.back().toString().c_str());
 				// Setting this to 0 avoids a recurse from the assertion trace event and also prevents a situation where
 				// we roll the trace log only to log the single assertion event when using --crash.
 				bufferLength = 0;
@@ -423,13 +430,6 @@ public:
 				failedLineOverflow = 1; // we only want to do this once
 			}
 		}
-
-		if (trackError) {
-			latestEventCache.setLatestError(fields);
-		}
-		if (!trackLatestKey.empty()) {
-			latestEventCache.set(trackLatestKey, fields);
-		}
 	}
 
 	void logMetrics(int severity, const char* name, UID id, uint64_t event_ts) {
@@ -1348,7 +1348,8 @@ void BaseTraceEvent::log() {
 					auto name = fmt::format("TraceEvent::{}", type);
 					ProcessEvents::trigger(StringRef(name), this, success());
 				}
-				g_traceLog.writeEvent(fields, trackingKey, severity > SevWarnAlways);
+				// The fields are not needed once the event is logged
+				g_traceLog.writeEvent(std::move(fields), trackingKey, severity > SevWarnAlways);
 
 				if (g_traceLog.isOpen()) {
 					// Log Metrics
@@ -1511,21 +1512,21 @@ void TraceBatch::dump() {
 		if (g_network->isSimulated()) {
 			attachBatch[i].fields.addField("Machine", machine);
 		}
-		g_traceLog.writeEvent(attachBatch[i].fields, "", false);
+		g_traceLog.writeEvent(std::move(attachBatch[i].fields), "", false);
 	}
 
 	for (int i = 0; i < eventBatch.size(); i++) {
 		if (g_network->isSimulated()) {
 			eventBatch[i].fields.addField("Machine", machine);
 		}
-		g_traceLog.writeEvent(eventBatch[i].fields, "", false);
+		g_traceLog.writeEvent(std::move(eventBatch[i].fields), "", false);
 	}
 
 	for (int i = 0; i < buggifyBatch.size(); i++) {
 		if (g_network->isSimulated()) {
 			buggifyBatch[i].fields.addField("Machine", machine);
 		}
-		g_traceLog.writeEvent(buggifyBatch[i].fields, "", false);
+		g_traceLog.writeEvent(std::move(buggifyBatch[i].fields), "", false);
 	}
 
 	onMainThreadVoid([]() { g_traceLog.flush(); });
@@ -41,46 +41,14 @@ void swapWithThreadLocalGlobal(std::vector<int>& writeToOffsets) {
 	gWriteToOffsetsMemory.swap(writeToOffsets);
 }
 
-VTable generate_vtable(size_t numMembers, const std::vector<unsigned>& sizesAlignments) {
-	if (numMembers == 0) {
-		return VTable{ 4, 4 };
-	}
-	// first is index, second is size
-	std::vector<std::pair<unsigned, unsigned>> indexed;
-	indexed.reserve(numMembers);
-	for (unsigned i = 0; i < numMembers; ++i) {
-		if (sizesAlignments[i] > 0) {
-			indexed.emplace_back(i, sizesAlignments[i]);
-		}
-	}
-	std::stable_sort(indexed.begin(),
-	                 indexed.end(),
-	                 [](const std::pair<unsigned, unsigned>& lhs, const std::pair<unsigned, unsigned>& rhs) {
-		                 return lhs.second > rhs.second;
-	                 });
-	VTable result;
-	result.resize(numMembers + 2);
-	// size of the vtable is
-	// - 2 bytes per member +
-	// - 2 bytes for the size entry +
-	// - 2 bytes for the size of the object
-	result[0] = 2 * numMembers + 4;
-	int offset = 0;
-	for (auto p : indexed) {
-		auto align = sizesAlignments[numMembers + p.first];
-		auto& res = result[p.first + 2];
-		res = offset % align == 0 ? offset : ((offset / align) + 1) * align;
-		offset = res + p.second;
-		res += 4;
-	}
-	result[1] = offset + 4;
-	return result;
-}
-
 } // namespace detail
 
 namespace unit_tests {
 
+static_assert((*detail::get_vtable<uint8_t, uint8_t, int, int64_t, int>())[0] == 14);
+static_assert((*detail::get_vtable<uint8_t, uint8_t, int, int64_t, int>())[1] == 22);
+static_assert(detail::get_vtable<int>() == detail::get_vtable<uint32_t>());
+
 TEST_CASE("flow/FlatBuffers/test") {
 	auto* vtable1 = detail::get_vtable<int>();
 	auto* vtable2 = detail::get_vtable<uint8_t, uint8_t, int, int64_t, int>();
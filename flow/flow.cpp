@@ -519,6 +519,20 @@ TEST_CASE("/flow/FlatBuffers/Standalone") {
 		reader.deserialize(out);
 		ASSERT(in == out);
 	}
+	{
+		// Deserializing from a Standalone copies only what the result needs, so the result does not keep the input
+		// alive, while an ArenaObjectReader shares the input's memory
+		Standalone<StringRef> in(std::string("foobar"));
+		Standalone<StringRef> copy = ObjectWriter::toValue(in, Unversioned());
+		Standalone<StringRef> out = ObjectReader::fromStringRef<Standalone<StringRef>>(copy, Unversioned());
+		ASSERT(in == out);
+		ASSERT(out.end() <= copy.begin() || out.begin() >= copy.end());
+		Standalone<StringRef> shared;
+		ArenaObjectReader reader(copy.arena(), copy, Unversioned());
+		reader.deserialize(shared);
+		ASSERT(in == shared);
+		ASSERT(shared.begin() >= copy.begin() && shared.end() <= copy.end());
+	}
 	return Void();
 }
 
@@ -41,6 +41,9 @@
 #include <string_view>
 #include <string>
 #include <cstring>
+#if defined(__x86_64__) && defined(__SSE2__)
+#include <immintrin.h>
+#endif
 #include <limits>
 #include <optional>
 #include <set>
@@ -840,8 +843,34 @@ inline bool operator>=(const StringRef& lhs, const StringRef& rhs) {
 
 typedef uint64_t Word;
 // Get the number of prefix bytes that are the same between a and b, up to their common length of cl
+// Blocks of 32 (AVX2) or 16 (SSE2, or NEON via sse2neon) bytes are compared with a single vector compare before
+// falling back to word and byte comparisons; no load ever reads past cl bytes of either buffer.
 static inline int commonPrefixLength(uint8_t const* ap, uint8_t const* bp, int cl) {
 	int i = 0;
+#if defined(__x86_64__) && defined(__AVX2__)
+	for (; i + 32 <= cl; i += 32) {
+		__m256i a = _mm256_loadu_si256((const __m256i*)ap);
+		__m256i b = _mm256_loadu_si256((const __m256i*)bp);
+		uint32_t eq = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b));
+		if (eq != 0xFFFFFFFFu) {
+			return i + ctzll(~eq);
+		}
+		ap += 32;
+		bp += 32;
+	}
+#endif
+#if (defined(__x86_64__) && defined(__SSE2__)) || defined(__aarch64__)
+	for (; i + 16 <= cl; i += 16) {
+		__m128i a = _mm_loadu_si128((const __m128i*)ap);
+		__m128i b = _mm_loadu_si128((const __m128i*)bp);
+		uint32_t eq = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(a, b));
+		if (eq != 0xFFFFu) {
+			return i + ctzll(~eq & 0xFFFFu);
+		}
+		ap += 16;
+		bp += 16;
+	}
+#endif
 	const int wordEnd = cl - sizeof(Word) + 1;
 
 	for (; i < wordEnd; i += sizeof(Word)) {
@@ -24,7 +24,9 @@
 
 #include "flow/Arena.h"
 
+#include <limits>
 #include <unordered_set>
+#include <vector>
 
 enum class CompressionFilter {
 	NONE,
@@ -35,7 +37,27 @@ enum class CompressionFilter {
 struct CompressionUtils {
 	static StringRef compress(const CompressionFilter filter, const StringRef& data, Arena& arena);
 	static StringRef compress(const CompressionFilter filter, const StringRef& data, int level, Arena& arena);
-	static StringRef decompress(const CompressionFilter filter, const StringRef& data, Arena& arena);
+	// Throws serialization_failed if the data does not record its decompressed size or that size exceeds maxSize, so
+	// that a small hostile or corrupt input cannot force a huge allocation
+	static StringRef decompress(const CompressionFilter filter,
+	                            const StringRef& data,
+	                            Arena& arena,
+	                            size_t maxSize = std::numeric_limits<int>::max());
+
+	// Values which are small but alike compress well only against a dictionary trained on samples of them. Returns
+	// an empty dictionary if the samples are not enough to train one, which compresses as if there were no dictionary.
+	static Standalone<StringRef> trainDictionary(const CompressionFilter filter,
+	                                             const std::vector<StringRef>& samples,
+	                                             int maxSize);
+	static StringRef compressWithDictionary(const CompressionFilter filter,
+	                                        const StringRef& data,
+	                                        const StringRef& dictionary,
+	                                        Arena& arena);
+	static StringRef decompressWithDictionary(const CompressionFilter filter,
+	                                          const StringRef& data,
+	                                          const StringRef& dictionary,
+	                                          Arena& arena,
+	                                          size_t maxSize = std::numeric_limits<int>::max());
 
 	static int getDefaultCompressionLevel(CompressionFilter filter);
 	static CompressionFilter getRandomFilter();
@@ -181,9 +181,22 @@ private:
 };
 
 extern std::atomic<int64_t> g_hugeArenaMemory;
+
+// Coroutine frames allocated by this thread (see allocateFrame in CoroutinesImpl.h). Every coroutine call allocates a
+// frame, so these are plain thread-local counts rather than atomic SimpleCounters; the network thread's counts are
+// logged in MemoryMetrics.
+struct CoroFrameAllocations {
+	int64_t frames = 0;
+	int64_t bytes = 0;
+	int64_t oversized = 0; // frames too large for any FastAllocator size class
+};
+extern thread_local CoroFrameAllocations g_coroFrameAllocations;
 void hugeArenaSample(int size);
 void releaseAllThreadMagazines();
 int64_t getTotalUnusedAllocatedMemory();
+// Bytes mapped for huge page slabs, and those not yet carved into magazines
+int64_t getHugePageSlabMemory();
+int64_t getHugePageSlabUnusedMemory();
 
 // These are thin wrappers around operator new and operator delete
 // and exist so that we can update metrics inside them.
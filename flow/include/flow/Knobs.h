@@ -131,6 +131,7 @@ public:
 
 	double FAST_ALLOC_LOGGING_BYTES;
 	bool FAST_ALLOC_ALLOW_GUARD_PAGES;
+	bool FAST_ALLOC_HUGE_PAGES;
 	double HUGE_ARENA_LOGGING_BYTES;
 	double HUGE_ARENA_LOGGING_INTERVAL;
 	// This setting allows to let the fdbserver abort instead of exit to generate coredumps
@@ -206,9 +207,12 @@ public:
 
 	int NETWORK_TEST_CLIENT_COUNT;
 	int NETWORK_TEST_REPLY_SIZE;
+	int NETWORK_TEST_REPLY_SIZE_MAX;
 	int NETWORK_TEST_REQUEST_COUNT;
 	int NETWORK_TEST_REQUEST_SIZE;
+	int NETWORK_TEST_REQUEST_SIZE_MAX;
 	bool NETWORK_TEST_SCRIPT_MODE;
+	bool NETWORK_TEST_STREAMING; // The network test client sends streaming requests rather than request/reply pairs
 
 	// Authorization
 	bool ALLOW_TOKENLESS_TENANT_ACCESS;
@@ -222,6 +226,7 @@ public:
 	// AsyncFileCached
 	int64_t PAGE_CACHE_4K;
 	int64_t PAGE_CACHE_64K;
+	bool PAGE_CACHE_SHARED_BUDGET; // 4K file page caches and the Redwood page cache share one PAGE_CACHE_4K budget
 	int64_t SIM_PAGE_CACHE_4K;
 	int64_t SIM_PAGE_CACHE_64K;
 	int64_t BUGGIFY_SIM_PAGE_CACHE_4K;
@@ -252,6 +257,13 @@ public:
 
 	int PAGE_WRITE_CHECKSUM_HISTORY;
 	int DISABLE_POSIX_KERNEL_AIO;
+	bool REAP_IO_IN_RUN_LOOP; // Reap disk completions each time the run loop polls the network
+
+	// AsyncFileIOUring
+	int USE_IO_URING; // Use io_uring instead of kernel AIO for unbuffered files, if the kernel supports it
+	int IO_URING_ENTRIES; // Submission queue depth, and the most requests in flight at once
+	int IO_URING_SQPOLL; // Let a kernel thread poll the submission queue, so submitting needs no system call
+	int IO_URING_SQPOLL_IDLE_MS;
 
 	// AsyncFileNonDurable
 	double NON_DURABLE_MAX_WRITE_DELAY;
@@ -287,11 +299,14 @@ public:
 	double MIN_LOGGED_PRIORITY_BUSY_FRACTION;
 	int CERT_FILE_MAX_SIZE;
 	int READY_QUEUE_RESERVED_SIZE;
+	int THREAD_READY_QUEUE_CAPACITY; // Slots in the ring tasks from other threads are handed over in; 0 uses a linked queue
 	int TASKS_PER_REACTOR_CHECK;
 
 	// Network
 	int64_t PACKET_LIMIT;
 	int64_t PACKET_WARNING; // 2MB packet warning quietly allows for 1MB system messages
+	int TRANSPORT_COMPRESSION_THRESHOLD; // Unreliable packets at least this large are compressed, 0 disables
+	int TRANSPORT_COMPRESSION_LEVEL;
 	double TIME_OFFSET_LOGGING_INTERVAL;
 	int MAX_PACKET_SEND_BYTES;
 	int MIN_PACKET_BUFFER_BYTES;
@@ -364,7 +379,12 @@ public:
 	double FUTURE_VERSION_MAX_BACKOFF;
 	double FUTURE_VERSION_BACKOFF_GROWTH;
 	int LOAD_BALANCE_MAX_BAD_OPTIONS;
+	double LOAD_BALANCE_NEAREST_MAX_OUTSTANDING;
 	bool LOAD_BALANCE_PENALTY_IS_BAD;
+	bool LOAD_BALANCE_TAIL_LATENCY_AWARE; // Choose replicas by predicted tail latency with power of two choices
+	double LOAD_BALANCE_TAIL_LATENCY_PERCENTILE;
+	int LOAD_BALANCE_TAIL_LATENCY_SAMPLES; // Clean latencies per endpoint each tail latency estimate is taken over
+	double LOAD_BALANCE_LATENCY_SKETCH_ACCURACY;
 	double BASIC_LOAD_BALANCE_UPDATE_RATE;
 	double BASIC_LOAD_BALANCE_MAX_CHANGE;
 	double BASIC_LOAD_BALANCE_MAX_PROB;
@@ -373,6 +393,7 @@ public:
 	double BASIC_LOAD_BALANCE_MIN_REQUESTS;
 	double BASIC_LOAD_BALANCE_MIN_CPU;
 	double LOAD_BALANCE_TSS_TIMEOUT;
+	double LOAD_BALANCE_TSS_SAMPLE_RATE;
 	bool LOAD_BALANCE_TSS_MISMATCH_VERIFY_SS;
 	bool LOAD_BALANCE_TSS_MISMATCH_TRACE_FULL;
 	int TSS_LARGE_TRACE_SIZE;
@@ -111,6 +111,8 @@ public:
 		vo.read(*this);
 	}
 
+	// T's StringRefs are copied out of the input, so T does not keep the input's arena alive. Use ArenaObjectReader to
+	// deserialize in place when T should share the input's memory.
 	template <class T, class VersionOptions>
 	static T fromStringRef(StringRef sr, VersionOptions vo) {
 		T t;
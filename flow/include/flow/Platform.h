@@ -351,6 +351,10 @@ bool deleteFile(std::string const& filename);
 // Renames the given file.  Does not fsync the directory.
 void renameFile(std::string const& fromPath, std::string const& toPath);
 
+// Creates toPath as a hard link to fromPath.  Returns false if the link cannot be created, e.g. because the paths are
+// on different file systems.  Does not fsync the directory.
+bool hardLinkFile(std::string const& fromPath, std::string const& toPath);
+
 // Atomically replaces the contents of the specified file.
 void atomicReplace(std::string const& path, std::string const& content, bool textmode = true);
 
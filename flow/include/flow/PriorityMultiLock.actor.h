@@ -30,6 +30,8 @@
 
 #include "flow/flow.h"
 #include <boost/intrusive/list.hpp>
+#include <algorithm>
+#include <unordered_map>
 #include "flow/actorcompiler.h" // This must be the last #include.
 
 #define PRIORITYMULTILOCK_DEBUG 0
@@ -65,6 +67,12 @@
 // For improved memory locality the properties mentioned above are stored as priorities[n].<property>
 // in the actual implementation.
 //
+// Within a priority, waiters may belong to different flows, such as the transaction tags of reads.  Waiters are
+// granted locks in order of their virtual finish time, as in weighted fair queuing, so a flow with many waiters does
+// not starve others at the same priority.  A waiter's finish time is its cost added to the later of the priority's
+// virtual time and the finish time of the previous waiter of its flow.  The virtual time is the finish time of the
+// waiter most recently granted a lock, so waiters of a single flow with equal costs are granted locks in FIFO order.
+//
 // The interface is similar to FlowMutex except that lock holders can just drop the lock to release it.
 //
 // Usage:
@@ -101,7 +109,7 @@ public:
 
 	~PriorityMultiLock() { kill(); }
 
-	Future<Lock> lock(int priority = 0) {
+	Future<Lock> lock(int priority = 0, uint64_t flow = 0, double cost = 1.0) {
 		if (killed)
 			throw broken_promise();
 
@@ -131,11 +139,10 @@ public:
 			waitingPriorities.push_back(p);
 		}
 
-		Waiter& w = q.emplace_back();
 		++waiting;
 
 		pml_debug_printf("lock wait priority %d  %s\n", priority, toString().c_str());
-		return w.lockPromise.getFuture();
+		return q.push(flow, cost);
 	}
 
 	// Halt stops the PML from handing out any new locks but leaves waiters and runners alone.
@@ -205,6 +212,67 @@ public:
 private:
 	struct Waiter {
 		Promise<Lock> lockPromise;
+		uint64_t flow;
+		// Virtual finish time, and the order of arrival to break ties
+		double finish;
+		uint64_t sequence;
+
+		// Orders a heap so that the waiter with the earliest finish time is at the top
+		bool operator<(const Waiter& rhs) const {
+			return finish > rhs.finish || (finish == rhs.finish && sequence > rhs.sequence);
+		}
+	};
+
+	// The waiters at a priority, ordered by virtual finish time
+	class Queue {
+	public:
+		bool empty() const { return waiters.empty(); }
+		int size() const { return waiters.size(); }
+
+		void clear() {
+			waiters.clear();
+			flowFinish.clear();
+			virtualTime = 0;
+		}
+
+		Future<Lock> push(uint64_t flow, double cost) {
+			auto f = flowFinish.find(flow);
+			double start = f == flowFinish.end() ? virtualTime : std::max(virtualTime, f->second);
+			double finish = start + std::max(cost, 0.0);
+			flowFinish[flow] = finish;
+
+			Waiter& w = waiters.emplace_back();
+			w.flow = flow;
+			w.finish = finish;
+			w.sequence = nextSequence++;
+			Future<Lock> lock = w.lockPromise.getFuture();
+			std::push_heap(waiters.begin(), waiters.end());
+			return lock;
+		}
+
+		Waiter pop() {
+			std::pop_heap(waiters.begin(), waiters.end());
+			Waiter w = std::move(waiters.back());
+			waiters.pop_back();
+			virtualTime = w.finish;
+
+			// Forget flows with no more waiters, since their next waiter would start at the virtual time anyway
+			auto f = flowFinish.find(w.flow);
+			if (f != flowFinish.end() && f->second <= w.finish) {
+				flowFinish.erase(f);
+			}
+			if (waiters.empty()) {
+				virtualTime = 0;
+			}
+			return w;
+		}
+
+	private:
+		std::vector<Waiter> waiters;
+		// Finish time of the last waiter queued by each flow which still has waiters
+		std::unordered_map<uint64_t, double> flowFinish;
+		double virtualTime = 0;
+		uint64_t nextSequence = 0;
 	};
 
 	// Total execution slots allowed across all priorities
@@ -216,8 +284,6 @@ private:
 	// Sum of weights for all priorities with 1 or more waiters
 	int totalPendingWeights;
 
-	typedef Deque<Waiter> Queue;
-
 	struct Priority : boost::intrusive::list_base_hook<> {
 		Priority() : runners(0), weight(0), priority(-1) {}
 
@@ -320,8 +386,7 @@ private:
 				}
 
 				Queue& queue = p->queue;
-				Waiter w = queue.front();
-				queue.pop_front();
+				Waiter w = queue.pop();
 
 				// If this priority is now empty, subtract its weight from the total pending weights an remove it
 				// from the waitingPriorities list
@@ -22,8 +22,14 @@
 #define FLOW_TASK_QUEUE_H
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <limits>
 #include <queue>
+#include <unordered_map>
 #include <vector>
+#include "flow/Deque.h"
 #include "flow/TDMetric.actor.h"
 #include "flow/network.h"
 #include "flow/ThreadSafeQueue.h"
@@ -33,7 +39,9 @@ template <typename Task>
 // All functions must be called on the main thread, except for addReadyThreadSafe() which can be called from any thread.
 class TaskQueue {
 public:
-	TaskQueue() : tasksIssued(0), ready(FLOW_KNOBS->READY_QUEUE_RESERVED_SIZE) {}
+	TaskQueue()
+	  : tasksIssued(0), ready(FLOW_KNOBS->READY_QUEUE_RESERVED_SIZE),
+	    threadReady(FLOW_KNOBS->THREAD_READY_QUEUE_CAPACITY) {}
 
 	// Add a task that is ready to be executed.
 	void addReady(TaskPriority taskId, Task* t) { this->ready.push(OrderedTask(getFIFOPriority(taskId), taskId, t)); }
@@ -67,7 +75,7 @@ public:
 	// Returns a time interval a caller should sleep from now until the next timer.
 	double getSleepTime(double now) const {
 		if (!timers.empty()) {
-			return timers.top().at - now;
+			return timers.earliest() - now;
 		}
 		return 0;
 	}
@@ -75,7 +83,8 @@ public:
 	// Moves all timers that are scheduled to be executed at or before now to the ready queue.
 	void processReadyTimers(double now) {
 		[[maybe_unused]] int numTimers = 0;
-		while (!timers.empty() && timers.top().at <= now + INetwork::TIME_EPS) {
+		timers.advanceTo(now + INetwork::TIME_EPS);
+		while (timers.hasDue() && timers.top().at <= now + INetwork::TIME_EPS) {
 			++numTimers;
 			++countTimers;
 			ready.push(timers.top());
@@ -112,10 +121,8 @@ public:
 	}
 
 	void clear() {
-		decltype(ready) _1;
-		ready.swap(_1);
-		decltype(timers) _2;
-		timers.swap(_2);
+		ready.clear();
+		timers.clear();
 	}
 
 private:
@@ -135,12 +142,270 @@ private:
 		bool operator<(DelayedTask const& rhs) const { return at > rhs.at; } // Ordering is reversed for priority_queue
 	};
 
-	template <class T>
-	class ReadyQueue : public std::priority_queue<T, std::vector<T>> {
+	// Ready tasks, highest priority first and in FIFO order within a TaskPriority.  There are only a few dozen distinct
+	// TaskPriority values, so tasks are kept in a FIFO per TaskPriority, and a bitmap of the non-empty ones finds the
+	// highest.  Timers are issued before they become ready, so a timer task would go ahead of tasks already in its FIFO,
+	// and those are kept in a heap instead.
+	class ReadyQueue {
 	public:
-		typedef typename std::priority_queue<T, std::vector<T>>::size_type size_type;
-		ReadyQueue(size_type capacity = 0) { reserve(capacity); };
-		void reserve(size_type capacity) { this->c.reserve(capacity); }
+		explicit ReadyQueue(size_t capacity = 0) { late.reserve(capacity); }
+
+		bool empty() const { return count == 0; }
+		size_t size() const { return count; }
+
+		void push(OrderedTask const& t) {
+			int b = getBucket(t.taskID);
+			Deque<OrderedTask>& bucket = buckets[b];
+			if (!bucket.empty() && bucket.back().priority < t.priority) {
+				late.push_back(t);
+				std::push_heap(late.begin(), late.end());
+			} else {
+				if (bucket.empty()) {
+					nonEmpty[b / 64] |= uint64_t(1) << (b % 64);
+				}
+				bucket.push_back(t);
+			}
+			++count;
+		}
+
+		OrderedTask const& top() const {
+			int b = highestBucket();
+			if (b < 0 || (!late.empty() && buckets[b].front() < late.front())) {
+				return late.front();
+			}
+			return buckets[b].front();
+		}
+
+		void pop() {
+			int b = highestBucket();
+			if (b < 0 || (!late.empty() && buckets[b].front() < late.front())) {
+				std::pop_heap(late.begin(), late.end());
+				late.pop_back();
+			} else {
+				buckets[b].pop_front();
+				if (buckets[b].empty()) {
+					nonEmpty[b / 64] &= ~(uint64_t(1) << (b % 64));
+				}
+			}
+			--count;
+		}
+
+		void clear() {
+			for (auto& bucket : buckets) {
+				bucket.clear();
+			}
+			std::fill(nonEmpty.begin(), nonEmpty.end(), 0);
+			late.clear();
+			count = 0;
+		}
+
+	private:
+		// Returns the index of the FIFO of tasks with the given TaskPriority, adding one in priority order if needed
+		int getBucket(TaskPriority taskID) {
+			auto it = bucketIndex.find(taskID);
+			if (it != bucketIndex.end()) {
+				return it->second;
+			}
+
+			int b = std::upper_bound(priorities.begin(), priorities.end(), taskID) - priorities.begin();
+			priorities.insert(priorities.begin() + b, taskID);
+			buckets.insert(buckets.begin() + b, Deque<OrderedTask>());
+			bucketIndex.clear();
+			nonEmpty.assign((buckets.size() + 63) / 64, 0);
+			for (int i = 0; i < buckets.size(); i++) {
+				bucketIndex[priorities[i]] = i;
+				if (!buckets[i].empty()) {
+					nonEmpty[i / 64] |= uint64_t(1) << (i % 64);
+				}
+			}
+			return b;
+		}
+
+		// Returns the index of the non-empty FIFO with the highest TaskPriority, or -1 if all are empty
+		int highestBucket() const {
+			for (int w = nonEmpty.size() - 1; w >= 0; w--) {
+				if (nonEmpty[w]) {
+					return w * 64 + std::bit_width(nonEmpty[w]) - 1;
+				}
+			}
+			return -1;
+		}
+
+		std::vector<TaskPriority> priorities; // The TaskPriority of each FIFO, in increasing order
+		std::vector<Deque<OrderedTask>> buckets;
+		std::unordered_map<TaskPriority, int> bucketIndex;
+		std::vector<uint64_t> nonEmpty; // Bit i is set iff buckets[i] is not empty
+		std::vector<OrderedTask> late; // A max-heap of tasks which are ahead of the tasks in their FIFO
+		size_t count = 0;
+	};
+
+	// Timers, earliest first.  Most timers are cancelled long before they are due, so rather than keeping all of them in
+	// a heap, timers are hashed by their time into a wheel of 1ms slots covering the next second, and a wheel of
+	// wheel-sized slots covering the next 17 minutes.  Only the timers of the current slot, which are due next, are kept
+	// in a heap, and the slots of the outer wheel are moved into the inner wheel as time reaches them.  Timers further
+	// out are kept in a heap until the outer wheel reaches them.  The earliest timer is always exact, so timers become
+	// ready at the same times, and in simulation the same order, as they did before.
+	class TimerWheel {
+	public:
+		bool empty() const { return count == 0; }
+		size_t size() const { return count; }
+
+		void push(DelayedTask const& t) {
+			++count;
+			insert(t);
+		}
+
+		// Returns the time of the earliest timer, without advancing the wheels.  It is in the heap of due timers, the
+		// next non-empty slot of either wheel, or the overflow heap.
+		double earliest() const {
+			double at = due.empty() ? std::numeric_limits<double>::infinity() : due.top().at;
+			const int64_t innerDistance = nextSlot(innerNonEmpty, currentTick % wheelSize);
+			if (innerDistance < wheelSize) {
+				at = std::min(at, earliestIn(inner[(currentTick + innerDistance) % wheelSize]));
+			}
+			const int64_t outerDistance = nextSlot(outerNonEmpty, (currentTick >> wheelBits) % wheelSize);
+			if (outerDistance < wheelSize) {
+				at = std::min(at, earliestIn(outer[((currentTick >> wheelBits) + outerDistance) % wheelSize]));
+			}
+			if (!overflow.empty()) {
+				at = std::min(at, overflow.top().at);
+			}
+			return at;
+		}
+
+		// Moves every timer due by the given time into the heap of due timers.  The wheels never advance past the
+		// tick of the current time, so timers added later for nearby ticks still go into the wheels.
+		void advanceTo(double now) {
+			const int64_t tick = getTick(now);
+			while (currentTick < tick) {
+				advance(tick);
+			}
+		}
+
+		// The earliest of the timers moved into the due heap by advanceTo()
+		bool hasDue() const { return !due.empty(); }
+		DelayedTask const& top() const { return due.top(); }
+
+		void pop() {
+			due.pop();
+			--count;
+		}
+
+		void clear() {
+			decltype(due) _1;
+			due.swap(_1);
+			decltype(overflow) _2;
+			overflow.swap(_2);
+			for (auto& slot : inner) {
+				slot.clear();
+			}
+			for (auto& slot : outer) {
+				slot.clear();
+			}
+			innerNonEmpty.fill(0);
+			outerNonEmpty.fill(0);
+			count = 0;
+		}
+
+	private:
+		static constexpr int wheelBits = 10;
+		static constexpr int64_t wheelSize = int64_t(1) << wheelBits;
+		static constexpr double tickSeconds = 0.001;
+		static constexpr int64_t maxTick = int64_t(1) << 60;
+
+		static int64_t getTick(double at) { return at < maxTick * tickSeconds ? int64_t(at / tickSeconds) : maxTick; }
+
+		void insert(DelayedTask const& t) {
+			int64_t tick = getTick(t.at);
+			if (tick <= currentTick) {
+				due.push(t);
+			} else if (tick - currentTick < wheelSize) {
+				add(inner, innerNonEmpty, tick % wheelSize, t);
+			} else if ((tick >> wheelBits) - (currentTick >> wheelBits) < wheelSize) {
+				add(outer, outerNonEmpty, (tick >> wheelBits) % wheelSize, t);
+			} else {
+				overflow.push(t);
+			}
+		}
+
+		template <class Slots>
+		static void add(Slots& slots, std::array<uint64_t, wheelSize / 64>& nonEmpty, int slot, DelayedTask const& t) {
+			slots[slot].push_back(t);
+			nonEmpty[slot / 64] |= uint64_t(1) << (slot % 64);
+		}
+
+		// Returns the number of slots after the given one to the next non-empty slot, or wheelSize if all are empty
+		static int64_t nextSlot(std::array<uint64_t, wheelSize / 64> const& nonEmpty, int64_t slot) {
+			for (int64_t i = 1; i < wheelSize;) {
+				int64_t s = (slot + i) % wheelSize;
+				uint64_t bits = nonEmpty[s / 64] >> (s % 64);
+				if (bits) {
+					return std::min(i + std::countr_zero(bits), wheelSize);
+				}
+				i += 64 - (s % 64);
+			}
+			return wheelSize;
+		}
+
+		static double earliestIn(std::vector<DelayedTask> const& timers) {
+			double at = std::numeric_limits<double>::infinity();
+			for (auto const& t : timers) {
+				at = std::min(at, t.at);
+			}
+			return at;
+		}
+
+		// Advances the current tick to the next tick with timers, moving them into the due heap, or to limit if no
+		// timer is due by then
+		void advance(int64_t limit) {
+			const int64_t innerDistance = nextSlot(innerNonEmpty, currentTick % wheelSize);
+			const int64_t outerDistance = nextSlot(outerNonEmpty, (currentTick >> wheelBits) % wheelSize);
+			int64_t tick = overflow.empty() ? maxTick + 1 : getTick(overflow.top().at);
+			if (innerDistance < wheelSize) {
+				tick = std::min(tick, currentTick + innerDistance);
+			}
+			if (outerDistance < wheelSize) {
+				tick = std::min(tick, ((currentTick >> wheelBits) + outerDistance) << wheelBits);
+			}
+			tick = std::min(tick, limit);
+			ASSERT(tick <= maxTick && tick > currentTick);
+
+			const int64_t previousTick = currentTick;
+			currentTick = tick;
+			if (innerDistance < wheelSize && tick == previousTick + innerDistance) {
+				moveSlot(inner, innerNonEmpty, tick % wheelSize);
+			}
+			if ((tick >> wheelBits) != (previousTick >> wheelBits)) {
+				if (outerDistance < wheelSize && (tick >> wheelBits) == (previousTick >> wheelBits) + outerDistance) {
+					moveSlot(outer, outerNonEmpty, (tick >> wheelBits) % wheelSize);
+				}
+				while (!overflow.empty() &&
+				       (getTick(overflow.top().at) >> wheelBits) - (tick >> wheelBits) < wheelSize) {
+					DelayedTask t = overflow.top();
+					overflow.pop();
+					insert(t);
+				}
+			}
+		}
+
+		template <class Slots>
+		void moveSlot(Slots& slots, std::array<uint64_t, wheelSize / 64>& nonEmpty, int slot) {
+			std::vector<DelayedTask> timers;
+			timers.swap(slots[slot]);
+			nonEmpty[slot / 64] &= ~(uint64_t(1) << (slot % 64));
+			for (auto const& t : timers) {
+				insert(t);
+			}
+		}
+
+		int64_t currentTick = 0; // Every timer at or before this tick is in due
+		std::priority_queue<DelayedTask, std::vector<DelayedTask>> due;
+		std::array<std::vector<DelayedTask>, wheelSize> inner; // Timers of each of the ticks after currentTick
+		std::array<std::vector<DelayedTask>, wheelSize> outer; // Timers of each of the inner wheels after this one
+		std::array<uint64_t, wheelSize / 64> innerNonEmpty{};
+		std::array<uint64_t, wheelSize / 64> outerNonEmpty{};
+		std::priority_queue<DelayedTask, std::vector<DelayedTask>> overflow; // Timers beyond the outer wheel
+		size_t count = 0;
 	};
 
 	// Returns a unique priority value for a task which preserves FIFO ordering
@@ -148,10 +413,10 @@ private:
 	int64_t getFIFOPriority(TaskPriority taskId) { return (int64_t(taskId) << 32) - (++tasksIssued); }
 	uint64_t tasksIssued;
 
-	ReadyQueue<OrderedTask> ready;
-	ThreadSafeQueue<std::pair<TaskPriority, Task*>> threadReady;
+	ReadyQueue ready;
+	ThreadSafeRingQueue<std::pair<TaskPriority, Task*>> threadReady;
 
-	std::priority_queue<DelayedTask, std::vector<DelayedTask>> timers;
+	TimerWheel timers;
 
 	Int64MetricHandle countTimers;
 	Int64MetricHandle countCantSleep;
@@ -185,3 +185,130 @@ public:
 		return Optional<T>(std::move(data));
 	}
 };
+
+// ThreadSafeRingQueue<T> is a multi-producer, single-consumer queue with the same interface as ThreadSafeQueue, backed
+// by a bounded ring of preallocated slots (after Dmitry Vyukov's bounded queue, same license as above) so that a push
+// neither allocates nor touches memory the consumer has just written. The producer and consumer positions sit on
+// their own cache lines. When the ring is full, pushes spill into an unbounded ThreadSafeQueue until the consumer has
+// drained it, which keeps each producer's elements in order.
+
+// Wakeups are batched: canSleep() raises a flag, and only the push that finds the flag raised returns true, so a burst
+// of pushes while the consumer is asleep wakes it once. A capacity of 0 makes this a plain ThreadSafeQueue.
+template <class T>
+class ThreadSafeRingQueue : NonCopyable {
+	static constexpr size_t cacheLineSize = 64;
+
+	struct Cell {
+		std::atomic<size_t> sequence;
+		T data;
+	};
+
+	Cell* cells = nullptr;
+	size_t mask = 0;
+
+	alignas(cacheLineSize) std::atomic<size_t> enqueuePos{ 0 };
+	// Number of elements pushed to overflow and not yet popped; while nonzero, producers keep using overflow.
+	alignas(cacheLineSize) std::atomic<int64_t> overflowCount{ 0 };
+	alignas(cacheLineSize) std::atomic<bool> sleeping{ false };
+	alignas(cacheLineSize) size_t dequeuePos = 0;
+	ThreadSafeQueue<T> overflow;
+
+	template <class U>
+	bool tryPushRing(U&& data) {
+		size_t pos = enqueuePos.load(std::memory_order_relaxed);
+		Cell* cell;
+		while (true) {
+			cell = &cells[pos & mask];
+			size_t seq = cell->sequence.load(std::memory_order_acquire);
+			intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+			if (diff == 0) {
+				if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+					break;
+				}
+			} else if (diff < 0) {
+				return false; // full
+			} else {
+				pos = enqueuePos.load(std::memory_order_relaxed);
+			}
+		}
+		cell->data = std::forward<U>(data);
+		cell->sequence.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	bool ringEmpty() const {
+		return cells[dequeuePos & mask].sequence.load(std::memory_order_acquire) != dequeuePos + 1;
+	}
+
+public:
+	explicit ThreadSafeRingQueue(size_t capacity) {
+		if (capacity) {
+			size_t size = 1;
+			while (size < capacity) {
+				size <<= 1;
+			}
+			cells = new Cell[size];
+			for (size_t i = 0; i < size; i++) {
+				cells[i].sequence.store(i, std::memory_order_relaxed);
+			}
+			mask = size - 1;
+		}
+	}
+	~ThreadSafeRingQueue() {
+		while (pop().present())
+			;
+		delete[] cells;
+	}
+
+	// If push() returns true, the consumer may be sleeping and should be woken
+	template <class U>
+	bool push(U&& data) {
+		if (!cells) {
+			return overflow.push(std::forward<U>(data));
+		}
+		if (overflowCount.load(std::memory_order_acquire) > 0 || !tryPushRing(std::forward<U>(data))) {
+			overflowCount.fetch_add(1, std::memory_order_acq_rel);
+			overflow.push(std::forward<U>(data));
+		}
+		// Pairs with the fence in canSleep(): either the consumer sees this element, or we see it is asleep.
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		return sleeping.load(std::memory_order_relaxed) && sleeping.exchange(false, std::memory_order_relaxed);
+	}
+
+	///////////// The below functions may only be called by a single, consumer thread //////////////////
+
+	// If canSleep returns true, then the queue is empty and the next push() will return true
+	bool canSleep() {
+		if (!cells) {
+			return overflow.canSleep();
+		}
+		if (!ringEmpty() || overflowCount.load(std::memory_order_acquire) > 0) {
+			return false;
+		}
+		sleeping.store(true, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (!ringEmpty() || overflowCount.load(std::memory_order_relaxed) > 0) {
+			sleeping.store(false, std::memory_order_relaxed);
+			return false;
+		}
+		return true;
+	}
+
+	Optional<T> pop() {
+		if (!cells) {
+			return overflow.pop();
+		}
+		if (!ringEmpty()) {
+			Cell& cell = cells[dequeuePos & mask];
+			T data = std::move(cell.data);
+			cell.sequence.store(dequeuePos + mask + 1, std::memory_order_release);
+			++dequeuePos;
+			return Optional<T>(std::move(data));
+		}
+		Optional<T> data = overflow.pop();
+		if (data.present()) {
+			overflowCount.fetch_sub(1, std::memory_order_acq_rel);
+		}
+		return data;
+	}
+};
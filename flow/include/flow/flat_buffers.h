@@ -401,7 +401,16 @@ constexpr bool expect_serialize_member =
 template <class T>
 constexpr bool use_indirection = !(is_scalar<T> || is_struct_like<T>);
 
-using VTable = std::vector<uint16_t>;
+// A vtable whose layout is computed at compile time, see get_vtable
+struct VTable {
+	const uint16_t* entries;
+	size_t count;
+
+	constexpr const uint16_t& operator[](size_t i) const { return entries[i]; }
+	constexpr size_t size() const { return count; }
+	constexpr const uint16_t* begin() const { return entries; }
+	constexpr const uint16_t* end() const { return entries + count; }
+};
 
 template <class T>
 constexpr int fb_scalar_size = is_scalar<T> ? scalar_traits<T>::size : sizeof(RelativeOffset);
@@ -659,24 +668,73 @@ using Fields = decltype(fields_helper<Member>());
 // It's important that get_vtable always returns the same VTable pointer
 // so that we can decide equality by comparing the pointers.
 
-// First |numMembers| elements of sizesAndAlignments are sizes, the second
-// |numMembers| elements are alignments.
-extern VTable generate_vtable(size_t numMembers, const std::vector<unsigned>& sizesAndAlignments);
+// First |NumMembers| elements of sizesAndAlignments are sizes, the second
+// |NumMembers| elements are alignments. Members are laid out largest first,
+// keeping declaration order among members of the same size.
+template <size_t NumMembers>
+constexpr std::array<uint16_t, NumMembers + 2> generate_vtable(
+    const std::array<unsigned, 2 * NumMembers>& sizesAlignments) {
+	std::array<uint16_t, NumMembers + 2> result{};
+	if constexpr (NumMembers == 0) {
+		result[0] = 4;
+		result[1] = 4;
+	} else {
+		std::array<unsigned, NumMembers> order{};
+		size_t present = 0;
+		for (unsigned i = 0; i < NumMembers; ++i) {
+			if (sizesAlignments[i] > 0) {
+				order[present++] = i;
+			}
+		}
+		// Insertion sort, which is stable
+		for (size_t i = 1; i < present; ++i) {
+			unsigned member = order[i];
+			size_t j = i;
+			for (; j > 0 && sizesAlignments[order[j - 1]] < sizesAlignments[member]; --j) {
+				order[j] = order[j - 1];
+			}
+			order[j] = member;
+		}
+		// size of the vtable is
+		// - 2 bytes per member +
+		// - 2 bytes for the size entry +
+		// - 2 bytes for the size of the object
+		result[0] = 2 * NumMembers + 4;
+		unsigned offset = 0;
+		for (size_t k = 0; k < present; ++k) {
+			unsigned member = order[k];
+			unsigned align = sizesAlignments[NumMembers + member];
+			unsigned res = offset % align == 0 ? offset : ((offset / align) + 1) * align;
+			offset = res + sizesAlignments[member];
+			result[member + 2] = res + 4;
+		}
+		result[1] = offset + 4;
+	}
+	return result;
+}
+
+template <unsigned... MembersAndAlignments>
+struct vtable_for {
+	static constexpr size_t numMembers = sizeof...(MembersAndAlignments) / 2;
+	static constexpr std::array<uint16_t, numMembers + 2> table =
+	    generate_vtable<numMembers>(std::array<unsigned, 2 * numMembers>{ MembersAndAlignments... });
+	static constexpr VTable vtable{ table.data(), table.size() };
+};
 
 template <unsigned... MembersAndAlignments>
-const VTable* gen_vtable3() {
-	static thread_local VTable table =
-	    generate_vtable(sizeof...(MembersAndAlignments) / 2, std::vector<unsigned>{ MembersAndAlignments... });
-	return &table;
+constexpr const VTable* gen_vtable3() {
+	return &vtable_for<MembersAndAlignments...>::vtable;
 }
 
 template <class... Members>
-const VTable* gen_vtable2(pack<Members...> p) {
+constexpr const VTable* gen_vtable2(pack<Members...> p) {
 	return gen_vtable3<_SizeOf<Members>::size..., _SizeOf<Members>::align...>();
 }
 
+// The layout is a compile time constant, so the save and load paths can
+// fold the member offsets instead of looking up a thread local table.
 template <class... Members>
-const VTable* get_vtable() {
+constexpr const VTable* get_vtable() {
 	return gen_vtable2(concat_t<Fields<Members>...>{});
 }
 
@@ -762,7 +820,7 @@ struct InsertVTableLambda : Context {
 
 template <class T>
 int vec_bytes(const T& begin, const T& end) {
-	return sizeof(typename T::value_type) * (end - begin);
+	return sizeof(typename std::iterator_traits<T>::value_type) * (end - begin);
 }
 
 template <class Root, class Context>
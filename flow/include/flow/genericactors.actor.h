@@ -599,14 +599,15 @@ public:
 	}
 
 	void trigger(K const& key) {
-		if (items.count(key) != 0) {
-			auto& i = items[key];
+		// Called for every key a storage server sets, so look the key up only once
+		auto it = items.find(key);
+		if (it != items.end()) {
 			Promise<Void> trigger;
-			i.change.swap(trigger);
+			it->second.change.swap(trigger);
 			Promise<Void> noDestroy = trigger; // See explanation of noDestroy in setUnconditional()
 
-			if (i.value == defaultValue)
-				items.erase(key);
+			if (it->second.value == defaultValue)
+				items.erase(it);
 
 			trigger.send(Void());
 		}
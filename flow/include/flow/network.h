@@ -69,6 +69,14 @@ struct NetworkMetrics {
 	};
 
 	std::unordered_map<TaskPriority, struct PriorityStats> activeTrackers;
+
+	// Time spent running tasks, and the number of tasks run, by the priority of each task. Unlike activeTrackers,
+	// which charge a run loop batch to the lowest priority reached so far, each task is charged to its own priority.
+	struct TaskStats {
+		double duration = 0;
+		uint64_t count = 0;
+	};
+	std::unordered_map<TaskPriority, TaskStats> taskStats;
 	double lastRunLoopBusyness; // network thread busyness (measured every 5s by default)
 	std::atomic<double>
 	    networkBusyness; // network thread busyness which is returned to the the client (measured every 1s by default)
@@ -95,6 +103,7 @@ struct NetworkMetrics {
 		secSquaredSubmit = rhs.secSquaredSubmit;
 		secSquaredDiskStall = rhs.secSquaredDiskStall;
 		activeTrackers = rhs.activeTrackers;
+		taskStats = rhs.taskStats;
 		lastRunLoopBusyness = rhs.lastRunLoopBusyness;
 		networkBusyness = rhs.networkBusyness.load();
 		starvationTrackers = rhs.starvationTrackers;
@@ -173,6 +182,8 @@ public:
 		enGrpcState = 21,
 		enProxy = 22,
 		enS3FaultInjector = 23,
+		enIOPollFunc = 24,
+		enDiskQueueSyncBatcher = 25,
 		COUNT // Add new fields before this enumerator
 	};
 
@@ -66,3 +66,46 @@ static void bench_callback(benchmark::State& benchState) {
 BENCHMARK_TEMPLATE(bench_callback, 1)->Range(1, 1 << 8)->ReportAggregatesOnly(true);
 BENCHMARK_TEMPLATE(bench_callback, 32)->Range(1, 1 << 8)->ReportAggregatesOnly(true);
 BENCHMARK_TEMPLATE(bench_callback, 1024)->Range(1, 1 << 8)->ReportAggregatesOnly(true);
+
+// Waits on futures which are already set, which runs to completion without registering a callback or yielding
+ACTOR static Future<Void> benchReadyActor(benchmark::State* benchState) {
+	state size_t waitCount = benchState->range(0);
+	state Future<int> ready = 1;
+	state size_t i;
+	state int sum;
+	while (benchState->KeepRunning()) {
+		sum = 0;
+		for (i = 0; i < waitCount; ++i) {
+			int value = wait(ready);
+			sum += value;
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	benchState->SetItemsProcessed(waitCount * static_cast<long>(benchState->iterations()));
+	return Void();
+}
+
+// The coroutine counterpart of benchReadyActor, where await_ready keeps the coroutine from suspending
+static Future<Void> benchReadyCoroutine(benchmark::State* benchState) {
+	size_t waitCount = benchState->range(0);
+	Future<int> ready = 1;
+	while (benchState->KeepRunning()) {
+		int sum = 0;
+		for (size_t i = 0; i < waitCount; ++i) {
+			sum += co_await ready;
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	benchState->SetItemsProcessed(waitCount * static_cast<long>(benchState->iterations()));
+}
+
+static void bench_ready_wait(benchmark::State& benchState) {
+	onMainThread([&benchState]() { return benchReadyActor(&benchState); }).blockUntilReady();
+}
+
+static void bench_ready_co_await(benchmark::State& benchState) {
+	onMainThread([&benchState]() { return benchReadyCoroutine(&benchState); }).blockUntilReady();
+}
+
+BENCHMARK(bench_ready_wait)->Range(1, 1 << 8)->ReportAggregatesOnly(true);
+BENCHMARK(bench_ready_co_await)->Range(1, 1 << 8)->ReportAggregatesOnly(true);
@@ -19,6 +19,7 @@
  */
 
 #include "benchmark/benchmark.h"
+#include "flow/Arena.h"
 #include "flow/IRandom.h"
 #include "flow/Error.h"
 #include <vector>
@@ -338,6 +339,86 @@ static void bench_ConflictDetection_Realistic(benchmark::State& state) {
 	state.SetItemsProcessed(state.iterations() * (writeRanges.size() + readRanges.size()));
 }
 
+// ============================================================================
+// Resolver key comparison: memcmp vs. prefix-skipping vectorized comparison
+// ============================================================================
+
+// Sorted conflict boundaries and per-transaction read keys that share a PrefixLen byte prefix, as
+// tuple-encoded keys under a common directory do.
+template <int PrefixLen>
+struct SharedPrefixKeys {
+	Arena arena;
+	std::vector<StringRef> boundaries;
+	std::vector<StringRef> reads;
+
+	SharedPrefixKeys() {
+		setThreadLocalDeterministicRandomSeed(PrefixLen);
+		auto makeKey = [&]() {
+			uint8_t* s = new (arena) uint8_t[PrefixLen + 8];
+			memset(s, 'k', PrefixLen);
+			for (int i = 0; i < 8; i++)
+				s[PrefixLen + i] = deterministicRandom()->randomInt(0, 256);
+			return StringRef(s, PrefixLen + 8);
+		};
+		for (int i = 0; i < 10000; i++)
+			boundaries.push_back(makeKey());
+		std::sort(boundaries.begin(), boundaries.end());
+		for (int i = 0; i < 400; i++)
+			reads.push_back(makeKey());
+	}
+};
+
+static bool lessMemcmp(const StringRef& a, const StringRef& b) {
+	int c = memcmp(a.begin(), b.begin(), std::min(a.size(), b.size()));
+	return c != 0 ? c < 0 : a.size() < b.size();
+}
+
+// Binary search that, like SkipList::Finger, carries the common prefix with the search key of both
+// bounds and skips the smaller of the two on every comparison.
+static int lowerBoundSkippingPrefix(const std::vector<StringRef>& keys, const StringRef& v) {
+	int lo = 0, hi = keys.size();
+	int loPrefix = 0, hiPrefix = 0;
+	while (lo < hi) {
+		int mid = lo + (hi - lo) / 2;
+		const StringRef& k = keys[mid];
+		int skip = std::min(loPrefix, hiPrefix);
+		int minLen = std::min(k.size(), v.size());
+		int p = skip + commonPrefixLength(k.begin() + skip, v.begin() + skip, minLen - skip);
+		if (p < minLen ? k[p] < v[p] : k.size() < v.size()) {
+			lo = mid + 1;
+			loPrefix = p;
+		} else {
+			hi = mid;
+			hiPrefix = p;
+		}
+	}
+	return lo;
+}
+
+// Each transaction locates its 4 read conflict keys among the batch's conflict boundaries.
+template <int PrefixLen, bool SkipPrefix>
+static void bench_KeyCompare_sharedPrefix(benchmark::State& state) {
+	static const SharedPrefixKeys<PrefixLen> keys;
+	constexpr int readsPerTransaction = 4;
+
+	for (auto _ : state) {
+		int64_t sum = 0;
+		for (const auto& r : keys.reads) {
+			if constexpr (SkipPrefix) {
+				sum += lowerBoundSkippingPrefix(keys.boundaries, r);
+			} else {
+				sum += std::lower_bound(keys.boundaries.begin(), keys.boundaries.end(), r, lessMemcmp) -
+				       keys.boundaries.begin();
+			}
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+
+	state.SetItemsProcessed(state.iterations() * keys.reads.size());
+	state.counters["transactions/sec"] =
+	    benchmark::Counter(state.iterations() * keys.reads.size() / readsPerTransaction, benchmark::Counter::kIsRate);
+}
+
 // ============================================================================
 // Benchmark registration - use BENCHMARK_TEMPLATE for templated functions
 // ============================================================================
@@ -375,4 +456,10 @@ BENCHMARK_TEMPLATE(bench_WordBitsetConflictSet_query, 10000, 100, 50)->Name("Wor
 
 // Realistic FoundationDB workload comparison
 BENCHMARK_TEMPLATE(bench_ConflictDetection_Realistic, 0)->Name("ConflictDetection/MiniConflictSet/realistic");
-BENCHMARK_TEMPLATE(bench_ConflictDetection_Realistic, 1)->Name("ConflictDetection/WordBitsetConflictSet/realistic");
\ No newline at end of file
+BENCHMARK_TEMPLATE(bench_ConflictDetection_Realistic, 1)->Name("ConflictDetection/WordBitsetConflictSet/realistic");
+
+// Key comparison with long shared key prefixes, single thread (i.e. per core)
+BENCHMARK_TEMPLATE(bench_KeyCompare_sharedPrefix, 16, false)->Name("KeyCompare/memcmp/prefix16");
+BENCHMARK_TEMPLATE(bench_KeyCompare_sharedPrefix, 16, true)->Name("KeyCompare/skipPrefix/prefix16");
+BENCHMARK_TEMPLATE(bench_KeyCompare_sharedPrefix, 64, false)->Name("KeyCompare/memcmp/prefix64");
+BENCHMARK_TEMPLATE(bench_KeyCompare_sharedPrefix, 64, true)->Name("KeyCompare/skipPrefix/prefix64");
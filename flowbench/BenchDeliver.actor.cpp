@@ -0,0 +1,56 @@
+/*
+ * BenchDeliver.actor.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2024 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark/benchmark.h"
+
+#include "fdbclient/StorageServerInterface.h"
+#include "fdbrpc/FlowTransport.h"
+#include "flow/ThreadHelper.actor.h"
+#include "flowbench/GlobalData.h"
+
+#include "flow/actorcompiler.h" // This must be the last #include.
+
+// Sends GetValueRequests to an endpoint of this process through FlowTransport, so that every request is serialized,
+// looked up in the endpoint map, and delivered to the stream as a request from a peer would be. This is the path a
+// storage server takes for each read, less the socket.
+ACTOR static Future<Void> benchDeliverActor(benchmark::State* benchState) {
+	state size_t items = benchState->range(0);
+	state RequestStream<GetValueRequest> stream;
+	state Endpoint endpoint = stream.getEndpoint();
+	state GetValueRequest request(SpanContext(), getKey(16), 100000, {}, {}, VersionVector());
+	state int i;
+	while (benchState->KeepRunning()) {
+		for (i = 0; i < items; ++i) {
+			FlowTransport::transport().sendUnreliable(SerializeSource<GetValueRequest>(request), endpoint, false);
+		}
+		for (i = 0; i < items; ++i) {
+			GetValueRequest received = waitNext(stream.getFuture());
+			benchmark::DoNotOptimize(received);
+		}
+	}
+	benchState->SetItemsProcessed(items * static_cast<long>(benchState->iterations()));
+	return Void();
+}
+
+static void bench_deliver(benchmark::State& benchState) {
+	onMainThread([&benchState]() { return benchDeliverActor(&benchState); }).blockUntilReady();
+}
+
+BENCHMARK(bench_deliver)->Range(1, 1 << 12)->ReportAggregatesOnly(true);
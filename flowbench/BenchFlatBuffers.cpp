@@ -0,0 +1,111 @@
+/*
+ * BenchFlatBuffers.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2024 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark/benchmark.h"
+#include "fdbclient/CommitTransaction.h"
+#include "fdbclient/StorageServerInterface.h"
+#include "flow/Arena.h"
+#include "flow/IRandom.h"
+#include "flow/ObjectSerializer.h"
+
+// Measures the flatbuffers serialization of the messages which dominate proxy and storage server traffic. The commit
+// request is benchmarked through its transaction, since serializing the ReplyPromise needs a running FlowTransport.
+
+struct BenchCommitTransaction {
+	constexpr static FileIdentifier file_identifier = 3381862;
+	Arena arena;
+	CommitTransactionRef transaction;
+
+	template <class Ar>
+	void serialize(Ar& ar) {
+		serializer(ar, transaction, arena);
+	}
+};
+
+static BenchCommitTransaction createCommit(int mutationCount) {
+	BenchCommitTransaction commit;
+	for (int i = 0; i < mutationCount; i++) {
+		KeyRef key = StringRef(commit.arena, deterministicRandom()->randomAlphaNumeric(24));
+		commit.transaction.mutations.push_back(
+		    commit.arena, MutationRef(MutationRef::SetValue, key, StringRef(commit.arena, std::string(100, 'v'))));
+		commit.transaction.write_conflict_ranges.push_back(commit.arena, singleKeyRange(key, commit.arena));
+		commit.transaction.read_conflict_ranges.push_back(commit.arena, singleKeyRange(key, commit.arena));
+	}
+	commit.transaction.read_snapshot = 100000;
+	return commit;
+}
+
+static GetKeyValuesReply createRangeReply(int rowCount) {
+	GetKeyValuesReply reply;
+	for (int i = 0; i < rowCount; i++) {
+		reply.data.push_back(reply.arena,
+		                     KeyValueRef(StringRef(reply.arena, deterministicRandom()->randomAlphaNumeric(24)),
+		                                 StringRef(reply.arena, std::string(100, 'v'))));
+	}
+	reply.version = 100000;
+	reply.more = true;
+	return reply;
+}
+
+template <class T>
+static void benchSave(benchmark::State& state, const T& message) {
+	size_t size = 0;
+	for (auto _ : state) {
+		Standalone<StringRef> msg = ObjectWriter::toValue(message, Unversioned());
+		size = msg.size();
+		benchmark::DoNotOptimize(msg);
+	}
+	state.SetItemsProcessed(static_cast<long>(state.iterations()));
+	state.SetBytesProcessed(size * static_cast<long>(state.iterations()));
+}
+
+template <class T>
+static void benchLoad(benchmark::State& state, const T& message) {
+	Standalone<StringRef> msg = ObjectWriter::toValue(message, Unversioned());
+	for (auto _ : state) {
+		T out;
+		ArenaObjectReader reader(msg.arena(), msg, Unversioned());
+		reader.deserialize(out);
+		benchmark::DoNotOptimize(out);
+	}
+	state.SetItemsProcessed(static_cast<long>(state.iterations()));
+	state.SetBytesProcessed(msg.size() * static_cast<long>(state.iterations()));
+}
+
+static void bench_commit_save(benchmark::State& state) {
+	benchSave(state, createCommit(state.range(0)));
+}
+
+static void bench_commit_load(benchmark::State& state) {
+	benchLoad(state, createCommit(state.range(0)));
+}
+
+static void bench_range_reply_save(benchmark::State& state) {
+	benchSave(state, createRangeReply(state.range(0)));
+}
+
+static void bench_range_reply_load(benchmark::State& state) {
+	benchLoad(state, createRangeReply(state.range(0)));
+}
+
+BENCHMARK(bench_commit_save)->Range(1, 1 << 10)->ReportAggregatesOnly(true);
+BENCHMARK(bench_commit_load)->Range(1, 1 << 10)->ReportAggregatesOnly(true);
+BENCHMARK(bench_range_reply_save)->Range(1, 1 << 10)->ReportAggregatesOnly(true);
+BENCHMARK(bench_range_reply_load)->Range(1, 1 << 10)->ReportAggregatesOnly(true);
@@ -57,3 +57,20 @@ static void bench_add_idempotency_ids(benchmark::State& state) {
 }
 
 BENCHMARK(bench_add_idempotency_ids)->ArgsProduct({ benchmark::CreateRange(1, 16384, 4), { 0, 16, 255 } });
+
+// Clears the idempotency keys of batches whose ids have all expired, as a commit proxy does between commit batches
+static void bench_add_idempotency_clears(benchmark::State& state) {
+	auto numKeys = state.range(0);
+	Version commitVersion = 0;
+	for (auto _ : state) {
+		Standalone<VectorRef<MutationRef>> clears;
+		for (int i = 0; i < numKeys; ++i) {
+			addIdempotencyClear(clears, commitVersion + i / 256, i % 256);
+		}
+		benchmark::DoNotOptimize(clears);
+		commitVersion += numKeys;
+	}
+	state.SetItemsProcessed(numKeys * static_cast<long>(state.iterations()));
+}
+
+BENCHMARK(bench_add_idempotency_clears)->Range(1, 1 << 12)->ReportAggregatesOnly(true);
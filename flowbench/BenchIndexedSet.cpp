@@ -0,0 +1,63 @@
+/*
+ * BenchIndexedSet.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2024 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark/benchmark.h"
+
+#include "fdbclient/FDBTypes.h"
+#include "flow/IndexedSet.h"
+#include "flow/IRandom.h"
+#include "flowbench/GlobalData.h"
+
+// Looks up random keys in a set of the given size, as the memory storage engine and the byte sample do for each read
+static void bench_indexedset_lower_bound(benchmark::State& state) {
+	const int items = state.range(0);
+	Arena arena;
+	IndexedSet<KeyRef, int64_t> set;
+	for (int i = 0; i < items; i++) {
+		set.insert(StringRef(arena, deterministicRandom()->randomAlphaNumeric(24)), 1);
+	}
+	InputGenerator<KeyRef> keys(1 << 12, [&arena]() {
+		return StringRef(arena, deterministicRandom()->randomAlphaNumeric(24));
+	});
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(set.lower_bound(keys.next()));
+	}
+	state.SetItemsProcessed(static_cast<long>(state.iterations()));
+}
+
+// Inserts random keys into a set and clears it again
+static void bench_indexedset_insert(benchmark::State& state) {
+	const int items = state.range(0);
+	Arena arena;
+	InputGenerator<KeyRef> keys(items, [&arena]() {
+		return StringRef(arena, deterministicRandom()->randomAlphaNumeric(24));
+	});
+	for (auto _ : state) {
+		IndexedSet<KeyRef, int64_t> set;
+		for (const auto& key : keys.data) {
+			set.insert(key, 1);
+		}
+		benchmark::DoNotOptimize(set.sumTo(set.end()));
+	}
+	state.SetItemsProcessed(items * static_cast<long>(state.iterations()));
+}
+
+BENCHMARK(bench_indexedset_lower_bound)->Range(1 << 4, 1 << 20)->ReportAggregatesOnly(true);
+BENCHMARK(bench_indexedset_insert)->Range(1 << 4, 1 << 16)->ReportAggregatesOnly(true);
@@ -0,0 +1,146 @@
+/*
+ * BenchLogPushSerialization.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2025 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark/benchmark.h"
+#include "fdbclient/CommitTransaction.h"
+#include "fdbclient/FDBTypes.h"
+#include "flow/Arena.h"
+#include "flow/IRandom.h"
+#include "flow/serialize.h"
+
+#include <utility>
+#include <vector>
+
+// Measures how fast a commit proxy can turn a batch of mutations into per-TLog push messages, mirroring the two
+// strategies in LogPushData: copying each serialized mutation into every TLog's writer, or serializing it once and
+// splicing it into each TLog's message when the messages are collected.
+
+static constexpr int kMutationsPerBatch = 64;
+
+static std::vector<MutationRef> createMutations(Arena& arena, int valueSize) {
+	std::vector<MutationRef> mutations;
+	for (int i = 0; i < kMutationsPerBatch; i++) {
+		uint8_t* value = new (arena) uint8_t[valueSize];
+		deterministicRandom()->randomBytes(value, valueSize);
+		mutations.emplace_back(MutationRef::SetValue,
+		                       StringRef(arena, deterministicRandom()->randomAlphaNumeric(24)),
+		                       StringRef(value, valueSize));
+	}
+	return mutations;
+}
+
+static void writeHeader(BinaryWriter& wr, uint32_t size, uint32_t subseq) {
+	wr << size << subseq << uint16_t(1) << Tag(0, 1);
+}
+
+static constexpr uint32_t kHeaderBytes = sizeof(uint32_t) + sizeof(uint16_t) + sizeof(Tag);
+
+static void bench_LogPush_copyPerTLog(benchmark::State& state) {
+	const int valueSize = state.range(0);
+	const int tlogs = state.range(1);
+	Arena arena;
+	std::vector<MutationRef> mutations = createMutations(arena, valueSize);
+	int64_t bytes = 0;
+
+	for (auto _ : state) {
+		std::vector<BinaryWriter> writers;
+		for (int i = 0; i < tlogs; i++) {
+			writers.emplace_back(AssumeVersion(g_network->protocolVersion()));
+		}
+		uint32_t subseq = 1;
+		for (const MutationRef& m : mutations) {
+			BinaryWriter& first = writers[0];
+			int offset = first.getLength();
+			writeHeader(first, 0, subseq++);
+			first << m;
+			int length = first.getLength() - offset;
+			*(uint32_t*)((uint8_t*)first.getData() + offset) = length - sizeof(uint32_t);
+			for (int i = 1; i < tlogs; i++) {
+				writers[i].serializeBytes((uint8_t*)first.getData() + offset, length);
+			}
+		}
+		for (const BinaryWriter& wr : writers) {
+			Standalone<StringRef> msg = wr.toValue();
+			benchmark::DoNotOptimize(msg.begin());
+			bytes += msg.size();
+		}
+	}
+	state.SetBytesProcessed(bytes);
+}
+
+static void bench_LogPush_sharedAcrossTLogs(benchmark::State& state) {
+	const int valueSize = state.range(0);
+	const int tlogs = state.range(1);
+	Arena arena;
+	std::vector<MutationRef> mutations = createMutations(arena, valueSize);
+	int64_t bytes = 0;
+
+	for (auto _ : state) {
+		std::vector<BinaryWriter> writers;
+		std::vector<std::vector<std::pair<int, StringRef>>> shared(tlogs);
+		Arena sharedArena;
+		for (int i = 0; i < tlogs; i++) {
+			writers.emplace_back(AssumeVersion(g_network->protocolVersion()));
+		}
+		uint32_t subseq = 1;
+		for (const MutationRef& m : mutations) {
+			Standalone<StringRef> message = BinaryWriter::toValue(m, AssumeVersion(g_network->protocolVersion()));
+			sharedArena.dependsOn(message.arena());
+			for (int i = 0; i < tlogs; i++) {
+				writeHeader(writers[i], message.size() + kHeaderBytes, subseq);
+				shared[i].emplace_back(writers[i].getLength(), message);
+			}
+			subseq++;
+		}
+		for (int i = 0; i < tlogs; i++) {
+			Standalone<StringRef> written = writers[i].toValue();
+			int totalBytes = written.size();
+			for (const auto& [offset, message] : shared[i]) {
+				totalBytes += message.size();
+			}
+			Standalone<StringRef> msg = makeString(totalBytes);
+			uint8_t* out = mutateString(msg);
+			int copied = 0;
+			for (const auto& [offset, message] : shared[i]) {
+				memcpy(out, written.begin() + copied, offset - copied);
+				out += offset - copied;
+				copied = offset;
+				memcpy(out, message.begin(), message.size());
+				out += message.size();
+			}
+			memcpy(out, written.begin() + copied, written.size() - copied);
+			benchmark::DoNotOptimize(msg.begin());
+			bytes += msg.size();
+		}
+	}
+	state.SetBytesProcessed(bytes);
+}
+
+static void LogPushArgs(benchmark::internal::Benchmark* b) {
+	for (int valueSize : { 100, 10000, 100000 }) {
+		for (int tlogs : { 1, 3, 6 }) {
+			b->Args({ valueSize, tlogs });
+		}
+	}
+	b->ArgNames({ "valueSize", "tlogs" });
+}
+
+BENCHMARK(bench_LogPush_copyPerTLog)->Apply(LogPushArgs);
+BENCHMARK(bench_LogPush_sharedAcrossTLogs)->Apply(LogPushArgs);
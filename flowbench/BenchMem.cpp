@@ -18,11 +18,19 @@
  * limitations under the License.
  */
 
+#include <condition_variable>
 #include <cstring>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include "benchmark/benchmark.h"
 
+#include "flow/Arena.h"
+#include "flow/FastAlloc.h"
+
 static void bench_memcmp(benchmark::State& state) {
 	constexpr int kLength = 10000;
 	std::unique_ptr<char[]> b1{ new char[kLength] };
@@ -47,5 +55,109 @@ static void bench_memcpy(benchmark::State& state) {
 	}
 }
 
+// Frees the batches of memory handed to it on a thread of its own, as a storage engine thread frees memory allocated on
+// the network thread
+template <class T>
+class RemoteReleaser {
+public:
+	explicit RemoteReleaser(std::function<void(T&)> release)
+	  : release(std::move(release)), thread([this]() { run(); }) {}
+	~RemoteReleaser() {
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			stopped = true;
+		}
+		changed.notify_all();
+		thread.join();
+	}
+
+	// Hands the batch to the releasing thread, and waits until it has been released
+	void releaseAndWait(std::vector<T>& batch) {
+		std::unique_lock<std::mutex> lock(mutex);
+		pending.swap(batch);
+		changed.notify_all();
+		changed.wait(lock, [this]() { return pending.empty(); });
+	}
+
+private:
+	void run() {
+		std::unique_lock<std::mutex> lock(mutex);
+		while (true) {
+			changed.wait(lock, [this]() { return stopped || !pending.empty(); });
+			if (stopped) {
+				return;
+			}
+			for (T& t : pending) {
+				release(t);
+			}
+			pending.clear();
+			changed.notify_all();
+		}
+	}
+
+	std::function<void(T&)> release;
+	std::mutex mutex;
+	std::condition_variable changed;
+	std::vector<T> pending;
+	bool stopped = false;
+	std::thread thread;
+};
+
+// Allocates and frees blocks of the given size class on this thread
+template <int Size>
+static void bench_fast_alloc_local(benchmark::State& state) {
+	const int batchSize = state.range(0);
+	std::vector<void*> batch;
+	batch.reserve(batchSize);
+	for (auto _ : state) {
+		for (int i = 0; i < batchSize; i++) {
+			batch.push_back(FastAllocator<Size>::allocate());
+		}
+		for (void* p : batch) {
+			FastAllocator<Size>::release(p);
+		}
+		batch.clear();
+	}
+	state.SetItemsProcessed(batchSize * static_cast<long>(state.iterations()));
+}
+
+// Allocates blocks of the given size class on this thread and frees them on another
+template <int Size>
+static void bench_fast_alloc_remote_free(benchmark::State& state) {
+	const int batchSize = state.range(0);
+	RemoteReleaser<void*> releaser([](void*& p) { FastAllocator<Size>::release(p); });
+	std::vector<void*> batch;
+	for (auto _ : state) {
+		batch.reserve(batchSize);
+		for (int i = 0; i < batchSize; i++) {
+			batch.push_back(FastAllocator<Size>::allocate());
+		}
+		releaser.releaseAndWait(batch);
+	}
+	state.SetItemsProcessed(batchSize * static_cast<long>(state.iterations()));
+}
+
+// Allocates arenas on this thread and drops them on another, as reads of a storage engine with threads of its own do
+static void bench_arena_remote_free(benchmark::State& state) {
+	const int batchSize = state.range(0);
+	const int bytes = state.range(1);
+	RemoteReleaser<Standalone<StringRef>> releaser([](Standalone<StringRef>& s) { s = Standalone<StringRef>(); });
+	std::vector<Standalone<StringRef>> batch;
+	for (auto _ : state) {
+		batch.reserve(batchSize);
+		for (int i = 0; i < batchSize; i++) {
+			batch.push_back(makeString(bytes));
+		}
+		releaser.releaseAndWait(batch);
+	}
+	state.SetItemsProcessed(batchSize * static_cast<long>(state.iterations()));
+	state.SetBytesProcessed(batchSize * bytes * static_cast<long>(state.iterations()));
+}
+
 BENCHMARK(bench_memcmp);
 BENCHMARK(bench_memcpy);
+BENCHMARK_TEMPLATE(bench_fast_alloc_local, 64)->Range(1 << 6, 1 << 14)->ReportAggregatesOnly(true);
+BENCHMARK_TEMPLATE(bench_fast_alloc_local, 4096)->Range(1 << 6, 1 << 14)->ReportAggregatesOnly(true);
+BENCHMARK_TEMPLATE(bench_fast_alloc_remote_free, 64)->Range(1 << 6, 1 << 14)->ReportAggregatesOnly(true);
+BENCHMARK_TEMPLATE(bench_fast_alloc_remote_free, 4096)->Range(1 << 6, 1 << 14)->ReportAggregatesOnly(true);
+BENCHMARK(bench_arena_remote_free)->Ranges({ { 1 << 6, 1 << 14 }, { 64, 8192 } })->ReportAggregatesOnly(true);
@@ -50,8 +50,30 @@ ACTOR static Future<Void> benchStreamActor(benchmark::State* benchState) {
 	return Void();
 }
 
+// The coroutine counterpart of benchStreamActor. Every item is queued before it is awaited, so no await suspends.
+static Future<Void> benchStreamCoroutine(benchmark::State* benchState) {
+	size_t items = benchState->range(0);
+	KeyRef key = getKey(benchState->range(1));
+	PromiseStream<Key> stream;
+	while (benchState->KeepRunning()) {
+		for (size_t i = 0; i < items; ++i) {
+			stream.send(key);
+		}
+		for (size_t i = 0; i < items; ++i) {
+			Key receivedKey = co_await stream.getFuture();
+			benchmark::DoNotOptimize(receivedKey);
+		}
+	}
+	benchState->SetItemsProcessed(items * static_cast<long>(benchState->iterations()));
+}
+
 static void bench_stream(benchmark::State& benchState) {
 	onMainThread([&benchState]() { return benchStreamActor(&benchState); }).blockUntilReady();
 }
 
+static void bench_stream_coroutine(benchmark::State& benchState) {
+	onMainThread([&benchState]() { return benchStreamCoroutine(&benchState); }).blockUntilReady();
+}
+
 BENCHMARK(bench_stream)->Ranges({ { 1, 1 << 16 }, { 1, 1 << 16 } })->ReportAggregatesOnly(true);
+BENCHMARK(bench_stream_coroutine)->Ranges({ { 1, 1 << 16 }, { 1, 1 << 16 } })->ReportAggregatesOnly(true);
@@ -0,0 +1,93 @@
+/*
+ * BenchTaskQueue.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2024 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark/benchmark.h"
+
+#include "flow/TaskQueue.h"
+
+struct BenchTask {};
+
+static const TaskPriority benchPriorities[] = {
+	TaskPriority::RunLoop,      TaskPriority::TLogCommit,   TaskPriority::ProxyCommit,         TaskPriority::DefaultEndpoint,
+	TaskPriority::DefaultYield, TaskPriority::DefaultDelay, TaskPriority::DefaultOnMainThread, TaskPriority::UpdateStorage
+};
+
+// Adds the given number of ready tasks, spread over a few priorities, and runs them all
+static void bench_ready_queue(benchmark::State& state) {
+	const int taskCount = state.range(0);
+	const int priorityCount = state.range(1);
+	TaskQueue<BenchTask> queue;
+	BenchTask task;
+	for (auto _ : state) {
+		for (int i = 0; i < taskCount; i++) {
+			queue.addReady(benchPriorities[i % priorityCount], &task);
+		}
+		while (queue.hasReadyTask()) {
+			benchmark::DoNotOptimize(queue.getReadyTask());
+			queue.popReadyTask();
+		}
+	}
+	state.SetItemsProcessed(taskCount * static_cast<long>(state.iterations()));
+}
+
+// Keeps the given number of tasks ready, adding one each time one is run, as the run loop does
+static void bench_ready_queue_steady(benchmark::State& state) {
+	const int taskCount = state.range(0);
+	const int priorityCount = state.range(1);
+	TaskQueue<BenchTask> queue;
+	BenchTask task;
+	for (int i = 0; i < taskCount; i++) {
+		queue.addReady(benchPriorities[i % priorityCount], &task);
+	}
+	int i = 0;
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(queue.getReadyTask());
+		queue.popReadyTask();
+		queue.addReady(benchPriorities[i++ % priorityCount], &task);
+	}
+	state.SetItemsProcessed(static_cast<long>(state.iterations()));
+}
+
+BENCHMARK(bench_ready_queue)->Ranges({ { 1, 1 << 16 }, { 1, 8 } })->ReportAggregatesOnly(true);
+BENCHMARK(bench_ready_queue_steady)->Ranges({ { 1, 1 << 16 }, { 1, 8 } })->ReportAggregatesOnly(true);
+
+// Adds timers which are mostly far off, as timeouts are, and runs those which come due as time advances by 1ms
+static void bench_timers(benchmark::State& state) {
+	const int timerCount = state.range(0);
+	TaskQueue<BenchTask> queue;
+	BenchTask task;
+	double now = 0;
+	int i = 0;
+	for (int j = 0; j < timerCount; j++) {
+		queue.addTimer(now + (j % 100 == 0 ? 0.001 * (j % 1000) : 5.0 + j % 1000), TaskPriority::DefaultDelay, &task);
+	}
+	for (auto _ : state) {
+		now += 0.001;
+		queue.addTimer(now + (i++ % 100 == 0 ? 0.001 : 5.0 + i % 1000), TaskPriority::DefaultDelay, &task);
+		queue.processReadyTimers(now);
+		while (queue.hasReadyTask()) {
+			queue.popReadyTask();
+		}
+		benchmark::DoNotOptimize(queue.getSleepTime(now));
+	}
+	state.SetItemsProcessed(static_cast<long>(state.iterations()));
+}
+
+BENCHMARK(bench_timers)->Range(1, 1 << 16)->ReportAggregatesOnly(true);
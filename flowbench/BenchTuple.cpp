@@ -0,0 +1,51 @@
+/*
+ * BenchTuple.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2024 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark/benchmark.h"
+
+#include "fdbclient/Tuple.h"
+#include "flowbench/GlobalData.h"
+
+// Packs a tuple of an integer and a byte string of the given size, as an index entry would be
+static void bench_tuple_pack(benchmark::State& state) {
+	KeyRef str = getKey(state.range(0));
+	for (auto _ : state) {
+		Tuple t;
+		t.append(int64_t(123456789)).append(str);
+		benchmark::DoNotOptimize(t.pack());
+	}
+	state.SetItemsProcessed(static_cast<long>(state.iterations()));
+	state.SetBytesProcessed(str.size() * static_cast<long>(state.iterations()));
+}
+
+// Unpacks the same tuple and reads back its byte string
+static void bench_tuple_unpack(benchmark::State& state) {
+	KeyRef str = getKey(state.range(0));
+	Standalone<StringRef> packed = Tuple().append(int64_t(123456789)).append(str).pack();
+	for (auto _ : state) {
+		Tuple t = Tuple::unpack(packed);
+		benchmark::DoNotOptimize(t.getString(1));
+	}
+	state.SetItemsProcessed(static_cast<long>(state.iterations()));
+	state.SetBytesProcessed(str.size() * static_cast<long>(state.iterations()));
+}
+
+BENCHMARK(bench_tuple_pack)->Range(8, 1 << 12)->ReportAggregatesOnly(true);
+BENCHMARK(bench_tuple_unpack)->Range(8, 1 << 12)->ReportAggregatesOnly(true);
@@ -38,6 +38,18 @@ Future<T> stopNetworkAfter(Future<T> what) {
 
 int main(int argc, char** argv) {
 	benchmark::Initialize(&argc, argv);
+	// Arguments of the form --knob_<name>=<value> are applied as knobs before the network is set up, so that
+	// benchmarks can be compared across settings that are only read at startup (e.g. --knob_use_io_uring=1).
+	int remaining = 1;
+	for (int i = 1; i < argc; i++) {
+		std::string arg = argv[i];
+		if (arg.rfind("--knob_", 0) == 0) {
+			setNetworkOption(FDBNetworkOptions::KNOB, StringRef(arg.substr(strlen("--knob_"))));
+		} else {
+			argv[remaining++] = argv[i];
+		}
+	}
+	argc = remaining;
 	if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
 		return 1;
 	}